@@ -56,6 +56,7 @@ static gboolean list_modems_flag;
 static gboolean monitor_modems_flag;
 static gboolean scan_modems_flag;
 static gchar *set_logging_str;
+static gboolean debug_stats_flag;
 static gchar *inhibit_device_str;
 static gchar *report_kernel_event_str;
 
@@ -72,6 +73,10 @@ static GOptionEntry entries[] = {
       "Set logging level in the ModemManager daemon",
       "[ERR,WARN,MSG,INFO,DEBUG]",
     },
+    { "debug-stats", 0, 0, G_OPTION_ARG_NONE, &debug_stats_flag,
+      "Get performance counters from the ModemManager daemon (requires --debug in the daemon)",
+      NULL
+    },
     { "list-modems", 'L', 0, G_OPTION_ARG_NONE, &list_modems_flag,
       "List available modems",
       NULL
@@ -131,6 +136,7 @@ mmcli_manager_options_enabled (void)
                  monitor_modems_flag +
                  scan_modems_flag +
                  !!set_logging_str +
+                 debug_stats_flag +
                  !!inhibit_device_str +
                  !!report_kernel_event_str);
 
@@ -292,6 +298,63 @@ set_logging_ready (MMManager    *manager,
     mmcli_async_operation_done ();
 }
 
+static void
+debug_stats_process_reply (GVariant     *statistics,
+                           const GError *error)
+{
+    GVariantIter  iter;
+    const gchar  *key;
+    GVariant     *value;
+
+    if (!statistics) {
+        g_printerr ("error: couldn't get debug statistics: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    g_variant_iter_init (&iter, statistics);
+    while (g_variant_iter_next (&iter, "{&sv}", &key, &value)) {
+        if (g_variant_is_of_type (value, G_VARIANT_TYPE_UINT64))
+            g_print ("%s: %" G_GUINT64_FORMAT "\n", key, g_variant_get_uint64 (value));
+        else if (g_variant_is_of_type (value, G_VARIANT_TYPE ("at"))) {
+            static const gchar *bucket_names[] = { "<10ms", "<50ms", "<100ms", "<500ms", "<1s", "<5s", ">=5s" };
+            const guint64      *buckets;
+            gsize               n_buckets = 0;
+            gsize               i;
+
+            buckets = g_variant_get_fixed_array (value, &n_buckets, sizeof (guint64));
+            g_print ("%s:", key);
+            for (i = 0; i < n_buckets; i++)
+                g_print (" %s=%" G_GUINT64_FORMAT,
+                         i < G_N_ELEMENTS (bucket_names) ? bucket_names[i] : "?",
+                         buckets[i]);
+            g_print ("\n");
+        } else {
+            g_autofree gchar *str = NULL;
+
+            str = g_variant_print (value, FALSE);
+            g_print ("%s: %s\n", key, str);
+        }
+        g_variant_unref (value);
+    }
+
+    g_variant_unref (statistics);
+}
+
+static void
+debug_stats_ready (MMManager    *manager,
+                   GAsyncResult *result,
+                   gpointer      nothing)
+{
+    GVariant *statistics;
+    GError   *error = NULL;
+
+    statistics = mm_manager_get_debug_statistics_finish (manager, result, &error);
+    debug_stats_process_reply (statistics, error);
+
+    mmcli_async_operation_done ();
+}
+
 static void
 scan_devices_process_reply (gboolean      result,
                             const GError *error)
@@ -424,6 +487,15 @@ get_manager_ready (GObject      *source,
         return;
     }
 
+    /* Request to get debug statistics? */
+    if (debug_stats_flag) {
+        mm_manager_get_debug_statistics (ctx->manager,
+                                         ctx->cancellable,
+                                         (GAsyncReadyCallback)debug_stats_ready,
+                                         NULL);
+        return;
+    }
+
     /* Request to scan modems? */
     if (scan_modems_flag) {
         mm_manager_scan_devices (ctx->manager,
@@ -581,6 +653,15 @@ mmcli_manager_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to get debug statistics? */
+    if (debug_stats_flag) {
+        GVariant *statistics;
+
+        statistics = mm_manager_get_debug_statistics_sync (ctx->manager, NULL, &error);
+        debug_stats_process_reply (statistics, error);
+        return;
+    }
+
     /* Request to scan modems? */
     if (scan_modems_flag) {
         gboolean result;
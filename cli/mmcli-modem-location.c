@@ -274,6 +274,7 @@ print_location_status (void)
     gchar        *capabilities;
     gchar        *enabled;
     gchar        *gps_refresh_rate = NULL;
+    gchar        *gps_ttff = NULL;
     const gchar  *gps_supl_server = NULL;
     gchar        *gps_assistance = NULL;
     const gchar **gps_assistance_servers = NULL;
@@ -291,6 +292,10 @@ print_location_status (void)
         rate = mm_modem_location_get_gps_refresh_rate (ctx->modem_location);
         gps_refresh_rate = g_strdup_printf ("%u", rate);
 
+        rate = mm_modem_location_get_gps_time_to_first_fix (ctx->modem_location);
+        if (rate)
+            gps_ttff = g_strdup_printf ("%u", rate);
+
         /* If A-GPS supported, show SUPL server setup */
         if (mm_modem_location_get_capabilities (ctx->modem_location) & (MM_MODEM_LOCATION_SOURCE_AGPS_MSA | MM_MODEM_LOCATION_SOURCE_AGPS_MSB))
             gps_supl_server = mm_modem_location_get_supl_server (ctx->modem_location);
@@ -307,6 +312,7 @@ print_location_status (void)
     mmcli_output_string_list_take  (MMC_F_LOCATION_ENABLED,                enabled);
     mmcli_output_string            (MMC_F_LOCATION_SIGNALS,                mm_modem_location_signals_location (ctx->modem_location) ? "yes" : "no");
     mmcli_output_string_take_typed (MMC_F_LOCATION_GPS_REFRESH_RATE,       gps_refresh_rate, "seconds");
+    mmcli_output_string_take_typed (MMC_F_LOCATION_GPS_TTFF,               gps_ttff, "ms");
     mmcli_output_string            (MMC_F_LOCATION_GPS_SUPL_SERVER,        gps_supl_server);
     mmcli_output_string_list_take  (MMC_F_LOCATION_GPS_ASSISTANCE,         gps_assistance);
     mmcli_output_string_array      (MMC_F_LOCATION_GPS_ASSISTANCE_SERVERS, gps_assistance_servers, TRUE);
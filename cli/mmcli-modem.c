@@ -43,12 +43,17 @@ typedef struct {
     MMModem *modem;
     MMModem3gpp *modem_3gpp;
     MMModemCdma *modem_cdma;
+    /* JSON event monitoring */
+    MMModemLocation *modem_location;
+    MMModemMessaging *modem_messaging;
+    GHashTable *monitored_bearers;
 } Context;
 static Context *ctx;
 
 /* Options */
 static gboolean info_flag; /* set when no action found */
 static gboolean monitor_state_flag;
+static gboolean monitor_json_flag;
 static gboolean enable_flag;
 static gboolean disable_flag;
 static gboolean set_power_state_on_flag;
@@ -72,6 +77,10 @@ static GOptionEntry entries[] = {
       "Monitor state of a given modem",
       NULL
     },
+    { "monitor-json", 0, 0, G_OPTION_ARG_NONE, &monitor_json_flag,
+      "Monitor state, signal, location, bearer and SMS events of a given modem, one JSON object per line",
+      NULL
+    },
     { "enable", 'e', 0, G_OPTION_ARG_NONE, &enable_flag,
       "Enable a given modem",
       NULL
@@ -169,6 +178,7 @@ mmcli_modem_options_enabled (void)
         return !!n_actions;
 
     n_actions = (monitor_state_flag +
+                 monitor_json_flag +
                  enable_flag +
                  disable_flag +
                  set_power_state_on_flag +
@@ -206,7 +216,7 @@ mmcli_modem_options_enabled (void)
         exit (EXIT_FAILURE);
     }
 
-    if (monitor_state_flag || inhibit_flag)
+    if (monitor_state_flag || monitor_json_flag || inhibit_flag)
         mmcli_force_async_operation ();
 
     if (info_flag)
@@ -230,6 +240,12 @@ context_free (void)
         g_object_unref (ctx->modem_3gpp);
     if (ctx->modem_cdma)
         g_object_unref (ctx->modem_cdma);
+    if (ctx->monitored_bearers)
+        g_hash_table_unref (ctx->monitored_bearers);
+    if (ctx->modem_location)
+        g_object_unref (ctx->modem_location);
+    if (ctx->modem_messaging)
+        g_object_unref (ctx->modem_messaging);
     if (ctx->object)
         g_object_unref (ctx->object);
     if (ctx->manager)
@@ -1038,6 +1054,246 @@ device_removed (MMManager *manager,
     mmcli_async_operation_done ();
 }
 
+/******************************************************************************/
+/* JSON event monitoring */
+
+static void
+json_state_changed (MMModem                  *modem,
+                    MMModemState              old_state,
+                    MMModemState              new_state,
+                    MMModemStateChangeReason  reason)
+{
+    mmcli_output_json_event (mm_modem_get_path (modem), "state",
+                             "old", mm_modem_state_get_string (old_state),
+                             "new", mm_modem_state_get_string (new_state),
+                             "reason", mmcli_get_state_reason_string (reason),
+                             NULL);
+}
+
+static void
+json_signal_quality_updated (MMModem *modem)
+{
+    g_autofree gchar *quality = NULL;
+    gboolean          recent = FALSE;
+
+    quality = g_strdup_printf ("%u", mm_modem_get_signal_quality (modem, &recent));
+    mmcli_output_json_event (mm_modem_get_path (modem), "signal-quality",
+                             "value", quality,
+                             "recent", recent ? "yes" : "no",
+                             NULL);
+}
+
+static void
+json_access_technologies_updated (MMModem *modem)
+{
+    g_autofree gchar *access_technologies = NULL;
+
+    access_technologies = mm_modem_access_technology_build_string_from_mask (mm_modem_get_access_technologies (modem));
+    mmcli_output_json_event (mm_modem_get_path (modem), "access-technologies",
+                             "value", access_technologies,
+                             NULL);
+}
+
+static void
+json_location_updated (MMModemLocation *modem_location)
+{
+    g_autoptr(MMLocation3gpp)   location_3gpp = NULL;
+    g_autoptr(MMLocationGpsRaw) location_gps_raw = NULL;
+    g_autofree gchar           *operator_code = NULL;
+    g_autofree gchar           *lac = NULL;
+    g_autofree gchar           *tac = NULL;
+    g_autofree gchar           *cid = NULL;
+    g_autofree gchar           *latitude = NULL;
+    g_autofree gchar           *longitude = NULL;
+    g_autofree gchar           *altitude = NULL;
+
+    location_3gpp = mm_modem_location_get_signaled_3gpp (modem_location);
+    if (location_3gpp) {
+        operator_code = g_strdup (mm_location_3gpp_get_operator_code (location_3gpp));
+        lac = g_strdup_printf ("%04lX", mm_location_3gpp_get_location_area_code (location_3gpp));
+        tac = g_strdup_printf ("%04lX", mm_location_3gpp_get_tracking_area_code (location_3gpp));
+        cid = g_strdup_printf ("%04lX", mm_location_3gpp_get_cell_id (location_3gpp));
+    }
+
+    location_gps_raw = mm_modem_location_get_signaled_gps_raw (modem_location);
+    if (location_gps_raw) {
+        latitude = g_strdup_printf ("%lf", mm_location_gps_raw_get_latitude (location_gps_raw));
+        longitude = g_strdup_printf ("%lf", mm_location_gps_raw_get_longitude (location_gps_raw));
+        altitude = g_strdup_printf ("%lf", mm_location_gps_raw_get_altitude (location_gps_raw));
+    }
+
+    mmcli_output_json_event (mm_modem_location_get_path (modem_location), "location",
+                             "operator-code", operator_code,
+                             "location-area-code", lac,
+                             "tracking-area-code", tac,
+                             "cell-id", cid,
+                             "latitude", latitude,
+                             "longitude", longitude,
+                             "altitude", altitude,
+                             NULL);
+}
+
+static void
+json_sms_added (MMModemMessaging *modem_messaging,
+                const gchar      *sms_path,
+                gboolean          received)
+{
+    mmcli_output_json_event (mm_modem_messaging_get_path (modem_messaging), "sms-added",
+                             "sms", sms_path,
+                             "received", received ? "yes" : "no",
+                             NULL);
+}
+
+static void
+json_bearer_connected_updated (MMBearer *bearer)
+{
+    mmcli_output_json_event (mm_bearer_get_path (bearer), "bearer-connected",
+                             "value", mm_bearer_get_connected (bearer) ? "yes" : "no",
+                             NULL);
+}
+
+static void
+json_bearer_stats_updated (MMBearer *bearer)
+{
+    g_autoptr(MMBearerStats)  stats = NULL;
+    g_autofree gchar         *duration = NULL;
+    g_autofree gchar         *rx_bytes = NULL;
+    g_autofree gchar         *tx_bytes = NULL;
+
+    stats = mm_bearer_get_stats (bearer);
+    if (!stats)
+        return;
+
+    duration = g_strdup_printf ("%u", mm_bearer_stats_get_duration (stats));
+    rx_bytes = g_strdup_printf ("%" G_GUINT64_FORMAT, mm_bearer_stats_get_rx_bytes (stats));
+    tx_bytes = g_strdup_printf ("%" G_GUINT64_FORMAT, mm_bearer_stats_get_tx_bytes (stats));
+    mmcli_output_json_event (mm_bearer_get_path (bearer), "bearer-stats",
+                             "duration", duration,
+                             "bytes-rx", rx_bytes,
+                             "bytes-tx", tx_bytes,
+                             NULL);
+}
+
+static void
+json_bearer_monitor_stop (MMBearer *bearer)
+{
+    g_signal_handlers_disconnect_by_func (bearer, json_bearer_connected_updated, NULL);
+    g_signal_handlers_disconnect_by_func (bearer, json_bearer_stats_updated, NULL);
+    g_object_unref (bearer);
+}
+
+static void
+json_list_bearers_ready (MMModem      *modem,
+                         GAsyncResult *result)
+{
+    g_autoptr(GError)     error = NULL;
+    g_autoptr(GHashTable) previous = NULL;
+    GList                *bearers;
+    GList                *l;
+
+    bearers = mm_modem_list_bearers_finish (modem, result, &error);
+    if (error) {
+        g_printerr ("error: couldn't list bearers: '%s'\n", error->message);
+        return;
+    }
+
+    /* Keep the handlers of the bearers we were already monitoring, and only
+     * setup new ones for the new bearers */
+    previous = g_steal_pointer (&ctx->monitored_bearers);
+    ctx->monitored_bearers = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify)json_bearer_monitor_stop);
+    for (l = bearers; l; l = g_list_next (l)) {
+        MMBearer *bearer = MM_BEARER (l->data);
+        gpointer  key = NULL;
+        gpointer  value = NULL;
+
+        if (previous && g_hash_table_lookup_extended (previous, mm_bearer_get_path (bearer), &key, &value)) {
+            g_hash_table_steal (previous, key);
+            g_hash_table_insert (ctx->monitored_bearers, key, value);
+            continue;
+        }
+
+        g_signal_connect (bearer, "notify::connected", G_CALLBACK (json_bearer_connected_updated), NULL);
+        g_signal_connect (bearer, "notify::stats",     G_CALLBACK (json_bearer_stats_updated),     NULL);
+        g_hash_table_insert (ctx->monitored_bearers, g_strdup (mm_bearer_get_path (bearer)), g_object_ref (bearer));
+        mmcli_output_json_event (mm_bearer_get_path (bearer), "bearer-added",
+                                 "connected", mm_bearer_get_connected (bearer) ? "yes" : "no",
+                                 NULL);
+    }
+    g_list_free_full (bearers, g_object_unref);
+
+    /* Whatever is left in the previous table was removed */
+    if (previous) {
+        GHashTableIter  iter;
+        const gchar    *path;
+
+        g_hash_table_iter_init (&iter, previous);
+        while (g_hash_table_iter_next (&iter, (gpointer *)&path, NULL))
+            mmcli_output_json_event (path, "bearer-removed", NULL);
+    }
+}
+
+static void
+json_bearers_updated (MMModem *modem)
+{
+    mm_modem_list_bearers (modem,
+                           ctx->cancellable,
+                           (GAsyncReadyCallback)json_list_bearers_ready,
+                           NULL);
+}
+
+static void
+json_device_removed (MMManager *manager,
+                     MMObject  *object)
+{
+    if (object != ctx->object)
+        return;
+
+    mmcli_output_json_event (mm_object_get_path (object), "removed", NULL);
+    mmcli_async_operation_done ();
+}
+
+static void
+monitor_json_start (void)
+{
+    g_autofree gchar *quality = NULL;
+    g_autofree gchar *access_technologies = NULL;
+    gboolean          recent = FALSE;
+
+    /* Initial snapshot, all updates are deltas afterwards */
+    quality = g_strdup_printf ("%u", mm_modem_get_signal_quality (ctx->modem, &recent));
+    access_technologies = mm_modem_access_technology_build_string_from_mask (mm_modem_get_access_technologies (ctx->modem));
+    mmcli_output_json_event (mm_object_get_path (ctx->object), "initial",
+                             "state", mm_modem_state_get_string (mm_modem_get_state (ctx->modem)),
+                             "signal-quality", quality,
+                             "signal-quality-recent", recent ? "yes" : "no",
+                             "access-technologies", access_technologies,
+                             NULL);
+
+    g_signal_connect (ctx->modem, "state-changed",                 G_CALLBACK (json_state_changed),               NULL);
+    g_signal_connect (ctx->modem, "notify::signal-quality",        G_CALLBACK (json_signal_quality_updated),      NULL);
+    g_signal_connect (ctx->modem, "notify::access-technologies",   G_CALLBACK (json_access_technologies_updated), NULL);
+    g_signal_connect (ctx->modem, "notify::bearers",               G_CALLBACK (json_bearers_updated),             NULL);
+    g_signal_connect (ctx->manager, "object-removed",              G_CALLBACK (json_device_removed),              NULL);
+
+    ctx->modem_location = mm_object_get_modem_location (ctx->object);
+    if (ctx->modem_location)
+        g_signal_connect (ctx->modem_location, "notify::location", G_CALLBACK (json_location_updated), NULL);
+
+    ctx->modem_messaging = mm_object_get_modem_messaging (ctx->object);
+    if (ctx->modem_messaging)
+        g_signal_connect (ctx->modem_messaging, "added", G_CALLBACK (json_sms_added), NULL);
+
+    json_bearers_updated (ctx->modem);
+
+    /* If we get cancelled, operation done */
+    g_cancellable_connect (ctx->cancellable,
+                           G_CALLBACK (cancelled),
+                           NULL,
+                           NULL);
+}
+
+/******************************************************************************/
+
 static void
 get_modem_ready (GObject      *source,
                  GAsyncResult *result,
@@ -1086,6 +1342,12 @@ get_modem_ready (GObject      *source,
         return;
     }
 
+    /* Request to monitor events in JSON? */
+    if (monitor_json_flag) {
+        monitor_json_start ();
+        return;
+    }
+
     /* Request to enable the modem? */
     if (enable_flag) {
         g_debug ("Asynchronously enabling modem...");
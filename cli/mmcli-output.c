@@ -18,6 +18,7 @@
  * Copyright (C) 2018 Aleksander Morgado <aleksander@aleksander.es>
  */
 
+#include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -216,6 +217,7 @@ static FieldInfo field_infos[] = {
     [MMC_F_LOCATION_ENABLED]                         = { "modem.location.enabled",                          "enabled",                  MMC_S_MODEM_LOCATION,             },
     [MMC_F_LOCATION_SIGNALS]                         = { "modem.location.signals",                          "signals",                  MMC_S_MODEM_LOCATION,             },
     [MMC_F_LOCATION_GPS_REFRESH_RATE]                = { "modem.location.gps.refresh-rate",                 "refresh rate",             MMC_S_MODEM_LOCATION_GPS,         },
+    [MMC_F_LOCATION_GPS_TTFF]                        = { "modem.location.gps.time-to-first-fix",            "time to first fix",        MMC_S_MODEM_LOCATION_GPS,         },
     [MMC_F_LOCATION_GPS_SUPL_SERVER]                 = { "modem.location.gps.supl-server",                  "a-gps supl server",        MMC_S_MODEM_LOCATION_GPS,         },
     [MMC_F_LOCATION_GPS_ASSISTANCE]                  = { "modem.location.gps.assistance",                   "supported assistance",     MMC_S_MODEM_LOCATION_GPS,         },
     [MMC_F_LOCATION_GPS_ASSISTANCE_SERVERS]          = { "modem.location.gps.assistance-servers",           "assistance servers",       MMC_S_MODEM_LOCATION_GPS,         },
@@ -1651,3 +1653,46 @@ mmcli_output_list_dump (MmcF field)
 
     fflush (stdout);
 }
+
+/******************************************************************************/
+/* Event stream output */
+
+void
+mmcli_output_json_event (const gchar *path,
+                         const gchar *event,
+                         const gchar *first_key,
+                         ...)
+{
+    g_autoptr(GDateTime)  now = NULL;
+    g_autofree gchar     *timestamp = NULL;
+    g_autofree gchar     *escaped_path = NULL;
+    GString              *line;
+    const gchar          *key;
+    va_list               args;
+
+    now = g_date_time_new_now_local ();
+    timestamp = g_date_time_format (now, "%Y-%m-%dT%H:%M:%S%z");
+    escaped_path = json_strescape (path);
+
+    line = g_string_new (NULL);
+    g_string_append_printf (line, "{\"timestamp\":\"%s\",\"path\":\"%s\",\"event\":\"%s\"",
+                            timestamp, escaped_path, event);
+
+    va_start (args, first_key);
+    for (key = first_key; key; key = va_arg (args, const gchar *)) {
+        const gchar      *value;
+        g_autofree gchar *escaped = NULL;
+
+        value = va_arg (args, const gchar *);
+        if (value)
+            escaped = json_strescape (value);
+        g_string_append_printf (line, ",\"%s\":\"%s\"", key, escaped ? escaped : "--");
+    }
+    va_end (args);
+
+    g_string_append (line, "}\n");
+    g_print ("%s", line->str);
+    g_string_free (line, TRUE);
+
+    fflush (stdout);
+}
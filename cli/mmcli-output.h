@@ -230,6 +230,7 @@ typedef enum {
     MMC_F_LOCATION_ENABLED,
     MMC_F_LOCATION_SIGNALS,
     MMC_F_LOCATION_GPS_REFRESH_RATE,
+    MMC_F_LOCATION_GPS_TTFF,
     MMC_F_LOCATION_GPS_SUPL_SERVER,
     MMC_F_LOCATION_GPS_ASSISTANCE,
     MMC_F_LOCATION_GPS_ASSISTANCE_SERVERS,
@@ -428,4 +429,14 @@ void mmcli_output_cell_info          (GList                     *cell_info_list)
 void mmcli_output_dump      (void);
 void mmcli_output_list_dump (MmcF field);
 
+/******************************************************************************/
+/* Event stream output */
+
+/* Prints a single line JSON object describing an event on the given object,
+ * with additional NULL-terminated string key/value pairs */
+void mmcli_output_json_event (const gchar *path,
+                              const gchar *event,
+                              const gchar *first_key,
+                              ...) G_GNUC_NULL_TERMINATED;
+
 #endif /* MMCLI_OUTPUT_H */
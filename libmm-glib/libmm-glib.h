@@ -106,6 +106,7 @@
 #include <mm-gdbus-modem.h>
 #include <mm-gdbus-bearer.h>
 #include <mm-gdbus-cbm.h>
+#include <mm-gdbus-debug.h>
 #include <mm-gdbus-sim.h>
 #include <mm-gdbus-sms.h>
 #include <mm-gdbus-call.h>
@@ -27,6 +27,7 @@
 #include "mm-common-helpers.h"
 #include "mm-errors-types.h"
 #include "mm-gdbus-manager.h"
+#include "mm-gdbus-debug.h"
 #include "mm-manager.h"
 #include "mm-object.h"
 
@@ -47,6 +48,8 @@ G_DEFINE_TYPE (MMManager, mm_manager, MM_GDBUS_TYPE_OBJECT_MANAGER_CLIENT)
 struct _MMManagerPrivate {
   /* The proxy for the Manager interface */
   MmGdbusOrgFreedesktopModemManager1 *manager_iface_proxy;
+  /* The proxy for the Debug interface */
+  MmGdbusDebug *debug_iface_proxy;
 };
 
 /*****************************************************************************/
@@ -98,6 +101,7 @@ cleanup_modem_manager1_proxy (MMManager *self)
     if (self->priv->manager_iface_proxy) {
         g_signal_handlers_disconnect_by_func (self, cleanup_modem_manager1_proxy, NULL);
         g_clear_object (&self->priv->manager_iface_proxy);
+    g_clear_object (&self->priv->debug_iface_proxy);
     }
 }
 
@@ -147,6 +151,61 @@ ensure_modem_manager1_proxy (MMManager  *self,
 
 /*****************************************************************************/
 
+static void
+cleanup_debug_proxy (MMManager *self)
+{
+    if (self->priv->debug_iface_proxy) {
+        g_signal_handlers_disconnect_by_func (self, cleanup_debug_proxy, NULL);
+        g_clear_object (&self->priv->debug_iface_proxy);
+    }
+}
+
+static gboolean
+ensure_debug_proxy (MMManager  *self,
+                    GError    **error)
+{
+    gchar *name = NULL;
+    gchar *object_path = NULL;
+    GDBusObjectManagerClientFlags obj_manager_flags = G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_NONE;
+    GDBusProxyFlags proxy_flags = G_DBUS_PROXY_FLAGS_NONE;
+    GDBusConnection *connection = NULL;
+
+    if (self->priv->debug_iface_proxy)
+        return TRUE;
+
+    /* Get the Debug proxy created synchronously now */
+    g_object_get (self,
+                  "name",        &name,
+                  "object-path", &object_path,
+                  "flags",       &obj_manager_flags,
+                  "connection",  &connection,
+                  NULL);
+
+    if (obj_manager_flags & G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_DO_NOT_AUTO_START)
+        proxy_flags |= G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START;
+
+    self->priv->debug_iface_proxy =
+        mm_gdbus_debug_proxy_new_sync (connection,
+                                       proxy_flags,
+                                       name,
+                                       object_path,
+                                       NULL,
+                                       error);
+    g_object_unref (connection);
+    g_free (object_path);
+    g_free (name);
+
+    if (self->priv->debug_iface_proxy)
+        g_signal_connect (self,
+                          "notify::name-owner",
+                          G_CALLBACK (cleanup_debug_proxy),
+                          NULL);
+
+    return !!self->priv->debug_iface_proxy;
+}
+
+/*****************************************************************************/
+
 /**
  * mm_manager_new_finish:
  * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
@@ -449,6 +508,141 @@ mm_manager_set_logging_sync (MMManager     *manager,
 
 /*****************************************************************************/
 
+/**
+ * mm_manager_get_debug_statistics_finish:
+ * @manager: A #MMManager.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_manager_get_debug_statistics().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_manager_get_debug_statistics().
+ *
+ * Returns: (transfer full): a #GVariant of type "a{sv}" with the daemon
+ * performance counters, or %NULL if @error is set. The returned value should
+ * be freed with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_manager_get_debug_statistics_finish (MMManager     *manager,
+                                        GAsyncResult  *res,
+                                        GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+get_debug_statistics_ready (MmGdbusDebug *debug_iface_proxy,
+                            GAsyncResult *res,
+                            GTask        *task)
+{
+    GError   *error = NULL;
+    GVariant *statistics = NULL;
+
+    if (!mm_gdbus_debug_call_get_statistics_finish (debug_iface_proxy,
+                                                    &statistics,
+                                                    res,
+                                                    &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_pointer (task, statistics, (GDestroyNotify) g_variant_unref);
+
+    g_object_unref (task);
+}
+
+/**
+ * mm_manager_get_debug_statistics:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously requests the internal performance counters collected by the
+ * daemon, using the org.freedesktop.ModemManager1.Debug interface. This
+ * interface is only exported when the daemon runs in debug mode, and it is not
+ * part of the stable API.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_manager_get_debug_statistics_finish() to get the result of the operation.
+ *
+ * See mm_manager_get_debug_statistics_sync() for the synchronous, blocking
+ * version of this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_manager_get_debug_statistics (MMManager           *manager,
+                                 GCancellable        *cancellable,
+                                 GAsyncReadyCallback  callback,
+                                 gpointer             user_data)
+{
+    GTask *task;
+    GError *inner_error = NULL;
+
+    g_return_if_fail (MM_IS_MANAGER (manager));
+
+    task = g_task_new (manager, cancellable, callback, user_data);
+
+    if (!ensure_debug_proxy (manager, &inner_error)) {
+        g_task_return_error (task, inner_error);
+        g_object_unref (task);
+        return;
+    }
+
+    mm_gdbus_debug_call_get_statistics (manager->priv->debug_iface_proxy,
+                                        cancellable,
+                                        (GAsyncReadyCallback)get_debug_statistics_ready,
+                                        task);
+}
+
+/**
+ * mm_manager_get_debug_statistics_sync:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously requests the internal performance counters collected by the
+ * daemon, using the org.freedesktop.ModemManager1.Debug interface. This
+ * interface is only exported when the daemon runs in debug mode, and it is not
+ * part of the stable API.
+ *
+ * The calling thread is blocked until a reply is received.
+ *
+ * See mm_manager_get_debug_statistics() for the asynchronous version of this
+ * method.
+ *
+ * Returns: (transfer full): a #GVariant of type "a{sv}" with the daemon
+ * performance counters, or %NULL if @error is set. The returned value should
+ * be freed with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_manager_get_debug_statistics_sync (MMManager     *manager,
+                                      GCancellable  *cancellable,
+                                      GError       **error)
+{
+    GVariant *statistics = NULL;
+
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    if (!ensure_debug_proxy (manager, error))
+        return NULL;
+
+    if (!mm_gdbus_debug_call_get_statistics_sync (manager->priv->debug_iface_proxy,
+                                                  &statistics,
+                                                  cancellable,
+                                                  error))
+        return NULL;
+
+    return statistics;
+}
+
+/*****************************************************************************/
+
 /**
  * mm_manager_scan_devices_finish:
  * @manager: A #MMManager.
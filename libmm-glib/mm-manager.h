@@ -101,6 +101,17 @@ gboolean mm_manager_set_logging_sync (MMManager     *manager,
                                       GCancellable  *cancellable,
                                       GError       **error);
 
+void      mm_manager_get_debug_statistics        (MMManager           *manager,
+                                                  GCancellable        *cancellable,
+                                                  GAsyncReadyCallback  callback,
+                                                  gpointer             user_data);
+GVariant *mm_manager_get_debug_statistics_finish (MMManager           *manager,
+                                                  GAsyncResult        *res,
+                                                  GError             **error);
+GVariant *mm_manager_get_debug_statistics_sync   (MMManager           *manager,
+                                                  GCancellable        *cancellable,
+                                                  GError             **error);
+
 void mm_manager_scan_devices (MMManager           *manager,
                               GCancellable        *cancellable,
                               GAsyncReadyCallback  callback,
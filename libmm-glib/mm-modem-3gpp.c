@@ -890,6 +890,193 @@ mm_modem_3gpp_scan_sync (MMModem3gpp *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_3gpp_scan_incremental_finish:
+ * @self: A #MMModem3gpp.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_modem_3gpp_scan_incremental().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_3gpp_scan_incremental().
+ *
+ * Returns: (transfer full) (element-type ModemManager.Modem3gppNetwork): a list
+ * of #MMModem3gppNetwork structs, or #NULL if @error is set. The returned value
+ * should be freed with g_list_free_full() using mm_modem_3gpp_network_free() as
+ * #GDestroyNotify function.
+ *
+ * Since: 1.26
+ */
+GList *
+mm_modem_3gpp_scan_incremental_finish (MMModem3gpp   *self,
+                                       GAsyncResult  *res,
+                                       GError       **error)
+{
+    GVariant *result = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_3GPP (self), NULL);
+
+    if (!mm_gdbus_modem3gpp_call_scan_incremental_finish (MM_GDBUS_MODEM3GPP (self), &result, res, error))
+        return NULL;
+
+    return create_networks_list (result);
+}
+
+/**
+ * mm_modem_3gpp_scan_incremental:
+ * @self: A #MMModem3gpp.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously requests to scan available 3GPP networks, reporting partial
+ * results in the #MmGdbusModem3gpp::scan-results signal while the scan is
+ * ongoing.
+ *
+ * Cancelling @cancellable doesn't stop the scan in the modem, use
+ * mm_modem_3gpp_cancel_scan() for that.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_modem_3gpp_scan_incremental_finish() to get the result of the operation.
+ *
+ * See mm_modem_3gpp_scan_incremental_sync() for the synchronous, blocking
+ * version of this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_modem_3gpp_scan_incremental (MMModem3gpp         *self,
+                                GCancellable        *cancellable,
+                                GAsyncReadyCallback  callback,
+                                gpointer             user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_3GPP (self));
+
+    mm_gdbus_modem3gpp_call_scan_incremental (MM_GDBUS_MODEM3GPP (self), cancellable, callback, user_data);
+}
+
+/**
+ * mm_modem_3gpp_scan_incremental_sync:
+ * @self: A #MMModem3gpp.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously requests to scan available 3GPP networks, reporting partial
+ * results in the #MmGdbusModem3gpp::scan-results signal while the scan is
+ * ongoing.
+ *
+ * The calling thread is blocked until a reply is received. See
+ * mm_modem_3gpp_scan_incremental() for the asynchronous version of this method.
+ *
+ * Returns: (transfer full) (element-type ModemManager.Modem3gppNetwork): a list
+ * of #MMModem3gppNetwork structs, or #NULL if @error is set. The returned value
+ * should be freed with g_list_free_full() using mm_modem_3gpp_network_free() as
+ * #GDestroyNotify function.
+ *
+ * Since: 1.26
+ */
+GList *
+mm_modem_3gpp_scan_incremental_sync (MMModem3gpp   *self,
+                                     GCancellable  *cancellable,
+                                     GError       **error)
+{
+    GVariant *result = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_3GPP (self), NULL);
+
+    if (!mm_gdbus_modem3gpp_call_scan_incremental_sync (MM_GDBUS_MODEM3GPP (self), &result, cancellable, error))
+        return NULL;
+
+    return create_networks_list (result);
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_3gpp_cancel_scan_finish:
+ * @self: A #MMModem3gpp.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_modem_3gpp_cancel_scan().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_3gpp_cancel_scan().
+ *
+ * Returns: %TRUE if the scan was cancelled, %FALSE if @error is set.
+ *
+ * Since: 1.26
+ */
+gboolean
+mm_modem_3gpp_cancel_scan_finish (MMModem3gpp   *self,
+                                  GAsyncResult  *res,
+                                  GError       **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_3GPP (self), FALSE);
+
+    return mm_gdbus_modem3gpp_call_cancel_scan_finish (MM_GDBUS_MODEM3GPP (self), res, error);
+}
+
+/**
+ * mm_modem_3gpp_cancel_scan:
+ * @self: A #MMModem3gpp.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously requests to cancel the scan started with
+ * mm_modem_3gpp_scan_incremental().
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_modem_3gpp_cancel_scan_finish() to get the result of the operation.
+ *
+ * See mm_modem_3gpp_cancel_scan_sync() for the synchronous, blocking version
+ * of this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_modem_3gpp_cancel_scan (MMModem3gpp         *self,
+                           GCancellable        *cancellable,
+                           GAsyncReadyCallback  callback,
+                           gpointer             user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_3GPP (self));
+
+    mm_gdbus_modem3gpp_call_cancel_scan (MM_GDBUS_MODEM3GPP (self), cancellable, callback, user_data);
+}
+
+/**
+ * mm_modem_3gpp_cancel_scan_sync:
+ * @self: A #MMModem3gpp.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously requests to cancel the scan started with
+ * mm_modem_3gpp_scan_incremental().
+ *
+ * The calling thread is blocked until a reply is received. See
+ * mm_modem_3gpp_cancel_scan() for the asynchronous version of this method.
+ *
+ * Returns: %TRUE if the scan was cancelled, %FALSE if @error is set.
+ *
+ * Since: 1.26
+ */
+gboolean
+mm_modem_3gpp_cancel_scan_sync (MMModem3gpp   *self,
+                                GCancellable  *cancellable,
+                                GError       **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_3GPP (self), FALSE);
+
+    return mm_gdbus_modem3gpp_call_cancel_scan_sync (MM_GDBUS_MODEM3GPP (self), cancellable, error);
+}
+
+/*****************************************************************************/
+
 /**
  * mm_modem_3gpp_set_eps_ue_mode_operation_finish:
  * @self: A #MMModem3gpp.
@@ -145,6 +145,28 @@ GList *mm_modem_3gpp_scan_sync   (MMModem3gpp *self,
                                   GCancellable *cancellable,
                                   GError **error);
 
+void   mm_modem_3gpp_scan_incremental        (MMModem3gpp          *self,
+                                              GCancellable         *cancellable,
+                                              GAsyncReadyCallback   callback,
+                                              gpointer              user_data);
+GList *mm_modem_3gpp_scan_incremental_finish (MMModem3gpp          *self,
+                                              GAsyncResult         *res,
+                                              GError              **error);
+GList *mm_modem_3gpp_scan_incremental_sync   (MMModem3gpp          *self,
+                                              GCancellable         *cancellable,
+                                              GError              **error);
+
+void     mm_modem_3gpp_cancel_scan        (MMModem3gpp          *self,
+                                           GCancellable         *cancellable,
+                                           GAsyncReadyCallback   callback,
+                                           gpointer              user_data);
+gboolean mm_modem_3gpp_cancel_scan_finish (MMModem3gpp          *self,
+                                           GAsyncResult         *res,
+                                           GError              **error);
+gboolean mm_modem_3gpp_cancel_scan_sync   (MMModem3gpp          *self,
+                                           GCancellable         *cancellable,
+                                           GError              **error);
+
 void     mm_modem_3gpp_set_eps_ue_mode_operation        (MMModem3gpp                    *self,
                                                          MMModem3gppEpsUeModeOperation   mode,
                                                          GCancellable                   *cancellable,
@@ -755,6 +755,127 @@ mm_modem_location_get_full_sync (MMModemLocation *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_location_get_history_finish:
+ * @self: A #MMModemLocation.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_modem_location_get_history().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_location_get_history().
+ *
+ * Returns: (transfer full): a #GVariant of type "aa{sv}" with the recorded
+ * location fixes, oldest first, or %NULL if @error is set. The returned value
+ * should be freed with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_modem_location_get_history_finish (MMModemLocation  *self,
+                                      GAsyncResult     *res,
+                                      GError          **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+get_location_history_ready (MMModemLocation *self,
+                            GAsyncResult    *res,
+                            GTask           *task)
+{
+    GError   *error = NULL;
+    GVariant *history = NULL;
+
+    if (!mm_gdbus_modem_location_call_get_location_history_finish (MM_GDBUS_MODEM_LOCATION (self), &history, res, &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_pointer (task, history, (GDestroyNotify) g_variant_unref);
+
+    g_object_unref (task);
+}
+
+/**
+ * mm_modem_location_get_history:
+ * @self: A #MMModemLocation.
+ * @since: Only fixes newer than this timestamp, in milliseconds since the
+ *  epoch, are returned; 0 to get all of them.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously gets the location fixes recorded by the daemon for this
+ * modem.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_modem_location_get_history_finish() to get the result of the operation.
+ *
+ * See mm_modem_location_get_history_sync() for the synchronous, blocking
+ * version of this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_modem_location_get_history (MMModemLocation     *self,
+                               gint64               since,
+                               GCancellable        *cancellable,
+                               GAsyncReadyCallback  callback,
+                               gpointer             user_data)
+{
+    GTask *task;
+
+    g_return_if_fail (MM_IS_MODEM_LOCATION (self));
+
+    task = g_task_new (self, cancellable, callback, user_data);
+    mm_gdbus_modem_location_call_get_location_history (MM_GDBUS_MODEM_LOCATION (self),
+                                                        since,
+                                                        cancellable,
+                                                        (GAsyncReadyCallback)get_location_history_ready,
+                                                        task);
+}
+
+/**
+ * mm_modem_location_get_history_sync:
+ * @self: A #MMModemLocation.
+ * @since: Only fixes newer than this timestamp, in milliseconds since the
+ *  epoch, are returned; 0 to get all of them.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously gets the location fixes recorded by the daemon for this
+ * modem.
+ *
+ * The calling thread is blocked until a reply is received.
+ *
+ * See mm_modem_location_get_history() for the asynchronous version of this
+ * method.
+ *
+ * Returns: (transfer full): a #GVariant of type "aa{sv}" with the recorded
+ * location fixes, oldest first, or %NULL if @error is set. The returned value
+ * should be freed with g_variant_unref().
+ *
+ * Since: 1.26
+ */
+GVariant *
+mm_modem_location_get_history_sync (MMModemLocation  *self,
+                                    gint64            since,
+                                    GCancellable     *cancellable,
+                                    GError          **error)
+{
+    GVariant *history = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_LOCATION (self), NULL);
+
+    if (!mm_gdbus_modem_location_call_get_location_history_sync (MM_GDBUS_MODEM_LOCATION (self), since, &history, cancellable, error))
+        return NULL;
+
+    return history;
+}
+
+/*****************************************************************************/
+
 /**
  * mm_modem_location_get_3gpp_finish:
  * @self: A #MMModemLocation.
@@ -1218,6 +1339,27 @@ mm_modem_location_get_gps_refresh_rate (MMModemLocation *self)
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_location_get_gps_time_to_first_fix:
+ * @self: A #MMModemLocation.
+ *
+ * Gets the time to first fix of the last GNSS session that got a valid
+ * position, in milliseconds.
+ *
+ * Returns: The time to first fix, or 0 if unknown.
+ *
+ * Since: 1.26
+ */
+guint
+mm_modem_location_get_gps_time_to_first_fix (MMModemLocation *self)
+{
+    g_return_val_if_fail (MM_IS_MODEM_LOCATION (self), 0);
+
+    return mm_gdbus_modem_location_get_gps_time_to_first_fix (MM_GDBUS_MODEM_LOCATION (self));
+}
+
+/*****************************************************************************/
+
 /* custom refresh method instead of PROPERTY_OBJECT_DEFINE_REFRESH() */
 static void
 signaled_location_refresh (MMModemLocation *self)
@@ -88,6 +88,8 @@ gchar       **mm_modem_location_dup_assistance_data_servers (MMModemLocation *se
 
 guint mm_modem_location_get_gps_refresh_rate (MMModemLocation *self);
 
+guint mm_modem_location_get_gps_time_to_first_fix (MMModemLocation *self);
+
 void     mm_modem_location_setup        (MMModemLocation *self,
                                          MMModemLocationSource sources,
                                          gboolean signal_location,
@@ -207,6 +209,19 @@ gboolean mm_modem_location_get_full_sync   (MMModemLocation *self,
                                             GCancellable *cancellable,
                                             GError **error);
 
+void      mm_modem_location_get_history        (MMModemLocation      *self,
+                                                gint64                since,
+                                                GCancellable         *cancellable,
+                                                GAsyncReadyCallback   callback,
+                                                gpointer              user_data);
+GVariant *mm_modem_location_get_history_finish (MMModemLocation      *self,
+                                                GAsyncResult         *res,
+                                                GError              **error);
+GVariant *mm_modem_location_get_history_sync   (MMModemLocation      *self,
+                                                gint64                since,
+                                                GCancellable         *cancellable,
+                                                GError              **error);
+
 MMLocation3gpp    *mm_modem_location_peek_signaled_3gpp     (MMModemLocation *self);
 MMLocation3gpp    *mm_modem_location_get_signaled_3gpp      (MMModemLocation *self);
 MMLocationGpsNmea *mm_modem_location_peek_signaled_gps_nmea (MMModemLocation *self);
@@ -156,6 +156,7 @@ typedef struct {
     gchar **sms_paths;
     GList *sms_objects;
     guint i;
+    guint total;
 } ListSmsContext;
 
 static void
@@ -373,6 +374,220 @@ mm_modem_messaging_list_sync (MMModemMessaging *self,
 
 /*****************************************************************************/
 
+static GVariant *
+build_list_filter (MMSmsState   state,
+                   MMSmsStorage storage)
+{
+    GVariantBuilder builder;
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    if (state != MM_SMS_STATE_UNKNOWN)
+        g_variant_builder_add (&builder, "{sv}", "state", g_variant_new_uint32 (state));
+    if (storage != MM_SMS_STORAGE_UNKNOWN)
+        g_variant_builder_add (&builder, "{sv}", "storage", g_variant_new_uint32 (storage));
+    return g_variant_builder_end (&builder);
+}
+
+/**
+ * mm_modem_messaging_list_paged_finish:
+ * @self: A #MMModemMessaging.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_modem_messaging_list_paged().
+ * @out_total: (out) (allow-none): Return location for the number of SMS
+ *  messages matching the filters, or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_messaging_list_paged().
+ *
+ * Returns: (element-type ModemManager.Sms) (transfer full): A list of #MMSms
+ * objects, newest first, or #NULL if either not found or @error is set. The
+ * returned value should be freed with g_list_free_full() using
+ * g_object_unref() as #GDestroyNotify function.
+ *
+ * Since: 1.26
+ */
+GList *
+mm_modem_messaging_list_paged_finish (MMModemMessaging  *self,
+                                      GAsyncResult      *res,
+                                      guint             *out_total,
+                                      GError           **error)
+{
+    GError *inner_error = NULL;
+    GList  *sms_objects;
+
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), NULL);
+
+    sms_objects = g_task_propagate_pointer (G_TASK (res), &inner_error);
+    if (inner_error) {
+        g_propagate_error (error, inner_error);
+        return NULL;
+    }
+
+    if (out_total)
+        *out_total = ((ListSmsContext *) g_task_get_task_data (G_TASK (res)))->total;
+    /* Objects are built in reverse order */
+    return g_list_reverse (sms_objects);
+}
+
+static void
+list_paged_ready (MmGdbusModemMessaging *proxy,
+                  GAsyncResult          *res,
+                  GTask                 *task)
+{
+    GError         *error = NULL;
+    ListSmsContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+    if (!mm_gdbus_modem_messaging_call_list_paged_finish (proxy, &ctx->sms_paths, &ctx->total, res, &error)) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    /* If no SMS in the page, just end here. */
+    if (!ctx->sms_paths || !ctx->sms_paths[0]) {
+        g_task_return_pointer (task, NULL, NULL);
+        g_object_unref (task);
+        return;
+    }
+
+    ctx->i = 0;
+    create_next_sms (task);
+}
+
+/**
+ * mm_modem_messaging_list_paged:
+ * @self: A #MMModemMessaging.
+ * @offset: The number of matching SMS messages to skip.
+ * @count: The maximum number of #MMSms objects to list.
+ * @state: A #MMSmsState to filter by, or %MM_SMS_STATE_UNKNOWN.
+ * @storage: A #MMSmsStorage to filter by, or %MM_SMS_STORAGE_UNKNOWN.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously lists a page of the #MMSms objects in the modem, newest
+ * first. Unlike mm_modem_messaging_list(), the list is requested to the
+ * daemon, so SMS messages not yet exposed in the bus are also included.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_modem_messaging_list_paged_finish() to get the result of the operation.
+ *
+ * See mm_modem_messaging_list_paged_sync() for the synchronous, blocking
+ * version of this method.
+ *
+ * Since: 1.26
+ */
+void
+mm_modem_messaging_list_paged (MMModemMessaging    *self,
+                               guint                offset,
+                               guint                count,
+                               MMSmsState           state,
+                               MMSmsStorage         storage,
+                               GCancellable        *cancellable,
+                               GAsyncReadyCallback  callback,
+                               gpointer             user_data)
+{
+    GTask *task;
+
+    g_return_if_fail (MM_IS_MODEM_MESSAGING (self));
+
+    task = g_task_new (self, cancellable, callback, user_data);
+    g_task_set_task_data (task, g_slice_new0 (ListSmsContext), (GDestroyNotify)list_sms_context_free);
+
+    mm_gdbus_modem_messaging_call_list_paged (MM_GDBUS_MODEM_MESSAGING (self),
+                                              offset,
+                                              count,
+                                              build_list_filter (state, storage),
+                                              cancellable,
+                                              (GAsyncReadyCallback)list_paged_ready,
+                                              task);
+}
+
+/**
+ * mm_modem_messaging_list_paged_sync:
+ * @self: A #MMModemMessaging.
+ * @offset: The number of matching SMS messages to skip.
+ * @count: The maximum number of #MMSms objects to list.
+ * @state: A #MMSmsState to filter by, or %MM_SMS_STATE_UNKNOWN.
+ * @storage: A #MMSmsStorage to filter by, or %MM_SMS_STORAGE_UNKNOWN.
+ * @out_total: (out) (allow-none): Return location for the number of SMS
+ *  messages matching the filters, or %NULL.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously lists a page of the #MMSms objects in the modem, newest
+ * first.
+ *
+ * The calling thread is blocked until a reply is received. See
+ * mm_modem_messaging_list_paged() for the asynchronous version of this
+ * method.
+ *
+ * Returns: (element-type ModemManager.Sms) (transfer full): A list of #MMSms
+ * objects, newest first, or #NULL if either not found or @error is set. The
+ * returned value should be freed with g_list_free_full() using
+ * g_object_unref() as #GDestroyNotify function.
+ *
+ * Since: 1.26
+ */
+GList *
+mm_modem_messaging_list_paged_sync (MMModemMessaging  *self,
+                                    guint              offset,
+                                    guint              count,
+                                    MMSmsState         state,
+                                    MMSmsStorage       storage,
+                                    guint             *out_total,
+                                    GCancellable      *cancellable,
+                                    GError           **error)
+{
+    g_auto(GStrv)  sms_paths = NULL;
+    GList         *sms_objects = NULL;
+    guint          total = 0;
+    guint          i;
+
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), NULL);
+
+    if (!mm_gdbus_modem_messaging_call_list_paged_sync (MM_GDBUS_MODEM_MESSAGING (self),
+                                                        offset,
+                                                        count,
+                                                        build_list_filter (state, storage),
+                                                        &sms_paths,
+                                                        &total,
+                                                        cancellable,
+                                                        error))
+        return NULL;
+
+    for (i = 0; sms_paths && sms_paths[i]; i++) {
+        GObject *sms;
+
+        sms = g_initable_new (MM_TYPE_SMS,
+                              cancellable,
+                              error,
+                              "g-flags",          G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START,
+                              "g-name",           MM_DBUS_SERVICE,
+                              "g-connection",     g_dbus_proxy_get_connection (G_DBUS_PROXY (self)),
+                              "g-object-path",    sms_paths[i],
+                              "g-interface-name", "org.freedesktop.ModemManager1.Sms",
+                              NULL);
+        if (!sms) {
+            sms_object_list_free (sms_objects);
+            return NULL;
+        }
+
+        /* Keep the object */
+        sms_objects = g_list_prepend (sms_objects, sms);
+    }
+
+    if (out_total)
+        *out_total = total;
+    return g_list_reverse (sms_objects);
+}
+
+/*****************************************************************************/
+
 /**
  * mm_modem_messaging_create_finish:
  * @self: A #MMModemMessaging.
@@ -103,6 +103,27 @@ GList *mm_modem_messaging_list_sync   (MMModemMessaging *self,
                                        GCancellable *cancellable,
                                        GError **error);
 
+void   mm_modem_messaging_list_paged        (MMModemMessaging     *self,
+                                             guint                 offset,
+                                             guint                 count,
+                                             MMSmsState            state,
+                                             MMSmsStorage          storage,
+                                             GCancellable         *cancellable,
+                                             GAsyncReadyCallback   callback,
+                                             gpointer              user_data);
+GList *mm_modem_messaging_list_paged_finish (MMModemMessaging     *self,
+                                             GAsyncResult         *res,
+                                             guint                *out_total,
+                                             GError              **error);
+GList *mm_modem_messaging_list_paged_sync   (MMModemMessaging     *self,
+                                             guint                 offset,
+                                             guint                 count,
+                                             MMSmsState            state,
+                                             MMSmsStorage          storage,
+                                             guint                *out_total,
+                                             GCancellable         *cancellable,
+                                             GError              **error);
+
 void     mm_modem_messaging_delete        (MMModemMessaging *self,
                                            const gchar *sms,
                                            GCancellable *cancellable,
@@ -28,6 +28,8 @@
 
 #define MM_LOG_NO_OBJECT
 #include "mm-log.h"
+#include "mm-perf-stats.h"
+#include "mm-regex-registry.h"
 #include "mm-base-manager.h"
 #include "mm-context.h"
 
@@ -206,6 +208,9 @@ main (int argc, char *argv[])
 
     if (!mm_log_setup (mm_context_get_log_level (),
                        mm_context_get_log_file (),
+                       mm_context_get_log_file_flush_interval (),
+                       mm_context_get_log_file_flush_size (),
+                       mm_context_get_log_file_sync_level (),
                        mm_context_get_log_journal (),
                        mm_context_get_log_timestamps (),
                        mm_context_get_log_relative_timestamps (),
@@ -228,6 +233,9 @@ main (int argc, char *argv[])
     /* Detect runtime charset conversion support */
     mm_modem_charsets_init ();
 
+    /* Performance counters only collected in debug mode */
+    mm_perf_stats_set_enabled (mm_context_get_debug ());
+
     /* Acquire name, don't allow replacement */
     name_id = g_bus_own_name (mm_context_get_test_session () ? G_BUS_TYPE_SESSION : G_BUS_TYPE_SYSTEM,
                               MM_DBUS_SERVICE,
@@ -300,6 +308,12 @@ main (int argc, char *argv[])
 
     g_bus_unown_name (name_id);
 
+    mm_perf_stats_log ();
+    mm_perf_stats_set_enabled (FALSE);
+
+    /* No more response parsers run once all modems are gone */
+    mm_regex_registry_clear ();
+
     mm_msg ("ModemManager is shut down");
 
     mm_log_shutdown ();
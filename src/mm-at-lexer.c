@@ -0,0 +1,209 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <string.h>
+
+#include "mm-at-lexer.h"
+
+/*****************************************************************************/
+
+void
+mm_at_lexer_init (MMAtLexer   *lexer,
+                  const gchar *str,
+                  gssize       len)
+{
+    g_assert (str);
+
+    lexer->p = str;
+    lexer->end = str + (len < 0 ? strlen (str) : (gsize) len);
+    lexer->done = FALSE;
+}
+
+void
+mm_at_lexer_init_group (MMAtLexer       *lexer,
+                        const MMAtToken *group)
+{
+    g_assert (group->type == MM_AT_TOKEN_TYPE_GROUP);
+
+    mm_at_lexer_init (lexer, group->str, group->len);
+}
+
+gboolean
+mm_at_lexer_init_line (MMAtLexer    *lexer,
+                       const gchar **response,
+                       const gchar  *tag)
+{
+    const gchar *p;
+    gsize        tag_len;
+
+    p = *response;
+    tag_len = strlen (tag);
+
+    while (p) {
+        const gchar *line;
+        const gchar *eol;
+
+        while (g_ascii_isspace (*p))
+            p++;
+        if (!*p)
+            break;
+
+        line = p;
+        eol = line + strcspn (line, "\r\n");
+        p = eol;
+
+        if (!strncmp (line, tag, tag_len)) {
+            *response = eol;
+            mm_at_lexer_init (lexer, line + tag_len, eol - line - tag_len);
+            return TRUE;
+        }
+    }
+
+    *response = p;
+    return FALSE;
+}
+
+/*****************************************************************************/
+
+static gboolean
+parse_number (const gchar **p,
+              const gchar  *end,
+              guint        *out)
+{
+    const gchar *start = *p;
+    guint64      value = 0;
+
+    for (; *p < end && g_ascii_isdigit (**p); (*p)++) {
+        value = (value * 10) + (**p - '0');
+        if (value > G_MAXUINT)
+            return FALSE;
+    }
+
+    if (*p == start)
+        return FALSE;
+
+    *out = (guint) value;
+    return TRUE;
+}
+
+static void
+classify_unquoted (MMAtToken *token)
+{
+    const gchar *p;
+    const gchar *end;
+    guint        min;
+    guint        max;
+
+    if (!token->len) {
+        token->type = MM_AT_TOKEN_TYPE_EMPTY;
+        return;
+    }
+
+    token->type = MM_AT_TOKEN_TYPE_WORD;
+
+    p = token->str;
+    end = token->str + token->len;
+    if (!parse_number (&p, end, &min))
+        return;
+
+    if (p == end) {
+        token->type = MM_AT_TOKEN_TYPE_NUMBER;
+        token->min = token->max = min;
+        return;
+    }
+
+    if (*p++ != '-' || !parse_number (&p, end, &max) || p != end)
+        return;
+
+    token->type = MM_AT_TOKEN_TYPE_RANGE;
+    token->min = min;
+    token->max = max;
+}
+
+gboolean
+mm_at_lexer_next (MMAtLexer *lexer,
+                  MMAtToken *token)
+{
+    const gchar *p;
+    const gchar *end;
+
+    if (lexer->done)
+        return FALSE;
+
+    p = lexer->p;
+    end = lexer->end;
+    while (p < end && g_ascii_isspace (*p))
+        p++;
+
+    token->min = 0;
+    token->max = 0;
+
+    if (p < end && *p == '"') {
+        token->type = MM_AT_TOKEN_TYPE_STRING;
+        token->str = ++p;
+        while (p < end && *p != '"')
+            p++;
+        token->len = p - token->str;
+    } else if (p < end && *p == '(') {
+        guint    depth = 1;
+        gboolean quoted = FALSE;
+
+        token->type = MM_AT_TOKEN_TYPE_GROUP;
+        token->str = ++p;
+        for (; p < end; p++) {
+            if (*p == '"')
+                quoted = !quoted;
+            else if (!quoted && *p == '(')
+                depth++;
+            else if (!quoted && *p == ')' && --depth == 0)
+                break;
+        }
+        token->len = p - token->str;
+    } else {
+        token->str = p;
+        while (p < end && *p != ',')
+            p++;
+        token->len = p - token->str;
+        while (token->len > 0 && g_ascii_isspace (token->str[token->len - 1]))
+            token->len--;
+        classify_unquoted (token);
+    }
+
+    /* Skip the closing quote or parenthesis, and anything else up to the
+     * next separator */
+    while (p < end && *p != ',')
+        p++;
+
+    if (p < end)
+        lexer->p = p + 1;
+    else
+        lexer->done = TRUE;
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+gboolean
+mm_at_token_equal (const MMAtToken *token,
+                   const gchar     *str)
+{
+    return (strlen (str) == token->len && !memcmp (token->str, str, token->len));
+}
+
+gchar *
+mm_at_token_dup (const MMAtToken *token)
+{
+    return g_strndup (token->str, token->len);
+}
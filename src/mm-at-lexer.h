@@ -0,0 +1,73 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_AT_LEXER_H
+#define MM_AT_LEXER_H
+
+#include <glib.h>
+
+/* Lexer for the comma separated field lists found in AT responses, e.g.:
+ *
+ *    1,"IP","internet",,(0-5),("SM","ME")
+ *
+ * Every field is returned as one token; tokens never own memory, they point
+ * to the lexed string, which must outlive them. Parenthesized groups are
+ * returned as a single token, and their contents may be lexed in turn with
+ * mm_at_lexer_init_group(). Whitespace around fields is ignored. */
+
+typedef enum {
+    MM_AT_TOKEN_TYPE_EMPTY,  /* nothing between two separators */
+    MM_AT_TOKEN_TYPE_NUMBER, /* e.g. 15 */
+    MM_AT_TOKEN_TYPE_RANGE,  /* e.g. 0-5 */
+    MM_AT_TOKEN_TYPE_STRING, /* e.g. "SM", str/len exclude the quotes */
+    MM_AT_TOKEN_TYPE_WORD,   /* any other unquoted field */
+    MM_AT_TOKEN_TYPE_GROUP,  /* e.g. (0,1), str/len exclude the parenthesis */
+} MMAtTokenType;
+
+typedef struct {
+    MMAtTokenType  type;
+    const gchar   *str;
+    gsize          len;
+    /* Value of NUMBER tokens, or bounds of RANGE tokens */
+    guint          min;
+    guint          max;
+} MMAtToken;
+
+typedef struct {
+    const gchar *p;
+    const gchar *end;
+    gboolean     done;
+} MMAtLexer;
+
+void     mm_at_lexer_init       (MMAtLexer       *lexer,
+                                 const gchar     *str,
+                                 gssize           len);
+void     mm_at_lexer_init_group (MMAtLexer       *lexer,
+                                 const MMAtToken *group);
+gboolean mm_at_lexer_next       (MMAtLexer       *lexer,
+                                 MMAtToken       *token);
+
+/* Sets up the lexer on the fields of the next line in the response starting
+ * with the given tag (e.g. "+CGACT:"), and moves the response past it.
+ * Returns FALSE if there are no more such lines. */
+gboolean mm_at_lexer_init_line  (MMAtLexer       *lexer,
+                                 const gchar    **response,
+                                 const gchar     *tag);
+
+gboolean mm_at_token_equal      (const MMAtToken *token,
+                                 const gchar     *str);
+gchar   *mm_at_token_dup        (const MMAtToken *token);
+
+#endif /* MM_AT_LEXER_H */
@@ -20,6 +20,7 @@
 #include <ModemManager.h>
 #include "mm-errors-types.h"
 #include "mm-log-object.h"
+#include "mm-perf-stats.h"
 #include "mm-utils.h"
 #include "mm-auth-provider.h"
 #include "mm-context.h"
@@ -60,6 +61,7 @@ typedef struct {
     PolkitSubject         *subject;
     gchar                 *authorization;
     GDBusMethodInvocation *invocation;
+    gint64                 start_time;
 } AuthorizeContext;
 
 static void
@@ -86,6 +88,7 @@ check_authorization_ready (PolkitAuthority *authority,
     }
 
     ctx = g_task_get_task_data (task);
+    mm_perf_stats_add_latency ("auth", "polkit-latency", g_get_monotonic_time () - ctx->start_time);
     pk_result = polkit_authority_check_authorization_finish (authority, res, &error);
     if (!pk_result) {
         g_task_return_new_error (task,
@@ -128,6 +131,7 @@ mm_auth_provider_authorize (MMAuthProvider        *self,
     GTask *task;
 
     task = g_task_new (self, cancellable, callback, user_data);
+    mm_perf_stats_inc ("auth", "requests");
 
     /* When running in the session bus for tests, default to always allow */
     if (mm_context_get_test_session ()) {
@@ -154,6 +158,7 @@ mm_auth_provider_authorize (MMAuthProvider        *self,
         ctx->invocation = g_object_ref (invocation);
         ctx->authorization = g_strdup (authorization);
         ctx->subject = polkit_system_bus_name_new (g_dbus_method_invocation_get_sender (ctx->invocation));
+        ctx->start_time = g_get_monotonic_time ();
         g_task_set_task_data (task, ctx, (GDestroyNotify)authorize_context_free);
 
         polkit_authority_check_authorization (self->authority,
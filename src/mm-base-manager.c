@@ -45,6 +45,7 @@
 #include "mm-error-helpers.h"
 
 #include <mm-gdbus-manager.h>
+#include <mm-gdbus-debug.h>
 #if defined WITH_TESTS
 # include <mm-gdbus-test.h>
 #endif
@@ -58,6 +59,7 @@
 #include "mm-plugin.h"
 #include "mm-filter.h"
 #include "mm-log-object.h"
+#include "mm-perf-stats.h"
 #include "mm-base-modem.h"
 #include "mm-iface-modem.h"
 
@@ -111,6 +113,8 @@ struct _MMBaseManagerPrivate {
     GDBusObjectManagerServer *object_manager;
     /* The map of inhibited devices */
     GHashTable *inhibited_devices;
+    /* The Debug interface support */
+    MmGdbusDebug *debug_skeleton;
 
 #if defined WITH_TESTS
     /* Whether the test interface is enabled */
@@ -1358,6 +1362,63 @@ handle_set_logging (MmGdbusOrgFreedesktopModemManager1 *manager,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* Get debug statistics */
+
+typedef struct {
+    MMBaseManager *self;
+    GDBusMethodInvocation *invocation;
+} GetStatisticsContext;
+
+static void
+get_statistics_context_free (GetStatisticsContext *ctx)
+{
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_free (ctx);
+}
+
+static void
+get_statistics_auth_ready (MMAuthProvider       *authp,
+                           GAsyncResult         *res,
+                           GetStatisticsContext *ctx)
+{
+    GError *error = NULL;
+
+    if (!mm_auth_provider_authorize_finish (authp, res, &error))
+        mm_dbus_method_invocation_take_error (ctx->invocation, error);
+    else {
+        g_autoptr(GVariant) dictionary = NULL;
+
+        dictionary = mm_perf_stats_get_dictionary ();
+        mm_gdbus_debug_complete_get_statistics (ctx->self->priv->debug_skeleton,
+                                                ctx->invocation,
+                                                dictionary);
+    }
+
+    get_statistics_context_free (ctx);
+}
+
+static gboolean
+handle_get_statistics (MmGdbusDebug          *skeleton,
+                       GDBusMethodInvocation *invocation,
+                       MMBaseManager         *self)
+{
+    GetStatisticsContext *ctx;
+
+    ctx = g_new0 (GetStatisticsContext, 1);
+    ctx->self = g_object_ref (self);
+    ctx->invocation = g_object_ref (invocation);
+
+    mm_auth_provider_authorize (self->priv->authp,
+                                invocation,
+                                MM_AUTHORIZATION_MANAGER_CONTROL,
+                                self->priv->authp_cancellable,
+                                (GAsyncReadyCallback)get_statistics_auth_ready,
+                                ctx);
+    return TRUE;
+}
+
 /*****************************************************************************/
 /* Manual scan */
 
@@ -2006,6 +2067,11 @@ set_property (GObject      *object,
                 mm_obj_dbg (self, "stopping connection in object manager server");
                 g_dbus_object_manager_server_set_connection (self->priv->object_manager, NULL);
             }
+            if (self->priv->debug_skeleton &&
+                g_dbus_interface_skeleton_get_connection (G_DBUS_INTERFACE_SKELETON (self->priv->debug_skeleton))) {
+                mm_obj_dbg (self, "stopping connection in debug skeleton");
+                g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (self->priv->debug_skeleton));
+            }
 #if defined WITH_TESTS
             if (self->priv->test_skeleton &&
                 g_dbus_interface_skeleton_get_connection (G_DBUS_INTERFACE_SKELETON (self->priv->test_skeleton))) {
@@ -2172,6 +2238,21 @@ initable_init (GInitable     *initable,
     g_dbus_object_manager_server_set_connection (self->priv->object_manager,
                                                  self->priv->connection);
 
+    /* Setup the Debug skeleton and export the interface, only if the daemon
+     * is collecting performance counters */
+    if (mm_perf_stats_enabled ()) {
+        self->priv->debug_skeleton = mm_gdbus_debug_skeleton_new ();
+        g_signal_connect (self->priv->debug_skeleton,
+                          "handle-get-statistics",
+                          G_CALLBACK (handle_get_statistics),
+                          initable);
+        if (!g_dbus_interface_skeleton_export (G_DBUS_INTERFACE_SKELETON (self->priv->debug_skeleton),
+                                               self->priv->connection,
+                                               MM_DBUS_PATH,
+                                               error))
+            return FALSE;
+    }
+
 #if defined WITH_TESTS
     /* Setup the Test skeleton and export the interface */
     if (self->priv->enable_test) {
@@ -2224,6 +2305,9 @@ finalize (GObject *object)
     if (self->priv->object_manager)
         g_object_unref (self->priv->object_manager);
 
+    if (self->priv->debug_skeleton)
+        g_object_unref (self->priv->debug_skeleton);
+
 #if defined WITH_TESTS
     if (self->priv->test_skeleton)
         g_object_unref (self->priv->test_skeleton);
@@ -14,6 +14,8 @@
  * Copyright (C) 2024 Google, Inc.
  */
 
+#include <string.h>
+
 #include <glib.h>
 #include <glib-object.h>
 
@@ -21,6 +23,7 @@
 
 #include "mm-base-modem-at.h"
 #include "mm-errors-types.h"
+#include "mm-log-object.h"
 
 /*****************************************************************************/
 /* Port setup/teardown logic, to prepare a port to be able to run an
@@ -99,11 +102,18 @@ typedef struct {
     GDestroyNotify              response_processor_context_free;
     GVariant                   *result;
     guint                       next_command_wait_id;
+    /* Number of commands sent in the ongoing compound command line */
+    guint                       n_batched;
+    /* Commands before this one must be sent one by one */
+    const MMBaseModemAtCommand *no_batch_until;
 } AtSequenceContext;
 
 static void at_sequence_parse_response (MMIfacePortAt *port,
                                         GAsyncResult   *res,
                                         GTask          *task);
+static void at_sequence_batch_ready    (MMIfacePortAt *port,
+                                        GAsyncResult   *res,
+                                        GTask          *task);
 
 static void
 at_sequence_context_free (AtSequenceContext *ctx)
@@ -157,47 +167,239 @@ mm_base_modem_at_sequence_full_finish (MMBaseModem   *self,
     return result;
 }
 
+/*****************************************************************************/
+/* Command concatenation
+ *
+ * Consecutive commands flagged as batchable in a sequence may be sent in a
+ * single command line (e.g. "AT+CSQ;+CREG?;+COPS?") if the port supports
+ * it. The compound response is then split back per command, using the
+ * command name as the expected prefix of each response line (e.g. "+CREG:").
+ * If the compound command fails or the response can't be split reliably,
+ * the commands are sent again one by one; as batchable commands must not
+ * have side effects, this just costs the additional round trips. */
+
+/* Keep the compound command line well below the usual modem limits */
+#define AT_BATCH_MAX_COMMANDS    8
+#define AT_BATCH_MAX_LINE_LENGTH 120
+
+static gchar *
+at_command_get_name (const gchar *command)
+{
+    gsize len;
+
+    /* Only extended syntax commands may be concatenated with ';' */
+    if (!command || !command[0] || g_ascii_isalnum (command[0]))
+        return NULL;
+
+    len = strcspn (command, "?=;");
+    if (len < 2 || command[len] == ';')
+        return NULL;
+    return g_strndup (command, len);
+}
+
 static gboolean
-at_sequence_next_command (GTask *task)
+at_command_is_batchable (const MMBaseModemAtCommand *command)
 {
-    AtSequenceContext *ctx;
+    g_autofree gchar *name = NULL;
+
+    if (!command->command || !command->batchable || command->allow_cached)
+        return FALSE;
+    name = at_command_get_name (command->command);
+    return !!name;
+}
+
+guint
+mm_base_modem_at_sequence_count_batchable (const MMBaseModemAtCommand *commands,
+                                           const MMBaseModemAtCommand *no_batch_until)
+{
+    const MMBaseModemAtCommand *cmd;
+    gsize                       line_length = 0;
+    guint                       n = 0;
+
+    if (no_batch_until && commands < no_batch_until)
+        return 0;
+
+    for (cmd = commands; n < AT_BATCH_MAX_COMMANDS && at_command_is_batchable (cmd); cmd++, n++) {
+        g_autofree gchar *name = NULL;
+        guint             i;
+
+        /* Only the first command may ask for a wait before being sent */
+        if (n > 0 && cmd->wait_seconds)
+            break;
+        line_length += strlen (cmd->command) + 1;
+        if (line_length > AT_BATCH_MAX_LINE_LENGTH)
+            break;
+
+        /* Responses of commands with the same name couldn't be told apart */
+        name = at_command_get_name (cmd->command);
+        for (i = 0; i < n; i++) {
+            g_autofree gchar *other = NULL;
+
+            other = at_command_get_name (commands[i].command);
+            if (g_str_equal (name, other))
+                return n;
+        }
+    }
+    return n;
+}
+
+static guint
+at_sequence_count_batchable (AtSequenceContext *ctx)
+{
+    gboolean concatenation = FALSE;
+
+    if (!MM_IS_PORT_SERIAL_AT (ctx->port))
+        return 0;
+
+    g_object_get (ctx->port, MM_PORT_SERIAL_AT_CONCATENATION, &concatenation, NULL);
+    if (!concatenation)
+        return 0;
+
+    return mm_base_modem_at_sequence_count_batchable (ctx->current, ctx->no_batch_until);
+}
+
+GStrv
+mm_base_modem_at_sequence_split_batch_response (const MMBaseModemAtCommand *commands,
+                                                guint                       n_commands,
+                                                const gchar                *response)
+{
+    g_auto(GStrv)  lines = NULL;
+    GString       *responses[AT_BATCH_MAX_COMMANDS] = { NULL };
+    gchar         *prefixes[AT_BATCH_MAX_COMMANDS] = { NULL };
+    GStrv          split = NULL;
+    guint          cmd_i = 0;
+    guint          i;
+
+    g_assert (n_commands <= AT_BATCH_MAX_COMMANDS);
+
+    for (i = 0; i < n_commands; i++) {
+        g_autofree gchar *name = NULL;
+
+        name = at_command_get_name (commands[i].command);
+        prefixes[i] = g_strdup_printf ("%s:", name);
+    }
+
+    /* Response lines come in the same order as the commands, and commands
+     * without response lines are just skipped */
+    lines = g_strsplit_set (response, "\r\n", -1);
+    for (i = 0; lines[i]; i++) {
+        if (!lines[i][0])
+            continue;
+
+        while (cmd_i < n_commands && !g_str_has_prefix (lines[i], prefixes[cmd_i]))
+            cmd_i++;
+        if (cmd_i == n_commands)
+            goto out;
+
+        if (!responses[cmd_i])
+            responses[cmd_i] = g_string_new (lines[i]);
+        else
+            g_string_append_printf (responses[cmd_i], "\r\n%s", lines[i]);
+    }
+
+    split = g_new0 (gchar *, n_commands + 1);
+    for (i = 0; i < n_commands; i++)
+        split[i] = responses[i] ? g_string_free (g_steal_pointer (&responses[i]), FALSE) : g_strdup ("");
+
+out:
+    for (i = 0; i < n_commands; i++) {
+        if (responses[i])
+            g_string_free (responses[i], TRUE);
+        g_free (prefixes[i]);
+    }
+    return split;
+}
+
+/*****************************************************************************/
+
+static void
+at_sequence_run_current (GTask *task)
+{
+    AtSequenceContext       *ctx;
+    g_autoptr(GString)       line = NULL;
+    guint                    timeout = 0;
+    MMPortSchedulerPriority  priority;
+    guint                    i;
 
     ctx = g_task_get_task_data (task);
-    ctx->next_command_wait_id = 0;
 
-    /* Schedule the next command in the probing group */
+    ctx->n_batched = at_sequence_count_batchable (ctx);
+    if (ctx->n_batched < 2) {
+        ctx->n_batched = 0;
+        mm_iface_port_at_command (
+            ctx->port,
+            ctx->current->command,
+            ctx->current->timeout,
+            FALSE,
+            ctx->current->allow_cached,
+            ctx->current->priority,
+            g_task_get_cancellable (task),
+            (GAsyncReadyCallback)at_sequence_parse_response,
+            task);
+        return;
+    }
+
+    /* Compound command line: the longest timeout applies to all, as well as
+     * the most urgent priority */
+    line = g_string_new (NULL);
+    priority = ctx->current->priority;
+    for (i = 0; i < ctx->n_batched; i++) {
+        if (i > 0)
+            g_string_append_c (line, ';');
+        g_string_append (line, ctx->current[i].command);
+        timeout = MAX (timeout, ctx->current[i].timeout);
+        if (mm_port_scheduler_priority_get_rank (ctx->current[i].priority) < mm_port_scheduler_priority_get_rank (priority))
+            priority = ctx->current[i].priority;
+    }
+
     mm_iface_port_at_command (
         ctx->port,
-        ctx->current->command,
-        ctx->current->timeout,
+        line->str,
+        timeout,
+        FALSE,
         FALSE,
-        ctx->current->allow_cached,
+        priority,
         g_task_get_cancellable (task),
-        (GAsyncReadyCallback)at_sequence_parse_response,
+        (GAsyncReadyCallback)at_sequence_batch_ready,
         task);
+}
+
+static gboolean
+at_sequence_next_command (GTask *task)
+{
+    AtSequenceContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+    ctx->next_command_wait_id = 0;
+
+    /* Schedule the next command in the probing group */
+    at_sequence_run_current (task);
 
     return G_SOURCE_REMOVE;
 }
 
 static void
-at_sequence_parse_response (MMIfacePortAt *port,
-                            GAsyncResult  *res,
-                            GTask         *task)
+at_sequence_schedule_current (GTask *task)
+{
+    AtSequenceContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+    g_assert (!ctx->next_command_wait_id);
+    ctx->next_command_wait_id = g_timeout_add_seconds (ctx->current->wait_seconds, (GSourceFunc) at_sequence_next_command, task);
+}
+
+/* Runs the response processor of the current command; returns TRUE if the
+ * sequence should go on with the next command, FALSE if the task has been
+ * completed */
+static gboolean
+at_sequence_process_response (GTask        *task,
+                              const gchar  *response,
+                              const GError *command_error)
 {
     MMBaseModemAtResponseProcessorResult  processor_result;
     GVariant                             *result = NULL;
     GError                               *result_error = NULL;
     AtSequenceContext                    *ctx;
-    g_autofree gchar                     *response = NULL;
-    g_autoptr(GError)                     command_error = NULL;
-
-    response = mm_iface_port_at_command_finish (port, res, &command_error);
-
-    /* Cancelled? */
-    if (g_task_return_error_if_cancelled (task)) {
-        g_object_unref (task);
-        return;
-    }
 
     ctx = g_task_get_task_data (task);
     if (!ctx->current->response_processor)
@@ -226,7 +428,7 @@ at_sequence_parse_response (MMIfacePortAt *port,
                 g_assert (!result && result_error); /* result is optional */
                 g_task_return_error (task, result_error);
                 g_object_unref (task);
-                return;
+                return FALSE;
             default:
                 g_assert_not_reached ();
         }
@@ -234,11 +436,8 @@ at_sequence_parse_response (MMIfacePortAt *port,
 
     if (processor_result == MM_BASE_MODEM_AT_RESPONSE_PROCESSOR_RESULT_CONTINUE) {
         ctx->current++;
-        if (ctx->current->command) {
-            g_assert (!ctx->next_command_wait_id);
-            ctx->next_command_wait_id = g_timeout_add_seconds (ctx->current->wait_seconds, (GSourceFunc) at_sequence_next_command, task);
-            return;
-        }
+        if (ctx->current->command)
+            return TRUE;
         /* On last command, end. */
     }
 
@@ -250,6 +449,73 @@ at_sequence_parse_response (MMIfacePortAt *port,
     /* transfer-none, the result remains owned by the GTask context */
     g_task_return_pointer (task, ctx->result, NULL);
     g_object_unref (task);
+    return FALSE;
+}
+
+static void
+at_sequence_batch_ready (MMIfacePortAt *port,
+                         GAsyncResult  *res,
+                         GTask         *task)
+{
+    AtSequenceContext *ctx;
+    g_autofree gchar  *response = NULL;
+    g_autoptr(GError)  command_error = NULL;
+    g_auto(GStrv)      responses = NULL;
+    guint              n_batched;
+    guint              i;
+
+    response = mm_iface_port_at_command_finish (port, res, &command_error);
+
+    /* Cancelled? */
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
+    }
+
+    ctx = g_task_get_task_data (task);
+    n_batched = ctx->n_batched;
+    ctx->n_batched = 0;
+
+    if (response)
+        responses = mm_base_modem_at_sequence_split_batch_response (ctx->current, n_batched, response);
+
+    /* Any error in a compound command line aborts the whole line, so we
+     * can't know which command failed; run them again one by one. */
+    if (!responses) {
+        mm_obj_dbg (g_task_get_source_object (task),
+                    "couldn't run %u commands concatenated (%s), sending them one by one",
+                    n_batched, command_error ? command_error->message : "unexpected response");
+        ctx->no_batch_until = ctx->current + n_batched;
+        at_sequence_run_current (task);
+        return;
+    }
+
+    for (i = 0; i < n_batched; i++) {
+        if (!at_sequence_process_response (task, responses[i], NULL))
+            return;
+    }
+
+    at_sequence_schedule_current (task);
+}
+
+static void
+at_sequence_parse_response (MMIfacePortAt *port,
+                            GAsyncResult  *res,
+                            GTask         *task)
+{
+    g_autofree gchar  *response = NULL;
+    g_autoptr(GError)  command_error = NULL;
+
+    response = mm_iface_port_at_command_finish (port, res, &command_error);
+
+    /* Cancelled? */
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
+    }
+
+    if (at_sequence_process_response (task, response, command_error))
+        at_sequence_schedule_current (task);
 }
 
 void
@@ -298,15 +564,7 @@ mm_base_modem_at_sequence_full (MMBaseModem                *self,
     g_task_set_task_data (task, ctx, (GDestroyNotify)at_sequence_context_free);
 
     /* Go on with the first one in the sequence */
-    mm_iface_port_at_command (
-        ctx->port,
-        ctx->current->command,
-        ctx->current->timeout,
-        FALSE,
-        ctx->current->allow_cached,
-        task_cancellable,
-        (GAsyncReadyCallback)at_sequence_parse_response,
-        task);
+    at_sequence_run_current (task);
 }
 
 /******************************************************************************/
@@ -531,16 +789,17 @@ at_command_ready (MMIfacePortAt *port,
     g_object_unref (task);
 }
 
-void
-mm_base_modem_at_command_full (MMBaseModem         *self,
-                               MMIfacePortAt       *port,
-                               const gchar         *command,
-                               guint                timeout,
-                               gboolean             allow_cached,
-                               gboolean             is_raw,
-                               GCancellable        *cancellable,
-                               GAsyncReadyCallback  callback,
-                               gpointer             user_data)
+static void
+at_command_run (MMBaseModem             *self,
+                MMIfacePortAt           *port,
+                const gchar             *command,
+                guint                    timeout,
+                gboolean                 allow_cached,
+                gboolean                 is_raw,
+                MMPortSchedulerPriority  priority,
+                GCancellable            *cancellable,
+                GAsyncReadyCallback      callback,
+                gpointer                 user_data)
 {
     GCancellable     *task_cancellable;
     GCancellable     *parent_cancellable;
@@ -580,20 +839,69 @@ mm_base_modem_at_command_full (MMBaseModem         *self,
         timeout,
         is_raw,
         allow_cached,
+        priority,
         task_cancellable,
         (GAsyncReadyCallback)at_command_ready,
         task);
 }
 
+void
+mm_base_modem_at_command_full (MMBaseModem         *self,
+                               MMIfacePortAt       *port,
+                               const gchar         *command,
+                               guint                timeout,
+                               gboolean             allow_cached,
+                               gboolean             is_raw,
+                               GCancellable        *cancellable,
+                               GAsyncReadyCallback  callback,
+                               gpointer             user_data)
+{
+    at_command_run (self,
+                    port,
+                    command,
+                    timeout,
+                    allow_cached,
+                    is_raw,
+                    MM_PORT_SCHEDULER_PRIORITY_CONTROL,
+                    cancellable,
+                    callback,
+                    user_data);
+}
+
+void
+mm_base_modem_at_command_full_with_priority (MMBaseModem             *self,
+                                             MMIfacePortAt           *port,
+                                             const gchar             *command,
+                                             guint                    timeout,
+                                             gboolean                 allow_cached,
+                                             gboolean                 is_raw,
+                                             MMPortSchedulerPriority  priority,
+                                             GCancellable            *cancellable,
+                                             GAsyncReadyCallback      callback,
+                                             gpointer                 user_data)
+{
+    at_command_run (self,
+                    port,
+                    command,
+                    timeout,
+                    allow_cached,
+                    is_raw,
+                    priority,
+                    cancellable,
+                    callback,
+                    user_data);
+}
+
 /******************************************************************************/
 
 void
-mm_base_modem_at_command (MMBaseModem         *self,
-                          const gchar         *command,
-                          guint                timeout,
-                          gboolean             allow_cached,
-                          GAsyncReadyCallback  callback,
-                          gpointer             user_data)
+mm_base_modem_at_command_with_priority (MMBaseModem             *self,
+                                        const gchar             *command,
+                                        guint                    timeout,
+                                        gboolean                 allow_cached,
+                                        MMPortSchedulerPriority  priority,
+                                        GAsyncReadyCallback      callback,
+                                        gpointer                 user_data)
 {
     MMIfacePortAt *port;
     GError        *error = NULL;
@@ -605,15 +913,33 @@ mm_base_modem_at_command (MMBaseModem         *self,
         return;
     }
 
-    mm_base_modem_at_command_full (self,
-                                   port,
-                                   command,
-                                   timeout,
-                                   allow_cached,
-                                   FALSE,
-                                   NULL,
-                                   callback,
-                                   user_data);
+    at_command_run (self,
+                    port,
+                    command,
+                    timeout,
+                    allow_cached,
+                    FALSE,
+                    priority,
+                    NULL,
+                    callback,
+                    user_data);
+}
+
+void
+mm_base_modem_at_command (MMBaseModem         *self,
+                          const gchar         *command,
+                          guint                timeout,
+                          gboolean             allow_cached,
+                          GAsyncReadyCallback  callback,
+                          gpointer             user_data)
+{
+    mm_base_modem_at_command_with_priority (self,
+                                            command,
+                                            timeout,
+                                            allow_cached,
+                                            MM_PORT_SCHEDULER_PRIORITY_CONTROL,
+                                            callback,
+                                            user_data);
 }
 
 const gchar *
@@ -69,6 +69,13 @@ typedef struct {
     MMBaseModemAtResponseProcessor response_processor;
     /* Time to wait before sending this command (in seconds) */
     guint wait_seconds;
+    /* Scheduling priority class, CONTROL if not given */
+    MMPortSchedulerPriority priority;
+    /* Query without side effects whose response lines all start with
+     * the command name followed by ':' (e.g. "+CREG?" and "+CREG: ...").
+     * Consecutive batchable commands in a sequence are sent concatenated in
+     * a single command line if the port supports it. */
+    gboolean batchable;
 } MMBaseModemAtCommand;
 
 /* Generic AT sequence handling, using the best AT port available and without
@@ -99,6 +106,20 @@ GVariant *mm_base_modem_at_sequence_full_finish (MMBaseModem                 *se
                                                  gpointer                    *response_processor_context,
                                                  GError                     **error);
 
+/* Command concatenation helpers used by the AT sequence handling */
+
+/* Number of batchable commands from @commands that may be sent in a single
+ * command line; 0 if @commands is before @no_batch_until, as the commands
+ * before that one must be sent one by one. */
+guint mm_base_modem_at_sequence_count_batchable      (const MMBaseModemAtCommand *commands,
+                                                      const MMBaseModemAtCommand *no_batch_until);
+
+/* Splits the compound response of the first @n_commands of @commands, or
+ * returns NULL if some response line cannot be mapped to a command */
+GStrv mm_base_modem_at_sequence_split_batch_response (const MMBaseModemAtCommand *commands,
+                                                      guint                       n_commands,
+                                                      const gchar                *response);
+
 /* Common helper response processors */
 
 /*
@@ -190,6 +211,17 @@ const gchar *mm_base_modem_at_command_finish (MMBaseModem          *self,
                                               GAsyncResult         *res,
                                               GError              **error);
 
+/* Same as mm_base_modem_at_command(), but explicitly setting the scheduling
+ * priority class of the command, e.g. BACKGROUND for periodic polling.
+ * Use mm_base_modem_at_command_finish() to get the result. */
+void         mm_base_modem_at_command_with_priority (MMBaseModem             *self,
+                                                     const gchar             *command,
+                                                     guint                    timeout,
+                                                     gboolean                 allow_cached,
+                                                     MMPortSchedulerPriority  priority,
+                                                     GAsyncReadyCallback      callback,
+                                                     gpointer                 user_data);
+
 /* Fully detailed AT command handling, when specific AT port and/or explicit
  * cancellations need to be used. */
 void         mm_base_modem_at_command_full        (MMBaseModem          *self,
@@ -205,6 +237,21 @@ const gchar *mm_base_modem_at_command_full_finish (MMBaseModem          *self,
                                                    GAsyncResult         *res,
                                                    GError              **error);
 
+/* Same as mm_base_modem_at_command_full(), but explicitly setting the
+ * scheduling priority class of the command, e.g. INTERACTIVE for commands
+ * a user is waiting for. Use mm_base_modem_at_command_full_finish() to get
+ * the result. */
+void         mm_base_modem_at_command_full_with_priority (MMBaseModem             *self,
+                                                          MMIfacePortAt           *port,
+                                                          const gchar             *command,
+                                                          guint                    timeout,
+                                                          gboolean                 allow_cached,
+                                                          gboolean                 is_raw,
+                                                          MMPortSchedulerPriority  priority,
+                                                          GCancellable            *cancellable,
+                                                          GAsyncReadyCallback      callback,
+                                                          gpointer                 user_data);
+
 /******************************************************************************/
 /* Support for MMBaseModemAtCommand with heap allocated contents */
 
@@ -216,6 +263,8 @@ typedef struct {
     gboolean  allow_cached;
     MMBaseModemAtResponseProcessor response_processor;
     guint     wait_seconds;
+    MMPortSchedulerPriority priority;
+    gboolean  batchable;
 } MMBaseModemAtCommandAlloc;
 
 G_STATIC_ASSERT (sizeof (MMBaseModemAtCommandAlloc) == sizeof (MMBaseModemAtCommand));
@@ -223,6 +272,8 @@ G_STATIC_ASSERT (G_STRUCT_OFFSET (MMBaseModemAtCommandAlloc, command)
 G_STATIC_ASSERT (G_STRUCT_OFFSET (MMBaseModemAtCommandAlloc, timeout)            == G_STRUCT_OFFSET (MMBaseModemAtCommand, timeout));
 G_STATIC_ASSERT (G_STRUCT_OFFSET (MMBaseModemAtCommandAlloc, allow_cached)       == G_STRUCT_OFFSET (MMBaseModemAtCommand, allow_cached));
 G_STATIC_ASSERT (G_STRUCT_OFFSET (MMBaseModemAtCommandAlloc, response_processor) == G_STRUCT_OFFSET (MMBaseModemAtCommand, response_processor));
+G_STATIC_ASSERT (G_STRUCT_OFFSET (MMBaseModemAtCommandAlloc, priority)           == G_STRUCT_OFFSET (MMBaseModemAtCommand, priority));
+G_STATIC_ASSERT (G_STRUCT_OFFSET (MMBaseModemAtCommandAlloc, batchable)          == G_STRUCT_OFFSET (MMBaseModemAtCommand, batchable));
 
 void mm_base_modem_at_command_alloc_clear (MMBaseModemAtCommandAlloc *command);
 
@@ -38,8 +38,10 @@
 #include "mm-port-enums-types.h"
 #include "mm-daemon-enums-types.h"
 #include "mm-serial-parsers.h"
+#include "mm-port-scheduler-prio.h"
 #include "mm-modem-helpers.h"
 #include "mm-bind.h"
+#include "mm-perf-stats.h"
 
 static void log_object_iface_init (MMLogObjectInterface *iface);
 static void auth_iface_init (MMIfaceAuthInterface *iface);
@@ -132,6 +134,9 @@ struct _MMBaseModemPrivate {
     /* Some audio-capable devices will have a port for audio specifically */
     MMPortSerial *audio;
 
+    /* Command scheduler shared by all AT ports, if enabled */
+    MMPortScheduler *at_scheduler;
+
 #if defined WITH_QMI
     /* QMI ports */
     GList *qmi;
@@ -146,7 +151,8 @@ struct _MMBaseModemPrivate {
      * organized ports */
     GHashTable *link_ports;
 
-    /* Scheduled operations. The forbidden_forever flag will be set to TRUE
+    /* Scheduled operations, both running and waiting, in the order they
+     * were requested. The forbidden_forever flag will be set to TRUE
      * if an "override" operation is requested, and will never be set to FALSE
      * back, it is expected the modem object will eventually be removed after
      * the operation has finished,
@@ -157,6 +163,8 @@ struct _MMBaseModemPrivate {
 
 static void   mm_base_modem_operation_lock        (MMBaseModem          *self,
                                                    MMOperationPriority   priority,
+                                                   MMOperationDomain     exclusive_domains,
+                                                   MMOperationDomain     shared_domains,
                                                    const gchar          *description,
                                                    GAsyncReadyCallback   callback,
                                                    gpointer              user_data);
@@ -497,6 +505,25 @@ base_modem_internal_grab_port (MMBaseModem         *self,
             at_pflags = MM_PORT_SERIAL_AT_FLAG_NONE;
 
         mm_port_serial_at_set_flags (MM_PORT_SERIAL_AT (port), at_pflags);
+
+        /* Ports known to accept concatenated extended commands in a single
+         * line may get AT sequences batched */
+        if (mm_kernel_device_get_property_as_boolean (kernel_device, "ID_MM_AT_CONCATENATION")) {
+            mm_obj_dbg (port, "AT port flagged as supporting command concatenation");
+            g_object_set (port, MM_PORT_SERIAL_AT_CONCATENATION, TRUE, NULL);
+        }
+
+        /* Optionally, let a single priority-aware scheduler arbitrate the
+         * commands of all AT ports, so that e.g. user requests sent through
+         * one port are not delayed by background polling in another one */
+        if (mm_context_get_test_port_priority_scheduler () ||
+            mm_kernel_device_get_global_property_as_boolean (kernel_device, "ID_MM_PORT_PRIORITY_SCHEDULER")) {
+            if (!self->priv->at_scheduler) {
+                mm_obj_dbg (self, "AT ports share a priority-aware command scheduler");
+                self->priv->at_scheduler = MM_PORT_SCHEDULER (mm_port_scheduler_prio_new ());
+            }
+            g_object_set (port, MM_PORT_SERIAL_SCHEDULER, self->priv->at_scheduler, NULL);
+        }
     }
 
     /* Add it to the tracking HT.
@@ -909,6 +936,8 @@ state_operation (MMBaseModem         *self,
     g_assert (operation_lock == MM_OPERATION_LOCK_REQUIRED);
     mm_base_modem_operation_lock (self,
                                   operation_priority,
+                                  MM_OPERATION_DOMAIN_ALL,
+                                  MM_OPERATION_DOMAIN_NONE,
                                   operation_description,
                                   (GAsyncReadyCallback) lock_before_state_operation_ready,
                                   task);
@@ -1864,11 +1893,13 @@ mm_base_modem_authorize (MMIfaceAuth *auth,
 }
 
 /*****************************************************************************/
-/* Exclusive operation */
+/* Operation lock */
 
 typedef struct {
     gssize               id;
     MMOperationPriority  priority;
+    MMOperationDomain    exclusive_domains;
+    MMOperationDomain    shared_domains;
     gchar               *description;
     GTask               *wait_task;
 } OperationInfo;
@@ -1881,7 +1912,13 @@ operation_info_free (OperationInfo *info)
     g_slice_free (OperationInfo, info);
 }
 
-/* Exclusive operation lock */
+static gboolean
+operations_conflict (OperationInfo *a,
+                     OperationInfo *b)
+{
+    return ((a->exclusive_domains & (b->exclusive_domains | b->shared_domains)) ||
+            (b->exclusive_domains & (a->exclusive_domains | a->shared_domains)));
+}
 
 static gssize
 mm_base_modem_operation_lock_finish (MMBaseModem   *self,
@@ -1894,25 +1931,47 @@ mm_base_modem_operation_lock_finish (MMBaseModem   *self,
 static void
 base_modem_operation_run (MMBaseModem *self)
 {
-    OperationInfo *info;
-    GTask         *task;
+    GList *l;
+    GList *acquired = NULL;
 
-    if (!self->priv->scheduled_operations)
-        return;
+    /* A waiting operation is run as soon as it doesn't conflict with any
+     * operation scheduled before, either running or waiting, so that
+     * conflicting operations are always run in the order they were
+     * requested. */
+    for (l = self->priv->scheduled_operations; l; l = g_list_next (l)) {
+        OperationInfo *info = l->data;
+        GList         *prev;
 
-    /* Do nothing if head operation is already running */
-    info = (OperationInfo *)(self->priv->scheduled_operations->data);
-    if (!info->wait_task)
-        return;
+        if (!info->wait_task)
+            continue;
 
-    /* Run the operation in head of the list */
-    mm_obj_dbg (self, "[operation %" G_GSSIZE_FORMAT "] %s - %s: lock acquired",
-                info->id,
-                mm_operation_priority_get_string (info->priority),
-                info->description);
-    task = g_steal_pointer (&info->wait_task);
-    g_task_return_int (task, info->id);
-    g_object_unref (task);
+        for (prev = self->priv->scheduled_operations; prev != l; prev = g_list_next (prev)) {
+            if (operations_conflict (info, (OperationInfo *)(prev->data)))
+                break;
+        }
+        if (prev != l)
+            continue;
+
+        mm_obj_dbg (self, "[operation %" G_GSSIZE_FORMAT "] %s - %s: lock acquired",
+                    info->id,
+                    mm_operation_priority_get_string (info->priority),
+                    info->description);
+        acquired = g_list_append (acquired, g_steal_pointer (&info->wait_task));
+    }
+
+    /* Complete the tasks only once the list is no longer being iterated, as
+     * the operations may be unlocked right away */
+    while (acquired) {
+        GTask         *task;
+        OperationInfo *info;
+
+        task = acquired->data;
+        acquired = g_list_delete_link (acquired, acquired);
+
+        info = g_task_get_task_data (task);
+        g_task_return_int (task, info->id);
+        g_object_unref (task);
+    }
 }
 
 static gboolean
@@ -1927,7 +1986,7 @@ abort_pending_operation_in_idle_cb (GTask *task)
 static void
 abort_pending_operations (MMBaseModem *self)
 {
-    GList *head = NULL;
+    GList *running = NULL;
     GList *abort_operations;
 
     /* Steal the whole list before iterating it */
@@ -1938,17 +1997,14 @@ abort_pending_operations (MMBaseModem *self)
         GTask         *task;
 
         info = (OperationInfo *)(abort_operations->data);
+        abort_operations = g_list_delete_link (abort_operations, abort_operations);
 
-        /* Head operation may already be running, we should not abort that one */
+        /* Operations may already be running, we should not abort those */
         if (!info->wait_task) {
-            /* Keep the head item as a single-element list */
-            g_assert (!head);
-            head = abort_operations;
-            abort_operations = g_list_remove_link (abort_operations, head);
+            running = g_list_append (running, info);
             continue;
         }
 
-        g_assert (info->wait_task);
         mm_obj_dbg (self, "[operation %" G_GSSIZE_FORMAT "] %s - %s: aborted early",
                     info->id,
                     mm_operation_priority_get_string (info->priority),
@@ -1956,24 +2012,27 @@ abort_pending_operations (MMBaseModem *self)
 
         task = g_steal_pointer (&info->wait_task);
         g_idle_add ((GSourceFunc) abort_pending_operation_in_idle_cb, task);
-        abort_operations = g_list_delete_link (abort_operations, abort_operations);
         operation_info_free (info);
     }
 
-    /* Keep the running head, if any, in the list of scheduled operations */
-    self->priv->scheduled_operations = head;
+    /* Keep the running operations, if any, in the list of scheduled operations */
+    self->priv->scheduled_operations = running;
 }
 
 static void
 mm_base_modem_operation_lock (MMBaseModem          *self,
                               MMOperationPriority   priority,
+                              MMOperationDomain     exclusive_domains,
+                              MMOperationDomain     shared_domains,
                               const gchar          *description,
                               GAsyncReadyCallback   callback,
                               gpointer              user_data)
 {
-    GTask          *task;
-    OperationInfo  *info;
-    static gssize   operation_id = 0;
+    GTask             *task;
+    OperationInfo     *info;
+    g_autofree gchar  *exclusive_str = NULL;
+    g_autofree gchar  *shared_str = NULL;
+    static gssize      operation_id = 0;
 
     task = g_task_new (self, NULL, callback, user_data);
     if (self->priv->scheduled_operations_forbidden_forever) {
@@ -1987,8 +2046,13 @@ mm_base_modem_operation_lock (MMBaseModem          *self,
     info = g_slice_new0 (OperationInfo);
     info->id = operation_id;
     info->priority = priority;
+    info->exclusive_domains = exclusive_domains;
+    info->shared_domains = shared_domains & ~exclusive_domains;
     info->description = g_strdup (description);
     info->wait_task = task;
+    /* The task doesn't own the info, it is only used to get the operation id
+     * when the lock is acquired */
+    g_task_set_task_data (task, info, NULL);
 
     if (operation_id == G_MAXSSIZE) {
         mm_obj_dbg (self, "operation id reset");
@@ -2004,12 +2068,20 @@ mm_base_modem_operation_lock (MMBaseModem          *self,
         g_assert (!self->priv->scheduled_operations_forbidden_forever);
         self->priv->scheduled_operations_forbidden_forever = TRUE;
         abort_pending_operations (self);
+        /* Override operations always lock all domains exclusively, so they
+         * wait for all running operations to finish */
+        info->exclusive_domains = MM_OPERATION_DOMAIN_ALL;
+        info->shared_domains = MM_OPERATION_DOMAIN_NONE;
         self->priv->scheduled_operations = g_list_append (self->priv->scheduled_operations, info);
     } else if (info->priority == MM_OPERATION_PRIORITY_DEFAULT) {
-        mm_obj_dbg (self, "[operation %" G_GSSIZE_FORMAT "] %s - %s: scheduled",
+        exclusive_str = mm_operation_domain_build_string_from_mask (info->exclusive_domains);
+        shared_str = mm_operation_domain_build_string_from_mask (info->shared_domains);
+        mm_obj_dbg (self, "[operation %" G_GSSIZE_FORMAT "] %s - %s: scheduled (exclusive: %s, shared: %s)",
                     info->id,
                     mm_operation_priority_get_string (info->priority),
-                    info->description);
+                    info->description,
+                    exclusive_str,
+                    shared_str);
         self->priv->scheduled_operations = g_list_append (self->priv->scheduled_operations, info);
     } else
         g_assert_not_reached ();
@@ -2017,32 +2089,35 @@ mm_base_modem_operation_lock (MMBaseModem          *self,
     base_modem_operation_run (self);
 }
 
-/* Exclusive operation unlock */
+/* Operation unlock */
 
 static void
 mm_base_modem_operation_unlock (MMIfaceOpLock *_self,
                                 gssize         operation_id)
 {
     MMBaseModem   *self = MM_BASE_MODEM (_self);
-    OperationInfo *info;
-
-    g_assert (self->priv->scheduled_operations);
+    OperationInfo *info = NULL;
+    GList         *l;
 
-    info = (OperationInfo *)(self->priv->scheduled_operations->data);
+    for (l = self->priv->scheduled_operations; l; l = g_list_next (l)) {
+        if (((OperationInfo *)(l->data))->id == operation_id) {
+            info = l->data;
+            break;
+        }
+    }
+    g_assert (info);
     g_assert (!info->wait_task);
-    g_assert (info->id == operation_id);
 
     mm_obj_dbg (self, "[operation %" G_GSSIZE_FORMAT "] %s - %s: lock released",
                 info->id,
                 mm_operation_priority_get_string (info->priority),
                 info->description);
 
-    /* Remove head list item and free its contents */
-    self->priv->scheduled_operations = g_list_delete_link (self->priv->scheduled_operations,
-                                                           self->priv->scheduled_operations);
+    /* Remove list item and free its contents */
+    self->priv->scheduled_operations = g_list_delete_link (self->priv->scheduled_operations, l);
     operation_info_free (info);
 
-    /* Run next, if any */
+    /* Run next ones, if any */
     base_modem_operation_run (self);
 }
 
@@ -2051,6 +2126,8 @@ mm_base_modem_operation_unlock (MMIfaceOpLock *_self,
 typedef struct {
     GDBusMethodInvocation *invocation;
     MMOperationPriority    operation_priority;
+    MMOperationDomain      exclusive_domains;
+    MMOperationDomain      shared_domains;
     gchar                 *operation_description;
 } AuthorizeAndOperationLockContext;
 
@@ -2103,6 +2180,8 @@ authorize_before_lock_ready (MMIfaceAuth  *auth,
     ctx = g_task_get_task_data (task);
     mm_base_modem_operation_lock (MM_BASE_MODEM (auth),
                                   ctx->operation_priority,
+                                  ctx->exclusive_domains,
+                                  ctx->shared_domains,
                                   ctx->operation_description,
                                   (GAsyncReadyCallback) lock_after_authorize_ready,
                                   task);
@@ -2113,6 +2192,8 @@ mm_base_modem_authorize_and_operation_lock (MMIfaceOpLock         *self,
                                             GDBusMethodInvocation *invocation,
                                             const gchar           *authorization,
                                             MMOperationPriority    operation_priority,
+                                            MMOperationDomain      exclusive_domains,
+                                            MMOperationDomain      shared_domains,
                                             const gchar           *operation_description,
                                             GAsyncReadyCallback    callback,
                                             gpointer               user_data)
@@ -2125,6 +2206,8 @@ mm_base_modem_authorize_and_operation_lock (MMIfaceOpLock         *self,
     ctx = g_slice_new0 (AuthorizeAndOperationLockContext);
     ctx->invocation = g_object_ref (invocation);
     ctx->operation_priority = operation_priority;
+    ctx->exclusive_domains = exclusive_domains;
+    ctx->shared_domains = shared_domains;
     ctx->operation_description = g_strdup (operation_description);
     g_task_set_task_data (task, ctx, (GDestroyNotify)authorize_and_operation_lock_context_free);
 
@@ -2436,6 +2519,45 @@ mm_base_modem_teardown_ports (MMBaseModem         *self,
     teardown_context_unref (ctx);
 }
 
+/*****************************************************************************/
+/* Performance stats: D-Bus property changes, per interface */
+
+#define PERF_STAT_TAG "perf-stat-tag"
+static GQuark perf_stat_quark;
+
+static void
+interface_property_notify_cb (GDBusInterfaceSkeleton *skeleton)
+{
+    MMPerfStat *stat;
+
+    if (!mm_perf_stats_enabled ())
+        return;
+
+    stat = g_object_get_qdata (G_OBJECT (skeleton), perf_stat_quark);
+    if (G_UNLIKELY (!stat)) {
+        stat = mm_perf_stats_lookup ("dbus-property-changes", g_dbus_interface_skeleton_get_info (skeleton)->name);
+        g_object_set_qdata (G_OBJECT (skeleton), perf_stat_quark, stat);
+    }
+    _mm_perf_stat_add (stat, 1);
+}
+
+static void
+interface_added_cb (MMBaseModem    *self,
+                    GDBusInterface *interface)
+{
+    /* Skeletons only notify property changes that are emitted over D-Bus */
+    g_signal_connect (interface, "notify", G_CALLBACK (interface_property_notify_cb), NULL);
+}
+
+static void
+setup_perf_stats (MMBaseModem *self)
+{
+    if (G_UNLIKELY (!perf_stat_quark))
+        perf_stat_quark = g_quark_from_static_string (PERF_STAT_TAG);
+
+    g_signal_connect (self, "interface-added", G_CALLBACK (interface_added_cb), NULL);
+}
+
 /*****************************************************************************/
 
 static gchar *
@@ -2478,6 +2600,9 @@ mm_base_modem_init (MMBaseModem *self)
 
     setup_ports_table (&self->priv->ports);
     setup_ports_table (&self->priv->link_ports);
+
+    if (mm_perf_stats_enabled ())
+        setup_perf_stats (self);
 }
 
 static void
@@ -2648,6 +2773,7 @@ dispose (GObject *object)
     g_clear_object (&self->priv->gps_control);
     g_clear_object (&self->priv->gps);
     g_clear_object (&self->priv->audio);
+    g_clear_object (&self->priv->at_scheduler);
 #if defined WITH_QMI
     g_list_free_full (g_steal_pointer (&self->priv->qmi), g_object_unref);
 #endif
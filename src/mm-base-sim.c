@@ -23,6 +23,8 @@
 #include <string.h>
 #include <ctype.h>
 
+#include <glib/gstdio.h>
+
 #include <ModemManager.h>
 #define _LIBMM_INSIDE_MM
 #include <libmm-glib.h>
@@ -35,6 +37,7 @@
 #include "mm-modem-helpers.h"
 #include "mm-error-helpers.h"
 #include "mm-bind.h"
+#include "mm-sim-cache.h"
 
 static void async_initable_iface_init (GAsyncInitableIface *iface);
 static void log_object_iface_init     (MMLogObjectInterface *iface);
@@ -104,6 +107,132 @@ mm_base_sim_is_esim_without_profiles (MMBaseSim *self)
     return IS_ESIM_WITHOUT_PROFILES (self);
 }
 
+/*****************************************************************************/
+/* SIM file cache */
+
+static gboolean
+load_cache (MMBaseSim *self)
+{
+    const gchar         *iccid;
+    const gchar         *imsi;
+    g_autofree gchar    *filename = NULL;
+    g_autoptr(GKeyFile)  key_file = NULL;
+    g_autoptr(GError)    error = NULL;
+    g_autofree gchar    *operator_identifier = NULL;
+    g_autofree gchar    *operator_name = NULL;
+    g_auto(GStrv)        emergency_numbers = NULL;
+    g_autofree gchar    *gid1 = NULL;
+    g_autofree gchar    *gid2 = NULL;
+
+    iccid = mm_gdbus_sim_get_sim_identifier (MM_GDBUS_SIM (self));
+    imsi = mm_gdbus_sim_get_imsi (MM_GDBUS_SIM (self));
+    if (!iccid || !imsi)
+        return FALSE;
+
+    filename = mm_sim_cache_build_filename (iccid);
+    key_file = mm_sim_cache_load (filename, iccid, imsi, &error);
+    if (!key_file) {
+        mm_obj_dbg (self, "SIM file cache not available: %s", error->message);
+        return FALSE;
+    }
+
+    operator_identifier = g_key_file_get_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_OPERATOR_IDENTIFIER, NULL);
+    if (operator_identifier)
+        mm_gdbus_sim_set_operator_identifier (MM_GDBUS_SIM (self), operator_identifier);
+
+    operator_name = g_key_file_get_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_OPERATOR_NAME, NULL);
+    if (operator_name)
+        mm_gdbus_sim_set_operator_name (MM_GDBUS_SIM (self), operator_name);
+
+    emergency_numbers = g_key_file_get_string_list (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_EMERGENCY_NUMBERS, NULL, NULL);
+    if (emergency_numbers)
+        mm_gdbus_sim_set_emergency_numbers (MM_GDBUS_SIM (self), (const gchar *const *) emergency_numbers);
+
+    gid1 = g_key_file_get_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_GID1, NULL);
+    gid2 = g_key_file_get_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_GID2, NULL);
+    if (gid1 || gid2) {
+        g_autofree guint8 *bin = NULL;
+        gsize              bin_len = 0;
+
+        if (gid1 && (bin = mm_utils_hexstr2bin (gid1, -1, &bin_len, NULL)))
+            mm_gdbus_sim_set_gid1 (MM_GDBUS_SIM (self),
+                                   g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE, bin, bin_len, sizeof (guint8)));
+        g_clear_pointer (&bin, g_free);
+        if (gid2 && (bin = mm_utils_hexstr2bin (gid2, -1, &bin_len, NULL)))
+            mm_gdbus_sim_set_gid2 (MM_GDBUS_SIM (self),
+                                   g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE, bin, bin_len, sizeof (guint8)));
+    }
+
+    mm_obj_info (self, "loaded SIM files from cache");
+    return TRUE;
+}
+
+static gchar *
+build_gid_string (GVariant *gid)
+{
+    const guint8 *data;
+    gsize         len = 0;
+
+    if (!gid)
+        return NULL;
+    data = g_variant_get_fixed_array (gid, &len, sizeof (guint8));
+    return mm_utils_bin2hexstr (data, len);
+}
+
+static void
+save_cache (MMBaseSim *self)
+{
+    const gchar         *iccid;
+    const gchar         *imsi;
+    const gchar         *str;
+    const gchar *const  *strv;
+    g_autofree gchar    *filename = NULL;
+    g_autofree gchar    *gid1 = NULL;
+    g_autofree gchar    *gid2 = NULL;
+    g_autoptr(GKeyFile)  key_file = NULL;
+    g_autoptr(GError)    error = NULL;
+
+    iccid = mm_gdbus_sim_get_sim_identifier (MM_GDBUS_SIM (self));
+    imsi = mm_gdbus_sim_get_imsi (MM_GDBUS_SIM (self));
+    if (!iccid || !imsi)
+        return;
+
+    key_file = g_key_file_new ();
+    if ((str = mm_gdbus_sim_get_operator_identifier (MM_GDBUS_SIM (self))) != NULL)
+        g_key_file_set_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_OPERATOR_IDENTIFIER, str);
+    if ((str = mm_gdbus_sim_get_operator_name (MM_GDBUS_SIM (self))) != NULL)
+        g_key_file_set_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_OPERATOR_NAME, str);
+    if ((strv = mm_gdbus_sim_get_emergency_numbers (MM_GDBUS_SIM (self))) != NULL)
+        g_key_file_set_string_list (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_EMERGENCY_NUMBERS, strv, g_strv_length ((GStrv) strv));
+    if ((gid1 = build_gid_string (mm_gdbus_sim_get_gid1 (MM_GDBUS_SIM (self)))) != NULL)
+        g_key_file_set_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_GID1, gid1);
+    if ((gid2 = build_gid_string (mm_gdbus_sim_get_gid2 (MM_GDBUS_SIM (self)))) != NULL)
+        g_key_file_set_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_GID2, gid2);
+
+    /* Nothing worth caching */
+    if (!g_key_file_has_group (key_file, MM_SIM_CACHE_GROUP))
+        return;
+
+    filename = mm_sim_cache_build_filename (iccid);
+    if (!mm_sim_cache_save (filename, iccid, imsi, key_file, &error))
+        mm_obj_dbg (self, "couldn't save SIM file cache: %s", error->message);
+}
+
+void
+mm_base_sim_invalidate_cache (MMBaseSim *self)
+{
+    const gchar      *iccid;
+    g_autofree gchar *filename = NULL;
+
+    iccid = mm_gdbus_sim_get_sim_identifier (MM_GDBUS_SIM (self));
+    if (!iccid)
+        return;
+
+    filename = mm_sim_cache_build_filename (iccid);
+    if (g_unlink (filename) == 0)
+        mm_obj_dbg (self, "SIM file cache removed");
+}
+
 /*****************************************************************************/
 
 void
@@ -1074,9 +1203,12 @@ check_preferred_networks_disabled (MMBaseSim *self)
  * the following steps:
  * 1. Using AT+CPOL=? to get SIM capacity; the capacity is checked to ensure
  *    that the list is not too large for the SIM card.
- * 2. Reading existing preferred networks from SIM with AT+CPOL?.
- * 3. Clearing existing networks with a series of AT+CPOL=<index> commands.
- * 4. Setting the new list by invoking AT+CPOL for each network.
+ * 2. Reading existing preferred networks from SIM with AT+CPOL?, and comparing
+ *    them with the new list, as each write to the SIM is slow.
+ * 3. Clearing the existing networks beyond the end of the new list, and the
+ *    ones that would otherwise be duplicated when the list is reordered, with
+ *    a series of AT+CPOL=<index> commands.
+ * 4. Setting the networks that changed by invoking AT+CPOL for each of them.
  *
  * There are some complications with AT+CPOL handling which makes the work more
  * difficult for us. It seems that modems can only handle a certain exact number
@@ -1098,11 +1230,13 @@ typedef struct {
     GList    *set_list;
     /* AT+CPOL indices that must be cleared before setting the networks. */
     GArray   *clear_index;
+    /* Positions in set_list of the networks that must be set (0 = first) */
+    GArray   *write_index;
     /* Number of access technology identifiers we will set. */
     guint     act_count;
     /* If TRUE, we know that act_count is something the modem can handle */
     gboolean  act_count_verified;
-    /* Index of preferred network currently being set (0 = first) */
+    /* Index in write_index of the preferred network currently being set */
     guint     current_write_index;
     /* Operation error code */
     GError   *error;
@@ -1114,6 +1248,7 @@ set_preferred_network_context_free (SetPreferredNetworksContext *ctx)
     g_list_free_full (ctx->set_list, (GDestroyNotify) mm_sim_preferred_network_free);
     g_clear_error (&ctx->error);
     g_array_free (ctx->clear_index, TRUE);
+    g_array_free (ctx->write_index, TRUE);
     g_slice_free (SetPreferredNetworksContext, ctx);
 }
 
@@ -1126,16 +1261,26 @@ set_preferred_networks_finish (MMBaseSim *self,
 }
 
 static void
-parse_old_preferred_networks (const gchar *response,
+parse_old_preferred_networks (MMBaseSim                   *self,
+                              const gchar                 *response,
                               SetPreferredNetworksContext *ctx)
 {
-    gchar **entries;
-    gchar **iter;
+    g_auto(GStrv)        entries = NULL;
+    g_autoptr(GPtrArray) old_networks = NULL;
+    gchar              **iter;
+
+    old_networks = g_ptr_array_new_with_free_func ((GDestroyNotify) mm_sim_preferred_network_free);
 
     entries = g_strsplit_set (response, "\r\n", -1);
     for (iter = entries; iter && *iter; iter++) {
-        guint index;
-        guint act_count = 0;
+        g_autofree gchar *operator_code = NULL;
+        guint             index;
+        guint             act_count = 0;
+        gboolean          gsm = FALSE;
+        gboolean          gsm_compact = FALSE;
+        gboolean          utran = FALSE;
+        gboolean          eutran = FALSE;
+        gboolean          ngran = FALSE;
 
         g_strstrip (*iter);
         if (strlen (*iter) == 0)
@@ -1143,20 +1288,46 @@ parse_old_preferred_networks (const gchar *response,
 
         if (mm_sim_parse_cpol_query_response (*iter,
                                               &index,
-                                              NULL, NULL, NULL, NULL, NULL, NULL,
+                                              &operator_code,
+                                              &gsm, &gsm_compact, &utran, &eutran, &ngran,
                                               &act_count,
                                               NULL) && index > 0) {
+            MMSimPreferredNetwork   *network;
+            MMModemAccessTechnology  act = MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN;
+
             /* Remember how many access technologies the modem/SIM can take */
             if (!ctx->act_count_verified || act_count > ctx->act_count) {
                 ctx->act_count = act_count;
                 ctx->act_count_verified = TRUE;
             }
 
-            /* Store the index to be cleared */
-            g_array_append_val (ctx->clear_index, index);
+            if (gsm)
+                act |= MM_MODEM_ACCESS_TECHNOLOGY_GSM;
+            if (gsm_compact)
+                act |= MM_MODEM_ACCESS_TECHNOLOGY_GSM_COMPACT;
+            if (utran)
+                act |= MM_MODEM_ACCESS_TECHNOLOGY_UMTS;
+            if (eutran)
+                act |= MM_MODEM_ACCESS_TECHNOLOGY_LTE;
+            if (ngran)
+                act |= MM_MODEM_ACCESS_TECHNOLOGY_5GNR;
+
+            network = mm_sim_preferred_network_new ();
+            mm_sim_preferred_network_set_operator_code (network, operator_code);
+            mm_sim_preferred_network_set_access_technology (network, act);
+            if (index > old_networks->len)
+                g_ptr_array_set_size (old_networks, index);
+            if (g_ptr_array_index (old_networks, index - 1))
+                mm_sim_preferred_network_free (g_ptr_array_index (old_networks, index - 1));
+            g_ptr_array_index (old_networks, index - 1) = network;
         }
     }
-    g_strfreev (entries);
+
+    mm_sim_preferred_networks_diff (old_networks, ctx->set_list, ctx->clear_index, ctx->write_index);
+
+    mm_obj_dbg (self, "preferred networks to set: %u, to clear: %u, unchanged: %u",
+                ctx->write_index->len, ctx->clear_index->len,
+                g_list_length (ctx->set_list) - ctx->write_index->len);
 }
 
 /* This function is called only in error case, after reloading the network list from SIM. */
@@ -1304,12 +1475,12 @@ set_preferred_networks_set_next (MMBaseSim  *self,
     MMSimPreferredNetwork       *current_network;
     const gchar                 *operator_code;
     MMModemAccessTechnology      act;
+    guint                        position;
     GError                      *error = NULL;
 
     ctx = g_task_get_task_data (task);
 
-    current_network = (MMSimPreferredNetwork *) g_list_nth_data (ctx->set_list, ctx->current_write_index);
-    if (current_network == NULL) {
+    if (ctx->current_write_index >= ctx->write_index->len) {
         /* No more networks to set; we are done. */
         mm_obj_dbg (self, "setting preferred networks completed.");
         g_task_return_boolean (task, TRUE);
@@ -1317,6 +1488,10 @@ set_preferred_networks_set_next (MMBaseSim  *self,
         return;
     }
 
+    position = g_array_index (ctx->write_index, guint, ctx->current_write_index);
+    current_network = (MMSimPreferredNetwork *) g_list_nth_data (ctx->set_list, position);
+    g_assert (current_network);
+
     if (!set_preferred_networks_check_support (self, ctx, current_network, &error)) {
         set_preferred_network_reload_and_return_error (self, task, error);
         return;
@@ -1326,7 +1501,7 @@ set_preferred_networks_set_next (MMBaseSim  *self,
     act = mm_sim_preferred_network_get_access_technology (current_network);
 
     /* Assemble the command to set the network */
-    command = g_strdup_printf ("+CPOL=%u,2,\"%s\"%s%s%s%s%s", ctx->current_write_index + 1, operator_code,
+    command = g_strdup_printf ("+CPOL=%u,2,\"%s\"%s%s%s%s%s", position + 1, operator_code,
                                ctx->act_count == 0 ? "" : ((act & MM_MODEM_ACCESS_TECHNOLOGY_GSM) ? ",1" : ",0"),
                                ctx->act_count <= 1 ? "" : ((act & MM_MODEM_ACCESS_TECHNOLOGY_GSM_COMPACT) ? ",1" : ",0"),
                                ctx->act_count <= 2 ? "" : ((act & MM_MODEM_ACCESS_TECHNOLOGY_UMTS) ? ",1" : ",0"),
@@ -1413,7 +1588,7 @@ set_preferred_networks_load_existing_ready (MMBaseModem *modem,
         return;
     }
 
-    parse_old_preferred_networks (response, ctx);
+    parse_old_preferred_networks (self, response, ctx);
     set_preferred_networks_clear_next (self, task);
 }
 
@@ -1489,6 +1664,7 @@ set_preferred_networks (MMBaseSim *self,
     ctx = g_slice_new0 (SetPreferredNetworksContext);
     ctx->set_list = mm_sim_preferred_network_list_copy (preferred_network_list);
     ctx->clear_index = g_array_new (FALSE, TRUE, sizeof (guint));
+    ctx->write_index = g_array_new (FALSE, TRUE, sizeof (guint));
     if (mm_iface_modem_is_5g (MM_IFACE_MODEM (self->priv->modem)))
         ctx->act_count = 5;
     else if (mm_iface_modem_is_4g (MM_IFACE_MODEM (self->priv->modem)))
@@ -2403,20 +2579,30 @@ typedef enum {
     INITIALIZATION_STEP_ESIM_STATUS,
     INITIALIZATION_STEP_SIM_IDENTIFIER,
     INITIALIZATION_STEP_IMSI,
+    INITIALIZATION_STEP_LOAD_CACHE,
+    /* From OPERATOR_ID to GID2, loads may run in parallel */
     INITIALIZATION_STEP_OPERATOR_ID,
     INITIALIZATION_STEP_OPERATOR_NAME,
     INITIALIZATION_STEP_EMERGENCY_NUMBERS,
     INITIALIZATION_STEP_PREFERRED_NETWORKS,
     INITIALIZATION_STEP_GID1,
     INITIALIZATION_STEP_GID2,
+    INITIALIZATION_STEP_WAIT_FILES,
     INITIALIZATION_STEP_EID,
     INITIALIZATION_STEP_REMOVABILITY,
+    INITIALIZATION_STEP_SAVE_CACHE,
     INITIALIZATION_STEP_LAST
 } InitializationStep;
 
 struct _InitAsyncContext {
     InitializationStep step;
     guint sim_identifier_tries;
+    /* Whether the SIM file loads are run in parallel, and how many of them
+     * are still ongoing */
+    gboolean parallel;
+    guint    n_pending;
+    /* Whether the SIM files were loaded from the cache */
+    gboolean cache_loaded;
 };
 
 MMBaseSim *
@@ -2447,6 +2633,37 @@ initable_init_finish (GAsyncInitable  *initable,
     return g_task_propagate_boolean (G_TASK (result), error);
 }
 
+/* Called when a load operation started by the initialization is over */
+static void
+init_load_done (GTask *task)
+{
+    InitAsyncContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+
+    /* Loads run in parallel; go on only after the last one */
+    if (ctx->n_pending > 0) {
+        if (--ctx->n_pending == 0)
+            interface_initialization_step (task);
+        return;
+    }
+
+    /* Go on to next step */
+    ctx->step++;
+    interface_initialization_step (task);
+}
+
+/* Returns TRUE if the initialization must wait for the load operation just
+ * started to finish before going on to the next step */
+static gboolean
+init_load_started (InitAsyncContext *ctx)
+{
+    if (!ctx->parallel)
+        return TRUE;
+    ctx->n_pending++;
+    return FALSE;
+}
+
 #undef COMMON_STR_REPLY_READY_FN
 #define COMMON_STR_REPLY_READY_FN(NAME,DISPLAY,VALUE_FORMAT)                              \
     static void                                                                           \
@@ -2454,7 +2671,6 @@ initable_init_finish (GAsyncInitable  *initable,
                               GAsyncResult *res,                                          \
                               GTask        *task)                                         \
     {                                                                                     \
-        InitAsyncContext  *ctx;                                                           \
         g_autoptr(GError)  error = NULL;                                                  \
         g_autofree gchar  *val = NULL;                                                    \
                                                                                           \
@@ -2466,10 +2682,7 @@ initable_init_finish (GAsyncInitable  *initable,
         else                                                                              \
             mm_obj_info (self, "loaded %s: %s", DISPLAY, VALUE_FORMAT (val));             \
                                                                                           \
-        /* Go on to next step */                                                          \
-        ctx = g_task_get_task_data (task);                                                \
-        ctx->step++;                                                                      \
-        interface_initialization_step (task);                                             \
+        init_load_done (task);                                                            \
     }
 
 #undef STR_REPLY_READY_FN
@@ -2485,7 +2698,6 @@ initable_init_finish (GAsyncInitable  *initable,
                               GAsyncResult *res,                                      \
                               GTask        *task)                                     \
     {                                                                                 \
-        InitAsyncContext  *ctx;                                                       \
         g_autoptr(GError)  error = NULL;                                              \
         ENUM_TYPE          val;                                                       \
                                                                                       \
@@ -2497,10 +2709,7 @@ initable_init_finish (GAsyncInitable  *initable,
         else                                                                          \
             mm_obj_info (self, "loaded %s: %s", DISPLAY, ENUM_GET_STRING (val));      \
                                                                                       \
-        /* Go on to next step */                                                      \
-        ctx = g_task_get_task_data (task);                                            \
-        ctx->step++;                                                                  \
-        interface_initialization_step (task);                                         \
+        init_load_done (task);                                                        \
     }
 
 #undef BYTEARRAY_REPLY_READY_FN
@@ -2510,7 +2719,6 @@ initable_init_finish (GAsyncInitable  *initable,
                               GAsyncResult *res,                                  \
                               GTask        *task)                                 \
     {                                                                             \
-        InitAsyncContext      *ctx;                                               \
         g_autoptr(GError)      error = NULL;                                      \
         g_autoptr(GByteArray)  bytearray = NULL;                                  \
                                                                                   \
@@ -2532,10 +2740,7 @@ initable_init_finish (GAsyncInitable  *initable,
             mm_obj_info (self, "loaded %s: %s", DISPLAY, bytearray_str);          \
         }                                                                         \
                                                                                   \
-        /* Go on to next step */                                                  \
-        ctx = g_task_get_task_data (task);                                        \
-        ctx->step++;                                                              \
-        interface_initialization_step (task);                                     \
+        init_load_done (task);                                                    \
     }
 
 ENUM_REPLY_READY_FN         (removability, "removability", MMSimRemovability, mm_sim_removability_get_string)
@@ -2548,7 +2753,6 @@ init_load_preferred_networks_ready (MMBaseSim    *self,
                                     GAsyncResult *res,
                                     GTask        *task)
 {
-    InitAsyncContext  *ctx;
     g_autoptr(GError)  error = NULL;
     GList             *preferred_nets_list;
 
@@ -2577,10 +2781,7 @@ init_load_preferred_networks_ready (MMBaseSim    *self,
 
     g_list_free_full (preferred_nets_list, (GDestroyNotify) mm_sim_preferred_network_free);
 
-    /* Go on to next step */
-    ctx = g_task_get_task_data (task);
-    ctx->step++;
-    interface_initialization_step (task);
+    init_load_done (task);
 }
 
 static void
@@ -2588,7 +2789,6 @@ init_load_emergency_numbers_ready (MMBaseSim    *self,
                                    GAsyncResult *res,
                                    GTask        *task)
 {
-    InitAsyncContext  *ctx;
     g_autoptr(GError)  error = NULL;
     g_auto(GStrv)      str_list = NULL;
 
@@ -2607,10 +2807,7 @@ init_load_emergency_numbers_ready (MMBaseSim    *self,
 
     mm_gdbus_sim_set_emergency_numbers (MM_GDBUS_SIM (self), (const gchar *const *) str_list);
 
-    /* Go on to next step */
-    ctx = g_task_get_task_data (task);
-    ctx->step++;
-    interface_initialization_step (task);
+    init_load_done (task);
 }
 
 STR_REPLY_READY_FN          (operator_name,       "operator name")
@@ -2770,6 +2967,15 @@ interface_initialization_step (GTask *task)
         ctx->step++;
         /* Fall through */
 
+    case INITIALIZATION_STEP_LOAD_CACHE:
+        /* Static SIM files are loaded from the cache if the same SIM card was
+         * already seen; the steps below skip the values already known */
+        if (!IS_ESIM_WITHOUT_PROFILES (self))
+            ctx->cache_loaded = load_cache (self);
+        ctx->parallel = MM_BASE_SIM_GET_CLASS (self)->parallel_file_loads;
+        ctx->step++;
+        /* Fall through */
+
     case INITIALIZATION_STEP_OPERATOR_ID:
         /* Don't load operator ID if the SIM is known to be an eSIM without
          * profiles; otherwise (if physical SIM, or if eSIM with profile, or if
@@ -2783,7 +2989,8 @@ interface_initialization_step (GTask *task)
                 self,
                 (GAsyncReadyCallback)init_load_operator_identifier_ready,
                 task);
-            return;
+            if (init_load_started (ctx))
+                return;
         }
         ctx->step++;
         /* Fall through */
@@ -2801,7 +3008,8 @@ interface_initialization_step (GTask *task)
                 self,
                 (GAsyncReadyCallback)init_load_operator_name_ready,
                 task);
-            return;
+            if (init_load_started (ctx))
+                return;
         }
         ctx->step++;
         /* Fall through */
@@ -2819,7 +3027,8 @@ interface_initialization_step (GTask *task)
                 self,
                 (GAsyncReadyCallback)init_load_emergency_numbers_ready,
                 task);
-            return;
+            if (init_load_started (ctx))
+                return;
         }
         ctx->step++;
         /* Fall through */
@@ -2837,7 +3046,8 @@ interface_initialization_step (GTask *task)
                 self,
                 (GAsyncReadyCallback)init_load_preferred_networks_ready,
                 task);
-            return;
+            if (init_load_started (ctx))
+                return;
         }
         ctx->step++;
         /* Fall through */
@@ -2855,7 +3065,8 @@ interface_initialization_step (GTask *task)
                 self,
                 (GAsyncReadyCallback)init_load_gid1_ready,
                 task);
-            return;
+            if (init_load_started (ctx))
+                return;
         }
         ctx->step++;
         /* Fall through */
@@ -2873,11 +3084,21 @@ interface_initialization_step (GTask *task)
                 self,
                 (GAsyncReadyCallback)init_load_gid2_ready,
                 task);
-            return;
+            if (init_load_started (ctx))
+                return;
         }
         ctx->step++;
         /* Fall through */
 
+    case INITIALIZATION_STEP_WAIT_FILES:
+        /* Wait for the loads run in parallel, the last one to finish will
+         * resume the initialization */
+        ctx->parallel = FALSE;
+        if (ctx->n_pending > 0)
+            return;
+        ctx->step++;
+        /* Fall through */
+
     case INITIALIZATION_STEP_EID:
         /* Don't load EID if the SIM is known to be a physical SIM; otherwise
          * (if eSIM with or without profiles) try to load it. */
@@ -2910,6 +3131,12 @@ interface_initialization_step (GTask *task)
         ctx->step++;
         /* Fall through */
 
+    case INITIALIZATION_STEP_SAVE_CACHE:
+        if (!ctx->cache_loaded && !IS_ESIM_WITHOUT_PROFILES (self))
+            save_cache (self);
+        ctx->step++;
+        /* Fall through */
+
     case INITIALIZATION_STEP_LAST:
         /* We are done without errors! */
         g_task_return_boolean (task, TRUE);
@@ -2936,9 +3163,8 @@ common_init_async (GAsyncInitable *initable,
 
     self = MM_BASE_SIM (initable);
 
-    ctx = g_new (InitAsyncContext, 1);
+    ctx = g_new0 (InitAsyncContext, 1);
     ctx->step = INITIALIZATION_STEP_FIRST;
-    ctx->sim_identifier_tries = 0;
 
     task = g_task_new (self, cancellable, callback, user_data);
     g_task_set_task_data (task, ctx, g_free);
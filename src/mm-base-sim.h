@@ -207,6 +207,10 @@ struct _MMBaseSimClass {
     gboolean (* set_preferred_networks_finish) (MMBaseSim *self,
                                                 GAsyncResult *res,
                                                 GError **error);
+
+    /* Whether the SIM file loads that don't depend on each other may be
+     * run in parallel during initialization */
+    gboolean parallel_file_loads;
 };
 
 GType mm_base_sim_get_type (void);
@@ -274,4 +278,7 @@ gboolean     mm_base_sim_is_emergency_number (MMBaseSim   *self,
 
 gboolean     mm_base_sim_is_esim_without_profiles (MMBaseSim *self);
 
+/* Removes the persisted SIM file cache of this SIM card, if any */
+void         mm_base_sim_invalidate_cache (MMBaseSim *self);
+
 #endif /* MM_BASE_SIM_H */
@@ -1119,9 +1119,8 @@ mm_base_sms_singlepart_init (MMBaseSms     *self,
         return FALSE;
     }
 
-    /* Only export once properly created */
+    /* Exporting is left to the SMS list */
     self->priv->initialized = TRUE;
-    mm_base_sms_export (self);
     return TRUE;
 }
 
@@ -1156,13 +1155,12 @@ mm_base_sms_multipart_init (MMBaseSms     *self,
     if (!mm_base_sms_multipart_take_part (self, first_part, error))
         return FALSE;
 
-    /* We do export incomplete multipart messages, in order to be able to
-     *  request removal of all parts of those multipart SMS that will never
-     *  get completed.
+    /* Incomplete multipart messages may also be exported by the SMS list,
+     *  in order to be able to request removal of all parts of those
+     *  multipart SMS that will never get completed.
      * Only the STATE of the SMS object will be valid in the exported DBus
      *  interface.*/
     self->priv->initialized = TRUE;
-    mm_base_sms_export (self);
 
     return TRUE;
 }
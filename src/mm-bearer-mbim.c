@@ -155,7 +155,7 @@ packet_statistics_query_ready (MbimDevice   *device,
     guint64                 in_octets = 0;
     guint64                 out_octets = 0;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_packet_statistics_response_parse (
@@ -199,12 +199,12 @@ reload_stats (MMBaseBearer        *self,
 
     task = g_task_new (self, NULL, callback, user_data);
     message = (mbim_message_packet_statistics_query_new (NULL));
-    mbim_device_command (mm_port_mbim_peek_device (mbim),
-                         message,
-                         5,
-                         NULL,
-                         (GAsyncReadyCallback)packet_statistics_query_ready,
-                         task);
+    mm_port_mbim_device_command (mm_port_mbim_peek_device (mbim),
+                                 message,
+                                 5,
+                                 NULL,
+                                 (GAsyncReadyCallback)packet_statistics_query_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -296,10 +296,10 @@ connect_context_free (ConnectContext *ctx)
     g_assert (!ctx->async_slaac_notification_id);
 
     if (ctx->abort_on_failure) {
-        mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
-                             ctx->abort_on_failure,
-                             MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
-                             NULL, NULL, NULL);
+        mm_port_mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
+                                     ctx->abort_on_failure,
+                                     MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
+                                     NULL, NULL, NULL);
         mbim_message_unref (ctx->abort_on_failure);
     }
 
@@ -825,7 +825,7 @@ ip_configuration_query_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_ip_configuration_response_parse (
@@ -881,7 +881,7 @@ connect_set_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -977,7 +977,7 @@ ensure_disconnected_ready (MbimDevice   *device,
     ctx = g_task_get_task_data (task);
 
     /* Ignore all errors, just go on */
-    response = mbim_device_command_finish (device, res, NULL);
+    response = mm_port_mbim_device_command_finish (device, res, NULL);
 
     /* Keep on */
     ctx->step++;
@@ -998,7 +998,7 @@ check_disconnected_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, NULL);
+    response = mm_port_mbim_device_command_finish (device, res, NULL);
     if (response && mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, NULL)) {
         if (mbim_device_check_ms_mbimex_version (device, 3, 0))
             mbim_message_ms_basic_connect_v3_connect_response_parse (
@@ -1310,24 +1310,24 @@ connect_context_step (GTask *task)
                           0,
                           NULL);
 
-        mbim_device_command (device,
-                             message,
-                             10,
-                             g_task_get_cancellable (task),
-                             (GAsyncReadyCallback)check_disconnected_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     g_task_get_cancellable (task),
+                                     (GAsyncReadyCallback)check_disconnected_ready,
+                                     task);
         return;
     }
 
     case CONNECT_STEP_ENSURE_DISCONNECTED:
         mm_obj_dbg (self, "ensuring session %u is disconnected...", ctx->session_id);
         message = build_disconnect_message (self, ctx->mbim, ctx->session_id);
-        mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
-                             message,
-                             MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
-                             g_task_get_cancellable (task),
-                             (GAsyncReadyCallback)ensure_disconnected_ready,
-                             task);
+        mm_port_mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
+                                     message,
+                                     MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
+                                     g_task_get_cancellable (task),
+                                     (GAsyncReadyCallback)ensure_disconnected_ready,
+                                     task);
         return;
 
     case CONNECT_STEP_CONNECT: {
@@ -1364,12 +1364,12 @@ connect_context_step (GTask *task)
                           mbim_uuid_from_context_type (ctx->context_type),
                           NULL);
 
-        mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
-                             message,
-                             MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
-                             g_task_get_cancellable (task),
-                             (GAsyncReadyCallback)connect_set_ready,
-                             task);
+        mm_port_mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
+                                     message,
+                                     MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+                                     g_task_get_cancellable (task),
+                                     (GAsyncReadyCallback)connect_set_ready,
+                                     task);
         return;
     }
 
@@ -1392,12 +1392,12 @@ connect_context_step (GTask *task)
                       0, /* ipv4mtu */
                       0, /* ipv6mtu */
                       NULL);
-        mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
-                             message,
-                             60,
-                             g_task_get_cancellable (task),
-                             (GAsyncReadyCallback)ip_configuration_query_ready,
-                             task);
+        mm_port_mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
+                                     message,
+                                     60,
+                                     g_task_get_cancellable (task),
+                                     (GAsyncReadyCallback)ip_configuration_query_ready,
+                                     task);
         return;
 
     case CONNECT_STEP_IP_CONFIGURATION_ASYNC:
@@ -1672,7 +1672,7 @@ disconnect_set_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response)
         goto out;
 
@@ -1780,12 +1780,12 @@ disconnect_context_step (GTask *task)
         g_autoptr(MbimMessage) message = NULL;
 
         message = build_disconnect_message (self, ctx->mbim, ctx->session_id);
-        mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
-                             message,
-                             MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
-                             NULL,
-                             (GAsyncReadyCallback)disconnect_set_ready,
-                             task);
+        mm_port_mbim_device_command (mm_port_mbim_peek_device (ctx->mbim),
+                                     message,
+                                     MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT,
+                                     NULL,
+                                     (GAsyncReadyCallback)disconnect_set_ready,
+                                     task);
         return;
     }
 
@@ -1900,7 +1900,7 @@ reload_connection_status_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_prefix_error (&error, "Cannot load session ID '%u' status: ",
                         mm_bearer_mbim_get_session_id (MM_BEARER_MBIM (self)));
@@ -1998,12 +1998,12 @@ reload_connection_status (MMBaseBearer        *self,
                                               mbim_uuid_from_context_type (MBIM_CONTEXT_TYPE_INTERNET),
                                               0,
                                               NULL);
-    mbim_device_command (mm_port_mbim_peek_device (mbim),
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)reload_connection_status_ready,
-                         task);
+    mm_port_mbim_device_command (mm_port_mbim_peek_device (mbim),
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)reload_connection_status_ready,
+                                 task);
 }
 
 #endif /* WITH_SUSPEND_RESUME */
@@ -472,24 +472,43 @@ typedef enum {
     CONNECT_STEP_SETUP_LINK_MAIN_UP,
     CONNECT_STEP_IP_METHOD,
     CONNECT_STEP_IPV4,
-    CONNECT_STEP_WDS_CLIENT_IPV4,
-    CONNECT_STEP_BIND_DATA_PORT_IPV4,
-    CONNECT_STEP_IP_FAMILY_IPV4,
-    CONNECT_STEP_ENABLE_INDICATIONS_IPV4,
-    CONNECT_STEP_START_NETWORK_IPV4,
-    CONNECT_STEP_ENABLE_WDS_INDICATIONS_IPV4,
-    CONNECT_STEP_GET_CURRENT_SETTINGS_IPV4,
     CONNECT_STEP_IPV6,
-    CONNECT_STEP_WDS_CLIENT_IPV6,
-    CONNECT_STEP_BIND_DATA_PORT_IPV6,
-    CONNECT_STEP_IP_FAMILY_IPV6,
-    CONNECT_STEP_ENABLE_INDICATIONS_IPV6,
-    CONNECT_STEP_START_NETWORK_IPV6,
-    CONNECT_STEP_ENABLE_WDS_INDICATIONS_IPV6,
-    CONNECT_STEP_GET_CURRENT_SETTINGS_IPV6,
     CONNECT_STEP_LAST
 } ConnectStep;
 
+typedef enum {
+    CONNECT_FAMILY_STEP_FIRST,
+    CONNECT_FAMILY_STEP_WDS_CLIENT,
+    CONNECT_FAMILY_STEP_BIND_DATA_PORT,
+    CONNECT_FAMILY_STEP_IP_FAMILY,
+    CONNECT_FAMILY_STEP_ENABLE_INDICATIONS,
+    CONNECT_FAMILY_STEP_START_NETWORK,
+    CONNECT_FAMILY_STEP_ENABLE_WDS_INDICATIONS,
+    CONNECT_FAMILY_STEP_GET_CURRENT_SETTINGS,
+    CONNECT_FAMILY_STEP_LAST
+} ConnectFamilyStep;
+
+/* Connection setup of a single IP family, run on its own WDS client. Both
+ * IPv4 and IPv6 setups may be run in parallel, if enabled for the device.
+ * The start network request of each family has its own cancellable, so
+ * that a failure that also applies to the other family aborts it right
+ * away. */
+typedef struct {
+    GTask             *task; /* not owned */
+    gboolean           ipv6;
+    GCancellable      *cancellable;
+    ConnectFamilyStep  step;
+    QmiClientWds      *client;
+    guint              packet_service_status_indication_id;
+    guint              event_report_indication_id;
+    guint              extended_ip_config_change_id;
+    guint32            packet_data_handle;
+    MMBearerIpConfig  *config;
+    GError            *error;
+} ConnectFamilyContext;
+
+#define CONNECT_FAMILY_STR(family) ((family)->ipv6 ? "IPv6" : "IPv4")
+
 typedef struct {
     MMBearerQmi *self;
     MMBaseModem *modem;
@@ -516,25 +535,16 @@ typedef struct {
     gchar                         *link_name;
     MMPort                        *link;
 
-    gboolean          ipv4;
-    gboolean          running_ipv4;
-    QmiClientWds     *client_ipv4;
-    guint             packet_service_status_ipv4_indication_id;
-    guint             event_report_ipv4_indication_id;
-    guint32           packet_data_handle_ipv4;
-    MMBearerIpConfig *ipv4_config;
-    GError           *error_ipv4;
-
-    gboolean          ipv6;
-    gboolean          running_ipv6;
-    QmiClientWds     *client_ipv6;
-    guint             packet_service_status_ipv6_indication_id;
-    guint             event_report_ipv6_indication_id;
-    guint32           packet_data_handle_ipv6;
-    MMBearerIpConfig *ipv6_config;
-    GError           *error_ipv6;
-    guint             extended_ipv4_config_change_id;
-    guint             extended_ipv6_config_change_id;
+    gboolean              ipv4;
+    gboolean              ipv6;
+    gboolean              parallel;
+    ConnectFamilyContext  family_ipv4;
+    ConnectFamilyContext  family_ipv6;
+
+    /* Join of the per-family setups */
+    guint     n_families_running;
+    gboolean  families_aborted;
+    GError   *families_error;
 } ConnectContext;
 
 /* When using the WDS service, we may not only want to have explicit different
@@ -703,63 +713,50 @@ extended_ip_config_indication_received (QmiClientWds                           *
 /*****************************************************************************/
 
 static void
-connect_context_free (ConnectContext *ctx)
+connect_family_context_clear (MMBearerQmi          *self,
+                              ConnectFamilyContext *family)
 {
-    g_free (ctx->apn);
-    g_free (ctx->user);
-    g_free (ctx->password);
-
-    if (ctx->client_ipv4) {
-        if (ctx->packet_service_status_ipv4_indication_id) {
-            common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
-                                                                           ctx->client_ipv4,
+    if (family->client) {
+        if (family->packet_service_status_indication_id) {
+            common_setup_cleanup_packet_service_status_unsolicited_events (self,
+                                                                           family->client,
                                                                            FALSE,
-                                                                           &ctx->packet_service_status_ipv4_indication_id);
+                                                                           &family->packet_service_status_indication_id);
         }
-        if (ctx->event_report_ipv4_indication_id) {
-            cleanup_event_report_unsolicited_events (ctx->self,
-                                                     ctx->client_ipv4,
-                                                     &ctx->event_report_ipv4_indication_id);
+        if (family->event_report_indication_id) {
+            cleanup_event_report_unsolicited_events (self,
+                                                     family->client,
+                                                     &family->event_report_indication_id);
         }
-        if (ctx->extended_ipv4_config_change_id) {
-            g_signal_handler_disconnect (ctx->client_ipv4, ctx->extended_ipv4_config_change_id);
-            ctx->extended_ipv4_config_change_id = 0;
+        if (family->extended_ip_config_change_id) {
+            g_signal_handler_disconnect (family->client, family->extended_ip_config_change_id);
+            family->extended_ip_config_change_id = 0;
         }
-        if (ctx->packet_data_handle_ipv4) {
+        if (family->packet_data_handle) {
             g_autoptr(QmiMessageWdsStopNetworkInput) input = NULL;
 
             input = qmi_message_wds_stop_network_input_new ();
-            qmi_message_wds_stop_network_input_set_packet_data_handle (input, ctx->packet_data_handle_ipv4, NULL);
-            qmi_client_wds_stop_network (ctx->client_ipv4, input, MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT, NULL, NULL, NULL);
+            qmi_message_wds_stop_network_input_set_packet_data_handle (input, family->packet_data_handle, NULL);
+            qmi_client_wds_stop_network (family->client, input, MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT, NULL, NULL, NULL);
         }
-        g_clear_object (&ctx->client_ipv4);
+        g_clear_object (&family->client);
     }
 
-    if (ctx->client_ipv6) {
-        if (ctx->packet_service_status_ipv6_indication_id) {
-            common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
-                                                                           ctx->client_ipv6,
-                                                                           FALSE,
-                                                                           &ctx->packet_service_status_ipv6_indication_id);
-        }
-        if (ctx->event_report_ipv6_indication_id) {
-            cleanup_event_report_unsolicited_events (ctx->self,
-                                                     ctx->client_ipv6,
-                                                     &ctx->event_report_ipv6_indication_id);
-        }
-        if (ctx->extended_ipv6_config_change_id) {
-            g_signal_handler_disconnect (ctx->client_ipv6, ctx->extended_ipv6_config_change_id);
-            ctx->extended_ipv6_config_change_id = 0;
-        }
-        if (ctx->packet_data_handle_ipv6) {
-            g_autoptr(QmiMessageWdsStopNetworkInput) input = NULL;
+    g_clear_error (&family->error);
+    g_clear_object (&family->config);
+    g_clear_object (&family->cancellable);
+}
 
-            input = qmi_message_wds_stop_network_input_new ();
-            qmi_message_wds_stop_network_input_set_packet_data_handle (input, ctx->packet_data_handle_ipv6, NULL);
-            qmi_client_wds_stop_network (ctx->client_ipv6, input, MM_BASE_BEARER_DEFAULT_DISCONNECTION_TIMEOUT, NULL, NULL, NULL);
-        }
-        g_clear_object (&ctx->client_ipv6);
-    }
+static void
+connect_context_free (ConnectContext *ctx)
+{
+    g_free (ctx->apn);
+    g_free (ctx->user);
+    g_free (ctx->password);
+
+    connect_family_context_clear (ctx->self, &ctx->family_ipv4);
+    connect_family_context_clear (ctx->self, &ctx->family_ipv6);
+    g_clear_error (&ctx->families_error);
 
     if (ctx->link_name) {
         mm_port_qmi_cleanup_link (ctx->qmi, ctx->link_name, ctx->mux_id, NULL, NULL);
@@ -771,11 +768,6 @@ connect_context_free (ConnectContext *ctx)
     if (ctx->explicit_qmi_open)
         mm_port_qmi_close (ctx->qmi, NULL, NULL);
 
-    g_clear_error (&ctx->error_ipv4);
-    g_clear_error (&ctx->error_ipv6);
-    g_clear_object (&ctx->ipv4_config);
-    g_clear_object (&ctx->ipv6_config);
-
     g_clear_object (&ctx->data);
     g_clear_object (&ctx->qmi);
     g_clear_object (&ctx->modem);
@@ -813,6 +805,71 @@ complete_connect (GTask                 *task,
 }
 
 static void connect_context_step (GTask *task);
+static void connect_family_step  (ConnectFamilyContext *family);
+
+static ConnectContext *
+connect_family_get_context (ConnectFamilyContext *family)
+{
+    return g_task_get_task_data (family->task);
+}
+
+/* Finish the setup of a given family. A fatal error aborts the whole
+ * connection attempt; a non-fatal abort stops the setup of any family that
+ * has not started yet. The connection attempt keeps on once all running
+ * family setups have finished. */
+static void
+connect_family_finish (ConnectFamilyContext *family,
+                       gboolean              abort,
+                       GError               *fatal_error)
+{
+    ConnectContext *ctx;
+    GTask          *task;
+
+    task = family->task;
+    ctx = connect_family_get_context (family);
+    family->step = CONNECT_FAMILY_STEP_LAST;
+
+    if (fatal_error) {
+        mm_obj_dbg (ctx->self, "%s connection setup failed: %s", CONNECT_FAMILY_STR (family), fatal_error->message);
+        if (!ctx->families_error)
+            ctx->families_error = fatal_error;
+        else
+            g_error_free (fatal_error);
+    }
+    if (abort)
+        ctx->families_aborted = TRUE;
+
+    g_assert (ctx->n_families_running > 0);
+    if (--ctx->n_families_running > 0)
+        return;
+
+    if (ctx->families_error) {
+        complete_connect (task, NULL, g_steal_pointer (&ctx->families_error));
+        return;
+    }
+
+    if (ctx->families_aborted)
+        ctx->step = CONNECT_STEP_LAST;
+    else
+        ctx->step++;
+    connect_context_step (task);
+}
+
+static ConnectFamilyContext *
+connect_family_get_other (ConnectFamilyContext *family)
+{
+    ConnectContext *ctx;
+
+    ctx = connect_family_get_context (family);
+    return family->ipv6 ? &ctx->family_ipv4 : &ctx->family_ipv6;
+}
+
+static void
+connect_family_next_step (ConnectFamilyContext *family)
+{
+    family->step++;
+    connect_family_step (family);
+}
 
 static void
 qmi_inet4_ntop (guint32 address, char *buf, const gsize buflen)
@@ -1005,29 +1062,26 @@ get_ipv6_config (MMBearerQmi *self,
 }
 
 static void
-get_current_settings_ready (QmiClientWds *client,
-                            GAsyncResult *res,
-                            GTask *task)
+get_current_settings_ready (QmiClientWds         *client,
+                            GAsyncResult         *res,
+                            ConnectFamilyContext *family)
 {
     MMBearerQmi *self;
     ConnectContext *ctx;
     GError *error = NULL;
     QmiMessageWdsGetCurrentSettingsOutput *output;
 
-    self = g_task_get_source_object (task);
-    ctx  = g_task_get_task_data (task);
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
+    self = g_task_get_source_object (family->task);
+    ctx  = connect_family_get_context (family);
 
     output = qmi_client_wds_get_current_settings_finish (client, res, &error);
     if (!output || !qmi_message_wds_get_current_settings_output_get_result (output, &error)) {
-        MMBearerIpConfig *config;
-
         /* When we're using static IP address, the current settings are mandatory */
         if (ctx->ip_method == MM_BEARER_IP_METHOD_STATIC) {
             mm_obj_warn (self, "failed to retrieve mandatory IP settings: %s", error->message);
             if (output)
                 qmi_message_wds_get_current_settings_output_unref (output);
-            complete_connect (task, NULL, error);
+            connect_family_finish (family, FALSE, error);
             return;
         }
 
@@ -1035,15 +1089,9 @@ get_current_settings_ready (QmiClientWds *client,
         mm_obj_dbg (self, "couldn't get current settings: %s", error->message);
         g_error_free (error);
 
-        config = mm_bearer_ip_config_new ();
-        mm_bearer_ip_config_set_method (config, ctx->ip_method);
-
-        if (ctx->running_ipv4)
-            ctx->ipv4_config = config;
-        else if (ctx->running_ipv6)
-            ctx->ipv6_config = config;
-        else
-            g_assert_not_reached ();
+        g_clear_object (&family->config);
+        family->config = mm_bearer_ip_config_new ();
+        mm_bearer_ip_config_set_method (family->config, ctx->ip_method);
     } else {
         QmiWdsIpFamily ip_family = QMI_WDS_IP_FAMILY_UNSPECIFIED;
         guint32 mtu = 0;
@@ -1063,10 +1111,13 @@ get_current_settings_ready (QmiClientWds *client,
             g_clear_error (&error);
         }
 
-        if (ip_family == QMI_WDS_IP_FAMILY_IPV4)
-            ctx->ipv4_config = get_ipv4_config (ctx->self, ctx->ip_method, output, mtu);
-        else if (ip_family == QMI_WDS_IP_FAMILY_IPV6)
-            ctx->ipv6_config = get_ipv6_config (ctx->self, ctx->ip_method, output, mtu);
+        if (ip_family == QMI_WDS_IP_FAMILY_IPV4) {
+            g_clear_object (&ctx->family_ipv4.config);
+            ctx->family_ipv4.config = get_ipv4_config (ctx->self, ctx->ip_method, output, mtu);
+        } else if (ip_family == QMI_WDS_IP_FAMILY_IPV6) {
+            g_clear_object (&ctx->family_ipv6.config);
+            ctx->family_ipv6.config = get_ipv6_config (ctx->self, ctx->ip_method, output, mtu);
+        }
 
         /* Domain names */
         if (qmi_message_wds_get_current_settings_output_get_domain_name_list (output, &array, &error)) {
@@ -1092,21 +1143,19 @@ get_current_settings_ready (QmiClientWds *client,
         qmi_message_wds_get_current_settings_output_unref (output);
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    connect_family_next_step (family);
 }
 
 static void
-get_current_settings (GTask *task, QmiClientWds *client)
+get_current_settings (ConnectFamilyContext *family)
 {
     MMBearerQmi                           *self;
     ConnectContext                        *ctx;
     QmiMessageWdsGetCurrentSettingsInput  *input;
     QmiWdsRequestedSettings                requested;
 
-    self = g_task_get_source_object (task);
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
+    self = g_task_get_source_object (family->task);
+    ctx = connect_family_get_context (family);
 
     requested = QMI_WDS_REQUESTED_SETTINGS_DNS_ADDRESS |
                 QMI_WDS_REQUESTED_SETTINGS_GRANTED_QOS |
@@ -1126,93 +1175,61 @@ get_current_settings (GTask *task, QmiClientWds *client)
 
     input = qmi_message_wds_get_current_settings_input_new ();
     qmi_message_wds_get_current_settings_input_set_requested_settings (input, requested, NULL);
-    qmi_client_wds_get_current_settings (client,
+    qmi_client_wds_get_current_settings (family->client,
                                          input,
                                          10,
-                                         g_task_get_cancellable (task),
+                                         g_task_get_cancellable (family->task),
                                          (GAsyncReadyCallback)get_current_settings_ready,
-                                         task);
+                                         family);
     qmi_message_wds_get_current_settings_input_unref (input);
 }
 
 static void
-wds_indication_register_response_ready (QmiClientWds *client,
-                                        GAsyncResult *res,
-                                        GTask        *task)
+wds_indication_register_response_ready (QmiClientWds         *client,
+                                        GAsyncResult         *res,
+                                        ConnectFamilyContext *family)
 {
-    MMBearerQmi                           *self;
-    ConnectContext                        *ctx;
-    QmiMessageWdsIndicationRegisterOutput *output;
-    GError                                *error = NULL;
-
-    self = g_task_get_source_object (task);
-    ctx = g_task_get_task_data (task);
-    output = qmi_client_wds_indication_register_finish (client, res, &error);
+    MMBearerQmi                                      *self;
+    g_autoptr(QmiMessageWdsIndicationRegisterOutput)  output = NULL;
+    g_autoptr(GError)                                 error = NULL;
 
-    if (!output) {
-        mm_obj_warn (self, "error: operation failed: %s", error->message);
-        g_error_free (error);
-        ctx->step++;
-        connect_context_step (task);
-        return;
-    }
+    self = g_task_get_source_object (family->task);
 
-    if (!qmi_message_wds_indication_register_output_get_result (output, &error)) {
-        mm_obj_warn (self, "error: could not register for indication: %s", error->message);
-        qmi_message_wds_indication_register_output_unref (output);
-        g_error_free (error);
-        ctx->step++;
-        connect_context_step (task);
-        return;
-    }
-    qmi_message_wds_indication_register_output_unref (output);
-    if (ctx->running_ipv4) {
-        mm_obj_dbg (self, "v4 extended ip config indication registered successfully");
-        g_assert (ctx->extended_ipv4_config_change_id == 0);
-        ctx->extended_ipv4_config_change_id =
-            g_signal_connect (client,
-                              "extended-ip-config",
-                              G_CALLBACK (extended_ip_config_indication_received),
-                              self);
-    } else {
-        mm_obj_dbg (self, "v6 extended ip Config indication registered successfully");
-        g_assert (ctx->extended_ipv6_config_change_id == 0);
-        ctx->extended_ipv6_config_change_id =
+    output = qmi_client_wds_indication_register_finish (client, res, &error);
+    if (!output || !qmi_message_wds_indication_register_output_get_result (output, &error))
+        mm_obj_warn (self, "error: could not register for %s extended ip config indication: %s",
+                     CONNECT_FAMILY_STR (family), error->message);
+    else {
+        mm_obj_dbg (self, "%s extended ip config indication registered successfully", CONNECT_FAMILY_STR (family));
+        g_assert (family->extended_ip_config_change_id == 0);
+        family->extended_ip_config_change_id =
             g_signal_connect (client,
                               "extended-ip-config",
                               G_CALLBACK (extended_ip_config_indication_received),
                               self);
     }
-    ctx->step++;
-    connect_context_step (task);
+
+    connect_family_next_step (family);
 }
 
 static void
-register_for_wds_indication (ConnectContext *ctx,
-                             GTask          *task)
+register_for_wds_indication (ConnectFamilyContext *family)
 {
     QmiMessageWdsIndicationRegisterInput *input;
-    QmiClientWds *client;
     MMBearerQmi *self;
 
-    input = qmi_message_wds_indication_register_input_new ();
-    self = g_task_get_source_object (task);
+    self = g_task_get_source_object (family->task);
+    mm_obj_dbg (self, "registering for wds extended ip %s info indication", CONNECT_FAMILY_STR (family));
 
-    if (ctx->running_ipv4) {
-        client = ctx->client_ipv4;
-        mm_obj_dbg (self, "registering for wds extended ip V4 info indication");
-    } else {
-        client = ctx->client_ipv6;
-        mm_obj_dbg (self, "registering for wds extended ip V6 info indication");
-    }
+    input = qmi_message_wds_indication_register_input_new ();
     qmi_message_wds_indication_register_input_set_report_extended_ip_configuration_change (input, TRUE, NULL);
     qmi_client_wds_indication_register (
-        client,
+        family->client,
         input,
         10,
-        g_task_get_cancellable (task),
+        g_task_get_cancellable (family->task),
         (GAsyncReadyCallback) wds_indication_register_response_ready,
-        task);
+        family);
     qmi_message_wds_indication_register_input_unref (input);
 }
 
@@ -1251,23 +1268,45 @@ error_from_start_network_output (MMBearerQmi                     *self,
     return g_error_new_literal (MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_UNKNOWN, "Call failed");
 }
 
+/* Errors reported by the network that don't depend on the IP family, so
+ * the start network request of the other family would fail as well */
+static gboolean
+start_network_error_applies_to_all_families (const GError *error)
+{
+    return (g_error_matches (error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_USER_AUTHENTICATION_FAILED) ||
+            g_error_matches (error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_MISSING_OR_UNKNOWN_APN) ||
+            g_error_matches (error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_SERVICE_OPTION_NOT_SUBSCRIBED) ||
+            g_error_matches (error, MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_OPERATOR_DETERMINED_BARRING));
+}
+
 static void
-start_network_ready (QmiClientWds *client,
-                     GAsyncResult *res,
-                     GTask *task)
+start_network_ready (QmiClientWds         *client,
+                     GAsyncResult         *res,
+                     ConnectFamilyContext *family)
 {
     MMBearerQmi *self;
-    ConnectContext *ctx;
     GError *error = NULL;
     QmiMessageWdsStartNetworkOutput *output;
+    ConnectFamilyContext *other;
 
-    self = g_task_get_source_object (task);
-    ctx  = g_task_get_task_data (task);
-
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
+    self = g_task_get_source_object (family->task);
+    other = connect_family_get_other (family);
 
     output = qmi_client_wds_start_network_finish (client, res, &error);
+
+    /* Aborted because the start network request of the other family failed
+     * with an error that applies to this one as well */
+    if (!output &&
+        g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED) &&
+        !g_cancellable_is_cancelled (g_task_get_cancellable (family->task)) &&
+        other->error) {
+        mm_obj_dbg (self, "%s connection attempt aborted: %s", CONNECT_FAMILY_STR (family), other->error->message);
+        g_clear_error (&error);
+        family->error = g_error_copy (other->error);
+        connect_family_next_step (family);
+        return;
+    }
+
     if (output && !qmi_message_wds_start_network_output_get_result (output, &error)) {
         /* No-effect errors should be ignored. The modem will keep the
          * connection active as long as there is a WDS client which requested
@@ -1276,48 +1315,43 @@ start_network_ready (QmiClientWds *client,
          * modem would just keep connected. */
         if (g_error_matches (error, QMI_PROTOCOL_ERROR, QMI_PROTOCOL_ERROR_NO_EFFECT)) {
             g_clear_error (&error);
-            if (ctx->running_ipv4)
-                ctx->packet_data_handle_ipv4 = GLOBAL_PACKET_DATA_HANDLE;
-            else
-                ctx->packet_data_handle_ipv6 = GLOBAL_PACKET_DATA_HANDLE;
+            family->packet_data_handle = GLOBAL_PACKET_DATA_HANDLE;
             /* Fall down to a successful connection */
         } else {
-            mm_obj_msg (self, "couldn't start %s network: %s", ctx->running_ipv4 ? "IPv4" : "IPv6", error->message);
+            mm_obj_msg (self, "couldn't start %s network: %s", CONNECT_FAMILY_STR (family), error->message);
             if (g_error_matches (error, QMI_PROTOCOL_ERROR, QMI_PROTOCOL_ERROR_CALL_FAILED)) {
                 g_clear_error (&error);
-                error = error_from_start_network_output (self, ctx->running_ipv4, output);
+                error = error_from_start_network_output (self, !family->ipv6, output);
             }
         }
     }
 
     if (error) {
-        if (ctx->running_ipv4)
-            ctx->error_ipv4 = error;
-        else
-            ctx->error_ipv6 = error;
-    } else {
-        if (ctx->running_ipv4)
-            qmi_message_wds_start_network_output_get_packet_data_handle (output, &ctx->packet_data_handle_ipv4, NULL);
-        else
-            qmi_message_wds_start_network_output_get_packet_data_handle (output, &ctx->packet_data_handle_ipv6, NULL);
-    }
+        family->error = error;
+        /* No point in waiting for the other family if it's going to fail
+         * in the same way */
+        if (connect_family_get_context (family)->parallel &&
+            other->step != CONNECT_FAMILY_STEP_LAST &&
+            start_network_error_applies_to_all_families (error)) {
+            mm_obj_dbg (self, "aborting %s connection attempt...", CONNECT_FAMILY_STR (other));
+            g_cancellable_cancel (other->cancellable);
+        }
+    } else
+        qmi_message_wds_start_network_output_get_packet_data_handle (output, &family->packet_data_handle, NULL);
 
     if (output)
         qmi_message_wds_start_network_output_unref (output);
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    connect_family_next_step (family);
 }
 
 static QmiMessageWdsStartNetworkInput *
-build_start_network_input (ConnectContext *ctx)
+build_start_network_input (ConnectContext       *ctx,
+                           ConnectFamilyContext *family)
 {
     QmiMessageWdsStartNetworkInput *input;
 
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
-
     input = qmi_message_wds_start_network_input_new ();
 
     /* When requesting to connect through a profile, add the profile-id setting */
@@ -1346,7 +1380,7 @@ build_start_network_input (ConnectContext *ctx)
     if (!ctx->no_ip_family_preference) {
         qmi_message_wds_start_network_input_set_ip_family_preference (
             input,
-            (ctx->running_ipv6 ? QMI_WDS_IP_FAMILY_IPV6 : QMI_WDS_IP_FAMILY_IPV4),
+            (family->ipv6 ? QMI_WDS_IP_FAMILY_IPV6 : QMI_WDS_IP_FAMILY_IPV4),
             NULL);
     }
 
@@ -1463,45 +1497,24 @@ connect_enable_indications_ready (QmiClientWds *client,
 }
 
 static void
-connect_enable_indications_ipv4_ready (QmiClientWds *client,
-                                       GAsyncResult *res,
-                                       GTask *task)
-{
-    ConnectContext *ctx;
-
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->event_report_ipv4_indication_id == 0);
-
-    ctx->event_report_ipv4_indication_id =
-        connect_enable_indications_ready (client, res, ctx->self, &ctx->error_ipv4);
-
-    if (!ctx->event_report_ipv4_indication_id)
-        ctx->step = CONNECT_STEP_LAST;
-    else
-        ctx->step++;
-
-    connect_context_step (task);
-}
-
-static void
-connect_enable_indications_ipv6_ready (QmiClientWds *client,
-                                       GAsyncResult *res,
-                                       GTask *task)
+connect_enable_indications_family_ready (QmiClientWds         *client,
+                                         GAsyncResult         *res,
+                                         ConnectFamilyContext *family)
 {
     ConnectContext *ctx;
 
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->event_report_ipv6_indication_id == 0);
+    ctx = connect_family_get_context (family);
+    g_assert (family->event_report_indication_id == 0);
 
-    ctx->event_report_ipv6_indication_id =
-        connect_enable_indications_ready (client, res, ctx->self, &ctx->error_ipv6);
+    family->event_report_indication_id =
+        connect_enable_indications_ready (client, res, ctx->self, &family->error);
 
-    if (!ctx->event_report_ipv6_indication_id)
-        ctx->step = CONNECT_STEP_LAST;
-    else
-        ctx->step++;
+    if (!family->event_report_indication_id) {
+        connect_family_finish (family, TRUE, NULL);
+        return;
+    }
 
-    connect_context_step (task);
+    connect_family_next_step (family);
 }
 
 static QmiMessageWdsSetEventReportInput *
@@ -1566,20 +1579,15 @@ cleanup_event_report_unsolicited_events (MMBearerQmi *self,
 }
 
 static void
-set_ip_family_ready (QmiClientWds *client,
-                     GAsyncResult *res,
-                     GTask *task)
+set_ip_family_ready (QmiClientWds         *client,
+                     GAsyncResult         *res,
+                     ConnectFamilyContext *family)
 {
     MMBearerQmi *self;
-    ConnectContext *ctx;
     GError *error = NULL;
     QmiMessageWdsSetIpFamilyOutput *output;
 
-    self = g_task_get_source_object (task);
-    ctx = g_task_get_task_data (task);
-
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
+    self = g_task_get_source_object (family->task);
 
     output = qmi_client_wds_set_ip_family_finish (client, res, &error);
     if (output) {
@@ -1593,23 +1601,19 @@ set_ip_family_ready (QmiClientWds *client,
     }
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    connect_family_next_step (family);
 }
 
 static void
-bind_data_port_ready (QmiClientWds *client,
-                      GAsyncResult *res,
-                      GTask        *task)
+bind_data_port_ready (QmiClientWds         *client,
+                      GAsyncResult         *res,
+                      ConnectFamilyContext *family)
 {
     ConnectContext                             *ctx;
     GError                                     *error = NULL;
     g_autoptr(QmiMessageWdsBindDataPortOutput)  output = NULL;
 
-    ctx  = g_task_get_task_data (task);
-
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
+    ctx = connect_family_get_context (family);
 
     output = qmi_client_wds_bind_data_port_finish (client, res, &error);
     if (!output || !qmi_message_wds_bind_data_port_output_get_result (output, &error)) {
@@ -1618,80 +1622,63 @@ bind_data_port_ready (QmiClientWds *client,
              * even if multiplexing is disabled. Try again with that. */
             g_error_free (error);
             ctx->sio_port_failed = TRUE;
-            connect_context_step (task);
+            connect_family_step (family);
             return;
         }
 
         g_prefix_error (&error, "Couldn't bind data port: ");
-        complete_connect (task, NULL, error);
+        connect_family_finish (family, FALSE, error);
         return;
     }
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    connect_family_next_step (family);
 }
 
 static void
-bind_mux_data_port_ready (QmiClientWds *client,
-                          GAsyncResult *res,
-                          GTask        *task)
+bind_mux_data_port_ready (QmiClientWds         *client,
+                          GAsyncResult         *res,
+                          ConnectFamilyContext *family)
 {
-    ConnectContext                                *ctx;
     GError                                        *error = NULL;
     g_autoptr(QmiMessageWdsBindMuxDataPortOutput)  output = NULL;
 
-    ctx  = g_task_get_task_data (task);
-
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
-
     output = qmi_client_wds_bind_mux_data_port_finish (client, res, &error);
     if (!output || !qmi_message_wds_bind_mux_data_port_output_get_result (output, &error)) {
         g_prefix_error (&error, "Couldn't bind mux data port: ");
-        complete_connect (task, NULL, error);
+        connect_family_finish (family, FALSE, error);
         return;
     }
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    connect_family_next_step (family);
 }
 
 static void
-qmi_port_allocate_client_ready (MMPortQmi *qmi,
-                                GAsyncResult *res,
-                                GTask *task)
+qmi_port_allocate_client_ready (MMPortQmi            *qmi,
+                                GAsyncResult         *res,
+                                ConnectFamilyContext *family)
 {
     ConnectContext *ctx;
     GError *error = NULL;
 
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
+    ctx = connect_family_get_context (family);
 
     if (!mm_port_qmi_allocate_client_finish (qmi, res, &error)) {
         g_prefix_error (&error, "Couldn't allocate %s client in QMI port %s: ",
-                        ctx->running_ipv4 ? "IPv4" : "IPv6",
+                        CONNECT_FAMILY_STR (family),
                         mm_port_get_device (MM_PORT (qmi)));
-        complete_connect (task, NULL, error);
+        connect_family_finish (family, FALSE, error);
         return;
     }
 
-    if (ctx->running_ipv4)
-        ctx->client_ipv4 = QMI_CLIENT_WDS (mm_port_qmi_get_client (
-                                               qmi,
-                                               QMI_SERVICE_WDS,
-                                               MM_BEARER_QMI_PORT_FLAG (MM_PORT_QMI_FLAG_WDS_IPV4, ctx)));
-    else
-        ctx->client_ipv6 = QMI_CLIENT_WDS (mm_port_qmi_get_client (
-                                               qmi,
-                                               QMI_SERVICE_WDS,
-                                               MM_BEARER_QMI_PORT_FLAG (MM_PORT_QMI_FLAG_WDS_IPV6, ctx)));
+    family->client = QMI_CLIENT_WDS (mm_port_qmi_get_client (
+                                         qmi,
+                                         QMI_SERVICE_WDS,
+                                         MM_BEARER_QMI_PORT_FLAG ((family->ipv6 ? MM_PORT_QMI_FLAG_WDS_IPV6 : MM_PORT_QMI_FLAG_WDS_IPV4), ctx)));
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    connect_family_next_step (family);
 }
 
 static void
@@ -1897,31 +1884,208 @@ get_profile_ready (MMIfaceModem3gppProfileManager *modem,
     connect_context_step (task);
 }
 
+static gboolean
+connect_check_cancelled (MMBearerQmi  *self,
+                         GError      **error)
+{
+    g_assert (self->priv->ongoing_connect_user_cancellable);
+    if (g_cancellable_is_cancelled (self->priv->ongoing_connect_user_cancellable)) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_CANCELLED, "operation cancelled");
+        return TRUE;
+    }
+
+    g_assert (self->priv->ongoing_connect_network_cancellable);
+    if (g_cancellable_is_cancelled (self->priv->ongoing_connect_network_cancellable)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_ABORTED, "aborted by the network");
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
 static void
-connect_context_step (GTask *task)
+connect_family_step (ConnectFamilyContext *family)
 {
     MMBearerQmi    *self;
     ConnectContext *ctx;
+    GError         *error = NULL;
 
-    self = g_task_get_source_object (task);
+    self = g_task_get_source_object (family->task);
 
-    g_assert (self->priv->ongoing_connect_user_cancellable);
-    if (g_cancellable_is_cancelled (self->priv->ongoing_connect_user_cancellable)) {
-        complete_connect (task,
-                          NULL,
-                          g_error_new (G_IO_ERROR,
-                                       G_IO_ERROR_CANCELLED,
-                                       "operation cancelled"));
+    if (connect_check_cancelled (self, &error)) {
+        connect_family_finish (family, FALSE, error);
         return;
     }
 
-    g_assert (self->priv->ongoing_connect_network_cancellable);
-    if (g_cancellable_is_cancelled (self->priv->ongoing_connect_network_cancellable)) {
-        complete_connect (task,
-                          NULL,
-                          g_error_new (MM_CORE_ERROR,
-                                       MM_CORE_ERROR_ABORTED,
-                                       "aborted by the network"));
+    ctx = connect_family_get_context (family);
+
+    /* If the setup of the other family failed, there is no point in going on */
+    if (ctx->families_error) {
+        connect_family_finish (family, FALSE, NULL);
+        return;
+    }
+
+    switch (family->step) {
+    case CONNECT_FAMILY_STEP_FIRST:
+        mm_obj_dbg (self, "running %s connection setup", CONNECT_FAMILY_STR (family));
+        family->step++;
+        /* fall through */
+
+    case CONNECT_FAMILY_STEP_WDS_CLIENT: {
+        QmiClient *client;
+        guint      flag;
+
+        flag = MM_BEARER_QMI_PORT_FLAG ((family->ipv6 ? MM_PORT_QMI_FLAG_WDS_IPV6 : MM_PORT_QMI_FLAG_WDS_IPV4), ctx);
+        client = mm_port_qmi_get_client (ctx->qmi, QMI_SERVICE_WDS, flag);
+        if (!client) {
+            mm_obj_dbg (self, "allocating %s-specific WDS client (mux id %u)", CONNECT_FAMILY_STR (family), ctx->mux_id);
+            mm_port_qmi_allocate_client (ctx->qmi,
+                                         QMI_SERVICE_WDS,
+                                         flag,
+                                         g_task_get_cancellable (family->task),
+                                         (GAsyncReadyCallback)qmi_port_allocate_client_ready,
+                                         family);
+            return;
+        }
+
+        family->client = QMI_CLIENT_WDS (client);
+        family->step++;
+    } /* fall through */
+
+    case CONNECT_FAMILY_STEP_BIND_DATA_PORT:
+        /* If SIO port given, bind client to it */
+        if (!ctx->sio_port_failed && ctx->endpoint.sio_port != QMI_SIO_PORT_NONE) {
+            g_autoptr(QmiMessageWdsBindDataPortInput) input = NULL;
+
+            mm_obj_dbg (self, "binding %s client to data port: %s",
+                        CONNECT_FAMILY_STR (family), qmi_sio_port_get_string (ctx->endpoint.sio_port));
+            input = qmi_message_wds_bind_data_port_input_new ();
+            qmi_message_wds_bind_data_port_input_set_data_port (input, ctx->endpoint.sio_port, NULL);
+            qmi_client_wds_bind_data_port (family->client,
+                                           input,
+                                           10,
+                                           g_task_get_cancellable (family->task),
+                                           (GAsyncReadyCallback)bind_data_port_ready,
+                                           family);
+            return;
+        }
+
+        /* If mux id given, bind mux data port */
+        if (ctx->sio_port_failed || ctx->mux_id != QMI_DEVICE_MUX_ID_UNBOUND) {
+            g_autoptr(QmiMessageWdsBindMuxDataPortInput) input = NULL;
+
+            mm_obj_dbg (self, "binding %s client to mux id %d", CONNECT_FAMILY_STR (family), ctx->mux_id);
+            input = qmi_message_wds_bind_mux_data_port_input_new ();
+            qmi_message_wds_bind_mux_data_port_input_set_endpoint_info (
+                input,
+                ctx->endpoint.type,
+                ctx->endpoint.interface_number,
+                NULL);
+            qmi_message_wds_bind_mux_data_port_input_set_mux_id (input, ctx->mux_id, NULL);
+
+            qmi_client_wds_bind_mux_data_port (family->client,
+                                               input,
+                                               10,
+                                               g_task_get_cancellable (family->task),
+                                               (GAsyncReadyCallback)bind_mux_data_port_ready,
+                                               family);
+            return;
+        }
+
+        family->step++;
+        /* fall through */
+
+    case CONNECT_FAMILY_STEP_IP_FAMILY:
+        /* If client is new enough, select IP family. An explicit IP family
+         * preference is always given when IPv6 is requested. */
+        g_assert (!family->ipv6 || !ctx->no_ip_family_preference);
+        if (!ctx->no_ip_family_preference) {
+            QmiMessageWdsSetIpFamilyInput *input;
+
+            mm_obj_dbg (self, "setting default IP family to: %s", CONNECT_FAMILY_STR (family));
+            input = qmi_message_wds_set_ip_family_input_new ();
+            qmi_message_wds_set_ip_family_input_set_preference (input,
+                                                                family->ipv6 ? QMI_WDS_IP_FAMILY_IPV6 : QMI_WDS_IP_FAMILY_IPV4,
+                                                                NULL);
+            qmi_client_wds_set_ip_family (family->client,
+                                          input,
+                                          10,
+                                          g_task_get_cancellable (family->task),
+                                          (GAsyncReadyCallback)set_ip_family_ready,
+                                          family);
+            qmi_message_wds_set_ip_family_input_unref (input);
+            return;
+        }
+
+        family->step++;
+        /* fall through */
+
+    case CONNECT_FAMILY_STEP_ENABLE_INDICATIONS:
+        common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
+                                                                       family->client,
+                                                                       TRUE,
+                                                                       &family->packet_service_status_indication_id);
+        setup_event_report_unsolicited_events (ctx->self,
+                                               family->client,
+                                               g_task_get_cancellable (family->task),
+                                               (GAsyncReadyCallback) connect_enable_indications_family_ready,
+                                               family);
+        return;
+
+    case CONNECT_FAMILY_STEP_START_NETWORK: {
+        QmiMessageWdsStartNetworkInput *input;
+
+        mm_obj_dbg (self, "starting %s connection...", CONNECT_FAMILY_STR (family));
+        input = build_start_network_input (ctx, family);
+        qmi_client_wds_start_network (family->client,
+                                      input,
+                                      MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+                                      family->cancellable,
+                                      (GAsyncReadyCallback)start_network_ready,
+                                      family);
+        qmi_message_wds_start_network_input_unref (input);
+        return;
+    }
+
+    case CONNECT_FAMILY_STEP_ENABLE_WDS_INDICATIONS:
+        /* If call is connected enable wds indications */
+        if (family->packet_data_handle) {
+            register_for_wds_indication (family);
+            return;
+        }
+        family->step++;
+        /* fall through */
+
+    case CONNECT_FAMILY_STEP_GET_CURRENT_SETTINGS:
+        /* Retrieve and print IP configuration */
+        if (family->packet_data_handle) {
+            mm_obj_dbg (self, "getting %s configuration...", CONNECT_FAMILY_STR (family));
+            get_current_settings (family);
+            return;
+        }
+        family->step++;
+        /* fall through */
+
+    case CONNECT_FAMILY_STEP_LAST:
+        connect_family_finish (family, FALSE, NULL);
+        return;
+
+    default:
+        g_assert_not_reached ();
+    }
+}
+
+static void
+connect_context_step (GTask *task)
+{
+    MMBearerQmi    *self;
+    ConnectContext *ctx;
+    GError         *error = NULL;
+
+    self = g_task_get_source_object (task);
+
+    if (connect_check_cancelled (self, &error)) {
+        complete_connect (task, NULL, error);
         return;
     }
 
@@ -2030,149 +2194,27 @@ connect_context_step (GTask *task)
         /* fall through */
 
     case CONNECT_STEP_IPV4:
-        /* If no IPv4 setup needed, jump to IPv6 */
-        if (!ctx->ipv4) {
+        /* If both IPv4 and IPv6 requested, run both setups in parallel, each
+         * one on its own WDS client. The join will jump to the last step. */
+        if (ctx->ipv4 && ctx->ipv6 && ctx->parallel) {
+            mm_obj_dbg (self, "running IPv4 and IPv6 connection setups in parallel");
+            ctx->n_families_running = 2;
             ctx->step = CONNECT_STEP_IPV6;
-            connect_context_step (task);
-            return;
-        }
-
-        /* Start IPv4 setup */
-        mm_obj_dbg (self, "running IPv4 connection setup");
-        ctx->running_ipv4 = TRUE;
-        ctx->running_ipv6 = FALSE;
-        ctx->step++;
-        /* fall through */
-
-    case CONNECT_STEP_WDS_CLIENT_IPV4: {
-        QmiClient *client;
-
-        client = mm_port_qmi_get_client (ctx->qmi,
-                                         QMI_SERVICE_WDS,
-                                         MM_BEARER_QMI_PORT_FLAG (MM_PORT_QMI_FLAG_WDS_IPV4, ctx));
-        if (!client) {
-            mm_obj_dbg (self, "allocating IPv4-specific WDS client (mux id %u)", ctx->mux_id);
-            mm_port_qmi_allocate_client (ctx->qmi,
-                                         QMI_SERVICE_WDS,
-                                         MM_BEARER_QMI_PORT_FLAG (MM_PORT_QMI_FLAG_WDS_IPV4, ctx),
-                                         g_task_get_cancellable (task),
-                                         (GAsyncReadyCallback)qmi_port_allocate_client_ready,
-                                         task);
-            return;
-        }
-
-        ctx->client_ipv4 = QMI_CLIENT_WDS (client);
-        ctx->step++;
-    } /* fall through */
-
-    case CONNECT_STEP_BIND_DATA_PORT_IPV4:
-        /* If SIO port given, bind client to it */
-        if (!ctx->sio_port_failed && ctx->endpoint.sio_port != QMI_SIO_PORT_NONE) {
-            g_autoptr(QmiMessageWdsBindDataPortInput) input = NULL;
-
-            mm_obj_dbg (self, "binding to data port: %s", qmi_sio_port_get_string (ctx->endpoint.sio_port));
-            input = qmi_message_wds_bind_data_port_input_new ();
-            qmi_message_wds_bind_data_port_input_set_data_port (input, ctx->endpoint.sio_port, NULL);
-            qmi_client_wds_bind_data_port (ctx->client_ipv4,
-                                           input,
-                                           10,
-                                           g_task_get_cancellable (task),
-                                           (GAsyncReadyCallback)bind_data_port_ready,
-                                           task);
+            connect_family_step (&ctx->family_ipv4);
+            connect_family_step (&ctx->family_ipv6);
             return;
         }
 
-        /* If mux id given, bind mux data port */
-        if (ctx->sio_port_failed || ctx->mux_id != QMI_DEVICE_MUX_ID_UNBOUND) {
-            g_autoptr(QmiMessageWdsBindMuxDataPortInput) input = NULL;
-
-            mm_obj_dbg (self, "binding to mux id %d", ctx->mux_id);
-            input = qmi_message_wds_bind_mux_data_port_input_new ();
-            qmi_message_wds_bind_mux_data_port_input_set_endpoint_info (
-                input,
-                ctx->endpoint.type,
-                ctx->endpoint.interface_number,
-                NULL);
-            qmi_message_wds_bind_mux_data_port_input_set_mux_id (input, ctx->mux_id, NULL);
-
-            qmi_client_wds_bind_mux_data_port (ctx->client_ipv4,
-                                               input,
-                                               10,
-                                               g_task_get_cancellable (task),
-                                               (GAsyncReadyCallback)bind_mux_data_port_ready,
-                                               task);
-            return;
-        }
-
-        ctx->step++;
-        /* fall through */
-
-    case CONNECT_STEP_IP_FAMILY_IPV4:
-        /* If client is new enough, select IP family */
-        if (!ctx->no_ip_family_preference) {
-            QmiMessageWdsSetIpFamilyInput *input;
-
-            mm_obj_dbg (self, "setting default IP family to: IPv4");
-            input = qmi_message_wds_set_ip_family_input_new ();
-            qmi_message_wds_set_ip_family_input_set_preference (input, QMI_WDS_IP_FAMILY_IPV4, NULL);
-            qmi_client_wds_set_ip_family (ctx->client_ipv4,
-                                          input,
-                                          10,
-                                          g_task_get_cancellable (task),
-                                          (GAsyncReadyCallback)set_ip_family_ready,
-                                          task);
-            qmi_message_wds_set_ip_family_input_unref (input);
+        /* If no IPv4 setup needed, jump to IPv6 */
+        if (!ctx->ipv4) {
+            ctx->step = CONNECT_STEP_IPV6;
+            connect_context_step (task);
             return;
         }
 
-        ctx->step++;
-        /* fall through */
-
-    case CONNECT_STEP_ENABLE_INDICATIONS_IPV4:
-        common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
-                                                                       ctx->client_ipv4,
-                                                                       TRUE,
-                                                                       &ctx->packet_service_status_ipv4_indication_id);
-        setup_event_report_unsolicited_events (ctx->self,
-                                               ctx->client_ipv4,
-                                               g_task_get_cancellable (task),
-                                               (GAsyncReadyCallback) connect_enable_indications_ipv4_ready,
-                                               task);
-        return;
-
-    case CONNECT_STEP_START_NETWORK_IPV4: {
-        QmiMessageWdsStartNetworkInput *input;
-
-        mm_obj_dbg (self, "starting IPv4 connection...");
-        input = build_start_network_input (ctx);
-        qmi_client_wds_start_network (ctx->client_ipv4,
-                                      input,
-                                      MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
-                                      g_task_get_cancellable (task),
-                                      (GAsyncReadyCallback)start_network_ready,
-                                      task);
-        qmi_message_wds_start_network_input_unref (input);
+        ctx->n_families_running = 1;
+        connect_family_step (&ctx->family_ipv4);
         return;
-    }
-
-    case CONNECT_STEP_ENABLE_WDS_INDICATIONS_IPV4:
-        /* If call is connected enable wds indications */
-        if (ctx->packet_data_handle_ipv4) {
-            register_for_wds_indication (ctx, task);
-            return;
-        }
-        ctx->step++;
-        /* fall through */
-
-    case CONNECT_STEP_GET_CURRENT_SETTINGS_IPV4:
-        /* Retrieve and print IP configuration */
-        if (ctx->packet_data_handle_ipv4) {
-            mm_obj_dbg (self, "getting IPv4 configuration...");
-            get_current_settings (task, ctx->client_ipv4);
-            return;
-        }
-        ctx->step++;
-        /* fall through */
 
     case CONNECT_STEP_IPV6:
         /* If no IPv6 setup needed, jump to last */
@@ -2182,155 +2224,20 @@ connect_context_step (GTask *task)
             return;
         }
 
-        /* Start IPv6 setup */
-        mm_obj_dbg (self, "running IPv6 connection setup");
-        ctx->running_ipv4 = FALSE;
-        ctx->running_ipv6 = TRUE;
-        ctx->step++;
-        /* fall through */
-
-    case CONNECT_STEP_WDS_CLIENT_IPV6: {
-        QmiClient *client;
-
-        client = mm_port_qmi_get_client (ctx->qmi,
-                                         QMI_SERVICE_WDS,
-                                         MM_BEARER_QMI_PORT_FLAG (MM_PORT_QMI_FLAG_WDS_IPV6, ctx));
-        if (!client) {
-            mm_obj_dbg (self, "allocating IPv6-specific WDS client (mux id %u)", ctx->mux_id);
-            mm_port_qmi_allocate_client (ctx->qmi,
-                                         QMI_SERVICE_WDS,
-                                         MM_BEARER_QMI_PORT_FLAG (MM_PORT_QMI_FLAG_WDS_IPV6, ctx),
-                                         g_task_get_cancellable (task),
-                                         (GAsyncReadyCallback)qmi_port_allocate_client_ready,
-                                         task);
-            return;
-        }
-
-        ctx->client_ipv6 = QMI_CLIENT_WDS (client);
-        ctx->step++;
-    } /* fall through */
-
-    case CONNECT_STEP_BIND_DATA_PORT_IPV6:
-        /* If SIO port given, bind client to it */
-        if (!ctx->sio_port_failed && ctx->endpoint.sio_port != QMI_SIO_PORT_NONE) {
-            g_autoptr(QmiMessageWdsBindDataPortInput) input = NULL;
-
-            mm_obj_dbg (self, "binding to data port: %s", qmi_sio_port_get_string (ctx->endpoint.sio_port));
-            input = qmi_message_wds_bind_data_port_input_new ();
-            qmi_message_wds_bind_data_port_input_set_data_port (input, ctx->endpoint.sio_port, NULL);
-            qmi_client_wds_bind_data_port (ctx->client_ipv6,
-                                           input,
-                                           10,
-                                           g_task_get_cancellable (task),
-                                           (GAsyncReadyCallback)bind_data_port_ready,
-                                           task);
-            return;
-        }
-
-        /* If mux id given, bind mux data port */
-        if (ctx->sio_port_failed || ctx->mux_id != QMI_DEVICE_MUX_ID_UNBOUND) {
-            g_autoptr(QmiMessageWdsBindMuxDataPortInput) input = NULL;
-
-            mm_obj_dbg (self, "binding to mux id %d", ctx->mux_id);
-            input = qmi_message_wds_bind_mux_data_port_input_new ();
-            qmi_message_wds_bind_mux_data_port_input_set_endpoint_info (
-                input,
-                ctx->endpoint.type,
-                ctx->endpoint.interface_number,
-                NULL);
-            qmi_message_wds_bind_mux_data_port_input_set_mux_id (input, ctx->mux_id, NULL);
-
-            qmi_client_wds_bind_mux_data_port (ctx->client_ipv6,
-                                               input,
-                                               10,
-                                               g_task_get_cancellable (task),
-                                               (GAsyncReadyCallback)bind_mux_data_port_ready,
-                                               task);
-            return;
-        }
-
-        ctx->step++;
-        /* fall through */
-
-    case CONNECT_STEP_IP_FAMILY_IPV6: {
-        QmiMessageWdsSetIpFamilyInput *input;
-
-        g_assert (ctx->no_ip_family_preference == FALSE);
-
-        mm_obj_dbg (self, "setting default IP family to: IPv6");
-        input = qmi_message_wds_set_ip_family_input_new ();
-        qmi_message_wds_set_ip_family_input_set_preference (input, QMI_WDS_IP_FAMILY_IPV6, NULL);
-        qmi_client_wds_set_ip_family (ctx->client_ipv6,
-                                      input,
-                                      10,
-                                      g_task_get_cancellable (task),
-                                      (GAsyncReadyCallback)set_ip_family_ready,
-                                      task);
-        qmi_message_wds_set_ip_family_input_unref (input);
+        ctx->n_families_running = 1;
+        connect_family_step (&ctx->family_ipv6);
         return;
-    }
-
-    case CONNECT_STEP_ENABLE_INDICATIONS_IPV6:
-        common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
-                                                                       ctx->client_ipv6,
-                                                                       TRUE,
-                                                                       &ctx->packet_service_status_ipv6_indication_id);
-        setup_event_report_unsolicited_events (ctx->self,
-                                               ctx->client_ipv6,
-                                               g_task_get_cancellable (task),
-                                               (GAsyncReadyCallback) connect_enable_indications_ipv6_ready,
-                                               task);
-        return;
-
-    case CONNECT_STEP_START_NETWORK_IPV6: {
-        QmiMessageWdsStartNetworkInput *input;
-
-        mm_obj_dbg (self, "starting IPv6 connection...");
-        input = build_start_network_input (ctx);
-        qmi_client_wds_start_network (ctx->client_ipv6,
-                                      input,
-                                      MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
-                                      g_task_get_cancellable (task),
-                                      (GAsyncReadyCallback)start_network_ready,
-                                      task);
-        qmi_message_wds_start_network_input_unref (input);
-        return;
-    }
-
-    case CONNECT_STEP_ENABLE_WDS_INDICATIONS_IPV6:
-        /* If call is connected enable wds indications */
-        if (ctx->packet_data_handle_ipv6) {
-            register_for_wds_indication (ctx, task);
-            return;
-        }
-        ctx->step++;
-        /* fall through */
-
-    case CONNECT_STEP_GET_CURRENT_SETTINGS_IPV6:
-        /* Retrieve and print IP configuration */
-        if (ctx->packet_data_handle_ipv6) {
-            mm_obj_dbg (self, "getting IPv6 configuration...");
-            get_current_settings (task, ctx->client_ipv6);
-            return;
-        }
-        ctx->step++;
-        /* fall through */
 
     case CONNECT_STEP_LAST: {
         MMBearerConnectResult *connect_result;
 
         /* If one of IPv4 or IPv6 succeeds, we're connected */
-        if (!ctx->packet_data_handle_ipv4 && !ctx->packet_data_handle_ipv6) {
-            GError *error;
-
+        if (!ctx->family_ipv4.packet_data_handle && !ctx->family_ipv6.packet_data_handle) {
             /* No connection, set error. If both set, IPv4 error preferred */
-            if (ctx->error_ipv4) {
-                error = ctx->error_ipv4;
-                ctx->error_ipv4 = NULL;
-            } else {
-                error = ctx->error_ipv6;
-                ctx->error_ipv6 = NULL;
-            }
+            if (ctx->family_ipv4.error)
+                error = g_steal_pointer (&ctx->family_ipv4.error);
+            else
+                error = g_steal_pointer (&ctx->family_ipv6.error);
 
             complete_connect (task, NULL, error);
             return;
@@ -2360,35 +2267,35 @@ connect_context_step (GTask *task)
 
         g_assert (ctx->self->priv->packet_data_handle_ipv4 == 0);
         g_assert (ctx->self->priv->client_ipv4 == NULL);
-        if (ctx->packet_data_handle_ipv4) {
-            ctx->self->priv->packet_data_handle_ipv4 = ctx->packet_data_handle_ipv4;
-            ctx->packet_data_handle_ipv4 = 0;
-            ctx->self->priv->packet_service_status_ipv4_indication_id = ctx->packet_service_status_ipv4_indication_id;
-            ctx->packet_service_status_ipv4_indication_id = 0;
-            ctx->self->priv->event_report_ipv4_indication_id = ctx->event_report_ipv4_indication_id;
-            ctx->event_report_ipv4_indication_id = 0;
-            ctx->self->priv->extended_ipv4_config_change_id = ctx->extended_ipv4_config_change_id;
-            ctx->extended_ipv4_config_change_id = 0;
-            ctx->self->priv->client_ipv4 = g_object_ref (ctx->client_ipv4);
+        if (ctx->family_ipv4.packet_data_handle) {
+            ctx->self->priv->packet_data_handle_ipv4 = ctx->family_ipv4.packet_data_handle;
+            ctx->family_ipv4.packet_data_handle = 0;
+            ctx->self->priv->packet_service_status_ipv4_indication_id = ctx->family_ipv4.packet_service_status_indication_id;
+            ctx->family_ipv4.packet_service_status_indication_id = 0;
+            ctx->self->priv->event_report_ipv4_indication_id = ctx->family_ipv4.event_report_indication_id;
+            ctx->family_ipv4.event_report_indication_id = 0;
+            ctx->self->priv->extended_ipv4_config_change_id = ctx->family_ipv4.extended_ip_config_change_id;
+            ctx->family_ipv4.extended_ip_config_change_id = 0;
+            ctx->self->priv->client_ipv4 = g_object_ref (ctx->family_ipv4.client);
         }
 
         g_assert (ctx->self->priv->packet_data_handle_ipv6 == 0);
         g_assert (ctx->self->priv->client_ipv6 == NULL);
-        if (ctx->packet_data_handle_ipv6) {
-            ctx->self->priv->packet_data_handle_ipv6 = ctx->packet_data_handle_ipv6;
-            ctx->packet_data_handle_ipv6 = 0;
-            ctx->self->priv->packet_service_status_ipv6_indication_id = ctx->packet_service_status_ipv6_indication_id;
-            ctx->packet_service_status_ipv6_indication_id = 0;
-            ctx->self->priv->event_report_ipv6_indication_id = ctx->event_report_ipv6_indication_id;
-            ctx->event_report_ipv6_indication_id = 0;
-            ctx->self->priv->extended_ipv6_config_change_id = ctx->extended_ipv6_config_change_id;
-            ctx->extended_ipv6_config_change_id = 0;
-            ctx->self->priv->client_ipv6 = g_object_ref (ctx->client_ipv6);
+        if (ctx->family_ipv6.packet_data_handle) {
+            ctx->self->priv->packet_data_handle_ipv6 = ctx->family_ipv6.packet_data_handle;
+            ctx->family_ipv6.packet_data_handle = 0;
+            ctx->self->priv->packet_service_status_ipv6_indication_id = ctx->family_ipv6.packet_service_status_indication_id;
+            ctx->family_ipv6.packet_service_status_indication_id = 0;
+            ctx->self->priv->event_report_ipv6_indication_id = ctx->family_ipv6.event_report_indication_id;
+            ctx->family_ipv6.event_report_indication_id = 0;
+            ctx->self->priv->extended_ipv6_config_change_id = ctx->family_ipv6.extended_ip_config_change_id;
+            ctx->family_ipv6.extended_ip_config_change_id = 0;
+            ctx->self->priv->client_ipv6 = g_object_ref (ctx->family_ipv6.client);
         }
 
         connect_result = mm_bearer_connect_result_new (ctx->link ? ctx->link : ctx->data,
-                                                       ctx->ipv4_config,
-                                                       ctx->ipv6_config);
+                                                       ctx->family_ipv4.config,
+                                                       ctx->family_ipv6.config);
         mm_bearer_connect_result_set_multiplexed (connect_result, !!ctx->link);
 
         if (ctx->profile_id != MM_3GPP_PROFILE_ID_UNKNOWN)
@@ -2564,6 +2471,19 @@ _connect (MMBaseBearer        *_self,
     ctx->mux_id = QMI_DEVICE_MUX_ID_UNBOUND;
     ctx->step = CONNECT_STEP_FIRST;
     ctx->ip_method = MM_BEARER_IP_METHOD_UNKNOWN;
+    ctx->family_ipv4.task = task;
+    ctx->family_ipv6.task = task;
+    ctx->family_ipv6.ipv6 = TRUE;
+    ctx->family_ipv4.cancellable = g_cancellable_new ();
+    ctx->family_ipv6.cancellable = g_cancellable_new ();
+    g_cancellable_connect (operation_cancellable,
+                           G_CALLBACK (cancel_operation_cancellable),
+                           g_object_ref (ctx->family_ipv4.cancellable),
+                           g_object_unref);
+    g_cancellable_connect (operation_cancellable,
+                           G_CALLBACK (cancel_operation_cancellable),
+                           g_object_ref (ctx->family_ipv6.cancellable),
+                           g_object_unref);
     g_task_set_task_data (task, ctx, (GDestroyNotify)connect_context_free);
 
     /* Grab a data port */
@@ -2584,6 +2504,11 @@ _connect (MMBaseBearer        *_self,
     }
     ctx->dap = mm_port_qmi_get_data_aggregation_protocol (ctx->qmi);
 
+    /* IPv4 and IPv6 setups are run one after the other, unless the device
+     * is tagged as supporting concurrent start network requests */
+    ctx->parallel = mm_kernel_device_get_global_property_as_boolean (mm_port_peek_kernel_device (MM_PORT (ctx->qmi)),
+                                                                     "ID_MM_QMI_PARALLEL_DUAL_STACK_CONNECT");
+
     /* load all settings from bearer */
     if (!load_settings_from_bearer (self, modem, ctx, properties, &error)) {
         g_prefix_error (&error, "Invalid bearer properties: ");
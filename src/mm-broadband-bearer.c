@@ -247,15 +247,16 @@ cdma_connect_context_dial (GTask *task)
 
     ctx = g_task_get_task_data (task);
 
-    mm_base_modem_at_command_full (ctx->modem,
-                                   MM_IFACE_PORT_AT (ctx->data),
-                                   "DT#777",
-                                   MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
-                                   FALSE,
-                                   FALSE,
-                                   NULL,
-                                   (GAsyncReadyCallback)dial_cdma_ready,
-                                   task);
+    mm_base_modem_at_command_full_with_priority (ctx->modem,
+                                                 MM_IFACE_PORT_AT (ctx->data),
+                                                 "DT#777",
+                                                 MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+                                                 FALSE,
+                                                 FALSE,
+                                                 MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                                 NULL,
+                                                 (GAsyncReadyCallback)dial_cdma_ready,
+                                                 task);
 }
 
 static void
@@ -564,15 +565,16 @@ dial_3gpp (MMBroadbandBearer *self,
 
     /* Use default *99 to connect */
     command = g_strdup_printf ("ATD*99***%d#", cid);
-    mm_base_modem_at_command_full (ctx->modem,
-                                   MM_IFACE_PORT_AT (ctx->dial_port),
-                                   command,
-                                   MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
-                                   FALSE,
-                                   FALSE, /* raw */
-                                   NULL, /* cancellable */
-                                   (GAsyncReadyCallback)atd_ready,
-                                   task);
+    mm_base_modem_at_command_full_with_priority (ctx->modem,
+                                                 MM_IFACE_PORT_AT (ctx->dial_port),
+                                                 command,
+                                                 MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+                                                 FALSE,
+                                                 FALSE, /* raw */
+                                                 MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                                 NULL, /* cancellable */
+                                                 (GAsyncReadyCallback)atd_ready,
+                                                 task);
     g_free (command);
 }
 
@@ -1327,15 +1329,16 @@ data_flash_3gpp_ready (MMPortSerial *data,
     else
         mm_obj_dbg (self, "sending PDP context deactivation in primary port again...");
 
-    mm_base_modem_at_command_full (ctx->modem,
-                                   MM_IFACE_PORT_AT (ctx->primary),
-                                   ctx->cgact_command,
-                                   10,
-                                   FALSE,
-                                   FALSE, /* raw */
-                                   NULL, /* cancellable */
-                                   (GAsyncReadyCallback)cgact_data_ready,
-                                   task);
+    mm_base_modem_at_command_full_with_priority (ctx->modem,
+                                                 MM_IFACE_PORT_AT (ctx->primary),
+                                                 ctx->cgact_command,
+                                                 10,
+                                                 FALSE,
+                                                 FALSE, /* raw */
+                                                 MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                                 NULL, /* cancellable */
+                                                 (GAsyncReadyCallback)cgact_data_ready,
+                                                 task);
 }
 
 static void
@@ -1444,15 +1447,16 @@ disconnect_3gpp (MMBroadbandBearer *self,
      * we'll send CGACT there */
     if (!mm_port_get_connected (MM_PORT (ctx->primary))) {
         mm_obj_dbg (self, "sending PDP context deactivation in primary port...");
-        mm_base_modem_at_command_full (ctx->modem,
-                                       MM_IFACE_PORT_AT (ctx->primary),
-                                       ctx->cgact_command,
-                                       45,
-                                       FALSE,
-                                       FALSE, /* raw */
-                                       NULL, /* cancellable */
-                                       (GAsyncReadyCallback)cgact_ready,
-                                       task);
+        mm_base_modem_at_command_full_with_priority (ctx->modem,
+                                                     MM_IFACE_PORT_AT (ctx->primary),
+                                                     ctx->cgact_command,
+                                                     45,
+                                                     FALSE,
+                                                     FALSE, /* raw */
+                                                     MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                                     NULL, /* cancellable */
+                                                     (GAsyncReadyCallback)cgact_ready,
+                                                     task);
         return;
     }
 
@@ -1463,15 +1467,16 @@ disconnect_3gpp (MMBroadbandBearer *self,
      */
     if (ctx->secondary) {
         mm_obj_dbg (self, "sending PDP context deactivation in secondary port...");
-        mm_base_modem_at_command_full (ctx->modem,
-                                       MM_IFACE_PORT_AT (ctx->secondary),
-                                       ctx->cgact_command,
-                                       45,
-                                       FALSE,
-                                       FALSE, /* raw */
-                                       NULL, /* cancellable */
-                                       (GAsyncReadyCallback)cgact_ready,
-                                       task);
+        mm_base_modem_at_command_full_with_priority (ctx->modem,
+                                                     MM_IFACE_PORT_AT (ctx->secondary),
+                                                     ctx->cgact_command,
+                                                     45,
+                                                     FALSE,
+                                                     FALSE, /* raw */
+                                                     MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                                     NULL, /* cancellable */
+                                                     (GAsyncReadyCallback)cgact_ready,
+                                                     task);
         return;
     }
 
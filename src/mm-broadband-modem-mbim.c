@@ -524,7 +524,7 @@ device_caps_query_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -632,12 +632,12 @@ load_current_capabilities_mbim (GTask *task)
         message = mbim_message_ms_basic_connect_extensions_device_caps_query_new (NULL);
     else
         message = mbim_message_device_caps_query_new (NULL);
-    mbim_device_command (ctx->device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)device_caps_query_ready,
-                         task);
+    mm_port_mbim_device_command (ctx->device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)device_caps_query_ready,
+                                 task);
 }
 
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
@@ -984,25 +984,102 @@ modem_load_equipment_identifier_finish (MMIfaceModem *self,
     return g_task_propagate_pointer (G_TASK (res), error);
 }
 
+static void
+equipment_identifier_device_caps_query_ready (MbimDevice   *device,
+                                              GAsyncResult *res,
+                                              GTask        *task)
+{
+    MMBroadbandModemMbim   *self;
+    g_autoptr(MbimMessage)  response = NULL;
+    g_autofree gchar       *device_id = NULL;
+    GError                 *error = NULL;
+
+    self = g_task_get_source_object (task);
+
+    response = mm_port_mbim_device_command_finish (device, res, &error);
+    if (response &&
+        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
+        if (mbim_device_check_ms_mbimex_version (device, 3, 0))
+            mbim_message_ms_basic_connect_extensions_v3_device_caps_response_parse (
+                response,
+                NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL, NULL, NULL,
+                &device_id,
+                NULL, NULL,
+                &error);
+        else if (mbim_device_check_ms_mbimex_version (device, 2, 0))
+            mbim_message_ms_basic_connect_extensions_device_caps_response_parse (
+                response,
+                NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                &device_id,
+                NULL, NULL, NULL,
+                &error);
+        else
+            mbim_message_device_caps_response_parse (
+                response,
+                NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                &device_id,
+                NULL, NULL,
+                &error);
+    }
+
+    if (error) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    if (!device_id) {
+        g_task_return_new_error (task,
+                                 MM_CORE_ERROR,
+                                 MM_CORE_ERROR_FAILED,
+                                 "Device ID not given in device capabilities");
+        g_object_unref (task);
+        return;
+    }
+
+    g_free (self->priv->caps_device_id);
+    self->priv->caps_device_id = g_strdup (device_id);
+    g_task_return_pointer (task, g_steal_pointer (&device_id), g_free);
+    g_object_unref (task);
+}
+
 static void
 modem_load_equipment_identifier (MMIfaceModem *_self,
                                  GAsyncReadyCallback callback,
                                  gpointer user_data)
 {
-    MMBroadbandModemMbim *self = MM_BROADBAND_MODEM_MBIM (_self);
-    GTask *task;
+    MMBroadbandModemMbim   *self = MM_BROADBAND_MODEM_MBIM (_self);
+    MbimDevice             *device;
+    GTask                  *task;
+    g_autoptr(MbimMessage)  message = NULL;
+
+    if (!peek_device (self, &device, callback, user_data))
+        return;
 
     task = g_task_new (self, NULL, callback, user_data);
-    if (self->priv->caps_device_id)
+
+    /* During initialization the device capabilities were just loaded */
+    if (self->priv->caps_device_id) {
         g_task_return_pointer (task,
                                g_strdup (self->priv->caps_device_id),
                                g_free);
+        g_object_unref (task);
+        return;
+    }
+
+    /* Otherwise, e.g. when validating the modem identity after resume, or if
+     * the device capabilities didn't include the device id, query them again */
+    if (mbim_device_check_ms_mbimex_version (device, 2, 0))
+        message = mbim_message_ms_basic_connect_extensions_device_caps_query_new (NULL);
     else
-        g_task_return_new_error (task,
-                                 MM_CORE_ERROR,
-                                 MM_CORE_ERROR_FAILED,
-                                 "Device ID not given in device capabilities");
-    g_object_unref (task);
+        message = mbim_message_device_caps_query_new (NULL);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)equipment_identifier_device_caps_query_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -1202,7 +1279,7 @@ register_state_current_modes_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_v2_register_state_response_parse (
@@ -1278,12 +1355,12 @@ modem_load_current_modes (MMIfaceModem        *self,
         g_autoptr(MbimMessage) message = NULL;
 
         message = mbim_message_register_state_query_new (NULL);
-        mbim_device_command (device,
-                             message,
-                             60,
-                             NULL,
-                             (GAsyncReadyCallback)register_state_current_modes_query_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     60,
+                                     NULL,
+                                     (GAsyncReadyCallback)register_state_current_modes_query_ready,
+                                     task);
         return;
     }
 
@@ -1367,7 +1444,7 @@ register_state_current_modes_set_ready (MbimDevice   *device,
     }
     g_clear_object (&self->priv->pending_allowed_modes_action);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_v2_register_state_response_parse (
@@ -1499,12 +1576,12 @@ modem_set_current_modes (MMIfaceModem        *_self,
                       self->priv->requested_operator_id ? MBIM_REGISTER_ACTION_MANUAL : MBIM_REGISTER_ACTION_AUTOMATIC,
                       self->priv->requested_data_class,
                       NULL);
-        mbim_device_command (device,
-                             message,
-                             60,
-                             NULL,
-                             (GAsyncReadyCallback)register_state_current_modes_set_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     60,
+                                     NULL,
+                                     (GAsyncReadyCallback)register_state_current_modes_set_ready,
+                                     task);
         return;
     }
 
@@ -1591,7 +1668,7 @@ pin_query_ready (MbimDevice   *device,
     MMBroadbandModemMbim *self;
 
     self = g_task_get_source_object (task);
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_pin_response_parse (
@@ -1644,7 +1721,7 @@ unlock_required_subscriber_ready_state_ready (MbimDevice   *device,
     /* reset to the default if any error happens */
     self->priv->enabled_cache.last_ready_state = MBIM_SUBSCRIBER_READY_STATE_NOT_INITIALIZED;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -1758,12 +1835,12 @@ unlock_required_subscriber_ready_state_ready (MbimDevice   *device,
 
         /* Query which lock is to unlock */
         message = mbim_message_pin_query_new (NULL);
-        mbim_device_command (device,
-                             message,
-                             10,
-                             g_task_get_cancellable (task),
-                             (GAsyncReadyCallback)pin_query_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     g_task_get_cancellable (task),
+                                     (GAsyncReadyCallback)pin_query_ready,
+                                     task);
         mbim_message_unref (message);
         return;
     }
@@ -1784,12 +1861,12 @@ wait_for_sim_ready (GTask *task)
 
     ctx = g_task_get_task_data (task);
     message = mbim_message_subscriber_ready_status_query_new (NULL);
-    mbim_device_command (ctx->device,
-                         message,
-                         10,
-                         g_task_get_cancellable (task),
-                         (GAsyncReadyCallback)unlock_required_subscriber_ready_state_ready,
-                         task);
+    mm_port_mbim_device_command (ctx->device,
+                                 message,
+                                 10,
+                                 g_task_get_cancellable (task),
+                                 (GAsyncReadyCallback)unlock_required_subscriber_ready_state_ready,
+                                 task);
     mbim_message_unref (message);
     return G_SOURCE_REMOVE;
 }
@@ -1839,7 +1916,7 @@ pin_query_unlock_retries_ready (MbimDevice *device,
     MbimPinType pin_type;
     guint32 remaining_attempts;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_pin_response_parse (
@@ -1881,12 +1958,12 @@ modem_load_unlock_retries (MMIfaceModem *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_pin_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)pin_query_unlock_retries_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)pin_query_unlock_retries_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -1931,7 +2008,7 @@ own_numbers_subscriber_ready_state_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -1989,12 +2066,12 @@ modem_load_own_numbers (MMIfaceModem        *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_subscriber_ready_status_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)own_numbers_subscriber_ready_state_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)own_numbers_subscriber_ready_state_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -2026,7 +2103,7 @@ radio_state_query_ready (MbimDevice *device,
     MbimRadioSwitchState hardware_radio_state;
     MbimRadioSwitchState software_radio_state;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_radio_state_response_parse (
@@ -2065,12 +2142,12 @@ modem_load_power_state (MMIfaceModem *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_radio_state_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)radio_state_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)radio_state_query_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -2098,7 +2175,7 @@ radio_state_set_up_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_radio_state_response_parse (
@@ -2144,12 +2221,12 @@ modem_power_up (MMIfaceModem        *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_radio_state_set_new (MBIM_RADIO_SWITCH_STATE_ON, NULL);
-    mbim_device_command (device,
-                         message,
-                         20,
-                         NULL,
-                         (GAsyncReadyCallback)radio_state_set_up_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 20,
+                                 NULL,
+                                 (GAsyncReadyCallback)radio_state_set_up_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -2171,7 +2248,7 @@ radio_state_set_down_ready (MbimDevice *device,
     MbimMessage *response;
     GError *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response) {
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
         mbim_message_unref (response);
@@ -2199,12 +2276,12 @@ modem_power_down (MMIfaceModem *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_radio_state_set_new (MBIM_RADIO_SWITCH_STATE_OFF, NULL);
-    mbim_device_command (device,
-                         message,
-                         20,
-                         NULL,
-                         (GAsyncReadyCallback)radio_state_set_down_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 20,
+                                 NULL,
+                                 (GAsyncReadyCallback)radio_state_set_down_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -2257,7 +2334,7 @@ signal_state_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -2321,12 +2398,12 @@ modem_load_signal_quality (MMIfaceModem *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_signal_state_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)signal_state_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)signal_state_query_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -2397,7 +2474,7 @@ ms_basic_connect_extensions_device_reset_set_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         mm_obj_dbg (self, "reset using the ms extensions device reset operation failed: %s", error->message);
         reset_fallback_to_qmi_or_unsupported (task);
@@ -2424,12 +2501,12 @@ modem_reset_ms_ext (GTask      *task,
 
     mm_obj_dbg (self, "attempting reset using the ms extensions device reset operation...");
     message = mbim_message_ms_basic_connect_extensions_device_reset_set_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)ms_basic_connect_extensions_device_reset_set_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)ms_basic_connect_extensions_device_reset_set_ready,
+                                 task);
 }
 
 static void
@@ -2443,7 +2520,7 @@ intel_firmware_update_modem_reboot_set_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         mm_obj_dbg (self, "reset using the intel firmware update modem reboot operation failed: %s", error->message);
         /* fallback to MS extensions reset */
@@ -2480,12 +2557,12 @@ modem_reset (MMIfaceModem        *_self,
      * really is just a standard modem reboot. */
     mm_obj_dbg (self, "attempting reset using the intel firmware update modem reboot operation...");
     message = mbim_message_intel_firmware_update_modem_reboot_set_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)intel_firmware_update_modem_reboot_set_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)intel_firmware_update_modem_reboot_set_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -2563,7 +2640,7 @@ base_stations_info_query_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         ctx->saved_error = error;
         ctx->step = GET_CELL_INFO_STEP_LAST;
@@ -2927,7 +3004,7 @@ check_rfim_query_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, NULL);
+    response = mm_port_mbim_device_command_finish (device, res, NULL);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, NULL) &&
         mbim_message_intel_thermal_rf_rfim_response_parse (response,
@@ -2977,12 +3054,12 @@ get_cell_info_step (MbimDevice *device,
     case GET_CELL_INFO_STEP_RFIM: {
         mm_obj_dbg (self, "Obtaining RFIM data...");
         message = mbim_message_intel_thermal_rf_rfim_query_new (NULL);
-        mbim_device_command (device,
-                             message,
-                             10,
-                             NULL,
-                             (GAsyncReadyCallback)check_rfim_query_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     NULL,
+                                     (GAsyncReadyCallback)check_rfim_query_ready,
+                                     task);
         return;
     }
 
@@ -2994,12 +3071,12 @@ get_cell_info_step (MbimDevice *device,
         else
             message = mbim_message_ms_basic_connect_extensions_base_stations_info_query_new (15, 15, 15, 15, 15, NULL);
 
-        mbim_device_command (device,
-                             message,
-                             300,
-                             NULL,
-                             (GAsyncReadyCallback)base_stations_info_query_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     300,
+                                     NULL,
+                                     (GAsyncReadyCallback)base_stations_info_query_ready,
+                                     task);
         return;
     }
 
@@ -3419,7 +3496,7 @@ query_device_services_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_device_services_response_parse (
@@ -3579,12 +3656,12 @@ query_device_services (GTask *task)
     mm_obj_dbg (self, "querying device services...");
 
     message = mbim_message_device_services_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)query_device_services_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)query_device_services_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -3773,7 +3850,7 @@ pin_list_query_ready (MbimDevice *device,
     MbimPinDesc *pin_desc_corporate_pin;
 
     ctx = g_task_get_task_data (task);
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_pin_list_response_parse (
@@ -3847,7 +3924,7 @@ load_enabled_facility_pin_query_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
-    response = mbim_device_command_finish (device, res, NULL);
+    response = mm_port_mbim_device_command_finish (device, res, NULL);
     if (response) {
         if (mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, NULL) &&
             mbim_message_pin_response_parse (response, &pin_type, &pin_state, NULL, NULL)) {
@@ -3861,12 +3938,12 @@ load_enabled_facility_pin_query_ready (MbimDevice *device,
     }
 
     message = mbim_message_pin_list_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)pin_list_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)pin_list_query_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -3892,12 +3969,12 @@ modem_3gpp_load_enabled_facility_locks (MMIfaceModem3gpp *self,
      * was added to get currently active PIN or PUK lock.
      */
     message = mbim_message_pin_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)load_enabled_facility_pin_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)load_enabled_facility_pin_query_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -3931,7 +4008,7 @@ disable_facility_lock_ready (MbimDevice *device,
 
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response,
                                                         MBIM_MESSAGE_TYPE_COMMAND_DONE,
                                                         &error)) {
@@ -3999,12 +4076,12 @@ modem_3gpp_disable_facility_lock (MMIfaceModem3gpp *self,
                                         NULL,
                                         NULL);
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)disable_facility_lock_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)disable_facility_lock_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -4081,7 +4158,7 @@ lte_attach_info_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -4172,12 +4249,12 @@ modem_3gpp_load_initial_eps_bearer (MMIfaceModem3gpp    *_self,
     }
 
     message = mbim_message_ms_basic_connect_extensions_lte_attach_info_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)lte_attach_info_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)lte_attach_info_query_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -4303,7 +4380,7 @@ lte_attach_configuration_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_lte_attach_configuration_response_parse (
@@ -4360,12 +4437,12 @@ modem_3gpp_load_initial_eps_bearer_settings (MMIfaceModem3gpp    *_self,
     }
 
     message = mbim_message_ms_basic_connect_extensions_lte_attach_configuration_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)lte_attach_configuration_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)lte_attach_configuration_query_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -4414,7 +4491,7 @@ lte_attach_configuration_set_ready (MbimDevice   *device,
     g_autoptr(MbimMessage)  response = NULL;
     GError                 *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error))
         g_task_return_error (task, error);
     else
@@ -4452,12 +4529,12 @@ lte_attach_configuration_set (GTask *task)
                   n_configurations,
                   (const MbimLteAttachConfiguration * const*)configurations,
                   NULL);
-    mbim_device_command (ctx->device,
-                         request,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)lte_attach_configuration_set_ready,
-                         task);
+    mm_port_mbim_device_command (ctx->device,
+                                 request,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)lte_attach_configuration_set_ready,
+                                 task);
 }
 
 static void
@@ -4560,7 +4637,7 @@ lte_attach_configuration_reload_before_set_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_lte_attach_configuration_response_parse (
@@ -4699,12 +4776,12 @@ modem_3gpp_set_initial_eps_bearer_settings (MMIfaceModem3gpp    *_self,
 
     /* Reload existing settings, so that we can log about the changes before the set operation */
     request = mbim_message_ms_basic_connect_extensions_lte_attach_configuration_query_new (NULL);
-    mbim_device_command (ctx->device,
-                         request,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)lte_attach_configuration_reload_before_set_ready,
-                         task);
+    mm_port_mbim_device_command (ctx->device,
+                                 request,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)lte_attach_configuration_reload_before_set_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -4729,7 +4806,7 @@ registration_parameters_query_ready (MbimDevice   *device,
     MbimDrxCycle                drx_cycle = MBIM_DRX_CYCLE_NOT_SPECIFIED;
     g_autoptr(MbimMessage)      response = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_v3_registration_parameters_response_parse (
@@ -4777,12 +4854,12 @@ modem_3gpp_load_nr5g_registration_settings (MMIfaceModem3gpp    *_self,
     }
 
     message = mbim_message_ms_basic_connect_extensions_v3_registration_parameters_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)registration_parameters_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)registration_parameters_query_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -4804,7 +4881,7 @@ set_nr5g_registration_settings_ready (MbimDevice   *device,
     g_autoptr(MbimMessage)  response = NULL;
     GError                 *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error))
         g_task_return_error (task, error);
     else
@@ -4847,12 +4924,12 @@ modem_3gpp_set_nr5g_registration_settings (MMIfaceModem3gpp           *_self,
                                                                                            TRUE,
                                                                                            NULL, /* unnamed ies */
                                                                                            NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)set_nr5g_registration_settings_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)set_nr5g_registration_settings_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -4877,7 +4954,7 @@ atds_signal_query_after_indication_ready (MbimDevice           *device,
     guint32                         rsrp;
     guint32                         snr;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_atds_signal_response_parse (response, &rssi, &error_rate, &rscp, &ecno, &rsrq, &rsrp, &snr, &error)) {
@@ -4945,12 +5022,12 @@ basic_connect_notification_signal_state (MMBroadbandModemMbim *self,
 
             mm_obj_dbg (self, "triggering ATDS signal query");
             message = mbim_message_atds_signal_query_new (NULL);
-            mbim_device_command (device,
-                                 message,
-                                 5,
-                                 NULL,
-                                 (GAsyncReadyCallback)atds_signal_query_after_indication_ready,
-                                 g_object_ref (self));
+            mm_port_mbim_device_command (device,
+                                         message,
+                                         5,
+                                         NULL,
+                                         (GAsyncReadyCallback)atds_signal_query_after_indication_ready,
+                                         g_object_ref (self));
         }
     }
 
@@ -4977,7 +5054,7 @@ atds_location_query_ready (MbimDevice           *device,
     guint32                 tac;
     guint32                 cid;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_atds_location_response_parse (response, &lac, &tac, &cid, &error)) {
@@ -5005,12 +5082,12 @@ update_atds_location (MMBroadbandModemMbim *self)
         return;
 
     message = mbim_message_atds_location_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)atds_location_query_ready,
-                         g_object_ref (self));
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)atds_location_query_ready,
+                                 g_object_ref (self));
 }
 
 /*****************************************************************************/
@@ -5474,7 +5551,7 @@ pin_query_after_subscriber_ready_status_ready (MbimDevice           *device,
     MbimPinState           pin_state;
     gboolean               sim_event = FALSE;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_pin_response_parse (
@@ -5575,12 +5652,12 @@ basic_connect_notification_subscriber_ready_status (MMBroadbandModemMbim *self,
 
         /* Query which lock has changed */
         message = mbim_message_pin_query_new (NULL);
-        mbim_device_command (device,
-                             message,
-                             10,
-                             NULL,
-                             (GAsyncReadyCallback)pin_query_after_subscriber_ready_status_ready,
-                             g_object_ref (self));
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     NULL,
+                                     (GAsyncReadyCallback)pin_query_after_subscriber_ready_status_ready,
+                                     g_object_ref (self));
     }
 
     /* Ignore NOT_INITIALIZED state when setting the last_ready_state as it is
@@ -5838,7 +5915,7 @@ basic_connect_notification_provisioned_contexts (MMBroadbandModemMbim *self,
 {
     /* We don't even attempt to parse the indication, we just need to notify that
      * something changed to the upper layers */
-    mm_iface_modem_3gpp_profile_manager_updated (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self));
+    mm_iface_modem_3gpp_profile_manager_updated (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self), MM_3GPP_PROFILE_ID_UNKNOWN);
 }
 
 static gboolean process_pdu_messages (MMBroadbandModemMbim       *self,
@@ -5936,7 +6013,7 @@ alert_sms_read_query_ready (MbimDevice             *device,
     MbimSmsFormat                        format;
     guint32                              messages_count;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_sms_read_response_parse (
@@ -5982,12 +6059,12 @@ sms_notification_read_stored_sms (MMBroadbandModemMbim *self,
     ctx = g_slice_new0 (SmsNotificationContext);
     ctx->self = g_object_ref (self);
     ctx->expected_index = index;
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)alert_sms_read_query_ready,
-                         ctx);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)alert_sms_read_query_ready,
+                                 ctx);
 }
 
 static void
@@ -6144,39 +6221,52 @@ ms_basic_connect_extensions_notification_lte_attach_info (MMBroadbandModemMbim *
     }
 }
 
-static MMBaseSim *
-create_sim_from_slot_state (MMBroadbandModemMbim *self,
-                            gboolean              active,
-                            guint                 slot_index,
-                            MbimUiccSlotState     slot_state)
+/* Returns FALSE if there is no SIM in the slot */
+static gboolean
+sim_type_from_slot_state (MbimUiccSlotState  slot_state,
+                          MMSimType         *sim_type,
+                          MMSimEsimStatus   *esim_status)
 {
-    MMSimType       sim_type    = MM_SIM_TYPE_UNKNOWN;
-    MMSimEsimStatus esim_status = MM_SIM_ESIM_STATUS_UNKNOWN;
+    *sim_type = MM_SIM_TYPE_UNKNOWN;
+    *esim_status = MM_SIM_ESIM_STATUS_UNKNOWN;
 
     switch (slot_state) {
     case MBIM_UICC_SLOT_STATE_ACTIVE:
-        sim_type = MM_SIM_TYPE_PHYSICAL;
-        break;
+        *sim_type = MM_SIM_TYPE_PHYSICAL;
+        return TRUE;
     case MBIM_UICC_SLOT_STATE_ACTIVE_ESIM:
-        sim_type = MM_SIM_TYPE_ESIM;
-        esim_status = MM_SIM_ESIM_STATUS_WITH_PROFILES;
-        break;
+        *sim_type = MM_SIM_TYPE_ESIM;
+        *esim_status = MM_SIM_ESIM_STATUS_WITH_PROFILES;
+        return TRUE;
     case MBIM_UICC_SLOT_STATE_ACTIVE_ESIM_NO_PROFILES:
-        sim_type = MM_SIM_TYPE_ESIM;
-        esim_status = MM_SIM_ESIM_STATUS_NO_PROFILES;
-        break;
+        *sim_type = MM_SIM_TYPE_ESIM;
+        *esim_status = MM_SIM_ESIM_STATUS_NO_PROFILES;
+        return TRUE;
     case MBIM_UICC_SLOT_STATE_NOT_READY:
     case MBIM_UICC_SLOT_STATE_ERROR:
         /* Not fully ready (NOT_READY) or unusable (ERROR) SIM cards should also be
          * reported as being available in the non-active slot. */
-        break;
+        return TRUE;
     case MBIM_UICC_SLOT_STATE_UNKNOWN:
     case MBIM_UICC_SLOT_SATE_OFF_EMPTY:
     case MBIM_UICC_SLOT_STATE_OFF:
     case MBIM_UICC_SLOT_STATE_EMPTY:
     default:
-        return NULL;
+        return FALSE;
     }
+}
+
+static MMBaseSim *
+create_sim_from_slot_state (MMBroadbandModemMbim *self,
+                            gboolean              active,
+                            guint                 slot_index,
+                            MbimUiccSlotState     slot_state)
+{
+    MMSimType       sim_type;
+    MMSimEsimStatus esim_status;
+
+    if (!sim_type_from_slot_state (slot_state, &sim_type, &esim_status))
+        return NULL;
 
     mm_obj_dbg (self, "found %s SIM in slot %u: %s (%s)",
                 active ? "active" : "inactive",
@@ -6197,6 +6287,43 @@ create_sim_from_slot_state (MMBroadbandModemMbim *self,
                                                      NULL));
 }
 
+/* If there already is a SIM object in the inactive slot and there is still a
+ * SIM in it, update the existing object instead of replacing it, so that
+ * clients don't need to look up a new object after every state change. */
+static gboolean
+update_inactive_sim_from_slot_state (MMBroadbandModemMbim *self,
+                                     guint                 slot_index,
+                                     MbimUiccSlotState     slot_state)
+{
+    g_autoptr(GPtrArray)  sim_slots = NULL;
+    MMBaseSim            *sim;
+    MMSimType             sim_type;
+    MMSimEsimStatus       esim_status;
+
+    if (!sim_type_from_slot_state (slot_state, &sim_type, &esim_status))
+        return FALSE;
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_SIM_SLOTS, &sim_slots,
+                  NULL);
+    if (!sim_slots || slot_index >= sim_slots->len)
+        return FALSE;
+
+    sim = g_ptr_array_index (sim_slots, slot_index);
+    if (!sim)
+        return FALSE;
+
+    mm_obj_dbg (self, "updating inactive SIM in slot %u: %s (%s)",
+                slot_index,
+                mm_sim_type_get_string (sim_type),
+                (sim_type == MM_SIM_TYPE_ESIM) ? mm_sim_esim_status_get_string (esim_status) : "n/a");
+    g_object_set (sim,
+                  "sim-type",    sim_type,
+                  "esim-status", esim_status,
+                  NULL);
+    return TRUE;
+}
+
 static void
 ms_basic_connect_extensions_notification_slot_info_status (MMBroadbandModemMbim *self,
                                                            MbimDevice           *device,
@@ -6226,6 +6353,8 @@ ms_basic_connect_extensions_notification_slot_info_status (MMBroadbandModemMbim
         g_autoptr(MMBaseSim) sim = NULL;
 
         mm_obj_dbg (self, "processing slot status change in non-active SIM slot %d: %s", slot_index + 1, mbim_uicc_slot_state_get_string (slot_state));
+        if (update_inactive_sim_from_slot_state (self, slot_index, slot_state))
+            return;
         sim = create_sim_from_slot_state (self, FALSE, slot_index, slot_state);
         mm_iface_modem_modify_sim (MM_IFACE_MODEM (self), slot_index, sim);
         return;
@@ -6518,7 +6647,7 @@ subscribe_list_set_ready_cb (MbimDevice *device,
     MbimMessage *response;
     GError *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response) {
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
         mbim_message_unref (response);
@@ -6637,12 +6766,12 @@ common_enable_disable_unsolicited_events (MMBroadbandModemMbim *self,
                    n_entries,
                    (const MbimEventEntry *const *)entries,
                    NULL));
-    mbim_device_command (device,
-                         request,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)subscribe_list_set_ready_cb,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 request,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)subscribe_list_set_ready_cb,
+                                 task);
     mbim_message_unref (request);
     mbim_event_entry_array_free (entries);
 }
@@ -6881,7 +7010,7 @@ basic_sim_details_subscriber_ready_state_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -6954,12 +7083,12 @@ modem_check_basic_sim_details (MMIfaceModem        *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_subscriber_ready_status_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)basic_sim_details_subscriber_ready_state_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)basic_sim_details_subscriber_ready_state_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -7110,7 +7239,7 @@ packet_service_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         (mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
          g_error_matches (error, MBIM_STATUS_ERROR, MBIM_STATUS_ERROR_FAILURE))) {
@@ -7136,7 +7265,7 @@ register_state_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -7151,12 +7280,12 @@ register_state_query_ready (MbimDevice   *device,
 
     /* Now queue packet service state update */
     message = mbim_message_packet_service_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)packet_service_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)packet_service_query_ready,
+                                 task);
 }
 
 static void
@@ -7178,12 +7307,12 @@ modem_3gpp_run_registration_checks (MMIfaceModem3gpp    *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_register_state_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)register_state_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)register_state_query_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -7215,7 +7344,7 @@ register_state_set_ready (MbimDevice   *device,
     /* The NwError field is valid if MBIM_SET_REGISTER_STATE response status code
      * equals MBIM_STATUS_FAILURE, so we parse the message both on success and on that
      * specific failure */
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         (mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
          g_error_matches (error, MBIM_STATUS_ERROR, MBIM_STATUS_ERROR_FAILURE))) {
@@ -7290,12 +7419,12 @@ modem_3gpp_register_in_network (MMIfaceModem3gpp *_self,
                    self->priv->requested_operator_id ? MBIM_REGISTER_ACTION_MANUAL : MBIM_REGISTER_ACTION_AUTOMATIC,
                    self->priv->requested_data_class,
                    NULL));
-    mbim_device_command (device,
-                         message,
-                         60,
-                         NULL,
-                         (GAsyncReadyCallback)register_state_set_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 60,
+                                 NULL,
+                                 (GAsyncReadyCallback)register_state_set_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -7319,7 +7448,7 @@ visible_providers_query_ready (MbimDevice *device,
     guint n_providers;
     GError *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_visible_providers_response_parse (response,
@@ -7358,12 +7487,12 @@ modem_3gpp_scan_networks (MMIfaceModem3gpp *self,
 
     mm_obj_dbg (self, "scanning networks...");
     message = mbim_message_visible_providers_query_new (MBIM_VISIBLE_PROVIDERS_ACTION_FULL_SCAN, NULL);
-    mbim_device_command (device,
-                         message,
-                         300,
-                         NULL,
-                         (GAsyncReadyCallback)visible_providers_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 300,
+                                 NULL,
+                                 (GAsyncReadyCallback)visible_providers_query_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -7485,7 +7614,7 @@ atds_signal_query_ready (MbimDevice   *device,
     guint32                 rsrp;
     guint32                 snr;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_atds_signal_response_parse (response, &rssi, &error_rate, &rscp, &ecno, &rsrq, &rsrp, &snr, &error)) {
@@ -7551,7 +7680,7 @@ mbimexv2_signal_state_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -7615,24 +7744,24 @@ modem_signal_load_values (MMIfaceModemSignal  *self,
 
     if (mbim_device_check_ms_mbimex_version (device, 2, 0)) {
         message = mbim_message_signal_state_query_new (NULL);
-        mbim_device_command (device,
-                             message,
-                             5,
-                             NULL,
-                             (GAsyncReadyCallback)mbimexv2_signal_state_query_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     5,
+                                     NULL,
+                                     (GAsyncReadyCallback)mbimexv2_signal_state_query_ready,
+                                     task);
         mbim_message_unref (message);
         return;
     }
 
     if (MM_BROADBAND_MODEM_MBIM (self)->priv->is_atds_signal_supported) {
         message = mbim_message_atds_signal_query_new (NULL);
-        mbim_device_command (device,
-                             message,
-                             5,
-                             NULL,
-                             (GAsyncReadyCallback)atds_signal_query_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     5,
+                                     NULL,
+                                     (GAsyncReadyCallback)atds_signal_query_ready,
+                                     task);
         mbim_message_unref (message);
         return;
     }
@@ -7664,7 +7793,7 @@ signal_state_set_thresholds_ready (MbimDevice   *device,
     g_autoptr(MbimMessage)  response = NULL;
     GError                  *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_signal_state_response_parse (
@@ -7727,12 +7856,12 @@ modem_signal_setup_thresholds (MMIfaceModemSignal  *self,
                    coded_error_rate_threshold,
                    NULL));
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)signal_state_set_thresholds_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)signal_state_set_thresholds_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -8007,7 +8136,7 @@ profile_manager_provisioned_contexts_query_ready (MbimDevice   *device,
 
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_provisioned_contexts_response_parse (response,
@@ -8046,7 +8175,7 @@ profile_manager_provisioned_contexts_v2_query_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_provisioned_contexts_response_parse (response,
@@ -8094,22 +8223,22 @@ modem_3gpp_profile_manager_list_profiles (MMIfaceModem3gppProfileManager  *_self
      * more information than the default one. */
     if (self->priv->is_context_type_ext_supported) {
         message = mbim_message_ms_basic_connect_extensions_provisioned_contexts_query_new (NULL);
-        mbim_device_command (device,
-                             message,
-                             10,
-                             NULL,
-                             (GAsyncReadyCallback)profile_manager_provisioned_contexts_v2_query_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     NULL,
+                                     (GAsyncReadyCallback)profile_manager_provisioned_contexts_v2_query_ready,
+                                     task);
         return;
     }
 
     message = mbim_message_provisioned_contexts_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)profile_manager_provisioned_contexts_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)profile_manager_provisioned_contexts_query_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -8148,7 +8277,7 @@ profile_manager_provisioned_contexts_set_ready (MbimDevice   *device,
     GError                 *error = NULL;
     g_autoptr(MbimMessage)  response = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response && mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error))
         g_task_return_boolean (task, TRUE);
     else
@@ -8297,12 +8426,12 @@ modem_3gpp_profile_manager_store_profile (MMIfaceModem3gppProfileManager *_self,
         return;
     }
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)profile_manager_provisioned_contexts_set_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)profile_manager_provisioned_contexts_set_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -8324,7 +8453,7 @@ profile_manager_provisioned_contexts_reset_ready (MbimDevice   *device,
     GError                 *error = NULL;
     g_autoptr(MbimMessage)  response = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response && mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error))
         g_task_return_boolean (task, TRUE);
     else
@@ -8405,12 +8534,12 @@ modem_3gpp_profile_manager_delete_profile (MMIfaceModem3gppProfileManager *_self
         return;
     }
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)profile_manager_provisioned_contexts_reset_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)profile_manager_provisioned_contexts_reset_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -8762,7 +8891,7 @@ ussd_send_ready (MbimDevice           *device,
 
     /* Note: if there is a cached task, it is ALWAYS completed here */
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_ussd_response_parse (response,
@@ -8861,12 +8990,12 @@ modem_3gpp_ussd_send (MMIfaceModem3gppUssd *_self,
     self->priv->pending_ussd_action = task;
     mm_iface_modem_3gpp_ussd_update_state (_self, MM_MODEM_3GPP_USSD_SESSION_STATE_ACTIVE);
 
-    mbim_device_command (device,
-                         message,
-                         100,
-                         NULL,
-                         (GAsyncReadyCallback)ussd_send_ready,
-                         g_object_ref (self)); /* Full reference! */
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 100,
+                                 NULL,
+                                 (GAsyncReadyCallback)ussd_send_ready,
+                                 g_object_ref (self)); /* Full reference! */
     mbim_message_unref (message);
 }
 
@@ -8892,7 +9021,7 @@ ussd_cancel_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response)
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
 
@@ -8944,12 +9073,12 @@ modem_3gpp_ussd_cancel (MMIfaceModem3gppUssd *_self,
         g_object_unref (task);
         return;
     }
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)ussd_cancel_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)ussd_cancel_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -9146,7 +9275,7 @@ sms_read_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_sms_read_response_parse (
@@ -9189,12 +9318,12 @@ load_initial_sms_parts (MMIfaceModemMessaging *self,
                                                MBIM_SMS_FLAG_ALL,
                                                0, /* message index, unused */
                                                NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)sms_read_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)sms_read_query_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -9334,7 +9463,7 @@ sar_config_query_state_ready (MbimDevice   *device,
     GError                 *error = NULL;
     MbimSarBackoffState     state;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_ms_sar_config_response_parse (
@@ -9368,12 +9497,12 @@ sar_load_state (MMIfaceModemSar    *_self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_ms_sar_config_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)sar_config_query_state_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)sar_config_query_state_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -9407,7 +9536,7 @@ sar_config_query_power_level_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_ms_sar_config_response_parse (
@@ -9447,12 +9576,12 @@ sar_load_power_level (MMIfaceModemSar    *_self,
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_ms_sar_config_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)sar_config_query_power_level_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)sar_config_query_power_level_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -9482,7 +9611,7 @@ sar_config_set_enable_ready (MbimDevice   *device,
     g_autoptr(MbimMessage) response = NULL;
     GError *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_boolean (task, TRUE);
@@ -9523,12 +9652,12 @@ sar_enable (MMIfaceModemSar    *_self,
                                                   enable ? MBIM_SAR_BACKOFF_STATE_ENABLED : MBIM_SAR_BACKOFF_STATE_DISABLED,
                                                   1, (const MbimSarConfigState **)&config_state, NULL);
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)sar_config_set_enable_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)sar_config_set_enable_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -9549,7 +9678,7 @@ sar_config_set_power_level_ready (MbimDevice   *device,
     g_autoptr(MbimMessage)  response = NULL;
     GError                 *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_boolean (task, TRUE);
@@ -9587,12 +9716,12 @@ sar_set_power_level (MMIfaceModemSar    *_self,
     message = mbim_message_ms_sar_config_set_new (MBIM_SAR_CONTROL_MODE_OS,
                                                   MBIM_SAR_BACKOFF_STATE_ENABLED,
                                                   1, (const MbimSarConfigState **)&config_state, NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)sar_config_set_power_level_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)sar_config_set_power_level_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -9649,14 +9778,16 @@ get_property (GObject *object,
 typedef struct {
     GPtrArray *sim_slots;
     guint number_slots;
-    guint query_slot_index;  /* range [0,number_slots-1] */
+    guint n_pending_queries;
     guint active_slot_index; /* range [1,number_slots]   */
+    GError *saved_error;
 } LoadSimSlotsContext;
 
 static void
 load_sim_slots_context_free (LoadSimSlotsContext *ctx)
 {
     g_clear_pointer (&ctx->sim_slots, g_ptr_array_unref);
+    g_clear_error (&ctx->saved_error);
     g_slice_free (LoadSimSlotsContext, ctx);
 }
 
@@ -9688,11 +9819,6 @@ load_sim_slots_finish (MMIfaceModem *self,
     return TRUE;
 }
 
-static void
-query_slot_information_status (MbimDevice *device,
-                               guint       slot_index,
-                               GTask      *task);
-
 static void
 query_slot_information_status_ready (MbimDevice   *device,
                                      GAsyncResult *res,
@@ -9704,13 +9830,15 @@ query_slot_information_status_ready (MbimDevice   *device,
     guint32                slot_index;
     MbimUiccSlotState      slot_state;
     LoadSimSlotsContext   *ctx;
-    MMBaseSim             *sim;
     gboolean               sim_active = FALSE;
 
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    g_assert (ctx->n_pending_queries > 0);
+    ctx->n_pending_queries--;
+
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_slot_info_status_response_parse (
@@ -9718,42 +9846,56 @@ query_slot_information_status_ready (MbimDevice   *device,
                 &slot_index,
                 &slot_state,
                 &error)) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        return;
-    }
-
-    /* the slot index in MM starts at 1 */
-    if ((slot_index + 1) == ctx->active_slot_index)
-        sim_active = TRUE;
+        if (!ctx->saved_error)
+            ctx->saved_error = error;
+        else
+            g_error_free (error);
+    } else if (slot_index >= ctx->number_slots) {
+        mm_obj_warn (self, "ignoring slot info status for unexpected SIM slot %u", slot_index + 1);
+    } else if (!ctx->saved_error) {
+        /* the slot index in MM starts at 1 */
+        if ((slot_index + 1) == ctx->active_slot_index)
+            sim_active = TRUE;
 
-    sim = create_sim_from_slot_state (self, sim_active, slot_index, slot_state);
-    g_ptr_array_add (ctx->sim_slots, sim);
+        g_clear_object (&g_ptr_array_index (ctx->sim_slots, slot_index));
+        g_ptr_array_index (ctx->sim_slots, slot_index) = create_sim_from_slot_state (self, sim_active, slot_index, slot_state);
+    }
 
-    ctx->query_slot_index++;
-    if (ctx->query_slot_index < ctx->number_slots) {
-        query_slot_information_status (device, ctx->query_slot_index, task);
+    /* Wait for all slots to be reported */
+    if (ctx->n_pending_queries > 0)
         return;
-    }
 
-    g_task_return_boolean (task, TRUE);
+    if (ctx->saved_error)
+        g_task_return_error (task, g_steal_pointer (&ctx->saved_error));
+    else
+        g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
 
+/* Slot info status can only be queried one slot at a time, so issue the
+ * queries for all slots right away instead of waiting for each response */
 static void
-query_slot_information_status (MbimDevice *device,
-                               guint       slot_index,
-                               GTask      *task)
+query_slot_information_status_all (MbimDevice *device,
+                                   GTask      *task)
 {
-    g_autoptr(MbimMessage) message = NULL;
+    LoadSimSlotsContext *ctx;
+    guint                i;
 
-    message = mbim_message_ms_basic_connect_extensions_slot_info_status_query_new (slot_index, NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)query_slot_information_status_ready,
-                         task);
+    ctx = g_task_get_task_data (task);
+    g_assert (ctx->number_slots > 0);
+
+    ctx->n_pending_queries = ctx->number_slots;
+    for (i = 0; i < ctx->number_slots; i++) {
+        g_autoptr(MbimMessage) message = NULL;
+
+        message = mbim_message_ms_basic_connect_extensions_slot_info_status_query_new (i, NULL);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     NULL,
+                                     (GAsyncReadyCallback)query_slot_information_status_ready,
+                                     task);
+    }
 }
 
 static void
@@ -9771,7 +9913,7 @@ query_device_slot_mappings_ready (MbimDevice   *device,
     ctx = g_task_get_task_data (task);
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_device_slot_mappings_response_parse (
             response,
@@ -9794,7 +9936,7 @@ query_device_slot_mappings_ready (MbimDevice   *device,
     ctx->active_slot_index = slot_mappings[self->priv->executor_index]->slot + 1;
     self->priv->active_slot_index = ctx->active_slot_index;
 
-    query_slot_information_status (device, ctx->query_slot_index, task);
+    query_slot_information_status_all (device, task);
 }
 
 static void
@@ -9804,12 +9946,12 @@ query_device_slot_mappings (MbimDevice *device,
     g_autoptr(MbimMessage) message = NULL;
 
     message = mbim_message_ms_basic_connect_extensions_device_slot_mappings_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)query_device_slot_mappings_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)query_device_slot_mappings_ready,
+                                 task);
 }
 
 static void
@@ -9824,7 +9966,7 @@ query_device_caps_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_device_caps_response_parse (
             response,
@@ -9870,7 +10012,7 @@ query_sys_caps_ready (MbimDevice   *device,
     ctx = g_task_get_task_data (task);
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_sys_caps_response_parse (
@@ -9893,6 +10035,7 @@ query_sys_caps_ready (MbimDevice   *device,
     }
     ctx->number_slots = number_slots;
     ctx->sim_slots = g_ptr_array_new_full (number_slots, (GDestroyNotify) sim_slot_free);
+    g_ptr_array_set_size (ctx->sim_slots, number_slots);
 
     if (number_executors == 0) {
         g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND,
@@ -9908,12 +10051,12 @@ query_sys_caps_ready (MbimDevice   *device,
     }
     /* Given that more than one executors supported,we first query the current device caps to know which is the current executor index */
     message = mbim_message_ms_basic_connect_extensions_device_caps_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)query_device_caps_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)query_device_caps_ready,
+                                 task);
 }
 
 static void
@@ -9929,12 +10072,12 @@ load_sim_slots_mbim (GTask *task)
         return;
 
     message = mbim_message_ms_basic_connect_extensions_sys_caps_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)query_sys_caps_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)query_sys_caps_ready,
+                                 task);
 }
 
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
@@ -10011,7 +10154,7 @@ set_device_slot_mappings_ready (MbimDevice   *device,
     /* the slot index in MM starts at 1 */
     slot_number = GPOINTER_TO_UINT (g_task_get_task_data (task)) - 1;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_device_slot_mappings_response_parse (
             response,
@@ -10062,7 +10205,7 @@ before_set_query_device_slot_mappings_ready (MbimDevice   *device,
     /* the slot index in MM starts at 1 */
     slot_number = GPOINTER_TO_UINT (g_task_get_task_data (task)) - 1;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_basic_connect_extensions_device_slot_mappings_response_parse (
             response,
@@ -10097,12 +10240,12 @@ before_set_query_device_slot_mappings_ready (MbimDevice   *device,
     message = mbim_message_ms_basic_connect_extensions_device_slot_mappings_set_new (map_count,
                                                                                      (const MbimSlot **)slot_mappings,
                                                                                      NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)set_device_slot_mappings_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)set_device_slot_mappings_ready,
+                                 task);
 }
 
 static void
@@ -10118,12 +10261,12 @@ set_primary_sim_slot_mbim (GTask *task)
         return;
 
     message = mbim_message_ms_basic_connect_extensions_device_slot_mappings_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)before_set_query_device_slot_mappings_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)before_set_query_device_slot_mappings_ready,
+                                 task);
 }
 
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
@@ -10196,7 +10339,7 @@ packet_service_set_ready (MbimDevice   *device,
     /* The NwError field is valid if MBIM_SET_PACKET_SERVICE response status code
      * equals MBIM_STATUS_FAILURE, so we parse the message both on success and on that
      * specific failure */
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         (mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
          g_error_matches (error, MBIM_STATUS_ERROR, MBIM_STATUS_ERROR_FAILURE))) {
@@ -10283,12 +10426,12 @@ set_packet_service_state (MMIfaceModem3gpp              *self,
     g_task_set_task_data (task, GUINT_TO_POINTER (requested_packet_service_state), NULL);
 
     message = mbim_message_packet_service_set_new (packet_service_action, NULL);
-    mbim_device_command (device,
-                         message,
-                         30,
-                         NULL,
-                         (GAsyncReadyCallback)packet_service_set_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 30,
+                                 NULL,
+                                 (GAsyncReadyCallback)packet_service_set_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -10310,7 +10453,7 @@ set_carrier_lock_ready (MbimDevice   *device,
     g_autoptr(MbimMessage)  response = NULL;
     GError                 *error = NULL;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_boolean (task, TRUE);
@@ -10349,12 +10492,12 @@ modem_set_carrier_lock (MMIfaceModem3gpp    *_self,
 
     mm_obj_dbg (self, "Sending carrier lock request...");
     message = mbim_message_google_carrier_lock_set_new (data_size, data, NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)set_carrier_lock_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)set_carrier_lock_ready,
+                                 task);
 }
 
 /*****************************************************************************/
@@ -10412,6 +10555,28 @@ modem_firmware_load_update_settings (MMIfaceModemFirmware *self,
         user_data);
 }
 
+/*****************************************************************************/
+/* Synchronization after resume */
+
+#if defined WITH_SUSPEND_RESUME
+
+/* 'sync' as function name conflicts with a declared function in unistd.h */
+static void
+synchronize (MMBaseModem         *self,
+             GCancellable        *cancellable,
+             GAsyncReadyCallback  callback,
+             gpointer             user_data)
+{
+    /* The modem identity is validated during the synchronization, so make
+     * sure the device id is queried again instead of taken from the device
+     * capabilities loaded before the suspension */
+    g_clear_pointer (&MM_BROADBAND_MODEM_MBIM (self)->priv->caps_device_id, g_free);
+
+    MM_BASE_MODEM_CLASS (mm_broadband_modem_mbim_parent_class)->sync (self, cancellable, callback, user_data);
+}
+
+#endif
+
 /*****************************************************************************/
 
 MMBroadbandModemMbim *
@@ -10733,6 +10898,7 @@ iface_modem_location_init (MMIfaceModemLocationInterface *iface)
     iface->inject_assistance_data_finish = mm_shared_qmi_location_inject_assistance_data_finish;
     iface->load_assistance_data_servers = mm_shared_qmi_location_load_assistance_data_servers;
     iface->load_assistance_data_servers_finish = mm_shared_qmi_location_load_assistance_data_servers_finish;
+    iface->peek_location_cache = mm_shared_qmi_location_peek_location_cache;
 #else
     iface->load_capabilities = NULL;
     iface->load_capabilities_finish = NULL;
@@ -10842,6 +11008,10 @@ mm_broadband_modem_mbim_class_init (MMBroadbandModemMbimClass *klass)
     broadband_modem_class->enabling_modem_init_finish = NULL;
     broadband_modem_class->create_sms = messaging_create_sms;
 
+#if defined WITH_SUSPEND_RESUME
+    MM_BASE_MODEM_CLASS (klass)->sync = synchronize;
+#endif
+
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     g_object_class_install_property (object_class, PROP_QMI_UNSUPPORTED,
         g_param_spec_boolean (MM_BROADBAND_MODEM_MBIM_QMI_UNSUPPORTED,
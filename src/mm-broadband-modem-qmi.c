@@ -54,6 +54,7 @@
 #include "mm-sms-part-cdma.h"
 #include "mm-call-qmi.h"
 #include "mm-call-list.h"
+#include "mm-context.h"
 
 static void iface_modem_init                      (MMIfaceModemInterface                   *iface);
 static void iface_modem_3gpp_init                 (MMIfaceModem3gppInterface               *iface);
@@ -699,17 +700,21 @@ dms_get_ids_ready (QmiClientDms *client,
      * Otherwise, if we have a ESN, use it...
      * Otherwise, if we have a MEID, use it...
      * Otherwise, 'unknown'
+     *
+     * Identifiers not given in this response are cleared, as this may be a
+     * reload to validate the modem identity (e.g. after resume) and values
+     * from a previous load must not be used.
      */
+    g_clear_pointer (&self->priv->imei, g_free);
+    g_clear_pointer (&self->priv->esn, g_free);
+    g_clear_pointer (&self->priv->meid, g_free);
 
     if (qmi_message_dms_get_ids_output_get_imei (output, &str, NULL) &&
-        str[0] != '\0') {
-        g_free (self->priv->imei);
+        str[0] != '\0')
         self->priv->imei = g_strdup (str);
-    }
 
     if (qmi_message_dms_get_ids_output_get_esn (output, &str, NULL) &&
         str[0] != '\0') {
-        g_clear_pointer (&self->priv->esn, g_free);
         len = strlen (str);
         if (len == 7)
             self->priv->esn = g_strdup_printf ("0%s", str);  /* zero-pad to 8 chars */
@@ -721,7 +726,6 @@ dms_get_ids_ready (QmiClientDms *client,
 
     if (qmi_message_dms_get_ids_output_get_meid (output, &str, NULL) &&
         str[0] != '\0') {
-        g_clear_pointer (&self->priv->meid, g_free);
         len = strlen (str);
         if (len == 14)
             self->priv->meid = g_strdup (str);
@@ -3489,6 +3493,45 @@ modem_3gpp_scan_networks (MMIfaceModem3gpp *self,
                                  g_task_new (self, NULL, callback, user_data));
 }
 
+static void
+modem_3gpp_scan_networks_restricted (MMIfaceModem3gpp    *self,
+                                     MMModemMode          modes,
+                                     GCancellable        *cancellable,
+                                     GAsyncReadyCallback  callback,
+                                     gpointer             user_data)
+{
+    QmiClient                                *client = NULL;
+    QmiNasNetworkScanType                     network_type = 0;
+    g_autoptr(QmiMessageNasNetworkScanInput)  input = NULL;
+
+    g_assert (callback != NULL);
+
+    if (!mm_shared_qmi_ensure_client (MM_SHARED_QMI (self),
+                                      QMI_SERVICE_NAS, &client,
+                                      callback, user_data))
+        return;
+
+    if (modes & MM_MODEM_MODE_2G)
+        network_type |= QMI_NAS_NETWORK_SCAN_TYPE_GSM;
+    if (modes & MM_MODEM_MODE_3G)
+        network_type |= (QMI_NAS_NETWORK_SCAN_TYPE_UMTS | QMI_NAS_NETWORK_SCAN_TYPE_TD_SCDMA);
+    if (modes & MM_MODEM_MODE_4G)
+        network_type |= QMI_NAS_NETWORK_SCAN_TYPE_LTE;
+    if (modes & MM_MODEM_MODE_5G)
+        network_type |= QMI_NAS_NETWORK_SCAN_TYPE_5GNR;
+
+    input = qmi_message_nas_network_scan_input_new ();
+    qmi_message_nas_network_scan_input_set_network_type (input, network_type, NULL);
+
+    mm_obj_dbg (self, "scanning networks (restricted)...");
+    qmi_client_nas_network_scan (QMI_CLIENT_NAS (client),
+                                 input,
+                                 300,
+                                 cancellable,
+                                 (GAsyncReadyCallback)nas_network_scan_ready,
+                                 g_task_new (self, cancellable, callback, user_data));
+}
+
 /*****************************************************************************/
 /* Load operator name (3GPP interface) */
 
@@ -7174,7 +7217,7 @@ pdc_refresh_received (QmiClientPdc                  *client,
                       MMBroadbandModemQmi           *self)
 {
     mm_obj_dbg (self, "profile refresh indication was received");
-    mm_iface_modem_3gpp_profile_manager_updated (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self));
+    mm_iface_modem_3gpp_profile_manager_updated (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self), MM_3GPP_PROFILE_ID_UNKNOWN);
 }
 
 /*****************************************************************************/
@@ -7185,8 +7228,16 @@ profile_changed_indication_received (QmiClientWds                         *clien
                                      QmiIndicationWdsProfileChangedOutput *output,
                                      MMBroadbandModemQmi                  *self)
 {
+    QmiWdsProfileType profile_type;
+    guint8            profile_index;
+    gint              profile_id = MM_3GPP_PROFILE_ID_UNKNOWN;
+
+    if (qmi_indication_wds_profile_changed_output_get_profile_identifier (output, &profile_type, &profile_index, NULL) &&
+        profile_type == QMI_WDS_PROFILE_TYPE_3GPP)
+        profile_id = profile_index;
+
     mm_obj_dbg (self, "profile changed indication was received");
-    mm_iface_modem_3gpp_profile_manager_updated (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self));
+    mm_iface_modem_3gpp_profile_manager_updated (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self), profile_id);
 }
 
 /*****************************************************************************/
@@ -14392,6 +14443,7 @@ config_signal_info_v2 (GTask *task)
     SignalSetupThresholdsContext                    *ctx;
     g_autoptr(QmiMessageNasConfigSignalInfoV2Input)  input = NULL;
     guint                                            delta;
+    guint                                            snr_delta;
 
     ctx = g_task_get_task_data (task);
 
@@ -14403,8 +14455,16 @@ config_signal_info_v2 (GTask *task)
     qmi_message_nas_config_signal_info_v2_input_set_gsm_rssi_delta (input, delta, NULL);
     qmi_message_nas_config_signal_info_v2_input_set_wcdma_rssi_delta (input, delta, NULL);
     qmi_message_nas_config_signal_info_v2_input_set_lte_rssi_delta (input, delta, NULL);
-    /* use RSRP for 5GNR*/
+    /* the same delta also applies to RSRP (in units of 0.1dB), so that the
+     * extended signal info gets reported on LTE/5GNR cells where RSSI barely
+     * changes; SNR has its own delta, if any */
+    qmi_message_nas_config_signal_info_v2_input_set_lte_rsrp_delta (input, delta, NULL);
     qmi_message_nas_config_signal_info_v2_input_set_nr5g_rsrp_delta (input, delta, NULL);
+    snr_delta = mm_context_get_signal_sinr_threshold () * 10;
+    if (ctx->rssi_threshold && snr_delta) {
+        qmi_message_nas_config_signal_info_v2_input_set_lte_snr_delta (input, snr_delta, NULL);
+        qmi_message_nas_config_signal_info_v2_input_set_nr5g_snr_delta (input, snr_delta, NULL);
+    }
 
     qmi_client_nas_config_signal_info_v2 (ctx->client,
                                           input,
@@ -14821,6 +14881,7 @@ allocate_next_client (GTask *task)
     ctx = g_task_get_task_data (task);
 
     if (ctx->service_index == G_N_ELEMENTS (qmi_services)) {
+        mm_port_qmi_setup_client_pool (ctx->qmi);
         parent_initialization_started (task);
         return;
     }
@@ -15151,6 +15212,8 @@ iface_modem_3gpp_init (MMIfaceModem3gppInterface *iface)
     /* Other actions */
     iface->scan_networks = modem_3gpp_scan_networks;
     iface->scan_networks_finish = modem_3gpp_scan_networks_finish;
+    iface->scan_networks_restricted = modem_3gpp_scan_networks_restricted;
+    iface->scan_networks_restricted_finish = modem_3gpp_scan_networks_finish;
     iface->register_in_network = mm_shared_qmi_3gpp_register_in_network;
     iface->register_in_network_finish = mm_shared_qmi_3gpp_register_in_network_finish;
     iface->run_registration_checks = modem_3gpp_run_registration_checks;
@@ -15367,6 +15430,7 @@ iface_modem_location_init (MMIfaceModemLocationInterface *iface)
     iface->inject_assistance_data_finish = mm_shared_qmi_location_inject_assistance_data_finish;
     iface->load_assistance_data_servers = mm_shared_qmi_location_load_assistance_data_servers;
     iface->load_assistance_data_servers_finish = mm_shared_qmi_location_load_assistance_data_servers_finish;
+    iface->peek_location_cache = mm_shared_qmi_location_peek_location_cache;
 }
 
 static void
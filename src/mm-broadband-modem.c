@@ -2252,8 +2252,8 @@ signal_quality_csq_ready (MMBroadbandModem *self,
  * try the other command if the first one fails.
  */
 static const MMBaseModemAtCommand signal_quality_csq_sequence[] = {
-    { "+CSQ",  3, FALSE, mm_base_modem_response_processor_string_ignore_at_errors },
-    { "+CSQ?", 3, FALSE, mm_base_modem_response_processor_string_ignore_at_errors },
+    { "+CSQ",  3, FALSE, mm_base_modem_response_processor_string_ignore_at_errors, 0, MM_PORT_SCHEDULER_PRIORITY_BACKGROUND },
+    { "+CSQ?", 3, FALSE, mm_base_modem_response_processor_string_ignore_at_errors, 0, MM_PORT_SCHEDULER_PRIORITY_BACKGROUND },
     { NULL }
 };
 
@@ -5545,8 +5545,24 @@ typedef struct {
     GError *error_ps;
     GError *error_eps;
     GError *error_5gs;
+    /* All pending checks are run as a single sequence, so that they may be
+     * sent concatenated if the port supports it */
+    MMBaseModemAtCommand  checks[5];
+    gchar                *responses[4];
+    GError               *errors[4];
 } RunRegistrationChecksContext;
 
+static void
+run_registration_checks_context_clear_responses (RunRegistrationChecksContext *ctx)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (ctx->responses); i++) {
+        g_clear_pointer (&ctx->responses[i], g_free);
+        g_clear_error (&ctx->errors[i]);
+    }
+}
+
 static void
 run_registration_checks_context_free (RunRegistrationChecksContext *ctx)
 {
@@ -5554,6 +5570,7 @@ run_registration_checks_context_free (RunRegistrationChecksContext *ctx)
     g_clear_error (&ctx->error_ps);
     g_clear_error (&ctx->error_eps);
     g_clear_error (&ctx->error_5gs);
+    run_registration_checks_context_clear_responses (ctx);
     g_free (ctx);
 }
 
@@ -5600,14 +5617,12 @@ run_registration_checks_context_set_error (RunRegistrationChecksContext *ctx,
 }
 
 static void
-registration_status_check_ready (MMBroadbandModem *self,
-                                 GAsyncResult     *res,
-                                 GTask            *task)
+registration_status_check_process (MMBroadbandModem             *self,
+                                   RunRegistrationChecksContext *ctx,
+                                   const gchar                  *response,
+                                   GError                       *error)
 {
     g_autoptr(GMatchInfo)         match_info = NULL;
-    RunRegistrationChecksContext *ctx;
-    const gchar                  *response;
-    GError                       *error = NULL;
     guint                         i;
     gboolean                      parsed;
     gboolean                      cgreg = FALSE;
@@ -5619,15 +5634,12 @@ registration_status_check_ready (MMBroadbandModem *self,
     gulong                        tac = 0;
     gulong                        cid = 0;
 
-    ctx = g_task_get_task_data (task);
-
     /* Only one must be running */
     g_assert ((ctx->running_cs + ctx->running_ps + ctx->running_eps + ctx->running_5gs) == 1);
 
-    response = mm_base_modem_at_command_finish (MM_BASE_MODEM (self), res, &error);
     if (!response) {
+        g_assert (error);
         run_registration_checks_context_set_error (ctx, error);
-        run_registration_checks_context_step (task);
         return;
     }
 
@@ -5636,7 +5648,6 @@ registration_status_check_ready (MMBroadbandModem *self,
      */
     if (!response[0]) {
         /* Done */
-        run_registration_checks_context_step (task);
         return;
     }
 
@@ -5658,7 +5669,6 @@ registration_status_check_ready (MMBroadbandModem *self,
                              "Unknown registration status response: '%s'",
                              response);
         run_registration_checks_context_set_error (ctx, error);
-        run_registration_checks_context_step (task);
         return;
     }
 
@@ -5680,7 +5690,6 @@ registration_status_check_ready (MMBroadbandModem *self,
                                  "Error parsing registration response: '%s'",
                                  response);
         run_registration_checks_context_set_error (ctx, error);
-        run_registration_checks_context_step (task);
         return;
     }
 
@@ -5733,7 +5742,76 @@ registration_status_check_ready (MMBroadbandModem *self,
 
     mm_iface_modem_3gpp_update_access_technologies (MM_IFACE_MODEM_3GPP (self), act);
     mm_iface_modem_3gpp_update_location (MM_IFACE_MODEM_3GPP (self), lac, tac, cid);
+}
+
+static MMBaseModemAtResponseProcessorResult
+registration_status_check_store (MMBaseModem   *self,
+                                 gpointer       context,
+                                 const gchar   *command,
+                                 const gchar   *response,
+                                 gboolean       last_command,
+                                 const GError  *error,
+                                 GVariant     **result,
+                                 GError       **result_error)
+{
+    RunRegistrationChecksContext *ctx = context;
+    guint                         i;
+
+    /* Just store each response, they're processed once all are received */
+    for (i = 0; ctx->checks[i].command; i++) {
+        if (g_str_equal (ctx->checks[i].command, command)) {
+            ctx->responses[i] = g_strdup (response);
+            ctx->errors[i] = error ? g_error_copy (error) : NULL;
+            break;
+        }
+    }
+    return MM_BASE_MODEM_AT_RESPONSE_PROCESSOR_RESULT_CONTINUE;
+}
+
+static void
+registration_status_checks_add (RunRegistrationChecksContext *ctx,
+                                guint                         i,
+                                const gchar                  *command)
+{
+    g_assert (i < G_N_ELEMENTS (ctx->checks) - 1);
+    ctx->checks[i].command = command;
+    ctx->checks[i].timeout = 10;
+    ctx->checks[i].response_processor = registration_status_check_store;
+    ctx->checks[i].priority = MM_PORT_SCHEDULER_PRIORITY_BACKGROUND;
+    ctx->checks[i].batchable = TRUE;
+}
+
+static void
+registration_status_checks_ready (MMBroadbandModem *self,
+                                  GAsyncResult     *res,
+                                  GTask            *task)
+{
+    RunRegistrationChecksContext *ctx;
+    GError                       *error = NULL;
+    guint                         i;
+
+    ctx = g_task_get_task_data (task);
+
+    mm_base_modem_at_sequence_finish (MM_BASE_MODEM (self), res, NULL, &error);
 
+    for (i = 0; ctx->checks[i].command; i++) {
+        const gchar *command = ctx->checks[i].command;
+
+        ctx->running_cs = g_str_equal (command, "+CREG?");
+        ctx->running_ps = g_str_equal (command, "+CGREG?");
+        ctx->running_eps = g_str_equal (command, "+CEREG?");
+        ctx->running_5gs = g_str_equal (command, "+C5GREG?");
+
+        /* If the whole sequence failed (e.g. port not available), report
+         * the same error for every check */
+        if (!ctx->responses[i] && !ctx->errors[i])
+            ctx->errors[i] = error ? g_error_copy (error) : g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                                                          "Registration check not run");
+        registration_status_check_process (self, ctx, ctx->responses[i], g_steal_pointer (&ctx->errors[i]));
+    }
+
+    g_clear_error (&error);
+    run_registration_checks_context_clear_responses (ctx);
     run_registration_checks_context_step (task);
 }
 
@@ -5752,55 +5830,27 @@ run_registration_checks_context_step (GTask *task)
     ctx->running_eps = FALSE;
     ctx->running_5gs = FALSE;
 
-    if (ctx->run_cs) {
-        ctx->running_cs = TRUE;
-        ctx->run_cs = FALSE;
-        /* Check current CS-registration state. */
-        mm_base_modem_at_command (MM_BASE_MODEM (self),
-                                  "+CREG?",
-                                  10,
-                                  FALSE,
-                                  (GAsyncReadyCallback)registration_status_check_ready,
-                                  task);
-        return;
-    }
-
-    if (ctx->run_ps) {
-        ctx->running_ps = TRUE;
-        ctx->run_ps = FALSE;
-        /* Check current PS-registration state. */
-        mm_base_modem_at_command (MM_BASE_MODEM (self),
-                                  "+CGREG?",
-                                  10,
-                                  FALSE,
-                                  (GAsyncReadyCallback)registration_status_check_ready,
-                                  task);
-        return;
-    }
-
-    if (ctx->run_eps) {
-        ctx->running_eps = TRUE;
-        ctx->run_eps = FALSE;
-        /* Check current EPS-registration state. */
-        mm_base_modem_at_command (MM_BASE_MODEM (self),
-                                  "+CEREG?",
-                                  10,
-                                  FALSE,
-                                  (GAsyncReadyCallback)registration_status_check_ready,
-                                  task);
-        return;
-    }
-
-    if (ctx->run_5gs) {
-        ctx->running_5gs = TRUE;
-        ctx->run_5gs = FALSE;
-        /* Check current 5GS-registration state. */
-        mm_base_modem_at_command (MM_BASE_MODEM (self),
-                                  "+C5GREG?",
-                                  10,
-                                  FALSE,
-                                  (GAsyncReadyCallback)registration_status_check_ready,
-                                  task);
+    if (ctx->run_cs || ctx->run_ps || ctx->run_eps || ctx->run_5gs) {
+        guint n = 0;
+
+        memset (ctx->checks, 0, sizeof (ctx->checks));
+        /* Check current CS, PS, EPS and 5GS registration states */
+        if (ctx->run_cs)
+            registration_status_checks_add (ctx, n++, "+CREG?");
+        if (ctx->run_ps)
+            registration_status_checks_add (ctx, n++, "+CGREG?");
+        if (ctx->run_eps)
+            registration_status_checks_add (ctx, n++, "+CEREG?");
+        if (ctx->run_5gs)
+            registration_status_checks_add (ctx, n++, "+C5GREG?");
+        ctx->run_cs = ctx->run_ps = ctx->run_eps = ctx->run_5gs = FALSE;
+
+        mm_base_modem_at_sequence (MM_BASE_MODEM (self),
+                                   ctx->checks,
+                                   ctx, /* response processor context */
+                                   NULL,
+                                   (GAsyncReadyCallback)registration_status_checks_ready,
+                                   task);
         return;
     }
 
@@ -6405,12 +6455,13 @@ modem_3gpp_ussd_context_send_encoded (MMBroadbandModem *self)
     at_command = g_strdup_printf ("+CUSD=1,\"%s\",%d", encoded, scheme);
     g_free (encoded);
 
-    mm_base_modem_at_command (MM_BASE_MODEM (self),
-                              at_command,
-                              10,
-                              FALSE,
-                              (GAsyncReadyCallback)ussd_send_command_ready,
-                              NULL);
+    mm_base_modem_at_command_with_priority (MM_BASE_MODEM (self),
+                                            at_command,
+                                            10,
+                                            FALSE,
+                                            MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                            (GAsyncReadyCallback)ussd_send_command_ready,
+                                            NULL);
     g_free (at_command);
 }
 
@@ -6433,12 +6484,13 @@ modem_3gpp_ussd_context_send_unencoded (MMBroadbandModem *self)
                                    MM_MODEM_GSM_USSD_SCHEME_7BIT);
     g_free (quoted_command);
 
-    mm_base_modem_at_command (MM_BASE_MODEM (self),
-                              at_command,
-                              10,
-                              FALSE,
-                              (GAsyncReadyCallback)ussd_send_command_ready,
-                              NULL);
+    mm_base_modem_at_command_with_priority (MM_BASE_MODEM (self),
+                                            at_command,
+                                            10,
+                                            FALSE,
+                                            MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                            (GAsyncReadyCallback)ussd_send_command_ready,
+                                            NULL);
     g_free (at_command);
 }
 
@@ -11061,12 +11113,13 @@ modem_signal_load_values (MMIfaceModemSignal  *self,
                           GAsyncReadyCallback  callback,
                           gpointer             user_data)
 {
-    mm_base_modem_at_command (MM_BASE_MODEM (self),
-                              "+CESQ",
-                              3,
-                              FALSE,
-                              callback,
-                              user_data);
+    mm_base_modem_at_command_with_priority (MM_BASE_MODEM (self),
+                                            "+CESQ",
+                                            3,
+                                            FALSE,
+                                            MM_PORT_SCHEDULER_PRIORITY_BACKGROUND,
+                                            callback,
+                                            user_data);
 }
 
 /*****************************************************************************/
@@ -13001,6 +13054,7 @@ enable (MMBaseModem         *self,
 typedef enum {
     SYNCING_STEP_FIRST,
     SYNCING_STEP_NOTIFY,
+    SYNCING_STEP_RESET_REPLY_CACHE,
     SYNCING_STEP_IFACE_MODEM,
     SYNCING_STEP_IFACE_3GPP,
     SYNCING_STEP_IFACE_TIME,
@@ -13009,6 +13063,7 @@ typedef enum {
 
 typedef struct {
     SyncingStep step;
+    gint64      started;
 } SyncingContext;
 
 static void syncing_step (GTask *task);
@@ -13068,8 +13123,17 @@ iface_modem_sync_ready (MMIfaceModem *self,
 
     ctx = g_task_get_task_data (task);
 
-    if (!mm_iface_modem_sync_finish (self, res, &error))
+    if (!mm_iface_modem_sync_finish (self, res, &error)) {
+        /* If the modem identity couldn't be validated, a full reprobe has
+         * already been scheduled */
+        if (g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_ABORTED)) {
+            mm_obj_warn (self, "synchronization aborted: %s", error->message);
+            g_task_return_error (task, g_steal_pointer (&error));
+            g_object_unref (task);
+            return;
+        }
         mm_obj_warn (self, "modem interface synchronization failed: %s", error->message);
+    }
 
     /* The synchronization logic only runs on modems that were enabled before
      * the suspend/resume cycle, and therefore we should not get SIM-PIN locked
@@ -13111,6 +13175,21 @@ syncing_step (GTask *task)
         ctx->step++;
         /* fall through */
 
+    case SYNCING_STEP_RESET_REPLY_CACHE: {
+        GList *ports;
+        GList *l;
+
+        /* Replies cached before the suspension (e.g. the equipment identifier)
+         * may no longer be valid, and we want to validate them */
+        ports = mm_base_modem_find_ports (MM_BASE_MODEM (self), MM_PORT_SUBSYS_UNKNOWN, MM_PORT_TYPE_UNKNOWN);
+        for (l = ports; l; l = g_list_next (l)) {
+            if (MM_IS_PORT_SERIAL (l->data))
+                mm_port_serial_reset_reply_cache (MM_PORT_SERIAL (l->data));
+        }
+        g_list_free_full (ports, g_object_unref);
+        ctx->step++;
+    } /* fall through */
+
     case SYNCING_STEP_IFACE_MODEM:
         /*
          * Start interface Modem synchronization.
@@ -13159,8 +13238,8 @@ syncing_step (GTask *task)
         /* fall through */
 
     case SYNCING_STEP_LAST:
-        mm_obj_msg (self, "resume synchronization state (%d/%d): all done",
-                    ctx->step, SYNCING_STEP_LAST);
+        mm_obj_msg (self, "resume synchronization state (%d/%d): all done in %" G_GINT64_FORMAT "ms",
+                    ctx->step, SYNCING_STEP_LAST, (g_get_monotonic_time () - ctx->started) / 1000);
         /* We are done without errors! */
         g_task_return_boolean (task, TRUE);
         g_object_unref (task);
@@ -13188,6 +13267,7 @@ synchronize (MMBaseModem         *self,
     /* Create SyncingContext */
     ctx = g_new0 (SyncingContext, 1);
     ctx->step = SYNCING_STEP_FIRST;
+    ctx->started = g_get_monotonic_time ();
     g_task_set_task_data (task, ctx, (GDestroyNotify)g_free);
 
     syncing_step (task);
@@ -0,0 +1,185 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+#include <string.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-keyfile-cache.h"
+#include "mm-carrier-config-cache.h"
+
+#define CARRIER_CONFIG_CACHE_FILE_PREFIX "carrier-config-"
+#define CARRIER_CONFIG_CACHE_VERSION     1
+
+#define CARRIER_CONFIG_CACHE_HEADER_GROUP  "carrier-config"
+#define CARRIER_CONFIG_CACHE_KEY_REVISION  "revision"
+
+#define CARRIER_CONFIG_CACHE_ENTRY_GROUP_PREFIX "config-"
+#define CARRIER_CONFIG_CACHE_KEY_ID             "id"
+#define CARRIER_CONFIG_CACHE_KEY_TYPE           "type"
+#define CARRIER_CONFIG_CACHE_KEY_VERSION        "version"
+#define CARRIER_CONFIG_CACHE_KEY_DESCRIPTION    "description"
+#define CARRIER_CONFIG_CACHE_KEY_SIZE           "size"
+
+/*****************************************************************************/
+
+void
+mm_carrier_config_cache_entry_clear (MMCarrierConfigCacheEntry *entry)
+{
+    g_clear_pointer (&entry->id, g_array_unref);
+    g_clear_pointer (&entry->description, g_free);
+}
+
+gchar *
+mm_carrier_config_cache_build_filename (const gchar *device)
+{
+    return mm_keyfile_cache_build_filename (CARRIER_CONFIG_CACHE_FILE_PREFIX, device);
+}
+
+/*****************************************************************************/
+
+static gboolean
+load_entry (GKeyFile                   *key_file,
+            const gchar                *group,
+            MMCarrierConfigCacheEntry  *entry,
+            GError                    **error)
+{
+    g_autofree gchar  *id_str = NULL;
+    g_autofree guint8 *id = NULL;
+    gsize              id_len = 0;
+    GError            *inner_error = NULL;
+
+    id_str = g_key_file_get_string (key_file, group, CARRIER_CONFIG_CACHE_KEY_ID, error);
+    if (!id_str)
+        return FALSE;
+    id = mm_utils_hexstr2bin (id_str, -1, &id_len, error);
+    if (!id)
+        return FALSE;
+
+    entry->id = g_array_sized_new (FALSE, FALSE, sizeof (guint8), id_len);
+    g_array_append_vals (entry->id, id, id_len);
+
+    entry->config_type = (guint) g_key_file_get_uint64 (key_file, group, CARRIER_CONFIG_CACHE_KEY_TYPE, &inner_error);
+    if (!inner_error)
+        entry->version = (guint32) g_key_file_get_uint64 (key_file, group, CARRIER_CONFIG_CACHE_KEY_VERSION, &inner_error);
+    if (!inner_error)
+        entry->total_size = (guint32) g_key_file_get_uint64 (key_file, group, CARRIER_CONFIG_CACHE_KEY_SIZE, &inner_error);
+    if (inner_error) {
+        g_propagate_error (error, inner_error);
+        return FALSE;
+    }
+
+    entry->description = g_key_file_get_string (key_file, group, CARRIER_CONFIG_CACHE_KEY_DESCRIPTION, error);
+    return !!entry->description;
+}
+
+GArray *
+mm_carrier_config_cache_load (const gchar  *filename,
+                              const gchar  *revision,
+                              GError      **error)
+{
+    g_autoptr(GKeyFile)  key_file = NULL;
+    g_autoptr(GArray)    entries = NULL;
+    g_auto(GStrv)        groups = NULL;
+    g_autofree gchar    *stored_revision = NULL;
+    guint                i;
+
+    key_file = mm_keyfile_cache_load (filename, CARRIER_CONFIG_CACHE_HEADER_GROUP, CARRIER_CONFIG_CACHE_VERSION, error);
+    if (!key_file)
+        return NULL;
+
+    stored_revision = g_key_file_get_string (key_file, CARRIER_CONFIG_CACHE_HEADER_GROUP, CARRIER_CONFIG_CACHE_KEY_REVISION, NULL);
+    if (g_strcmp0 (stored_revision, revision) != 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND,
+                     "Carrier config cache doesn't match the firmware revision");
+        return NULL;
+    }
+
+    entries = g_array_new (FALSE, TRUE, sizeof (MMCarrierConfigCacheEntry));
+    g_array_set_clear_func (entries, (GDestroyNotify) mm_carrier_config_cache_entry_clear);
+
+    groups = g_key_file_get_groups (key_file, NULL);
+    for (i = 0; groups[i]; i++) {
+        MMCarrierConfigCacheEntry entry = { 0 };
+
+        if (!g_str_has_prefix (groups[i], CARRIER_CONFIG_CACHE_ENTRY_GROUP_PREFIX))
+            continue;
+
+        if (!load_entry (key_file, groups[i], &entry, error)) {
+            mm_carrier_config_cache_entry_clear (&entry);
+            g_prefix_error (error, "Invalid carrier config cache entry '%s': ", groups[i]);
+            return NULL;
+        }
+        g_array_append_val (entries, entry);
+    }
+
+    return g_steal_pointer (&entries);
+}
+
+gboolean
+mm_carrier_config_cache_save (const gchar                      *filename,
+                              const gchar                      *revision,
+                              const MMCarrierConfigCacheEntry  *entries,
+                              guint                             n_entries,
+                              GError                          **error)
+{
+    g_autoptr(GKeyFile) key_file = NULL;
+    guint               i;
+
+    key_file = g_key_file_new ();
+    g_key_file_set_string (key_file, CARRIER_CONFIG_CACHE_HEADER_GROUP, CARRIER_CONFIG_CACHE_KEY_REVISION, revision);
+
+    for (i = 0; i < n_entries; i++) {
+        g_autofree gchar *group = NULL;
+        g_autofree gchar *id_str = NULL;
+
+        group = g_strdup_printf (CARRIER_CONFIG_CACHE_ENTRY_GROUP_PREFIX "%u", i);
+        id_str = mm_utils_bin2hexstr ((const guint8 *) entries[i].id->data, entries[i].id->len);
+        g_key_file_set_string (key_file, group, CARRIER_CONFIG_CACHE_KEY_ID, id_str);
+        g_key_file_set_uint64 (key_file, group, CARRIER_CONFIG_CACHE_KEY_TYPE, entries[i].config_type);
+        g_key_file_set_uint64 (key_file, group, CARRIER_CONFIG_CACHE_KEY_VERSION, entries[i].version);
+        g_key_file_set_uint64 (key_file, group, CARRIER_CONFIG_CACHE_KEY_SIZE, entries[i].total_size);
+        g_key_file_set_string (key_file, group, CARRIER_CONFIG_CACHE_KEY_DESCRIPTION, entries[i].description);
+    }
+
+    return mm_keyfile_cache_save (filename, CARRIER_CONFIG_CACHE_HEADER_GROUP, CARRIER_CONFIG_CACHE_VERSION, key_file, error);
+}
+
+/*****************************************************************************/
+
+const MMCarrierConfigCacheEntry *
+mm_carrier_config_cache_lookup (GArray       *entries,
+                                guint         config_type,
+                                const GArray *id)
+{
+    guint i;
+
+    if (!entries)
+        return NULL;
+
+    for (i = 0; i < entries->len; i++) {
+        const MMCarrierConfigCacheEntry *entry;
+
+        entry = &g_array_index (entries, MMCarrierConfigCacheEntry, i);
+        if (entry->config_type == config_type &&
+            entry->id->len == id->len &&
+            !memcmp (entry->id->data, id->data, id->len))
+            return entry;
+    }
+    return NULL;
+}
@@ -0,0 +1,59 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_CARRIER_CONFIG_CACHE_H
+#define MM_CARRIER_CONFIG_CACHE_H
+
+#include <glib.h>
+
+/* Cache of the details of the carrier configurations installed in a modem,
+ * persisted across restarts.
+ *
+ * There is one cache file per device, named after a checksum of the device
+ * path. The cached details are only valid for the same firmware revision,
+ * as a firmware upgrade usually comes with a new set of configurations.
+ *
+ * Only the loading of the carrier config uses the cache. Switching to a
+ * different config reuses the list already loaded, and doesn't change the
+ * details of the installed configs. */
+
+typedef struct {
+    GArray  *id; /* guint8 */
+    guint    config_type;
+    guint32  version;
+    gchar   *description;
+    guint32  total_size;
+} MMCarrierConfigCacheEntry;
+
+void      mm_carrier_config_cache_entry_clear    (MMCarrierConfigCacheEntry *entry);
+
+gchar    *mm_carrier_config_cache_build_filename (const gchar *device);
+
+/* Returns an array of MMCarrierConfigCacheEntry */
+GArray   *mm_carrier_config_cache_load           (const gchar  *filename,
+                                                  const gchar  *revision,
+                                                  GError      **error);
+gboolean  mm_carrier_config_cache_save           (const gchar                      *filename,
+                                                  const gchar                      *revision,
+                                                  const MMCarrierConfigCacheEntry  *entries,
+                                                  guint                             n_entries,
+                                                  GError                          **error);
+
+/* Returns the entry with the given config type and id, if any */
+const MMCarrierConfigCacheEntry *mm_carrier_config_cache_lookup (GArray       *entries,
+                                                                 guint         config_type,
+                                                                 const GArray *id);
+
+#endif /* MM_CARRIER_CONFIG_CACHE_H */
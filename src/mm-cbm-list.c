@@ -33,6 +33,7 @@
 #include "mm-base-cbm.h"
 #include "mm-log-object.h"
 #include "mm-bind.h"
+#include "mm-perf-stats.h"
 
 static void log_object_iface_init (MMLogObjectInterface *iface);
 static void bind_iface_init (MMBindInterface *iface);
@@ -61,16 +62,159 @@ struct _MMCbmListPrivate {
     GObject *bind_to;
     /* The owner modem */
     MMBaseModem *modem;
-    /* List of cbm objects */
+    /* List of cbm objects, newest first */
     GList *list;
+    guint  count;
+    /* Index of cbm objects by serial and message id */
+    GHashTable *index;
+    /* Removed messages, oldest first, and their index */
+    GQueue     *tombstones;
+    GHashTable *tombstones_index;
+    /* Limits, 0 if unlimited */
+    guint max_messages;
+    guint retention;
+    guint expiry_id;
 };
 
+/*****************************************************************************/
+/* Index of CBM objects
+ *
+ * Per 3GPP TS 23.041, a CBM is identified by its message identifier and its
+ * serial number, which includes the geographical scope, the message code and
+ * the update number; a new update number is therefore a new message. */
+
+typedef struct {
+    MMBaseCbm *cbm;
+    gint64     received;
+} CbmIndexEntry;
+
+#define CBM_INDEX_KEY(serial, channel) GUINT_TO_POINTER (((guint32)(channel) << 16) | (serial))
+
+static CbmIndexEntry *
+index_lookup (MMCbmList *self,
+              guint16    serial,
+              guint16    channel)
+{
+    return g_hash_table_lookup (self->priv->index, CBM_INDEX_KEY (serial, channel));
+}
+
+static void
+index_add (MMCbmList *self,
+           MMBaseCbm *cbm)
+{
+    CbmIndexEntry *entry;
+
+    entry = g_slice_new (CbmIndexEntry);
+    entry->cbm = cbm;
+    entry->received = g_get_monotonic_time ();
+    g_hash_table_insert (self->priv->index,
+                         CBM_INDEX_KEY (mm_base_cbm_get_serial (cbm), mm_base_cbm_get_channel (cbm)),
+                         entry);
+}
+
+static void
+index_remove (MMCbmList *self,
+              MMBaseCbm *cbm)
+{
+    CbmIndexEntry *entry;
+
+    /* Only remove the entry if it's for this same object */
+    entry = index_lookup (self, mm_base_cbm_get_serial (cbm), mm_base_cbm_get_channel (cbm));
+    if (entry && entry->cbm == cbm)
+        g_hash_table_remove (self->priv->index,
+                             CBM_INDEX_KEY (mm_base_cbm_get_serial (cbm), mm_base_cbm_get_channel (cbm)));
+}
+
+static void
+cbm_index_entry_free (CbmIndexEntry *entry)
+{
+    g_slice_free (CbmIndexEntry, entry);
+}
+
+/*****************************************************************************/
+/* Tombstones of removed CBMs
+ *
+ * Once a complete message is removed from the list (evicted, expired or
+ * deleted) its rebroadcasts must still be dropped, or it would just be
+ * created again. The serial number and message identifier of the removed
+ * messages are kept for as long as the retention time (if any) from the
+ * moment they were removed, with a bound on the number of them. */
+
+#define CBM_TOMBSTONES_MAX 256
+
+typedef struct {
+    gpointer key;
+    gint64   removed;
+} CbmTombstone;
+
+static void
+cbm_tombstone_free (CbmTombstone *tombstone)
+{
+    g_slice_free (CbmTombstone, tombstone);
+}
+
+static void
+tombstones_prune (MMCbmList *self)
+{
+    gint64 now;
+
+    now = g_get_monotonic_time ();
+    while (!g_queue_is_empty (self->priv->tombstones)) {
+        CbmTombstone *tombstone;
+
+        tombstone = g_queue_peek_head (self->priv->tombstones);
+        if (g_queue_get_length (self->priv->tombstones) <= CBM_TOMBSTONES_MAX &&
+            (!self->priv->retention ||
+             (now - tombstone->removed) < (gint64) self->priv->retention * G_USEC_PER_SEC))
+            break;
+
+        g_queue_pop_head (self->priv->tombstones);
+        g_hash_table_remove (self->priv->tombstones_index, tombstone->key);
+        cbm_tombstone_free (tombstone);
+    }
+}
+
+static void
+tombstones_add (MMCbmList *self,
+                MMBaseCbm *cbm)
+{
+    CbmTombstone *tombstone;
+    gpointer      key;
+
+    /* Incomplete messages may still be completed by a rebroadcast */
+    if (!mm_base_cbm_is_complete (cbm))
+        return;
+
+    key = CBM_INDEX_KEY (mm_base_cbm_get_serial (cbm), mm_base_cbm_get_channel (cbm));
+    tombstone = g_hash_table_lookup (self->priv->tombstones_index, key);
+    if (tombstone)
+        g_queue_remove (self->priv->tombstones, tombstone);
+    else {
+        tombstone = g_slice_new (CbmTombstone);
+        tombstone->key = key;
+        g_hash_table_insert (self->priv->tombstones_index, key, tombstone);
+    }
+    tombstone->removed = g_get_monotonic_time ();
+    g_queue_push_tail (self->priv->tombstones, tombstone);
+
+    tombstones_prune (self);
+}
+
+static gboolean
+tombstones_lookup (MMCbmList *self,
+                   guint16    serial,
+                   guint16    channel)
+{
+    tombstones_prune (self);
+    return g_hash_table_contains (self->priv->tombstones_index, CBM_INDEX_KEY (serial, channel));
+}
+
 /*****************************************************************************/
 
 guint
 mm_cbm_list_get_count (MMCbmList *self)
 {
-    return g_list_length (self->priv->list);
+    return self->priv->count;
 }
 
 GStrv
@@ -80,7 +224,7 @@ mm_cbm_list_get_paths (MMCbmList *self)
     GList *l;
     guint i;
 
-    path_list = g_new0 (gchar *, 1 + g_list_length (self->priv->list));
+    path_list = g_new0 (gchar *, 1 + self->priv->count);
     for (i = 0, l = self->priv->list; l; l = g_list_next (l)) {
         const gchar *path;
 
@@ -141,6 +285,9 @@ mm_cbm_list_delete_cbm (MMCbmList *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     self->priv->list = g_list_delete_link (self->priv->list, l);
+    self->priv->count--;
+    index_remove (self, cbm);
+    tombstones_add (self, cbm);
 
     mm_base_cbm_unexport (cbm);
     g_object_unref (cbm);
@@ -152,31 +299,122 @@ mm_cbm_list_delete_cbm (MMCbmList *self,
 
 /*****************************************************************************/
 
-void
-mm_cbm_list_add_cbm (MMCbmList *self,
-                     MMBaseCbm *cbm)
+/* Removes the oldest CBM object, which is the last one in the list */
+static void
+remove_oldest (MMCbmList *self)
 {
-    self->priv->list = g_list_prepend (self->priv->list, g_object_ref (cbm));
+    GList               *l;
+    g_autoptr(MMBaseCbm) cbm = NULL;
+    g_autofree gchar    *path = NULL;
+
+    l = g_list_last (self->priv->list);
+    cbm = MM_BASE_CBM (l->data);
+    path = g_strdup (mm_base_cbm_get_path (cbm));
+
+    self->priv->list = g_list_delete_link (self->priv->list, l);
+    self->priv->count--;
+    index_remove (self, cbm);
+    tombstones_add (self, cbm);
+    mm_base_cbm_unexport (cbm);
+
+    g_signal_emit (self, signals[SIGNAL_DELETED], 0, path);
+}
+
+static void schedule_expiry (MMCbmList *self);
+
+static gboolean
+expire_cbms (MMCbmList *self)
+{
+    gint64 now;
+
+    self->priv->expiry_id = 0;
+
+    now = g_get_monotonic_time ();
+    while (self->priv->list) {
+        MMBaseCbm     *oldest;
+        CbmIndexEntry *entry;
+
+        oldest = MM_BASE_CBM (g_list_last (self->priv->list)->data);
+        entry = index_lookup (self, mm_base_cbm_get_serial (oldest), mm_base_cbm_get_channel (oldest));
+        if (entry && entry->cbm == oldest &&
+            (now - entry->received) < (gint64) self->priv->retention * G_USEC_PER_SEC)
+            break;
+
+        mm_obj_dbg (self, "CBM with serial '%u' and id '%u' expired",
+                    mm_base_cbm_get_serial (oldest), mm_base_cbm_get_channel (oldest));
+        mm_perf_stats_inc ("cbm", "expired");
+        remove_oldest (self);
+    }
+
+    schedule_expiry (self);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+schedule_expiry (MMCbmList *self)
+{
+    MMBaseCbm     *oldest;
+    CbmIndexEntry *entry;
+    gint64         elapsed;
+
+    if (!self->priv->retention || self->priv->expiry_id || !self->priv->list)
+        return;
+
+    oldest = MM_BASE_CBM (g_list_last (self->priv->list)->data);
+    entry = index_lookup (self, mm_base_cbm_get_serial (oldest), mm_base_cbm_get_channel (oldest));
+    elapsed = entry ? (g_get_monotonic_time () - entry->received) / G_USEC_PER_SEC : 0;
+
+    self->priv->expiry_id = g_timeout_add_seconds ((guint) MAX ((gint64) self->priv->retention - elapsed, 1),
+                                                   (GSourceFunc) expire_cbms,
+                                                   self);
+}
+
+static void
+add_cbm_internal (MMCbmList *self,
+                  MMBaseCbm *cbm,
+                  gboolean   received)
+{
+    self->priv->list = g_list_prepend (self->priv->list, cbm);
+    self->priv->count++;
+    index_add (self, cbm);
+
     g_signal_emit (self, signals[SIGNAL_ADDED], 0,
                    mm_base_cbm_get_path (cbm),
-                   FALSE);
-}
+                   received);
 
-/*****************************************************************************/
+    /* Make room for the new one */
+    while (self->priv->max_messages && self->priv->count > self->priv->max_messages) {
+        mm_perf_stats_inc ("cbm", "evicted");
+        remove_oldest (self);
+    }
 
-typedef struct {
-    guint16 serial;
-    guint16 channel;
-} PartIdAndSerial;
+    schedule_expiry (self);
+}
 
-static guint
-cmp_cbm_by_serial_and_id (MMBaseCbm *cbm,
-                          PartIdAndSerial *ctx)
+void
+mm_cbm_list_add_cbm (MMCbmList *self,
+                     MMBaseCbm *cbm)
 {
-    return !(mm_base_cbm_get_serial (cbm) == ctx->serial &&
-             mm_base_cbm_get_channel (cbm) == ctx->channel);
+    add_cbm_internal (self, g_object_ref (cbm), FALSE);
 }
 
+void
+mm_cbm_list_set_limits (MMCbmList *self,
+                        guint      max_messages,
+                        guint      retention)
+{
+    self->priv->max_messages = max_messages;
+    self->priv->retention = retention;
+
+    if (self->priv->expiry_id) {
+        g_source_remove (self->priv->expiry_id);
+        self->priv->expiry_id = 0;
+    }
+    schedule_expiry (self);
+}
+
+/*****************************************************************************/
+
 static gboolean
 take_part (MMCbmList *self,
            GObject *bind_to,
@@ -184,22 +422,19 @@ take_part (MMCbmList *self,
            MMCbmState state,
            GError **error)
 {
-    GList *l;
+    CbmIndexEntry *entry;
     MMBaseCbm *cbm;
-    PartIdAndSerial cmp;
+    guint16 serial;
+    guint16 channel;
 
-    cmp = (PartIdAndSerial){
-        .serial = mm_cbm_part_get_serial (part),
-        .channel = mm_cbm_part_get_channel (part),
-    };
-    l = g_list_find_custom (self->priv->list,
-                            &cmp,
-                            (GCompareFunc)cmp_cbm_by_serial_and_id);
-    if (l) {
+    serial = mm_cbm_part_get_serial (part);
+    channel = mm_cbm_part_get_channel (part);
+    entry = index_lookup (self, serial, channel);
+    if (entry) {
         /* Try to take the part */
         mm_obj_dbg (self, "found existing multipart CBM object with serial '%u' and id '%u': adding new part",
-                    cmp.serial, cmp.channel);
-        return mm_base_cbm_take_part (MM_BASE_CBM (l->data), part, error);
+                    serial, channel);
+        return mm_base_cbm_take_part (entry->cbm, part, error);
     }
 
     /* Create new cbm */
@@ -212,47 +447,25 @@ take_part (MMCbmList *self,
         return FALSE;
 
     mm_obj_dbg (self, "creating new multipart CBM object: need to receive %u parts with serial '%u' and id '%u'",
-                mm_cbm_part_get_num_parts (part), cmp.serial, cmp.channel);
-
-    self->priv->list = g_list_prepend (self->priv->list, cbm);
-    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
-                   mm_base_cbm_get_path (cbm),
-                   (state == MM_CBM_STATE_RECEIVED ||
-                    state == MM_CBM_STATE_RECEIVING));
+                mm_cbm_part_get_num_parts (part), serial, channel);
 
+    add_cbm_internal (self,
+                      cbm,
+                      (state == MM_CBM_STATE_RECEIVED ||
+                       state == MM_CBM_STATE_RECEIVING));
     return TRUE;
 }
 
-typedef struct {
-    guint16 serial;
-    guint16 channel;
-    guint8  part_num;
-} PartIdSerialAndNum;
-
-static guint
-cmp_cbm_by_serial_id_and_part_num (MMBaseCbm          *cbm,
-                                   PartIdSerialAndNum *ctx)
-{
-    return !(mm_base_cbm_get_serial (cbm) == ctx->serial &&
-             mm_base_cbm_get_channel (cbm) == ctx->channel &&
-             mm_base_cbm_has_part_num (cbm, ctx->part_num));
-}
-
 gboolean
 mm_cbm_list_has_part (MMCbmList *self,
                       guint16    serial,
                       guint16    channel,
                       guint8     part_num)
 {
-    PartIdSerialAndNum ctx = {
-        .channel = channel,
-        .serial = serial,
-        .part_num = part_num
-    };
-
-    return !!g_list_find_custom (self->priv->list,
-                                 &ctx,
-                                 (GCompareFunc)cmp_cbm_by_serial_id_and_part_num);
+    CbmIndexEntry *entry;
+
+    entry = index_lookup (self, serial, channel);
+    return (entry && mm_base_cbm_has_part_num (entry->cbm, part_num));
 }
 
 gboolean
@@ -262,11 +475,28 @@ mm_cbm_list_take_part (MMCbmList *self,
                        MMCbmState state,
                        GError   **error)
 {
+    /* Drop rebroadcasts of messages already removed from the list */
+    if (tombstones_lookup (self,
+                           mm_cbm_part_get_serial (part),
+                           mm_cbm_part_get_channel (part))) {
+        mm_perf_stats_inc ("cbm", "duplicates-dropped");
+        g_set_error (error,
+                     MM_CORE_ERROR,
+                     MM_CORE_ERROR_FAILED,
+                     "A message with serial %u and id %u was already received",
+                     mm_cbm_part_get_serial (part),
+                     mm_cbm_part_get_channel (part));
+        return FALSE;
+    }
+
     /* Ensure we don't have already taken a part with the same index */
     if (mm_cbm_list_has_part (self,
                               mm_cbm_part_get_serial (part),
                               mm_cbm_part_get_channel (part),
                               mm_cbm_part_get_part_num (part))) {
+        /* Rebroadcasts of the same page are expected, e.g. while the
+         * message is still active or after a cell change */
+        mm_perf_stats_inc ("cbm", "duplicates-dropped");
         g_set_error (error,
                      MM_CORE_ERROR,
                      MM_CORE_ERROR_FAILED,
@@ -352,6 +582,12 @@ mm_cbm_list_init (MMCbmList *self)
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self,
                                               MM_TYPE_CBM_LIST,
                                               MMCbmListPrivate);
+    self->priv->index = g_hash_table_new_full (g_direct_hash,
+                                               g_direct_equal,
+                                               NULL,
+                                               (GDestroyNotify) cbm_index_entry_free);
+    self->priv->tombstones = g_queue_new ();
+    self->priv->tombstones_index = g_hash_table_new (g_direct_hash, g_direct_equal);
 }
 
 static void
@@ -361,8 +597,19 @@ dispose (GObject *object)
 
     g_clear_object (&self->priv->modem);
     g_clear_object (&self->priv->bind_to);
+    if (self->priv->expiry_id) {
+        g_source_remove (self->priv->expiry_id);
+        self->priv->expiry_id = 0;
+    }
+    g_clear_pointer (&self->priv->index, g_hash_table_unref);
     g_list_free_full (self->priv->list, g_object_unref);
     self->priv->list = NULL;
+    self->priv->count = 0;
+    g_clear_pointer (&self->priv->tombstones_index, g_hash_table_unref);
+    if (self->priv->tombstones) {
+        g_queue_free_full (self->priv->tombstones, (GDestroyNotify) cbm_tombstone_free);
+        self->priv->tombstones = NULL;
+    }
 
     G_OBJECT_CLASS (mm_cbm_list_parent_class)->dispose (object);
 }
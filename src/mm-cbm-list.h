@@ -77,6 +77,12 @@ gboolean mm_cbm_list_take_part (MMCbmList *self,
 void mm_cbm_list_add_cbm (MMCbmList *self,
                           MMBaseCbm *cbm);
 
+/* Maximum number of CBM objects kept, and time (in seconds) they are kept
+ * after being received; 0 for no limit */
+void mm_cbm_list_set_limits (MMCbmList *self,
+                             guint      max_messages,
+                             guint      retention);
+
 void     mm_cbm_list_delete_cbm        (MMCbmList *self,
                                         const gchar *cbm_path,
                                         GAsyncReadyCallback callback,
@@ -41,6 +41,13 @@ static gboolean      debug;
 static MMFilterRule  filter_policy = MM_FILTER_POLICY_STRICT;
 static gboolean      no_auto_scan = NO_AUTO_SCAN_DEFAULT;
 static const gchar  *initial_kernel_events;
+static gboolean      sms_export_on_demand;
+static gint          cbm_max_messages;
+static gint          cbm_retention;
+static gint          signal_threshold_poll_rate = 5;
+static gint          signal_threshold_min_interval = 1;
+static gint          signal_threshold_max_interval = 120;
+static gint          signal_sinr_threshold = 3;
 
 static gboolean
 filter_policy_option_arg (const gchar  *option_name,
@@ -84,6 +91,41 @@ static const GOptionEntry entries[] = {
         "Path to initial kernel events file",
         "[PATH]"
     },
+    {
+        "sms-export-on-demand", 0, 0, G_OPTION_ARG_NONE, &sms_export_on_demand,
+        "Export SMS messages loaded from storage only when requested",
+        NULL
+    },
+    {
+        "cbm-max-messages", 0, 0, G_OPTION_ARG_INT, &cbm_max_messages,
+        "Maximum number of cell broadcast messages kept per modem, or 0 for no limit (default 0)",
+        "[COUNT]"
+    },
+    {
+        "cbm-retention", 0, 0, G_OPTION_ARG_INT, &cbm_retention,
+        "Time cell broadcast messages are kept after being received, or 0 for no limit (default 0)",
+        "[SECONDS]"
+    },
+    {
+        "signal-threshold-poll-rate", 0, 0, G_OPTION_ARG_INT, &signal_threshold_poll_rate,
+        "Polling rate used to emulate signal thresholds the modem cannot report, when no explicit rate is set (default 5)",
+        "[SECONDS]"
+    },
+    {
+        "signal-threshold-min-interval", 0, 0, G_OPTION_ARG_INT, &signal_threshold_min_interval,
+        "Minimum time between signal updates published because a threshold was crossed, or 0 for no limit (default 1)",
+        "[SECONDS]"
+    },
+    {
+        "signal-threshold-max-interval", 0, 0, G_OPTION_ARG_INT, &signal_threshold_max_interval,
+        "Maximum time without signal updates while thresholds are set, or 0 for no limit (default 120)",
+        "[SECONDS]"
+    },
+    {
+        "signal-sinr-threshold", 0, 0, G_OPTION_ARG_INT, &signal_sinr_threshold,
+        "Change in SINR or SNR that publishes a signal update while a RSSI threshold is set, or 0 to ignore them (default 3)",
+        "[DB]"
+    },
     {
         "debug", 0, 0, G_OPTION_ARG_NONE, &debug,
         "Run with extended debugging capabilities",
@@ -120,6 +162,49 @@ mm_context_get_no_auto_scan (void)
     return no_auto_scan;
 }
 
+gboolean
+mm_context_get_sms_export_on_demand (void)
+{
+    return sms_export_on_demand;
+}
+
+guint
+mm_context_get_cbm_max_messages (void)
+{
+    return (guint) MAX (cbm_max_messages, 0);
+}
+
+guint
+mm_context_get_cbm_retention (void)
+{
+    return (guint) MAX (cbm_retention, 0);
+}
+
+guint
+mm_context_get_signal_threshold_poll_rate (void)
+{
+    /* A rate is always needed to emulate thresholds */
+    return (guint) MAX (signal_threshold_poll_rate, 1);
+}
+
+guint
+mm_context_get_signal_threshold_min_interval (void)
+{
+    return (guint) MAX (signal_threshold_min_interval, 0);
+}
+
+guint
+mm_context_get_signal_threshold_max_interval (void)
+{
+    return (guint) MAX (signal_threshold_max_interval, 0);
+}
+
+guint
+mm_context_get_signal_sinr_threshold (void)
+{
+    return (guint) MAX (signal_sinr_threshold, 0);
+}
+
 MMFilterRule
 mm_context_get_filter_policy (void)
 {
@@ -135,6 +220,9 @@ static gboolean     log_journal;
 static gboolean     log_show_ts;
 static gboolean     log_rel_ts;
 static gboolean     log_personal_info;
+static gint         log_file_flush_interval = 1000;
+static gint         log_file_flush_size = 64 * 1024;
+static const gchar *log_file_sync_level = "WARN";
 
 static const GOptionEntry log_entries[] = {
     {
@@ -147,6 +235,21 @@ static const GOptionEntry log_entries[] = {
         "Path to log file",
         "[PATH]"
     },
+    {
+        "log-file-flush-interval", 0, 0, G_OPTION_ARG_INT, &log_file_flush_interval,
+        "Maximum time log file contents are kept buffered, or 0 to write synchronously (default 1000)",
+        "[MS]"
+    },
+    {
+        "log-file-flush-size", 0, 0, G_OPTION_ARG_INT, &log_file_flush_size,
+        "Amount of buffered log file contents that triggers a write (default 65536)",
+        "[BYTES]"
+    },
+    {
+        "log-file-sync-level", 0, 0, G_OPTION_ARG_STRING, &log_file_sync_level,
+        "Log level from which log file contents are written and synced right away (default WARN)",
+        "[LEVEL]"
+    },
 #if defined WITH_SYSTEMD_JOURNAL
     {
         "log-journal", 0, 0, G_OPTION_ARG_NONE, &log_journal,
@@ -198,6 +301,24 @@ mm_context_get_log_file (void)
     return log_file;
 }
 
+guint
+mm_context_get_log_file_flush_interval (void)
+{
+    return (guint) MAX (log_file_flush_interval, 0);
+}
+
+guint
+mm_context_get_log_file_flush_size (void)
+{
+    return (guint) MAX (log_file_flush_size, 0);
+}
+
+const gchar *
+mm_context_get_log_file_sync_level (void)
+{
+    return log_file_sync_level;
+}
+
 gboolean
 mm_context_get_log_journal (void)
 {
@@ -244,6 +365,7 @@ static gboolean  test_low_power_suspend_resume;
 static gboolean  test_no_qrtr;
 #endif
 static gboolean  test_multiplex_requested;
+static gboolean  test_port_priority_scheduler;
 #if defined WITH_MBIM
 static gboolean  test_mbimex_profile_management;
 #endif
@@ -304,6 +426,11 @@ static const GOptionEntry test_entries[] = {
         "Default to request multiplex support if no explicitly given",
         NULL
     },
+    {
+        "test-port-priority-scheduler", 0, 0, G_OPTION_ARG_NONE, &test_port_priority_scheduler,
+        "Share a priority-aware command scheduler among all AT ports of each modem",
+        NULL
+    },
 #if defined WITH_MBIM
     {
         "test-mbimex-profile-management", 0, 0, G_OPTION_ARG_NONE, &test_mbimex_profile_management,
@@ -392,6 +519,12 @@ mm_context_get_test_multiplex_requested (void)
     return test_multiplex_requested;
 }
 
+gboolean
+mm_context_get_test_port_priority_scheduler (void)
+{
+    return test_port_priority_scheduler;
+}
+
 #if defined WITH_MBIM
 gboolean
 mm_context_get_test_mbimex_profile_management (void)
@@ -28,9 +28,16 @@
 void mm_context_init (gint    argc,
                       gchar **argv);
 
-gboolean     mm_context_get_debug                 (void);
-const gchar *mm_context_get_initial_kernel_events (void);
-gboolean     mm_context_get_no_auto_scan          (void);
+gboolean     mm_context_get_debug                         (void);
+const gchar *mm_context_get_initial_kernel_events         (void);
+gboolean     mm_context_get_no_auto_scan                  (void);
+gboolean     mm_context_get_sms_export_on_demand          (void);
+guint        mm_context_get_cbm_max_messages              (void);
+guint        mm_context_get_cbm_retention                 (void);
+guint        mm_context_get_signal_threshold_poll_rate    (void);
+guint        mm_context_get_signal_threshold_min_interval (void);
+guint        mm_context_get_signal_threshold_max_interval (void);
+guint        mm_context_get_signal_sinr_threshold         (void);
 
 /* Filter support */
 MMFilterRule mm_context_get_filter_policy (void);
@@ -38,6 +45,9 @@ MMFilterRule mm_context_get_filter_policy (void);
 /* Logging support */
 const gchar *mm_context_get_log_level               (void);
 const gchar *mm_context_get_log_file                (void);
+guint        mm_context_get_log_file_flush_interval (void);
+guint        mm_context_get_log_file_flush_size     (void);
+const gchar *mm_context_get_log_file_sync_level     (void);
 gboolean     mm_context_get_log_journal             (void);
 gboolean     mm_context_get_log_timestamps          (void);
 gboolean     mm_context_get_log_relative_timestamps (void);
@@ -63,6 +73,7 @@ gboolean     mm_context_get_test_low_power_suspend_resume (void);
 gboolean     mm_context_get_test_no_qrtr (void);
 #endif
 gboolean     mm_context_get_test_multiplex_requested (void);
+gboolean     mm_context_get_test_port_priority_scheduler (void);
 #if defined WITH_MBIM
 gboolean     mm_context_get_test_mbimex_profile_management (void);
 #endif
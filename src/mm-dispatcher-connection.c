@@ -20,6 +20,7 @@
 #include "mm-errors-types.h"
 #include "mm-utils.h"
 #include "mm-log-object.h"
+#include "mm-perf-stats.h"
 #include "mm-dispatcher-connection.h"
 
 #if !defined CONNECTIONDIRPACKAGE
@@ -36,8 +37,15 @@
  * us killing it */
 #define MAX_CONNECTION_EXEC_TIME_SECS 5
 
+/* Scripts in this subdirectory of the dispatcher directories declare
+ * themselves independent of the others; they are all launched at once,
+ * in parallel with the ones run in sequence. */
+#define PARALLEL_SUBDIR "parallel.d"
+
 struct _MMDispatcherConnection {
     MMDispatcher parent;
+    /* Bearer path -> MMDispatcherConnectionQueue */
+    GHashTable *queues;
 };
 
 struct _MMDispatcherConnectionClass {
@@ -48,6 +56,164 @@ G_DEFINE_TYPE (MMDispatcherConnection, mm_dispatcher_connection, MM_TYPE_DISPATC
 
 /*****************************************************************************/
 
+/* Events of a given bearer are reported in order, one at a time, and only
+ * the net state is reported for the ones waiting:
+ *  - a new event identical to the last one waiting to be reported (same
+ *    event and same data port) is merged with it: the scripts are run once,
+ *    and all the merged requests get the same result;
+ *  - a new connected or disconnected event replaces a waiting event of the
+ *    opposite kind, and if that takes back to the state of the previous
+ *    event (e.g. the one being reported), the requests are merged with it;
+ *  - any other event is queued and reported on its own.
+ * Once there is a newer event waiting, the event being reported is stale,
+ * so the scripts not yet run for it are skipped. */
+typedef struct {
+    MMDispatcherConnectionEvent  event;
+    gchar                       *data_port;
+    GList                       *items;
+    /* Scripts were skipped because of a newer event */
+    gboolean                     superseded;
+} QueuedEvent;
+
+struct _MMDispatcherConnectionQueue {
+    /* QueuedEvent; the head is the one being reported */
+    GQueue *events;
+};
+
+static void
+queued_event_free (QueuedEvent *queued)
+{
+    g_assert (!queued->items);
+    g_free (queued->data_port);
+    g_slice_free (QueuedEvent, queued);
+}
+
+MMDispatcherConnectionQueue *
+mm_dispatcher_connection_queue_new (void)
+{
+    MMDispatcherConnectionQueue *queue;
+
+    queue = g_slice_new0 (MMDispatcherConnectionQueue);
+    queue->events = g_queue_new ();
+    return queue;
+}
+
+void
+mm_dispatcher_connection_queue_free (MMDispatcherConnectionQueue *queue)
+{
+    g_assert (g_queue_is_empty (queue->events));
+    g_queue_free (queue->events);
+    g_slice_free (MMDispatcherConnectionQueue, queue);
+}
+
+gboolean
+mm_dispatcher_connection_queue_is_empty (MMDispatcherConnectionQueue *queue)
+{
+    return g_queue_is_empty (queue->events);
+}
+
+static gboolean
+queue_has_pending (MMDispatcherConnectionQueue *queue)
+{
+    return (g_queue_get_length (queue->events) > 1);
+}
+
+gboolean
+mm_dispatcher_connection_queue_supersede (MMDispatcherConnectionQueue *queue)
+{
+    QueuedEvent *running;
+
+    if (!queue_has_pending (queue))
+        return FALSE;
+
+    running = g_queue_peek_head (queue->events);
+    running->superseded = TRUE;
+    return TRUE;
+}
+
+static gboolean
+queued_event_matches (QueuedEvent                 *queued,
+                      MMDispatcherConnectionEvent  event,
+                      const gchar                 *data_port)
+{
+    return (queued->event == event && g_strcmp0 (queued->data_port, data_port) == 0);
+}
+
+static gboolean
+events_are_opposite (MMDispatcherConnectionEvent a,
+                     MMDispatcherConnectionEvent b)
+{
+    return ((a == MM_DISPATCHER_CONNECTION_EVENT_CONNECTED && b == MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED) ||
+            (a == MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED && b == MM_DISPATCHER_CONNECTION_EVENT_CONNECTED));
+}
+
+gboolean
+mm_dispatcher_connection_queue_push (MMDispatcherConnectionQueue *queue,
+                                     MMDispatcherConnectionEvent  event,
+                                     const gchar                 *data_port,
+                                     gpointer                     item)
+{
+    QueuedEvent *queued;
+
+    /* Only the events waiting are updated, the event being reported is
+     * never replaced as its scripts may already have seen an older state */
+    if (queue_has_pending (queue)) {
+        QueuedEvent *previous;
+        guint        n_events;
+
+        queued = g_queue_peek_tail (queue->events);
+        if (queued_event_matches (queued, event, data_port)) {
+            queued->items = g_list_append (queued->items, item);
+            return FALSE;
+        }
+
+        if (events_are_opposite (queued->event, event)) {
+            queued->event = event;
+            g_free (queued->data_port);
+            queued->data_port = g_strdup (data_port);
+            queued->items = g_list_append (queued->items, item);
+
+            /* Back to the state of the previous event, nothing else to
+             * report, unless some scripts were already skipped for it */
+            n_events = g_queue_get_length (queue->events);
+            previous = g_queue_peek_nth (queue->events, n_events - 2);
+            if (!previous->superseded && queued_event_matches (previous, event, data_port)) {
+                previous->items = g_list_concat (previous->items, g_steal_pointer (&queued->items));
+                queued_event_free (g_queue_pop_tail (queue->events));
+            }
+            return FALSE;
+        }
+    }
+
+    queued = g_slice_new0 (QueuedEvent);
+    queued->event = event;
+    queued->data_port = g_strdup (data_port);
+    queued->items = g_list_append (NULL, item);
+    g_queue_push_tail (queue->events, queued);
+
+    /* Report right away if nothing else is being reported */
+    return (g_queue_get_length (queue->events) == 1);
+}
+
+GList *
+mm_dispatcher_connection_queue_pop (MMDispatcherConnectionQueue  *queue,
+                                    gpointer                     *next)
+{
+    QueuedEvent *queued;
+    GList       *items;
+
+    queued = g_queue_pop_head (queue->events);
+    g_assert (queued);
+    items = g_steal_pointer (&queued->items);
+    queued_event_free (queued);
+
+    queued = g_queue_peek_head (queue->events);
+    *next = queued ? queued->items->data : NULL;
+    return items;
+}
+
+/*****************************************************************************/
+
 typedef struct {
     gchar                      *modem_dbus_path;
     gchar                      *bearer_dbus_path;
@@ -55,9 +221,18 @@ typedef struct {
     MMDispatcherConnectionEvent event;
     GList                      *dispatcher_scripts;
     GFile                      *current;
+    gint64                      current_started;
+    gboolean                    sequential_done;
+    guint                       n_parallel_running;
     guint                       n_failures;
 } ConnectionRunContext;
 
+typedef struct {
+    GTask  *task;
+    GFile  *script;
+    gint64  started;
+} ParallelRunContext;
+
 static gchar *
 mm_dispatcher_connection_event_to_string (MMDispatcherConnectionEvent event)
 {
@@ -77,6 +252,7 @@ static void
 connection_run_context_free (ConnectionRunContext *ctx)
 {
     g_assert (!ctx->current);
+    g_assert (!ctx->n_parallel_running);
     g_free (ctx->modem_dbus_path);
     g_free (ctx->bearer_dbus_path);
     g_free (ctx->data_port);
@@ -84,6 +260,14 @@ connection_run_context_free (ConnectionRunContext *ctx)
     g_slice_free (ConnectionRunContext, ctx);
 }
 
+static void
+parallel_run_context_free (ParallelRunContext *pctx)
+{
+    g_object_unref (pctx->task);
+    g_object_unref (pctx->script);
+    g_slice_free (ParallelRunContext, pctx);
+}
+
 gboolean
 mm_dispatcher_connection_run_finish (MMDispatcherConnection  *self,
                                      GAsyncResult           *res,
@@ -92,7 +276,113 @@ mm_dispatcher_connection_run_finish (MMDispatcherConnection  *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
-static void connection_run_next (GTask *task);
+static void connection_run_start (GTask *task);
+static void connection_run_next  (GTask *task);
+
+static void
+connection_run_maybe_complete (GTask *task)
+{
+    MMDispatcherConnection       *self;
+    ConnectionRunContext         *ctx;
+    MMDispatcherConnectionQueue  *queue;
+    g_autofree gchar             *bearer_dbus_path = NULL;
+    GTask                        *next = NULL;
+    GList                        *tasks;
+    GList                        *l;
+    guint                         n_failures;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    if (!ctx->sequential_done || ctx->n_parallel_running)
+        return;
+
+    bearer_dbus_path = g_strdup (ctx->bearer_dbus_path);
+    n_failures = ctx->n_failures;
+
+    queue = g_hash_table_lookup (self->queues, bearer_dbus_path);
+    g_assert (queue);
+    tasks = mm_dispatcher_connection_queue_pop (queue, (gpointer *)&next);
+    g_assert (tasks && tasks->data == task);
+    if (mm_dispatcher_connection_queue_is_empty (queue))
+        g_hash_table_remove (self->queues, bearer_dbus_path);
+
+    /* The task run and the ones merged with it get the same result */
+    for (l = tasks; l; l = g_list_next (l)) {
+        if (n_failures)
+            g_task_return_new_error (G_TASK (l->data), MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                     "Failed %u " OPERATION_DESCRIPTION " operations",
+                                     n_failures);
+        else
+            g_task_return_boolean (G_TASK (l->data), TRUE);
+    }
+    g_list_free_full (tasks, g_object_unref);
+
+    /* Go on with the next event of the same bearer, if any */
+    if (next)
+        connection_run_start (next);
+}
+
+static void
+script_run_report (MMDispatcherConnection *self,
+                   ConnectionRunContext   *ctx,
+                   GFile                  *script,
+                   gint64                  started,
+                   GAsyncResult           *res)
+{
+    g_autoptr(GError)  error = NULL;
+    g_autofree gchar  *basename = NULL;
+    gint64             elapsed;
+
+    elapsed = g_get_monotonic_time () - started;
+    basename = g_file_get_basename (script);
+    /* Script runs are rare, no need to keep the counter around */
+    mm_perf_stat_add_latency (mm_perf_stats_lookup ("dispatcher-connection", basename), elapsed);
+
+    if (!mm_dispatcher_run_finish (MM_DISPATCHER (self), res, &error)) {
+        ctx->n_failures++;
+        mm_obj_warn (self, "Cannot run " OPERATION_DESCRIPTION " operation from %s: %s",
+                     g_file_peek_path (script), error->message);
+    } else
+        mm_obj_dbg (self, OPERATION_DESCRIPTION " operation successfully from %s (%" G_GINT64_FORMAT " ms)",
+                    g_file_peek_path (script), elapsed / 1000);
+}
+
+static gchar **
+build_argv (ConnectionRunContext *ctx,
+            GFile                *script)
+{
+    GPtrArray *aux;
+
+    aux = g_ptr_array_new ();
+    g_ptr_array_add (aux, g_file_get_path (script));
+    g_ptr_array_add (aux, g_strdup (ctx->modem_dbus_path));
+    g_ptr_array_add (aux, g_strdup (ctx->bearer_dbus_path));
+    g_ptr_array_add (aux, g_strdup (ctx->data_port));
+    g_ptr_array_add (aux, mm_dispatcher_connection_event_to_string (ctx->event));
+    g_ptr_array_add (aux, NULL);
+    return (gchar **) g_ptr_array_free (aux, FALSE);
+}
+
+static void
+parallel_dispatcher_run_ready (MMDispatcher       *self,
+                               GAsyncResult       *res,
+                               ParallelRunContext *pctx)
+{
+    ConnectionRunContext *ctx;
+    GTask                *task;
+
+    task = g_object_ref (pctx->task);
+    ctx = g_task_get_task_data (task);
+
+    script_run_report (MM_DISPATCHER_CONNECTION (self), ctx, pctx->script, pctx->started, res);
+    parallel_run_context_free (pctx);
+
+    g_assert (ctx->n_parallel_running > 0);
+    ctx->n_parallel_running--;
+    connection_run_maybe_complete (task);
+    g_object_unref (task);
+}
 
 static void
 dispatcher_run_ready (MMDispatcher *self,
@@ -100,17 +390,10 @@ dispatcher_run_ready (MMDispatcher *self,
                       GTask        *task)
 {
     ConnectionRunContext *ctx;
-    g_autoptr(GError)     error = NULL;
 
     ctx = g_task_get_task_data (task);
 
-    if (!mm_dispatcher_run_finish (self, res, &error)) {
-        ctx->n_failures++;
-        mm_obj_warn (self, "Cannot run " OPERATION_DESCRIPTION " operation from %s: %s",
-                     g_file_peek_path (ctx->current), error->message);
-    } else
-        mm_obj_dbg (self, OPERATION_DESCRIPTION " operation successfully from %s",
-                    g_file_peek_path (ctx->current));
+    script_run_report (MM_DISPATCHER_CONNECTION (self), ctx, ctx->current, ctx->current_started, res);
 
     g_clear_object (&ctx->current);
     connection_run_next (task);
@@ -121,40 +404,35 @@ connection_run_next (GTask *task)
 {
     MMDispatcherConnection *self;
     ConnectionRunContext   *ctx;
-    g_autofree gchar       *path = NULL;
-    GPtrArray              *aux;
     g_auto(GStrv)           argv = NULL;
 
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
+    /* Don't delay newer events of the same bearer with stale ones */
+    if (ctx->dispatcher_scripts &&
+        mm_dispatcher_connection_queue_supersede (g_hash_table_lookup (self->queues, ctx->bearer_dbus_path))) {
+        g_autofree gchar *event_str = NULL;
+
+        event_str = mm_dispatcher_connection_event_to_string (ctx->event);
+        mm_obj_dbg (self, "%s event on %s superseded: skipping %u scripts",
+                    event_str, ctx->bearer_dbus_path, g_list_length (ctx->dispatcher_scripts));
+        g_list_free_full (g_steal_pointer (&ctx->dispatcher_scripts), (GDestroyNotify)g_object_unref);
+    }
+
     if (!ctx->dispatcher_scripts) {
-        if (ctx->n_failures)
-            g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                     "Failed %u " OPERATION_DESCRIPTION " operations",
-                                     ctx->n_failures);
-        else
-            g_task_return_boolean (task, TRUE);
-        g_object_unref (task);
+        ctx->sequential_done = TRUE;
+        connection_run_maybe_complete (task);
         return;
     }
 
     /* store current file reference in context */
     ctx->current = ctx->dispatcher_scripts->data;
     ctx->dispatcher_scripts = g_list_delete_link (ctx->dispatcher_scripts, ctx->dispatcher_scripts);
-    path = g_file_get_path (ctx->current);
-
-    /* build argv */
-    aux = g_ptr_array_new ();
-    g_ptr_array_add (aux, g_steal_pointer (&path));
-    g_ptr_array_add (aux, g_strdup (ctx->modem_dbus_path));
-    g_ptr_array_add (aux, g_strdup (ctx->bearer_dbus_path));
-    g_ptr_array_add (aux, g_strdup (ctx->data_port));
-    g_ptr_array_add (aux, mm_dispatcher_connection_event_to_string (ctx->event));
-    g_ptr_array_add (aux, NULL);
-    argv = (GStrv) g_ptr_array_free (aux, FALSE);
+    ctx->current_started = g_get_monotonic_time ();
 
     /* run */
+    argv = build_argv (ctx, ctx->current);
     mm_dispatcher_run (MM_DISPATCHER (self),
                        argv,
                        MAX_CONNECTION_EXEC_TIME_SECS,
@@ -176,6 +454,91 @@ dispatcher_script_cmp (GFile *a,
     return g_strcmp0 (a_name, b_name);
 }
 
+static GList *
+collect_dispatcher_scripts (GFile        *dir_file,
+                            GList        *scripts,
+                            GCancellable *cancellable)
+{
+    g_autoptr(GFileEnumerator)  enumerator = NULL;
+    GFileInfo                  *info;
+    GFile                      *child;
+
+    enumerator = g_file_enumerate_children (dir_file,
+                                            G_FILE_ATTRIBUTE_STANDARD_NAME ","
+                                            G_FILE_ATTRIBUTE_STANDARD_TYPE,
+                                            G_FILE_QUERY_INFO_NONE,
+                                            cancellable,
+                                            NULL);
+    if (!enumerator)
+        return scripts;
+
+    while (g_file_enumerator_iterate (enumerator, &info, &child, cancellable, NULL) && child) {
+        /* Subdirectories (e.g. the one with the parallel scripts) are not
+         * scripts themselves */
+        if (g_file_info_get_file_type (info) == G_FILE_TYPE_DIRECTORY)
+            continue;
+        scripts = g_list_prepend (scripts, g_object_ref (child));
+    }
+    return scripts;
+}
+
+static void
+connection_run_start (GTask *task)
+{
+    MMDispatcherConnection *self;
+    ConnectionRunContext   *ctx;
+    GCancellable           *cancellable;
+    GList                  *parallel_scripts = NULL;
+    GList                  *l;
+    guint                   i;
+    const gchar            *enabled_dirs[] = {
+        CONNECTIONDIRUSER,    /* sysconfdir */
+        CONNECTIONDIRPACKAGE, /* libdir */
+    };
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+    cancellable = g_task_get_cancellable (task);
+
+    /* Iterate over all enabled dirs and collect all dispatcher script paths */
+    for (i = 0; i < G_N_ELEMENTS (enabled_dirs); i++) {
+        g_autoptr(GFile) dir_file = NULL;
+        g_autoptr(GFile) parallel_dir_file = NULL;
+
+        dir_file = g_file_new_for_path (enabled_dirs[i]);
+        ctx->dispatcher_scripts = collect_dispatcher_scripts (dir_file, ctx->dispatcher_scripts, cancellable);
+
+        parallel_dir_file = g_file_get_child (dir_file, PARALLEL_SUBDIR);
+        parallel_scripts = collect_dispatcher_scripts (parallel_dir_file, parallel_scripts, cancellable);
+    }
+
+    /* Sort all by filename, regardless of the directory where they're in */
+    ctx->dispatcher_scripts = g_list_sort (ctx->dispatcher_scripts, (GCompareFunc)dispatcher_script_cmp);
+
+    /* Launch all the independent scripts right away */
+    for (l = parallel_scripts; l; l = g_list_next (l)) {
+        ParallelRunContext *pctx;
+        g_auto(GStrv)       argv = NULL;
+
+        pctx = g_slice_new0 (ParallelRunContext);
+        pctx->task = g_object_ref (task);
+        pctx->script = g_object_ref (l->data);
+        pctx->started = g_get_monotonic_time ();
+        ctx->n_parallel_running++;
+
+        argv = build_argv (ctx, pctx->script);
+        mm_dispatcher_run (MM_DISPATCHER (self),
+                           argv,
+                           MAX_CONNECTION_EXEC_TIME_SECS,
+                           cancellable,
+                           (GAsyncReadyCallback) parallel_dispatcher_run_ready,
+                           pctx);
+    }
+    g_list_free_full (parallel_scripts, (GDestroyNotify)g_object_unref);
+
+    connection_run_next (task);
+}
+
 void
 mm_dispatcher_connection_run (MMDispatcherConnection *self,
                               const gchar            *modem_dbus_path,
@@ -186,13 +549,10 @@ mm_dispatcher_connection_run (MMDispatcherConnection *self,
                               GAsyncReadyCallback     callback,
                               gpointer                user_data)
 {
-    GTask                *task;
-    ConnectionRunContext *ctx;
-    guint                 i;
-    const gchar          *enabled_dirs[] = {
-        CONNECTIONDIRUSER,    /* sysconfdir */
-        CONNECTIONDIRPACKAGE, /* libdir */
-    };
+    GTask                       *task;
+    ConnectionRunContext        *ctx;
+    MMDispatcherConnectionQueue *queue;
+    g_autofree gchar            *event_str = NULL;
 
     task = g_task_new (self, cancellable, callback, user_data);
 
@@ -203,29 +563,20 @@ mm_dispatcher_connection_run (MMDispatcherConnection *self,
     ctx->event = event;
     g_task_set_task_data (task, ctx, (GDestroyNotify)connection_run_context_free);
 
-    /* Iterate over all enabled dirs and collect all dispatcher script paths */
-    for (i = 0; i < G_N_ELEMENTS (enabled_dirs); i++) {
-        g_autoptr(GFile)            dir_file = NULL;
-        g_autoptr(GFileEnumerator)  enumerator = NULL;
-        GFile                      *child;
-
-        dir_file = g_file_new_for_path (enabled_dirs[i]);
-        enumerator = g_file_enumerate_children (dir_file,
-                                                G_FILE_ATTRIBUTE_STANDARD_NAME,
-                                                G_FILE_QUERY_INFO_NONE,
-                                                cancellable,
-                                                NULL);
-        if (!enumerator)
-            continue;
-
-        while (g_file_enumerator_iterate (enumerator, NULL, &child, cancellable, NULL) && child)
-            ctx->dispatcher_scripts = g_list_prepend (ctx->dispatcher_scripts, g_object_ref (child));
+    queue = g_hash_table_lookup (self->queues, bearer_dbus_path);
+    if (!queue) {
+        queue = mm_dispatcher_connection_queue_new ();
+        g_hash_table_insert (self->queues, g_strdup (bearer_dbus_path), queue);
     }
 
-    /* Sort all by filename, regardless of the directory where they're in */
-    ctx->dispatcher_scripts = g_list_sort (ctx->dispatcher_scripts, (GCompareFunc)dispatcher_script_cmp);
+    /* The queue owns the task until it's completed */
+    if (mm_dispatcher_connection_queue_push (queue, event, data_port, task)) {
+        connection_run_start (task);
+        return;
+    }
 
-    connection_run_next (task);
+    event_str = mm_dispatcher_connection_event_to_string (event);
+    mm_obj_dbg (self, "%s event on %s queued", event_str, bearer_dbus_path);
 }
 
 /*****************************************************************************/
@@ -233,11 +584,25 @@ mm_dispatcher_connection_run (MMDispatcherConnection *self,
 static void
 mm_dispatcher_connection_init (MMDispatcherConnection *self)
 {
+    self->queues = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify)mm_dispatcher_connection_queue_free);
+}
+
+static void
+finalize (GObject *object)
+{
+    MMDispatcherConnection *self = MM_DISPATCHER_CONNECTION (object);
+
+    g_hash_table_unref (self->queues);
+
+    G_OBJECT_CLASS (mm_dispatcher_connection_parent_class)->finalize (object);
 }
 
 static void
 mm_dispatcher_connection_class_init (MMDispatcherConnectionClass *class)
 {
+    GObjectClass *object_class = G_OBJECT_CLASS (class);
+
+    object_class->finalize = finalize;
 }
 
 MM_DEFINE_SINGLETON_GETTER (MMDispatcherConnection, mm_dispatcher_connection_get, MM_TYPE_DISPATCHER_CONNECTION,
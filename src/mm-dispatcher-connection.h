@@ -52,4 +52,23 @@ gboolean                mm_dispatcher_connection_run_finish (MMDispatcherConnect
                                                              GAsyncResult           *res,
                                                              GError                **error);
 
+/* For testing purposes */
+typedef struct _MMDispatcherConnectionQueue MMDispatcherConnectionQueue;
+
+MMDispatcherConnectionQueue *mm_dispatcher_connection_queue_new         (void);
+void                         mm_dispatcher_connection_queue_free        (MMDispatcherConnectionQueue  *queue);
+gboolean                     mm_dispatcher_connection_queue_is_empty    (MMDispatcherConnectionQueue  *queue);
+/* Returns TRUE if there are events waiting behind the one being reported,
+ * which is then no longer merged with newer events */
+gboolean                     mm_dispatcher_connection_queue_supersede   (MMDispatcherConnectionQueue  *queue);
+/* Returns TRUE if the item must be reported right away */
+gboolean                     mm_dispatcher_connection_queue_push        (MMDispatcherConnectionQueue  *queue,
+                                                                         MMDispatcherConnectionEvent   event,
+                                                                         const gchar                  *data_port,
+                                                                         gpointer                      item);
+/* Removes the event being reported, returning the list of items merged in
+ * it, and gives the item of the next event to report, if any */
+GList                       *mm_dispatcher_connection_queue_pop         (MMDispatcherConnectionQueue  *queue,
+                                                                         gpointer                     *next);
+
 #endif /* MM_DISPATCHER_CONNECTION_H */
@@ -28,6 +28,7 @@
 #include "mm-log-object.h"
 #include "mm-error-helpers.h"
 #include "mm-log-helpers.h"
+#include "mm-profile-cache.h"
 
 #define SUPPORT_CHECKED_TAG "3gpp-profile-manager-support-checked-tag"
 #define SUPPORTED_TAG       "3gpp-profile-manager-supported-tag"
@@ -48,6 +49,10 @@ typedef struct {
     gint  update_ignored;
     /* throttle updated signal */
     guint updated_timeout_source;
+    /* profile list cache, only used while the modem reports profile changes */
+    MMProfileCache *cache;
+    /* profiles written by our own ongoing operations */
+    GArray *own_profile_ids;
 } Private;
 
 static void
@@ -55,6 +60,8 @@ private_free (Private *priv)
 {
     if (priv->updated_timeout_source)
         g_source_remove (priv->updated_timeout_source);
+    mm_profile_cache_free (priv->cache);
+    g_array_unref (priv->own_profile_ids);
     g_slice_free (Private, priv);
 }
 
@@ -69,12 +76,84 @@ get_private (MMIfaceModem3gppProfileManager *self)
     priv = g_object_get_qdata (G_OBJECT (self), private_quark);
     if (!priv) {
         priv = g_slice_new0 (Private);
+        priv->cache = mm_profile_cache_new ();
+        priv->own_profile_ids = g_array_new (FALSE, FALSE, sizeof (gint));
         g_object_set_qdata_full (G_OBJECT (self), private_quark, priv, (GDestroyNotify)private_free);
     }
 
     return priv;
 }
 
+/*****************************************************************************/
+/* Profile cache
+ *
+ * The list of profiles is kept in memory once loaded, and updated with the
+ * results of our own set and delete operations. The cache is only used while
+ * the modem reports profile changes, as those are the only way to know about
+ * changes done by other modem clients. */
+
+static void
+profile_cache_invalidate (MMIfaceModem3gppProfileManager *self)
+{
+    if (mm_profile_cache_invalidate (get_private (self)->cache))
+        mm_obj_dbg (self, "profile cache invalidated");
+}
+
+/* Profiles written by our own operations are tracked while update reports
+ * are being ignored, so that the reports caused by them don't invalidate
+ * the whole cache; the written profile is read back from the modem anyway */
+static void
+profile_cache_track_own_write (MMIfaceModem3gppProfileManager *self,
+                               gint                            profile_id)
+{
+    Private *priv;
+    guint    i;
+
+    priv = get_private (self);
+    if (profile_id == MM_3GPP_PROFILE_ID_UNKNOWN || priv->update_ignored <= 0)
+        return;
+
+    for (i = 0; i < priv->own_profile_ids->len; i++) {
+        if (g_array_index (priv->own_profile_ids, gint, i) == profile_id)
+            return;
+    }
+    g_array_append_val (priv->own_profile_ids, profile_id);
+}
+
+static gboolean
+profile_cache_is_own_write (MMIfaceModem3gppProfileManager *self,
+                            gint                            profile_id)
+{
+    Private *priv;
+    guint    i;
+
+    priv = get_private (self);
+    if (profile_id == MM_3GPP_PROFILE_ID_UNKNOWN || priv->update_ignored <= 0)
+        return FALSE;
+
+    for (i = 0; i < priv->own_profile_ids->len; i++) {
+        if (g_array_index (priv->own_profile_ids, gint, i) == profile_id)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void
+profile_cache_set_enabled (MMIfaceModem3gppProfileManager *self,
+                           gboolean                        enabled)
+{
+    mm_profile_cache_set_enabled (get_private (self)->cache, enabled);
+}
+
+static void
+profile_cache_set_list (MMIfaceModem3gppProfileManager *self,
+                        guint                           generation,
+                        GList                          *profiles)
+{
+    if (mm_profile_cache_set_list (get_private (self)->cache, generation, profiles))
+        mm_obj_dbg (self, "profile cache loaded: %u profiles", g_list_length (profiles));
+}
+
 /*****************************************************************************/
 
 void
@@ -117,8 +196,10 @@ mm_iface_modem_3gpp_profile_manager_update_ignore_stop (MMIfaceModem3gppProfileM
     priv->update_ignored--;
     if (priv->update_ignored > 0)
         mm_obj_dbg (self, "still ignoring profile manager updates during our own operations (%d ongoing)", priv->update_ignored);
-    else
+    else {
         mm_obj_dbg (self, "no longer ignoring profile manager updates during our own operations");
+        g_array_set_size (priv->own_profile_ids, 0);
+    }
 }
 
 /* Wait some ms before actually enabling back the update requests */
@@ -177,7 +258,8 @@ profile_manager_updated_emit (MMIfaceModem3gppProfileManager *self)
 }
 
 void
-mm_iface_modem_3gpp_profile_manager_updated (MMIfaceModem3gppProfileManager *self)
+mm_iface_modem_3gpp_profile_manager_updated (MMIfaceModem3gppProfileManager *self,
+                                             gint                            profile_id)
 {
     Private *priv;
 
@@ -188,6 +270,14 @@ mm_iface_modem_3gpp_profile_manager_updated (MMIfaceModem3gppProfileManager *sel
         return;
     }
 
+    /* The change may have been done by some other modem client, even while
+     * our own operations are ongoing, so only reports about the profiles
+     * we're writing ourselves keep the cache */
+    if (profile_cache_is_own_write (self, profile_id))
+        mm_obj_dbg (self, "profile '%d' updated by our own operations: cache kept", profile_id);
+    else
+        profile_cache_invalidate (self);
+
     if (priv->update_ignored > 0) {
         mm_obj_info (self, "skipping profile manager updated signal: ignored");
         return;
@@ -233,6 +323,7 @@ typedef struct {
     gchar                 *apn_type_str;
     GList                 *before_list;
     MM3gppProfile         *stored;
+    guint                  cache_generation;
 } SetProfileContext;
 
 static void
@@ -257,6 +348,12 @@ mm_iface_modem_3gpp_profile_manager_set_profile_finish (MMIfaceModem3gppProfileM
 
 static void set_profile_step (GTask *task);
 
+static void get_profile_internal (MMIfaceModem3gppProfileManager *self,
+                                  gint                            profile_id,
+                                  gboolean                        use_cache,
+                                  GAsyncReadyCallback             callback,
+                                  gpointer                        user_data);
+
 static void
 profile_manager_get_profile_after_ready (MMIfaceModem3gppProfileManager *self,
                                          GAsyncResult                   *res,
@@ -270,11 +367,15 @@ profile_manager_get_profile_after_ready (MMIfaceModem3gppProfileManager *self,
     ctx->stored = mm_iface_modem_3gpp_profile_manager_get_profile_finish (self, res, &error);
     if (!ctx->stored) {
         g_prefix_error (&error, "Couldn't validate update of profile '%d': ", ctx->profile_id);
+        /* the profile was possibly stored, so we don't know its contents */
+        profile_cache_invalidate (self);
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
     }
 
+    mm_profile_cache_update (get_private (self)->cache, ctx->cache_generation, ctx->stored);
+
     ctx->step++;
     set_profile_step (task);
 }
@@ -288,11 +389,13 @@ set_profile_step_list_after (GTask *task)
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    mm_iface_modem_3gpp_profile_manager_get_profile (
-        self,
-        ctx->profile_id,
-        (GAsyncReadyCallback)profile_manager_get_profile_after_ready,
-        task);
+    /* always read back the stored profile from the modem */
+    ctx->cache_generation = mm_profile_cache_get_generation (get_private (self)->cache);
+    get_profile_internal (self,
+                          ctx->profile_id,
+                          FALSE,
+                          (GAsyncReadyCallback)profile_manager_get_profile_after_ready,
+                          task);
 }
 
 static void
@@ -308,6 +411,7 @@ profile_manager_store_profile_ready (MMIfaceModem3gppProfileManager *self,
     ctx = g_task_get_task_data (task);
 
     if (!MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->store_profile_finish (self, res, &profile_id, &apn_type, &error)) {
+        profile_cache_invalidate (self);
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
@@ -324,6 +428,8 @@ profile_manager_store_profile_ready (MMIfaceModem3gppProfileManager *self,
         g_assert (ctx->profile_id == profile_id);
     }
 
+    profile_cache_track_own_write (self, profile_id);
+
     mm_obj_dbg (self, "stored profile '%s'", ctx->index_field_value_str);
 
     ctx->step++;
@@ -341,6 +447,8 @@ set_profile_step_store_profile (GTask *task)
 
     g_assert (!ctx->stored);
 
+    profile_cache_track_own_write (self, ctx->profile_id);
+
     MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->store_profile (
         self,
         ctx->requested,
@@ -890,6 +998,11 @@ mm_iface_modem_3gpp_profile_manager_get_profile_finish (MMIfaceModem3gppProfileM
     return MM_3GPP_PROFILE (g_task_propagate_pointer (G_TASK (res), error));
 }
 
+static void list_profiles_internal (MMIfaceModem3gppProfileManager *self,
+                                    gboolean                        use_cache,
+                                    GAsyncReadyCallback             callback,
+                                    gpointer                        user_data);
+
 static void
 get_profile_list_ready (MMIfaceModem3gppProfileManager *self,
                         GAsyncResult                   *res,
@@ -902,7 +1015,7 @@ get_profile_list_ready (MMIfaceModem3gppProfileManager *self,
 
     profile_id = GPOINTER_TO_INT (g_task_get_task_data (task));
 
-    if (!MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->list_profiles_finish (self, res, &profiles, &error)) {
+    if (!mm_iface_modem_3gpp_profile_manager_list_profiles_finish (self, res, &profiles, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
@@ -937,16 +1050,32 @@ get_profile_single_ready (MMIfaceModem3gppProfileManager *self,
     g_object_unref (task);
 }
 
-void
-mm_iface_modem_3gpp_profile_manager_get_profile (MMIfaceModem3gppProfileManager *self,
-                                                 gint                            profile_id,
-                                                 GAsyncReadyCallback             callback,
-                                                 gpointer                        user_data)
+static void
+get_profile_internal (MMIfaceModem3gppProfileManager *self,
+                      gint                            profile_id,
+                      gboolean                        use_cache,
+                      GAsyncReadyCallback             callback,
+                      gpointer                        user_data)
 {
-    GTask *task;
+    GTask   *task;
+    Private *priv;
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    priv = get_private (self);
+    if (use_cache && mm_profile_cache_is_valid (priv->cache)) {
+        MM3gppProfile *cached;
+        GError        *error = NULL;
+
+        cached = mm_profile_cache_dup_profile (priv->cache, profile_id, &error);
+        if (!cached)
+            g_task_return_error (task, error);
+        else
+            g_task_return_pointer (task, cached, g_object_unref);
+        g_object_unref (task);
+        return;
+    }
+
     if (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->get_profile &&
         MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->get_profile_finish) {
         MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->get_profile (
@@ -960,9 +1089,19 @@ mm_iface_modem_3gpp_profile_manager_get_profile (MMIfaceModem3gppProfileManager
     /* If there is no way to query one single profile, query all and filter */
     g_task_set_task_data (task, GINT_TO_POINTER (profile_id), NULL);
 
-    mm_iface_modem_3gpp_profile_manager_list_profiles (self,
-                                                       (GAsyncReadyCallback)get_profile_list_ready,
-                                                       task);
+    list_profiles_internal (self,
+                            use_cache,
+                            (GAsyncReadyCallback)get_profile_list_ready,
+                            task);
+}
+
+void
+mm_iface_modem_3gpp_profile_manager_get_profile (MMIfaceModem3gppProfileManager *self,
+                                                 gint                            profile_id,
+                                                 GAsyncReadyCallback             callback,
+                                                 gpointer                        user_data)
+{
+    get_profile_internal (self, profile_id, TRUE, callback, user_data);
 }
 
 /*****************************************************************************/
@@ -972,6 +1111,7 @@ mm_iface_modem_3gpp_profile_manager_get_profile (MMIfaceModem3gppProfileManager
 
 typedef struct {
     GList *profiles;
+    guint  cache_generation;
 } ListProfilesContext;
 
 static void
@@ -1006,24 +1146,38 @@ internal_list_profiles_ready (MMIfaceModem3gppProfileManager *self,
     ListProfilesContext *ctx;
     GError              *error = NULL;
 
-    ctx = g_slice_new0 (ListProfilesContext);
-    g_task_set_task_data (task, ctx, (GDestroyNotify) list_profiles_context_free);
+    ctx = g_task_get_task_data (task);
 
     if (!MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->list_profiles_finish (self, res, &ctx->profiles, &error))
         g_task_return_error (task, error);
-    else
+    else {
+        profile_cache_set_list (self, ctx->cache_generation, ctx->profiles);
         g_task_return_boolean (task, TRUE);
+    }
     g_object_unref (task);
 }
 
-void
-mm_iface_modem_3gpp_profile_manager_list_profiles (MMIfaceModem3gppProfileManager *self,
-                                                   GAsyncReadyCallback             callback,
-                                                   gpointer                        user_data)
+static void
+list_profiles_internal (MMIfaceModem3gppProfileManager *self,
+                        gboolean                        use_cache,
+                        GAsyncReadyCallback             callback,
+                        gpointer                        user_data)
 {
-    GTask *task;
+    GTask               *task;
+    ListProfilesContext *ctx;
+    Private             *priv;
 
     task = g_task_new (self, NULL, callback, user_data);
+    ctx = g_slice_new0 (ListProfilesContext);
+    g_task_set_task_data (task, ctx, (GDestroyNotify) list_profiles_context_free);
+
+    priv = get_private (self);
+    if (use_cache && mm_profile_cache_is_valid (priv->cache)) {
+        ctx->profiles = mm_profile_cache_dup_list (priv->cache);
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+    }
 
     /* Internal calls to the list profile logic may be performed even if the 3GPP Profile Manager
      * interface is not exposed in DBus, therefore, make sure this logic exits cleanly if there
@@ -1036,12 +1190,22 @@ mm_iface_modem_3gpp_profile_manager_list_profiles (MMIfaceModem3gppProfileManage
         return;
     }
 
+    /* The result is not cached if the cache gets invalidated meanwhile */
+    ctx->cache_generation = mm_profile_cache_get_generation (priv->cache);
     MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->list_profiles (
         MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self),
         (GAsyncReadyCallback)internal_list_profiles_ready,
         task);
 }
 
+void
+mm_iface_modem_3gpp_profile_manager_list_profiles (MMIfaceModem3gppProfileManager *self,
+                                                   GAsyncReadyCallback             callback,
+                                                   gpointer                        user_data)
+{
+    list_profiles_internal (self, TRUE, callback, user_data);
+}
+
 /*****************************************************************************/
 
 typedef struct {
@@ -1291,6 +1455,7 @@ typedef struct {
     GDBusMethodInvocation          *invocation;
     GVariant                       *dictionary;
     MMIfaceModem3gppProfileManager *self;
+    gint                            profile_id;
 } HandleDeleteContext;
 
 static void
@@ -1312,11 +1477,16 @@ delete_profile_ready (MMIfaceModem3gppProfileManager *self,
 
     if (!MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->delete_profile_finish (self, res, &error)) {
         mm_obj_warn (self, "failed deleting 3GPP profile: %s", error->message);
+        profile_cache_invalidate (self);
         /* process profile manager updates right away on error */
         mm_iface_modem_3gpp_profile_manager_update_ignore_stop (self);
         mm_dbus_method_invocation_take_error (ctx->invocation, error);
     } else {
         mm_obj_info (self, "3GPP profile deleted");
+        if (ctx->profile_id != MM_3GPP_PROFILE_ID_UNKNOWN)
+            mm_profile_cache_remove (get_private (self)->cache, ctx->profile_id);
+        else
+            profile_cache_invalidate (self);
         /* delay processing profile manager updates on success */
         mm_iface_modem_3gpp_profile_manager_update_ignore_stop_delayed (self);
         mm_gdbus_modem3gpp_profile_manager_complete_delete (ctx->skeleton, ctx->invocation);
@@ -1403,8 +1573,11 @@ handle_delete_auth_ready (MMIfaceAuth         *self,
     mm_obj_info (self, "processing user request to delete 3GPP profile...");
     mm_log_3gpp_profile (self, MM_LOG_LEVEL_INFO, "  ", profile);
 
+    ctx->profile_id = profile_id;
+
     /* Start ignoring our own indications */
     mm_iface_modem_3gpp_profile_manager_update_ignore_start (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self));
+    profile_cache_track_own_write (MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self), profile_id);
 
     MM_IFACE_MODEM_3GPP_PROFILE_MANAGER_GET_IFACE (self)->delete_profile (
         MM_IFACE_MODEM_3GPP_PROFILE_MANAGER (self),
@@ -1519,6 +1692,8 @@ interface_disabling_step (GTask *task)
 
     switch (ctx->step) {
     case DISABLING_STEP_FIRST:
+        /* Profile changes will no longer be reported */
+        profile_cache_set_enabled (self, FALSE);
         ctx->step++;
         /* fall through */
 
@@ -1652,6 +1827,9 @@ enable_unsolicited_events_ready (MMIfaceModem3gppProfileManager *self,
         mm_obj_dbg (self, "couldn't enable unsolicited profile management events: %s", error->message);
     }
 
+    /* Profiles can only be cached if the modem reports changes */
+    profile_cache_set_enabled (self, !error);
+
     /* Go on to next step */
     ctx = g_task_get_task_data (task);
     ctx->step++;
@@ -223,10 +223,14 @@ void mm_iface_modem_3gpp_profile_manager_update_ignore_start        (MMIfaceMode
 void mm_iface_modem_3gpp_profile_manager_update_ignore_stop         (MMIfaceModem3gppProfileManager *self);
 void mm_iface_modem_3gpp_profile_manager_update_ignore_stop_delayed (MMIfaceModem3gppProfileManager *self);
 
-/* Helper to emit the Updated signal by implementations */
-void mm_iface_modem_3gpp_profile_manager_updated (MMIfaceModem3gppProfileManager *self);
+/* Helper to emit the Updated signal by implementations, also invalidates the
+ * profile cache unless the updated profile is one being written by our own
+ * operations. The profile id is MM_3GPP_PROFILE_ID_UNKNOWN if not reported. */
+void mm_iface_modem_3gpp_profile_manager_updated (MMIfaceModem3gppProfileManager *self,
+                                                  gint                            profile_id);
 
-/* Internal list profile management */
+/* Internal list profile management. Get and list are served from the in-memory
+ * profile cache while the modem reports profile changes. */
 void           mm_iface_modem_3gpp_profile_manager_get_profile          (MMIfaceModem3gppProfileManager  *self,
                                                                          gint                             profile_id,
                                                                          GAsyncReadyCallback              callback,
@@ -80,6 +80,8 @@ typedef struct {
     gboolean check_running;
     /* Packet service state */
     gboolean packet_service_state_update_supported;
+    /* Ongoing incremental network scan */
+    GCancellable *incremental_scan_cancellable;
 } Private;
 
 static void
@@ -92,6 +94,10 @@ private_free (Private *priv)
     }
     if (priv->check_timeout_source)
         g_source_remove (priv->check_timeout_source);
+    if (priv->incremental_scan_cancellable) {
+        g_cancellable_cancel (priv->incremental_scan_cancellable);
+        g_object_unref (priv->incremental_scan_cancellable);
+    }
     g_slice_free (Private, priv);
 }
 
@@ -1056,6 +1062,9 @@ handle_scan (MmGdbusModem3gpp      *skeleton,
     ctx->invocation = g_object_ref (invocation);
     ctx->self = g_object_ref (self);
 
+    /* Scans may take minutes, so they don't take the operation lock, which
+     * would otherwise delay state changes (enabling, disabling, power state
+     * updates, resets) until the scan is over */
     mm_iface_auth_authorize (MM_IFACE_AUTH (self),
                              invocation,
                              MM_AUTHORIZATION_DEVICE_CONTROL,
@@ -1066,6 +1075,300 @@ handle_scan (MmGdbusModem3gpp      *skeleton,
 
 /*****************************************************************************/
 
+typedef struct {
+    MmGdbusModem3gpp      *skeleton;
+    GDBusMethodInvocation *invocation;
+    MMIfaceModem3gpp      *self;
+    GCancellable          *cancellable;
+    GArray                *passes;
+    guint                  current_pass;
+    GList                 *results;
+    GError                *saved_error;
+} HandleScanIncrementalContext;
+
+static void
+handle_scan_incremental_context_free (HandleScanIncrementalContext *ctx)
+{
+    if (ctx->cancellable) {
+        Private *priv;
+
+        priv = get_private (ctx->self);
+        if (priv->incremental_scan_cancellable == ctx->cancellable)
+            g_clear_object (&priv->incremental_scan_cancellable);
+        g_object_unref (ctx->cancellable);
+    }
+
+    g_clear_error (&ctx->saved_error);
+    mm_3gpp_network_info_list_free (ctx->results);
+    if (ctx->passes)
+        g_array_unref (ctx->passes);
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_slice_free (HandleScanIncrementalContext, ctx);
+}
+
+static void
+scan_incremental_process_results (HandleScanIncrementalContext *ctx,
+                                  GList                        *info_list)
+{
+    GList *new_list;
+
+    /* The same network may be found in several passes */
+    new_list = mm_3gpp_network_info_list_filter_new (ctx->results, info_list);
+    if (new_list) {
+        g_autoptr(GVariant) dict_array = NULL;
+
+        mm_obj_info (ctx->self, "network scan pass %u/%u: %u new networks found",
+                     ctx->current_pass + 1, ctx->passes->len, g_list_length (new_list));
+        dict_array = build_scan_networks_result (ctx->self, new_list);
+        mm_gdbus_modem3gpp_emit_scan_results (ctx->skeleton, dict_array);
+        ctx->results = g_list_concat (ctx->results, new_list);
+    }
+}
+
+static void scan_incremental_next_pass (HandleScanIncrementalContext *ctx);
+
+static void
+scan_incremental_pass_ready (MMIfaceModem3gpp             *self,
+                             GAsyncResult                 *res,
+                             HandleScanIncrementalContext *ctx)
+{
+    GError *error = NULL;
+    GList  *info_list;
+
+    if (MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_restricted)
+        info_list = MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_restricted_finish (self, res, &error);
+    else
+        info_list = MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_finish (self, res, &error);
+
+    if (error) {
+        /* A failed pass doesn't abort the whole scan, e.g. the modem may not
+         * allow scanning some of the access technologies */
+        mm_obj_dbg (self, "network scan pass %u/%u failed: %s",
+                    ctx->current_pass + 1, ctx->passes->len, error->message);
+        g_clear_error (&ctx->saved_error);
+        ctx->saved_error = error;
+    } else
+        scan_incremental_process_results (ctx, info_list);
+
+    ctx->current_pass++;
+    scan_incremental_next_pass (ctx);
+}
+
+static void
+scan_incremental_next_pass (HandleScanIncrementalContext *ctx)
+{
+    g_autoptr(GVariant) dict_array = NULL;
+
+    if (g_cancellable_is_cancelled (ctx->cancellable)) {
+        mm_obj_info (ctx->self, "network scan cancelled: %u found", g_list_length (ctx->results));
+        mm_dbus_method_invocation_return_error_literal (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_CANCELLED,
+                                                        "Network scan cancelled");
+        handle_scan_incremental_context_free (ctx);
+        return;
+    }
+
+    if (ctx->current_pass < ctx->passes->len) {
+        if (MM_IFACE_MODEM_3GPP_GET_IFACE (ctx->self)->scan_networks_restricted) {
+            MMModemMode       modes;
+            g_autofree gchar *modes_str = NULL;
+
+            modes = g_array_index (ctx->passes, MMModemMode, ctx->current_pass);
+            modes_str = mm_modem_mode_build_string_from_mask (modes);
+            mm_obj_dbg (ctx->self, "network scan pass %u/%u: %s",
+                        ctx->current_pass + 1, ctx->passes->len, modes_str);
+            MM_IFACE_MODEM_3GPP_GET_IFACE (ctx->self)->scan_networks_restricted (
+                ctx->self,
+                modes,
+                ctx->cancellable,
+                (GAsyncReadyCallback)scan_incremental_pass_ready,
+                ctx);
+        } else
+            MM_IFACE_MODEM_3GPP_GET_IFACE (ctx->self)->scan_networks (
+                ctx->self,
+                (GAsyncReadyCallback)scan_incremental_pass_ready,
+                ctx);
+        return;
+    }
+
+    /* Only fail if no pass succeeded */
+    if (!ctx->results && ctx->saved_error) {
+        mm_obj_warn (ctx->self, "failed scanning networks: %s", ctx->saved_error->message);
+        mm_dbus_method_invocation_take_error (ctx->invocation, g_steal_pointer (&ctx->saved_error));
+        handle_scan_incremental_context_free (ctx);
+        return;
+    }
+
+    mm_obj_info (ctx->self, "incremental network scan performed: %u found", g_list_length (ctx->results));
+    dict_array = build_scan_networks_result (ctx->self, ctx->results);
+    mm_gdbus_modem3gpp_complete_scan_incremental (ctx->skeleton, ctx->invocation, dict_array);
+    handle_scan_incremental_context_free (ctx);
+}
+
+static void
+handle_scan_incremental_auth_ready (MMIfaceAuth                  *auth,
+                                    GAsyncResult                 *res,
+                                    HandleScanIncrementalContext *ctx)
+{
+    MMIfaceModem3gpp *self = MM_IFACE_MODEM_3GPP (auth);
+    Private          *priv;
+    GError           *error = NULL;
+    MMModemMode       supported = MM_MODEM_MODE_NONE;
+    MMModemMode       allowed = MM_MODEM_MODE_ANY;
+    MMModemMode       preferred = MM_MODEM_MODE_NONE;
+
+    if (!mm_iface_auth_authorize_finish (auth, res, &error)) {
+        mm_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_scan_incremental_context_free (ctx);
+        return;
+    }
+
+    /* If scanning is not implemented, report an error */
+    if ((!MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks ||
+         !MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_finish) &&
+        (!MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_restricted ||
+         !MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_restricted_finish)) {
+        mm_dbus_method_invocation_return_error_literal (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
+                                                        "Cannot scan networks: operation not supported");
+        handle_scan_incremental_context_free (ctx);
+        return;
+    }
+
+    if (mm_iface_modem_abort_invocation_if_state_not_reached (MM_IFACE_MODEM (self),
+                                                              ctx->invocation,
+                                                              MM_MODEM_STATE_ENABLED)) {
+        handle_scan_incremental_context_free (ctx);
+        return;
+    }
+
+    priv = get_private (self);
+    if (priv->incremental_scan_cancellable) {
+        mm_dbus_method_invocation_return_error_literal (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_IN_PROGRESS,
+                                                        "Network scan already in progress");
+        handle_scan_incremental_context_free (ctx);
+        return;
+    }
+    ctx->cancellable = g_cancellable_new ();
+    priv->incremental_scan_cancellable = g_object_ref (ctx->cancellable);
+
+    /* Restricted scans are needed to run one pass per access technology */
+    if (MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_restricted &&
+        MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_restricted_finish) {
+        mm_iface_modem_get_current_modes (MM_IFACE_MODEM (self), &allowed, &preferred);
+        if (mm_iface_modem_is_5g (MM_IFACE_MODEM (self)))
+            supported |= MM_MODEM_MODE_5G;
+        if (mm_iface_modem_is_4g (MM_IFACE_MODEM (self)))
+            supported |= MM_MODEM_MODE_4G;
+        if (mm_iface_modem_is_3g (MM_IFACE_MODEM (self)))
+            supported |= MM_MODEM_MODE_3G;
+        if (mm_iface_modem_is_2g (MM_IFACE_MODEM (self)))
+            supported |= MM_MODEM_MODE_2G;
+    }
+    ctx->passes = mm_3gpp_build_incremental_scan_passes (supported, allowed);
+
+    mm_obj_info (self, "processing user request to scan networks incrementally (%u passes)...", ctx->passes->len);
+    scan_incremental_next_pass (ctx);
+}
+
+static gboolean
+handle_scan_incremental (MmGdbusModem3gpp      *skeleton,
+                         GDBusMethodInvocation *invocation,
+                         MMIfaceModem3gpp      *self)
+{
+    HandleScanIncrementalContext *ctx;
+
+    ctx = g_slice_new0 (HandleScanIncrementalContext);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self = g_object_ref (self);
+
+    /* Same as the full scan, no operation lock */
+    mm_iface_auth_authorize (MM_IFACE_AUTH (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_scan_incremental_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    MmGdbusModem3gpp      *skeleton;
+    GDBusMethodInvocation *invocation;
+    MMIfaceModem3gpp      *self;
+} HandleCancelScanContext;
+
+static void
+handle_cancel_scan_context_free (HandleCancelScanContext *ctx)
+{
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_slice_free (HandleCancelScanContext, ctx);
+}
+
+static void
+handle_cancel_scan_auth_ready (MMIfaceAuth             *self,
+                               GAsyncResult            *res,
+                               HandleCancelScanContext *ctx)
+{
+    Private *priv;
+    GError  *error = NULL;
+
+    if (!mm_iface_auth_authorize_finish (self, res, &error)) {
+        mm_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_cancel_scan_context_free (ctx);
+        return;
+    }
+
+    /* Without restricted scans, the scan is a single full scan which can't
+     * be aborted */
+    if (!MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_restricted ||
+        !MM_IFACE_MODEM_3GPP_GET_IFACE (self)->scan_networks_restricted_finish) {
+        mm_dbus_method_invocation_return_error_literal (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
+                                                        "Cannot cancel network scan: operation not supported");
+        handle_cancel_scan_context_free (ctx);
+        return;
+    }
+
+    priv = get_private (MM_IFACE_MODEM_3GPP (self));
+    if (!priv->incremental_scan_cancellable) {
+        mm_dbus_method_invocation_return_error_literal (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                                                        "No network scan in progress");
+        handle_cancel_scan_context_free (ctx);
+        return;
+    }
+
+    mm_obj_info (self, "processing user request to cancel network scan...");
+    g_cancellable_cancel (priv->incremental_scan_cancellable);
+    mm_gdbus_modem3gpp_complete_cancel_scan (ctx->skeleton, ctx->invocation);
+    handle_cancel_scan_context_free (ctx);
+}
+
+static gboolean
+handle_cancel_scan (MmGdbusModem3gpp      *skeleton,
+                    GDBusMethodInvocation *invocation,
+                    MMIfaceModem3gpp      *self)
+{
+    HandleCancelScanContext *ctx;
+
+    ctx = g_slice_new0 (HandleCancelScanContext);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self = g_object_ref (self);
+
+    mm_iface_auth_authorize (MM_IFACE_AUTH (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_cancel_scan_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 typedef struct {
     MmGdbusModem3gpp              *skeleton;
     GDBusMethodInvocation         *invocation;
@@ -1497,6 +1800,8 @@ handle_set_initial_eps_bearer_settings (MmGdbusModem3gpp      *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_RADIO | MM_OPERATION_DOMAIN_DATA,
+                                         MM_OPERATION_DOMAIN_NONE,
                                          "set-initial-eps-bearer-settings",
                                          (GAsyncReadyCallback)set_initial_eps_bearer_settings_auth_ready,
                                          ctx);
@@ -1991,6 +2296,8 @@ handle_set_nr5g_registration_settings (MmGdbusModem3gpp      *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_NETWORK,
+                                         MM_OPERATION_DOMAIN_RADIO,
                                          "set-nr5g-registration-settings",
                                          (GAsyncReadyCallback)set_nr5g_registration_settings_auth_ready,
                                          ctx);
@@ -3951,6 +4258,14 @@ interface_initialization_step (GTask *task)
                           "handle-scan",
                           G_CALLBACK (handle_scan),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-scan-incremental",
+                          G_CALLBACK (handle_scan_incremental),
+                          self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-cancel-scan",
+                          G_CALLBACK (handle_cancel_scan),
+                          self);
         g_signal_connect (ctx->skeleton,
                           "handle-set-eps-ue-mode-operation",
                           G_CALLBACK (handle_set_eps_ue_mode_operation),
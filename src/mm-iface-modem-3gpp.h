@@ -224,6 +224,17 @@ struct _MMIfaceModem3gppInterface {
                                      GAsyncResult *res,
                                      GError **error);
 
+    /* Scan networks only in the given modes (optional), used to run incremental
+     * scans in several passes; expect a GList of MMModem3gppNetworkInfo */
+    void (* scan_networks_restricted) (MMIfaceModem3gpp *self,
+                                       MMModemMode modes,
+                                       GCancellable *cancellable,
+                                       GAsyncReadyCallback callback,
+                                       gpointer user_data);
+    GList * (*scan_networks_restricted_finish) (MMIfaceModem3gpp *self,
+                                                GAsyncResult *res,
+                                                GError **error);
+
     /* Set UE mode of operation for EPS */
     void     (* set_eps_ue_mode_operation)        (MMIfaceModem3gpp               *self,
                                                    MMModem3gppEpsUeModeOperation   mode,
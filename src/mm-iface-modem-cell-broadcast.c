@@ -23,6 +23,7 @@
 #include "mm-log-object.h"
 #include "mm-error-helpers.h"
 #include "mm-modem-helpers.h"
+#include "mm-context.h"
 
 #define SUPPORT_CHECKED_TAG "cell-broadcast-support-checked-tag"
 #define SUPPORTED_TAG       "cell-broadcast-supported-tag"
@@ -631,6 +632,9 @@ interface_enabling_step (GTask *task)
         g_autoptr (MMCbmList) list = NULL;
 
         list = mm_cbm_list_new (MM_BASE_MODEM (self), G_OBJECT (self));
+        mm_cbm_list_set_limits (list,
+                                mm_context_get_cbm_max_messages (),
+                                mm_context_get_cbm_retention ());
         g_object_set (self,
                       MM_IFACE_MODEM_CELL_BROADCAST_CBM_LIST, list,
                       NULL);
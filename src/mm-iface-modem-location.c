@@ -24,12 +24,16 @@
 #include "mm-log-object.h"
 #include "mm-error-helpers.h"
 #include "mm-modem-helpers.h"
+#include "mm-location-cache.h"
+#include "mm-perf-stats.h"
 
 #define MM_LOCATION_GPS_REFRESH_TIME_SECS 30
 
 #define LOCATION_CONTEXT_TAG "location-context-tag"
+#define LOCATION_HISTORY_TAG "location-history-tag"
 
 static GQuark location_context_quark;
+static GQuark location_history_quark;
 
 G_DEFINE_INTERFACE (MMIfaceModemLocation, mm_iface_modem_location, MM_TYPE_IFACE_MODEM)
 
@@ -53,6 +57,9 @@ typedef struct {
     MMLocationGpsRaw *location_gps_raw;
     /* CDMA BS location */
     MMLocationCdmaBs *location_cdma_bs;
+    /* Time to first fix tracking, only while waiting for the first fix */
+    gint64            gps_started;
+    MMLocationGpsRaw *gps_ttff;
 } LocationContext;
 
 static void
@@ -66,6 +73,8 @@ location_context_free (LocationContext *ctx)
         g_object_unref (ctx->location_gps_raw);
     if (ctx->location_cdma_bs)
         g_object_unref (ctx->location_cdma_bs);
+    if (ctx->gps_ttff)
+        g_object_unref (ctx->gps_ttff);
     g_free (ctx);
 }
 
@@ -106,6 +115,67 @@ get_location_context (MMIfaceModemLocation *self)
     return ctx;
 }
 
+/*****************************************************************************/
+/* Location history, kept across enable/disable cycles */
+
+static MMLocationCache *
+get_location_history (MMIfaceModemLocation *self)
+{
+    MMLocationCache *history;
+
+    if (G_UNLIKELY (!location_history_quark))
+        location_history_quark = g_quark_from_static_string (LOCATION_HISTORY_TAG);
+
+    history = g_object_get_qdata (G_OBJECT (self), location_history_quark);
+    if (!history) {
+        g_autoptr(GError)  error = NULL;
+        g_autofree gchar  *filename = NULL;
+
+        /* Attach the history to the location cache the modem already keeps,
+         * if any; otherwise, use one that only keeps the history */
+        if (MM_IFACE_MODEM_LOCATION_GET_IFACE (self)->peek_location_cache)
+            history = MM_IFACE_MODEM_LOCATION_GET_IFACE (self)->peek_location_cache (self);
+        if (history)
+            g_object_ref (history);
+        else {
+            history = mm_location_cache_new ();
+            mm_location_cache_set_filename (history, NULL);
+        }
+
+        filename = mm_location_cache_build_history_filename (mm_base_modem_get_device (MM_BASE_MODEM (self)));
+        mm_location_cache_set_history_filename (history, filename);
+        if (!mm_location_cache_load_history (history, &error))
+            mm_obj_dbg (self, "no previous location history loaded: %s", error->message);
+
+        g_object_set_qdata_full (G_OBJECT (self),
+                                 location_history_quark,
+                                 history,
+                                 (GDestroyNotify)g_object_unref);
+    }
+
+    return history;
+}
+
+static void
+location_history_add (MMIfaceModemLocation  *self,
+                      MMModemLocationSource  source,
+                      gdouble                latitude,
+                      gdouble                longitude,
+                      gdouble                altitude)
+{
+    MMLocationCacheFix fix;
+
+    if (latitude == MM_LOCATION_LATITUDE_UNKNOWN || longitude == MM_LOCATION_LONGITUDE_UNKNOWN)
+        return;
+
+    fix.timestamp = g_get_real_time () / 1000;
+    fix.latitude = latitude;
+    fix.longitude = longitude;
+    fix.altitude = altitude;
+    fix.source = source;
+    mm_location_cache_add_fix (get_location_history (self), &fix);
+}
+
 /*****************************************************************************/
 
 static GVariant *
@@ -252,6 +322,26 @@ notify_gps_location_update (MMIfaceModemLocation *self,
                                        NULL));
 }
 
+static void
+location_gps_update_ttff (MMIfaceModemLocation *self,
+                          MmGdbusModemLocation *skeleton,
+                          LocationContext      *ctx,
+                          const gchar          *nmea_trace)
+{
+    gint64 ttff_ms;
+
+    if (!mm_location_gps_raw_add_trace (ctx->gps_ttff, nmea_trace) ||
+        mm_location_gps_raw_get_latitude (ctx->gps_ttff) == MM_LOCATION_LATITUDE_UNKNOWN ||
+        mm_location_gps_raw_get_longitude (ctx->gps_ttff) == MM_LOCATION_LONGITUDE_UNKNOWN)
+        return;
+
+    ttff_ms = (g_get_monotonic_time () - ctx->gps_started) / 1000;
+    mm_obj_info (self, "GPS time to first fix: %" G_GINT64_FORMAT "ms", ttff_ms);
+    mm_perf_stats_add_latency ("location", "gps-ttff", ttff_ms * 1000);
+    mm_gdbus_modem_location_set_gps_time_to_first_fix (skeleton, (guint) MIN (ttff_ms, G_MAXUINT));
+    g_clear_object (&ctx->gps_ttff);
+}
+
 static void
 location_gps_update_nmea (MMIfaceModemLocation *self,
                           const gchar          *nmea_trace)
@@ -268,6 +358,9 @@ location_gps_update_nmea (MMIfaceModemLocation *self,
     if (!skeleton)
         return;
 
+    if (ctx->gps_ttff)
+        location_gps_update_ttff (self, skeleton, ctx, nmea_trace);
+
     if (mm_gdbus_modem_location_get_enabled (skeleton) & MM_MODEM_LOCATION_SOURCE_GPS_NMEA) {
         g_assert (ctx->location_gps_nmea != NULL);
         if (mm_location_gps_nmea_add_trace (ctx->location_gps_nmea, nmea_trace) &&
@@ -285,6 +378,11 @@ location_gps_update_nmea (MMIfaceModemLocation *self,
              time (NULL) - ctx->location_gps_raw_last_time >= (glong)mm_gdbus_modem_location_get_gps_refresh_rate (skeleton))) {
             ctx->location_gps_raw_last_time = time (NULL);
             update_raw = TRUE;
+            location_history_add (self,
+                                  MM_MODEM_LOCATION_SOURCE_GPS_RAW,
+                                  mm_location_gps_raw_get_latitude (ctx->location_gps_raw),
+                                  mm_location_gps_raw_get_longitude (ctx->location_gps_raw),
+                                  mm_location_gps_raw_get_altitude (ctx->location_gps_raw));
         }
     }
 
@@ -524,8 +622,14 @@ mm_iface_modem_location_cdma_bs_update (MMIfaceModemLocation *self,
         return;
 
     if (mm_gdbus_modem_location_get_enabled (skeleton) & MM_MODEM_LOCATION_SOURCE_CDMA_BS) {
-        if (mm_location_cdma_bs_set (ctx->location_cdma_bs, longitude, latitude))
+        if (mm_location_cdma_bs_set (ctx->location_cdma_bs, longitude, latitude)) {
             notify_cdma_bs_location_update (self, skeleton, ctx->location_cdma_bs);
+            location_history_add (self,
+                                  MM_MODEM_LOCATION_SOURCE_CDMA_BS,
+                                  latitude,
+                                  longitude,
+                                  MM_LOCATION_ALTITUDE_UNKNOWN);
+        }
     }
 
     g_object_unref (skeleton);
@@ -566,6 +670,17 @@ update_location_source_status (MMIfaceModemLocation *self,
     /* Update status in the context */
     ctx = get_location_context (self);
 
+    /* Start measuring time to first fix when the first GPS source is enabled,
+     * stop when the last one is disabled */
+    if (source & (MM_MODEM_LOCATION_SOURCE_GPS_NMEA | MM_MODEM_LOCATION_SOURCE_GPS_RAW)) {
+        if (enabled && !(mm_gdbus_modem_location_get_enabled (skeleton) & (MM_MODEM_LOCATION_SOURCE_GPS_NMEA | MM_MODEM_LOCATION_SOURCE_GPS_RAW))) {
+            ctx->gps_started = g_get_monotonic_time ();
+            g_clear_object (&ctx->gps_ttff);
+            ctx->gps_ttff = mm_location_gps_raw_new ();
+        } else if (!enabled && !(mask & (MM_MODEM_LOCATION_SOURCE_GPS_NMEA | MM_MODEM_LOCATION_SOURCE_GPS_RAW)))
+            g_clear_object (&ctx->gps_ttff);
+    }
+
     switch (source) {
     case MM_MODEM_LOCATION_SOURCE_3GPP_LAC_CI:
         if (enabled) {
@@ -1369,6 +1484,87 @@ handle_get_location (MmGdbusModemLocation  *skeleton,
 
 /*****************************************************************************/
 
+typedef struct {
+    MmGdbusModemLocation  *skeleton;
+    GDBusMethodInvocation *invocation;
+    MMIfaceModemLocation  *self;
+    gint64                 since;
+} HandleGetLocationHistoryContext;
+
+static void
+handle_get_location_history_context_free (HandleGetLocationHistoryContext *ctx)
+{
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_slice_free (HandleGetLocationHistoryContext, ctx);
+}
+
+static void
+handle_get_location_history_auth_ready (MMIfaceAuth                     *_self,
+                                        GAsyncResult                    *res,
+                                        HandleGetLocationHistoryContext *ctx)
+{
+    MMIfaceModemLocation *self = MM_IFACE_MODEM_LOCATION (_self);
+    g_autoptr(GArray)     fixes = NULL;
+    GVariantBuilder       builder;
+    GError               *error = NULL;
+    guint                 i;
+
+    if (!mm_iface_auth_authorize_finish (_self, res, &error)) {
+        mm_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_get_location_history_context_free (ctx);
+        return;
+    }
+
+    fixes = mm_location_cache_get_history (get_location_history (self), ctx->since);
+    mm_obj_info (self, "processing user request to get location history: %u fixes", fixes->len);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sv}"));
+    for (i = 0; i < fixes->len; i++) {
+        MMLocationCacheFix *fix;
+
+        fix = &g_array_index (fixes, MMLocationCacheFix, i);
+        g_variant_builder_open (&builder, G_VARIANT_TYPE ("a{sv}"));
+        g_variant_builder_add (&builder, "{sv}", "timestamp", g_variant_new_int64 (fix->timestamp));
+        g_variant_builder_add (&builder, "{sv}", "source", g_variant_new_uint32 (fix->source));
+        g_variant_builder_add (&builder, "{sv}", "latitude", g_variant_new_double (fix->latitude));
+        g_variant_builder_add (&builder, "{sv}", "longitude", g_variant_new_double (fix->longitude));
+        if (fix->altitude != MM_LOCATION_ALTITUDE_UNKNOWN)
+            g_variant_builder_add (&builder, "{sv}", "altitude", g_variant_new_double (fix->altitude));
+        g_variant_builder_close (&builder);
+    }
+
+    mm_gdbus_modem_location_complete_get_location_history (ctx->skeleton,
+                                                           ctx->invocation,
+                                                           g_variant_builder_end (&builder));
+    handle_get_location_history_context_free (ctx);
+}
+
+static gboolean
+handle_get_location_history (MmGdbusModemLocation  *skeleton,
+                             GDBusMethodInvocation *invocation,
+                             gint64                 since,
+                             MMIfaceModemLocation  *self)
+{
+    HandleGetLocationHistoryContext *ctx;
+
+    ctx = g_slice_new0 (HandleGetLocationHistoryContext);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self = g_object_ref (self);
+    ctx->since = since;
+
+    mm_iface_auth_authorize (MM_IFACE_AUTH (self),
+                             invocation,
+                             MM_AUTHORIZATION_LOCATION,
+                             (GAsyncReadyCallback)handle_get_location_history_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 typedef struct _DisablingContext DisablingContext;
 static void interface_disabling_step (GTask *task);
 
@@ -1883,6 +2079,10 @@ interface_initialization_step (GTask *task)
                           "handle-get-location",
                           G_CALLBACK (handle_get_location),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-get-location-history",
+                          G_CALLBACK (handle_get_location_history),
+                          self);
 
         /* Finally, export the new interface */
         mm_gdbus_object_skeleton_set_modem_location (MM_GDBUS_OBJECT_SKELETON (self),
@@ -1929,6 +2129,7 @@ mm_iface_modem_location_initialize (MMIfaceModemLocation *self,
         mm_gdbus_modem_location_set_supported_assistance_data (skeleton, MM_MODEM_LOCATION_ASSISTANCE_DATA_TYPE_NONE);
         mm_gdbus_modem_location_set_enabled (skeleton, MM_MODEM_LOCATION_SOURCE_NONE);
         mm_gdbus_modem_location_set_signals_location (skeleton, FALSE);
+        mm_gdbus_modem_location_set_gps_time_to_first_fix (skeleton, 0);
         mm_gdbus_modem_location_set_location (skeleton,
                                               build_location_dictionary (NULL, NULL, NULL, NULL, NULL));
 
@@ -23,6 +23,7 @@
 #include <libmm-glib.h>
 
 #include "mm-iface-modem.h"
+#include "mm-location-cache.h"
 
 #define MM_TYPE_IFACE_MODEM_LOCATION mm_iface_modem_location_get_type ()
 G_DECLARE_INTERFACE (MMIfaceModemLocation, mm_iface_modem_location, MM, IFACE_MODEM_LOCATION, MMIfaceModem)
@@ -101,6 +102,10 @@ struct _MMIfaceModemLocationInterface {
     gboolean (*inject_assistance_data_finish) (MMIfaceModemLocation  *self,
                                                GAsyncResult          *res,
                                                GError               **error);
+
+    /* Peek the location cache already kept by the modem, if any, so that
+     * the location history is attached to it */
+    MMLocationCache * (* peek_location_cache) (MMIfaceModemLocation *self);
 };
 
 /* Initialize Location interface (async) */
@@ -23,6 +23,7 @@
 #include "mm-error-helpers.h"
 #include "mm-log-object.h"
 #include "mm-broadband-modem.h"
+#include "mm-context.h"
 
 #define SUPPORT_CHECKED_TAG "messaging-support-checked-tag"
 #define SUPPORTED_TAG       "messaging-supported-tag"
@@ -355,7 +356,9 @@ handle_list (MmGdbusModemMessaging *skeleton,
     }
 
     mm_obj_info (self, "processing user request to list SMS messages...");
-    paths = mm_sms_list_get_paths (list);
+    /* Legacy full listing: export any SMS object not exported yet, which
+     * also updates the Messages property and emits Added for them */
+    paths = mm_sms_list_get_page (list, 0, G_MAXUINT, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_UNKNOWN, NULL);
     mm_gdbus_modem_messaging_complete_list (skeleton,
                                             invocation,
                                             (const gchar *const *)paths);
@@ -363,6 +366,62 @@ handle_list (MmGdbusModemMessaging *skeleton,
     return TRUE;
 }
 
+static gboolean
+handle_list_paged (MmGdbusModemMessaging *skeleton,
+                   GDBusMethodInvocation *invocation,
+                   guint                  offset,
+                   guint                  count,
+                   GVariant              *filter,
+                   MMIfaceModemMessaging *self)
+{
+    g_auto(GStrv)        paths = NULL;
+    g_autoptr(MMSmsList) list = NULL;
+    GVariantIter         iter;
+    const gchar         *key;
+    GVariant            *value;
+    MMSmsState           state = MM_SMS_STATE_UNKNOWN;
+    MMSmsStorage         storage = MM_SMS_STORAGE_UNKNOWN;
+    guint                total = 0;
+
+    if (mm_iface_modem_abort_invocation_if_state_not_reached (MM_IFACE_MODEM (self),
+                                                              invocation,
+                                                              MM_MODEM_STATE_ENABLED))
+        return TRUE;
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_MESSAGING_SMS_LIST, &list,
+                  NULL);
+    if (!list) {
+        mm_dbus_method_invocation_return_error_literal (invocation, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                                                        "Cannot list SMS: missing SMS list");
+        return TRUE;
+    }
+
+    g_variant_iter_init (&iter, filter);
+    while (g_variant_iter_next (&iter, "{&sv}", &key, &value)) {
+        g_autoptr(GVariant) owned_value = value;
+
+        if (g_str_equal (key, "state") && g_variant_is_of_type (value, G_VARIANT_TYPE_UINT32))
+            state = (MMSmsState) g_variant_get_uint32 (value);
+        else if (g_str_equal (key, "storage") && g_variant_is_of_type (value, G_VARIANT_TYPE_UINT32))
+            storage = (MMSmsStorage) g_variant_get_uint32 (value);
+        else {
+            mm_dbus_method_invocation_return_error (invocation, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                                                    "Invalid SMS list filter: '%s'", key);
+            return TRUE;
+        }
+    }
+
+    mm_obj_info (self, "processing user request to list SMS messages (offset %u, count %u)...", offset, count);
+    paths = mm_sms_list_get_page (list, offset, count, state, storage, &total);
+    mm_gdbus_modem_messaging_complete_list_paged (skeleton,
+                                                  invocation,
+                                                  (const gchar *const *)paths,
+                                                  total);
+    mm_obj_info (self, "reported %u out of %u SMS messages available", g_strv_length (paths), total);
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 typedef struct {
@@ -574,7 +633,7 @@ mm_iface_modem_messaging_get_default_storage (MMIfaceModemMessaging *self)
 
 static void
 update_message_list (MmGdbusModemMessaging *skeleton,
-                     MMSmsList *list)
+                     MMSmsList             *list)
 {
     gchar **paths;
 
@@ -899,6 +958,15 @@ load_initial_sms_parts_from_storages (GTask *task)
     }
 
     if (all_loaded) {
+        g_autoptr(MMSmsList) list = NULL;
+
+        /* SMS objects received from now on are exported right away */
+        g_object_get (self,
+                      MM_IFACE_MODEM_MESSAGING_SMS_LIST, &list,
+                      NULL);
+        if (list)
+            mm_sms_list_set_defer_export (list, FALSE);
+
         /* Go on with next step */
         ctx->step++;
         interface_enabling_step (task);
@@ -1097,6 +1165,17 @@ interface_enabling_step (GTask *task)
         /* Allow loading the initial list of SMS parts */
         if (MM_IFACE_MODEM_MESSAGING_GET_IFACE (self)->load_initial_sms_parts &&
             MM_IFACE_MODEM_MESSAGING_GET_IFACE (self)->load_initial_sms_parts_finish) {
+            /* SMS objects loaded from storage may be exported only when
+             * requested by the user */
+            if (mm_context_get_sms_export_on_demand ()) {
+                g_autoptr(MMSmsList) list = NULL;
+
+                g_object_get (self,
+                              MM_IFACE_MODEM_MESSAGING_SMS_LIST, &list,
+                              NULL);
+                if (list)
+                    mm_sms_list_set_defer_export (list, TRUE);
+            }
             load_initial_sms_parts_from_storages (task);
             return;
         }
@@ -1456,6 +1535,10 @@ interface_initialization_step (GTask *task)
                           "handle-list",
                           G_CALLBACK (handle_list),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-list-paged",
+                          G_CALLBACK (handle_list_paged),
+                          self);
         g_signal_connect (ctx->skeleton,
                           "handle-set-default-storage",
                           G_CALLBACK (handle_set_default_storage),
@@ -22,6 +22,8 @@
 #include "mm-iface-modem-signal.h"
 #include "mm-error-helpers.h"
 #include "mm-log-object.h"
+#include "mm-modem-helpers.h"
+#include "mm-context.h"
 
 #define SUPPORT_CHECKED_TAG "signal-support-checked-tag"
 #define SUPPORTED_TAG       "signal-supported-tag"
@@ -37,15 +39,32 @@ G_DEFINE_INTERFACE (MMIfaceModemSignal, mm_iface_modem_signal, MM_TYPE_IFACE_MOD
 #define PRIVATE_TAG "signal-private-tag"
 static GQuark private_quark;
 
+typedef enum {
+    SIGNAL_RAT_CDMA,
+    SIGNAL_RAT_EVDO,
+    SIGNAL_RAT_GSM,
+    SIGNAL_RAT_UMTS,
+    SIGNAL_RAT_LTE,
+    SIGNAL_RAT_NR5G,
+    SIGNAL_RAT_LAST
+} SignalRat;
+
 typedef struct {
     /* interface enabled */
-    gboolean enabled;
+    gboolean  enabled;
     /* polling-based reporting  */
-    guint    rate;
-    guint    timeout_source;
+    guint     rate;
+    guint     timeout_source;
     /* threshold-based reporting */
-    guint    rssi_threshold;
-    gboolean error_rate_threshold;
+    guint     rssi_threshold;
+    gboolean  error_rate_threshold;
+    gboolean  thresholds_emulated;
+    /* last published values, used to suppress unchanged samples */
+    MMSignal *last_reported[SIGNAL_RAT_LAST];
+    gint64    last_report_time;
+    /* latest values received too soon after the last published ones */
+    MMSignal *pending[SIGNAL_RAT_LAST];
+    guint     pending_source;
     /* info logging control */
     GTimer   *info_log_timer;
 } Private;
@@ -53,6 +72,14 @@ typedef struct {
 static void
 private_free (Private *priv)
 {
+    guint i;
+
+    for (i = 0; i < SIGNAL_RAT_LAST; i++) {
+        g_clear_object (&priv->last_reported[i]);
+        g_clear_object (&priv->pending[i]);
+    }
+    if (priv->pending_source)
+        g_source_remove (priv->pending_source);
     if (priv->info_log_timer)
         g_timer_destroy (priv->info_log_timer);
     if (priv->timeout_source)
@@ -184,6 +211,125 @@ internal_signal_update (MMIfaceModemSignal *self,
     g_dbus_interface_skeleton_flush (G_DBUS_INTERFACE_SKELETON (skeleton));
 }
 
+/*****************************************************************************/
+/* Threshold-based sample filtering */
+
+static gboolean
+thresholds_enabled (Private *priv)
+{
+    return (priv->rssi_threshold || priv->error_rate_threshold);
+}
+
+static void
+signal_update_pending_clear (Private *priv)
+{
+    guint i;
+
+    for (i = 0; i < SIGNAL_RAT_LAST; i++)
+        g_clear_object (&priv->pending[i]);
+    if (priv->pending_source) {
+        g_source_remove (priv->pending_source);
+        priv->pending_source = 0;
+    }
+}
+
+static gboolean
+signal_update_pending_cb (MMIfaceModemSignal *self)
+{
+    Private  *priv;
+    MMSignal *pending[SIGNAL_RAT_LAST];
+    guint     i;
+
+    priv = get_private (self);
+    priv->pending_source = 0;
+
+    for (i = 0; i < SIGNAL_RAT_LAST; i++)
+        pending[i] = g_steal_pointer (&priv->pending[i]);
+    mm_iface_modem_signal_update (self,
+                                  pending[SIGNAL_RAT_CDMA],
+                                  pending[SIGNAL_RAT_EVDO],
+                                  pending[SIGNAL_RAT_GSM],
+                                  pending[SIGNAL_RAT_UMTS],
+                                  pending[SIGNAL_RAT_LTE],
+                                  pending[SIGNAL_RAT_NR5G]);
+    for (i = 0; i < SIGNAL_RAT_LAST; i++)
+        g_clear_object (&pending[i]);
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean
+signal_update_filter (MMIfaceModemSignal *self,
+                      Private            *priv,
+                      MMSignal          **samples)
+{
+    gint64 now;
+    gint64 elapsed;
+    gint64 min_interval;
+    guint  max_interval;
+    guint  i;
+
+    now = g_get_monotonic_time ();
+
+    /* Without thresholds, every sample is published */
+    if (thresholds_enabled (priv) && priv->last_report_time) {
+        /* Samples received too soon after the last published ones are kept
+         * and processed again once the minimum interval has elapsed, unless
+         * newer ones are received meanwhile */
+        elapsed = now - priv->last_report_time;
+        min_interval = (gint64) mm_context_get_signal_threshold_min_interval () * G_USEC_PER_SEC;
+        if (elapsed < min_interval) {
+            mm_obj_dbg (self, "extended signal information update delayed: too soon after the last one");
+            for (i = 0; i < SIGNAL_RAT_LAST; i++)
+                g_set_object (&priv->pending[i], samples[i]);
+            if (!priv->pending_source)
+                priv->pending_source = g_timeout_add ((guint) ((min_interval - elapsed + 999) / 1000),
+                                                      (GSourceFunc) signal_update_pending_cb,
+                                                      self);
+            return FALSE;
+        }
+        /* Newer samples supersede any delayed ones */
+        signal_update_pending_clear (priv);
+
+        /* Even if no threshold is crossed, publish the latest sample at least
+         * once in the maximum interval, if any, so that clients can tell the
+         * values are still current */
+        max_interval = mm_context_get_signal_threshold_max_interval ();
+        if (!max_interval || elapsed < (gint64) max_interval * G_USEC_PER_SEC) {
+            for (i = 0; i < SIGNAL_RAT_LAST; i++) {
+                if (mm_signal_threshold_crossed (priv->last_reported[i],
+                                                 samples[i],
+                                                 priv->rssi_threshold,
+                                                 mm_context_get_signal_sinr_threshold (),
+                                                 priv->error_rate_threshold))
+                    break;
+            }
+            if (i == SIGNAL_RAT_LAST) {
+                mm_obj_dbg (self, "extended signal information update suppressed: no threshold crossed");
+                return FALSE;
+            }
+        }
+    }
+
+    signal_update_pending_clear (priv);
+    for (i = 0; i < SIGNAL_RAT_LAST; i++)
+        g_set_object (&priv->last_reported[i], samples[i]);
+    priv->last_report_time = now;
+    return TRUE;
+}
+
+static void
+signal_update_filter_reset (Private *priv)
+{
+    guint i;
+
+    signal_update_pending_clear (priv);
+    for (i = 0; i < SIGNAL_RAT_LAST; i++)
+        g_clear_object (&priv->last_reported[i]);
+    priv->last_report_time = 0;
+}
+
+/*****************************************************************************/
+
 void
 mm_iface_modem_signal_update (MMIfaceModemSignal *self,
                               MMSignal           *cdma,
@@ -193,14 +339,24 @@ mm_iface_modem_signal_update (MMIfaceModemSignal *self,
                               MMSignal           *lte,
                               MMSignal           *nr5g)
 {
-    Private *priv;
+    Private  *priv;
+    MMSignal *samples[SIGNAL_RAT_LAST];
 
     priv = get_private (self);
-    if (!priv->enabled || (!priv->rate && !priv->rssi_threshold && !priv->error_rate_threshold)) {
+    if (!priv->enabled || (!priv->rate && !thresholds_enabled (priv))) {
         mm_obj_dbg (self, "skipping extended signal information update...");
         return;
     }
 
+    samples[SIGNAL_RAT_CDMA] = cdma;
+    samples[SIGNAL_RAT_EVDO] = evdo;
+    samples[SIGNAL_RAT_GSM]  = gsm;
+    samples[SIGNAL_RAT_UMTS] = umts;
+    samples[SIGNAL_RAT_LTE]  = lte;
+    samples[SIGNAL_RAT_NR5G] = nr5g;
+    if (!signal_update_filter (self, priv, samples))
+        return;
+
     internal_signal_update (self, cdma, evdo, gsm, umts, lte, nr5g);
 }
 
@@ -213,7 +369,10 @@ check_interface_reset (MMIfaceModemSignal *self)
 
     priv = get_private (self);
 
-    if (!priv->enabled || (!priv->rate && !priv->rssi_threshold && !priv->error_rate_threshold)) {
+    /* Make sure the next sample is published right away */
+    signal_update_filter_reset (priv);
+
+    if (!priv->enabled || (!priv->rate && !thresholds_enabled (priv))) {
         mm_obj_dbg (self, "resetting extended signal information...");
         internal_signal_update (self, NULL, NULL, NULL, NULL, NULL, NULL);
     }
@@ -262,36 +421,54 @@ query_signal_values (MMIfaceModemSignal *self)
     return G_SOURCE_CONTINUE;
 }
 
-static void
+static guint
+polling_get_rate (Private *priv)
+{
+    if (!priv->enabled)
+        return 0;
+
+    /* Thresholds emulated in the daemon need polling even if no explicit
+     * rate was requested; if one was, it is always respected. */
+    if (priv->thresholds_emulated && thresholds_enabled (priv) && !priv->rate)
+        return mm_context_get_signal_threshold_poll_rate ();
+
+    return priv->rate;
+}
+
+/* Returns TRUE if a query was launched right away */
+static gboolean
 polling_restart (MMIfaceModemSignal *self)
 {
-    Private  *priv;
-    gboolean  polling_setup;
+    Private *priv;
+    guint    rate;
 
     priv = get_private (self);
-    polling_setup = (priv->enabled && priv->rate);
+    rate = polling_get_rate (priv);
 
-    if (polling_setup)
-        mm_obj_info (self, "setting up extended signal information polling: rate %u seconds", priv->rate);
+    if (rate && rate != priv->rate)
+        mm_obj_info (self, "setting up extended signal information polling: rate %u seconds (emulating thresholds)", rate);
+    else if (rate)
+        mm_obj_info (self, "setting up extended signal information polling: rate %u seconds", rate);
     else
         mm_obj_dbg (self, "cleaning up extended signal information polling");
 
     /* Stop polling */
-    if (!polling_setup) {
+    if (!rate) {
         if (priv->timeout_source) {
             g_source_remove (priv->timeout_source);
             priv->timeout_source = 0;
         }
-        return;
+        return FALSE;
     }
 
     /* Start/restart polling */
     if (priv->timeout_source)
         g_source_remove (priv->timeout_source);
-    priv->timeout_source = g_timeout_add_seconds (priv->rate, (GSourceFunc) query_signal_values, self);
+    priv->timeout_source = g_timeout_add_seconds (rate, (GSourceFunc) query_signal_values, self);
 
     /* Also launch right away */
     query_signal_values (self);
+    return TRUE;
 }
 
 /*****************************************************************************/
@@ -305,20 +482,49 @@ thresholds_restart_finish (MMIfaceModemSignal  *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
+/* Returns TRUE if a query was launched right away */
+static gboolean
+thresholds_emulation_restart (MMIfaceModemSignal *self,
+                              gboolean            emulated)
+{
+    Private *priv;
+
+    priv = get_private (self);
+    if (priv->thresholds_emulated == emulated)
+        return FALSE;
+
+    if (emulated)
+        mm_obj_dbg (self, "extended signal information thresholds emulated in the daemon");
+    priv->thresholds_emulated = emulated;
+    return polling_restart (self);
+}
+
 static void
 setup_thresholds_ready (MMIfaceModemSignal *self,
                         GAsyncResult       *res,
                         GTask              *task)
 {
-    GError *error = NULL;
-
-    if (!MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds_finish (self, res, &error))
-        g_task_return_error (task, error);
-    else {
-        /* launch a query right away */
+    GError   *error = NULL;
+    gboolean  queried;
+
+    if (!MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds_finish (self, res, &error)) {
+        /* If the modem cannot program the requested thresholds, fallback to
+         * emulating them in the daemon */
+        if (!g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED)) {
+            g_task_return_error (task, error);
+            g_object_unref (task);
+            return;
+        }
+        mm_obj_dbg (self, "couldn't setup thresholds in the modem: %s", error->message);
+        g_error_free (error);
+        queried = thresholds_emulation_restart (self, TRUE);
+    } else
+        queried = thresholds_emulation_restart (self, FALSE);
+
+    /* launch a query right away, unless restarting the polling already did */
+    if (!queried)
         query_signal_values (self);
-        g_task_return_boolean (task, TRUE);
-    }
+    g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
 
@@ -333,16 +539,17 @@ thresholds_restart (MMIfaceModemSignal  *self,
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    priv = get_private (self);
+    threshold_setup = (priv->enabled && thresholds_enabled (priv));
+
     if (!MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds ||
         !MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds_finish) {
+        thresholds_emulation_restart (self, threshold_setup);
         g_task_return_boolean (task, TRUE);
         g_object_unref (task);
         return;
     }
 
-    priv = get_private (self);
-    threshold_setup = (priv->enabled && (priv->rssi_threshold || priv->error_rate_threshold));
-
     mm_obj_dbg (self, "%s extended signal information thresholds: interface %s, rssi threshold %u dBm, error rate threshold %s",
                 threshold_setup ? "setting up" : "cleaning up",
                 priv->enabled ? "enabled" : "disabled",
@@ -490,14 +697,6 @@ handle_setup_thresholds_auth_ready (MMIfaceAuth                  *_self,
         return;
     }
 
-    if (!MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds ||
-        !MM_IFACE_MODEM_SIGNAL_GET_IFACE (self)->setup_thresholds_finish) {
-        mm_dbus_method_invocation_return_error_literal (ctx->invocation, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
-                                                        "Cannot setup thresholds: operation not supported");
-        handle_setup_thresholds_context_free (ctx);
-        return;
-    }
-
     if (mm_iface_modem_abort_invocation_if_state_not_reached (MM_IFACE_MODEM (self),
                                                               ctx->invocation,
                                                               MM_MODEM_STATE_DISABLED)) {
@@ -145,6 +145,16 @@ get_private (MMIfaceModem *self)
 
 /*****************************************************************************/
 
+static void
+iface_modem_invalidate_sim_cache (MMIfaceModem *self)
+{
+    g_autoptr(MMBaseSim) sim = NULL;
+
+    g_object_get (self, MM_IFACE_MODEM_SIM, &sim, NULL);
+    if (sim)
+        mm_base_sim_invalidate_cache (sim);
+}
+
 gboolean
 mm_iface_modem_check_for_sim_swap_finish (MMIfaceModem *self,
                                           GAsyncResult *res,
@@ -204,6 +214,11 @@ check_basic_sim_details_ready (MMIfaceModem *self,
                      mm_log_str_personal_info (old_imsi),
                      mm_log_str_personal_info (current_imsi));
 
+        /* The files cached for the previous card are no longer valid, even
+         * if the change isn't processed as a SIM swap below */
+        if (iccid_changed)
+            iface_modem_invalidate_sim_cache (self);
+
         g_object_get (self,
                       MM_IFACE_MODEM_STATE, &state,
                       NULL);
@@ -348,20 +363,15 @@ after_sim_event_disable_ready (MMBaseModem  *self,
 
     mm_base_modem_disable_finish (self, res, &error);
     if (error)
-        mm_obj_err (self, "failed to disable after SIM switch event: %s", error->message);
+        mm_obj_err (self, "failed to disable before reprobing: %s", error->message);
 
     /* set invalid either way, so that it's reprobed */
     mm_base_modem_set_valid (self, FALSE);
 }
 
 static void
-iface_modem_process_sim_event_internal (MMIfaceModem *self)
+iface_modem_disable_and_reprobe (MMIfaceModem *self)
 {
-    mm_obj_info (self, "processing SIM event");
-
-    if (MM_IFACE_MODEM_GET_IFACE (self)->cleanup_sim_hot_swap)
-        MM_IFACE_MODEM_GET_IFACE (self)->cleanup_sim_hot_swap (self);
-
     /* Make sure modem is disabled before reprobing. This operation requests
      * an exclusive lock marked as override, so the modem object will not
      * allow any additional lock request any more. */
@@ -373,6 +383,20 @@ iface_modem_process_sim_event_internal (MMIfaceModem *self)
                            NULL);
 }
 
+static void
+iface_modem_process_sim_event_internal (MMIfaceModem *self)
+{
+    mm_obj_info (self, "processing SIM event");
+
+    /* The SIM card contents may have changed */
+    iface_modem_invalidate_sim_cache (self);
+
+    if (MM_IFACE_MODEM_GET_IFACE (self)->cleanup_sim_hot_swap)
+        MM_IFACE_MODEM_GET_IFACE (self)->cleanup_sim_hot_swap (self);
+
+    iface_modem_disable_and_reprobe (self);
+}
+
 void
 mm_iface_modem_process_sim_event (MMIfaceModem *self)
 {
@@ -1234,6 +1258,7 @@ typedef struct {
     MmGdbusModem          *skeleton;
     GDBusMethodInvocation *invocation;
     MMIfaceModem          *self;
+    gssize                 operation_id;
     MMBearerList          *list;
     gchar                 *bearer_path;
     MMBaseBearer          *bearer;
@@ -1242,6 +1267,9 @@ typedef struct {
 static void
 handle_delete_bearer_context_free (HandleDeleteBearerContext *ctx)
 {
+    if (ctx->operation_id >= 0)
+        mm_iface_op_lock_unlock (MM_IFACE_OP_LOCK (ctx->self), ctx->operation_id);
+
     g_object_unref (ctx->skeleton);
     g_object_unref (ctx->invocation);
     g_object_unref (ctx->self);
@@ -1276,13 +1304,14 @@ delete_bearer_disconnect_ready (MMBaseBearer              *bearer,
 }
 
 static void
-handle_delete_bearer_auth_ready (MMIfaceAuth               *self,
+handle_delete_bearer_auth_ready (MMIfaceOpLock             *self,
                                  GAsyncResult              *res,
                                  HandleDeleteBearerContext *ctx)
 {
     GError *error = NULL;
 
-    if (!mm_iface_auth_authorize_finish (self, res, &error)) {
+    ctx->operation_id = mm_iface_op_lock_authorize_and_lock_finish (self, res, &error);
+    if (ctx->operation_id < 0) {
         mm_dbus_method_invocation_take_error (ctx->invocation, error);
         handle_delete_bearer_context_free (ctx);
         return;
@@ -1330,12 +1359,20 @@ handle_delete_bearer (MmGdbusModem          *skeleton,
     g_object_get (self,
                   MM_IFACE_MODEM_BEARER_LIST, &ctx->list,
                   NULL);
+    ctx->operation_id = -1;
 
-    mm_iface_auth_authorize (MM_IFACE_AUTH (self),
-                             invocation,
-                             MM_AUTHORIZATION_DEVICE_CONTROL,
-                             (GAsyncReadyCallback)handle_delete_bearer_auth_ready,
-                             ctx);
+    /* Bearers are disconnected before being deleted; the shared lock keeps
+     * the deletion out of operations that change the data settings, while
+     * still allowing several bearers to be deleted at the same time */
+    mm_iface_op_lock_authorize_and_lock (MM_IFACE_OP_LOCK (self),
+                                         invocation,
+                                         MM_AUTHORIZATION_DEVICE_CONTROL,
+                                         MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_NONE,
+                                         MM_OPERATION_DOMAIN_DATA,
+                                         "delete-bearer",
+                                         (GAsyncReadyCallback)handle_delete_bearer_auth_ready,
+                                         ctx);
     return TRUE;
 }
 
@@ -2434,6 +2471,8 @@ handle_enable (MmGdbusModem          *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_ALL,
+                                         MM_OPERATION_DOMAIN_NONE,
                                          enable ? "enable" : "disable",
                                          (GAsyncReadyCallback)handle_enable_auth_ready,
                                          ctx);
@@ -2614,6 +2653,8 @@ handle_set_power_state (MmGdbusModem          *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_ALL,
+                                         MM_OPERATION_DOMAIN_NONE,
                                          operation_name,
                                          (GAsyncReadyCallback)handle_set_power_state_auth_ready,
                                          ctx);
@@ -2705,6 +2746,8 @@ handle_reset (MmGdbusModem          *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_ALL,
+                                         MM_OPERATION_DOMAIN_NONE,
                                          "reset",
                                          (GAsyncReadyCallback)handle_reset_auth_ready,
                                          ctx);
@@ -2802,6 +2845,8 @@ handle_factory_reset (MmGdbusModem          *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_ALL,
+                                         MM_OPERATION_DOMAIN_NONE,
                                          "factory-reset",
                                          (GAsyncReadyCallback)handle_factory_reset_auth_ready,
                                          ctx);
@@ -2948,6 +2993,8 @@ handle_set_current_capabilities (MmGdbusModem          *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_ALL,
+                                         MM_OPERATION_DOMAIN_NONE,
                                          "set-current-capabilities",
                                          (GAsyncReadyCallback)handle_set_current_capabilities_auth_ready,
                                          ctx);
@@ -3401,6 +3448,8 @@ handle_set_current_bands (MmGdbusModem          *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_NETWORK,
+                                         MM_OPERATION_DOMAIN_RADIO,
                                          "set-current-bands",
                                          (GAsyncReadyCallback)handle_set_current_bands_auth_ready,
                                          ctx);
@@ -3813,6 +3862,8 @@ handle_set_current_modes (MmGdbusModem          *skeleton,
                                          invocation,
                                          MM_AUTHORIZATION_DEVICE_CONTROL,
                                          MM_OPERATION_PRIORITY_DEFAULT,
+                                         MM_OPERATION_DOMAIN_NETWORK,
+                                         MM_OPERATION_DOMAIN_RADIO,
                                          "set-current-modes",
                                          (GAsyncReadyCallback)handle_set_current_modes_auth_ready,
                                          ctx);
@@ -4873,6 +4924,7 @@ static void interface_syncing_step (GTask *task);
 
 typedef enum {
     SYNCING_STEP_FIRST,
+    SYNCING_STEP_CHECK_IDENTITY,
     SYNCING_STEP_DETECT_SIM_SWAP,
     SYNCING_STEP_REFRESH_SIM_LOCK,
     SYNCING_STEP_REFRESH_SIGNAL_STRENGTH,
@@ -4892,6 +4944,45 @@ mm_iface_modem_sync_finish (MMIfaceModem  *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
+static void
+sync_check_identity_ready (MMIfaceModem *self,
+                           GAsyncResult *res,
+                           GTask        *task)
+{
+    SyncingContext                  *ctx;
+    g_autoptr(MmGdbusModemSkeleton)  skeleton = NULL;
+    g_autofree gchar                *equipment_id = NULL;
+    g_autoptr(GError)                error = NULL;
+
+    ctx = g_task_get_task_data (task);
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_DBUS_SKELETON, &skeleton,
+                  NULL);
+
+    /* If the modem doesn't reply or reports a different identity, it was
+     * either power cycled or replaced during the suspension, so all the state
+     * we have is stale: fully reprobe it. */
+    equipment_id = MM_IFACE_MODEM_GET_IFACE (self)->load_equipment_identifier_finish (self, res, &error);
+    if (!equipment_id)
+        mm_obj_warn (self, "couldn't reload equipment identifier: %s", error->message);
+    else if (skeleton && !mm_equipment_identifier_equal (equipment_id, mm_gdbus_modem_get_equipment_identifier (MM_GDBUS_MODEM (skeleton))))
+        mm_obj_warn (self, "equipment identifier changed: %s -> %s",
+                     mm_log_str_personal_info (mm_gdbus_modem_get_equipment_identifier (MM_GDBUS_MODEM (skeleton))),
+                     mm_log_str_personal_info (equipment_id));
+    else {
+        mm_obj_dbg (self, "equipment identifier not changed");
+        ctx->step++;
+        interface_syncing_step (task);
+        return;
+    }
+
+    iface_modem_disable_and_reprobe (self);
+    g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_ABORTED,
+                             "Modem identity not validated after resume");
+    g_object_unref (task);
+}
+
 static void
 sync_all_bearers_ready (MMBearerList *bearer_list,
                         GAsyncResult *res,
@@ -4989,6 +5080,22 @@ interface_syncing_step (GTask *task)
         ctx->step++;
         /* fall through */
 
+    case SYNCING_STEP_CHECK_IDENTITY:
+        /*
+         * Validate that we're still talking to the same device, by reloading
+         * the equipment identifier (e.g. IMEI) we got during initialization.
+         */
+        if (MM_IFACE_MODEM_GET_IFACE (self)->load_equipment_identifier &&
+            MM_IFACE_MODEM_GET_IFACE (self)->load_equipment_identifier_finish) {
+            MM_IFACE_MODEM_GET_IFACE (self)->load_equipment_identifier (
+                self,
+                (GAsyncReadyCallback)sync_check_identity_ready,
+                task);
+            return;
+        }
+        ctx->step++;
+        /* fall through */
+
     case SYNCING_STEP_DETECT_SIM_SWAP:
         /*
          * Detect possible SIM swaps.
@@ -29,6 +29,8 @@ mm_iface_op_lock_authorize_and_lock (MMIfaceOpLock         *self,
                                      GDBusMethodInvocation *invocation,
                                      const gchar           *authorization,
                                      MMOperationPriority    operation_priority,
+                                     MMOperationDomain      exclusive_domains,
+                                     MMOperationDomain      shared_domains,
                                      const gchar           *operation_description,
                                      GAsyncReadyCallback    callback,
                                      gpointer               user_data)
@@ -39,6 +41,8 @@ mm_iface_op_lock_authorize_and_lock (MMIfaceOpLock         *self,
                                                            invocation,
                                                            authorization,
                                                            operation_priority,
+                                                           exclusive_domains,
+                                                           shared_domains,
                                                            operation_description,
                                                            callback,
                                                            user_data);
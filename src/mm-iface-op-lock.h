@@ -38,6 +38,31 @@ typedef enum {
     MM_OPERATION_LOCK_ALREADY_ACQUIRED,
 } MMOperationLock;
 
+/* Resource domains an operation may lock. Each operation locks some domains
+ * in exclusive mode and some others in shared mode; two operations conflict
+ * if one of them locks exclusively a domain locked in any mode by the other
+ * one. Non-conflicting operations may run concurrently. */
+typedef enum { /*< underscore_name=mm_operation_domain >*/
+    MM_OPERATION_DOMAIN_NONE      = 0,
+    /* Power and enabled state of the modem */
+    MM_OPERATION_DOMAIN_RADIO     = 1 << 0,
+    /* Network selection, bands, modes and registration settings */
+    MM_OPERATION_DOMAIN_NETWORK   = 1 << 1,
+    /* Bearers and packet data settings */
+    MM_OPERATION_DOMAIN_DATA      = 1 << 2,
+    /* SMS and cell broadcast messaging */
+    MM_OPERATION_DOMAIN_MESSAGING = 1 << 3,
+    /* Location gathering */
+    MM_OPERATION_DOMAIN_LOCATION  = 1 << 4,
+} MMOperationDomain;
+
+#define MM_OPERATION_DOMAIN_ALL       \
+    (MM_OPERATION_DOMAIN_RADIO      | \
+     MM_OPERATION_DOMAIN_NETWORK    | \
+     MM_OPERATION_DOMAIN_DATA       | \
+     MM_OPERATION_DOMAIN_MESSAGING  | \
+     MM_OPERATION_DOMAIN_LOCATION)
+
 #define MM_TYPE_IFACE_OP_LOCK mm_iface_op_lock_get_type ()
 G_DECLARE_INTERFACE (MMIfaceOpLock, mm_iface_op_lock, MM, IFACE_OP_LOCK, GObject)
 
@@ -48,6 +73,8 @@ struct _MMIfaceOpLockInterface {
                                  GDBusMethodInvocation   *invocation,
                                  const gchar             *authorization,
                                  MMOperationPriority      operation_priority,
+                                 MMOperationDomain        exclusive_domains,
+                                 MMOperationDomain        shared_domains,
                                  const gchar             *operation_description,
                                  GAsyncReadyCallback      callback,
                                  gpointer                 user_data);
@@ -65,6 +92,8 @@ void     mm_iface_op_lock_authorize_and_lock (MMIfaceOpLock         *self,
                                               GDBusMethodInvocation *invocation,
                                               const gchar           *authorization,
                                               MMOperationPriority    operation_priority,
+                                              MMOperationDomain      exclusive_domains,
+                                              MMOperationDomain      shared_domains,
                                               const gchar           *operation_description,
                                               GAsyncReadyCallback    callback,
                                               gpointer               user_data);
@@ -52,14 +52,15 @@ mm_iface_port_at_command_finish (MMIfacePortAt  *self,
 }
 
 void
-mm_iface_port_at_command (MMIfacePortAt        *self,
-                          const gchar          *command,
-                          guint32               timeout_seconds,
-                          gboolean              is_raw,
-                          gboolean              allow_cached,
-                          GCancellable         *cancellable,
-                          GAsyncReadyCallback   callback,
-                          gpointer              user_data)
+mm_iface_port_at_command (MMIfacePortAt           *self,
+                          const gchar             *command,
+                          guint32                  timeout_seconds,
+                          gboolean                 is_raw,
+                          gboolean                 allow_cached,
+                          MMPortSchedulerPriority  priority,
+                          GCancellable            *cancellable,
+                          GAsyncReadyCallback      callback,
+                          gpointer                 user_data)
 {
     g_assert (MM_IFACE_PORT_AT_GET_IFACE (self)->command);
     g_assert (MM_IFACE_PORT_AT_GET_IFACE (self)->command_finish);
@@ -69,6 +70,7 @@ mm_iface_port_at_command (MMIfacePortAt        *self,
                                                 timeout_seconds,
                                                 is_raw,
                                                 allow_cached,
+                                                priority,
                                                 cancellable,
                                                 callback,
                                                 user_data);
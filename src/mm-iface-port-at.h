@@ -23,6 +23,7 @@
 #include <libmm-glib.h>
 
 #include "mm-port.h"
+#include "mm-port-scheduler.h"
 
 #define MM_TYPE_IFACE_PORT_AT mm_iface_port_at_get_type ()
 G_DECLARE_INTERFACE (MMIfacePortAt, mm_iface_port_at, MM, IFACE_PORT_AT, MMPort)
@@ -30,37 +31,39 @@ G_DECLARE_INTERFACE (MMIfacePortAt, mm_iface_port_at, MM, IFACE_PORT_AT, MMPort)
 struct _MMIfacePortAtInterface {
     GTypeInterface g_iface;
 
-    gboolean (* check_support) (MMIfacePortAt        *self,
-                                gboolean             *out_supported,
-                                GError              **error);
+    gboolean (* check_support) (MMIfacePortAt           *self,
+                                gboolean                *out_supported,
+                                GError                 **error);
 
-    void    (* command)        (MMIfacePortAt        *self,
-                                const gchar          *command,
-                                guint32               timeout_seconds,
-                                gboolean              is_raw,
-                                gboolean              allow_cached,
-                                GCancellable         *cancellable,
-                                GAsyncReadyCallback   callback,
-                                gpointer              user_data);
-    gchar * (* command_finish) (MMIfacePortAt        *self,
-                                GAsyncResult         *res,
-                                GError              **error);
+    void    (* command)        (MMIfacePortAt           *self,
+                                const gchar             *command,
+                                guint32                  timeout_seconds,
+                                gboolean                 is_raw,
+                                gboolean                 allow_cached,
+                                MMPortSchedulerPriority  priority,
+                                GCancellable            *cancellable,
+                                GAsyncReadyCallback      callback,
+                                gpointer                 user_data);
+    gchar * (* command_finish) (MMIfacePortAt           *self,
+                                GAsyncResult            *res,
+                                GError                 **error);
 };
 
 gboolean  mm_iface_port_at_check_support  (MMIfacePortAt        *self,
                                            gboolean             *out_supported,
                                            GError              **error);
 
-void      mm_iface_port_at_command        (MMIfacePortAt        *self,
-                                           const gchar          *command,
-                                           guint32               timeout_seconds,
-                                           gboolean              is_raw,
-                                           gboolean              allow_cached,
-                                           GCancellable         *cancellable,
-                                           GAsyncReadyCallback   callback,
-                                           gpointer              user_data);
-gchar    *mm_iface_port_at_command_finish (MMIfacePortAt        *self,
-                                           GAsyncResult         *res,
-                                           GError              **error);
+void      mm_iface_port_at_command        (MMIfacePortAt           *self,
+                                           const gchar             *command,
+                                           guint32                  timeout_seconds,
+                                           gboolean                 is_raw,
+                                           gboolean                 allow_cached,
+                                           MMPortSchedulerPriority  priority,
+                                           GCancellable            *cancellable,
+                                           GAsyncReadyCallback      callback,
+                                           gpointer                 user_data);
+gchar    *mm_iface_port_at_command_finish (MMIfacePortAt           *self,
+                                           GAsyncResult            *res,
+                                           GError                 **error);
 
 #endif /* MM_IFACE_PORT_AT_H */
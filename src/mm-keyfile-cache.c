@@ -0,0 +1,91 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-keyfile-cache.h"
+
+#if !defined PKGSTATEDIR
+# error PKGSTATEDIR is not defined
+#endif
+
+#define KEYFILE_CACHE_KEY_VERSION "version"
+
+/*****************************************************************************/
+
+gchar *
+mm_keyfile_cache_build_digest (const gchar *str)
+{
+    return g_compute_checksum_for_string (G_CHECKSUM_SHA256, str, -1);
+}
+
+gchar *
+mm_keyfile_cache_build_filename (const gchar *prefix,
+                                 const gchar *key)
+{
+    g_autofree gchar *digest = NULL;
+    g_autofree gchar *basename = NULL;
+
+    digest = mm_keyfile_cache_build_digest (key);
+    basename = g_strdup_printf ("%s%.16s.ini", prefix, digest);
+    return g_build_path (G_DIR_SEPARATOR_S, PKGSTATEDIR, basename, NULL);
+}
+
+/*****************************************************************************/
+
+GKeyFile *
+mm_keyfile_cache_load (const gchar  *filename,
+                       const gchar  *header_group,
+                       gint          version,
+                       GError      **error)
+{
+    g_autoptr(GKeyFile) key_file = NULL;
+    gint                stored_version;
+
+    key_file = g_key_file_new ();
+    if (!g_key_file_load_from_file (key_file, filename, G_KEY_FILE_NONE, error)) {
+        g_prefix_error (error, "Error loading %s cache from %s: ", header_group, filename);
+        return NULL;
+    }
+
+    stored_version = g_key_file_get_integer (key_file, header_group, KEYFILE_CACHE_KEY_VERSION, NULL);
+    if (stored_version != version) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
+                     "Unsupported %s cache version: %d", header_group, stored_version);
+        return NULL;
+    }
+
+    return g_steal_pointer (&key_file);
+}
+
+gboolean
+mm_keyfile_cache_save (const gchar  *filename,
+                       const gchar  *header_group,
+                       gint          version,
+                       GKeyFile     *key_file,
+                       GError      **error)
+{
+    g_key_file_set_integer (key_file, header_group, KEYFILE_CACHE_KEY_VERSION, version);
+
+    if (!g_key_file_save_to_file (key_file, filename, error)) {
+        g_prefix_error (error, "Error saving %s cache to %s: ", header_group, filename);
+        return FALSE;
+    }
+    return TRUE;
+}
@@ -0,0 +1,49 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_KEYFILE_CACHE_H
+#define MM_KEYFILE_CACHE_H
+
+#include <glib.h>
+
+/* Common handling of the cache files persisted across restarts in the
+ * state directory.
+ *
+ * Each cache file is a keyfile with a header group holding the format
+ * version, named after a checksum of the given key so that identifiers
+ * like the ICCID or the device path are not exposed in the file name. */
+
+/* Returns a SHA-256 hex digest of @str */
+gchar    *mm_keyfile_cache_build_digest   (const gchar  *str);
+
+/* Returns the path of the <prefix><digest>.ini file in the state directory */
+gchar    *mm_keyfile_cache_build_filename (const gchar  *prefix,
+                                           const gchar  *key);
+
+/* Fails with MM_CORE_ERROR_UNSUPPORTED if the version in @header_group
+ * isn't @version */
+GKeyFile *mm_keyfile_cache_load           (const gchar  *filename,
+                                           const gchar  *header_group,
+                                           gint          version,
+                                           GError      **error);
+
+/* Sets the version in @header_group before writing @key_file */
+gboolean  mm_keyfile_cache_save           (const gchar  *filename,
+                                           const gchar  *header_group,
+                                           gint          version,
+                                           GKeyFile     *key_file,
+                                           GError      **error);
+
+#endif /* MM_KEYFILE_CACHE_H */
@@ -15,6 +15,10 @@
 
 
 #include <config.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
 #include <glib/gstdio.h>
 
 #define _LIBMM_INSIDE_MM
@@ -28,10 +32,37 @@
 #endif
 
 #define LOCATION_STATE_FILE "location.ini"
+#define LOCATION_DEVICE_HISTORY_FILE_PREFIX "location-history-"
 #define LOCATION_LAST_POS_GROUP "last_position"
 #define LOCATION_LAST_POS_LATITUDE_KEY "latitude"
 #define LOCATION_LAST_POS_LONGITUDE_KEY "longitude"
 
+/* The location history file is a fixed size array of fixed size records,
+ * in host byte order, preceded by a small header. Fixes are written in place
+ * as they're added, in slot (seq - 1) % MM_LOCATION_CACHE_HISTORY_SIZE, so
+ * the file is never rewritten as a whole; empty slots have seq 0. */
+#define HISTORY_FILE_MAGIC   0x484c4d4d /* "MMLH" */
+#define HISTORY_FILE_VERSION 1
+
+typedef struct {
+    guint32 magic;
+    guint32 version;
+    guint32 record_size;
+    guint32 n_records;
+} HistoryFileHeader;
+
+typedef struct {
+    gint64  timestamp;
+    gdouble latitude;
+    gdouble longitude;
+    gdouble altitude;
+    guint32 source;
+    guint32 seq;
+} HistoryFileRecord;
+
+G_STATIC_ASSERT (sizeof (HistoryFileHeader) == 16);
+G_STATIC_ASSERT (sizeof (HistoryFileRecord) == 40);
+
 /*****************************************************************************/
 
 static void log_object_iface_init (MMLogObjectInterface *iface);
@@ -44,6 +75,13 @@ struct _MMLocationCachePrivate {
     gdouble last_latitude;
     gdouble last_longitude;
     gchar*  filename;
+
+    /* Location history ring buffer, slots match the ones in the file */
+    MMLocationCacheFix history[MM_LOCATION_CACHE_HISTORY_SIZE];
+    guint32            history_seq;
+    guint              history_len;
+    gchar             *history_filename;
+    gint               history_fd;
 };
 
 /*****************************************************************************/
@@ -135,6 +173,9 @@ gboolean
 mm_location_cache_save (MMLocationCache  *self,
                         GError          **error)
 {
+    /* Caches used only for the location history don't keep a last position */
+    if (!self->priv->filename)
+        return TRUE;
     return mm_location_cache_save_to_file (self, self->priv->filename, error);
 }
 
@@ -182,12 +223,238 @@ mm_location_cache_get_lat_lon (MMLocationCache *self,
     *lon = self->priv->last_longitude;
 }
 
+/*****************************************************************************/
+/* Location history */
+
+void
+mm_location_cache_set_history_filename (MMLocationCache *self,
+                                        const gchar     *file)
+{
+    if (self->priv->history_fd >= 0) {
+        close (self->priv->history_fd);
+        self->priv->history_fd = -1;
+    }
+    g_free (self->priv->history_filename);
+    self->priv->history_filename = g_strdup (file);
+}
+
+/* Drops the contents of an invalid history file, so that it's initialized
+ * again, header included, before the next fix is written; otherwise new
+ * fixes would be written next to stale records of the old contents */
+static void
+history_file_discard (MMLocationCache *self)
+{
+    if (truncate (self->priv->history_filename, 0) < 0)
+        mm_obj_dbg (self, "couldn't discard location history file %s: %s",
+                    self->priv->history_filename, g_strerror (errno));
+}
+
+gboolean
+mm_location_cache_load_history (MMLocationCache  *self,
+                                GError          **error)
+{
+    g_autofree gchar  *contents = NULL;
+    gsize              length = 0;
+    HistoryFileHeader  header;
+    guint              i;
+
+    self->priv->history_seq = 0;
+    self->priv->history_len = 0;
+
+    g_assert (self->priv->history_filename);
+    if (!g_file_get_contents (self->priv->history_filename, &contents, &length, error)) {
+        g_prefix_error (error, "Error loading location history from %s: ", self->priv->history_filename);
+        return FALSE;
+    }
+
+    if (length != sizeof (HistoryFileHeader) + MM_LOCATION_CACHE_HISTORY_SIZE * sizeof (HistoryFileRecord)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Invalid location history file size: %" G_GSIZE_FORMAT, length);
+        history_file_discard (self);
+        return FALSE;
+    }
+
+    memcpy (&header, contents, sizeof (header));
+    if (header.magic != HISTORY_FILE_MAGIC ||
+        header.version != HISTORY_FILE_VERSION ||
+        header.record_size != sizeof (HistoryFileRecord) ||
+        header.n_records != MM_LOCATION_CACHE_HISTORY_SIZE) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Unsupported location history file format");
+        history_file_discard (self);
+        return FALSE;
+    }
+
+    for (i = 0; i < MM_LOCATION_CACHE_HISTORY_SIZE; i++) {
+        HistoryFileRecord record;
+
+        memcpy (&record, contents + sizeof (header) + i * sizeof (record), sizeof (record));
+        if (!record.seq)
+            continue;
+        /* Records not in their expected slot means a corrupted file */
+        if ((record.seq - 1) % MM_LOCATION_CACHE_HISTORY_SIZE != i) {
+            self->priv->history_seq = 0;
+            self->priv->history_len = 0;
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Invalid location history record at slot %u", i);
+            history_file_discard (self);
+            return FALSE;
+        }
+
+        self->priv->history[i].timestamp = record.timestamp;
+        self->priv->history[i].latitude = record.latitude;
+        self->priv->history[i].longitude = record.longitude;
+        self->priv->history[i].altitude = record.altitude;
+        self->priv->history[i].source = record.source;
+        self->priv->history_seq = MAX (self->priv->history_seq, record.seq);
+        self->priv->history_len++;
+    }
+
+    return TRUE;
+}
+
+static gboolean
+history_file_open (MMLocationCache  *self,
+                   GError          **error)
+{
+    HistoryFileHeader header = {
+        .magic       = HISTORY_FILE_MAGIC,
+        .version     = HISTORY_FILE_VERSION,
+        .record_size = sizeof (HistoryFileRecord),
+        .n_records   = MM_LOCATION_CACHE_HISTORY_SIZE,
+    };
+    HistoryFileHeader current;
+    gint              fd;
+
+    fd = g_open (self->priv->history_filename, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errno),
+                     "Couldn't open location history file %s: %s",
+                     self->priv->history_filename, g_strerror (errno));
+        return FALSE;
+    }
+
+    /* A new or unsupported file is reset, and synced with whatever is in the
+     * ring buffer */
+    if (pread (fd, &current, sizeof (current), 0) != sizeof (current) ||
+        memcmp (&current, &header, sizeof (header)) != 0) {
+        guint i;
+
+        if (ftruncate (fd, 0) < 0 ||
+            ftruncate (fd, sizeof (header) + MM_LOCATION_CACHE_HISTORY_SIZE * sizeof (HistoryFileRecord)) < 0 ||
+            pwrite (fd, &header, sizeof (header), 0) != sizeof (header)) {
+            g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errno),
+                         "Couldn't initialize location history file %s: %s",
+                         self->priv->history_filename, g_strerror (errno));
+            close (fd);
+            return FALSE;
+        }
+
+        for (i = 0; i < self->priv->history_len; i++) {
+            guint32            seq;
+            guint              slot;
+            HistoryFileRecord  record = { 0 };
+            MMLocationCacheFix *fix;
+
+            seq = self->priv->history_seq - i;
+            slot = (seq - 1) % MM_LOCATION_CACHE_HISTORY_SIZE;
+            fix = &self->priv->history[slot];
+            record.timestamp = fix->timestamp;
+            record.latitude = fix->latitude;
+            record.longitude = fix->longitude;
+            record.altitude = fix->altitude;
+            record.source = fix->source;
+            record.seq = seq;
+            if (pwrite (fd, &record, sizeof (record), sizeof (header) + slot * sizeof (record)) != sizeof (record))
+                break;
+        }
+    }
+
+    self->priv->history_fd = fd;
+    return TRUE;
+}
+
+void
+mm_location_cache_add_fix (MMLocationCache          *self,
+                           const MMLocationCacheFix *fix)
+{
+    HistoryFileRecord record = { 0 };
+    guint             slot;
+
+    mm_location_cache_update_from_lat_lon (self, fix->latitude, fix->longitude);
+
+    self->priv->history_seq++;
+    slot = (self->priv->history_seq - 1) % MM_LOCATION_CACHE_HISTORY_SIZE;
+    self->priv->history[slot] = *fix;
+    if (self->priv->history_len < MM_LOCATION_CACHE_HISTORY_SIZE)
+        self->priv->history_len++;
+
+    if (!self->priv->history_filename)
+        return;
+
+    if (self->priv->history_fd < 0) {
+        g_autoptr(GError) error = NULL;
+
+        if (!history_file_open (self, &error)) {
+            mm_obj_warn (self, "%s", error->message);
+            return;
+        }
+    }
+
+    record.timestamp = fix->timestamp;
+    record.latitude = fix->latitude;
+    record.longitude = fix->longitude;
+    record.altitude = fix->altitude;
+    record.source = fix->source;
+    record.seq = self->priv->history_seq;
+    if (pwrite (self->priv->history_fd, &record, sizeof (record),
+                sizeof (HistoryFileHeader) + slot * sizeof (record)) != sizeof (record))
+        mm_obj_warn (self, "couldn't write location history record: %s", g_strerror (errno));
+}
+
+GArray *
+mm_location_cache_get_history (MMLocationCache *self,
+                               gint64           since)
+{
+    GArray *fixes;
+    guint   i;
+
+    fixes = g_array_sized_new (FALSE, FALSE, sizeof (MMLocationCacheFix), self->priv->history_len);
+
+    /* Oldest first */
+    for (i = self->priv->history_len; i > 0; i--) {
+        const MMLocationCacheFix *fix;
+        guint32                   seq;
+
+        seq = self->priv->history_seq - i + 1;
+        fix = &self->priv->history[(seq - 1) % MM_LOCATION_CACHE_HISTORY_SIZE];
+        if (fix->timestamp > since)
+            g_array_append_val (fixes, *fix);
+    }
+    return fixes;
+}
+
+/*****************************************************************************/
+
 MMLocationCache *
 mm_location_cache_new (void)
 {
     return MM_LOCATION_CACHE (g_object_new (MM_TYPE_LOCATION_CACHE, NULL));
 }
 
+gchar *
+mm_location_cache_build_history_filename (const gchar *device)
+{
+    g_autofree gchar *checksum = NULL;
+    g_autofree gchar *basename = NULL;
+
+    /* Keyed by a short hash of the device path, so that each modem keeps its
+     * own history */
+    checksum = g_compute_checksum_for_string (G_CHECKSUM_SHA1, device, -1);
+    basename = g_strdup_printf (LOCATION_DEVICE_HISTORY_FILE_PREFIX "%.16s.bin", checksum);
+    return g_build_path (G_DIR_SEPARATOR_S, PKGSTATEDIR, basename, NULL);
+}
+
 static void
 mm_location_cache_init (MMLocationCache *self)
 {
@@ -198,6 +465,7 @@ mm_location_cache_init (MMLocationCache *self)
     self->priv->gps_raw = mm_location_gps_raw_new ();
 
     self->priv->filename = g_build_path (G_DIR_SEPARATOR_S, PKGSTATEDIR, LOCATION_STATE_FILE, NULL);
+    self->priv->history_fd = -1;
 }
 
 static void
@@ -207,6 +475,9 @@ finalize (GObject *object)
 
     g_object_unref (self->priv->gps_raw);
     g_free (self->priv->filename);
+    if (self->priv->history_fd >= 0)
+        close (self->priv->history_fd);
+    g_free (self->priv->history_filename);
 
     G_OBJECT_CLASS (mm_location_cache_parent_class)->finalize (object);
 }
@@ -42,6 +42,18 @@ struct _MMLocationCacheClass {
 GType mm_location_cache_get_type (void);
 G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMLocationCache, g_object_unref)
 
+/* A single location fix kept in the location history */
+typedef struct {
+    gint64  timestamp; /* milliseconds since the epoch */
+    gdouble latitude;
+    gdouble longitude;
+    gdouble altitude;
+    guint   source;    /* MMModemLocationSource */
+} MMLocationCacheFix;
+
+/* Maximum number of fixes kept in the location history */
+#define MM_LOCATION_CACHE_HISTORY_SIZE 256
+
 MMLocationCache *mm_location_cache_new (void);
 
 gboolean mm_location_cache_load_from_file      (MMLocationCache *self, const gchar *file, GError **error);
@@ -53,5 +65,11 @@ void     mm_location_cache_update_from_lat_lon (MMLocationCache *self, const dou
 void     mm_location_cache_update_from_nmea    (MMLocationCache *self, const gchar *nmea);
 void     mm_location_cache_get_lat_lon         (MMLocationCache *self, double *lat, double *lon);
 
+gchar   *mm_location_cache_build_history_filename (const gchar *device);
+void     mm_location_cache_set_history_filename   (MMLocationCache *self, const gchar *file);
+gboolean mm_location_cache_load_history           (MMLocationCache *self, GError **error);
+void     mm_location_cache_add_fix                (MMLocationCache *self, const MMLocationCacheFix *fix);
+GArray  *mm_location_cache_get_history            (MMLocationCache *self, gint64 since);
+
 #endif /* MM_LOCATION_CACHE_H */
 
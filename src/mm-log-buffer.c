@@ -0,0 +1,67 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <string.h>
+
+#include "mm-log-buffer.h"
+
+gsize
+mm_log_buffer_escape (MMLogBufferFormat  format,
+                      const guint8      *buffer,
+                      gsize              length,
+                      gchar             *out)
+{
+    static const gchar  hex[] = "0123456789abcdef";
+    gchar              *p = out;
+    gsize               i;
+
+    switch (format) {
+    case MM_LOG_BUFFER_FORMAT_HEX:
+        for (i = 0; i < length; i++) {
+            *p++ = ' ';
+            *p++ = hex[buffer[i] >> 4];
+            *p++ = hex[buffer[i] & 0x0F];
+        }
+        break;
+    case MM_LOG_BUFFER_FORMAT_TEXT:
+        *p++ = ' ';
+        *p++ = '\'';
+        for (i = 0; i < length; i++) {
+            if (g_ascii_isprint (buffer[i]))
+                *p++ = (gchar) buffer[i];
+            else if (buffer[i] == '\r') {
+                memcpy (p, "<CR>", 4);
+                p += 4;
+            } else if (buffer[i] == '\n') {
+                memcpy (p, "<LF>", 4);
+                p += 4;
+            } else {
+                /* Decimal value, e.g. \26 for Ctrl-Z */
+                *p++ = '\\';
+                if (buffer[i] >= 100)
+                    *p++ = (gchar) ('0' + buffer[i] / 100);
+                if (buffer[i] >= 10)
+                    *p++ = (gchar) ('0' + (buffer[i] / 10) % 10);
+                *p++ = (gchar) ('0' + buffer[i] % 10);
+            }
+        }
+        *p++ = '\'';
+        break;
+    default:
+        g_assert_not_reached ();
+    }
+
+    return (gsize) (p - out);
+}
@@ -0,0 +1,34 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_LOG_BUFFER_H
+#define MM_LOG_BUFFER_H
+
+#include <glib.h>
+
+#include "mm-log.h"
+
+/* Maximum number of characters written by mm_log_buffer_escape() */
+#define MM_LOG_BUFFER_ESCAPED_MAX_LEN(length) (3 + 4 * (length))
+
+/* Writes the printable representation of @buffer in @out, which must have
+ * room for at least MM_LOG_BUFFER_ESCAPED_MAX_LEN(@length) characters. The
+ * output is not NUL-terminated. Returns the number of characters written. */
+gsize mm_log_buffer_escape (MMLogBufferFormat  format,
+                            const guint8      *buffer,
+                            gsize              length,
+                            gchar             *out);
+
+#endif /* MM_LOG_BUFFER_H */
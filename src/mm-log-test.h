@@ -18,6 +18,7 @@
 
 #include <glib.h>
 #include "mm-log.h"
+#include "mm-log-buffer.h"
 
 /* This is a common logging method to be used by all test applications */
 
@@ -43,4 +44,29 @@ _mm_log (gpointer     obj,
     g_free (msg);
 }
 
+void
+_mm_log_buffer (gpointer           obj,
+                const gchar       *module,
+                const gchar       *loc,
+                const gchar       *func,
+                MMLogLevel         level,
+                const gchar       *prefix,
+                MMLogBufferFormat  format,
+                const guint8      *buffer,
+                gsize              length)
+{
+    GString *str;
+    gsize    prefix_len;
+
+    if (!g_test_verbose ())
+        return;
+
+    str = g_string_new (prefix);
+    prefix_len = str->len;
+    g_string_set_size (str, prefix_len + MM_LOG_BUFFER_ESCAPED_MAX_LEN (length));
+    g_string_truncate (str, prefix_len + mm_log_buffer_escape (format, buffer, length, &str->str[prefix_len]));
+    g_print ("%s\n", str->str);
+    g_string_free (str, TRUE);
+}
+
 #endif /* MM_LOG_TEST_H */
@@ -46,6 +46,7 @@
 
 #include "mm-log.h"
 #include "mm-log-object.h"
+#include "mm-log-buffer.h"
 
 enum {
     TS_FLAG_NONE = 0,
@@ -80,8 +81,34 @@ static const LogDesc level_descs[] = {
     { 0, NULL }
 };
 
-static GString *msgbuf = NULL;
-static gsize msgbuf_once = 0;
+/* Size of the on-stack buffer used to build each log line; longer lines
+ * fall back to a heap allocated buffer */
+#define LOG_LINE_STACK_SIZE 512
+
+/* Size of the ring buffer used by the buffered file backend */
+#define LOG_FILE_BUFFER_SIZE (1024 * 1024)
+
+typedef struct {
+    GMutex    mutex;
+    GCond     cond;
+    GCond     flushed_cond;
+    GThread  *thread;
+    gboolean  stop;
+    /* policy */
+    guint     flush_interval_ms;
+    gsize     flush_size;
+    int       sync_syslog_level;
+    /* ring buffer; the writer thread owns [head, head+in_progress) until
+     * it releases it, so data is written out without additional copies */
+    gchar    *data;
+    gsize     head;
+    gsize     len;
+    gsize     in_progress;
+    gboolean  sync_requested;
+    guint64   n_dropped;
+} LogFileWriter;
+
+static LogFileWriter file_writer;
 
 static int
 mm_to_syslog_priority (MMLogLevel level)
@@ -153,6 +180,151 @@ log_level_description (MMLogLevel level)
     return NULL;
 }
 
+static void
+log_file_write_all (const gchar *data,
+                    gsize        length)
+{
+    while (length > 0) {
+        ssize_t n;
+
+        n = write (logfd, data, length);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            /* whatever; nothing else we can do */
+            return;
+        }
+        data += n;
+        length -= n;
+    }
+}
+
+static gpointer
+log_file_writer_thread (gpointer unused)
+{
+    gint64 last_sync_time;
+
+    last_sync_time = g_get_monotonic_time ();
+
+    g_mutex_lock (&file_writer.mutex);
+    while (TRUE) {
+        gint64   deadline;
+        gsize    start;
+        gsize    length;
+        gboolean sync;
+        gboolean stop;
+        guint64  n_dropped;
+
+        deadline = g_get_monotonic_time () + file_writer.flush_interval_ms * G_TIME_SPAN_MILLISECOND;
+        while (!file_writer.stop &&
+               !file_writer.sync_requested &&
+               file_writer.len < file_writer.flush_size) {
+            if (!g_cond_wait_until (&file_writer.cond, &file_writer.mutex, deadline))
+                break;
+        }
+
+        start = file_writer.head;
+        length = file_writer.len;
+        sync = file_writer.sync_requested;
+        stop = file_writer.stop;
+        n_dropped = file_writer.n_dropped;
+        file_writer.sync_requested = FALSE;
+        file_writer.n_dropped = 0;
+        file_writer.in_progress = length;
+        g_mutex_unlock (&file_writer.mutex);
+
+        /* The reported region is not touched by producers until released */
+        if (length > 0) {
+            gsize first;
+
+            first = MIN (length, LOG_FILE_BUFFER_SIZE - start);
+            log_file_write_all (&file_writer.data[start], first);
+            if (first < length)
+                log_file_write_all (file_writer.data, length - first);
+        }
+
+        if (n_dropped > 0) {
+            gchar dropped_msg[128];
+            gint  dropped_msg_len;
+
+            dropped_msg_len = g_snprintf (dropped_msg, sizeof (dropped_msg),
+                                          "%slog buffer overflow: %" G_GUINT64_FORMAT " messages dropped\n",
+                                          append_log_level_text ? "<wrn> " : "",
+                                          n_dropped);
+            log_file_write_all (dropped_msg, MIN ((gsize) dropped_msg_len, sizeof (dropped_msg) - 1));
+        }
+
+        if ((length > 0 || n_dropped > 0) &&
+            (sync || stop ||
+             (g_get_monotonic_time () - last_sync_time) >= (gint64) file_writer.flush_interval_ms * G_TIME_SPAN_MILLISECOND)) {
+            fsync (logfd);
+            last_sync_time = g_get_monotonic_time ();
+        }
+
+        g_mutex_lock (&file_writer.mutex);
+        file_writer.head = (file_writer.head + length) % LOG_FILE_BUFFER_SIZE;
+        file_writer.len -= length;
+        file_writer.in_progress = 0;
+        /* Wakeup anyone waiting for the buffer to be flushed */
+        g_cond_broadcast (&file_writer.flushed_cond);
+
+        if (stop && file_writer.len == 0 && file_writer.n_dropped == 0)
+            break;
+    }
+    g_mutex_unlock (&file_writer.mutex);
+
+    return NULL;
+}
+
+static void
+log_file_writer_flush (void)
+{
+    g_mutex_lock (&file_writer.mutex);
+    if (file_writer.thread) {
+        file_writer.sync_requested = TRUE;
+        g_cond_broadcast (&file_writer.cond);
+        while (file_writer.len > 0 && file_writer.thread)
+            g_cond_wait (&file_writer.flushed_cond, &file_writer.mutex);
+    }
+    g_mutex_unlock (&file_writer.mutex);
+}
+
+static void
+log_file_writer_start (guint flush_interval_ms,
+                       gsize flush_size,
+                       int   sync_syslog_level)
+{
+    file_writer.flush_interval_ms = flush_interval_ms;
+    file_writer.flush_size = CLAMP (flush_size, 1, LOG_FILE_BUFFER_SIZE);
+    file_writer.sync_syslog_level = sync_syslog_level;
+    file_writer.data = g_malloc (LOG_FILE_BUFFER_SIZE);
+    file_writer.thread = g_thread_new ("mm-log-writer", log_file_writer_thread, NULL);
+}
+
+static void
+log_file_writer_stop (void)
+{
+    GThread *thread;
+
+    g_mutex_lock (&file_writer.mutex);
+    thread = file_writer.thread;
+    file_writer.stop = TRUE;
+    g_cond_broadcast (&file_writer.cond);
+    g_mutex_unlock (&file_writer.mutex);
+
+    if (!thread)
+        return;
+
+    g_thread_join (thread);
+
+    g_mutex_lock (&file_writer.mutex);
+    file_writer.thread = NULL;
+    g_cond_broadcast (&file_writer.flushed_cond);
+    g_mutex_unlock (&file_writer.mutex);
+
+    g_clear_pointer (&file_writer.data, g_free);
+}
+
 static void
 log_backend_file (const char *loc,
                   const char *func,
@@ -160,12 +332,43 @@ log_backend_file (const char *loc,
                   const char *message,
                   size_t      length)
 {
-    ssize_t ign;
+    gsize tail;
+    gsize first;
 
-    ign = write (logfd, message, length);
-    if (ign) {} /* whatever; really shut up about unused result */
+    g_mutex_lock (&file_writer.mutex);
 
-    fsync (logfd);  /* Make sure output is dumped to disk immediately  */
+    /* No writer thread (synchronous mode, or already shut down) */
+    if (!file_writer.thread || file_writer.stop) {
+        g_mutex_unlock (&file_writer.mutex);
+        log_file_write_all (message, length);
+        fsync (logfd);  /* Make sure output is dumped to disk immediately  */
+        return;
+    }
+
+    /* Never block the caller: drop the message if there is no room */
+    if (length > LOG_FILE_BUFFER_SIZE - file_writer.len) {
+        file_writer.n_dropped++;
+        g_mutex_unlock (&file_writer.mutex);
+        return;
+    }
+
+    tail = (file_writer.head + file_writer.len) % LOG_FILE_BUFFER_SIZE;
+    first = MIN (length, LOG_FILE_BUFFER_SIZE - tail);
+    memcpy (&file_writer.data[tail], message, first);
+    if (first < length)
+        memcpy (file_writer.data, message + first, length - first);
+    file_writer.len += length;
+
+    if (syslog_level <= file_writer.sync_syslog_level)
+        file_writer.sync_requested = TRUE;
+
+    /* Only wakeup the writer if any flush condition is met, otherwise
+     * it will wakeup by itself once the flush interval elapses */
+    if (file_writer.sync_requested ||
+        (file_writer.len - file_writer.in_progress) >= file_writer.flush_size)
+        g_cond_signal (&file_writer.cond);
+
+    g_mutex_unlock (&file_writer.mutex);
 }
 
 static void
@@ -227,33 +430,127 @@ mm_log_check_level_enabled (MMLogLevel level)
     return (log_level & level);
 }
 
-void
-_mm_log (gpointer     obj,
-         const gchar *module,
-         const gchar *loc,
-         const gchar *func,
-         MMLogLevel   level,
-         const gchar *fmt,
-         ...)
+/*****************************************************************************/
+/* Log line building: each line is built in a single buffer, on the stack
+ * unless it is too long. No shared state, so safe to use from any thread. */
+
+typedef struct {
+    gchar  stack[LOG_LINE_STACK_SIZE];
+    gchar *str;
+    gsize  len;
+    gsize  allocated;
+} LogLine;
+
+static void
+log_line_init (LogLine *line)
 {
-    va_list  args;
-    GTimeVal tv;
+    line->str = line->stack;
+    line->len = 0;
+    line->allocated = sizeof (line->stack);
+    line->str[0] = '\0';
+}
 
-    if (!mm_log_check_level_enabled (level))
+static void
+log_line_clear (LogLine *line)
+{
+    if (line->str != line->stack)
+        g_free (line->str);
+}
+
+static void
+log_line_reserve (LogLine *line,
+                  gsize    extra)
+{
+    gsize needed;
+
+    /* Always keep room for the trailing NUL byte */
+    needed = line->len + extra + 1;
+    if (needed <= line->allocated)
         return;
 
-    if (g_once_init_enter (&msgbuf_once)) {
-        msgbuf = g_string_sized_new (512);
-        g_once_init_leave (&msgbuf_once, 1);
+    line->allocated = MAX (needed, line->allocated * 2);
+    if (line->str == line->stack) {
+        line->str = g_malloc (line->allocated);
+        memcpy (line->str, line->stack, line->len + 1);
     } else
-        g_string_truncate (msgbuf, 0);
+        line->str = g_realloc (line->str, line->allocated);
+}
 
-    if (append_log_level_text)
-        g_string_append_printf (msgbuf, "%s ", log_level_description (level));
+static void
+log_line_append_len (LogLine     *line,
+                     const gchar *str,
+                     gsize        len)
+{
+    log_line_reserve (line, len);
+    memcpy (&line->str[line->len], str, len);
+    line->len += len;
+    line->str[line->len] = '\0';
+}
+
+static void
+log_line_append_c (LogLine *line,
+                   gchar    c)
+{
+    log_line_reserve (line, 1);
+    line->str[line->len++] = c;
+    line->str[line->len] = '\0';
+}
+
+static void
+log_line_append_vprintf (LogLine     *line,
+                         const gchar *fmt,
+                         va_list      args)
+{
+    va_list args_copy;
+    gint    n;
+
+    va_copy (args_copy, args);
+    n = g_vsnprintf (&line->str[line->len], line->allocated - line->len, fmt, args_copy);
+    va_end (args_copy);
+    if (n < 0)
+        return;
+
+    /* Didn't fit; grow and format again */
+    if ((gsize) n >= line->allocated - line->len) {
+        log_line_reserve (line, n);
+        g_vsnprintf (&line->str[line->len], line->allocated - line->len, fmt, args);
+    }
+    line->len += n;
+}
+
+static void
+log_line_append_printf (LogLine     *line,
+                        const gchar *fmt,
+                        ...)
+{
+    va_list args;
+
+    va_start (args, fmt);
+    log_line_append_vprintf (line, fmt, args);
+    va_end (args);
+}
+
+static void
+log_line_append_prefix (LogLine     *line,
+                        gpointer     obj,
+                        const gchar *module,
+                        const gchar *loc,
+                        const gchar *func,
+                        MMLogLevel   level)
+{
+    GTimeVal tv;
+
+    if (append_log_level_text) {
+        const gchar *description;
+
+        description = log_level_description (level);
+        log_line_append_len (line, description, strlen (description));
+        log_line_append_c (line, ' ');
+    }
 
     if (ts_flags == TS_FLAG_WALL) {
         g_get_current_time (&tv);
-        g_string_append_printf (msgbuf, "[%09ld.%06ld] ", tv.tv_sec, tv.tv_usec);
+        log_line_append_printf (line, "[%09ld.%06ld] ", tv.tv_sec, tv.tv_usec);
     } else if (ts_flags == TS_FLAG_REL) {
         glong secs;
         glong usecs;
@@ -266,26 +563,85 @@ _mm_log (gpointer     obj,
             usecs += 1000000;
         }
 
-        g_string_append_printf (msgbuf, "[%06ld.%06ld] ", secs, usecs);
+        log_line_append_printf (line, "[%06ld.%06ld] ", secs, usecs);
     }
 
 #if defined MM_LOG_FUNC_LOC
     if (loc && func)
-        g_string_append_printf (msgbuf, "[%s] %s(): ", loc, func);
+        log_line_append_printf (line, "[%s] %s(): ", loc, func);
 #endif
 
-    if (obj)
-        g_string_append_printf (msgbuf, "[%s] ", mm_log_object_get_id (MM_LOG_OBJECT (obj)));
-    if (module)
-        g_string_append_printf (msgbuf, "(%s) ", module);
+    if (obj) {
+        const gchar *id;
+
+        id = mm_log_object_get_id (MM_LOG_OBJECT (obj));
+        log_line_append_c (line, '[');
+        log_line_append_len (line, id, strlen (id));
+        log_line_append_len (line, "] ", 2);
+    }
+    if (module) {
+        log_line_append_c (line, '(');
+        log_line_append_len (line, module, strlen (module));
+        log_line_append_len (line, ") ", 2);
+    }
+}
+
+void
+_mm_log (gpointer     obj,
+         const gchar *module,
+         const gchar *loc,
+         const gchar *func,
+         MMLogLevel   level,
+         const gchar *fmt,
+         ...)
+{
+    va_list args;
+    LogLine line;
+
+    if (!mm_log_check_level_enabled (level))
+        return;
+
+    log_line_init (&line);
+    log_line_append_prefix (&line, obj, module, loc, func, level);
 
     va_start (args, fmt);
-    g_string_append_vprintf (msgbuf, fmt, args);
+    log_line_append_vprintf (&line, fmt, args);
     va_end (args);
 
-    g_string_append_c (msgbuf, '\n');
+    log_line_append_c (&line, '\n');
+
+    log_backend (loc, func, mm_to_syslog_priority (level), line.str, line.len);
+    log_line_clear (&line);
+}
+
+void
+_mm_log_buffer (gpointer           obj,
+                const gchar       *module,
+                const gchar       *loc,
+                const gchar       *func,
+                MMLogLevel         level,
+                const gchar       *prefix,
+                MMLogBufferFormat  format,
+                const guint8      *buffer,
+                gsize              length)
+{
+    LogLine line;
+
+    if (!mm_log_check_level_enabled (level))
+        return;
+
+    log_line_init (&line);
+    log_line_append_prefix (&line, obj, module, loc, func, level);
+    log_line_append_len (&line, prefix, strlen (prefix));
+
+    log_line_reserve (&line, MM_LOG_BUFFER_ESCAPED_MAX_LEN (length));
+    line.len += mm_log_buffer_escape (format, buffer, length, &line.str[line.len]);
+    line.str[line.len] = '\0';
 
-    log_backend (loc, func, mm_to_syslog_priority (level), msgbuf->str, msgbuf->len);
+    log_line_append_c (&line, '\n');
+
+    log_backend (loc, func, mm_to_syslog_priority (level), line.str, line.len);
+    log_line_clear (&line);
 }
 
 static void
@@ -301,26 +657,37 @@ log_handler (const gchar    *log_domain,
              glib_level_to_mm_level (glib_level),
              "%s",
              message);
+
+    /* Make sure everything is in disk before aborting */
+    if (glib_level & (G_LOG_FLAG_FATAL | G_LOG_LEVEL_ERROR))
+        log_file_writer_flush ();
 }
 
-gboolean
-mm_log_set_level (const gchar  *level,
-                  GError      **error)
+static gboolean
+log_level_mask_from_string (const gchar  *level,
+                            guint32      *out_mask,
+                            GError      **error)
 {
     guint i;
 
-    for (i = 0; i < G_N_ELEMENTS (level_descs); i++) {
+    for (i = 0; level_descs[i].name; i++) {
         if (!g_ascii_strcasecmp (level_descs[i].name, level)) {
-            log_level = level_descs[i].num;
-            break;
+            *out_mask = level_descs[i].num;
+            return TRUE;
         }
     }
 
-    if (i == G_N_ELEMENTS (level_descs)) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
-                     "Unknown log level '%s'", level);
+    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                 "Unknown log level '%s'", level);
+    return FALSE;
+}
+
+gboolean
+mm_log_set_level (const gchar  *level,
+                  GError      **error)
+{
+    if (!log_level_mask_from_string (level, &log_level, error))
         return FALSE;
-    }
 
 #if defined WITH_QMI
     qmi_utils_set_traces_enabled (log_level & MM_LOG_LEVEL_DEBUG ? TRUE : FALSE);
@@ -336,16 +703,25 @@ mm_log_set_level (const gchar  *level,
 gboolean
 mm_log_setup (const gchar  *level,
               const gchar  *log_file,
+              guint         log_file_flush_interval_ms,
+              guint         log_file_flush_size,
+              const gchar  *log_file_sync_level,
               gboolean      log_journal,
               gboolean      show_timestamps,
               gboolean      rel_timestamps,
               gboolean      show_personal_info,
               GError      **error)
 {
+    guint32 sync_mask = MM_LOG_LEVEL_ERR | MM_LOG_LEVEL_WARN;
+
     /* levels */
     if (level && strlen (level) && !mm_log_set_level (level, error))
         return FALSE;
 
+    if (log_file_sync_level && strlen (log_file_sync_level) &&
+        !log_level_mask_from_string (log_file_sync_level, &sync_mask, error))
+        return FALSE;
+
     personal_info = show_personal_info;
 
     if (show_timestamps)
@@ -376,6 +752,20 @@ mm_log_setup (const gchar  *level,
             return FALSE;
         }
         log_backend = log_backend_file;
+
+        /* Unless explicitly disabled, messages are buffered and written to
+         * disk by a separate thread */
+        if (log_file_flush_interval_ms > 0) {
+            int sync_syslog_level = -1;
+            guint i;
+
+            /* Least severe syslog priority that triggers a sync */
+            for (i = 0; i < 32; i++) {
+                if (sync_mask & (1 << i))
+                    sync_syslog_level = MAX (sync_syslog_level, mm_to_syslog_priority (1 << i));
+            }
+            log_file_writer_start (log_file_flush_interval_ms, log_file_flush_size, sync_syslog_level);
+        }
     }
 
     g_log_set_handler (G_LOG_DOMAIN,
@@ -414,8 +804,10 @@ mm_log_shutdown (void)
 {
     if (logfd < 0)
         closelog ();
-    else
+    else {
+        log_file_writer_stop ();
         close (logfd);
+    }
 }
 
 /******************************************************************************/
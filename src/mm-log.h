@@ -52,6 +52,16 @@ typedef enum {
 # define mm_dbg(...)  mm_obj_dbg  (NULL, ## __VA_ARGS__ )
 #endif
 
+/* Dump a binary buffer (e.g. port traffic) built directly in the log line */
+typedef enum {
+    MM_LOG_BUFFER_FORMAT_TEXT, /* printable chars as-is, <CR>, <LF>, and \NNN otherwise */
+    MM_LOG_BUFFER_FORMAT_HEX,
+} MMLogBufferFormat;
+
+#define mm_obj_dbg_buffer(obj, prefix, format, buffer, length)   \
+    _mm_log_buffer (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, \
+                    MM_LOG_LEVEL_DEBUG, prefix, format, buffer, length)
+
 #define mm_log_err_enabled()   mm_log_check_level_enabled (MM_LOG_LEVEL_ERR)
 #define mm_log_warn_enabled()  mm_log_check_level_enabled (MM_LOG_LEVEL_WARN)
 #define mm_log_msg_enabled()   mm_log_check_level_enabled (MM_LOG_LEVEL_MSG)
@@ -66,10 +76,23 @@ void _mm_log (gpointer     obj,
               const gchar *fmt,
               ...)  __attribute__((__format__ (__printf__, 6, 7)));
 
+void _mm_log_buffer (gpointer           obj,
+                     const gchar       *module,
+                     const gchar       *loc,
+                     const gchar       *func,
+                     MMLogLevel         level,
+                     const gchar       *prefix,
+                     MMLogBufferFormat  format,
+                     const guint8      *buffer,
+                     gsize              length);
+
 gboolean mm_log_set_level              (const gchar  *level,
                                         GError      **error);
 gboolean mm_log_setup                  (const gchar  *level,
                                         const gchar  *log_file,
+                                        guint         log_file_flush_interval_ms,
+                                        guint         log_file_flush_size,
+                                        const gchar  *log_file_sync_level,
                                         gboolean      log_journal,
                                         gboolean      show_ts,
                                         gboolean      rel_ts,
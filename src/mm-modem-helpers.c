@@ -23,6 +23,7 @@
 #include <glib.h>
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
 #include <arpa/inet.h>
 
 #include <ModemManager.h>
@@ -34,6 +35,8 @@
 #include "mm-modem-helpers.h"
 #include "mm-helper-enums-types.h"
 #include "mm-log-object.h"
+#include "mm-regex-registry.h"
+#include "mm-at-lexer.h"
 
 /*****************************************************************************/
 
@@ -75,61 +78,34 @@ gchar **
 mm_split_string_groups (const gchar *str)
 {
     GPtrArray *array;
-    const gchar *start;
-    const gchar *next;
+    MMAtLexer  lexer;
+    MMAtToken  token;
 
-    array = g_ptr_array_new ();
+    if (!str)
+        return NULL;
 
     /*
-     * Manually parse splitting groups. Groups may be single elements, or otherwise
-     * lists given between parenthesis, e.g.:
+     * Split groups. Groups may be single elements, or otherwise lists given
+     * between parenthesis, e.g.:
      *
      *    ("SM","ME"),("SM","ME"),("SM","ME")
      *    "SM","SM","SM"
      *    "SM",("SM","ME"),("SM","ME")
+     *
+     * Lists are returned without the enclosing parenthesis, single quoted
+     * elements are returned with their quotes.
      */
-
-    /* Iterate string splitting groups */
-    for (start = str; start; start = next) {
-        gchar *item;
-        gssize len = -1;
-
-        /* skip leading whitespaces */
-        while (*start == ' ')
-            start++;
-
-        if (*start == '(') {
-            start++;
-            next = strchr (start, ')');
-            if (next) {
-                len = next - start;
-                next = strchr (next, ',');
-                if (next)
-                    next++;
-            }
-        } else {
-            next = strchr (start, ',');
-            if (next) {
-                len = next - start;
-                next++;
-            }
-        }
-
-        if (len < 0)
-            item = g_strdup (start);
+    array = g_ptr_array_new ();
+    mm_at_lexer_init (&lexer, str, -1);
+    while (mm_at_lexer_next (&lexer, &token)) {
+        if (token.type == MM_AT_TOKEN_TYPE_STRING)
+            g_ptr_array_add (array, g_strdup_printf ("\"%.*s\"", (gint) token.len, token.str));
         else
-            item = g_strndup (start, len);
-
-        g_ptr_array_add (array, item);
-    }
-
-    if (array->len > 0) {
-        g_ptr_array_add (array, NULL);
-        return (gchar **) g_ptr_array_free (array, FALSE);
+            g_ptr_array_add (array, mm_at_token_dup (&token));
     }
 
-    g_ptr_array_unref (array);
-    return NULL;
+    g_ptr_array_add (array, NULL);
+    return (gchar **) g_ptr_array_free (array, FALSE);
 }
 
 /*****************************************************************************/
@@ -143,10 +119,9 @@ GArray *
 mm_parse_uint_list (const gchar  *str,
                     GError      **error)
 {
-    GArray *array;
-    gchar  *dupstr;
-    gchar  *aux;
-    GError *inner_error = NULL;
+    GArray    *array;
+    MMAtLexer  lexer;
+    MMAtToken  token;
 
     if (!str || !str[0])
         return NULL;
@@ -158,76 +133,31 @@ mm_parse_uint_list (const gchar  *str,
      *   1,2,4-6  --> 1,2,4,5,6
      */
     array = g_array_new (FALSE, FALSE, sizeof (guint));
-    aux = dupstr = g_strdup (str);
-
-    while (aux) {
-        gchar *next;
-        gchar *interval;
+    mm_at_lexer_init (&lexer, str, -1);
+    while (mm_at_lexer_next (&lexer, &token)) {
+        guint num;
 
-        next = strchr (aux, ',');
-        if (next) {
-            *next = '\0';
-            next++;
+        if (token.type != MM_AT_TOKEN_TYPE_NUMBER && token.type != MM_AT_TOKEN_TYPE_RANGE) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "couldn't parse integer or interval: '%.*s'", (gint) token.len, token.str);
+            g_array_unref (array);
+            return NULL;
         }
 
-        interval = strchr (aux, '-');
-        if (interval) {
-            guint start = 0;
-            guint stop = 0;
-
-            *interval = '\0';
-            interval++;
-
-            if (!mm_get_uint_from_str (aux, &start)) {
-                inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                           "couldn't parse interval start integer: '%s'", aux);
-                goto out;
-            }
-            if (!mm_get_uint_from_str (interval, &stop)) {
-                inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                           "couldn't parse interval stop integer: '%s'", interval);
-                goto out;
-            }
-
-            if (start > stop) {
-                inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                           "interval start (%u) cannot be bigger than interval stop (%u)", start, stop);
-                goto out;
-            }
-
-            for (; start <= stop; start++)
-                g_array_append_val (array, start);
-        } else {
-            guint num;
-
-            if (!mm_get_uint_from_str (aux, &num)) {
-                inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                           "couldn't parse integer: '%s'", aux);
-                goto out;
-            }
-
-            g_array_append_val (array, num);
+        if (token.min > token.max) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "interval start (%u) cannot be bigger than interval stop (%u)", token.min, token.max);
+            g_array_unref (array);
+            return NULL;
         }
 
-        aux = next;
-    }
-
-    if (!array->len)
-        inner_error = g_error_new (MM_CORE_ERROR,
-                                   MM_CORE_ERROR_FAILED,
-                                   "couldn't parse list of integers: '%s'", str);
-    else
-        g_array_sort (array, uint_compare_func);
-
-out:
-    g_free (dupstr);
-
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
-        g_array_unref (array);
-        return NULL;
+        num = token.min;
+        do
+            g_array_append_val (array, num);
+        while (num++ < token.max);
     }
 
+    g_array_sort (array, uint_compare_func);
     return array;
 }
 
@@ -574,7 +504,7 @@ mm_3gpp_parse_clcc_response (const gchar  *str,
                              GList       **out_list,
                              GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info  = NULL;
     GList                 *list = NULL;
     GError                *inner_error = NULL;
@@ -611,16 +541,14 @@ mm_3gpp_parse_clcc_response (const gchar  *str,
      *  ...
      */
 
-    r = g_regex_new ("\\+CLCC:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)" /* mandatory fields */
-                     "(?:,\\s*([^,]*),\\s*(\\d+)"                                     /* number and type */
-                     "(?:,\\s*([^,]*)"                                                /* alpha */
-                     "(?:,\\s*(\\d*)"                                                 /* priority */
-                     "(?:,\\s*(\\d*)"                                                 /* CLI validity */
-                     ")?)?)?)?$",
-                     G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
-                     G_REGEX_MATCH_NEWLINE_CRLF,
-                     NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CLCC:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)" /* mandatory fields */
+                               "(?:,\\s*([^,]*),\\s*(\\d+)"                                     /* number and type */
+                               "(?:,\\s*([^,]*)"                                                /* alpha */
+                               "(?:,\\s*(\\d*)"                                                 /* priority */
+                               "(?:,\\s*(\\d*)"                                                 /* CLI validity */
+                               ")?)?)?)?$",
+                               G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
+                               G_REGEX_MATCH_NEWLINE_CRLF);
 
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -779,15 +707,14 @@ mm_parse_ifc_test_response (const gchar  *response,
                             gpointer      log_object,
                             GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info  = NULL;
     GError                *inner_error = NULL;
     MMFlowControl          te_mask     = MM_FLOW_CONTROL_UNKNOWN;
     MMFlowControl          ta_mask     = MM_FLOW_CONTROL_UNKNOWN;
     MMFlowControl          mask        = MM_FLOW_CONTROL_UNKNOWN;
 
-    r = g_regex_new ("(?:\\+IFC:)?\\s*\\((.*)\\),\\((.*)\\)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("(?:\\+IFC:)?\\s*\\((.*)\\),\\((.*)\\)(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -1055,7 +982,7 @@ mm_3gpp_parse_ws46_test_response (const gchar  *response,
                                   gpointer      log_object,
                                   GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GArray                *modes = NULL;
     GArray                *tech_values = NULL;
@@ -1071,8 +998,7 @@ mm_3gpp_parse_ws46_test_response (const gchar  *response,
     gboolean               supported_mode_25 = FALSE;
     gboolean               supported_mode_29 = FALSE;
 
-    r = g_regex_new ("(?:\\+WS46:)?\\s*\\((.*)\\)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("(?:\\+WS46:)?\\s*\\((.*)\\)(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -1194,6 +1120,79 @@ mm_3gpp_network_info_list_free (GList *info_list)
     g_list_free_full (info_list, (GDestroyNotify) mm_3gpp_network_info_free);
 }
 
+static gboolean
+network_info_list_contains (GList             *info_list,
+                            MM3gppNetworkInfo *info)
+{
+    GList *l;
+
+    for (l = info_list; l; l = g_list_next (l)) {
+        MM3gppNetworkInfo *iter = l->data;
+
+        if (iter->access_tech == info->access_tech &&
+            g_strcmp0 (iter->operator_code, info->operator_code) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+GList *
+mm_3gpp_network_info_list_filter_new (GList *known_list,
+                                      GList *info_list)
+{
+    GList *new_list = NULL;
+    GList *repeated_list = NULL;
+    GList *l;
+
+    for (l = info_list; l; l = g_list_next (l)) {
+        MM3gppNetworkInfo *info = l->data;
+
+        if (!info->operator_code ||
+            network_info_list_contains (known_list, info) ||
+            network_info_list_contains (new_list, info))
+            repeated_list = g_list_prepend (repeated_list, info);
+        else
+            new_list = g_list_prepend (new_list, info);
+    }
+    g_list_free (info_list);
+    mm_3gpp_network_info_list_free (repeated_list);
+
+    return g_list_reverse (new_list);
+}
+
+/*************************************************************************/
+
+GArray *
+mm_3gpp_build_incremental_scan_passes (MMModemMode supported,
+                                       MMModemMode allowed)
+{
+    static const MMModemMode pass_modes[] = {
+        MM_MODEM_MODE_5G,
+        MM_MODEM_MODE_4G,
+        MM_MODEM_MODE_3G,
+        MM_MODEM_MODE_2G,
+    };
+    GArray *passes;
+    guint   i;
+
+    passes = g_array_new (FALSE, FALSE, sizeof (MMModemMode));
+
+    /* One pass per supported and allowed access technology, newest first */
+    for (i = 0; i < G_N_ELEMENTS (pass_modes); i++) {
+        if (!(supported & pass_modes[i]))
+            continue;
+        if (allowed != MM_MODEM_MODE_ANY && !(allowed & pass_modes[i]))
+            continue;
+        g_array_append_val (passes, pass_modes[i]);
+    }
+
+    /* Single pass with the full scan otherwise */
+    if (!passes->len)
+        g_array_append_val (passes, allowed);
+
+    return passes;
+}
+
 static MMModem3gppNetworkAvailability
 get_mm_network_availability_from_3gpp_network_availability (guint    val,
                                                             gpointer log_object)
@@ -1261,7 +1260,7 @@ mm_3gpp_parse_cops_test_response (const gchar     *reply,
                                   gpointer         log_object,
                                   GError         **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GList                 *info_list = NULL;
     gboolean               umts_format = TRUE;
@@ -1293,12 +1292,10 @@ mm_3gpp_parse_cops_test_response (const gchar     *reply,
      *       +COPS: (2,"","T-Mobile","31026",0),(1,"AT&T","AT&T","310410"),0)
      */
 
-    r = g_regex_new ("\\((\\d),\"([^\"\\)]*)\",([^,\\)]*),([^,\\)]*)[\\)]?,(\\d+)\\)", G_REGEX_UNGREEDY, 0, NULL);
-    g_assert (r);
+    r = mm_regex_registry_get ("\\((\\d),\"([^\"\\)]*)\",([^,\\)]*),([^,\\)]*)[\\)]?,(\\d+)\\)", G_REGEX_UNGREEDY, 0);
 
     /* If we didn't get any hits, try the pre-UMTS format match */
     if (!g_regex_match (r, reply, 0, &match_info)) {
-        g_clear_pointer (&r, g_regex_unref);
         g_clear_pointer (&match_info, g_match_info_free);
 
         /* Pre-UMTS format doesn't include the cell access technology after
@@ -1314,8 +1311,7 @@ mm_3gpp_parse_cops_test_response (const gchar     *reply,
          *       +COPS: (2,"T - Mobile",,"31026"),(1,"Einstein PCS",,"31064"),(1,"Cingular",,"31041"),,(0,1,3),(0,2)
          */
 
-        r = g_regex_new ("\\((\\d),([^,\\)]*),([^,\\)]*),([^\\)]*)\\)", G_REGEX_UNGREEDY, 0, NULL);
-        g_assert (r);
+        r = mm_regex_registry_get ("\\((\\d),([^,\\)]*),([^,\\)]*),([^\\)]*)\\)", G_REGEX_UNGREEDY, 0);
 
         g_regex_match (r, reply, 0, &match_info);
         umts_format = FALSE;
@@ -1404,7 +1400,7 @@ mm_3gpp_parse_cops_read_response (const gchar              *response,
                                   gpointer                  log_object,
                                   GError                  **error)
 {
-    g_autoptr(GRegex)        r = NULL;
+    GRegex                  *r = NULL;
     g_autoptr(GMatchInfo)    match_info = NULL;
     GError                  *inner_error = NULL;
     guint                    mode = 0;
@@ -1420,8 +1416,7 @@ mm_3gpp_parse_cops_read_response (const gchar              *response,
      * or:
      *   +COPS: <mode>,<format>,<oper>,<AcT>
      */
-    r = g_regex_new ("\\+COPS:\\s*(\\d+),(\\d+),([^,]*)(?:,(\\d+))?(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+COPS:\\s*(\\d+),(\\d+),([^,]*)(?:,(\\d+))?(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -1795,7 +1790,7 @@ mm_3gpp_parse_cgdcont_test_response (const gchar  *response,
                                      gpointer      log_object,
                                      GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     GList                 *list = NULL;
@@ -1805,10 +1800,9 @@ mm_3gpp_parse_cgdcont_test_response (const gchar  *response,
         return NULL;
     }
 
-    r = g_regex_new ("\\+CGDCONT:\\s*\\(\\s*(\\d+)\\s*-?\\s*(\\d+)?[^\\)]*\\)\\s*,\\s*\\(?\"(\\S+)\"",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, &inner_error);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CGDCONT:\\s*\\(\\s*(\\d+)\\s*-?\\s*(\\d+)?[^\\)]*\\)\\s*,\\s*\\(?\"(\\S+)\"",
+                               G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                               0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     while (!inner_error && g_match_info_matches (match_info)) {
@@ -1876,57 +1870,100 @@ mm_3gpp_pdp_context_cmp (MM3gppPdpContext *a,
     return (a->cid - b->cid);
 }
 
+static const struct {
+    const gchar      *str;
+    MMBearerIpFamily  ip_family;
+} pdp_types[] = {
+    { "IP",     MM_BEARER_IP_FAMILY_IPV4   },
+    { "IPV4",   MM_BEARER_IP_FAMILY_IPV4   },
+    { "IPV6",   MM_BEARER_IP_FAMILY_IPV6   },
+    { "IPV4V6", MM_BEARER_IP_FAMILY_IPV4V6 },
+    { "Non-IP", MM_BEARER_IP_FAMILY_NON_IP },
+};
+
+static MMBearerIpFamily
+ip_family_from_pdp_type_token (const MMAtToken *token)
+{
+    guint i;
+
+    if (token->type != MM_AT_TOKEN_TYPE_STRING && token->type != MM_AT_TOKEN_TYPE_WORD)
+        return MM_BEARER_IP_FAMILY_NONE;
+
+    for (i = 0; i < G_N_ELEMENTS (pdp_types); i++) {
+        if (mm_at_token_equal (token, pdp_types[i].str))
+            return pdp_types[i].ip_family;
+    }
+    return MM_BEARER_IP_FAMILY_NONE;
+}
+
+/* Unquoted fields made of digits only which the lexer doesn't report as
+ * numbers are too big to fit in a guint */
+static gboolean
+token_is_overflowed_number (const MMAtToken *token)
+{
+    gsize i;
+
+    if (token->type != MM_AT_TOKEN_TYPE_WORD)
+        return FALSE;
+
+    for (i = 0; i < token->len; i++) {
+        if (!g_ascii_isdigit (token->str[i]))
+            return FALSE;
+    }
+    return TRUE;
+}
+
 GList *
 mm_3gpp_parse_cgdcont_read_response (const gchar *reply,
                                      GError **error)
 {
-    GError                *inner_error = NULL;
-    g_autoptr(GRegex)      r = NULL;
-    g_autoptr(GMatchInfo)  match_info = NULL;
-    GList                 *list = NULL;
+    MMAtLexer    lexer;
+    const gchar *line = reply;
+    GList       *list = NULL;
 
     if (!reply || !reply[0])
         /* No APNs configured, all done */
         return NULL;
 
-    r = g_regex_new ("\\+CGDCONT:\\s*(\\d+)\\s*,([^, \\)]*)\\s*,([^,\\s\\)]*)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, NULL);
-    g_assert (r);
+    while (mm_at_lexer_init_line (&lexer, &line, "+CGDCONT:")) {
+        MM3gppPdpContext *pdp;
+        MMAtToken         cid;
+        MMAtToken         pdp_type;
+        MMAtToken         apn;
+        MMBearerIpFamily  ip_family;
+
+        /* Lines without a numeric CID or without a known PDP type are
+         * ignored */
+        if (!mm_at_lexer_next (&lexer, &cid) ||
+            !mm_at_lexer_next (&lexer, &pdp_type))
+            continue;
 
-    g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &inner_error);
-    while (!inner_error && g_match_info_matches (match_info)) {
-        gchar *str;
-        MMBearerIpFamily ip_family;
-
-        str = mm_get_string_unquoted_from_match_info (match_info, 2);
-        ip_family = mm_3gpp_get_ip_family_from_pdp_type (str);
-        if (ip_family != MM_BEARER_IP_FAMILY_NONE) {
-            MM3gppPdpContext *pdp;
-
-            pdp = g_slice_new0 (MM3gppPdpContext);
-            list = g_list_prepend (list, pdp);
-
-            if (!mm_get_uint_from_match_info (match_info, 1, &pdp->cid)) {
-                inner_error = g_error_new (MM_CORE_ERROR,
-                                           MM_CORE_ERROR_FAILED,
-                                           "Couldn't parse CID from reply: '%s'",
-                                           reply);
-                break;
-            }
-            pdp->pdp_type = ip_family;
-            pdp->apn = mm_get_string_unquoted_from_match_info (match_info, 3);
-        }
+        ip_family = ip_family_from_pdp_type_token (&pdp_type);
+        if (ip_family == MM_BEARER_IP_FAMILY_NONE)
+            continue;
 
-        g_free (str);
-        g_match_info_next (match_info, &inner_error);
-    }
+        if (cid.type != MM_AT_TOKEN_TYPE_NUMBER) {
+            if (!token_is_overflowed_number (&cid))
+                continue;
+            mm_3gpp_pdp_context_list_free (list);
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Couldn't properly parse list of PDP contexts. "
+                         "Couldn't parse CID from reply: '%s'",
+                         reply);
+            return NULL;
+        }
 
-    if (inner_error) {
-        mm_3gpp_pdp_context_list_free (list);
-        g_propagate_error (error, inner_error);
-        g_prefix_error (error, "Couldn't properly parse list of PDP contexts. ");
-        return NULL;
+        pdp = g_slice_new0 (MM3gppPdpContext);
+        pdp->cid = cid.min;
+        pdp->pdp_type = ip_family;
+        if (mm_at_lexer_next (&lexer, &apn) &&
+            (apn.type != MM_AT_TOKEN_TYPE_EMPTY) &&
+            (apn.type != MM_AT_TOKEN_TYPE_GROUP)) {
+            pdp->apn = g_strstrip (mm_at_token_dup (&apn));
+            if (!pdp->apn[0])
+                g_clear_pointer (&pdp->apn, g_free);
+        }
+        list = g_list_prepend (list, pdp);
     }
 
     return g_list_sort (list, (GCompareFunc)mm_3gpp_pdp_context_cmp);
@@ -1957,53 +1994,50 @@ GList *
 mm_3gpp_parse_cgact_read_response (const gchar *reply,
                                    GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
-    g_autoptr(GMatchInfo)  match_info = NULL;
-    GError                *inner_error = NULL;
-    GList                 *list = NULL;
+    MMAtLexer    lexer;
+    const gchar *line = reply;
+    GList       *list = NULL;
 
     if (!reply || !reply[0])
         /* Nothing configured, all done */
         return NULL;
 
-    r = g_regex_new ("\\+CGACT:\\s*(\\d+),(\\d+)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, &inner_error);
-    g_assert (r);
-
-    g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &inner_error);
-    while (!inner_error && g_match_info_matches (match_info)) {
+    while (mm_at_lexer_init_line (&lexer, &line, "+CGACT:")) {
         MM3gppPdpContextActive *pdp_active;
-        guint cid = 0;
-        guint aux = 0;
+        MMAtToken               cid;
+        MMAtToken               status;
 
-        if (!mm_get_uint_from_match_info (match_info, 1, &cid)) {
-            inner_error = g_error_new (MM_CORE_ERROR,
-                                       MM_CORE_ERROR_FAILED,
-                                       "Couldn't parse CID from reply: '%s'",
-                                       reply);
-            break;
+        /* Lines without a numeric CID and status are ignored */
+        if (!mm_at_lexer_next (&lexer, &cid) ||
+            !mm_at_lexer_next (&lexer, &status))
+            continue;
+
+        if (token_is_overflowed_number (&cid)) {
+            mm_3gpp_pdp_context_active_list_free (list);
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Couldn't properly parse list of active/inactive PDP contexts. "
+                         "Couldn't parse CID from reply: '%s'",
+                         reply);
+            return NULL;
         }
-        if (!mm_get_uint_from_match_info (match_info, 2, &aux) || (aux != 0 && aux != 1)) {
-            inner_error = g_error_new (MM_CORE_ERROR,
-                                       MM_CORE_ERROR_FAILED,
-                                       "Couldn't parse context status from reply: '%s'",
-                                       reply);
-            break;
+
+        if (cid.type != MM_AT_TOKEN_TYPE_NUMBER ||
+            (status.type != MM_AT_TOKEN_TYPE_NUMBER && !token_is_overflowed_number (&status)))
+            continue;
+
+        if (status.type != MM_AT_TOKEN_TYPE_NUMBER || (status.min != 0 && status.min != 1)) {
+            mm_3gpp_pdp_context_active_list_free (list);
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Couldn't properly parse list of active/inactive PDP contexts. "
+                         "Couldn't parse context status from reply: '%s'",
+                         reply);
+            return NULL;
         }
 
         pdp_active = g_slice_new0 (MM3gppPdpContextActive);
-        pdp_active->cid = cid;
-        pdp_active->active = (gboolean) aux;
+        pdp_active->cid = cid.min;
+        pdp_active->active = (gboolean) status.min;
         list = g_list_prepend (list, pdp_active);
-
-        g_match_info_next (match_info, &inner_error);
-    }
-
-    if (inner_error) {
-        mm_3gpp_pdp_context_active_list_free (list);
-        g_propagate_error (error, inner_error);
-        g_prefix_error (error, "Couldn't properly parse list of active/inactive PDP contexts. ");
-        return NULL;
     }
 
     list = g_list_sort (list, (GCompareFunc) mm_3gpp_pdp_context_active_cmp);
@@ -2197,7 +2231,7 @@ mm_3gpp_parse_cmgf_test_response (const gchar *reply,
                                   gboolean *sms_text_supported,
                                   GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     gchar                 *s;
     guint32                min = -1;
@@ -2209,9 +2243,7 @@ mm_3gpp_parse_cmgf_test_response (const gchar *reply,
     while (isspace (*reply))
         reply++;
 
-    r = g_regex_new ("\\(?\\s*(\\d+)\\s*[-,]?\\s*(\\d+)?\\s*\\)?", 0, 0, error);
-    if (!r)
-        return FALSE;
+    r = mm_regex_registry_get ("\\(?\\s*(\\d+)\\s*[-,]?\\s*(\\d+)?\\s*\\)?", 0, 0);
 
     if (!g_regex_match (r, reply, 0, &match_info)) {
         g_set_error (error,
@@ -2248,7 +2280,7 @@ mm_3gpp_parse_cmgr_read_response (const gchar *reply,
                                   guint index,
                                   GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     gint                   count;
     gint                   status;
@@ -2257,8 +2289,7 @@ mm_3gpp_parse_cmgr_read_response (const gchar *reply,
 
     /* +CMGR: <stat>,<alpha>,<length>(whitespace)<pdu> */
     /* The <alpha> and <length> fields are matched, but not currently used */
-    r = g_regex_new ("\\+CMGR:\\s*(\\d+)\\s*,([^,]*),\\s*(\\d+)\\s*([^\\r\\n]*)", 0, 0, NULL);
-    g_assert (r);
+    r = mm_regex_registry_get ("\\+CMGR:\\s*(\\d+)\\s*,([^,]*),\\s*(\\d+)\\s*([^\\r\\n]*)", 0, 0);
 
     if (!g_regex_match (r, reply, 0, &match_info)) {
         g_set_error (error,
@@ -2317,7 +2348,7 @@ mm_3gpp_parse_crsm_response (const gchar *reply,
                              gchar **hex,
                              GError **error)
 {
-    g_autoptr(GRegex)     r = NULL;
+    GRegex               *r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
 
     g_assert (sw1 != NULL);
@@ -2333,9 +2364,8 @@ mm_3gpp_parse_crsm_response (const gchar *reply,
         return FALSE;
     }
 
-    r = g_regex_new ("\\+CRSM:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*\"?([0-9a-fA-F]+)\"?",
-                     G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CRSM:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*\"?([0-9a-fA-F]+)\"?",
+                               G_REGEX_RAW, 0);
 
     if (g_regex_match (r, reply, 0, &match_info) &&
         mm_get_uint_from_match_info (match_info, 1, sw1) &&
@@ -2363,14 +2393,13 @@ dots_to_v6_address (const gchar   *str,
                     gsize          len,
                     GError      **error)
 {
-    g_autoptr(GRegex)       r = NULL;
+    GRegex                 *r = NULL;
     g_autoptr(GMatchInfo)   match_info = NULL;
     guint                   i;
     g_autoptr(GString)      addr = NULL;
     g_autoptr(GInetAddress) normalized = NULL;
 
-    r = g_regex_new ("(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)\\.(\\d+)", 0, 0);
 
     if (!g_regex_match_full (r, str, len, 0, 0, &match_info, error))
         return NULL;
@@ -2551,7 +2580,7 @@ mm_3gpp_parse_cgcontrdp_response (const gchar  *response,
                                   gchar       **out_dns_secondary_address,
                                   GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     guint                  cid = 0;
@@ -2580,17 +2609,16 @@ mm_3gpp_parse_cgcontrdp_response (const gchar  *response,
      * The format of the response changed in TS 27.007 v9.4.0, we try to detect
      * both formats ('a' if >= v9.4.0, 'b' if < v9.4.0) with a single regex here.
      */
-    r = g_regex_new ("\\+CGCONTRDP: "
-                     "(\\d+),(\\d+),([^,]*)" /* cid, bearer id, apn */
-                     "(?:,([^,]*))?" /* (a)ip+mask        or (b)ip */
-                     "(?:,([^,]*))?" /* (a)gateway        or (b)mask */
-                     "(?:,([^,]*))?" /* (a)dns1           or (b)gateway */
-                     "(?:,([^,]*))?" /* (a)dns2           or (b)dns1 */
-                     "(?:,([^,]*))?" /* (a)p-cscf primary or (b)dns2 */
-                     "(?:,(.*))?"    /* others, ignored */
-                     "(?:\\r\\n)?",
-                     0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CGCONTRDP: "
+                               "(\\d+),(\\d+),([^,]*)" /* cid, bearer id, apn */
+                               "(?:,([^,]*))?" /* (a)ip+mask        or (b)ip */
+                               "(?:,([^,]*))?" /* (a)gateway        or (b)mask */
+                               "(?:,([^,]*))?" /* (a)dns1           or (b)gateway */
+                               "(?:,([^,]*))?" /* (a)dns2           or (b)dns1 */
+                               "(?:,([^,]*))?" /* (a)p-cscf primary or (b)dns2 */
+                               "(?:,(.*))?"    /* others, ignored */
+                               "(?:\\r\\n)?",
+                               0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error) {
@@ -2680,7 +2708,7 @@ mm_3gpp_parse_cfun_query_response (const gchar  *response,
                                    guint        *out_state,
                                    GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     guint                  state = G_MAXUINT;
@@ -2691,8 +2719,7 @@ mm_3gpp_parse_cfun_query_response (const gchar  *response,
      * +CFUN: 1,0
      *   ..but we don't care about the second number
      */
-    r = g_regex_new ("\\+CFUN: (\\d+)(?:,(?:\\d+))?(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CFUN: (\\d+)(?:,(?:\\d+))?(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -2734,7 +2761,7 @@ mm_3gpp_parse_cesq_response (const gchar  *response,
                              guint        *out_rsrp,
                              GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     guint                  rxlev = 99;
@@ -2755,8 +2782,7 @@ mm_3gpp_parse_cesq_response (const gchar  *response,
     /* Response may be e.g.:
      * +CESQ: 99,99,255,255,20,80
      */
-    r = g_regex_new ("\\+CESQ:\\s*(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CESQ:\\s*(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
@@ -2963,6 +2989,55 @@ mm_3gpp_cesq_response_to_signal_info (const gchar  *response,
     return TRUE;
 }
 
+/*****************************************************************************/
+
+static gboolean
+signal_value_changed (gdouble previous,
+                      gdouble current,
+                      guint   threshold)
+{
+    if (previous == MM_SIGNAL_UNKNOWN && current == MM_SIGNAL_UNKNOWN)
+        return FALSE;
+    if (previous == MM_SIGNAL_UNKNOWN || current == MM_SIGNAL_UNKNOWN)
+        return TRUE;
+    return (fabs (current - previous) >= (gdouble) threshold);
+}
+
+gboolean
+mm_signal_threshold_crossed (MMSignal *previous,
+                             MMSignal *current,
+                             guint     rssi_threshold,
+                             guint     sinr_threshold,
+                             gboolean  error_rate_threshold)
+{
+    /* RAT appeared or disappeared */
+    if (!previous != !current)
+        return TRUE;
+    if (!current)
+        return FALSE;
+
+    /* The RSSI threshold applies to all power levels (RSSI, RSCP, RSRP), all
+     * of them given in dBm. The signal to noise ratios (SINR, SNR) are given
+     * in dB and have their own threshold, only used along with the RSSI one */
+    if (rssi_threshold) {
+        if (signal_value_changed (mm_signal_get_rssi (previous), mm_signal_get_rssi (current), rssi_threshold) ||
+            signal_value_changed (mm_signal_get_rscp (previous), mm_signal_get_rscp (current), rssi_threshold) ||
+            signal_value_changed (mm_signal_get_rsrp (previous), mm_signal_get_rsrp (current), rssi_threshold))
+            return TRUE;
+        if (sinr_threshold &&
+            (signal_value_changed (mm_signal_get_sinr (previous), mm_signal_get_sinr (current), sinr_threshold) ||
+             signal_value_changed (mm_signal_get_snr  (previous), mm_signal_get_snr  (current), sinr_threshold)))
+            return TRUE;
+    }
+
+    /* Any change in the error rate is reported */
+    if (error_rate_threshold &&
+        mm_signal_get_error_rate (previous) != mm_signal_get_error_rate (current))
+        return TRUE;
+
+    return FALSE;
+}
+
 gboolean
 mm_3gpp_parse_cfun_query_generic_response (const gchar        *response,
                                            MMModemPowerState  *out_state,
@@ -3044,7 +3119,7 @@ mm_3gpp_parse_ccwa_service_query_response (const gchar  *response,
                                            gboolean     *status,
                                            GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     gint                   class_1_status = -1;
@@ -3060,11 +3135,9 @@ mm_3gpp_parse_ccwa_service_query_response (const gchar  *response,
      *
      * We're only interested in class 1 (voice)
      */
-    r = g_regex_new ("\\+CCWA:\\s*(\\d+),\\s*(\\d+)$",
-                     G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
-                     G_REGEX_MATCH_NEWLINE_CRLF,
-                     NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CCWA:\\s*(\\d+),\\s*(\\d+)$",
+                               G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
+                               G_REGEX_MATCH_NEWLINE_CRLF);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -3119,7 +3192,7 @@ out:
 GArray *
 mm_3gpp_parse_cscb_response (const char *response, GError **error)
 {
-    g_autoptr(GRegex) r = NULL;
+    GRegex           *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError *inner_error = NULL;
     gsize len;
@@ -3137,14 +3210,12 @@ mm_3gpp_parse_cscb_response (const char *response, GError **error)
     /*
      * AT+CSCB=[0|1],"<channels>","<coding-scheme>"
      */
-    r = g_regex_new ("\\+CSCB:\\s*"
-                     "(\\d),\\s*"         /* [0|1] */
-                     "\"([\\d,\\-]*)\","  /* channel list */
-                     "\"\"",              /* encodings */
-                     G_REGEX_NEWLINE_CRLF,
-                     0,
-                     NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CSCB:\\s*"
+                               "(\\d),\\s*"         /* [0|1] */
+                               "\"([\\d,\\-]*)\","  /* channel list */
+                               "\"\"",              /* encodings */
+                               G_REGEX_NEWLINE_CRLF,
+                               0);
 
     g_regex_match_full (r, response, -1, 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -3242,24 +3313,58 @@ mm_3gpp_build_cgatt_set_request (MMModem3gppPacketServiceState state)
 
 /*************************************************************************/
 
+#define N_EXPECTED_CPMS_GROUPS 3
+
+static const struct {
+    const gchar  *str;
+    MMSmsStorage  storage;
+} storages[] = {
+    { "SM", MM_SMS_STORAGE_SM },
+    { "ME", MM_SMS_STORAGE_ME },
+    { "MT", MM_SMS_STORAGE_MT },
+    { "SR", MM_SMS_STORAGE_SR },
+    { "BM", MM_SMS_STORAGE_BM },
+    { "TA", MM_SMS_STORAGE_TA },
+};
+
 static MMSmsStorage
 storage_from_str (const gchar *str)
 {
-    if (g_str_equal (str, "SM"))
-        return MM_SMS_STORAGE_SM;
-    if (g_str_equal (str, "ME"))
-        return MM_SMS_STORAGE_ME;
-    if (g_str_equal (str, "MT"))
-        return MM_SMS_STORAGE_MT;
-    if (g_str_equal (str, "SR"))
-        return MM_SMS_STORAGE_SR;
-    if (g_str_equal (str, "BM"))
-        return MM_SMS_STORAGE_BM;
-    if (g_str_equal (str, "TA"))
-        return MM_SMS_STORAGE_TA;
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (storages); i++) {
+        if (g_str_equal (str, storages[i].str))
+            return storages[i].storage;
+    }
+    return MM_SMS_STORAGE_UNKNOWN;
+}
+
+static MMSmsStorage
+storage_from_token (const MMAtToken *token)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (storages); i++) {
+        if (mm_at_token_equal (token, storages[i].str))
+            return storages[i].storage;
+    }
     return MM_SMS_STORAGE_UNKNOWN;
 }
 
+static void
+storage_array_add_token (GArray          *array,
+                         const MMAtToken *token)
+{
+    MMSmsStorage storage;
+
+    /* Only quoted storage names are expected */
+    if (token->type != MM_AT_TOKEN_TYPE_STRING || !token->len)
+        return;
+
+    storage = storage_from_token (token);
+    g_array_append_val (array, storage);
+}
+
 gboolean
 mm_3gpp_parse_cpms_test_response (const gchar  *reply,
                                   GArray      **mem1,
@@ -3267,86 +3372,60 @@ mm_3gpp_parse_cpms_test_response (const gchar  *reply,
                                   GArray      **mem3,
                                   GError      **error)
 {
-    guint i;
-    g_autoptr(GRegex) r = NULL;
-    g_autoptr(GArray) tmp1 = NULL;
-    g_autoptr(GArray) tmp2 = NULL;
-    g_autoptr(GArray) tmp3 = NULL;
-    g_auto(GStrv)     split = NULL;
+    GArray    *mems[N_EXPECTED_CPMS_GROUPS] = { NULL };
+    MMAtLexer  lexer;
+    MMAtToken  token;
+    guint      n_groups;
+    guint      i;
 
     g_assert (mem1 != NULL);
     g_assert (mem2 != NULL);
     g_assert (mem3 != NULL);
 
-#define N_EXPECTED_GROUPS 3
-
-    split = mm_split_string_groups (mm_strip_tag (reply, "+CPMS:"));
-    if (!split) {
+    if (!reply) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                      "Couldn't split +CPMS test response in groups");
         return FALSE;
     }
 
-    if (g_strv_length (split) != N_EXPECTED_GROUPS) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "Cannot parse +CPMS test response: invalid number of groups (%u != %u)",
-                     g_strv_length (split), N_EXPECTED_GROUPS);
-        return FALSE;
-    }
-
-    r = g_regex_new ("\\s*\"([^,\\)]+)\"\\s*", 0, 0, NULL);
-    g_assert (r);
-
-    for (i = 0; i < N_EXPECTED_GROUPS; i++) {
-        g_autoptr(GMatchInfo)  match_info = NULL;
-        GArray                *array;
+    /* Each group may be a list of storages, or a single storage, e.g.:
+     *   +CPMS: ("ME","MT"),("ME","SM","MT"),("SM","MT")
+     *   +CPMS: "ME","MT","SM"
+     */
+    mm_at_lexer_init (&lexer, mm_strip_tag (reply, "+CPMS:"), -1);
+    for (n_groups = 0; mm_at_lexer_next (&lexer, &token); n_groups++) {
+        if (n_groups >= N_EXPECTED_CPMS_GROUPS)
+            continue;
 
         /* We always return a valid array, even if it may be empty */
-        array = g_array_new (FALSE, FALSE, sizeof (MMSmsStorage));
-
-        /* Got a range group to match */
-        if (g_regex_match (r, split[i], 0, &match_info)) {
-            while (g_match_info_matches (match_info)) {
-                gchar *str;
+        mems[n_groups] = g_array_new (FALSE, FALSE, sizeof (MMSmsStorage));
 
-                str = g_match_info_fetch (match_info, 1);
-                if (str) {
-                    MMSmsStorage storage;
-
-                    storage = storage_from_str (str);
-                    g_array_append_val (array, storage);
-                    g_free (str);
-                }
+        if (token.type == MM_AT_TOKEN_TYPE_GROUP) {
+            MMAtLexer group;
+            MMAtToken item;
 
-                g_match_info_next (match_info, NULL);
-            }
-        }
-
-        if (!tmp1)
-            tmp1 = array;
-        else if (!tmp2)
-            tmp2 = array;
-        else if (!tmp3)
-            tmp3 = array;
-        else
-            g_assert_not_reached ();
+            mm_at_lexer_init_group (&group, &token);
+            while (mm_at_lexer_next (&group, &item))
+                storage_array_add_token (mems[n_groups], &item);
+        } else
+            storage_array_add_token (mems[n_groups], &token);
     }
 
-    /* Only return TRUE if all sets have been parsed correctly
-     * (even if the arrays may be empty) */
-    if (tmp1 && tmp2 && tmp3) {
-        *mem1 = g_steal_pointer (&tmp1);
-        *mem2 = g_steal_pointer (&tmp2);
-        *mem3 = g_steal_pointer (&tmp3);
-        return TRUE;
+    if (n_groups != N_EXPECTED_CPMS_GROUPS) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Cannot parse +CPMS test response: invalid number of groups (%u != %u)",
+                     n_groups, N_EXPECTED_CPMS_GROUPS);
+        for (i = 0; i < N_EXPECTED_CPMS_GROUPS; i++) {
+            if (mems[i])
+                g_array_unref (mems[i]);
+        }
+        return FALSE;
     }
 
-    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                 "Cannot parse +CPMS test response: mem1 %s, mem2 %s, mem3 %s",
-                 tmp1 ? "yes" : "no",
-                 tmp2 ? "yes" : "no",
-                 tmp3 ? "yes" : "no");
-    return FALSE;
+    *mem1 = mems[0];
+    *mem2 = mems[1];
+    *mem3 = mems[2];
+    return TRUE;
 }
 
 /**********************************************************************
@@ -3362,11 +3441,10 @@ mm_3gpp_parse_cpms_query_response (const gchar *reply,
                                    MMSmsStorage *memw,
                                    GError **error)
 {
-    g_autoptr(GRegex)     r = NULL;
+    GRegex               *r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
 
-    r = g_regex_new (CPMS_QUERY_REGEX, G_REGEX_RAW, 0, NULL);
-    g_assert (r);
+    r = mm_regex_registry_get (CPMS_QUERY_REGEX, G_REGEX_RAW, 0);
 
     if (!g_regex_match (r, reply, 0, &match_info)) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
@@ -3418,7 +3496,7 @@ gboolean
 mm_3gpp_parse_cscs_test_response (const gchar *reply,
                                   MMModemCharset *out_charsets)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     MMModemCharset         charsets = MM_MODEM_CHARSET_UNKNOWN;
     gchar                 *p;
@@ -3444,8 +3522,7 @@ mm_3gpp_parse_cscs_test_response (const gchar *reply,
     }
 
     /* Now parse each charset */
-    r = g_regex_new ("\\s*([^,\\)]+)\\s*", 0, 0, NULL);
-    g_assert (r);
+    r = mm_regex_registry_get ("\\s*([^,\\)]+)\\s*", 0, 0);
 
     if (g_regex_match (r, p, 0, &match_info)) {
         while (g_match_info_matches (match_info)) {
@@ -3470,7 +3547,7 @@ gboolean
 mm_3gpp_parse_clck_test_response (const gchar *reply,
                                   MMModem3gppFacility *out_facilities)
 {
-    g_autoptr(GRegex)     r = NULL;
+    GRegex               *r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
 
     g_return_val_if_fail (reply != NULL, FALSE);
@@ -3483,8 +3560,7 @@ mm_3gpp_parse_clck_test_response (const gchar *reply,
     reply = mm_strip_tag (reply, "+CLCK:");
 
     /* Now parse each facility */
-    r = g_regex_new ("\\s*\"([^,\\)]+)\"\\s*", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\s*\"([^,\\)]+)\"\\s*", 0, 0);
 
     *out_facilities = MM_MODEM_3GPP_FACILITY_NONE;
     if (g_regex_match (r, reply, 0, &match_info)) {
@@ -3510,7 +3586,7 @@ gboolean
 mm_3gpp_parse_clck_write_response (const gchar *reply,
                                    gboolean *enabled)
 {
-    g_autoptr(GRegex)     r = NULL;
+    GRegex               *r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
 
     g_return_val_if_fail (reply != NULL, FALSE);
@@ -3518,8 +3594,7 @@ mm_3gpp_parse_clck_write_response (const gchar *reply,
 
     reply = mm_strip_tag (reply, "+CLCK:");
 
-    r = g_regex_new ("\\s*([01])\\s*", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\s*([01])\\s*", 0, 0);
 
     if (g_regex_match (r, reply, 0, &match_info)) {
         g_autofree gchar *str = NULL;
@@ -3547,16 +3622,15 @@ GStrv
 mm_3gpp_parse_cnum_exec_response (const gchar *reply)
 {
     g_autoptr(GPtrArray)  array = NULL;
-    g_autoptr(GRegex)     r = NULL;
+    GRegex               *r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
 
     /* Empty strings also return NULL list */
     if (!reply || !reply[0])
         return NULL;
 
-    r = g_regex_new ("\\+CNUM:\\s*((\"([^\"]|(\\\"))*\")|([^,]*)),\"(?<num>\\S+)\",\\d",
-                     G_REGEX_UNGREEDY, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CNUM:\\s*((\"([^\"]|(\\\"))*\")|([^,]*)),\"(?<num>\\S+)\",\\d",
+                               G_REGEX_UNGREEDY, 0);
 
     array = g_ptr_array_new ();
     g_regex_match (r, reply, 0, &match_info);
@@ -3767,48 +3841,61 @@ GHashTable *
 mm_3gpp_parse_cind_test_response (const gchar *reply,
                                   GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
-    g_autoptr(GMatchInfo)  match_info = NULL;
-    GHashTable            *hash;
-    guint                  idx = 1;
+    GHashTable *hash;
+    MMAtLexer   lexer;
+    MMAtToken   indicator;
+    guint       idx = 1;
 
     g_return_val_if_fail (reply != NULL, NULL);
 
-    /* Strip whitespace and response tag */
+    /* Strip response tag */
     if (g_str_has_prefix (reply, CIND_TAG))
         reply += strlen (CIND_TAG);
-    while (isspace (*reply))
-        reply++;
-
-    r = g_regex_new ("\\(([^,]*),\\((\\d+)[-,](\\d+).*\\)", G_REGEX_UNGREEDY, 0, NULL);
-    g_assert (r);
 
     hash = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) cind_response_free);
 
-    if (g_regex_match (r, reply, 0, &match_info)) {
-        while (g_match_info_matches (match_info)) {
-            MM3gppCindResponse *resp;
-            gchar *desc, *tmp;
-            gint min = 0, max = 0;
-
-            desc = g_match_info_fetch (match_info, 1);
-
-            tmp = g_match_info_fetch (match_info, 2);
-            min = atoi (tmp);
-            g_free (tmp);
-
-            tmp = g_match_info_fetch (match_info, 3);
-            max = atoi (tmp);
-            g_free (tmp);
+    /* Each indicator is given as a group with its description and the list
+     * or range of values it supports, e.g.:
+     *   ("battchg",(0-5)),("service",(0,1))
+     */
+    mm_at_lexer_init (&lexer, reply, -1);
+    while (mm_at_lexer_next (&lexer, &indicator)) {
+        MM3gppCindResponse *resp;
+        g_autofree gchar   *desc_str = NULL;
+        MMAtLexer           fields;
+        MMAtLexer           values;
+        MMAtToken           desc;
+        MMAtToken           range;
+        MMAtToken           value;
+        guint               min;
+        guint               max;
+
+        if (indicator.type != MM_AT_TOKEN_TYPE_GROUP)
+            continue;
 
-            resp = cind_response_new (desc, idx++, min, max);
-            if (resp)
-                g_hash_table_insert (hash, g_strdup (resp->desc), resp);
+        mm_at_lexer_init_group (&fields, &indicator);
+        if (!mm_at_lexer_next (&fields, &desc) ||
+            desc.type == MM_AT_TOKEN_TYPE_EMPTY ||
+            !mm_at_lexer_next (&fields, &range) ||
+            range.type != MM_AT_TOKEN_TYPE_GROUP)
+            continue;
 
-            g_free (desc);
+        mm_at_lexer_init_group (&values, &range);
+        if (!mm_at_lexer_next (&values, &value) ||
+            (value.type != MM_AT_TOKEN_TYPE_NUMBER && value.type != MM_AT_TOKEN_TYPE_RANGE))
+            continue;
 
-            g_match_info_next (match_info, NULL);
+        min = value.min;
+        max = value.max;
+        while (mm_at_lexer_next (&values, &value)) {
+            if (value.type == MM_AT_TOKEN_TYPE_NUMBER || value.type == MM_AT_TOKEN_TYPE_RANGE)
+                max = MAX (max, value.max);
         }
+
+        desc_str = mm_at_token_dup (&desc);
+        resp = cind_response_new (desc_str, idx++, (gint) min, (gint) max);
+        if (resp)
+            g_hash_table_insert (hash, g_strdup (resp->desc), resp);
     }
 
     return hash;
@@ -3820,7 +3907,7 @@ GByteArray *
 mm_3gpp_parse_cind_read_response (const gchar *reply,
                                   GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GByteArray            *array = NULL;
     GError                *inner_error = NULL;
@@ -3837,8 +3924,7 @@ mm_3gpp_parse_cind_read_response (const gchar *reply,
 
     reply = mm_strip_tag (reply, CIND_TAG);
 
-    r = g_regex_new ("(\\d+)[^0-9]+", G_REGEX_UNGREEDY, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("(\\d+)[^0-9]+", G_REGEX_UNGREEDY, 0);
 
     if (!g_regex_match (r, reply, 0, &match_info)) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
@@ -4060,7 +4146,7 @@ mm_3gpp_parse_cgev_indication_pdp (const gchar  *str,
                                    guint        *out_cid,
                                    GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     g_autofree gchar      *pdp_type = NULL;
@@ -4072,12 +4158,11 @@ mm_3gpp_parse_cgev_indication_pdp (const gchar  *str,
               type == MM_3GPP_CGEV_NW_DEACT_PDP ||
               type == MM_3GPP_CGEV_ME_DEACT_PDP);
 
-    r = g_regex_new ("(?:"
-                     "REJECT|"
-                     "NW REACT|"
-                     "NW DEACT|ME DEACT"
-                     ")\\s*([^,]*),\\s*([^,]*)(?:,\\s*([0-9]+))?", 0, 0, NULL);
-    g_assert (r);
+    r = mm_regex_registry_get ("(?:"
+                               "REJECT|"
+                               "NW REACT|"
+                               "NW DEACT|ME DEACT"
+                               ")\\s*([^,]*),\\s*([^,]*)(?:,\\s*([0-9]+))?", 0, 0);
 
     str = mm_strip_tag (str, "+CGEV:");
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
@@ -4137,7 +4222,7 @@ mm_3gpp_parse_cgev_indication_primary (const gchar  *str,
                                        guint        *out_cid,
                                        GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     guint                  cid = 0;
@@ -4147,10 +4232,10 @@ mm_3gpp_parse_cgev_indication_primary (const gchar  *str,
               (type == MM_3GPP_CGEV_NW_DEACT_PRIMARY) ||
               (type == MM_3GPP_CGEV_ME_DEACT_PRIMARY));
 
-    r = g_regex_new ("(?:"
-                     "NW PDN ACT|ME PDN ACT|"
-                     "NW PDN DEACT|ME PDN DEACT|"
-                     ")\\s*([0-9]+)", 0, 0, NULL);
+    r = mm_regex_registry_get ("(?:"
+                               "NW PDN ACT|ME PDN ACT|"
+                               "NW PDN DEACT|ME PDN DEACT|"
+                               ")\\s*([0-9]+)", 0, 0);
 
     str = mm_strip_tag (str, "+CGEV:");
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
@@ -4192,7 +4277,7 @@ mm_3gpp_parse_cgev_indication_secondary (const gchar  *str,
                                          guint        *out_event_type,
                                          GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     guint                  p_cid = 0;
@@ -4204,10 +4289,10 @@ mm_3gpp_parse_cgev_indication_secondary (const gchar  *str,
               type == MM_3GPP_CGEV_NW_DEACT_SECONDARY ||
               type == MM_3GPP_CGEV_ME_DEACT_SECONDARY);
 
-    r = g_regex_new ("(?:"
-                     "NW ACT|ME ACT|"
-                     "NW DEACT|ME DEACT"
-                     ")\\s*([0-9]+),\\s*([0-9]+),\\s*([0-9]+)", 0, 0, NULL);
+    r = mm_regex_registry_get ("(?:"
+                               "NW ACT|ME ACT|"
+                               "NW DEACT|ME DEACT"
+                               ")\\s*([0-9]+),\\s*([0-9]+),\\s*([0-9]+)", 0, 0);
 
     str = mm_strip_tag (str, "+CGEV:");
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
@@ -4268,7 +4353,7 @@ GList *
 mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
                                  GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     GList                 *list = NULL;
@@ -4280,9 +4365,8 @@ mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
      *
      * We just read <index>, <stat> and the PDU itself.
      */
-    r = g_regex_new ("\\+CMGL:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,(.*)\\r\\n([^\\r\\n]*)(\\r\\n)?",
-                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CMGL:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,(.*)\\r\\n([^\\r\\n]*)(\\r\\n)?",
+                               G_REGEX_RAW, 0);
 
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
     while (!inner_error && g_match_info_matches (match_info)) {
@@ -4500,18 +4584,15 @@ mm_3gpp_get_pdp_type_from_ip_family (MMBearerIpFamily family)
 MMBearerIpFamily
 mm_3gpp_get_ip_family_from_pdp_type (const gchar *pdp_type)
 {
+    guint i;
+
     if (!pdp_type)
         return MM_BEARER_IP_FAMILY_NONE;
-    if (g_str_equal (pdp_type, "IP"))
-        return MM_BEARER_IP_FAMILY_IPV4;
-    if (g_str_equal (pdp_type, "IPV4"))
-        return MM_BEARER_IP_FAMILY_IPV4;
-    if (g_str_equal (pdp_type, "IPV6"))
-        return MM_BEARER_IP_FAMILY_IPV6;
-    if (g_str_equal (pdp_type, "IPV4V6"))
-        return MM_BEARER_IP_FAMILY_IPV4V6;
-    if (g_str_equal (pdp_type, "Non-IP"))
-        return MM_BEARER_IP_FAMILY_NON_IP;
+
+    for (i = 0; i < G_N_ELEMENTS (pdp_types); i++) {
+        if (g_str_equal (pdp_type, pdp_types[i].str))
+            return pdp_types[i].ip_family;
+    }
     return MM_BEARER_IP_FAMILY_NONE;
 }
 
@@ -5048,7 +5129,7 @@ mm_cdma_parse_crm_test_response (const gchar *reply,
                                  MMModemCdmaRmProtocol *max,
                                  GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     gboolean               result = FALSE;
     GError                *match_error = NULL;
@@ -5058,10 +5139,9 @@ mm_cdma_parse_crm_test_response (const gchar *reply,
      *   <--- +CRM: (0-2)
      */
 
-    r = g_regex_new ("\\+CRM:\\s*\\((\\d+)-(\\d+)\\)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, error);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CRM:\\s*\\((\\d+)-(\\d+)\\)",
+                               G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                               0);
 
     if (g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &match_error)) {
         gchar *aux;
@@ -5321,6 +5401,25 @@ mm_parse_gsn (const char *gsn,
     return success;
 }
 
+/*************************************************************************/
+
+gboolean
+mm_equipment_identifier_equal (const gchar *a,
+                               const gchar *b)
+{
+    g_autofree gchar *a_stripped = NULL;
+    g_autofree gchar *b_stripped = NULL;
+
+    if (!a || !b)
+        return (a == b);
+
+    /* Identifiers given in hex (ESN, MEID) may be reported with different
+     * case by different ports or protocols */
+    a_stripped = g_strstrip (g_strdup (a));
+    b_stripped = g_strstrip (g_strdup (b));
+    return (g_ascii_strcasecmp (a_stripped, b_stripped) == 0);
+}
+
 /*****************************************************************************/
 /* +CCLK response parser */
 
@@ -5330,7 +5429,7 @@ mm_parse_cclk_response (const char *response,
                         MMNetworkTimezone **tzp,
                         GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *match_error = NULL;
     guint                  year = 0;
@@ -5347,8 +5446,7 @@ mm_parse_cclk_response (const char *response,
      *  +CCLK: "15/03/05,14:14:26-32"
      *  +CCLK: 17/07/26,11:42:15+01
      */
-    r = g_regex_new ("\\+CCLK:\\s*\"?(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d+)([-+]\\d+)?\"?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CCLK:\\s*\"?(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d+)([-+]\\d+)?\"?", 0, 0);
 
     if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
@@ -5428,14 +5526,14 @@ gint
 mm_parse_csim_response (const gchar *response,
                               GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     g_autofree gchar      *str_code = NULL;
     gint                   retries = -1;
     guint                  hex_code;
     GError                *inner_error = NULL;
 
-    r = g_regex_new ("\\+CSIM:\\s*[0-9]+,\\s*\".*([0-9a-fA-F]{4})\"", G_REGEX_RAW, 0, NULL);
+    r = mm_regex_registry_get ("\\+CSIM:\\s*[0-9]+,\\s*\".*([0-9a-fA-F]{4})\"", G_REGEX_RAW, 0);
     g_regex_match (r, response, 0, &match_info);
 
     if (!g_match_info_matches (match_info)) {
@@ -5624,19 +5722,19 @@ mm_sim_parse_cpol_query_response (const gchar  *response,
                                   GError      **error)
 {
     g_autoptr(GMatchInfo)  match_info = NULL;
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autofree gchar      *operator_code = NULL;
     guint                  format = 0;
     guint                  act = 0;
     guint                  match_count;
 
-    r = g_regex_new ("\\+CPOL:\\s*(\\d+),\\s*(\\d+),\\s*\"?(\\d+)\"?"
-                     "(?:,\\s*(\\d+))?"     /* GSM_AcTn */
-                     "(?:,\\s*(\\d+))?"     /* GSM_Compact_AcTn */
-                     "(?:,\\s*(\\d+))?"     /* UTRAN_AcTn */
-                     "(?:,\\s*(\\d+))?"     /* E-UTRAN_AcTn */
-                     "(?:,\\s*(\\d+))?",    /* NG-RAN_AcTn */
-                     G_REGEX_RAW, 0, NULL);
+    r = mm_regex_registry_get ("\\+CPOL:\\s*(\\d+),\\s*(\\d+),\\s*\"?(\\d+)\"?"
+                               "(?:,\\s*(\\d+))?"     /* GSM_AcTn */
+                               "(?:,\\s*(\\d+))?"     /* GSM_Compact_AcTn */
+                               "(?:,\\s*(\\d+))?"     /* UTRAN_AcTn */
+                               "(?:,\\s*(\\d+))?"     /* E-UTRAN_AcTn */
+                               "(?:,\\s*(\\d+))?",    /* NG-RAN_AcTn */
+                               G_REGEX_RAW, 0);
     g_regex_match (r, response, 0, &match_info);
 
     if (!g_match_info_matches (match_info)) {
@@ -5712,13 +5810,13 @@ mm_sim_parse_cpol_test_response (const gchar  *response,
                                  GError      **error)
 {
     g_autoptr(GMatchInfo)  match_info = NULL;
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     guint                  match_count;
     guint                  min_index;
     guint                  max_index;
 
-    r = g_regex_new ("\\+CPOL:\\s*\\((\\d+)\\s*-\\s*(\\d+)\\)",
-                     G_REGEX_RAW, 0, NULL);
+    r = mm_regex_registry_get ("\\+CPOL:\\s*\\((\\d+)\\s*-\\s*(\\d+)\\)",
+                               G_REGEX_RAW, 0);
     g_regex_match (r, response, 0, &match_info);
 
     if (!g_match_info_matches (match_info)) {
@@ -5750,6 +5848,81 @@ mm_sim_parse_cpol_test_response (const gchar  *response,
     return TRUE;
 }
 
+/*************************************************************************/
+
+static gboolean
+preferred_network_equal (const MMSimPreferredNetwork *a,
+                         const MMSimPreferredNetwork *b)
+{
+    return (g_strcmp0 (mm_sim_preferred_network_get_operator_code (a),
+                       mm_sim_preferred_network_get_operator_code (b)) == 0 &&
+            mm_sim_preferred_network_get_access_technology (a) ==
+            mm_sim_preferred_network_get_access_technology (b));
+}
+
+void
+mm_sim_preferred_networks_diff (GPtrArray *old_networks,
+                                GList     *new_networks,
+                                GArray    *out_clear_index,
+                                GArray    *out_write_index)
+{
+    g_autofree MMSimPreferredNetwork **new_array = NULL;
+    guint                              n_new;
+    guint                              first_rewrite;
+    guint                              i;
+    guint                              j;
+    GList                             *l;
+
+    n_new = g_list_length (new_networks);
+    new_array = g_new0 (MMSimPreferredNetwork *, n_new + 1);
+    for (l = new_networks, j = 0; l; l = g_list_next (l), j++)
+        new_array[j] = l->data;
+
+    /* A network moved to a different position can't be written while the
+     * old entry is still in the SIM, as some modems reject duplicates. The
+     * old entries holding a network found elsewhere in the new list must
+     * therefore be cleared before writing. And as some modems (e.g. u-blox)
+     * shift up the entries following a cleared one, all the entries from the
+     * first one cleared onwards are cleared and written again. */
+    first_rewrite = n_new;
+    for (i = 0; i < MIN (old_networks->len, n_new) && first_rewrite == n_new; i++) {
+        MMSimPreferredNetwork *old;
+
+        old = g_ptr_array_index (old_networks, i);
+        if (!old || preferred_network_equal (old, new_array[i]))
+            continue;
+
+        for (j = 0; j < n_new; j++) {
+            if (j != i &&
+                g_strcmp0 (mm_sim_preferred_network_get_operator_code (old),
+                           mm_sim_preferred_network_get_operator_code (new_array[j])) == 0) {
+                first_rewrite = i;
+                break;
+            }
+        }
+    }
+
+    /* Entries beyond the end of the new list are always cleared */
+    for (i = 0; i < old_networks->len; i++) {
+        guint index;
+
+        if (!g_ptr_array_index (old_networks, i) || i < first_rewrite)
+            continue;
+        index = i + 1;
+        g_array_append_val (out_clear_index, index);
+    }
+
+    /* Entries already holding the same network are left untouched */
+    for (j = 0; j < n_new; j++) {
+        MMSimPreferredNetwork *old = NULL;
+
+        if (j < old_networks->len)
+            old = g_ptr_array_index (old_networks, j);
+        if (j >= first_rewrite || !old || !preferred_network_equal (old, new_array[j]))
+            g_array_append_val (out_write_index, j);
+    }
+}
+
 gchar *
 mm_sim_convert_spn_to_utf8 (const guint8  *bin,
                             gsize          binlen,
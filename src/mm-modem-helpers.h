@@ -164,11 +164,22 @@ typedef struct {
     MMModemAccessTechnology access_tech;
 } MM3gppNetworkInfo;
 void mm_3gpp_network_info_list_free (GList *info_list);
+/* Takes ownership of @info_list, and returns the networks in it that have an
+ * operator code and aren't already in @known_list, in the same order. The
+ * same network is identified by its access technology and operator code. */
+GList *mm_3gpp_network_info_list_filter_new (GList *known_list,
+                                             GList *info_list);
 GList *mm_3gpp_parse_cops_test_response (const gchar     *reply,
                                          MMModemCharset   cur_charset,
                                          gpointer         log_object,
                                          GError         **error);
 
+/* Passes of an incremental network scan: one per access technology in
+ * @supported and @allowed, newest first, or a single pass with @allowed if
+ * there is none. Returns an array of MMModemMode values. */
+GArray *mm_3gpp_build_incremental_scan_passes (MMModemMode supported,
+                                               MMModemMode allowed);
+
 /* AT+COPS? (current operator) response parser */
 gboolean mm_3gpp_parse_cops_read_response (const gchar              *response,
                                            guint                    *out_mode,
@@ -425,6 +436,14 @@ gboolean mm_3gpp_cesq_response_to_signal_info (const gchar  *response,
                                                MMSignal    **out_lte,
                                                GError      **error);
 
+/* Whether the change between two signal samples of the same RAT crosses any
+ * of the given thresholds; NULL samples mean the RAT is not available */
+gboolean mm_signal_threshold_crossed (MMSignal *previous,
+                                      MMSignal *current,
+                                      guint     rssi_threshold,
+                                      guint     sinr_threshold,
+                                      gboolean  error_rate_threshold);
+
 /* CEMODE? response parser */
 gchar    *mm_3gpp_build_cemode_set_request    (MMModem3gppEpsUeModeOperation   mode);
 gboolean  mm_3gpp_parse_cemode_query_response (const gchar                    *response,
@@ -555,6 +574,10 @@ gboolean mm_parse_gsn (const char *gsn,
                        gchar **out_meid,
                        gchar **out_esn);
 
+/* Whether two equipment identifiers (IMEI, ESN, MEID) identify the same device */
+gboolean mm_equipment_identifier_equal (const gchar *a,
+                                        const gchar *b);
+
 /* +CCLK response parser */
 gboolean mm_parse_cclk_response (const gchar *response,
                                  gchar **iso8601p,
@@ -602,6 +625,15 @@ gboolean mm_sim_parse_cpol_test_response (const gchar  *response,
                                           guint        *out_max_index,
                                           GError      **error);
 
+/* Computes the AT+CPOL operations needed to replace the preferred networks
+ * stored in the SIM (@old_networks, by position, NULL for empty entries)
+ * with @new_networks: the AT+CPOL indices to clear, in ascending order, and
+ * the positions in @new_networks to write once cleared. */
+void mm_sim_preferred_networks_diff (GPtrArray *old_networks,
+                                     GList     *new_networks,
+                                     GArray    *out_clear_index,
+                                     GArray    *out_write_index);
+
 /* Parse operator name and mnc length */
 gchar *mm_sim_convert_spn_to_utf8 (const guint8  *bin,
                                    gsize          len,
@@ -0,0 +1,202 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <string.h>
+
+#include "mm-perf-stats.h"
+#include "mm-log.h"
+
+gboolean mm_perf_stats_enabled_flag;
+
+static const guint latency_buckets_ms[] = { MM_PERF_STATS_LATENCY_BUCKETS_MS };
+
+G_STATIC_ASSERT (G_N_ELEMENTS (latency_buckets_ms) + 1 == MM_PERF_STATS_N_LATENCY_BUCKETS);
+
+struct _MMPerfStat {
+    gchar    *key; /* "group/name" */
+    gboolean  histogram;
+    guint64   value;
+    guint64   buckets[MM_PERF_STATS_N_LATENCY_BUCKETS];
+};
+
+/* Group name to table of counters in the group, keyed by name. Counters are
+ * never freed, as callers may keep references to them. */
+static GHashTable *groups;
+/* All counters, in creation order */
+static GPtrArray  *all_stats;
+
+/*****************************************************************************/
+
+void
+mm_perf_stats_set_enabled (gboolean enabled)
+{
+    mm_perf_stats_enabled_flag = enabled;
+    if (!enabled)
+        mm_perf_stats_reset ();
+}
+
+void
+mm_perf_stats_reset (void)
+{
+    guint i;
+
+    for (i = 0; all_stats && i < all_stats->len; i++) {
+        MMPerfStat *stat;
+
+        stat = g_ptr_array_index (all_stats, i);
+        stat->value = 0;
+        memset (stat->buckets, 0, sizeof (stat->buckets));
+    }
+}
+
+MMPerfStat *
+mm_perf_stats_lookup (const gchar *group,
+                      const gchar *name)
+{
+    GHashTable *group_stats;
+    MMPerfStat *stat;
+
+    if (G_UNLIKELY (!groups)) {
+        groups = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_unref);
+        all_stats = g_ptr_array_new ();
+    }
+
+    group_stats = g_hash_table_lookup (groups, group);
+    if (!group_stats) {
+        group_stats = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+        g_hash_table_insert (groups, g_strdup (group), group_stats);
+    }
+
+    stat = g_hash_table_lookup (group_stats, name);
+    if (!stat) {
+        stat = g_new0 (MMPerfStat, 1);
+        stat->key = g_strdup_printf ("%s/%s", group, name);
+        g_hash_table_insert (group_stats, g_strdup (name), stat);
+        g_ptr_array_add (all_stats, stat);
+    }
+    return stat;
+}
+
+void
+_mm_perf_stat_add (MMPerfStat *stat,
+                   guint64     value)
+{
+    stat->value += value;
+}
+
+void
+_mm_perf_stat_add_latency (MMPerfStat *stat,
+                           gint64      usecs)
+{
+    guint i;
+
+    stat->histogram = TRUE;
+    stat->value++;
+
+    for (i = 0; i < G_N_ELEMENTS (latency_buckets_ms); i++) {
+        if (usecs < (gint64) latency_buckets_ms[i] * 1000)
+            break;
+    }
+    stat->buckets[i]++;
+}
+
+/*****************************************************************************/
+
+static gint
+stat_cmp (MMPerfStat **a,
+          MMPerfStat **b)
+{
+    return g_strcmp0 ((*a)->key, (*b)->key);
+}
+
+/* Counters not updated since the last reset are skipped */
+static GPtrArray *
+get_sorted_stats (void)
+{
+    GPtrArray *sorted;
+    guint      i;
+
+    sorted = g_ptr_array_new ();
+    for (i = 0; all_stats && i < all_stats->len; i++) {
+        MMPerfStat *stat;
+
+        stat = g_ptr_array_index (all_stats, i);
+        if (stat->value)
+            g_ptr_array_add (sorted, stat);
+    }
+    g_ptr_array_sort (sorted, (GCompareFunc) stat_cmp);
+    return sorted;
+}
+
+GVariant *
+mm_perf_stats_get_dictionary (void)
+{
+    GVariantBuilder      builder;
+    g_autoptr(GPtrArray) sorted = NULL;
+    guint                i;
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+
+    sorted = get_sorted_stats ();
+    for (i = 0; i < sorted->len; i++) {
+        MMPerfStat *stat;
+
+        stat = g_ptr_array_index (sorted, i);
+        if (stat->histogram)
+            g_variant_builder_add (&builder, "{sv}", stat->key,
+                                   g_variant_new_fixed_array (G_VARIANT_TYPE_UINT64,
+                                                              stat->buckets,
+                                                              MM_PERF_STATS_N_LATENCY_BUCKETS,
+                                                              sizeof (guint64)));
+        else
+            g_variant_builder_add (&builder, "{sv}", stat->key, g_variant_new_uint64 (stat->value));
+    }
+
+    return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
+
+void
+mm_perf_stats_log (void)
+{
+    g_autoptr(GPtrArray) sorted = NULL;
+    guint                i;
+
+    if (!mm_perf_stats_enabled ())
+        return;
+
+    sorted = get_sorted_stats ();
+    mm_obj_msg (NULL, "performance stats: %u counters", sorted->len);
+    for (i = 0; i < sorted->len; i++) {
+        MMPerfStat *stat;
+
+        stat = g_ptr_array_index (sorted, i);
+        if (stat->histogram) {
+            g_autoptr(GString) str = NULL;
+            guint              j;
+
+            str = g_string_new (NULL);
+            for (j = 0; j < MM_PERF_STATS_N_LATENCY_BUCKETS; j++) {
+                if (j < G_N_ELEMENTS (latency_buckets_ms))
+                    g_string_append_printf (str, "%s<%ums: %" G_GUINT64_FORMAT,
+                                            j ? ", " : "", latency_buckets_ms[j], stat->buckets[j]);
+                else
+                    g_string_append_printf (str, ", >=%ums: %" G_GUINT64_FORMAT,
+                                            latency_buckets_ms[j - 1], stat->buckets[j]);
+            }
+            mm_obj_msg (NULL, "  %s: %" G_GUINT64_FORMAT " samples (%s)", stat->key, stat->value, str->str);
+        } else
+            mm_obj_msg (NULL, "  %s: %" G_GUINT64_FORMAT, stat->key, stat->value);
+    }
+}
@@ -0,0 +1,96 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_PERF_STATS_H
+#define MM_PERF_STATS_H
+
+#include <glib.h>
+
+/* Lightweight performance counters for the daemon hot paths.
+ *
+ * Counters are identified by a group (e.g. "port/ttyUSB2", "auth") and a
+ * name (e.g. "commands-sent"). Stats are only collected when explicitly
+ * enabled (daemon running with --debug); otherwise the helper macros below
+ * reduce to a single boolean check.
+ *
+ * Counters are interned: once looked up, a MMPerfStat is valid until the
+ * daemon exits, so callers in hot paths keep it around instead of looking it
+ * up on every update. The mm_perf_stats_*() macros do that themselves, and
+ * can only be used with constant group and name strings; the mm_perf_stat_*()
+ * ones work on counters kept by the caller.
+ *
+ * Counters are only updated and read from the main context; the log file
+ * writer thread never touches them. */
+
+typedef struct _MMPerfStat MMPerfStat;
+
+extern gboolean mm_perf_stats_enabled_flag;
+
+#define mm_perf_stats_enabled() G_UNLIKELY (mm_perf_stats_enabled_flag)
+
+#define mm_perf_stat_add(stat, value) do {                                 \
+        if (mm_perf_stats_enabled ())                                      \
+            _mm_perf_stat_add (stat, value);                               \
+    } while (0)
+
+#define mm_perf_stat_inc(stat) mm_perf_stat_add (stat, 1)
+
+#define mm_perf_stat_add_latency(stat, usecs) do {                         \
+        if (mm_perf_stats_enabled ())                                      \
+            _mm_perf_stat_add_latency (stat, usecs);                       \
+    } while (0)
+
+#define mm_perf_stats_add(group, name, value) do {                         \
+        if (mm_perf_stats_enabled ()) {                                    \
+            static MMPerfStat *_mm_perf_stat;                              \
+                                                                           \
+            if (G_UNLIKELY (!_mm_perf_stat))                               \
+                _mm_perf_stat = mm_perf_stats_lookup (group, name);        \
+            _mm_perf_stat_add (_mm_perf_stat, value);                      \
+        }                                                                  \
+    } while (0)
+
+#define mm_perf_stats_inc(group, name) mm_perf_stats_add (group, name, 1)
+
+#define mm_perf_stats_add_latency(group, name, usecs) do {                 \
+        if (mm_perf_stats_enabled ()) {                                    \
+            static MMPerfStat *_mm_perf_stat;                              \
+                                                                           \
+            if (G_UNLIKELY (!_mm_perf_stat))                               \
+                _mm_perf_stat = mm_perf_stats_lookup (group, name);        \
+            _mm_perf_stat_add_latency (_mm_perf_stat, usecs);              \
+        }                                                                  \
+    } while (0)
+
+/* Upper bounds of the latency histogram buckets, in milliseconds; an
+ * additional last bucket collects all values above the last bound. */
+#define MM_PERF_STATS_LATENCY_BUCKETS_MS 10, 50, 100, 500, 1000, 5000
+#define MM_PERF_STATS_N_LATENCY_BUCKETS  7
+
+void        mm_perf_stats_set_enabled    (gboolean enabled);
+void        mm_perf_stats_reset          (void);
+GVariant   *mm_perf_stats_get_dictionary (void);
+void        mm_perf_stats_log            (void);
+
+/* Returns the interned counter, created if needed */
+MMPerfStat *mm_perf_stats_lookup         (const gchar *group,
+                                          const gchar *name);
+
+void        _mm_perf_stat_add            (MMPerfStat  *stat,
+                                          guint64      value);
+void        _mm_perf_stat_add_latency    (MMPerfStat  *stat,
+                                          gint64       usecs);
+
+#endif /* MM_PERF_STATS_H */
@@ -28,6 +28,7 @@
 #include "mm-port-mbim.h"
 #include "mm-port-net.h"
 #include "mm-log-object.h"
+#include "mm-perf-stats.h"
 
 G_DEFINE_TYPE (MMPortMbim, mm_port_mbim, MM_TYPE_PORT)
 
@@ -51,6 +52,9 @@ struct _MMPortMbimPrivate {
     MbimDeviceServiceElement **device_services;
     guint32                    device_services_count;
 
+    /* indication counters, keyed by service and CID */
+    GHashTable *perf_indications;
+
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     QmiDevice  *qmi_device;
     GList      *qmi_clients;
@@ -435,13 +439,165 @@ device_removed_cb (MMPortMbim  *self)
     g_signal_emit_by_name (self, MM_PORT_SIGNAL_REMOVED);
 }
 
+static void
+count_notification (MMPortMbim  *self,
+                    MbimMessage *notification)
+{
+    MbimService  service;
+    guint        cid;
+    gpointer     key;
+    MMPerfStat  *stat;
+
+    service = mbim_message_indicate_status_get_service (notification);
+    cid = mbim_message_indicate_status_get_cid (notification);
+    key = GUINT_TO_POINTER ((service << 16) | (cid & 0xFFFF));
+
+    if (G_UNLIKELY (!self->priv->perf_indications))
+        self->priv->perf_indications = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    stat = g_hash_table_lookup (self->priv->perf_indications, key);
+    if (!stat) {
+        g_autofree gchar *group = NULL;
+        g_autofree gchar *name = NULL;
+        const gchar      *service_str;
+        const gchar      *cid_str;
+
+        service_str = mbim_service_get_string (service);
+        cid_str = mbim_cid_get_printable (service, cid);
+        group = g_strdup_printf ("mbim/%s", mm_port_get_device (MM_PORT (self)));
+        if (cid_str)
+            name = g_strdup_printf ("%s/%s-indications", service_str, cid_str);
+        else
+            name = g_strdup_printf ("%s/%u-indications", service_str ? service_str : "unknown", cid);
+        stat = mm_perf_stats_lookup (group, name);
+        g_hash_table_insert (self->priv->perf_indications, key, stat);
+    }
+    _mm_perf_stat_add (stat, 1);
+}
+
 static void
 notification_cb (MMPortMbim  *self,
                  MbimMessage *notification)
 {
+    if (mm_perf_stats_enabled ())
+        count_notification (self, notification);
     g_signal_emit (self, signals[SIGNAL_NOTIFICATION], 0, notification);
 }
 
+/*****************************************************************************/
+/* Commands */
+
+typedef struct {
+    MMPerfStat *requests;
+    MMPerfStat *responses;
+} CommandStats;
+
+/* Command counters, keyed by service and CID; counters are interned so they
+ * are never freed */
+static GHashTable *perf_commands;
+
+static CommandStats *
+peek_command_stats (MbimMessage *message)
+{
+    MbimService   service;
+    guint         cid;
+    gpointer      key;
+    CommandStats *stats;
+
+    service = mbim_message_command_get_service (message);
+    cid = mbim_message_command_get_cid (message);
+    key = GUINT_TO_POINTER ((service << 16) | (cid & 0xFFFF));
+
+    if (G_UNLIKELY (!perf_commands))
+        perf_commands = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+
+    stats = g_hash_table_lookup (perf_commands, key);
+    if (!stats) {
+        g_autofree gchar *prefix = NULL;
+        g_autofree gchar *name = NULL;
+        const gchar      *service_str;
+        const gchar      *cid_str;
+
+        service_str = mbim_service_get_string (service);
+        cid_str = mbim_cid_get_printable (service, cid);
+        if (cid_str)
+            prefix = g_strdup_printf ("%s/%s", service_str, cid_str);
+        else
+            prefix = g_strdup_printf ("%s/%u", service_str ? service_str : "unknown", cid);
+
+        stats = g_new0 (CommandStats, 1);
+        name = g_strdup_printf ("%s-requests", prefix);
+        stats->requests = mm_perf_stats_lookup ("mbim", name);
+        g_free (name);
+        name = g_strdup_printf ("%s-responses", prefix);
+        stats->responses = mm_perf_stats_lookup ("mbim", name);
+        g_hash_table_insert (perf_commands, key, stats);
+    }
+    return stats;
+}
+
+MbimMessage *
+mm_port_mbim_device_command_finish (MbimDevice    *device,
+                                    GAsyncResult  *res,
+                                    GError       **error)
+{
+    if (g_async_result_is_tagged (res, mm_port_mbim_device_command))
+        return g_task_propagate_pointer (G_TASK (res), error);
+    return mbim_device_command_finish (device, res, error);
+}
+
+static void
+device_command_ready (MbimDevice   *device,
+                      GAsyncResult *res,
+                      GTask        *task)
+{
+    MbimMessage *response;
+    GError      *error = NULL;
+
+    response = mbim_device_command_finish (device, res, &error);
+    if (!response) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    _mm_perf_stat_add (((CommandStats *) g_task_get_task_data (task))->responses, 1);
+    g_task_return_pointer (task, response, (GDestroyNotify) mbim_message_unref);
+    g_object_unref (task);
+}
+
+void
+mm_port_mbim_device_command (MbimDevice          *device,
+                             MbimMessage         *message,
+                             guint                timeout,
+                             GCancellable        *cancellable,
+                             GAsyncReadyCallback  callback,
+                             gpointer             user_data)
+{
+    GTask        *task;
+    CommandStats *stats;
+
+    /* Only wrap the operation if the counters are being collected */
+    if (!mm_perf_stats_enabled ()) {
+        mbim_device_command (device, message, timeout, cancellable, callback, user_data);
+        return;
+    }
+
+    stats = peek_command_stats (message);
+    _mm_perf_stat_add (stats->requests, 1);
+
+    task = g_task_new (device, cancellable, callback, user_data);
+    g_task_set_source_tag (task, mm_port_mbim_device_command);
+    g_task_set_task_data (task, stats, NULL);
+
+    mbim_device_command (device,
+                         message,
+                         timeout,
+                         cancellable,
+                         (GAsyncReadyCallback)device_command_ready,
+                         task);
+}
+
 static void
 setup_monitoring (MMPortMbim *self,
                   MbimDevice *mbim_device)
@@ -633,7 +789,7 @@ mbim_query_device_services_ready (MbimDevice   *device,
     self->priv->device_services_count = 0;
     g_clear_pointer (&self->priv->device_services, (GDestroyNotify)mbim_device_service_element_array_free);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_device_services_response_parse (
@@ -661,12 +817,12 @@ mbim_query_device_services (GTask *task)
     self = g_task_get_source_object (task);
 
     message = mbim_message_device_services_query_new (NULL);
-    mbim_device_command (self->priv->mbim_device,
-                         message,
-                         20,
-                         NULL,
-                         (GAsyncReadyCallback)mbim_query_device_services_ready,
-                         task);
+    mm_port_mbim_device_command (self->priv->mbim_device,
+                                 message,
+                                 20,
+                                 NULL,
+                                 (GAsyncReadyCallback)mbim_query_device_services_ready,
+                                 task);
 }
 
 static void
@@ -958,6 +1114,7 @@ dispose (GObject *object)
 
     self->priv->device_services_count = 0;
     g_clear_pointer (&self->priv->device_services, (GDestroyNotify)mbim_device_service_element_array_free);
+    g_clear_pointer (&self->priv->perf_indications, g_hash_table_unref);
 
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     g_list_free_full (self->priv->qmi_clients, g_object_unref);
@@ -104,6 +104,18 @@ gboolean   mm_port_mbim_allocate_qmi_client_finish (MMPortMbim           *self,
 
 MbimDevice *mm_port_mbim_peek_device (MMPortMbim *self);
 
+/* Same as mbim_device_command(), but counting requests and responses per
+ * service and CID when performance counters are enabled */
+void         mm_port_mbim_device_command        (MbimDevice           *device,
+                                                 MbimMessage          *message,
+                                                 guint                 timeout,
+                                                 GCancellable         *cancellable,
+                                                 GAsyncReadyCallback   callback,
+                                                 gpointer              user_data);
+MbimMessage *mm_port_mbim_device_command_finish (MbimDevice           *device,
+                                                 GAsyncResult         *res,
+                                                 GError              **error);
+
 void   mm_port_mbim_setup_link        (MMPortMbim            *self,
                                        MMPort                *data,
                                        const gchar           *link_prefix_hint,
@@ -28,6 +28,7 @@
 #include "mm-port-enums-types.h"
 #include "mm-modem-helpers-qmi.h"
 #include "mm-log-object.h"
+#include "mm-perf-stats.h"
 
 /* as internally defined in the kernel */
 #define RMNET_MAX_PACKET_SIZE 16384
@@ -53,10 +54,33 @@ typedef struct {
     guint       flag;
 } ServiceInfo;
 
+/* QMI service ids are 8-bit values, so clients are looked up directly by
+ * service, and then by flag among the (usually very few) clients allocated
+ * for that service. If enabled, some services also keep a pool of spare
+ * clients, pre-allocated once the modem is created, so that clients can be
+ * handed out without CTL round trips. The pool is refilled in the background
+ * every time a client is taken from it, and explicitly released clients go
+ * back to the pool while there is room for them. */
+#define SERVICE_SLOTS_N 256
+
+typedef struct {
+    GList *clients; /* ServiceInfo */
+    GList *pool;    /* QmiClient */
+    guint  pool_size;
+    guint  pool_pending;
+} ServiceSlot;
+
+/* Services with a client pool */
+static const QmiService client_pool_services[] = {
+    QMI_SERVICE_WDS,
+    QMI_SERVICE_NAS,
+    QMI_SERVICE_LOC,
+};
+
 struct _MMPortQmiPrivate {
-    gboolean   in_progress;
-    QmiDevice *qmi_device;
-    GList     *services;
+    gboolean     in_progress;
+    QmiDevice   *qmi_device;
+    ServiceSlot *services[SERVICE_SLOTS_N];
     gchar     *net_driver;
     gchar     *net_sysfs_path;
     guint      net_preallocated_links_requested;
@@ -68,6 +92,9 @@ struct _MMPortQmiPrivate {
     /* port monitoring */
     gulong timeout_monitoring_id;
     gulong removed_monitoring_id;
+    gulong indication_monitoring_id;
+    /* indication counters, keyed by service and message id */
+    GHashTable *perf_indications;
     /* endpoint info */
     QmiDataEndpointType endpoint_type;
     gint                endpoint_interface_number;
@@ -89,23 +116,90 @@ struct _MMPortQmiPrivate {
 
 /*****************************************************************************/
 
+static ServiceSlot *
+peek_service_slot (MMPortQmi  *self,
+                   QmiService  service)
+{
+    g_assert ((guint) service < SERVICE_SLOTS_N);
+    return self->priv->services[service];
+}
+
+static ServiceSlot *
+get_service_slot (MMPortQmi  *self,
+                  QmiService  service)
+{
+    g_assert ((guint) service < SERVICE_SLOTS_N);
+    if (!self->priv->services[service])
+        self->priv->services[service] = g_new0 (ServiceSlot, 1);
+    return self->priv->services[service];
+}
+
+static void
+release_all_clients (MMPortQmi *self,
+                     QmiDevice *qmi_device)
+{
+    guint i;
+
+    for (i = 0; i < SERVICE_SLOTS_N; i++) {
+        ServiceSlot *slot;
+        GList       *l;
+
+        slot = self->priv->services[i];
+        if (!slot)
+            continue;
+
+        for (l = slot->clients; l; l = g_list_next (l)) {
+            ServiceInfo *info = l->data;
+
+            if (qmi_device) {
+                mm_obj_dbg (self, "Releasing client for service '%s'...", qmi_service_get_string (info->service));
+                qmi_device_release_client (qmi_device,
+                                           info->client,
+                                           QMI_DEVICE_RELEASE_CLIENT_FLAGS_RELEASE_CID,
+                                           3, NULL, NULL, NULL);
+            }
+            g_clear_object (&info->client);
+        }
+        g_list_free_full (slot->clients, g_free);
+
+        if (qmi_device && slot->pool)
+            mm_obj_dbg (self, "Releasing %u pooled clients for service '%s'...",
+                        g_list_length (slot->pool), qmi_service_get_string ((QmiService) i));
+        for (l = slot->pool; l; l = g_list_next (l)) {
+            if (qmi_device)
+                qmi_device_release_client (qmi_device,
+                                           QMI_CLIENT (l->data),
+                                           QMI_DEVICE_RELEASE_CLIENT_FLAGS_RELEASE_CID,
+                                           3, NULL, NULL, NULL);
+        }
+        g_list_free_full (slot->pool, g_object_unref);
+
+        g_clear_pointer (&self->priv->services[i], g_free);
+    }
+}
+
 static QmiClient *
 lookup_client (MMPortQmi  *self,
                QmiService  service,
                guint       flag,
                gboolean    steal)
 {
-    GList *l;
+    ServiceSlot *slot;
+    GList       *l;
 
-    for (l = self->priv->services; l; l = g_list_next (l)) {
+    slot = peek_service_slot (self, service);
+    if (!slot)
+        return NULL;
+
+    for (l = slot->clients; l; l = g_list_next (l)) {
         ServiceInfo *info = l->data;
 
-        if (info->service == service && info->flag == flag) {
+        if (info->flag == flag) {
             QmiClient *found;
 
             found = info->client;
             if (steal) {
-                self->priv->services = g_list_delete_link (self->priv->services, l);
+                slot->clients = g_list_delete_link (slot->clients, l);
                 g_free (info);
             }
             return found;
@@ -206,6 +300,10 @@ reset_monitoring (MMPortQmi *self,
         g_signal_handler_disconnect (qmi_device, self->priv->removed_monitoring_id);
         self->priv->removed_monitoring_id = 0;
     }
+    if (self->priv->indication_monitoring_id && qmi_device) {
+        g_signal_handler_disconnect (qmi_device, self->priv->indication_monitoring_id);
+        self->priv->indication_monitoring_id = 0;
+    }
 }
 
 static void
@@ -222,6 +320,38 @@ device_removed_cb (MMPortQmi  *self)
     g_signal_emit_by_name (self, MM_PORT_SIGNAL_REMOVED);
 }
 
+static void
+indication_cb (MMPortQmi  *self,
+               GByteArray *raw)
+{
+    QmiMessage *message = (QmiMessage *) raw;
+    QmiService  service;
+    guint16     message_id;
+    gpointer    key;
+    MMPerfStat *stat;
+
+    service = qmi_message_get_service (message);
+    message_id = qmi_message_get_message_id (message);
+    key = GUINT_TO_POINTER ((service << 16) | message_id);
+
+    if (G_UNLIKELY (!self->priv->perf_indications))
+        self->priv->perf_indications = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    stat = g_hash_table_lookup (self->priv->perf_indications, key);
+    if (!stat) {
+        g_autofree gchar *group = NULL;
+        g_autofree gchar *name = NULL;
+        const gchar      *service_str;
+
+        service_str = qmi_service_get_string (service);
+        group = g_strdup_printf ("qmi/%s", mm_port_get_device (MM_PORT (self)));
+        name = g_strdup_printf ("%s/0x%04x-indications", service_str ? service_str : "unknown", message_id);
+        stat = mm_perf_stats_lookup (group, name);
+        g_hash_table_insert (self->priv->perf_indications, key, stat);
+    }
+    _mm_perf_stat_add (stat, 1);
+}
+
 static void
 setup_monitoring (MMPortQmi *self,
                   QmiDevice *qmi_device)
@@ -241,6 +371,14 @@ setup_monitoring (MMPortQmi *self,
                                                                   QMI_DEVICE_SIGNAL_REMOVED,
                                                                   G_CALLBACK (device_removed_cb),
                                                                   self);
+
+    /* Only monitor indications if the counters are being collected */
+    g_assert (!self->priv->indication_monitoring_id);
+    if (mm_perf_stats_enabled ())
+        self->priv->indication_monitoring_id = g_signal_connect_swapped (qmi_device,
+                                                                         QMI_DEVICE_SIGNAL_INDICATION,
+                                                                         G_CALLBACK (indication_cb),
+                                                                         self);
 }
 
 /*****************************************************************************/
@@ -250,7 +388,8 @@ mm_port_qmi_release_client (MMPortQmi     *self,
                             QmiService     service,
                             MMPortQmiFlag  flag)
 {
-    QmiClient *client;
+    QmiClient   *client;
+    ServiceSlot *slot;
 
     if (!self->priv->qmi_device)
         return;
@@ -259,7 +398,17 @@ mm_port_qmi_release_client (MMPortQmi     *self,
     if (!client)
         return;
 
+    /* Put the client back in the pool if there is room for it */
+    slot = peek_service_slot (self, service);
+    if (slot && (g_list_length (slot->pool) + slot->pool_pending) < slot->pool_size) {
+        mm_obj_dbg (self, "returning client for service '%s' to the pool...", qmi_service_get_string (service));
+        mm_perf_stats_inc ("qmi", "client-pool-returns");
+        slot->pool = g_list_prepend (slot->pool, client);
+        return;
+    }
+
     mm_obj_dbg (self, "explicitly releasing client for service '%s'...", qmi_service_get_string (service));
+    mm_perf_stats_inc ("qmi", "client-releases");
     qmi_device_release_client (self->priv->qmi_device,
                                client,
                                QMI_DEVICE_RELEASE_CLIENT_FLAGS_RELEASE_CID,
@@ -269,8 +418,12 @@ mm_port_qmi_release_client (MMPortQmi     *self,
 
 /*****************************************************************************/
 
+static void pool_refill (MMPortQmi  *self,
+                         QmiService  service);
+
 typedef struct {
     ServiceInfo *info;
+    gint64       start_time;
 } AllocateClientContext;
 
 static void
@@ -303,14 +456,19 @@ allocate_client_ready (QmiDevice *qmi_device,
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
     ctx->info->client = qmi_device_allocate_client_finish (qmi_device, res, &error);
+    mm_perf_stats_add_latency ("qmi", "client-allocation-latency", g_get_monotonic_time () - ctx->start_time);
     if (!ctx->info->client) {
+        mm_perf_stats_inc ("qmi", "client-allocation-failures");
         g_prefix_error (&error,
                         "Couldn't create client for service '%s': ",
                         qmi_service_get_string (ctx->info->service));
         g_task_return_error (task, error);
     } else {
-        /* Move the service info to our internal list */
-        self->priv->services = g_list_prepend (self->priv->services, ctx->info);
+        ServiceSlot *slot;
+
+        /* Move the service info to our internal table */
+        slot = get_service_slot (self, ctx->info->service);
+        slot->clients = g_list_prepend (slot->clients, ctx->info);
         ctx->info = NULL;
         g_task_return_boolean (task, TRUE);
     }
@@ -327,6 +485,7 @@ mm_port_qmi_allocate_client (MMPortQmi           *self,
                              gpointer             user_data)
 {
     AllocateClientContext *ctx;
+    ServiceSlot *slot;
     GTask *task;
 
     task = g_task_new (self, cancellable, callback, user_data);
@@ -346,12 +505,35 @@ mm_port_qmi_allocate_client (MMPortQmi           *self,
         return;
     }
 
+    /* Hand out a spare client from the pool, if any */
+    slot = peek_service_slot (self, service);
+    if (slot && slot->pool) {
+        ServiceInfo *info;
+
+        info = g_new0 (ServiceInfo, 1);
+        info->service = service;
+        info->flag = flag;
+        info->client = slot->pool->data;
+        slot->pool = g_list_delete_link (slot->pool, slot->pool);
+        slot->clients = g_list_prepend (slot->clients, info);
+
+        mm_obj_dbg (self, "using pooled client for service '%s'", qmi_service_get_string (service));
+        mm_perf_stats_inc ("qmi", "client-pool-hits");
+        pool_refill (self, service);
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+    }
+
     ctx = g_new0 (AllocateClientContext, 1);
     ctx->info = g_new0 (ServiceInfo, 1);
     ctx->info->service = service;
     ctx->info->flag = flag;
+    ctx->start_time = g_get_monotonic_time ();
     g_task_set_task_data (task, ctx, (GDestroyNotify)allocate_client_context_free);
 
+    mm_perf_stats_inc ("qmi", "client-allocations");
+
     qmi_device_allocate_client (self->priv->qmi_device,
                                 service,
                                 QMI_CID_NONE,
@@ -363,6 +545,106 @@ mm_port_qmi_allocate_client (MMPortQmi           *self,
 
 /*****************************************************************************/
 
+typedef struct {
+    MMPortQmi  *self;
+    QmiService  service;
+} PoolAllocateContext;
+
+static void
+pool_allocate_client_ready (QmiDevice           *qmi_device,
+                            GAsyncResult        *res,
+                            PoolAllocateContext *ctx)
+{
+    MMPortQmi         *self = ctx->self;
+    QmiClient         *client;
+    ServiceSlot       *slot = NULL;
+    g_autoptr(GError)  error = NULL;
+
+    /* The port may have been closed, or even reopened, in the meantime */
+    if (self->priv->qmi_device == qmi_device) {
+        slot = get_service_slot (self, ctx->service);
+        if (slot->pool_pending > 0)
+            slot->pool_pending--;
+    }
+
+    client = qmi_device_allocate_client_finish (qmi_device, res, &error);
+    if (!client)
+        mm_obj_dbg (self, "couldn't pre-allocate pooled client: %s", error->message);
+    else if (!slot || g_list_length (slot->pool) >= slot->pool_size) {
+        /* Either the port is gone, or the pool was already filled back with
+         * released clients */
+        qmi_device_release_client (qmi_device,
+                                   client,
+                                   QMI_DEVICE_RELEASE_CLIENT_FLAGS_RELEASE_CID,
+                                   3, NULL, NULL, NULL);
+        g_object_unref (client);
+    } else
+        slot->pool = g_list_prepend (slot->pool, client);
+
+    g_object_unref (ctx->self);
+    g_slice_free (PoolAllocateContext, ctx);
+}
+
+static void
+pool_refill (MMPortQmi  *self,
+             QmiService  service)
+{
+    ServiceSlot *slot;
+    guint        i;
+
+    slot = peek_service_slot (self, service);
+    if (!slot || !slot->pool_size)
+        return;
+
+    for (i = g_list_length (slot->pool) + slot->pool_pending; i < slot->pool_size; i++) {
+        PoolAllocateContext *ctx;
+
+        ctx = g_slice_new0 (PoolAllocateContext);
+        ctx->self = g_object_ref (self);
+        ctx->service = service;
+        slot->pool_pending++;
+        qmi_device_allocate_client (self->priv->qmi_device,
+                                    service,
+                                    QMI_CID_NONE,
+                                    10,
+                                    NULL,
+                                    (GAsyncReadyCallback) pool_allocate_client_ready,
+                                    ctx);
+    }
+}
+
+void
+mm_port_qmi_setup_client_pool (MMPortQmi *self)
+{
+    MMKernelDevice *kernel_device;
+    gint            pool_size = 0;
+    guint           i;
+
+    if (!self->priv->qmi_device)
+        return;
+
+    /* The pool is disabled unless explicitly requested for the device */
+    kernel_device = mm_port_peek_kernel_device (MM_PORT (self));
+    if (kernel_device && mm_kernel_device_has_global_property (kernel_device, "ID_MM_QMI_CLIENT_POOL_SIZE"))
+        pool_size = mm_kernel_device_get_global_property_as_int (kernel_device, "ID_MM_QMI_CLIENT_POOL_SIZE");
+    if (pool_size <= 0)
+        return;
+
+    /* All pre-allocations are launched at once */
+    for (i = 0; i < G_N_ELEMENTS (client_pool_services); i++) {
+        ServiceSlot *slot;
+
+        slot = get_service_slot (self, client_pool_services[i]);
+        slot->pool_size = (guint) pool_size;
+
+        mm_obj_dbg (self, "pre-allocating %u pooled clients for service '%s'...",
+                    slot->pool_size, qmi_service_get_string (client_pool_services[i]));
+        pool_refill (self, client_pool_services[i]);
+    }
+}
+
+/*****************************************************************************/
+
 typedef struct {
     gchar    *link_name;
     guint     mux_id;
@@ -2804,7 +3086,6 @@ mm_port_qmi_close (MMPortQmi           *self,
 {
     PortQmiCloseContext *ctx;
     GTask               *task;
-    GList               *l;
 
     g_return_if_fail (MM_IS_PORT_QMI (self));
 
@@ -2835,19 +3116,8 @@ mm_port_qmi_close (MMPortQmi           *self,
     /* Reset monitoring logic */
     reset_monitoring (self, ctx->qmi_device);
 
-    /* Release all allocated clients */
-    for (l = self->priv->services; l; l = g_list_next (l)) {
-        ServiceInfo *info = l->data;
-
-        mm_obj_dbg (self, "Releasing client for service '%s'...", qmi_service_get_string (info->service));
-        qmi_device_release_client (ctx->qmi_device,
-                                   info->client,
-                                   QMI_DEVICE_RELEASE_CLIENT_FLAGS_RELEASE_CID,
-                                   3, NULL, NULL, NULL);
-        g_clear_object (&info->client);
-    }
-    g_list_free_full (self->priv->services, g_free);
-    self->priv->services = NULL;
+    /* Release all allocated and pooled clients */
+    release_all_clients (self, ctx->qmi_device);
 
     /* Cleanup preallocated links, if any */
     if (self->priv->preallocated_links) {
@@ -2943,17 +3213,9 @@ static void
 dispose (GObject *object)
 {
     MMPortQmi *self = MM_PORT_QMI (object);
-    GList *l;
 
     /* Deallocate all clients */
-    for (l = self->priv->services; l; l = g_list_next (l)) {
-        ServiceInfo *info = l->data;
-
-        if (info->client)
-            g_object_unref (info->client);
-    }
-    g_list_free_full (self->priv->services, g_free);
-    self->priv->services = NULL;
+    release_all_clients (self, NULL);
 
     /* Cleanup preallocated links, if any */
     if (self->priv->preallocated_links && self->priv->qmi_device)
@@ -2968,6 +3230,7 @@ dispose (GObject *object)
     /* Clear device object */
     reset_monitoring (self, self->priv->qmi_device);
     g_clear_object (&self->priv->qmi_device);
+    g_clear_pointer (&self->priv->perf_indications, g_hash_table_unref);
 
     g_clear_pointer (&self->priv->net_driver, g_free);
     g_clear_pointer (&self->priv->net_sysfs_path, g_free);
@@ -107,6 +107,10 @@ gboolean mm_port_qmi_allocate_client_finish (MMPortQmi            *self,
                                              GAsyncResult         *res,
                                              GError              **error);
 
+/* Pre-allocates spare clients of the most used services, if enabled with the
+ * ID_MM_QMI_CLIENT_POOL_SIZE udev property. To be called once probing is over. */
+void     mm_port_qmi_setup_client_pool      (MMPortQmi    *self);
+
 void     mm_port_qmi_release_client         (MMPortQmi    *self,
                                              QmiService    service,
                                              MMPortQmiFlag flag);
@@ -0,0 +1,485 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include "mm-port-scheduler-prio.h"
+#include "mm-log-object.h"
+
+/* Theory of operation:
+ *
+ * Same contract with the sources as MMPortSchedulerRR: sources register
+ * themselves, notify the scheduler whenever their queue depth changes, get
+ * the 'send-command' signal when they're allowed to send the next command
+ * in their queue, and must call mm_port_scheduler_notify_command_done() once
+ * that command is finished.
+ *
+ * Additionally, sources may report the priority class and submission time
+ * of the next command in their queue with
+ * mm_port_scheduler_notify_next_command(). Sources that don't report it
+ * are handled as if all their commands had CONTROL priority.
+ *
+ * When the scheduler is idle, it selects the source whose next command has
+ * the best effective priority. The effective priority is the priority class
+ * of the command, promoted one class for every 'aging-interval' ms the
+ * command has been waiting, so that background commands are never starved
+ * by a continuous flow of higher priority ones. Ties are resolved in favor
+ * of the command that has been waiting longer, and then round-robin.
+ */
+
+static void mm_port_scheduler_iface_init (MMPortSchedulerInterface *iface);
+static void log_object_iface_init (MMLogObjectInterface *iface);
+
+struct _MMPortSchedulerPrioPrivate {
+    guint      instance_id;
+    GPtrArray *sources;
+    guint      cur_source;
+    gboolean   in_command;
+    guint      next_pending_id;
+
+    /* Delay between allowing ports to send commands, in ms */
+    guint inter_port_delay;
+    /* Time waited before promoting a command one priority class, in ms */
+    guint aging_interval;
+};
+
+enum {
+    PROP_0,
+    PROP_INTER_PORT_DELAY,
+    PROP_AGING_INTERVAL,
+
+    LAST_PROP
+};
+
+static guint send_command_signal = 0;
+static guint instance_id_last = 0;
+
+G_DEFINE_TYPE_WITH_CODE (MMPortSchedulerPrio, mm_port_scheduler_prio, G_TYPE_OBJECT,
+                         G_ADD_PRIVATE (MMPortSchedulerPrio)
+                         G_IMPLEMENT_INTERFACE (MM_TYPE_PORT_SCHEDULER,
+                                                mm_port_scheduler_iface_init)
+                         G_IMPLEMENT_INTERFACE (MM_TYPE_LOG_OBJECT,
+                                                log_object_iface_init))
+
+/*****************************************************************************/
+
+typedef struct {
+    gpointer                 id;
+    gchar                   *tag; /* e.g. port name */
+    guint                    num_pending;
+    /* Whether the source reports its next command explicitly */
+    gboolean                 reports_next;
+    MMPortSchedulerPriority  priority;
+    gint64                   enqueued_time;
+} Source;
+
+static void
+source_free (Source *s)
+{
+    g_free (s->tag);
+    g_slice_free (Source, s);
+}
+
+static Source *
+find_source (MMPortSchedulerPrio *self,
+             gpointer             source_id,
+             guint               *out_idx)
+{
+    guint i;
+
+    for (i = 0; i < self->priv->sources->len; i++) {
+        Source *s;
+
+        s = g_ptr_array_index (self->priv->sources, i);
+        if (s->id == source_id) {
+            if (out_idx)
+                *out_idx = i;
+            return s;
+        }
+    }
+
+    return NULL;
+}
+
+static guint
+source_get_effective_rank (MMPortSchedulerPrio *self,
+                           Source              *s,
+                           gint64               now)
+{
+    guint  rank;
+    gint64 promotions;
+
+    rank = mm_port_scheduler_priority_get_rank (s->priority);
+    if (!self->priv->aging_interval || now <= s->enqueued_time)
+        return rank;
+
+    promotions = (now - s->enqueued_time) / ((gint64) self->priv->aging_interval * 1000);
+    return (promotions >= (gint64) rank) ? 0 : (rank - (guint) promotions);
+}
+
+static Source *
+find_next_source (MMPortSchedulerPrio *self,
+                  guint               *out_idx)
+{
+    Source *best = NULL;
+    guint   best_idx = 0;
+    guint   best_rank = G_MAXUINT;
+    gint64  now;
+    guint   i, idx;
+
+    now = g_get_monotonic_time ();
+
+    /* Walk all sources starting at the one *after* the current source, so
+     * that sources with equal priority and submission time are served
+     * round-robin. */
+    for (i = 0, idx = self->priv->cur_source + 1;
+         i < self->priv->sources->len;
+         i++, idx++) {
+        Source *s;
+        guint   rank;
+
+        /* Wrap around */
+        if (idx >= self->priv->sources->len)
+            idx = 0;
+
+        s = g_ptr_array_index (self->priv->sources, idx);
+        if (s->num_pending == 0)
+            continue;
+
+        rank = source_get_effective_rank (self, s, now);
+        if (!best || rank < best_rank || (rank == best_rank && s->enqueued_time < best->enqueued_time)) {
+            best = s;
+            best_idx = idx;
+            best_rank = rank;
+        }
+    }
+
+    if (best && out_idx)
+        *out_idx = best_idx;
+    return best;
+}
+
+static void schedule_next_command (MMPortSchedulerPrio *self);
+
+static gboolean
+run_next_command (MMPortSchedulerPrio *self)
+{
+    Source *s;
+
+    self->priv->next_pending_id = 0;
+
+    /* Priorities are evaluated again here, as they may have changed
+     * while waiting for the inter-port delay */
+    s = find_next_source (self, &self->priv->cur_source);
+    if (s) {
+        gint64 now;
+
+        now = g_get_monotonic_time ();
+        if (source_get_effective_rank (self, s, now) < mm_port_scheduler_priority_get_rank (s->priority))
+            mm_obj_dbg (self, "[%s] command promoted after waiting %" G_GINT64_FORMAT "ms",
+                        s->tag, (now - s->enqueued_time) / 1000);
+        self->priv->in_command = TRUE;
+        g_signal_emit (MM_PORT_SCHEDULER (self),
+                       send_command_signal,
+                       0,
+                       s->id);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+schedule_next_command (MMPortSchedulerPrio *self)
+{
+    guint next_idx = 0;
+    guint delay = 0;
+
+    if (self->priv->next_pending_id || self->priv->in_command || !find_next_source (self, &next_idx))
+        return;
+
+    /* Only delay next command if we change sources and this isn't the
+     * first time we're running a command.
+     */
+    if (next_idx != self->priv->cur_source && self->priv->cur_source < self->priv->sources->len)
+        delay = self->priv->inter_port_delay;
+    self->priv->next_pending_id = g_timeout_add (delay, (GSourceFunc) run_next_command, self);
+}
+
+static void
+register_source (MMPortScheduler *scheduler,
+                 gpointer         source_id,
+                 const gchar     *tag)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (scheduler);
+    Source              *s;
+
+    g_assert (source_id != NULL);
+
+    s = find_source (self, source_id, NULL);
+    if (!s) {
+        s = g_slice_new0 (Source);
+        s->id = source_id;
+        s->tag = g_strdup (tag);
+        s->priority = MM_PORT_SCHEDULER_PRIORITY_CONTROL;
+        g_ptr_array_add (self->priv->sources, s);
+
+        g_assert_cmpint (self->priv->sources->len, <, UINT_MAX);
+        mm_obj_dbg (self, "[%s] source id %p registered", tag, source_id);
+        mm_log_object_reset_id (MM_LOG_OBJECT (self));
+    }
+}
+
+static void
+unregister_source (MMPortScheduler *scheduler,
+                   gpointer         source_id)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (scheduler);
+    Source              *s;
+    guint                idx = 0;
+
+    g_assert (source_id != NULL);
+
+    s = find_source (self, source_id, &idx);
+    if (!s)
+        return;
+
+    mm_obj_dbg (self, "[%s] source id %p unregistered", s->tag, s->id);
+    g_ptr_array_remove_index (self->priv->sources, idx);
+    mm_log_object_reset_id (MM_LOG_OBJECT (self));
+
+    /* Keep the current source index valid; if we just removed the current
+     * source, it will never report its command done, so move on. */
+    if (self->priv->cur_source == idx) {
+        self->priv->cur_source = G_MAXUINT32;
+        self->priv->in_command = FALSE;
+        schedule_next_command (self);
+    } else if (self->priv->cur_source != G_MAXUINT32 && self->priv->cur_source > idx)
+        self->priv->cur_source--;
+}
+
+static void
+notify_num_pending (MMPortScheduler *scheduler,
+                    gpointer         source_id,
+                    guint            num_pending)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (scheduler);
+    Source              *s;
+
+    g_assert (source_id != NULL);
+
+    s = find_source (self, source_id, NULL);
+    if (s && s->num_pending != num_pending) {
+        /* For sources not reporting their next command, the waiting
+         * time starts when the queue stops being empty */
+        if (!s->reports_next && s->num_pending == 0)
+            s->enqueued_time = g_get_monotonic_time ();
+        s->num_pending = num_pending;
+        schedule_next_command (self);
+    }
+}
+
+static void
+notify_command_done (MMPortScheduler *scheduler,
+                     gpointer         source_id,
+                     guint            num_pending)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (scheduler);
+    Source              *s;
+    guint                idx = 0;
+
+    g_assert (source_id != NULL);
+
+    s = find_source (self, source_id, &idx);
+    if (!s) {
+        mm_obj_warn (self, "unknown source %p notified command-done", source_id);
+        return;
+    }
+
+    /* Only the current source gets to call this function */
+    if (self->priv->cur_source != idx) {
+        mm_obj_warn (self, "[%s] notified command-done but not active source", s->tag);
+        return;
+    }
+
+    self->priv->in_command = FALSE;
+    if (!s->reports_next)
+        s->enqueued_time = g_get_monotonic_time ();
+    s->num_pending = num_pending;
+    schedule_next_command (self);
+}
+
+static void
+notify_next_command (MMPortScheduler         *scheduler,
+                     gpointer                 source_id,
+                     MMPortSchedulerPriority  priority,
+                     gint64                   enqueued_time)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (scheduler);
+    Source              *s;
+
+    g_assert (source_id != NULL);
+
+    s = find_source (self, source_id, NULL);
+    if (!s)
+        return;
+
+    /* No need to reschedule here: the source is expected to notify its
+     * queue depth right after this */
+    s->reports_next = TRUE;
+    s->priority = priority;
+    s->enqueued_time = enqueued_time;
+}
+
+/*****************************************************************************/
+
+MMPortSchedulerPrio *
+mm_port_scheduler_prio_new (void)
+{
+    return MM_PORT_SCHEDULER_PRIO (g_object_new (MM_TYPE_PORT_SCHEDULER_PRIO, NULL));
+}
+
+static void
+get_property (GObject *object,
+              guint prop_id,
+              GValue *value,
+              GParamSpec *pspec)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (object);
+
+    switch (prop_id) {
+    case PROP_INTER_PORT_DELAY:
+        g_value_set_uint (value, self->priv->inter_port_delay);
+        break;
+    case PROP_AGING_INTERVAL:
+        g_value_set_uint (value, self->priv->aging_interval);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+set_property (GObject *object,
+              guint prop_id,
+              const GValue *value,
+              GParamSpec *pspec)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (object);
+
+    switch (prop_id) {
+    case PROP_INTER_PORT_DELAY:
+        self->priv->inter_port_delay = g_value_get_uint (value);
+        break;
+    case PROP_AGING_INTERVAL:
+        self->priv->aging_interval = g_value_get_uint (value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+mm_port_scheduler_iface_init (MMPortSchedulerInterface *scheduler_iface)
+{
+    scheduler_iface->register_source = register_source;
+    scheduler_iface->unregister_source = unregister_source;
+    scheduler_iface->notify_num_pending = notify_num_pending;
+    scheduler_iface->notify_command_done = notify_command_done;
+    scheduler_iface->notify_next_command = notify_next_command;
+
+    send_command_signal = g_signal_lookup (MM_PORT_SCHEDULER_SIGNAL_SEND_COMMAND,
+                                           MM_TYPE_PORT_SCHEDULER);
+}
+
+static gchar *
+log_object_build_id (MMLogObject *_self)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (_self);
+    g_autoptr(GString)   str;
+    guint                i;
+
+    str = g_string_sized_new (16);
+    for (i = 0; i < self->priv->sources->len; i++) {
+        Source *s;
+
+        s = g_ptr_array_index (self->priv->sources, i);
+        if (str->len)
+            g_string_append_c (str, ',');
+        g_string_append (str, s->tag);
+    }
+
+    return g_strdup_printf ("scheduler-prio-%u (%s)", self->priv->instance_id, str->str);
+}
+
+static void
+log_object_iface_init (MMLogObjectInterface *iface)
+{
+    iface->build_id = log_object_build_id;
+}
+
+static void
+mm_port_scheduler_prio_init (MMPortSchedulerPrio *self)
+{
+    self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self,
+                                              MM_TYPE_PORT_SCHEDULER_PRIO,
+                                              MMPortSchedulerPrioPrivate);
+    self->priv->sources = g_ptr_array_new_full (2, (GDestroyNotify) source_free);
+    self->priv->cur_source = G_MAXUINT32;
+    self->priv->aging_interval = MM_PORT_SCHEDULER_PRIO_AGING_INTERVAL_DEFAULT;
+    self->priv->instance_id = instance_id_last++;
+}
+
+static void
+dispose (GObject *object)
+{
+    MMPortSchedulerPrio *self = MM_PORT_SCHEDULER_PRIO (object);
+
+    if (self->priv->next_pending_id) {
+        g_source_remove (self->priv->next_pending_id);
+        self->priv->next_pending_id = 0;
+    }
+
+    g_assert (self->priv->sources->len == 0);
+    g_ptr_array_free (self->priv->sources, TRUE);
+
+    G_OBJECT_CLASS (mm_port_scheduler_prio_parent_class)->dispose (object);
+}
+
+static void
+mm_port_scheduler_prio_class_init (MMPortSchedulerPrioClass *klass)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+    /* Virtual methods */
+    object_class->set_property = set_property;
+    object_class->get_property = get_property;
+    object_class->dispose = dispose;
+
+    g_object_class_install_property
+        (object_class, PROP_INTER_PORT_DELAY,
+         g_param_spec_uint (MM_PORT_SCHEDULER_PRIO_INTER_PORT_DELAY,
+                            "Inter-port Delay",
+                            "Inter-port delay in ms",
+                            0, G_MAXUINT, 0,
+                            G_PARAM_READWRITE));
+
+    g_object_class_install_property
+        (object_class, PROP_AGING_INTERVAL,
+         g_param_spec_uint (MM_PORT_SCHEDULER_PRIO_AGING_INTERVAL,
+                            "Aging interval",
+                            "Time in ms a command waits before being promoted one priority class, 0 to disable aging",
+                            0, G_MAXUINT, MM_PORT_SCHEDULER_PRIO_AGING_INTERVAL_DEFAULT,
+                            G_PARAM_READWRITE));
+}
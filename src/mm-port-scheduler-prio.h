@@ -0,0 +1,57 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef _MM_PORT_SCHEDULER_PRIO_H_
+#define _MM_PORT_SCHEDULER_PRIO_H_
+
+#include <glib-object.h>
+#include <gio/gio.h>
+
+#include "mm-port-scheduler.h"
+
+#define MM_TYPE_PORT_SCHEDULER_PRIO            (mm_port_scheduler_prio_get_type ())
+#define MM_PORT_SCHEDULER_PRIO(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), MM_TYPE_PORT_SCHEDULER_PRIO, MMPortSchedulerPrio))
+#define MM_PORT_SCHEDULER_PRIO_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST ((klass),  MM_TYPE_PORT_SCHEDULER_PRIO, MMPortSchedulerPrioClass))
+#define MM_IS_PORT_SCHEDULER_PRIO(obj)         (G_TYPE_CHECK_INSTANCE_TYPE ((obj), MM_TYPE_PORT_SCHEDULER_PRIO))
+#define MM_IS_PORT_SCHEDULER_PRIO_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE ((klass),  MM_TYPE_PORT_SCHEDULER_PRIO))
+#define MM_PORT_SCHEDULER_PRIO_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS ((obj),  MM_TYPE_PORT_SCHEDULER_PRIO, MMPortSchedulerPrioClass))
+
+#define MM_PORT_SCHEDULER_PRIO_INTER_PORT_DELAY "inter-port-delay"
+#define MM_PORT_SCHEDULER_PRIO_AGING_INTERVAL   "aging-interval"
+
+/* Time a command may wait before being promoted one priority class, in ms */
+#define MM_PORT_SCHEDULER_PRIO_AGING_INTERVAL_DEFAULT 2000
+
+typedef struct _MMPortSchedulerPrio MMPortSchedulerPrio;
+typedef struct _MMPortSchedulerPrioClass MMPortSchedulerPrioClass;
+typedef struct _MMPortSchedulerPrioPrivate MMPortSchedulerPrioPrivate;
+
+struct _MMPortSchedulerPrio {
+    /*< private >*/
+    GObject parent;
+    MMPortSchedulerPrioPrivate *priv;
+};
+
+struct _MMPortSchedulerPrioClass {
+    /*< private >*/
+    GObjectClass parent;
+};
+
+GType mm_port_scheduler_prio_get_type (void);
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMPortSchedulerPrio, g_object_unref)
+
+MMPortSchedulerPrio *mm_port_scheduler_prio_new (void);
+
+#endif /* _MM_PORT_SCHEDULER_PRIO_H_ */
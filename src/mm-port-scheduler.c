@@ -57,6 +57,57 @@ mm_port_scheduler_notify_command_done (MMPortScheduler *self,
     MM_PORT_SCHEDULER_GET_INTERFACE (self)->notify_command_done (self, source, num_pending);
 }
 
+void
+mm_port_scheduler_notify_next_command (MMPortScheduler         *self,
+                                       gpointer                 source,
+                                       MMPortSchedulerPriority  priority,
+                                       gint64                   enqueued_time)
+{
+    /* Schedulers not caring about priorities don't need to implement this */
+    if (MM_PORT_SCHEDULER_GET_INTERFACE (self)->notify_next_command)
+        MM_PORT_SCHEDULER_GET_INTERFACE (self)->notify_next_command (self, source, priority, enqueued_time);
+}
+
+/*****************************************************************************/
+
+guint
+mm_port_scheduler_priority_get_rank (MMPortSchedulerPriority priority)
+{
+    switch (priority) {
+    case MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE:
+        return 0;
+    case MM_PORT_SCHEDULER_PRIORITY_CONTROL:
+        return 1;
+    case MM_PORT_SCHEDULER_PRIORITY_BACKGROUND:
+        return 2;
+    default:
+        g_assert_not_reached ();
+    }
+}
+
+void
+mm_port_scheduler_priority_queue_insert (GQueue                          *queue,
+                                         gpointer                         item,
+                                         MMPortSchedulerQueueGetPriority  get_priority)
+{
+    guint  rank;
+    GList *l;
+
+    rank = mm_port_scheduler_priority_get_rank (get_priority (item, NULL));
+
+    for (l = queue->head; l; l = g_list_next (l)) {
+        MMPortSchedulerPriority priority;
+        gboolean                started = FALSE;
+
+        priority = get_priority (l->data, &started);
+        if (!started && mm_port_scheduler_priority_get_rank (priority) > rank) {
+            g_queue_insert_before (queue, l, item);
+            return;
+        }
+    }
+    g_queue_push_tail (queue, item);
+}
+
 /*****************************************************************************/
 
 static void
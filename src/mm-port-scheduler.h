@@ -26,6 +26,31 @@ G_DECLARE_INTERFACE (MMPortScheduler, mm_port_scheduler, MM, PORT_SCHEDULER, GOb
 
 #define MM_PORT_SCHEDULER_SIGNAL_SEND_COMMAND "send-command"
 
+/* Priority classes for commands submitted to a source. CONTROL is the
+ * default so that zero-initialized command descriptions keep the plain
+ * FIFO behavior; INTERACTIVE is meant for commands that a user is waiting
+ * on (e.g. a D-Bus request), and BACKGROUND for periodic polling that
+ * may be delayed without consequences. */
+typedef enum {
+    MM_PORT_SCHEDULER_PRIORITY_CONTROL     = 0,
+    MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE = 1,
+    MM_PORT_SCHEDULER_PRIORITY_BACKGROUND  = 2,
+} MMPortSchedulerPriority;
+
+/* Numeric rank of a priority class; lower ranks are served first */
+guint mm_port_scheduler_priority_get_rank (MMPortSchedulerPriority priority);
+
+/* Inserts an item in the command queue of a source, after all the items
+ * with the same or better priority class and never in front of an item
+ * already started; FIFO within each class. The priority class and started
+ * state of the queued items are given by get_priority. */
+typedef MMPortSchedulerPriority (* MMPortSchedulerQueueGetPriority) (gpointer  item,
+                                                                     gboolean *started);
+
+void mm_port_scheduler_priority_queue_insert (GQueue                          *queue,
+                                              gpointer                         item,
+                                              MMPortSchedulerQueueGetPriority  get_priority);
+
 typedef struct _MMPortSchedulerInterface MMPortSchedulerInterface;
 
 struct _MMPortSchedulerInterface
@@ -51,6 +76,13 @@ struct _MMPortSchedulerInterface
     void (*notify_command_done) (MMPortScheduler *self,
                                  gpointer         source,
                                  guint            num_pending);
+
+    /* Optional: priority and submission time (monotonic, in us) of the
+     * next command the source would send if allowed */
+    void (*notify_next_command) (MMPortScheduler         *self,
+                                 gpointer                 source,
+                                 MMPortSchedulerPriority  priority,
+                                 gint64                   enqueued_time);
 };
 
 void mm_port_scheduler_register_source      (MMPortScheduler *self,
@@ -68,4 +100,9 @@ void  mm_port_scheduler_notify_command_done (MMPortScheduler *self,
                                              gpointer         source,
                                              guint            num_pending);
 
+void  mm_port_scheduler_notify_next_command (MMPortScheduler         *self,
+                                             gpointer                 source,
+                                             MMPortSchedulerPriority  priority,
+                                             gint64                   enqueued_time);
+
 #endif /* MM_PORT_SCHEDULER_H */
@@ -24,6 +24,7 @@
 #include "mm-iface-port-at.h"
 #include "mm-port-serial-at.h"
 #include "mm-log-object.h"
+#include "mm-perf-stats.h"
 
 static void iface_port_at_init (MMIfacePortAtInterface *iface);
 
@@ -36,6 +37,7 @@ enum {
     PROP_INIT_SEQUENCE_ENABLED,
     PROP_INIT_SEQUENCE,
     PROP_SEND_LF,
+    PROP_CONCATENATION,
     LAST_PROP
 };
 
@@ -55,6 +57,7 @@ struct _MMPortSerialAtPrivate {
     guint init_sequence_enabled;
     gchar **init_sequence;
     gboolean send_lf;
+    gboolean concatenation;
 };
 
 /*****************************************************************************/
@@ -137,8 +140,46 @@ typedef struct {
     gboolean enable;
     gpointer user_data;
     GDestroyNotify notify;
+    MMPerfStat *perf_stat;
 } MMAtUnsolicitedMsgHandler;
 
+/* Short name of the handler in the performance stats: the first AT prefix
+ * in the pattern (e.g. "+CREG" for "\\r\\n\\+CREG: (\\d+)\\r\\n"), or
+ * else the first upper case word (e.g. "RING"), or else the pattern itself */
+static gchar *
+unsolicited_msg_handler_perf_name (MMAtUnsolicitedMsgHandler *handler)
+{
+    const gchar *pattern;
+    const gchar *p;
+    const gchar *word = NULL;
+
+    pattern = g_regex_get_pattern (handler->regex);
+    for (p = pattern; *p; p++) {
+        const gchar *end;
+
+        if (*p == '\\' && p[1]) {
+            p++;
+            if (!strchr ("+^%*$", *p))
+                continue;
+        } else if (!strchr ("+^%*$", *p) && !g_ascii_isupper (*p))
+            continue;
+
+        for (end = p + 1; g_ascii_isalnum (*end) || *end == '_'; end++);
+        if (!g_ascii_isupper (*p)) {
+            if (end > p + 1)
+                return g_strndup (p, end - p);
+        } else if (!word && end > p + 1)
+            word = p;
+        p = end - 1;
+    }
+
+    if (word) {
+        for (p = word; g_ascii_isalnum (*p) || *p == '_'; p++);
+        return g_strndup (word, p - word);
+    }
+    return g_strdup (pattern);
+}
+
 static gint
 unsolicited_msg_handler_cmp (MMAtUnsolicitedMsgHandler *handler,
                              GRegex *regex)
@@ -174,6 +215,7 @@ mm_port_serial_at_add_unsolicited_msg_handler (MMPortSerialAt *self,
          * plugin. */
         handler = g_slice_new (MMAtUnsolicitedMsgHandler);
         handler->regex = g_regex_ref (regex);
+        handler->perf_stat = NULL;
         self->priv->unsolicited_msg_handlers = g_slist_prepend (self->priv->unsolicited_msg_handlers, handler);
     }
 
@@ -240,6 +282,16 @@ parse_unsolicited (MMPortSerial *port, GByteArray *response)
                                       (const char *) response->data,
                                       response->len,
                                       0, 0, &match_info, NULL);
+        if (matches && mm_perf_stats_enabled ()) {
+            if (G_UNLIKELY (!handler->perf_stat)) {
+                g_autofree gchar *name = NULL;
+
+                name = unsolicited_msg_handler_perf_name (handler);
+                handler->perf_stat = mm_perf_stats_lookup ("unsolicited", name);
+            }
+            _mm_perf_stat_add (handler->perf_stat, 1);
+        }
+
         if (handler->callback) {
             while (g_match_info_matches (match_info) && handler->callback) {
                 handler->callback (self, match_info, handler->user_data);
@@ -339,14 +391,15 @@ serial_command_ready (MMPortSerial *port,
 }
 
 void
-mm_port_serial_at_command (MMPortSerialAt *self,
-                           const char *command,
-                           guint32 timeout_seconds,
-                           gboolean is_raw,
-                           gboolean allow_cached,
-                           GCancellable *cancellable,
-                           GAsyncReadyCallback callback,
-                           gpointer user_data)
+mm_port_serial_at_command_full (MMPortSerialAt *self,
+                                const char *command,
+                                guint32 timeout_seconds,
+                                gboolean is_raw,
+                                gboolean allow_cached,
+                                MMPortSchedulerPriority priority,
+                                GCancellable *cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data)
 {
     GByteArray *buf;
     GTask *task;
@@ -369,12 +422,34 @@ mm_port_serial_at_command (MMPortSerialAt *self,
                             timeout_seconds,
                             allow_cached,
                             is_raw, /* raw commands always run next, never queued last */
+                            priority,
                             cancellable,
                             (GAsyncReadyCallback)serial_command_ready,
                             task);
     g_byte_array_unref (buf);
 }
 
+void
+mm_port_serial_at_command (MMPortSerialAt *self,
+                           const char *command,
+                           guint32 timeout_seconds,
+                           gboolean is_raw,
+                           gboolean allow_cached,
+                           GCancellable *cancellable,
+                           GAsyncReadyCallback callback,
+                           gpointer user_data)
+{
+    mm_port_serial_at_command_full (self,
+                                    command,
+                                    timeout_seconds,
+                                    is_raw,
+                                    allow_cached,
+                                    MM_PORT_SCHEDULER_PRIORITY_CONTROL,
+                                    cancellable,
+                                    callback,
+                                    user_data);
+}
+
 /*****************************************************************************/
 /* Integration with the Port AT interface */
 
@@ -387,23 +462,25 @@ iface_port_at_command_finish (MMIfacePortAt  *self,
 }
 
 static void
-iface_port_at_command (MMIfacePortAt        *self,
-                       const gchar          *command,
-                       guint32               timeout_seconds,
-                       gboolean              is_raw,
-                       gboolean              allow_cached,
-                       GCancellable         *cancellable,
-                       GAsyncReadyCallback   callback,
-                       gpointer              user_data)
+iface_port_at_command (MMIfacePortAt           *self,
+                       const gchar             *command,
+                       guint32                  timeout_seconds,
+                       gboolean                 is_raw,
+                       gboolean                 allow_cached,
+                       MMPortSchedulerPriority  priority,
+                       GCancellable            *cancellable,
+                       GAsyncReadyCallback      callback,
+                       gpointer                 user_data)
 {
-    mm_port_serial_at_command (MM_PORT_SERIAL_AT (self),
-                               command,
-                               timeout_seconds,
-                               is_raw,
-                               allow_cached,
-                               cancellable,
-                               callback,
-                               user_data);
+    mm_port_serial_at_command_full (MM_PORT_SERIAL_AT (self),
+                                    command,
+                                    timeout_seconds,
+                                    is_raw,
+                                    allow_cached,
+                                    priority,
+                                    cancellable,
+                                    callback,
+                                    user_data);
 }
 
 /*****************************************************************************/
@@ -414,32 +491,7 @@ debug_log (MMPortSerial *self,
            const gchar  *buf,
            gsize         len)
 {
-    static GString *debug = NULL;
-    const  char    *s;
-
-    if (!debug)
-        debug = g_string_sized_new (256);
-
-    g_string_append (debug, prefix);
-    g_string_append (debug, " '");
-
-    s = buf;
-    while (len--) {
-        if (g_ascii_isprint (*s))
-            g_string_append_c (debug, *s);
-        else if (*s == '\r')
-            g_string_append (debug, "<CR>");
-        else if (*s == '\n')
-            g_string_append (debug, "<LF>");
-        else
-            g_string_append_printf (debug, "\\%u", (guint8) (*s & 0xFF));
-
-        s++;
-    }
-
-    g_string_append_c (debug, '\'');
-    mm_obj_dbg (self, "%s", debug->str);
-    g_string_truncate (debug, 0);
+    mm_obj_dbg_buffer (self, prefix, MM_LOG_BUFFER_FORMAT_TEXT, (const guint8 *) buf, len);
 }
 
 void
@@ -550,6 +602,9 @@ set_property (GObject *object,
     case PROP_SEND_LF:
         self->priv->send_lf = g_value_get_boolean (value);
         break;
+    case PROP_CONCATENATION:
+        self->priv->concatenation = g_value_get_boolean (value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -577,6 +632,9 @@ get_property (GObject *object,
     case PROP_SEND_LF:
         g_value_set_boolean (value, self->priv->send_lf);
         break;
+    case PROP_CONCATENATION:
+        g_value_set_boolean (value, self->priv->concatenation);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -665,4 +723,12 @@ mm_port_serial_at_class_init (MMPortSerialAtClass *klass)
                                "Send line-feed at the end of each AT command sent",
                                FALSE,
                                G_PARAM_READWRITE));
+
+    g_object_class_install_property
+        (object_class, PROP_CONCATENATION,
+         g_param_spec_boolean (MM_PORT_SERIAL_AT_CONCATENATION,
+                               "Concatenation",
+                               "Whether several extended commands may be concatenated in a single command line",
+                               FALSE,
+                               G_PARAM_READWRITE));
 }
@@ -72,6 +72,7 @@ typedef void (*MMPortSerialAtRemoveEchoFn)     (gpointer    user_data,
 #define MM_PORT_SERIAL_AT_INIT_SEQUENCE_ENABLED "init-sequence-enabled"
 #define MM_PORT_SERIAL_AT_INIT_SEQUENCE         "init-sequence"
 #define MM_PORT_SERIAL_AT_SEND_LF               "send-lf"
+#define MM_PORT_SERIAL_AT_CONCATENATION         "concatenation"
 
 struct _MMPortSerialAt {
     MMPortSerial parent;
@@ -112,6 +113,15 @@ void         mm_port_serial_at_command        (MMPortSerialAt *self,
                                                GCancellable *cancellable,
                                                GAsyncReadyCallback callback,
                                                gpointer user_data);
+void         mm_port_serial_at_command_full   (MMPortSerialAt *self,
+                                               const char *command,
+                                               guint32 timeout_seconds,
+                                               gboolean is_raw,
+                                               gboolean allow_cached,
+                                               MMPortSchedulerPriority priority,
+                                               GCancellable *cancellable,
+                                               GAsyncReadyCallback callback,
+                                               gpointer user_data);
 gchar *mm_port_serial_at_command_finish       (MMPortSerialAt *self,
                                                GAsyncResult *res,
                                                GError **error);
@@ -138,32 +138,7 @@ debug_log (MMPortSerial *self,
            const gchar  *buf,
            gsize         len)
 {
-    static GString *debug = NULL;
-    const gchar    *s;
-
-    if (!debug)
-        debug = g_string_sized_new (256);
-
-    g_string_append (debug, prefix);
-    g_string_append (debug, " '");
-
-    s = buf;
-    while (len--) {
-        if (g_ascii_isprint (*s))
-            g_string_append_c (debug, *s);
-        else if (*s == '\r')
-            g_string_append (debug, "<CR>");
-        else if (*s == '\n')
-            g_string_append (debug, "<LF>");
-        else
-            g_string_append_printf (debug, "\\%u", (guint8) (*s & 0xFF));
-
-        s++;
-    }
-
-    g_string_append_c (debug, '\'');
-    mm_obj_dbg (self, "%s", debug->str);
-    g_string_truncate (debug, 0);
+    mm_obj_dbg_buffer (self, prefix, MM_LOG_BUFFER_FORMAT_TEXT, (const guint8 *) buf, len);
 }
 
 /*****************************************************************************/
@@ -216,6 +216,7 @@ mm_port_serial_qcdm_command (MMPortSerialQcdm *self,
                             timeout_seconds,
                             FALSE, /* never cached */
                             FALSE, /* always queued last */
+                            MM_PORT_SCHEDULER_PRIORITY_CONTROL,
                             cancellable,
                             (GAsyncReadyCallback)serial_command_ready,
                             task);
@@ -227,19 +228,7 @@ debug_log (MMPortSerial *self,
            const gchar  *buf,
            gsize         len)
 {
-    static GString *debug = NULL;
-    const gchar    *s = buf;
-
-    if (!debug)
-        debug = g_string_sized_new (512);
-
-    g_string_append (debug, prefix);
-
-    while (len--)
-        g_string_append_printf (debug, " %02x", (guint8) (*s++ & 0xFF));
-
-    mm_obj_dbg (self, "%s", debug->str);
-    g_string_truncate (debug, 0);
+    mm_obj_dbg_buffer (self, prefix, MM_LOG_BUFFER_FORMAT_HEX, (const guint8 *) buf, len);
 }
 
 /*****************************************************************************/
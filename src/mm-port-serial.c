@@ -35,9 +35,11 @@
 
 #include "mm-port-serial.h"
 #include "mm-log-object.h"
+#include "mm-perf-stats.h"
 #include "mm-helper-enums-types.h"
 #include "mm-port-scheduler.h"
 #include "mm-port-scheduler-rr.h"
+#include "mm-port-scheduler-prio.h"
 
 static gboolean port_serial_queue_process          (gpointer data);
 static void     port_serial_schedule_queue_process (MMPortSerial *self,
@@ -76,6 +78,16 @@ static guint signals[LAST_SIGNAL] = { 0 };
 
 #define SERIAL_BUF_SIZE 2048
 
+typedef enum {
+    PERF_STAT_COMMANDS_SENT,
+    PERF_STAT_BYTES_OUT,
+    PERF_STAT_BYTES_IN,
+    PERF_STAT_RESPONSE_LATENCY,
+    PERF_STAT_TIMEOUTS,
+    PERF_STAT_CACHED_REPLIES,
+    PERF_STAT_LAST
+} PerfStat;
+
 struct _MMPortSerialPrivate {
     guint32 open_count;
     gboolean forced_close;
@@ -87,6 +99,7 @@ struct _MMPortSerialPrivate {
     /* Command scheduler */
     MMPortScheduler *scheduler;
     guint            scheduler_send_id;
+    gboolean         scheduler_prio;
 
     /* For real ports, iochannel, and we implement the eagain limit */
     GIOChannel *iochannel;
@@ -117,8 +130,37 @@ struct _MMPortSerialPrivate {
 
     GTask *flash_task;
     GTask *reopen_task;
+
+    /* Performance stats, looked up when first used */
+    MMPerfStat *perf_stats[PERF_STAT_LAST];
+};
+
+/*****************************************************************************/
+
+static const gchar *perf_stat_names[] = {
+    [PERF_STAT_COMMANDS_SENT]    = "commands-sent",
+    [PERF_STAT_BYTES_OUT]        = "bytes-out",
+    [PERF_STAT_BYTES_IN]         = "bytes-in",
+    [PERF_STAT_RESPONSE_LATENCY] = "response-latency",
+    [PERF_STAT_TIMEOUTS]         = "timeouts",
+    [PERF_STAT_CACHED_REPLIES]   = "cached-replies",
 };
 
+G_STATIC_ASSERT (G_N_ELEMENTS (perf_stat_names) == PERF_STAT_LAST);
+
+static MMPerfStat *
+port_serial_perf_stat (MMPortSerial *self,
+                       PerfStat      stat)
+{
+    if (G_UNLIKELY (!self->priv->perf_stats[stat])) {
+        g_autofree gchar *group = NULL;
+
+        group = g_strdup_printf ("port/%s", mm_port_get_device (MM_PORT (self)));
+        self->priv->perf_stats[stat] = mm_perf_stats_lookup (group, perf_stat_names[stat]);
+    }
+    return self->priv->perf_stats[stat];
+}
+
 /*****************************************************************************/
 /* Command */
 
@@ -131,6 +173,10 @@ typedef struct {
     guint32 idx;
     gboolean started;
     gboolean done;
+    gint64 start_time;
+
+    MMPortSchedulerPriority priority;
+    gint64 enqueued_time;
 } CommandContext;
 
 static void
@@ -140,6 +186,53 @@ command_context_free (CommandContext *ctx)
     g_slice_free (CommandContext, ctx);
 }
 
+static void
+port_serial_notify_next_command (MMPortSerial *self)
+{
+    GList *l;
+
+    /* Report the first command not yet sent, i.e. skipping the one
+     * currently in progress */
+    for (l = self->priv->queue->head; l; l = g_list_next (l)) {
+        CommandContext *ctx;
+
+        ctx = g_task_get_task_data (G_TASK (l->data));
+        if (!ctx->started) {
+            mm_port_scheduler_notify_next_command (self->priv->scheduler,
+                                                   self,
+                                                   ctx->priority,
+                                                   ctx->enqueued_time);
+            return;
+        }
+    }
+}
+
+static MMPortSchedulerPriority
+port_serial_queue_get_priority (gpointer  item,
+                                gboolean *started)
+{
+    CommandContext *ctx;
+
+    ctx = g_task_get_task_data (G_TASK (item));
+    if (started)
+        *started = ctx->started;
+    return ctx->priority;
+}
+
+static void
+port_serial_queue_insert (MMPortSerial *self,
+                          GTask        *task)
+{
+    /* Commands are only reordered when a priority-aware scheduler is in
+     * use, otherwise the queue is plain FIFO */
+    if (!self->priv->scheduler_prio) {
+        g_queue_push_tail (self->priv->queue, task);
+        return;
+    }
+
+    mm_port_scheduler_priority_queue_insert (self->priv->queue, task, port_serial_queue_get_priority);
+}
+
 GByteArray *
 mm_port_serial_command_finish (MMPortSerial *self,
                                GAsyncResult *res,
@@ -154,6 +247,7 @@ mm_port_serial_command (MMPortSerial *self,
                         guint32 timeout_seconds,
                         gboolean allow_cached,
                         gboolean run_next,
+                        MMPortSchedulerPriority priority,
                         GCancellable *cancellable,
                         GAsyncReadyCallback callback,
                         gpointer user_data)
@@ -173,6 +267,8 @@ mm_port_serial_command (MMPortSerial *self,
     ctx->command = g_byte_array_ref (command);
     ctx->allow_cached = allow_cached;
     ctx->timeout = timeout_seconds;
+    ctx->priority = priority;
+    ctx->enqueued_time = g_get_monotonic_time ();
 
     /* Only accept about 3 seconds of EAGAIN for this command */
     if (self->priv->send_delay && mm_port_get_subsys (MM_PORT (self)) == MM_PORT_SUBSYS_TTY)
@@ -198,8 +294,9 @@ mm_port_serial_command (MMPortSerial *self,
     if (run_next)
         g_queue_push_head (self->priv->queue, task);
     else
-        g_queue_push_tail (self->priv->queue, task);
+        port_serial_queue_insert (self, task);
 
+    port_serial_notify_next_command (self);
     mm_port_scheduler_notify_num_pending (self->priv->scheduler,
                                           self,
                                           g_queue_get_length (self->priv->queue));
@@ -551,6 +648,11 @@ port_serial_process_command (MMPortSerial *self,
     if (ctx->started == FALSE) {
         ctx->started = TRUE;
         serial_debug (self, "-->", (const gchar *) ctx->command->data, ctx->command->len);
+        if (mm_perf_stats_enabled ()) {
+            ctx->start_time = g_get_monotonic_time ();
+            _mm_perf_stat_add (port_serial_perf_stat (self, PERF_STAT_COMMANDS_SENT), 1);
+            _mm_perf_stat_add (port_serial_perf_stat (self, PERF_STAT_BYTES_OUT), ctx->command->len);
+        }
     }
 
     if (self->priv->send_delay == 0 || mm_port_get_subsys (MM_PORT (self)) != MM_PORT_SUBSYS_TTY) {
@@ -678,6 +780,14 @@ port_serial_get_cached_reply (MMPortSerial *self,
     return (const GByteArray *)g_hash_table_lookup (self->priv->reply_cache, command);
 }
 
+void
+mm_port_serial_reset_reply_cache (MMPortSerial *self)
+{
+    g_return_if_fail (MM_IS_PORT_SERIAL (self));
+
+    g_hash_table_remove_all (self->priv->reply_cache);
+}
+
 static void
 port_serial_schedule_queue_process (MMPortSerial *self, guint timeout_ms)
 {
@@ -736,6 +846,9 @@ port_serial_got_response (MMPortSerial *self,
                 CommandContext *ctx;
 
                 ctx = g_task_get_task_data (task);
+                if (ctx->start_time)
+                    mm_perf_stat_add_latency (port_serial_perf_stat (self, PERF_STAT_RESPONSE_LATENCY),
+                                              g_get_monotonic_time () - ctx->start_time);
                 if (ctx->allow_cached)
                     port_serial_set_cached_reply (self, ctx->command, parsed_response);
                 g_task_return_pointer (task,
@@ -745,6 +858,7 @@ port_serial_got_response (MMPortSerial *self,
 
             g_object_unref (task);
 
+            port_serial_notify_next_command (self);
             mm_port_scheduler_notify_command_done (self->priv->scheduler,
                                                    self,
                                                    g_queue_get_length (self->priv->queue));
@@ -764,6 +878,7 @@ port_serial_timed_out (gpointer data)
 
     /* Update number of consecutive timeouts found */
     self->priv->n_consecutive_timeouts++;
+    mm_perf_stat_inc (port_serial_perf_stat (self, PERF_STAT_TIMEOUTS));
 
     /* FIXME: This is not completely correct - if the response finally arrives and there's
      * some other command waiting for response right now, the other command will
@@ -828,6 +943,8 @@ port_serial_queue_process (gpointer data)
         if (cached) {
             GByteArray *parsed_response;
 
+            mm_perf_stat_inc (port_serial_perf_stat (self, PERF_STAT_CACHED_REPLIES));
+
             parsed_response = g_byte_array_sized_new (cached->len);
             g_byte_array_append (parsed_response, cached->data, cached->len);
             /* Note: may complete last operation and unref the MMPortSerial */
@@ -1032,6 +1149,7 @@ common_input_available (MMPortSerial *self,
 
         g_assert (bytes_read > 0);
         serial_debug (self, "<--", buf, bytes_read);
+        mm_perf_stat_add (port_serial_perf_stat (self, PERF_STAT_BYTES_IN), bytes_read);
         g_byte_array_append (self->priv->response, (const guint8 *) buf, bytes_read);
 
         /* See if we can parse anything. The response parsing may actually
@@ -1962,6 +2080,7 @@ static void
 scheduler_setup (MMPortSerial *self, MMPortScheduler *scheduler)
 {
     self->priv->scheduler = scheduler;
+    self->priv->scheduler_prio = (scheduler && MM_IS_PORT_SCHEDULER_PRIO (scheduler));
     if (self->priv->scheduler) {
         const gchar *port_name;
 
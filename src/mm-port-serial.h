@@ -23,6 +23,7 @@
 
 #include "mm-modem-helpers.h"
 #include "mm-port.h"
+#include "mm-port-scheduler.h"
 
 #define MM_TYPE_PORT_SERIAL            (mm_port_serial_get_type ())
 #define MM_PORT_SERIAL(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), MM_TYPE_PORT_SERIAL, MMPortSerial))
@@ -151,11 +152,15 @@ gboolean mm_port_serial_flush             (MMPortSerial *self,
                                            MMPortSerialFlushType type,
                                            GError **error);
 
+/* Drops all replies cached for commands run with allow_cached */
+void     mm_port_serial_reset_reply_cache (MMPortSerial *self);
+
 void        mm_port_serial_command        (MMPortSerial *self,
                                            GByteArray *command,
                                            guint32 timeout_seconds,
                                            gboolean allow_cached,
                                            gboolean run_next,
+                                           MMPortSchedulerPriority priority,
                                            GCancellable *cancellable,
                                            GAsyncReadyCallback callback,
                                            gpointer user_data);
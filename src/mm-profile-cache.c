@@ -0,0 +1,185 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-profile-cache.h"
+#include "mm-modem-helpers.h"
+
+struct _MMProfileCache {
+    gboolean  enabled;
+    gboolean  valid;
+    guint     generation;
+    GList    *profiles;
+};
+
+/*****************************************************************************/
+
+static MM3gppProfile *
+profile_dup (MM3gppProfile *profile)
+{
+    g_autoptr(GVariant) dict = NULL;
+
+    dict = mm_3gpp_profile_get_dictionary (profile);
+    return mm_3gpp_profile_new_from_dictionary (dict, NULL);
+}
+
+static GList *
+profile_list_dup (GList *profiles)
+{
+    GList *copy = NULL;
+    GList *l;
+
+    /* Callers own the returned profiles, so never give them the cached ones */
+    for (l = profiles; l; l = g_list_next (l)) {
+        MM3gppProfile *profile;
+
+        profile = profile_dup (MM_3GPP_PROFILE (l->data));
+        if (profile)
+            copy = g_list_prepend (copy, profile);
+    }
+    return g_list_reverse (copy);
+}
+
+static gint
+profile_id_cmp (MM3gppProfile *a,
+                MM3gppProfile *b)
+{
+    return mm_3gpp_profile_get_profile_id (a) - mm_3gpp_profile_get_profile_id (b);
+}
+
+/*****************************************************************************/
+
+gboolean
+mm_profile_cache_invalidate (MMProfileCache *self)
+{
+    gboolean was_valid;
+
+    was_valid = self->valid;
+    self->valid = FALSE;
+    self->generation++;
+    g_clear_pointer (&self->profiles, mm_3gpp_profile_list_free);
+    return was_valid;
+}
+
+void
+mm_profile_cache_set_enabled (MMProfileCache *self,
+                              gboolean        enabled)
+{
+    self->enabled = enabled;
+    mm_profile_cache_invalidate (self);
+}
+
+gboolean
+mm_profile_cache_is_valid (MMProfileCache *self)
+{
+    return self->valid;
+}
+
+guint
+mm_profile_cache_get_generation (MMProfileCache *self)
+{
+    return self->generation;
+}
+
+gboolean
+mm_profile_cache_set_list (MMProfileCache *self,
+                           guint           generation,
+                           GList          *profiles)
+{
+    if (!self->enabled || generation != self->generation)
+        return FALSE;
+
+    g_clear_pointer (&self->profiles, mm_3gpp_profile_list_free);
+    self->profiles = profile_list_dup (profiles);
+    self->valid = TRUE;
+    return TRUE;
+}
+
+GList *
+mm_profile_cache_dup_list (MMProfileCache *self)
+{
+    g_assert (self->valid);
+    return profile_list_dup (self->profiles);
+}
+
+MM3gppProfile *
+mm_profile_cache_dup_profile (MMProfileCache  *self,
+                              gint             profile_id,
+                              GError         **error)
+{
+    g_autoptr(MM3gppProfile) cached = NULL;
+
+    g_assert (self->valid);
+    cached = mm_3gpp_profile_list_find_by_profile_id (self->profiles, profile_id, error);
+    return cached ? profile_dup (cached) : NULL;
+}
+
+void
+mm_profile_cache_remove (MMProfileCache *self,
+                         gint            profile_id)
+{
+    GList *l;
+
+    if (!self->valid)
+        return;
+
+    for (l = self->profiles; l; l = g_list_next (l)) {
+        if (mm_3gpp_profile_get_profile_id (MM_3GPP_PROFILE (l->data)) == profile_id) {
+            g_object_unref (l->data);
+            self->profiles = g_list_delete_link (self->profiles, l);
+            return;
+        }
+    }
+}
+
+void
+mm_profile_cache_update (MMProfileCache *self,
+                         guint           generation,
+                         MM3gppProfile  *profile)
+{
+    MM3gppProfile *copy;
+
+    if (!self->valid || generation != self->generation)
+        return;
+
+    copy = profile_dup (profile);
+    if (!copy) {
+        mm_profile_cache_invalidate (self);
+        return;
+    }
+
+    mm_profile_cache_remove (self, mm_3gpp_profile_get_profile_id (profile));
+    self->profiles = g_list_insert_sorted (self->profiles, copy, (GCompareFunc) profile_id_cmp);
+}
+
+/*****************************************************************************/
+
+MMProfileCache *
+mm_profile_cache_new (void)
+{
+    return g_slice_new0 (MMProfileCache);
+}
+
+void
+mm_profile_cache_free (MMProfileCache *self)
+{
+    mm_3gpp_profile_list_free (self->profiles);
+    g_slice_free (MMProfileCache, self);
+}
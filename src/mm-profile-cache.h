@@ -0,0 +1,65 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_PROFILE_CACHE_H
+#define MM_PROFILE_CACHE_H
+
+#include <glib.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+/* In-memory cache of the list of 3GPP profiles stored in a modem.
+ *
+ * Every invalidation bumps a generation counter. Results of operations
+ * started before the last invalidation (i.e. with an older generation) may
+ * not reflect the latest changes, so they are never stored in the cache. */
+
+typedef struct _MMProfileCache MMProfileCache;
+
+MMProfileCache *mm_profile_cache_new            (void);
+void            mm_profile_cache_free           (MMProfileCache *self);
+
+void            mm_profile_cache_set_enabled    (MMProfileCache *self,
+                                                 gboolean        enabled);
+gboolean        mm_profile_cache_is_valid       (MMProfileCache *self);
+guint           mm_profile_cache_get_generation (MMProfileCache *self);
+
+/* Returns TRUE if the cache was valid */
+gboolean        mm_profile_cache_invalidate     (MMProfileCache *self);
+
+/* Returns TRUE if the list was stored */
+gboolean        mm_profile_cache_set_list       (MMProfileCache *self,
+                                                 guint           generation,
+                                                 GList          *profiles);
+
+/* Both return new copies of the cached profiles; only valid caches can be
+ * queried */
+GList          *mm_profile_cache_dup_list       (MMProfileCache  *self);
+MM3gppProfile  *mm_profile_cache_dup_profile    (MMProfileCache  *self,
+                                                 gint             profile_id,
+                                                 GError         **error);
+
+/* Both are ignored if the cache isn't valid; the update is also ignored if
+ * it comes from an operation started before the last invalidation */
+void            mm_profile_cache_update         (MMProfileCache  *self,
+                                                 guint            generation,
+                                                 MM3gppProfile   *profile);
+void            mm_profile_cache_remove         (MMProfileCache  *self,
+                                                 gint             profile_id);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMProfileCache, mm_profile_cache_free)
+
+#endif /* MM_PROFILE_CACHE_H */
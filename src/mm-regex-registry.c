@@ -0,0 +1,108 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include "mm-regex-registry.h"
+#include "mm-perf-stats.h"
+
+typedef struct {
+    gchar              *pattern;
+    GRegexCompileFlags  compile_options;
+    GRegexMatchFlags    match_options;
+} RegistryKey;
+
+/* Keys are RegistryKey, values are GRegex */
+static GHashTable *registry;
+static guint       n_compiled;
+
+static guint
+registry_key_hash (const RegistryKey *key)
+{
+    return g_str_hash (key->pattern) ^ (guint) key->compile_options ^ ((guint) key->match_options << 16);
+}
+
+static gboolean
+registry_key_equal (const RegistryKey *a,
+                    const RegistryKey *b)
+{
+    return (a->compile_options == b->compile_options &&
+            a->match_options == b->match_options &&
+            g_str_equal (a->pattern, b->pattern));
+}
+
+static void
+registry_key_free (RegistryKey *key)
+{
+    g_free (key->pattern);
+    g_slice_free (RegistryKey, key);
+}
+
+/*****************************************************************************/
+
+GRegex *
+mm_regex_registry_get (const gchar        *pattern,
+                       GRegexCompileFlags  compile_options,
+                       GRegexMatchFlags    match_options)
+{
+    g_autoptr(GError)  error = NULL;
+    RegistryKey        lookup;
+    RegistryKey       *key;
+    GRegex            *regex;
+
+    if (G_UNLIKELY (!registry))
+        registry = g_hash_table_new_full ((GHashFunc)  registry_key_hash,
+                                          (GEqualFunc) registry_key_equal,
+                                          (GDestroyNotify) registry_key_free,
+                                          (GDestroyNotify) g_regex_unref);
+
+    compile_options |= G_REGEX_OPTIMIZE;
+
+    /* The lookup key is never modified, so it's fine to avoid the copy */
+    lookup.pattern = (gchar *) pattern;
+    lookup.compile_options = compile_options;
+    lookup.match_options = match_options;
+
+    regex = g_hash_table_lookup (registry, &lookup);
+    if (G_LIKELY (regex)) {
+        mm_perf_stats_inc ("regex", "hits");
+        return regex;
+    }
+
+    regex = g_regex_new (pattern, compile_options, match_options, &error);
+    if (!regex)
+        g_error ("couldn't compile regex '%s': %s", pattern, error->message);
+
+    key = g_slice_new (RegistryKey);
+    key->pattern = g_strdup (pattern);
+    key->compile_options = compile_options;
+    key->match_options = match_options;
+    g_hash_table_insert (registry, key, regex);
+
+    n_compiled++;
+    mm_perf_stats_inc ("regex", "compiled");
+    return regex;
+}
+
+guint
+mm_regex_registry_get_n_compiled (void)
+{
+    return n_compiled;
+}
+
+void
+mm_regex_registry_clear (void)
+{
+    g_clear_pointer (&registry, g_hash_table_unref);
+    n_compiled = 0;
+}
@@ -0,0 +1,40 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_REGEX_REGISTRY_H
+#define MM_REGEX_REGISTRY_H
+
+#include <glib.h>
+
+/* Process-wide registry of compiled regular expressions.
+ *
+ * Response parsers that run periodically should not compile the same pattern
+ * over and over again; instead, they get a borrowed compiled regex from this
+ * registry, which compiles each pattern only once, the first time it's
+ * requested, and always with G_REGEX_OPTIMIZE (JIT, if available).
+ *
+ * Only constant patterns must be used, as compiled patterns are never
+ * released until the registry is cleared. The returned GRegex must not be
+ * unref-ed by the caller.
+ *
+ * Only to be used from the main context. */
+
+GRegex *mm_regex_registry_get             (const gchar        *pattern,
+                                           GRegexCompileFlags  compile_options,
+                                           GRegexMatchFlags    match_options);
+guint   mm_regex_registry_get_n_compiled  (void);
+void    mm_regex_registry_clear           (void);
+
+#endif /* MM_REGEX_REGISTRY_H */
@@ -31,6 +31,7 @@
 #include "mm-iface-modem-3gpp.h"
 #include "mm-iface-modem-location.h"
 #include "mm-location-cache.h"
+#include "mm-carrier-config-cache.h"
 #include "mm-sim-qmi.h"
 #include "mm-shared-qmi.h"
 #include "mm-modem-helpers-qmi.h"
@@ -94,6 +95,8 @@ typedef struct {
 
     gulong                          loc_assistance_inject_time_req_indication_id;
     gulong                          loc_assistance_inject_position_req_indication_id;
+    GBytes                         *loc_assistance_data;
+    gint64                          loc_assistance_data_time;
 
     /* Carrier config helpers */
     gboolean  config_active_default;
@@ -146,6 +149,8 @@ private_free (Private *priv)
     if (priv->feature_nas_ssp_acquisition_order_preference_array)
         g_array_unref (priv->feature_nas_ssp_acquisition_order_preference_array);
     g_strfreev (priv->loc_assistance_data_servers);
+    if (priv->loc_assistance_data)
+        g_bytes_unref (priv->loc_assistance_data);
     g_slice_free (Private, priv);
 }
 
@@ -2835,6 +2840,12 @@ typedef struct {
     gboolean      config_active_default;
     gint          config_active_i;
 
+    /* Details of the configs, as found in a previous run */
+    gchar        *cache_filename;
+    gchar        *cache_revision;
+    GArray       *cache;
+    gboolean      cache_outdated;
+
     guint         token;
     guint         timeout_id;
     gulong        list_configs_indication_id;
@@ -2872,6 +2883,10 @@ load_carrier_config_context_free (LoadCarrierConfigContext *ctx)
 
     if (ctx->config_list)
         g_array_unref (ctx->config_list);
+    if (ctx->cache)
+        g_array_unref (ctx->cache);
+    g_free (ctx->cache_filename);
+    g_free (ctx->cache_revision);
     g_clear_object (&ctx->client);
     g_slice_free (LoadCarrierConfigContext, ctx);
 }
@@ -3142,20 +3157,21 @@ list_configs_indication (QmiClientPdc                      *client,
         return;
     }
 
-    /* Preallocate config list and request details for each */
+    /* Preallocate config list and request details for each, unless already
+     * known from a previous run */
     mm_obj_dbg (self, "found %u carrier configurations...", configs->len);
     ctx->config_list = g_array_sized_new (FALSE, TRUE, sizeof (ConfigInfo), configs->len);
     g_array_set_size (ctx->config_list, configs->len);
     g_array_set_clear_func (ctx->config_list, (GDestroyNotify) config_info_clear);
 
-    ctx->get_config_info_indication_id = g_signal_connect (ctx->client,
-                                                           "get-config-info",
-                                                           G_CALLBACK (get_config_info_indication),
-                                                           task);
+    /* Configs removed since the cache was written */
+    if (ctx->cache && ctx->cache->len != configs->len)
+        ctx->cache_outdated = TRUE;
 
     for (i = 0; i < configs->len; i++) {
         ConfigInfo                                      *current_info;
         QmiIndicationPdcListConfigsOutputConfigsElement *element;
+        const MMCarrierConfigCacheEntry                 *cached;
         g_autoptr(QmiMessagePdcGetConfigInfoInput)       input = NULL;
 
         element = &g_array_index (configs, QmiIndicationPdcListConfigsOutputConfigsElement, i);
@@ -3165,11 +3181,35 @@ list_configs_indication (QmiClientPdc                      *client,
         current_info->id          = g_array_ref (element->id);
         current_info->config_type = element->config_type;
 
+        cached = mm_carrier_config_cache_lookup (ctx->cache, element->config_type, element->id);
+        if (cached) {
+            current_info->version     = cached->version;
+            current_info->total_size  = cached->total_size;
+            current_info->description = g_strdup (cached->description);
+            ctx->configs_loaded++;
+            continue;
+        }
+
+        if (!ctx->get_config_info_indication_id)
+            ctx->get_config_info_indication_id = g_signal_connect (ctx->client,
+                                                                   "get-config-info",
+                                                                   G_CALLBACK (get_config_info_indication),
+                                                                   task);
+        ctx->cache_outdated = TRUE;
+
         input = qmi_message_pdc_get_config_info_input_new ();
         qmi_message_pdc_get_config_info_input_set_type_with_id_v2 (input, element->config_type, current_info->id, NULL);
         qmi_message_pdc_get_config_info_input_set_token (input, current_info->token, NULL);
         qmi_client_pdc_get_config_info (ctx->client, input, 10, NULL, NULL, NULL); /* ignore response! */
     }
+
+    /* If all details were cached, only the selected config is left to query */
+    if (ctx->configs_loaded == ctx->config_list->len) {
+        mm_obj_dbg (self, "carrier configuration details loaded from cache");
+        load_carrier_config_context_cleanup_action (ctx);
+        ctx->step++;
+        load_carrier_config_step (task);
+    }
 }
 
 static void
@@ -3201,14 +3241,47 @@ out:
         qmi_message_pdc_list_configs_output_unref (output);
 }
 
+static void
+load_carrier_config_cache_save (MMSharedQmi              *self,
+                                LoadCarrierConfigContext *ctx)
+{
+    g_autoptr(GArray)  entries = NULL;
+    g_autoptr(GError)  error = NULL;
+    guint              i;
+
+    /* Entries reference the config list contents, they're not owned */
+    entries = g_array_sized_new (FALSE, TRUE, sizeof (MMCarrierConfigCacheEntry), ctx->config_list->len);
+    for (i = 0; i < ctx->config_list->len; i++) {
+        ConfigInfo                *config;
+        MMCarrierConfigCacheEntry  entry;
+
+        config = &g_array_index (ctx->config_list, ConfigInfo, i);
+        entry.id          = config->id;
+        entry.config_type = config->config_type;
+        entry.version     = config->version;
+        entry.description = config->description;
+        entry.total_size  = config->total_size;
+        g_array_append_val (entries, entry);
+    }
+
+    if (!mm_carrier_config_cache_save (ctx->cache_filename,
+                                       ctx->cache_revision,
+                                       (const MMCarrierConfigCacheEntry *) entries->data,
+                                       entries->len,
+                                       &error))
+        mm_obj_dbg (self, "couldn't save carrier config cache: %s", error->message);
+}
+
 static void
 load_carrier_config_step (GTask *task)
 {
+    MMSharedQmi              *self;
     LoadCarrierConfigContext *ctx;
     Private                  *priv;
 
+    self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
-    priv = get_private (g_task_get_source_object (task));
+    priv = get_private (self);
 
     switch (ctx->step) {
     case LOAD_CARRIER_CONFIG_STEP_FIRST:
@@ -3256,6 +3329,9 @@ load_carrier_config_step (GTask *task)
         priv->config_active_i = ctx->config_active_i;
         priv->config_active_default = ctx->config_active_default;
 
+        if (ctx->cache_filename && ctx->cache_outdated && ctx->config_list)
+            load_carrier_config_cache_save (self, ctx);
+
         g_task_return_boolean (task, TRUE);
         g_object_unref (task);
         break;
@@ -3273,7 +3349,7 @@ mm_shared_qmi_load_carrier_config (MMIfaceModem        *self,
     LoadCarrierConfigContext *ctx;
     GTask                    *task;
     QmiClient                *client = NULL;
-
+    const gchar              *revision;
 
     task = g_task_new (self, NULL, callback, user_data);
     ctx = g_slice_new0 (LoadCarrierConfigContext);
@@ -3281,6 +3357,19 @@ mm_shared_qmi_load_carrier_config (MMIfaceModem        *self,
     ctx->config_active_i = -1;
     g_task_set_task_data (task, ctx, (GDestroyNotify)load_carrier_config_context_free);
 
+    /* The details of each config don't change unless the firmware is
+     * upgraded, so reuse the ones found in a previous run if available */
+    revision = mm_iface_modem_get_revision (self);
+    if (revision) {
+        g_autoptr(GError) error = NULL;
+
+        ctx->cache_filename = mm_carrier_config_cache_build_filename (mm_base_modem_get_device (MM_BASE_MODEM (self)));
+        ctx->cache_revision = g_strdup (revision);
+        ctx->cache = mm_carrier_config_cache_load (ctx->cache_filename, ctx->cache_revision, &error);
+        if (!ctx->cache)
+            mm_obj_dbg (self, "carrier config cache not available: %s", error->message);
+    }
+
     /* Load PDC client */
     client = mm_shared_qmi_peek_client (MM_SHARED_QMI (self),
                                         QMI_SERVICE_PDC,
@@ -3717,6 +3806,17 @@ uim_refresh_indication_cb (QmiClientUim                  *client,
         return;
     }
 
+    /* All refresh modes come with changes in the SIM files, so the cached
+     * copy of them can no longer be used. Drop it both when the refresh
+     * starts and when it ends, as files may have been read in between. */
+    if (stage == QMI_UIM_REFRESH_STAGE_START || stage == QMI_UIM_REFRESH_STAGE_END_WITH_SUCCESS) {
+        g_autoptr(MMBaseSim) sim = NULL;
+
+        g_object_get (self, MM_IFACE_MODEM_SIM, &sim, NULL);
+        if (sim)
+            mm_base_sim_invalidate_cache (sim);
+    }
+
     /* Currently we handle UICC Reset type refresh, which can be used
      * in profile switch scenarios, and Init Full FCN type refresh for
      * SIM IMSI switch scenarios. In other cases we just trigger 'refresh
@@ -6369,6 +6469,8 @@ mm_shared_qmi_disable_location_gathering (MMIfaceModemLocation  *_self,
 /*****************************************************************************/
 /* Location: enable */
 
+static void loc_warm_start (MMSharedQmi *self);
+
 gboolean
 mm_shared_qmi_enable_location_gathering_finish (MMIfaceModemLocation  *self,
                                                 GAsyncResult          *res,
@@ -6491,6 +6593,9 @@ parent_enable_location_gathering_ready (MMIfaceModemLocation *_self,
 
     /* Only setup NMEA traces and start GPS engine if not done already */
     if (!(priv->enabled_sources & (MM_MODEM_LOCATION_SOURCE_GPS_NMEA | MM_MODEM_LOCATION_SOURCE_GPS_RAW))) {
+        /* Seed the engine before it's started, without waiting for it to
+         * request the data */
+        loc_warm_start (self);
         setup_required_nmea_traces (self,
                                     (GAsyncReadyCallback)setup_required_nmea_traces_ready,
                                     task);
@@ -6673,6 +6778,15 @@ mm_shared_qmi_location_load_capabilities (MMIfaceModemLocation *self,
     unlock_location_engine (self, task);
 }
 
+/*****************************************************************************/
+/* Location: peek location cache */
+
+MMLocationCache *
+mm_shared_qmi_location_peek_location_cache (MMIfaceModemLocation *self)
+{
+    return get_private (MM_SHARED_QMI (self))->location_cache;
+}
+
 /*****************************************************************************/
 /* Location: load supported assistance data */
 
@@ -6842,9 +6956,8 @@ loc_location_inject_time_ready (QmiClientLoc *client,
 }
 
 static void
-loc_location_inject_time_req_indication_cb (QmiClientLoc                            *client,
-                                            QmiIndicationLocInjectTimeRequestOutput *output,
-                                            MMSharedQmi                             *self)
+loc_inject_utc_time (MMSharedQmi  *self,
+                     QmiClientLoc *client)
 {
     g_autoptr(QmiMessageLocInjectUtcTimeInput)  input = NULL;
     guint64                                     utc_ms = 0;
@@ -6882,6 +6995,14 @@ loc_location_inject_time_req_indication_cb (QmiClientLoc
         task);
 }
 
+static void
+loc_location_inject_time_req_indication_cb (QmiClientLoc                            *client,
+                                            QmiIndicationLocInjectTimeRequestOutput *output,
+                                            MMSharedQmi                             *self)
+{
+    loc_inject_utc_time (self, client);
+}
+
 /*****************************************************************************/
 /* Location: Inject position */
 
@@ -6972,35 +7093,23 @@ loc_location_inject_position_ready (QmiClientLoc *client,
     }
 }
 
-static void
-loc_location_inject_position_req_indication_cb (QmiClientLoc                                *client,
-                                                QmiIndicationLocInjectPositionRequestOutput *output,
-                                                MMSharedQmi                                 *self)
+static gboolean
+loc_inject_cached_position (MMSharedQmi  *self,
+                            QmiClientLoc *client)
 {
     g_autoptr(QmiMessageLocInjectPositionInput) input = NULL;
     InjectPositionContext                      *ctx;
     Private                                    *priv;
     GTask                                      *task;
-    gdouble                                     lat;
-    gdouble                                     lon;
     guint64                                     utc_ms = 0;
     gdouble                                     last_lat;
     gdouble                                     last_lon;
-    guint64                                     timestamp;
-
-    qmi_indication_loc_inject_position_request_output_get_latitude (output, &lat, NULL);
-    qmi_indication_loc_inject_position_request_output_get_longitude (output, &lon, NULL);
-    qmi_indication_loc_inject_position_request_output_get_utc_timestamp (output, &timestamp, NULL);
-
-    /* check whether modem already has position */
-    if ((lat != 0.0) && (lon != 0.0) && (timestamp != 0))
-        return;
 
     priv = get_private (MM_SHARED_QMI (self));
     mm_location_cache_get_lat_lon (priv->location_cache, &last_lat, &last_lon);
     if ((last_lat == MM_LOCATION_LATITUDE_UNKNOWN) ||
         (last_lon == MM_LOCATION_LONGITUDE_UNKNOWN))
-        return;
+        return FALSE;
 
     task = g_task_new (self, NULL, NULL, NULL);
     ctx = g_slice_new0 (InjectPositionContext);
@@ -7037,6 +7146,27 @@ loc_location_inject_position_req_indication_cb (QmiClientLoc
         NULL, /* cancellable */
         (GAsyncReadyCallback)loc_location_inject_position_ready,
         task);
+    return TRUE;
+}
+
+static void
+loc_location_inject_position_req_indication_cb (QmiClientLoc                                *client,
+                                                QmiIndicationLocInjectPositionRequestOutput *output,
+                                                MMSharedQmi                                 *self)
+{
+    gdouble lat;
+    gdouble lon;
+    guint64 timestamp;
+
+    qmi_indication_loc_inject_position_request_output_get_latitude (output, &lat, NULL);
+    qmi_indication_loc_inject_position_request_output_get_longitude (output, &lon, NULL);
+    qmi_indication_loc_inject_position_request_output_get_utc_timestamp (output, &timestamp, NULL);
+
+    /* check whether modem already has position */
+    if ((lat != 0.0) && (lon != 0.0) && (timestamp != 0))
+        return;
+
+    loc_inject_cached_position (self, client);
 }
 
 
@@ -7432,6 +7562,26 @@ inject_xtra_data (GTask *task)
 
 static void inject_assistance_data_next (GTask *task);
 
+static void
+loc_assistance_data_store (MMSharedQmi                 *self,
+                           InjectAssistanceDataContext *ctx)
+{
+    Private           *priv;
+    g_autoptr(GBytes)  data = NULL;
+
+    priv = get_private (self);
+    data = g_bytes_new (ctx->data, ctx->data_size);
+
+    /* Re-injecting the same data (e.g. on warm start) doesn't refresh its age */
+    if (priv->loc_assistance_data && g_bytes_equal (priv->loc_assistance_data, data))
+        return;
+
+    if (priv->loc_assistance_data)
+        g_bytes_unref (priv->loc_assistance_data);
+    priv->loc_assistance_data = g_steal_pointer (&data);
+    priv->loc_assistance_data_time = g_get_monotonic_time ();
+}
+
 static void
 loc_location_inject_predicted_orbits_data_indication_cb (QmiClientLoc                                    *client,
                                                          QmiIndicationLocInjectPredictedOrbitsDataOutput *output,
@@ -7521,6 +7671,7 @@ inject_assistance_data_next (GTask *task)
     g_assert (ctx->data_size >= ctx->i);
     total_bytes_left = ctx->data_size - ctx->i;
     if (total_bytes_left == 0) {
+        loc_assistance_data_store (self, ctx);
         g_task_return_boolean (task, TRUE);
         g_object_unref (task);
         return;
@@ -7612,6 +7763,64 @@ mm_shared_qmi_location_inject_assistance_data (MMIfaceModemLocation *self,
     inject_assistance_data_next (task);
 }
 
+/*****************************************************************************/
+/* Location: warm start
+ *
+ * When the GPS engine is started, the current time, the last known position
+ * and the last assistance data injected (if still valid) are given to the
+ * engine right away, instead of waiting for the engine to request them. All
+ * these operations are best effort and run in parallel with the engine start.
+ */
+
+/* gpsOneXTRA files are usually valid for at least this long */
+#define LOC_ASSISTANCE_DATA_MAX_AGE_SECS (24 * 60 * 60)
+
+static void
+loc_warm_start_inject_assistance_data_ready (MMIfaceModemLocation *self,
+                                             GAsyncResult         *res,
+                                             gpointer              user_data)
+{
+    g_autoptr(GError) error = NULL;
+
+    if (!mm_shared_qmi_location_inject_assistance_data_finish (self, res, &error))
+        mm_obj_dbg (self, "couldn't re-inject assistance data: %s", error->message);
+    else
+        mm_obj_dbg (self, "assistance data re-injected");
+}
+
+static void
+loc_warm_start (MMSharedQmi *self)
+{
+    QmiClient *client;
+    Private   *priv;
+
+    client = mm_shared_qmi_peek_client (self, QMI_SERVICE_LOC, MM_PORT_QMI_FLAG_DEFAULT, NULL);
+    if (!client)
+        return;
+
+    priv = get_private (self);
+
+    mm_obj_dbg (self, "warm starting GPS engine: injecting time...");
+    loc_inject_utc_time (self, QMI_CLIENT_LOC (client));
+
+    if (loc_inject_cached_position (self, QMI_CLIENT_LOC (client)))
+        mm_obj_dbg (self, "warm starting GPS engine: injecting last known position...");
+
+    if (priv->loc_assistance_data) {
+        if ((g_get_monotonic_time () - priv->loc_assistance_data_time) < (LOC_ASSISTANCE_DATA_MAX_AGE_SECS * G_USEC_PER_SEC)) {
+            mm_obj_dbg (self, "warm starting GPS engine: re-injecting assistance data...");
+            mm_shared_qmi_location_inject_assistance_data (MM_IFACE_MODEM_LOCATION (self),
+                                                           g_bytes_get_data (priv->loc_assistance_data, NULL),
+                                                           g_bytes_get_size (priv->loc_assistance_data),
+                                                           (GAsyncReadyCallback)loc_warm_start_inject_assistance_data_ready,
+                                                           NULL);
+        } else {
+            mm_obj_dbg (self, "assistance data too old, not re-injecting it");
+            g_clear_pointer (&priv->loc_assistance_data, g_bytes_unref);
+        }
+    }
+}
+
 /*****************************************************************************/
 
 QmiClient *
@@ -255,5 +255,6 @@ void                               mm_shared_qmi_location_load_assistance_data_s
 gchar                            **mm_shared_qmi_location_load_assistance_data_servers_finish   (MMIfaceModemLocation   *self,
                                                                                                  GAsyncResult           *res,
                                                                                                  GError                **error);
+MMLocationCache                   *mm_shared_qmi_location_peek_location_cache                   (MMIfaceModemLocation   *self);
 
 #endif /* MM_SHARED_QMI_H */
@@ -0,0 +1,98 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-keyfile-cache.h"
+#include "mm-sim-cache.h"
+
+#define SIM_CACHE_FILE_PREFIX "sim-"
+#define SIM_CACHE_VERSION     1
+
+#define SIM_CACHE_HEADER_GROUP     "sim"
+#define SIM_CACHE_KEY_ICCID_DIGEST "iccid-digest"
+#define SIM_CACHE_KEY_IMSI_DIGEST  "imsi-digest"
+
+/*****************************************************************************/
+
+gchar *
+mm_sim_cache_build_filename (const gchar *iccid)
+{
+    return mm_keyfile_cache_build_filename (SIM_CACHE_FILE_PREFIX, iccid);
+}
+
+static gboolean
+check_digest (GKeyFile     *key_file,
+              const gchar  *key,
+              const gchar  *str,
+              GError      **error)
+{
+    g_autofree gchar *expected = NULL;
+    g_autofree gchar *stored = NULL;
+
+    stored = g_key_file_get_string (key_file, SIM_CACHE_HEADER_GROUP, key, error);
+    if (!stored)
+        return FALSE;
+
+    expected = mm_keyfile_cache_build_digest (str);
+    if (!g_str_equal (stored, expected)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND,
+                     "SIM cache doesn't match the SIM card (%s)", key);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+GKeyFile *
+mm_sim_cache_load (const gchar  *filename,
+                   const gchar  *iccid,
+                   const gchar  *imsi,
+                   GError      **error)
+{
+    g_autoptr(GKeyFile) key_file = NULL;
+
+    key_file = mm_keyfile_cache_load (filename, SIM_CACHE_HEADER_GROUP, SIM_CACHE_VERSION, error);
+    if (!key_file)
+        return NULL;
+
+    if (!check_digest (key_file, SIM_CACHE_KEY_ICCID_DIGEST, iccid, error) ||
+        !check_digest (key_file, SIM_CACHE_KEY_IMSI_DIGEST, imsi, error))
+        return NULL;
+
+    return g_steal_pointer (&key_file);
+}
+
+gboolean
+mm_sim_cache_save (const gchar  *filename,
+                   const gchar  *iccid,
+                   const gchar  *imsi,
+                   GKeyFile     *values,
+                   GError      **error)
+{
+    g_autofree gchar *iccid_digest = NULL;
+    g_autofree gchar *imsi_digest = NULL;
+
+    iccid_digest = mm_keyfile_cache_build_digest (iccid);
+    imsi_digest = mm_keyfile_cache_build_digest (imsi);
+
+    g_key_file_set_string (values, SIM_CACHE_HEADER_GROUP, SIM_CACHE_KEY_ICCID_DIGEST, iccid_digest);
+    g_key_file_set_string (values, SIM_CACHE_HEADER_GROUP, SIM_CACHE_KEY_IMSI_DIGEST, imsi_digest);
+
+    return mm_keyfile_cache_save (filename, SIM_CACHE_HEADER_GROUP, SIM_CACHE_VERSION, values, error);
+}
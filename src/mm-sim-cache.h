@@ -0,0 +1,48 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_SIM_CACHE_H
+#define MM_SIM_CACHE_H
+
+#include <glib.h>
+
+/* Cache of the contents of static SIM files, persisted across restarts.
+ *
+ * There is one cache file per SIM card, named after a checksum of the ICCID.
+ * The cached values are only valid for the same IMSI, so that SIM cards
+ * switching between several IMSIs don't report stale values. Neither the
+ * ICCID nor the IMSI are stored in plain text. */
+
+#define MM_SIM_CACHE_GROUP                   "files"
+#define MM_SIM_CACHE_KEY_OPERATOR_IDENTIFIER "operator-identifier"
+#define MM_SIM_CACHE_KEY_OPERATOR_NAME       "operator-name"
+#define MM_SIM_CACHE_KEY_EMERGENCY_NUMBERS   "emergency-numbers"
+#define MM_SIM_CACHE_KEY_GID1                "gid1"
+#define MM_SIM_CACHE_KEY_GID2                "gid2"
+
+gchar    *mm_sim_cache_build_filename (const gchar  *iccid);
+
+/* Returns the cached values, in the MM_SIM_CACHE_GROUP group */
+GKeyFile *mm_sim_cache_load           (const gchar  *filename,
+                                       const gchar  *iccid,
+                                       const gchar  *imsi,
+                                       GError      **error);
+gboolean  mm_sim_cache_save           (const gchar  *filename,
+                                       const gchar  *iccid,
+                                       const gchar  *imsi,
+                                       GKeyFile     *values,
+                                       GError      **error);
+
+#endif /* MM_SIM_CACHE_H */
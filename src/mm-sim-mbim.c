@@ -196,7 +196,7 @@ application_list_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
 
     if (g_task_return_error_if_cancelled (task)) {
         g_object_unref (task);
@@ -246,12 +246,12 @@ uicc_application_list (GTask      *task,
     g_autoptr(MbimMessage) message = NULL;
 
     message = mbim_message_ms_uicc_low_level_access_application_list_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)application_list_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)application_list_query_ready,
+                                 task);
 }
 
 static void
@@ -267,7 +267,7 @@ subscriber_ready_status_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
 
     if (g_task_return_error_if_cancelled (task)) {
         g_object_unref (task);
@@ -362,12 +362,12 @@ subscriber_ready_status (GTask      *task,
     g_autoptr(MbimMessage) message = NULL;
 
     message = mbim_message_subscriber_ready_status_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)subscriber_ready_status_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)subscriber_ready_status_ready,
+                                 task);
 }
 
 static void
@@ -621,7 +621,7 @@ check_uicc_close_channel_ready (MbimDevice   *device,
 
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_uicc_low_level_access_close_channel_response_parse (response, &status, &error)) {
@@ -654,7 +654,7 @@ check_uicc_apdu_ready (MbimDevice   *device,
 
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_uicc_low_level_access_apdu_response_parse (
@@ -690,7 +690,7 @@ check_uicc_open_channel_ready (MbimDevice   *device,
 
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_uicc_low_level_access_open_channel_response_parse (
@@ -755,12 +755,12 @@ esim_check_step (MbimDevice *device,
                           */
                       ctx->channel_grp,
                       NULL);
-        mbim_device_command (device,
-                             message,
-                             10,
-                             NULL,
-                             (GAsyncReadyCallback)check_uicc_open_channel_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     NULL,
+                                     (GAsyncReadyCallback)check_uicc_open_channel_ready,
+                                     task);
         return;
     }
 
@@ -776,12 +776,12 @@ esim_check_step (MbimDevice *device,
                       sizeof (apdu_cmd),
                       apdu_cmd,
                       NULL);
-        mbim_device_command (device,
-                             message,
-                             10,
-                             NULL,
-                             (GAsyncReadyCallback)check_uicc_apdu_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     NULL,
+                                     (GAsyncReadyCallback)check_uicc_apdu_ready,
+                                     task);
         return;
     }
 
@@ -791,12 +791,12 @@ esim_check_step (MbimDevice *device,
                       ctx->channel,
                       ctx->channel_grp,
                       NULL);
-        mbim_device_command (device,
-                             message,
-                             10,
-                             NULL,
-                             (GAsyncReadyCallback)check_uicc_close_channel_ready,
-                             task);
+        mm_port_mbim_device_command (device,
+                                     message,
+                                     10,
+                                     NULL,
+                                     (GAsyncReadyCallback)check_uicc_close_channel_ready,
+                                     task);
         return;
 
     case ESIM_CHECK_STEP_LAST:
@@ -870,7 +870,7 @@ read_binary_query_ready (MbimDevice   *device,
     const guint8           *data;
     guint32                 data_size;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_uicc_low_level_access_read_binary_response_parse (
@@ -909,7 +909,7 @@ file_status_query_ready (MbimDevice   *device,
     self = g_task_get_source_object (task);
     ctx = (CommonReadBinaryContext *) g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_ms_uicc_low_level_access_file_status_response_parse (
@@ -963,12 +963,12 @@ file_status_query_ready (MbimDevice   *device,
                                                                            0,    /* data_size */
                                                                            NULL, /* data */
                                                                            NULL);
-    mbim_device_command (ctx->device,
-                         request,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)read_binary_query_ready,
-                         task);
+    mm_port_mbim_device_command (ctx->device,
+                                 request,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)read_binary_query_ready,
+                                 task);
 }
 
 static void
@@ -1008,12 +1008,12 @@ read_binary_subscriber_info_ready (MMSimMbim    *self,
                                                                            ctx->file_path->data,
                                                                            NULL);
 
-    mbim_device_command (ctx->device,
-                         request,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)file_status_query_ready,
-                         task);
+    mm_port_mbim_device_command (ctx->device,
+                                 request,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)file_status_query_ready,
+                                 task);
 }
 
 static void
@@ -1353,7 +1353,7 @@ pin_set_enter_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response) {
         success = mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
 
@@ -1420,12 +1420,12 @@ send_pin (MMBaseSim *self,
         return;
     }
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)pin_set_enter_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)pin_set_enter_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -1455,7 +1455,7 @@ puk_set_enter_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response) {
         success = mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
 
@@ -1523,12 +1523,12 @@ send_puk (MMBaseSim *self,
         return;
     }
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)puk_set_enter_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)puk_set_enter_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -1556,7 +1556,7 @@ pin_set_enable_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response) {
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
 
@@ -1614,12 +1614,12 @@ enable_pin (MMBaseSim *self,
         return;
     }
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)pin_set_enable_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)pin_set_enable_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -1647,7 +1647,7 @@ pin_set_change_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response) {
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
 
@@ -1705,12 +1705,12 @@ change_pin (MMBaseSim *self,
         return;
     }
 
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)pin_set_change_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)pin_set_change_ready,
+                                 task);
     mbim_message_unref (message);
 }
 
@@ -1953,6 +1953,8 @@ mm_sim_qmi_class_init (MMSimQmiClass *klass)
     base_sim_class->change_pin_finish = change_pin_finish;
     base_sim_class->enable_pin = enable_pin;
     base_sim_class->enable_pin_finish = enable_pin_finish;
+    /* UIM file reads can be run in parallel */
+    base_sim_class->parallel_file_loads = TRUE;
 
     properties[PROP_DMS_UIM_DEPRECATED] =
         g_param_spec_boolean (MM_SIM_QMI_DMS_UIM_DEPRECATED,
@@ -439,15 +439,16 @@ send_generic_ready (MMBaseModem  *modem,
      * be treated as an AT command (i.e. we don't want it prefixed
      * with AT+ and suffixed with <CR><LF>), plus, we want it to be
      * sent right away (not queued after other AT commands). */
-    mm_base_modem_at_command_full (ctx->modem,
-                                   ctx->port,
-                                   ctx->msg_data,
-                                   MM_BASE_SMS_DEFAULT_SEND_TIMEOUT,
-                                   FALSE,
-                                   TRUE, /* raw */
-                                   NULL,
-                                   (GAsyncReadyCallback)send_generic_msg_data_ready,
-                                   task);
+    mm_base_modem_at_command_full_with_priority (ctx->modem,
+                                                 ctx->port,
+                                                 ctx->msg_data,
+                                                 MM_BASE_SMS_DEFAULT_SEND_TIMEOUT,
+                                                 FALSE,
+                                                 TRUE, /* raw */
+                                                 MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                                 NULL,
+                                                 (GAsyncReadyCallback)send_generic_msg_data_ready,
+                                                 task);
 }
 
 static void
@@ -515,15 +516,16 @@ sms_send_next_part (GTask *task)
     /* Send from storage */
     if (ctx->from_storage) {
         cmd = g_strdup_printf ("+CMSS=%d", mm_sms_part_get_index ((MMSmsPart *)ctx->current->data));
-        mm_base_modem_at_command_full (ctx->modem,
-                                       ctx->port,
-                                       cmd,
-                                       MM_BASE_SMS_DEFAULT_SEND_TIMEOUT,
-                                       FALSE,
-                                       FALSE,
-                                       NULL,
-                                       (GAsyncReadyCallback)send_from_storage_ready,
-                                       task);
+        mm_base_modem_at_command_full_with_priority (ctx->modem,
+                                                     ctx->port,
+                                                     cmd,
+                                                     MM_BASE_SMS_DEFAULT_SEND_TIMEOUT,
+                                                     FALSE,
+                                                     FALSE,
+                                                     MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                                     NULL,
+                                                     (GAsyncReadyCallback)send_from_storage_ready,
+                                                     task);
         return;
     }
 
@@ -547,15 +549,16 @@ sms_send_next_part (GTask *task)
     g_assert (ctx->msg_data != NULL);
 
     /* no network involved in this initial AT command, so lower timeout */
-    mm_base_modem_at_command_full (ctx->modem,
-                                   ctx->port,
-                                   cmd,
-                                   10,
-                                   FALSE,
-                                   FALSE, /* raw */
-                                   NULL,
-                                   (GAsyncReadyCallback)send_generic_ready,
-                                   task);
+    mm_base_modem_at_command_full_with_priority (ctx->modem,
+                                                 ctx->port,
+                                                 cmd,
+                                                 10,
+                                                 FALSE,
+                                                 FALSE, /* raw */
+                                                 MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                                 NULL,
+                                                 (GAsyncReadyCallback)send_generic_ready,
+                                                 task);
 }
 
 static void
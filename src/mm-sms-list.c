@@ -54,6 +54,8 @@ struct _MMSmsListPrivate {
     GObject *bind_to;
     /* List of sms objects */
     GList *list;
+    /* Whether new sms objects are left unexported */
+    gboolean defer_export;
 };
 
 static void _release_sms_internal (MMBaseSms *sms, MMSmsList *self);
@@ -117,6 +119,63 @@ mm_sms_list_get_paths (MMSmsList *self)
     return path_list;
 }
 
+GStrv
+mm_sms_list_get_page (MMSmsList    *self,
+                      guint         offset,
+                      guint         count,
+                      MMSmsState    state,
+                      MMSmsStorage  storage,
+                      guint        *out_total)
+{
+    GPtrArray *path_list;
+    GList     *exported = NULL;
+    GList     *l;
+    guint      total = 0;
+
+    path_list = g_ptr_array_new ();
+
+    /* Newest SMS objects first, same as in the list of paths */
+    for (l = self->priv->list; l; l = g_list_next (l)) {
+        MMBaseSms *sms = MM_BASE_SMS (l->data);
+
+        if (state != MM_SMS_STATE_UNKNOWN &&
+            mm_gdbus_sms_get_state (MM_GDBUS_SMS (sms)) != state)
+            continue;
+        if (storage != MM_SMS_STORAGE_UNKNOWN &&
+            mm_base_sms_get_storage (sms) != storage)
+            continue;
+
+        if (total >= offset && (total - offset) < count) {
+            if (!mm_base_sms_get_path (sms)) {
+                mm_base_sms_export (sms);
+                mm_obj_dbg (sms, "SMS object exported on demand");
+                exported = g_list_prepend (exported, g_object_ref (sms));
+            }
+            g_ptr_array_add (path_list, g_strdup (mm_base_sms_get_path (sms)));
+        }
+        total++;
+    }
+
+    /* Notify the SMS objects exported on demand once all of them are
+     * exported, so that the list of paths is only updated once; oldest
+     * first, same as when added */
+    for (l = exported; l; l = g_list_next (l)) {
+        MMSmsState sms_state;
+
+        sms_state = mm_gdbus_sms_get_state (MM_GDBUS_SMS (l->data));
+        g_signal_emit (self, signals[SIGNAL_ADDED], 0,
+                       mm_base_sms_get_path (MM_BASE_SMS (l->data)),
+                       (sms_state == MM_SMS_STATE_RECEIVED || sms_state == MM_SMS_STATE_RECEIVING));
+    }
+    g_list_free_full (exported, g_object_unref);
+
+    if (out_total)
+        *out_total = total;
+
+    g_ptr_array_add (path_list, NULL);
+    return (GStrv) g_ptr_array_free (path_list, FALSE);
+}
+
 /*****************************************************************************/
 
 gboolean
@@ -243,6 +302,19 @@ _release_sms_internal (MMBaseSms *sms, MMSmsList *self)
     g_object_unref (sms);
 }
 
+static void
+_export_sms_internal (MMSmsList *self,
+                      MMBaseSms *sms,
+                      gboolean   received)
+{
+    if (!mm_base_sms_get_path (sms))
+        mm_base_sms_export (sms);
+
+    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
+                   mm_base_sms_get_path (sms),
+                   received);
+}
+
 static void
 _add_sms_internal (MMSmsList *self,
                    MMBaseSms *sms,
@@ -254,9 +326,10 @@ _add_sms_internal (MMSmsList *self,
                       (GCallback)set_local_multipart_reference,
                       self);
 
-    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
-                   mm_base_sms_get_path (sms),
-                   received);
+    /* SMS objects added while export is deferred are not notified; they
+     * are exported on demand in mm_sms_list_get_page() */
+    if (!self->priv->defer_export)
+        _export_sms_internal (self, sms, received);
 }
 
 
@@ -336,9 +409,18 @@ take_multipart (MMSmsList *self,
     l = g_list_find_custom (self->priv->list, part,
                             (GCompareFunc)cmp_sms_by_number_reference);
     if (l) {
+        MMBaseSms *existing = MM_BASE_SMS (l->data);
+
         /* Try to take the part */
-        mm_obj_dbg (l->data, "found existing multipart SMS object with reference '%u': adding new part", concat_reference);
-        return mm_base_sms_multipart_take_part (MM_BASE_SMS (l->data), part, error);
+        mm_obj_dbg (existing, "found existing multipart SMS object with reference '%u': adding new part", concat_reference);
+        if (!mm_base_sms_multipart_take_part (existing, part, error))
+            return FALSE;
+
+        /* A new part for a not yet exported SMS object is notified right
+         * away, unless export is still being deferred */
+        if (!mm_base_sms_get_path (existing) && !self->priv->defer_export)
+            _export_sms_internal (self, existing, (state == MM_SMS_STATE_RECEIVED || state == MM_SMS_STATE_RECEIVING));
+        return TRUE;
     }
 
     /* Create new Multipart */
@@ -427,6 +509,15 @@ mm_sms_list_take_part (MMSmsList *self,
 
 /*****************************************************************************/
 
+void
+mm_sms_list_set_defer_export (MMSmsList *self,
+                              gboolean   defer_export)
+{
+    self->priv->defer_export = defer_export;
+}
+
+/*****************************************************************************/
+
 void
 mm_sms_list_set_default_storage (MMSmsList    *self,
                                  MMSmsStorage  default_storage)
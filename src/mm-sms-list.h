@@ -60,6 +60,23 @@ MMSmsList *mm_sms_list_new (GObject     *bind_to);
 GStrv mm_sms_list_get_paths (MMSmsList *self);
 guint mm_sms_list_get_count (MMSmsList *self);
 
+/* Paths of the SMS objects matching the given state and storage (UNKNOWN
+ * matches all), from @offset and up to @count of them. SMS objects in the
+ * page not exported yet are exported, and MM_SMS_ADDED is emitted for them
+ * once all of them are exported. */
+GStrv mm_sms_list_get_page (MMSmsList    *self,
+                            guint         offset,
+                            guint         count,
+                            MMSmsState    state,
+                            MMSmsStorage  storage,
+                            guint        *out_total);
+
+/* While set, new SMS objects are neither exported nor notified. They are
+ * missing from mm_sms_list_get_paths() until exported by
+ * mm_sms_list_get_page(), which is when MM_SMS_ADDED is emitted for them. */
+void mm_sms_list_set_defer_export (MMSmsList *self,
+                                   gboolean   defer_export);
+
 gboolean mm_sms_list_has_part (MMSmsList *self,
                                MMSmsStorage storage,
                                guint index);
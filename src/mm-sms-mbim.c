@@ -104,7 +104,7 @@ sms_send_set_ready (MbimDevice *device,
     guint32 message_reference;
 
     ctx = g_task_get_task_data (task);
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_sms_send_response_parse (
@@ -167,12 +167,12 @@ sms_send_next_part (GTask *task)
                                              &send_record,
                                              NULL,
                                              NULL);
-    mbim_device_command (ctx->device,
-                         message,
-                         MM_BASE_SMS_DEFAULT_SEND_TIMEOUT,
-                         NULL,
-                         (GAsyncReadyCallback)sms_send_set_ready,
-                         task);
+    mm_port_mbim_device_command (ctx->device,
+                                 message,
+                                 MM_BASE_SMS_DEFAULT_SEND_TIMEOUT,
+                                 NULL,
+                                 (GAsyncReadyCallback)sms_send_set_ready,
+                                 task);
     mbim_message_unref (message);
     g_free (pdu);
 }
@@ -238,7 +238,7 @@ sms_delete_set_ready (MbimDevice *device,
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error))
         mbim_message_sms_delete_response_parse (response, &error);
@@ -291,12 +291,12 @@ delete_next_part (GTask *task)
     message = mbim_message_sms_delete_set_new (MBIM_SMS_FLAG_INDEX,
                                                (guint32)mm_sms_part_get_index ((MMSmsPart *)ctx->current->data),
                                                NULL);
-    mbim_device_command (ctx->device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)sms_delete_set_ready,
-                         task);
+    mm_port_mbim_device_command (ctx->device,
+                                 message,
+                                 10,
+                                 NULL,
+                                 (GAsyncReadyCallback)sms_delete_set_ready,
+                                 task);
     mbim_message_unref (message);
 
 }
@@ -31,6 +31,7 @@
 #include "mm-modem-helpers.h"
 #include "mm-common-helpers.h"
 #include "mm-port-serial-at.h"
+#include "mm-regex-registry.h"
 
 /* Setup relationship between the 3G band bitmask in the modem and the bitmask
  * in ModemManager. */
@@ -258,9 +259,9 @@ mm_cinterion_parse_scfg_test (const gchar                 *response,
                               MMCinterionRadioBandFormat  *format,
                               GError                     **error)
 {
-    g_autoptr(GRegex)      r1 = NULL;
+    GRegex                *r1 = NULL;
     g_autoptr(GMatchInfo)  match_info1 = NULL;
-    g_autoptr(GRegex)      r2 = NULL;
+    GRegex                *r2 = NULL;
     g_autoptr(GMatchInfo)  match_info2 = NULL;
     GError                *inner_error = NULL;
     GArray                *bands = NULL;
@@ -272,9 +273,8 @@ mm_cinterion_parse_scfg_test (const gchar                 *response,
         return FALSE;
     }
 
-    r1 = g_regex_new ("\\^SCFG:\\s*\"Radio/Band\",\\((?:\")?([0-9]*)(?:\")?-(?:\")?([0-9]*)(?:\")?.*\\)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r1 != NULL);
+    r1 = mm_regex_registry_get ("\\^SCFG:\\s*\"Radio/Band\",\\((?:\")?([0-9]*)(?:\")?-(?:\")?([0-9]*)(?:\")?.*\\)",
+                                G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
 
     g_regex_match_full (r1, response, strlen (response), 0, 0, &match_info1, &inner_error);
     if (inner_error)
@@ -307,11 +307,10 @@ mm_cinterion_parse_scfg_test (const gchar                 *response,
         goto finish;
     }
 
-    r2 = g_regex_new ("\\^SCFG:\\s*\"Radio/Band/([234]G)\","
-                      "\\(\"?([0-9A-Fa-fx]*)\"?-\"?([0-9A-Fa-fx]*)\"?\\)"
-                      "(,*\\(\"?([0-9A-Fa-fx]*)\"?-\"?([0-9A-Fa-fx]*)\"?\\))?",
-                     0, 0, NULL);
-    g_assert (r2 != NULL);
+    r2 = mm_regex_registry_get ("\\^SCFG:\\s*\"Radio/Band/([234]G)\","
+                                "\\(\"?([0-9A-Fa-fx]*)\"?-\"?([0-9A-Fa-fx]*)\"?\\)"
+                                "(,*\\(\"?([0-9A-Fa-fx]*)\"?-\"?([0-9A-Fa-fx]*)\"?\\))?",
+                                0, 0);
 
     g_regex_match_full (r2, response, strlen (response), 0, 0, &match_info2, &inner_error);
     if (inner_error)
@@ -430,7 +429,7 @@ mm_cinterion_parse_scfg_response (const gchar                  *response,
                                   MMCinterionRadioBandFormat    format,
                                   GError                      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     GArray                *bands = NULL;
@@ -441,8 +440,7 @@ mm_cinterion_parse_scfg_response (const gchar                  *response,
     }
 
     if (format == MM_CINTERION_RADIO_BAND_FORMAT_SINGLE) {
-        r = g_regex_new ("\\^SCFG:\\s*\"Radio/Band\",\\s*\"?([0-9a-fA-F]*)\"?", 0, 0, NULL);
-        g_assert (r != NULL);
+        r = mm_regex_registry_get ("\\^SCFG:\\s*\"Radio/Band\",\\s*\"?([0-9a-fA-F]*)\"?", 0, 0);
 
         g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
         if (inner_error)
@@ -473,9 +471,8 @@ mm_cinterion_parse_scfg_response (const gchar                  *response,
             }
         }
     } else if (format == MM_CINTERION_RADIO_BAND_FORMAT_MULTIPLE) {
-        r = g_regex_new ("\\^SCFG:\\s*\"Radio/Band/([234]G)\",\"?([0-9A-Fa-fx]*)\"?,?\"?([0-9A-Fa-fx]*)?\"?",
-                         0, 0, NULL);
-        g_assert (r != NULL);
+        r = mm_regex_registry_get ("\\^SCFG:\\s*\"Radio/Band/([234]G)\",\"?([0-9A-Fa-fx]*)\"?,?\"?([0-9A-Fa-fx]*)?\"?",
+                                   0, 0);
 
         g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
         if (inner_error)
@@ -561,7 +558,7 @@ mm_cinterion_parse_scfg_sim_response (const gchar  *response,
                                       guint        *active_slot,
                                       GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
 
@@ -570,8 +567,7 @@ mm_cinterion_parse_scfg_sim_response (const gchar  *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\^SCFG:\\s*\"SIM/CS\",\".*?(\\d)\"", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SCFG:\\s*\"SIM/CS\",\".*?(\\d)\"", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error) {
@@ -641,7 +637,7 @@ mm_cinterion_parse_sind_simlocal_response (const gchar  *response,
                                            GArray      **available,
                                            GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     g_autofree gchar      *str = NULL;
     GError                *inner_error = NULL;
@@ -651,8 +647,7 @@ mm_cinterion_parse_sind_simlocal_response (const gchar  *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\^SIND:\\s*simlocal,\\d+,((\\d,)*\\d)", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SIND:\\s*simlocal,\\d+,((\\d,)*\\d)", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error) {
@@ -694,7 +689,7 @@ mm_cinterion_parse_cnmi_test (const gchar *response,
                               GArray **supported_bfr,
                               GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     g_autoptr(GArray)      tmp_supported_mode = NULL;
     g_autoptr(GArray)      tmp_supported_mt = NULL;
@@ -708,10 +703,9 @@ mm_cinterion_parse_cnmi_test (const gchar *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\+CNMI:\\s*\\((.*)\\),\\((.*)\\),\\((.*)\\),\\((.*)\\),\\((.*)\\)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+CNMI:\\s*\\((.*)\\),\\((.*)\\),\\((.*)\\),\\((.*)\\),\\((.*)\\)",
+                               G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                               0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
@@ -792,7 +786,7 @@ mm_cinterion_parse_sxrat_test (const gchar *response,
                                GArray **supported_pref2,
                                GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     GArray                *tmp_supported_rat = NULL;
@@ -804,11 +798,9 @@ mm_cinterion_parse_sxrat_test (const gchar *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\^SXRAT:\\s*\\(([^\\)]*)\\),\\s*\\(([^\\)]*)\\)(,\\s*\\(([^\\)]*)\\))?(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, NULL);
-
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SXRAT:\\s*\\(([^\\)]*)\\),\\s*\\(([^\\)]*)\\)(,\\s*\\(([^\\)]*)\\))?(?:\\r\\n)?",
+                               G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                               0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
 
@@ -977,7 +969,7 @@ mm_cinterion_parse_sind_response (const gchar *response,
                                   guint *value,
                                   GError **error)
 {
-    g_autoptr(GRegex)     r = NULL;
+    GRegex               *r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
     guint                 errors = 0;
 
@@ -986,8 +978,7 @@ mm_cinterion_parse_sind_response (const gchar *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\^SIND:\\s*(.*),(\\d+),(\\d+)(\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SIND:\\s*(.*),(\\d+),(\\d+)(\\r\\n)?", 0, 0);
 
     if (g_regex_match (r, response, 0, &match_info)) {
         if (description) {
@@ -1047,7 +1038,7 @@ mm_cinterion_parse_swwan_response (const gchar  *response,
                                    gpointer      log_object,
                                    GError      **error)
 {
-    g_autoptr(GRegex)         r = NULL;
+    GRegex                   *r = NULL;
     g_autoptr(GMatchInfo)     match_info = NULL;
     GError                   *inner_error = NULL;
     MMBearerConnectionStatus  status;
@@ -1065,9 +1056,8 @@ mm_cinterion_parse_swwan_response (const gchar  *response,
         return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
     }
 
-    r = g_regex_new ("\\^SWWAN:\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d+))?(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SWWAN:\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d+))?(?:\\r\\n)?",
+                               G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
 
     status = MM_BEARER_CONNECTION_STATUS_UNKNOWN;
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
@@ -1119,11 +1109,10 @@ mm_cinterion_parse_sgauth_response (const gchar          *response,
                                     gchar               **out_username,
                                     GError              **error)
 {
-    g_autoptr(GRegex)     r = NULL;
+    GRegex               *r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
 
-    r = g_regex_new ("\\^SGAUTH:\\s*(\\d+),(\\d+),?\"?([a-zA-Z0-9_-]+)?\"?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SGAUTH:\\s*(\\d+),(\\d+),?\"?([a-zA-Z0-9_-]+)?\"?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, NULL);
     while (g_match_info_matches (match_info)) {
@@ -1187,7 +1176,7 @@ mm_cinterion_parse_smong_response (const gchar              *response,
     guint                  value = 0;
     GError                *inner_error = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
-    g_autoptr(GRegex)      regex = NULL;
+    GRegex                *regex = NULL;
 
     /* The AT^SMONG command returns a cell info table, where the second
      * column identifies the "GPRS status", which is exactly what we want.
@@ -1199,12 +1188,11 @@ mm_cinterion_parse_smong_response (const gchar              *response,
      * 0776  1  -      -   214   03  2    00      01
      * OK
      */
-    regex = g_regex_new (".*GPRS Monitor(?:\r\n)*"
-                         "BCCH\\s*G.*\\r\\n"
-                         "\\s*(\\d+)\\s*(\\d+)\\s*",
-                         G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                         0, NULL);
-    g_assert (regex);
+    regex = mm_regex_registry_get (".*GPRS Monitor(?:\r\n)*"
+                                   "BCCH\\s*G.*\\r\\n"
+                                   "\\s*(\\d+)\\s*(\\d+)\\s*",
+                                   G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                                   0);
 
     g_regex_match_full (regex, response, strlen (response), 0, 0, &match_info, &inner_error);
 
@@ -1286,7 +1274,7 @@ mm_cinterion_parse_slcc_list (const gchar *str,
                               GList      **out_list,
                               GError     **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GList                 *list = NULL;
     GError                *inner_error = NULL;
@@ -1315,14 +1303,12 @@ mm_cinterion_parse_slcc_list (const gchar *str,
      *  ^SLCC :
      */
 
-    r = g_regex_new ("\\^SLCC:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)" /* mandatory fields */
-                     "(?:,\\s*([^,]*),\\s*(\\d+)"                                                /* number and type */
-                     "(?:,\\s*([^,]*)"                                                           /* alpha */
-                     ")?)?$",
-                     G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
-                     G_REGEX_MATCH_NEWLINE_CRLF,
-                     NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SLCC:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)" /* mandatory fields */
+                               "(?:,\\s*([^,]*),\\s*(\\d+)"                                                /* number and type */
+                               "(?:,\\s*([^,]*)"                                                           /* alpha */
+                               ")?)?$",
+                               G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
+                               G_REGEX_MATCH_NEWLINE_CRLF);
 
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -1469,8 +1455,8 @@ mm_cinterion_parse_smoni_query_response (const gchar           *response,
                                          gdouble               *out_rsrq,
                                          GError               **error)
 {
-    g_autoptr(GRegex)        r = NULL;
-    g_autoptr(GRegex)        pre = NULL;
+    GRegex                  *r = NULL;
+    GRegex                  *pre = NULL;
     g_autoptr(GMatchInfo)    match_info = NULL;
     g_autoptr(GMatchInfo)    match_info_pre = NULL;
     GError                  *inner_error = NULL;
@@ -1546,8 +1532,7 @@ mm_cinterion_parse_smoni_query_response (const gchar           *response,
         success = TRUE;
         goto out;
     }
-    pre = g_regex_new ("\\^SMONI:\\s*([234])", 0, 0, NULL);
-    g_assert (pre != NULL);
+    pre = mm_regex_registry_get ("\\^SMONI:\\s*([234])", 0, 0);
     g_regex_match_full (pre, response, strlen (response), 0, 0, &match_info_pre, &inner_error);
     if (!inner_error && g_match_info_matches (match_info_pre)) {
         if (!mm_get_uint_from_match_info (match_info_pre, 1, &tech)) {
@@ -1557,8 +1542,7 @@ mm_cinterion_parse_smoni_query_response (const gchar           *response,
         #define FLOAT "([-+]?[0-9]+\\.?[0-9]*)"
         switch (tech) {
         case MM_CINTERION_RADIO_GEN_2G:
-            r = g_regex_new ("\\^SMONI:\\s*2G,(\\d+),"FLOAT, 0, 0, NULL);
-            g_assert (r != NULL);
+            r = mm_regex_registry_get ("\\^SMONI:\\s*2G,(\\d+),"FLOAT, 0, 0);
             g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
             if (!inner_error && g_match_info_matches (match_info)) {
                 /* skip ARFCN */
@@ -1569,8 +1553,7 @@ mm_cinterion_parse_smoni_query_response (const gchar           *response,
             }
             break;
         case MM_CINTERION_RADIO_GEN_3G:
-            r = g_regex_new ("\\^SMONI:\\s*3G,(\\d+),(\\d+),"FLOAT","FLOAT, 0, 0, NULL);
-            g_assert (r != NULL);
+            r = mm_regex_registry_get ("\\^SMONI:\\s*3G,(\\d+),(\\d+),"FLOAT","FLOAT, 0, 0);
             g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
             if (!inner_error && g_match_info_matches (match_info)) {
                 /* skip UARFCN */
@@ -1586,8 +1569,7 @@ mm_cinterion_parse_smoni_query_response (const gchar           *response,
             }
             break;
         case MM_CINTERION_RADIO_GEN_4G:
-            r = g_regex_new ("\\^SMONI:\\s*4G,(\\d+),(\\d+),(\\d+),(\\d+),(\\w+),(\\d+),(\\d+),(\\w+),(\\w+),(\\d+),([^,]*),"FLOAT","FLOAT, 0, 0, NULL);
-            g_assert (r != NULL);
+            r = mm_regex_registry_get ("\\^SMONI:\\s*4G,(\\d+),(\\d+),(\\d+),(\\d+),(\\w+),(\\d+),(\\d+),(\\w+),(\\w+),(\\d+),([^,]*),"FLOAT","FLOAT, 0, 0);
             g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
             if (!inner_error && g_match_info_matches (match_info)) {
                 /* skip EARFCN */
@@ -1720,13 +1702,12 @@ mm_cinterion_provcfg_response_to_cid (const gchar             *response,
                                       gint                    *cid,
                                       GError                 **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     g_autofree gchar      *mno = NULL;
     GError                *inner_error = NULL;
 
-    r = g_regex_new ("\\^SCFG:\\s*\"MEopMode/Prov/Cfg\",\\s*\"([0-9a-zA-Z*]*)\"", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SCFG:\\s*\"MEopMode/Prov/Cfg\",\\s*\"([0-9a-zA-Z*]*)\"", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
 
@@ -2019,13 +2000,12 @@ mm_cinterion_parse_ws46_response (const gchar  *response,
                                   MMModemMode  *result,
                                   GError      **error)
 {
-    g_autoptr(GRegex)     r = NULL;
+    GRegex               *r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
     guint                 mode_num;
 
-    r = g_regex_new ("\\+WS46:\\s*(\\d+)",
-                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+WS46:\\s*(\\d+)",
+                               G_REGEX_RAW, 0);
 
     if (!g_regex_match (r, response, 0, &match_info)) {
         g_set_error (error,
@@ -0,0 +1,478 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+/*
+ * End-to-end daemon benchmark with N simulated generic AT modems.
+ *
+ * Each simulated modem is a TestPortContext serving a scripted AT port over
+ * an abstract unix socket, added to the daemon as a virtual device through
+ * the Test interface. The whole lifecycle (probe, initialization, enabling,
+ * registration and connection) runs in the daemon exactly as with real
+ * hardware, and for each number of modems the benchmark reports:
+ *   - time from device injection to registered state (median and max)
+ *   - time from device injection to connected state (median and max)
+ *   - daemon RSS once all modems are processed
+ *   - daemon CPU time used while processing all modems
+ */
+
+#include <sys/types.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <libmm-glib.h>
+
+#include "test-port-context.h"
+#include "test-fixture.h"
+
+#define SIMULATOR_TIMEOUT_SECS    300
+#define SIMULATOR_CHECK_PERIOD_MS 50
+#define SIMULATOR_APN             "internet"
+
+/*****************************************************************************/
+/* Daemon process stats */
+
+static guint32
+get_daemon_pid (TestFixture *fixture)
+{
+    g_autoptr(GVariant) result = NULL;
+    GError             *error = NULL;
+    guint32             pid = 0;
+
+    result = g_dbus_connection_call_sync (fixture->connection,
+                                          "org.freedesktop.DBus",
+                                          "/org/freedesktop/DBus",
+                                          "org.freedesktop.DBus",
+                                          "GetConnectionUnixProcessID",
+                                          g_variant_new ("(s)", "org.freedesktop.ModemManager1"),
+                                          G_VARIANT_TYPE ("(u)"),
+                                          G_DBUS_CALL_FLAGS_NONE,
+                                          -1,
+                                          NULL,
+                                          &error);
+    if (!result)
+        g_error ("Couldn't get daemon process id: %s", error->message);
+    g_variant_get (result, "(u)", &pid);
+    return pid;
+}
+
+/* CPU time (user + system) in milliseconds */
+static guint64
+get_daemon_cpu_time_ms (guint32 pid)
+{
+    g_autofree gchar  *path = NULL;
+    g_autofree gchar  *contents = NULL;
+    g_auto(GStrv)      fields = NULL;
+    const gchar       *aux;
+    guint64            utime;
+    guint64            stime;
+
+    path = g_strdup_printf ("/proc/%u/stat", pid);
+    if (!g_file_get_contents (path, &contents, NULL, NULL))
+        return 0;
+
+    /* Skip pid and comm, the comm may have whitespaces */
+    aux = strrchr (contents, ')');
+    if (!aux)
+        return 0;
+    fields = g_strsplit (aux + 2, " ", -1);
+    /* utime and stime are fields 14 and 15, we skipped the first two */
+    if (g_strv_length (fields) < 13)
+        return 0;
+    utime = g_ascii_strtoull (fields[11], NULL, 10);
+    stime = g_ascii_strtoull (fields[12], NULL, 10);
+    return ((utime + stime) * 1000) / sysconf (_SC_CLK_TCK);
+}
+
+static guint64
+get_daemon_rss_kb (guint32 pid)
+{
+    g_autofree gchar  *path = NULL;
+    g_autofree gchar  *contents = NULL;
+    const gchar       *aux;
+
+    path = g_strdup_printf ("/proc/%u/status", pid);
+    if (!g_file_get_contents (path, &contents, NULL, NULL))
+        return 0;
+
+    aux = strstr (contents, "VmRSS:");
+    if (!aux)
+        return 0;
+    aux += strlen ("VmRSS:");
+    return g_ascii_strtoull (aux, NULL, 10);
+}
+
+/*****************************************************************************/
+/* Simulated modems */
+
+typedef struct _Simulator Simulator;
+
+typedef struct {
+    Simulator       *simulator;
+    gchar           *id;
+    gchar           *device;
+    gchar           *port_name;
+    TestPortContext *port_ctx;
+    MMObject        *obj;
+    gint64           t_start;
+    gint64           t_registered;
+    gint64           t_connected;
+    gboolean         enable_requested;
+    gboolean         connect_requested;
+    gboolean         completed;
+    gboolean         failed;
+} SimModem;
+
+struct _Simulator {
+    TestFixture *fixture;
+    MMManager   *manager;
+    GPtrArray   *modems;
+    guint        n_pending;
+    guint        n_operations;
+    gboolean     timed_out;
+};
+
+static void
+sim_modem_free (SimModem *sim)
+{
+    g_clear_object (&sim->obj);
+    if (sim->port_ctx) {
+        test_port_context_stop (sim->port_ctx);
+        test_port_context_free (sim->port_ctx);
+    }
+    g_free (sim->port_name);
+    g_free (sim->device);
+    g_free (sim->id);
+    g_slice_free (SimModem, sim);
+}
+
+static SimModem *
+sim_modem_new (Simulator *simulator,
+               guint      index)
+{
+    SimModem *sim;
+
+    sim = g_slice_new0 (SimModem);
+    sim->simulator = simulator;
+    sim->id = g_strdup_printf ("simulator-%u", index);
+    sim->device = g_strdup_printf ("/virtual/%s", sim->id);
+
+    /* Add process ID so that multiple runs in the same system don't clash */
+    sim->port_name = g_strdup_printf ("abstract:simulator%u:%ld", index, (glong) getpid ());
+
+    /* Common GSM modem script, plus what's needed to connect; all commands
+     * must be set before the port context thread starts */
+    sim->port_ctx = test_port_context_new (sim->port_name);
+    test_port_context_load_commands (sim->port_ctx, COMMON_GSM_PORT_CONF);
+    test_port_context_set_command (sim->port_ctx, "AT+CGDCONT?",
+                                   "\\r\\n+CGDCONT: 1,\\\"IP\\\",\\\"" SIMULATOR_APN "\\\",\\\"0.0.0.0\\\",0,0\\r\\n\\r\\nOK\\r\\n");
+    test_port_context_set_command (sim->port_ctx, "AT+CGDCONT=1,\"IP\",\"" SIMULATOR_APN "\"", "\\r\\nOK\\r\\n");
+    test_port_context_set_command (sim->port_ctx, "AT+CGACT?", "\\r\\n+CGACT: 1,0\\r\\n\\r\\nOK\\r\\n");
+    test_port_context_set_command (sim->port_ctx, "ATD*99***1#", "\\r\\nCONNECT 100000000\\r\\n");
+    test_port_context_start (sim->port_ctx);
+
+    return sim;
+}
+
+static void
+sim_modem_complete (SimModem    *sim,
+                    const gchar *error_message)
+{
+    if (sim->completed)
+        return;
+    sim->completed = TRUE;
+
+    if (error_message) {
+        g_test_message ("%s failed: %s", sim->id, error_message);
+        sim->failed = TRUE;
+    }
+    g_assert_cmpuint (sim->simulator->n_pending, >, 0);
+    sim->simulator->n_pending--;
+}
+
+static void
+simple_connect_ready (MMModemSimple *simple,
+                      GAsyncResult  *res,
+                      SimModem      *sim)
+{
+    g_autoptr(MMBearer) bearer = NULL;
+    g_autoptr(GError)   error = NULL;
+
+    sim->simulator->n_operations--;
+    bearer = mm_modem_simple_connect_finish (simple, res, &error);
+    if (!bearer) {
+        sim_modem_complete (sim, error->message);
+        return;
+    }
+    sim->t_connected = g_get_monotonic_time ();
+    sim_modem_complete (sim, NULL);
+}
+
+static void
+enable_ready (MMModem      *modem,
+              GAsyncResult *res,
+              SimModem     *sim)
+{
+    g_autoptr(GError) error = NULL;
+
+    sim->simulator->n_operations--;
+    if (!mm_modem_enable_finish (modem, res, &error))
+        sim_modem_complete (sim, error->message);
+}
+
+static void
+sim_modem_check (SimModem *sim)
+{
+    g_autoptr(MMModem) modem = NULL;
+    MMModemState       state;
+
+    if (sim->completed)
+        return;
+
+    modem = mm_object_get_modem (sim->obj);
+    if (!modem)
+        return;
+
+    state = mm_modem_get_state (modem);
+    if (state == MM_MODEM_STATE_FAILED) {
+        sim_modem_complete (sim, "modem in failed state");
+        return;
+    }
+
+    if (!sim->enable_requested && state == MM_MODEM_STATE_DISABLED) {
+        sim->enable_requested = TRUE;
+        sim->simulator->n_operations++;
+        mm_modem_enable (modem, NULL, (GAsyncReadyCallback) enable_ready, sim);
+        return;
+    }
+
+    if (!sim->t_registered && state >= MM_MODEM_STATE_REGISTERED)
+        sim->t_registered = g_get_monotonic_time ();
+
+    if (sim->t_registered && !sim->connect_requested) {
+        g_autoptr(MMModemSimple)             simple = NULL;
+        g_autoptr(MMSimpleConnectProperties) properties = NULL;
+
+        sim->connect_requested = TRUE;
+        simple = mm_object_get_modem_simple (sim->obj);
+        if (!simple) {
+            sim_modem_complete (sim, "no simple interface");
+            return;
+        }
+        properties = mm_simple_connect_properties_new ();
+        mm_simple_connect_properties_set_apn (properties, SIMULATOR_APN);
+        sim->simulator->n_operations++;
+        mm_modem_simple_connect (simple, properties, NULL, (GAsyncReadyCallback) simple_connect_ready, sim);
+    }
+}
+
+static gboolean
+simulator_check_cb (Simulator *simulator)
+{
+    GList *objects;
+    GList *l;
+    guint  i;
+
+    /* Match exported modem objects with the simulated devices */
+    objects = g_dbus_object_manager_get_objects (G_DBUS_OBJECT_MANAGER (simulator->manager));
+    for (l = objects; l; l = g_list_next (l)) {
+        MMObject           *obj = MM_OBJECT (l->data);
+        g_autoptr(MMModem)  modem = NULL;
+
+        modem = mm_object_get_modem (obj);
+        if (!modem)
+            continue;
+
+        for (i = 0; i < simulator->modems->len; i++) {
+            SimModem *sim = g_ptr_array_index (simulator->modems, i);
+
+            if (!sim->obj && !g_strcmp0 (sim->device, mm_modem_get_device (modem))) {
+                sim->obj = g_object_ref (obj);
+                break;
+            }
+        }
+    }
+    g_list_free_full (objects, g_object_unref);
+
+    for (i = 0; i < simulator->modems->len; i++) {
+        SimModem *sim = g_ptr_array_index (simulator->modems, i);
+
+        if (sim->obj)
+            sim_modem_check (sim);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+simulator_timeout_cb (Simulator *simulator)
+{
+    simulator->timed_out = TRUE;
+    return G_SOURCE_REMOVE;
+}
+
+/*****************************************************************************/
+
+static gint
+cmp_gint64 (const gint64 *a,
+            const gint64 *b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+static void
+report_times (const gchar *name,
+              guint        n_modems,
+              GArray      *times)
+{
+    gdouble median;
+    gdouble max;
+
+    if (!times->len) {
+        g_print ("%3u modems: %-16s none\n", n_modems, name);
+        return;
+    }
+
+    g_array_sort (times, (GCompareFunc) cmp_gint64);
+    median = (gdouble) g_array_index (times, gint64, times->len / 2) / 1000.0;
+    max = (gdouble) g_array_index (times, gint64, times->len - 1) / 1000.0;
+
+    g_test_minimized_result (median, "%u modems: median %s %.1f ms", n_modems, name, median);
+    g_test_minimized_result (max, "%u modems: max %s %.1f ms", n_modems, name, max);
+    g_print ("%3u modems: %-16s %4u ok, median %10.1f ms, max %10.1f ms\n",
+             n_modems, name, times->len, median, max);
+}
+
+static void
+benchmark_modems (TestFixture   *fixture,
+                  gconstpointer  data)
+{
+    Simulator           simulator = { 0 };
+    g_autoptr(GArray)   registered_times = NULL;
+    g_autoptr(GArray)   connected_times = NULL;
+    GError             *error = NULL;
+    guint               n_modems;
+    guint32             pid;
+    guint64             cpu_start;
+    guint64             cpu_used;
+    guint64             rss;
+    guint               check_id;
+    guint               timeout_id;
+    guint               i;
+
+    n_modems = GPOINTER_TO_UINT (data);
+    if (n_modems > 16 && !g_test_thorough ()) {
+        g_test_skip ("only run in thorough mode");
+        return;
+    }
+
+    simulator.fixture = fixture;
+    simulator.modems = g_ptr_array_new_with_free_func ((GDestroyNotify) sim_modem_free);
+
+    /* Ensure no modem is exported */
+    test_fixture_no_modem (fixture);
+
+    simulator.manager = mm_manager_new_sync (fixture->connection,
+                                             G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_NONE,
+                                             NULL,
+                                             &error);
+    if (!simulator.manager)
+        g_error ("Couldn't create manager: %s", error->message);
+
+    for (i = 0; i < n_modems; i++)
+        g_ptr_array_add (simulator.modems, sim_modem_new (&simulator, i));
+    simulator.n_pending = n_modems;
+
+    pid = get_daemon_pid (fixture);
+    cpu_start = get_daemon_cpu_time_ms (pid);
+
+    /* Inject all devices in a burst */
+    for (i = 0; i < n_modems; i++) {
+        SimModem    *sim = g_ptr_array_index (simulator.modems, i);
+        const gchar *ports[] = { sim->port_name, NULL };
+
+        sim->t_start = g_get_monotonic_time ();
+        test_fixture_set_profile (fixture, sim->id, "generic", ports);
+    }
+
+    check_id = g_timeout_add (SIMULATOR_CHECK_PERIOD_MS, (GSourceFunc) simulator_check_cb, &simulator);
+    timeout_id = g_timeout_add_seconds (SIMULATOR_TIMEOUT_SECS, (GSourceFunc) simulator_timeout_cb, &simulator);
+    while ((simulator.n_pending > 0 || simulator.n_operations > 0) && !simulator.timed_out)
+        g_main_context_iteration (NULL, TRUE);
+    g_source_remove (check_id);
+    if (!simulator.timed_out)
+        g_source_remove (timeout_id);
+
+    cpu_used = get_daemon_cpu_time_ms (pid) - cpu_start;
+    rss = get_daemon_rss_kb (pid);
+
+    registered_times = g_array_new (FALSE, FALSE, sizeof (gint64));
+    connected_times = g_array_new (FALSE, FALSE, sizeof (gint64));
+    for (i = 0; i < n_modems; i++) {
+        SimModem *sim = g_ptr_array_index (simulator.modems, i);
+        gint64    elapsed;
+
+        if (sim->t_registered) {
+            elapsed = sim->t_registered - sim->t_start;
+            g_array_append_val (registered_times, elapsed);
+        }
+        if (sim->t_connected) {
+            elapsed = sim->t_connected - sim->t_start;
+            g_array_append_val (connected_times, elapsed);
+        }
+    }
+
+    report_times ("registered", n_modems, registered_times);
+    report_times ("connected", n_modems, connected_times);
+    g_test_minimized_result ((gdouble) rss, "%u modems: daemon RSS %" G_GUINT64_FORMAT " kB", n_modems, rss);
+    g_test_minimized_result ((gdouble) cpu_used, "%u modems: daemon CPU %" G_GUINT64_FORMAT " ms", n_modems, cpu_used);
+    g_print ("%3u modems: daemon RSS %" G_GUINT64_FORMAT " kB, daemon CPU %" G_GUINT64_FORMAT " ms\n",
+             n_modems, rss, cpu_used);
+
+    /* Simulated modems can only be disposed once no operation is ongoing */
+    g_assert (!simulator.timed_out);
+    g_object_unref (simulator.manager);
+    g_ptr_array_unref (simulator.modems);
+
+    /* All modems must at least reach the registered state */
+    g_assert_cmpuint (registered_times->len, ==, n_modems);
+}
+
+/*****************************************************************************/
+
+int main (int   argc,
+          char *argv[])
+{
+    static const guint n_modems[] = { 1, 2, 4, 8, 16, 32, 64 };
+    guint              i;
+
+    g_test_init (&argc, &argv, NULL);
+
+    for (i = 0; i < G_N_ELEMENTS (n_modems); i++) {
+        g_autofree gchar *path = NULL;
+
+        path = g_strdup_printf ("/MM/Service/Generic/benchmark/%u-modems", n_modems[i]);
+        g_test_add (path,
+                    TestFixture,
+                    GUINT_TO_POINTER (n_modems[i]),
+                    (TCFunc)test_fixture_setup,
+                    (TCFunc)benchmark_modems,
+                    (TCFunc)test_fixture_teardown);
+    }
+
+    return g_test_run ();
+}
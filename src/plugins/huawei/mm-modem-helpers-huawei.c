@@ -27,6 +27,7 @@
 #include "mm-modem-helpers.h"
 #include "mm-modem-helpers-huawei.h"
 #include "mm-huawei-enums-types.h"
+#include "mm-regex-registry.h"
 
 /*****************************************************************************/
 /* ^NDISSTAT /  ^NDISSTATQRY response parser */
@@ -69,14 +70,13 @@ mm_huawei_parse_ndisstatqry_response (const gchar *response,
 
     /* If multiple fields available, try first parsing method */
     if (strchr (response, ',')) {
-        g_autoptr(GRegex)     r = NULL;
+        GRegex               *r = NULL;
         g_autoptr(GMatchInfo) match_info = NULL;
 
-        r = g_regex_new ("\\^NDISSTAT(?:QRY)?(?:Qry)?:\\s*(\\d),([^,]*),([^,]*),([^,\\r\\n]*)(?:\\r\\n)?"
-                         "(?:\\^NDISSTAT:|\\^NDISSTATQRY:)?\\s*,?(\\d)?,?([^,]*)?,?([^,]*)?,?([^,\\r\\n]*)?(?:\\r\\n)?",
-                         G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                         0, NULL);
-        g_assert (r != NULL);
+        r = mm_regex_registry_get ("\\^NDISSTAT(?:QRY)?(?:Qry)?:\\s*(\\d),([^,]*),([^,]*),([^,\\r\\n]*)(?:\\r\\n)?"
+                                   "(?:\\^NDISSTAT:|\\^NDISSTATQRY:)?\\s*,?(\\d)?,?([^,]*)?,?([^,]*)?,?([^,\\r\\n]*)?(?:\\r\\n)?",
+                                   G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                                   0);
 
         g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
         if (!inner_error && g_match_info_matches (match_info)) {
@@ -112,13 +112,12 @@ mm_huawei_parse_ndisstatqry_response (const gchar *response,
     }
     /* No separate IPv4/IPv6 info given just connected/not connected */
     else {
-        g_autoptr(GRegex)     r = NULL;
+        GRegex               *r = NULL;
         g_autoptr(GMatchInfo) match_info = NULL;
 
-        r = g_regex_new ("\\^NDISSTAT(?:QRY)?(?:Qry)?:\\s*(\\d)(?:\\r\\n)?",
-                         G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                         0, NULL);
-        g_assert (r != NULL);
+        r = mm_regex_registry_get ("\\^NDISSTAT(?:QRY)?(?:Qry)?:\\s*(\\d)(?:\\r\\n)?",
+                                   G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                                   0);
 
         g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
         if (!inner_error && g_match_info_matches (match_info)) {
@@ -206,7 +205,7 @@ mm_huawei_parse_dhcp_response (const char *reply,
                                guint *out_dns2,
                                GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     gboolean               matched;
     GError                *match_error = NULL;
@@ -228,8 +227,7 @@ mm_huawei_parse_dhcp_response (const char *reply,
      * actually 10.10.1.1.
      */
 
-    r = g_regex_new ("\\^DHCP:\\s*(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),.*$", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^DHCP:\\s*(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),.*$", 0, 0);
 
     matched = g_regex_match_full (r, reply, -1, 0, 0, &match_info, &match_error);
     if (!matched) {
@@ -272,7 +270,7 @@ mm_huawei_parse_sysinfo_response (const char *reply,
                                   guint *out_sys_submode,
                                   GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     gboolean               matched;
     GError                *match_error = NULL;
@@ -291,8 +289,7 @@ mm_huawei_parse_sysinfo_response (const char *reply,
      */
 
     /* Can't just use \d here since sometimes you get "^SYSINFO:2,1,0,3,1,,3" */
-    r = g_regex_new ("\\^SYSINFO:\\s*(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),?(\\d+)?,?(\\d+)?$", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SYSINFO:\\s*(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),?(\\d+)?,?(\\d+)?$", 0, 0);
 
     matched = g_regex_match_full (r, reply, -1, 0, 0, &match_info, &match_error);
     if (!matched) {
@@ -335,7 +332,7 @@ mm_huawei_parse_sysinfoex_response (const char *reply,
                                     guint *out_sys_submode,
                                     GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     gboolean               matched;
     GError                *match_error = NULL;
@@ -356,8 +353,7 @@ mm_huawei_parse_sysinfoex_response (const char *reply,
 
     /* ^SYSINFOEX:2,3,0,1,,3,"WCDMA",41,"HSPA+" */
 
-    r = g_regex_new ("\\^SYSINFOEX:\\s*(\\d+),(\\d+),(\\d+),(\\d+),?(\\d*),(\\d+),\"?([^\"]*)\"?,(\\d+),\"?([^\"]*)\"?$", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^SYSINFOEX:\\s*(\\d+),(\\d+),(\\d+),(\\d+),?(\\d*),(\\d+),\"?([^\"]*)\"?,(\\d+),\"?([^\"]*)\"?$", 0, 0);
 
     matched = g_regex_match_full (r, reply, -1, 0, 0, &match_info, &match_error);
     if (!matched) {
@@ -1319,7 +1315,7 @@ mm_huawei_parse_nwtime_response (const gchar        *response,
                                  MMNetworkTimezone **tzp,
                                  GError            **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *match_error = NULL;
     guint                  year = 0;
@@ -1333,8 +1329,7 @@ mm_huawei_parse_nwtime_response (const gchar        *response,
 
     g_assert (iso8601p || tzp); /* at least one */
 
-    r = g_regex_new ("\\^NWTIME:\\s*(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d*)([\\-\\+\\d]+),(\\d+)$", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^NWTIME:\\s*(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d*)([\\-\\+\\d]+),(\\d+)$", 0, 0);
 
     if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
@@ -1398,7 +1393,7 @@ mm_huawei_parse_time_response (const gchar        *response,
                                MMNetworkTimezone **tzp,
                                GError            **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *match_error = NULL;
     guint                  year = 0;
@@ -1420,8 +1415,7 @@ mm_huawei_parse_time_response (const gchar        *response,
     }
 
     /* Already in ISO-8601 format, but verify just to be sure */
-    r = g_regex_new ("\\^TIME:\\s*(\\d+)/(\\d+)/(\\d+)\\s*(\\d+):(\\d+):(\\d*)$", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^TIME:\\s*(\\d+)/(\\d+)/(\\d+)\\s*(\\d+):(\\d+):(\\d*)$", 0, 0);
 
     if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
@@ -1477,12 +1471,11 @@ mm_huawei_parse_hcsq_response (const gchar *response,
                                guint *out_value5,
                                GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *match_error = NULL;
 
-    r = g_regex_new ("\\^HCSQ:\\s*\"?([a-zA-Z]*)\"?,(\\d+),?(\\d+)?,?(\\d+)?,?(\\d+)?,?(\\d+)?$", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^HCSQ:\\s*\"?([a-zA-Z]*)\"?,(\\d+),?(\\d+)?,?(\\d+)?,?(\\d+)?,?(\\d+)?$", 0, 0);
 
     if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
@@ -1532,7 +1525,7 @@ mm_huawei_parse_cvoice_response (const gchar  *response,
                                  guint        *out_bits,
                                  GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *match_error = NULL;
     guint                  supported = 0;
@@ -1540,8 +1533,7 @@ mm_huawei_parse_cvoice_response (const gchar  *response,
     guint                  bits = 0;
 
     /* ^CVOICE: <0=supported,1=unsupported>,<hz>,<bits>,<unknown> */
-    r = g_regex_new ("\\^CVOICE:\\s*(\\d)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)$", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\^CVOICE:\\s*(\\d)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)$", 0, 0);
 
     if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
@@ -152,6 +152,7 @@ mm_port_serial_xmmrpc_xmm7360_command (MMPortSerialXmmrpcXmm7360 *self,
                             timeout_seconds,
                             allow_cached,
                             TRUE, /* raw commands always run next, never queued last */
+                            MM_PORT_SCHEDULER_PRIORITY_CONTROL,
                             cancellable,
                             (GAsyncReadyCallback)serial_command_ready,
                             task);
@@ -1291,6 +1291,7 @@ gps_enabled_ready (MMBaseModem *self,
                                     3,
                                     FALSE, /* never cached */
                                     FALSE, /* always queued last */
+                                    MM_PORT_SCHEDULER_PRIORITY_CONTROL,
                                     NULL,
                                     NULL,
                                     NULL);
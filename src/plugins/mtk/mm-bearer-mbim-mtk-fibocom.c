@@ -68,7 +68,7 @@ packet_filters_set_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error))
         mm_obj_dbg (self, "Couldn't reset IP packet filters: %s", error->message);
 
@@ -103,12 +103,12 @@ ensure_removed_filters (GTask *task)
     mm_obj_dbg (self, "Resetting IP packet filters...");
     session_id = mm_bearer_mbim_get_session_id (MM_BEARER_MBIM (self));
     message = mbim_message_ip_packet_filters_set_new (session_id, 0, NULL, NULL);
-    mbim_device_command (mm_port_mbim_peek_device (port),
-                         message,
-                         5,
-                         NULL,
-                         (GAsyncReadyCallback)packet_filters_set_ready,
-                         task);
+    mm_port_mbim_device_command (mm_port_mbim_peek_device (port),
+                                 message,
+                                 5,
+                                 NULL,
+                                 (GAsyncReadyCallback)packet_filters_set_ready,
+                                 task);
 }
 
 static void
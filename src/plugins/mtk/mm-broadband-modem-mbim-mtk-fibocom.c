@@ -278,7 +278,7 @@ signal_state_query_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
@@ -342,12 +342,12 @@ parent_setup_thresholds_ready (MMIfaceModemSignal *self,
     device = mm_port_mbim_peek_device (port);
 
     message = mbim_message_signal_state_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         5,
-                         NULL,
-                         (GAsyncReadyCallback)signal_state_query_ready,
-                         task);
+    mm_port_mbim_device_command (device,
+                                 message,
+                                 5,
+                                 NULL,
+                                 (GAsyncReadyCallback)signal_state_query_ready,
+                                 task);
 }
 
 static void
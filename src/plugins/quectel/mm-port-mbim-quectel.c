@@ -129,7 +129,7 @@ at_command_ready (MbimDevice   *device,
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_device_command_finish (device, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_qdu_command_response_parse (
@@ -210,14 +210,15 @@ at_command_to_byte_array (const gchar *command,
 }
 
 static void
-iface_port_at_command (MMIfacePortAt        *self,
-                       const gchar          *command,
-                       guint32               timeout_seconds,
-                       gboolean              is_raw,
-                       gboolean              allow_cached, /* ignored */
-                       GCancellable         *cancellable,
-                       GAsyncReadyCallback   callback,
-                       gpointer              user_data)
+iface_port_at_command (MMIfacePortAt           *self,
+                       const gchar             *command,
+                       guint32                  timeout_seconds,
+                       gboolean                 is_raw,
+                       gboolean                 allow_cached, /* ignored */
+                       MMPortSchedulerPriority  priority,     /* ignored */
+                       GCancellable            *cancellable,
+                       GAsyncReadyCallback      callback,
+                       gpointer                 user_data)
 {
     g_autoptr(MbimMessage)  request = NULL;
     g_autoptr(GByteArray)   buffer = NULL;
@@ -233,12 +234,12 @@ iface_port_at_command (MMIfacePortAt        *self,
                                                 buffer->len,
                                                 (const guint8 *)buffer->data,
                                                 NULL);
-    mbim_device_command (mm_port_mbim_peek_device (MM_PORT_MBIM (self)),
-                         request,
-                         timeout_seconds,
-                         cancellable,
-                         (GAsyncReadyCallback)at_command_ready,
-                         task);
+    mm_port_mbim_device_command (mm_port_mbim_peek_device (MM_PORT_MBIM (self)),
+                                 request,
+                                 timeout_seconds,
+                                 cancellable,
+                                 (GAsyncReadyCallback)at_command_ready,
+                                 task);
 }
 
 /*****************************************************************************/
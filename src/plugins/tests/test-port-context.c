@@ -92,6 +92,14 @@ test_port_context_load_commands (TestPortContext *self,
     g_free (contents);
 }
 
+GList *
+test_port_context_list_commands (TestPortContext *self)
+{
+    if (!self->commands)
+        return NULL;
+    return g_list_sort (g_hash_table_get_keys (self->commands), (GCompareFunc) g_strcmp0);
+}
+
 static const gchar *
 process_next_command (TestPortContext *ctx,
                       GByteArray *buffer)
@@ -242,6 +250,64 @@ client_new (TestPortContext *self,
     return client;
 }
 
+/*****************************************************************************/
+
+typedef struct {
+    TestPortContext *ctx;
+    gchar           *unsolicited;
+} SendUnsolicitedContext;
+
+static gboolean
+send_unsolicited_cb (SendUnsolicitedContext *send_ctx)
+{
+    GList *l;
+    gsize  len;
+
+    len = strlen (send_ctx->unsolicited);
+    for (l = send_ctx->ctx->clients; l; l = g_list_next (l)) {
+        Client *client = l->data;
+        GError *error = NULL;
+
+        if (!g_output_stream_write_all (g_io_stream_get_output_stream (G_IO_STREAM (client->connection)),
+                                        send_ctx->unsolicited,
+                                        len,
+                                        NULL, /* bytes_written */
+                                        NULL, /* cancellable */
+                                        &error)) {
+            g_warning ("Cannot send unsolicited message to client: %s", error->message);
+            g_error_free (error);
+        }
+    }
+    return G_SOURCE_REMOVE;
+}
+
+static void
+send_unsolicited_context_free (SendUnsolicitedContext *send_ctx)
+{
+    g_free (send_ctx->unsolicited);
+    g_slice_free (SendUnsolicitedContext, send_ctx);
+}
+
+void
+test_port_context_send_unsolicited (TestPortContext *self,
+                                    const gchar *unsolicited)
+{
+    SendUnsolicitedContext *send_ctx;
+
+    g_assert (self->context != NULL);
+
+    /* Messages are written from within the port context thread, so that they
+     * don't interleave with command responses */
+    send_ctx = g_slice_new0 (SendUnsolicitedContext);
+    send_ctx->ctx = self;
+    send_ctx->unsolicited = g_strcompress (unsolicited);
+    g_main_context_invoke_full (self->context,
+                                G_PRIORITY_DEFAULT,
+                                (GSourceFunc) send_unsolicited_cb,
+                                send_ctx,
+                                (GDestroyNotify) send_unsolicited_context_free);
+}
+
 /* /\*****************************************************************************\/ */
 
 static void
@@ -31,5 +31,9 @@ void             test_port_context_set_command   (TestPortContext *self,
                                                   const gchar *response);
 void             test_port_context_load_commands (TestPortContext *self,
                                                   const gchar *commands_file);
+GList           *test_port_context_list_commands (TestPortContext *self);
+
+void             test_port_context_send_unsolicited (TestPortContext *self,
+                                                     const gchar *unsolicited);
 
 #endif /* TEST_PORT_CONTEXT_H */
@@ -395,12 +395,13 @@ activate_3gpp (GTask *task)
 
     cmd = g_strdup_printf ("+CGACT=1,%u", ctx->cid);
     mm_obj_dbg (self, "activating PDP context #%u...", ctx->cid);
-    mm_base_modem_at_command (MM_BASE_MODEM (ctx->modem),
-                              cmd,
-                              MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
-                              FALSE,
-                              (GAsyncReadyCallback) cgact_activate_ready,
-                              task);
+    mm_base_modem_at_command_with_priority (MM_BASE_MODEM (ctx->modem),
+                                            cmd,
+                                            MM_BASE_BEARER_DEFAULT_CONNECTION_TIMEOUT,
+                                            FALSE,
+                                            MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+                                            (GAsyncReadyCallback) cgact_activate_ready,
+                                            task);
 }
 
 static void
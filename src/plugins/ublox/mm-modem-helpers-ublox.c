@@ -19,6 +19,7 @@
 #include "mm-log.h"
 #include "mm-modem-helpers.h"
 #include "mm-modem-helpers-ublox.h"
+#include "mm-regex-registry.h"
 
 /*****************************************************************************/
 /* +UPINCNT response parser */
@@ -31,7 +32,7 @@ mm_ublox_parse_upincnt_response (const gchar  *response,
                                  guint        *out_puk2_attempts,
                                  GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     guint                  pin_attempts = 0;
@@ -48,8 +49,7 @@ mm_ublox_parse_upincnt_response (const gchar  *response,
     /* Response may be e.g.:
      * +UPINCNT: 3,3,10,10
      */
-    r = g_regex_new ("\\+UPINCNT: (\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+UPINCNT: (\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
@@ -104,7 +104,7 @@ mm_ublox_parse_uusbconf_response (const gchar        *response,
                                   MMUbloxUsbProfile  *out_profile,
                                   GError            **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     MMUbloxUsbProfile      profile = MM_UBLOX_USB_PROFILE_UNKNOWN;
@@ -119,8 +119,7 @@ mm_ublox_parse_uusbconf_response (const gchar        *response,
      * Note: we don't rely on the PID; assuming future new modules will
      * have a different PID but they may keep the profile names.
      */
-    r = g_regex_new ("\\+UUSBCONF: (\\d+),([^,]*),([^,]*),([^,]*)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+UUSBCONF: (\\d+),([^,]*),([^,]*),([^,]*)(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
@@ -162,7 +161,7 @@ mm_ublox_parse_ubmconf_response (const gchar            *response,
                                  MMUbloxNetworkingMode  *out_mode,
                                  GError                **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     MMUbloxNetworkingMode  mode = MM_UBLOX_NETWORKING_MODE_UNKNOWN;
@@ -173,8 +172,7 @@ mm_ublox_parse_ubmconf_response (const gchar            *response,
      * +UBMCONF: 1
      * +UBMCONF: 2
      */
-    r = g_regex_new ("\\+UBMCONF: (\\d+)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+UBMCONF: (\\d+)(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
@@ -224,7 +222,7 @@ mm_ublox_parse_uipaddr_response (const gchar  *response,
                                  gchar       **out_ipv6_link_local_address,
                                  GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     guint                  cid = 0;
@@ -241,8 +239,7 @@ mm_ublox_parse_uipaddr_response (const gchar  *response,
      *
      * We assume only ONE line is returned; because we request +UIPADDR with a specific N CID.
      */
-    r = g_regex_new ("\\+UIPADDR: (\\d+),([^,]*),([^,]*),([^,]*),([^,]*),([^,]*)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+UIPADDR: (\\d+),([^,]*),([^,]*),([^,]*),([^,]*),([^,]*)(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error) {
@@ -1551,7 +1548,7 @@ GArray *
 mm_ublox_parse_uact_response (const gchar  *response,
                               GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     GArray                *nums = NULL;
@@ -1561,9 +1558,8 @@ mm_ublox_parse_uact_response (const gchar  *response,
      * AT+UACT?
      * +UACT: ,,,900,1800,1,8,101,103,107,108,120,138
      */
-    r = g_regex_new ("\\+UACT: ([^,]*),([^,]*),([^,]*),(.*)(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+UACT: ([^,]*),([^,]*),([^,]*),(.*)(?:\\r\\n)?",
+                               G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
@@ -1629,7 +1625,7 @@ mm_ublox_parse_uact_test (const gchar  *response,
                           GArray      **bands4g_out,
                           GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     g_auto(GStrv)          split = NULL;
     GError                *inner_error = NULL;
@@ -1646,9 +1642,8 @@ mm_ublox_parse_uact_test (const gchar  *response,
      * AT+UACT=?
      * +UACT: ,,,(900,1800),(1,8),(101,103,107,108,120),(138)
      */
-    r = g_regex_new ("\\+UACT: ([^,]*),([^,]*),([^,]*),(.*)(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+UACT: ([^,]*),([^,]*),([^,]*),(.*)(?:\\r\\n)?",
+                               G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
@@ -1752,7 +1747,7 @@ mm_ublox_parse_urat_read_response (const gchar  *response,
                                    MMModemMode  *out_preferred,
                                    GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     MMModemMode            allowed = MM_MODEM_MODE_NONE;
@@ -1766,8 +1761,7 @@ mm_ublox_parse_urat_read_response (const gchar  *response,
      * +URAT: 1,2
      * +URAT: 1
      */
-    r = g_regex_new ("\\+URAT: (\\d+)(?:,(\\d+))?(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+URAT: (\\d+)(?:,(\\d+))?(?:\\r\\n)?", 0, 0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
@@ -1966,7 +1960,7 @@ mm_ublox_parse_ugcntrd_response_for_cid (const gchar  *response,
                                          guint64      *out_total_rx_bytes,
                                          GError      **error)
 {
-    g_autoptr(GRegex)      r = NULL;
+    GRegex                *r = NULL;
     g_autoptr(GMatchInfo)  match_info = NULL;
     GError                *inner_error = NULL;
     guint64                session_tx_bytes = 0;
@@ -1979,9 +1973,8 @@ mm_ublox_parse_ugcntrd_response_for_cid (const gchar  *response,
      *  +UGCNTRD: 31,2704,1819,2724,1839
      * We assume only ONE line is returned.
      */
-    r = g_regex_new ("\\+UGCNTRD:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
+    r = mm_regex_registry_get ("\\+UGCNTRD:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)",
+                               G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
 
     /* Report invalid CID given */
     if (!in_cid) {
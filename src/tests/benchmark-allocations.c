@@ -0,0 +1,80 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+#include <stdlib.h>
+
+#include <glib.h>
+
+#include "benchmark-allocations.h"
+
+#if defined WITH_ALLOCATION_COUNT
+
+extern void *__libc_malloc  (size_t size);
+extern void *__libc_calloc  (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+static __thread gboolean count_allocations;
+static __thread guint64  n_allocations;
+
+void *
+malloc (size_t size)
+{
+    if (count_allocations)
+        n_allocations++;
+    return __libc_malloc (size);
+}
+
+void *
+calloc (size_t nmemb,
+        size_t size)
+{
+    if (count_allocations)
+        n_allocations++;
+    return __libc_calloc (nmemb, size);
+}
+
+void *
+realloc (void   *ptr,
+         size_t  size)
+{
+    if (count_allocations)
+        n_allocations++;
+    return __libc_realloc (ptr, size);
+}
+
+#endif
+
+/*****************************************************************************/
+
+void
+mm_benchmark_allocations_start (void)
+{
+#if defined WITH_ALLOCATION_COUNT
+    n_allocations = 0;
+    count_allocations = TRUE;
+#endif
+}
+
+guint64
+mm_benchmark_allocations_stop (void)
+{
+#if defined WITH_ALLOCATION_COUNT
+    count_allocations = FALSE;
+    return n_allocations;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,33 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#ifndef MM_BENCHMARK_ALLOCATIONS_H
+#define MM_BENCHMARK_ALLOCATIONS_H
+
+#include <glib.h>
+
+/* Allocation counting for the benchmarks: only available with glibc, and
+ * only if we're not running under a sanitizer that also intercepts the
+ * allocator. Allocations are counted per thread, between the start and
+ * stop calls. */
+
+#if defined (__GLIBC__) && !defined (__SANITIZE_ADDRESS__)
+# define WITH_ALLOCATION_COUNT 1
+#endif
+
+void    mm_benchmark_allocations_start (void);
+guint64 mm_benchmark_allocations_stop  (void);
+
+#endif /* MM_BENCHMARK_ALLOCATIONS_H */
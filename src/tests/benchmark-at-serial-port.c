@@ -0,0 +1,682 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+/*
+ * Benchmark of the AT port stack (MMPortSerialAt, the v1 serial parser, the
+ * unsolicited message handlers and the AT response parsers) against a fake
+ * AT endpoint served by a TestPortContext.
+ *
+ * For each scenario the following values are reported:
+ *   - messages per second (command responses and unsolicited messages)
+ *   - CPU time per message, of the thread running the port
+ *   - memory allocations per message, of the thread running the port
+ */
+
+#include <config.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include "mm-port-serial-at.h"
+#include "mm-serial-parsers.h"
+#include "mm-modem-helpers.h"
+#include "mm-log-test.h"
+
+#include "test-port-context.h"
+#include "benchmark-allocations.h"
+
+#define BENCHMARK_TIMEOUT_SECS 60
+
+/*****************************************************************************/
+
+typedef struct {
+    gint64  wall_time;
+    gint64  cpu_time;
+    guint64 n_allocations;
+} Sample;
+
+static gint64
+thread_cpu_time (void)
+{
+    struct rusage usage;
+
+    if (getrusage (RUSAGE_THREAD, &usage) < 0)
+        return 0;
+    return ((gint64) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * G_USEC_PER_SEC +
+            (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec));
+}
+
+static void
+sample_start (Sample *sample)
+{
+    sample->wall_time = g_get_monotonic_time ();
+    sample->cpu_time = thread_cpu_time ();
+    mm_benchmark_allocations_start ();
+}
+
+static void
+sample_stop (Sample *sample)
+{
+    sample->n_allocations = mm_benchmark_allocations_stop ();
+    sample->wall_time = g_get_monotonic_time () - sample->wall_time;
+    sample->cpu_time = thread_cpu_time () - sample->cpu_time;
+}
+
+static void
+sample_report (const gchar  *name,
+               const Sample *sample,
+               guint         n_messages)
+{
+    gdouble msgs_per_sec;
+    gdouble cpu_per_msg;
+
+    g_assert_cmpuint (n_messages, >, 0);
+
+    msgs_per_sec = (gdouble) n_messages * G_USEC_PER_SEC / MAX (sample->wall_time, 1);
+    cpu_per_msg = (gdouble) sample->cpu_time / n_messages;
+
+    g_test_maximized_result (msgs_per_sec, "%s: %.1f messages/s", name, msgs_per_sec);
+    g_test_minimized_result (cpu_per_msg, "%s: %.2f us CPU/message", name, cpu_per_msg);
+#if defined WITH_ALLOCATION_COUNT
+    g_test_minimized_result ((gdouble) sample->n_allocations / n_messages,
+                             "%s: %.2f allocations/message", name, (gdouble) sample->n_allocations / n_messages);
+    g_print ("%-24s %8u msgs %12.1f msgs/s %10.2f us/msg %10.2f allocs/msg\n",
+             name, n_messages, msgs_per_sec, cpu_per_msg, (gdouble) sample->n_allocations / n_messages);
+#else
+    g_print ("%-24s %8u msgs %12.1f msgs/s %10.2f us/msg\n",
+             name, n_messages, msgs_per_sec, cpu_per_msg);
+#endif
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    TestPortContext *port_ctx;
+    gchar           *port_name;
+    MMPortSerialAt  *port;
+    GPtrArray       *unsolicited_regexes;
+    guint            n_unsolicited;
+    guint            n_responses;
+    gboolean         timed_out;
+} BenchmarkContext;
+
+static BenchmarkContext *benchmark_ctx;
+
+static gboolean
+benchmark_timeout_cb (BenchmarkContext *ctx)
+{
+    ctx->timed_out = TRUE;
+    return G_SOURCE_REMOVE;
+}
+
+static void
+unsolicited_cb (MMPortSerialAt   *port,
+                GMatchInfo       *match_info,
+                BenchmarkContext *ctx)
+{
+    ctx->n_unsolicited++;
+}
+
+/*****************************************************************************/
+/* Response processors, the same ones the modem objects run */
+
+static void
+process_response (const gchar *command,
+                  const gchar *response)
+{
+    GError *error = NULL;
+    GList  *list = NULL;
+
+    if (g_str_has_prefix (command, "AT+COPS=?")) {
+        list = mm_3gpp_parse_cops_test_response (response, MM_MODEM_CHARSET_GSM, NULL, &error);
+        g_assert_no_error (error);
+        mm_3gpp_network_info_list_free (list);
+    } else if (g_str_has_prefix (command, "AT+CMGL")) {
+        list = mm_3gpp_parse_pdu_cmgl_response (response, &error);
+        g_assert_no_error (error);
+        mm_3gpp_pdu_info_list_free (list);
+    }
+}
+
+typedef struct {
+    const gchar *command;
+    gboolean     done;
+} CommandContext;
+
+static void
+command_ready (MMPortSerialAt *port,
+               GAsyncResult   *res,
+               CommandContext *cmd_ctx)
+{
+    g_autofree gchar *response = NULL;
+
+    /* Errors are expected for the commands the fake endpoint doesn't know
+     * about; they still count as processed messages */
+    response = mm_port_serial_at_command_finish (port, res, NULL);
+    if (response)
+        process_response (cmd_ctx->command, response);
+    benchmark_ctx->n_responses++;
+    cmd_ctx->done = TRUE;
+}
+
+static void
+run_command (BenchmarkContext *ctx,
+             const gchar      *command)
+{
+    CommandContext cmd_ctx = { .command = command, .done = FALSE };
+
+    mm_port_serial_at_command (ctx->port, command, 10, FALSE, FALSE, NULL,
+                               (GAsyncReadyCallback) command_ready, &cmd_ctx);
+    while (!cmd_ctx.done && !ctx->timed_out)
+        g_main_context_iteration (NULL, TRUE);
+    g_assert (!ctx->timed_out);
+}
+
+static void
+run_scenario (const gchar        *name,
+              const gchar *const *commands,
+              guint               n_iterations,
+              const gchar        *unsolicited,
+              guint               n_unsolicited_per_iteration)
+{
+    BenchmarkContext *ctx = benchmark_ctx;
+    Sample            sample = { 0 };
+    guint             timeout_id;
+    guint             i;
+    guint             j;
+
+    ctx->n_unsolicited = 0;
+    ctx->n_responses = 0;
+    ctx->timed_out = FALSE;
+    timeout_id = g_timeout_add_seconds (BENCHMARK_TIMEOUT_SECS, (GSourceFunc) benchmark_timeout_cb, ctx);
+
+    sample_start (&sample);
+    for (i = 0; i < n_iterations; i++) {
+        if (unsolicited) {
+            guint expected;
+
+            expected = ctx->n_unsolicited + n_unsolicited_per_iteration;
+            test_port_context_send_unsolicited (ctx->port_ctx, unsolicited);
+            while (ctx->n_unsolicited < expected && !ctx->timed_out)
+                g_main_context_iteration (NULL, TRUE);
+            g_assert (!ctx->timed_out);
+        }
+        for (j = 0; commands && commands[j]; j++)
+            run_command (ctx, commands[j]);
+    }
+    sample_stop (&sample);
+
+    g_source_remove (timeout_id);
+
+    sample_report (name, &sample, ctx->n_responses + ctx->n_unsolicited);
+}
+
+/*****************************************************************************/
+/* Scenarios */
+
+static guint
+get_n_iterations (guint base)
+{
+    return g_test_thorough () ? base * 10 : base;
+}
+
+static void
+benchmark_generic_session (void)
+{
+    g_autoptr(GPtrArray) commands = NULL;
+    GList               *list;
+    GList               *l;
+
+    /* Replay every command of the common recorded GSM port session */
+    list = test_port_context_list_commands (benchmark_ctx->port_ctx);
+    commands = g_ptr_array_new ();
+    for (l = list; l; l = g_list_next (l)) {
+        if (g_str_has_prefix ((const gchar *) l->data, "AT"))
+            g_ptr_array_add (commands, l->data);
+    }
+    g_ptr_array_add (commands, NULL);
+    g_list_free (list);
+
+    run_scenario ("generic-session", (const gchar *const *) commands->pdata, get_n_iterations (100), NULL, 0);
+}
+
+static void
+benchmark_cops_test (void)
+{
+    static const gchar *commands[] = { "AT+COPS=?", NULL };
+
+    run_scenario ("cops-test", commands, get_n_iterations (200), NULL, 0);
+}
+
+static void
+benchmark_cmgl (void)
+{
+    static const gchar *commands[] = { "AT+CMGL=4", NULL };
+
+    run_scenario ("cmgl", commands, get_n_iterations (50), NULL, 0);
+}
+
+#define STORM_BURST_SIZE 25
+
+static const gchar *storm_messages[] = {
+    "\\r\\n+CREG: 1,\\\"1A2B\\\",\\\"00C0FFEE\\\",7\\r\\n",
+    "\\r\\n+CGREG: 5\\r\\n",
+    "\\r\\n+CIEV: 2,3\\r\\n",
+    "\\r\\n+CMTI: \\\"SM\\\",5\\r\\n",
+    "\\r\\n+CEREG: 1,\\\"1A2B\\\",\\\"00C0FFEE\\\",7\\r\\n",
+};
+
+static void
+benchmark_unsolicited_storm (void)
+{
+    g_autoptr(GString) burst = NULL;
+    guint              i;
+
+    burst = g_string_new (NULL);
+    for (i = 0; i < STORM_BURST_SIZE; i++)
+        g_string_append (burst, storm_messages[i % G_N_ELEMENTS (storm_messages)]);
+
+    run_scenario ("unsolicited-storm", NULL, get_n_iterations (200), burst->str, STORM_BURST_SIZE);
+}
+
+static void
+benchmark_unsolicited_storm_with_commands (void)
+{
+    static const gchar *commands[] = { "AT+CSQ", "AT+CREG?", NULL };
+    g_autoptr(GString)  burst = NULL;
+    guint               i;
+
+    burst = g_string_new (NULL);
+    for (i = 0; i < STORM_BURST_SIZE; i++)
+        g_string_append (burst, storm_messages[i % G_N_ELEMENTS (storm_messages)]);
+
+    run_scenario ("unsolicited-mixed", commands, get_n_iterations (200), burst->str, STORM_BURST_SIZE);
+}
+
+/*****************************************************************************/
+/* Per-plugin scenarios
+ *
+ * The plugins add their own unsolicited message handlers on top of the
+ * generic ones, and these are run against every chunk read from the port. The
+ * patterns below are the ones setup by each plugin (keep them in sync), and
+ * the bursts mix the plugin specific URCs with the generic ones, as sent by
+ * the real devices. Plugin specific command replies are also run through the
+ * response parser.
+ */
+
+typedef struct {
+    const gchar *command;
+    const gchar *response;
+} PluginCommand;
+
+typedef struct {
+    const gchar         *name;
+    const gchar *const  *patterns;
+    const gchar *const  *urcs;
+    const PluginCommand *commands;
+} PluginProfile;
+
+static const gchar *huawei_patterns[] = {
+    "\\r\\n\\^RSSI:\\s*(\\d+)\\r\\n",
+    "\\r\\n\\^RSSILVL:\\s*(\\d+)\\r+\\n",
+    "\\r\\n\\^HRSSILVL:\\s*(\\d+)\\r+\\n",
+    "\\r\\n\\^MODE:\\s*(\\d*),?(\\d*)\\r+\\n",
+    "\\r\\n\\^DSFLOWRPT:(.+)\\r\\n",
+    "\\r\\n(\\^NDISSTAT:.+)\\r+\\n",
+    "\\r\\n\\^ORIG:\\s*(\\d+),\\s*(\\d+)\\r\\n",
+    "\\r\\n\\^CONF:\\s*(\\d+)\\r\\n",
+    "\\r\\n\\^CONN:\\s*(\\d+),\\s*(\\d+)\\r\\n",
+    "\\r\\n\\^CEND:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d*))?\\r\\n",
+    "\\r\\n\\^DDTMF:\\s*([0-9A-D\\*\\#])\\r\\n",
+    "\\r\\n\\^BOOT:.+\\r\\n",
+    "\\r\\n\\^CONNECT .+\\r\\n",
+    "\\r\\n\\^CSNR:.+\\r\\n",
+    "\\r\\n\\+CUSATP:.+\\r\\n",
+    "\\r\\n\\+CUSATEND\\r\\n",
+    "\\r\\n\\^DSDORMANT:.+\\r\\n",
+    "\\r\\n\\^SIMST:.+\\r\\n",
+    "\\r\\n\\^SRVST:.+\\r\\n",
+    "\\r\\n\\^STIN:.+\\r\\n",
+    "\\r\\n(\\^HCSQ:.+)\\r+\\n",
+    "\\r\\n\\^PDPDEACT:.+\\r+\\n",
+    "\\r\\n\\^NDISEND:.+\\r+\\n",
+    "\\r\\n\\^RFSWITCH:.+\\r\\n",
+    "\\r\\n\\^POSITION:.+\\r\\n",
+    "\\r\\n\\^POSEND:.+\\r\\n",
+    "\\r\\n\\^ECCLIST:.+\\r\\n",
+    "\\r\\n\\^LTERSRP:.+\\r\\n",
+    "\\r\\n\\^CSCHANNELINFO:.+\\r\\n",
+    "\\r\\n\\^CCALLSTATE:.+\\r\\n",
+    "\\r\\n\\^EONS:.+\\r\\n",
+    "\\r\\n\\^LWURC:.+\\r\\n",
+    NULL
+};
+
+static const gchar *huawei_urcs[] = {
+    "\\r\\n^RSSI: 20\\r\\n",
+    "\\r\\n^MODE: 7,17\\r\\n",
+    "\\r\\n^DSFLOWRPT:0000063D,00000000,00000000,0000000000000000,0000000000000000,0003E800,0003E800\\r\\n",
+    "\\r\\n^HCSQ: \\\"LTE\\\",48,42,122,28\\r\\n",
+    "\\r\\n^NDISSTAT: 1,,,\\\"IPV4\\\"\\r\\n",
+    "\\r\\n^SRVST: 2\\r\\n",
+    "\\r\\n^LTERSRP: -95,-9\\r\\n",
+    NULL
+};
+
+static const PluginCommand huawei_commands[] = {
+    { "AT^SYSINFOEX", "\\r\\n^SYSINFOEX: 2,3,0,1,,6,\\\"LTE\\\",101,\\\"LTE\\\"\\r\\n\\r\\nOK\\r\\n" },
+    { "AT^CARDLOCK?", "\\r\\n^CARDLOCK: 2,10,0\\r\\n\\r\\nOK\\r\\n" },
+    { NULL }
+};
+
+static const gchar *cinterion_patterns[] = {
+    "\\r\\n\\+CIEV:\\s*([a-z]+),(\\d+)\\r\\n",
+    "\\r\\n\\^SYSSTART.*\\r\\n",
+    "\\^SCKS:\\s*([0-3])\\r\\n",
+    "\\r\\n\\+CIEV:\\s*simlocal,((\\d,)*\\d)\\r\\n",
+    "\\r\\n(\\^SLCC: .*\\r\\n)*\\^SLCC: \\r\\n",
+    "\\r\\n\\+CTZU:\\s*\"(\\d+)\\/(\\d+)\\/(\\d+),(\\d+):(\\d+):(\\d+)\",([\\-\\+\\d]+)(?:,(\\d+))?(?:\\r\\n)?",
+    NULL
+};
+
+static const gchar *cinterion_urcs[] = {
+    "\\r\\n+CIEV: psinfo,10\\r\\n",
+    "\\r\\n+CIEV: service,1\\r\\n",
+    "\\r\\n^SYSSTART\\r\\n",
+    "\\r\\n+CTZU: \\\"26/10/19,10:21:33\\\",+8,0\\r\\n",
+    NULL
+};
+
+static const PluginCommand cinterion_commands[] = {
+    { "AT^SMONI",  "\\r\\n^SMONI: 4G,6300,20,10,10,FDD,262,02,BF75,0345103,350,33,-94,-7,NOCONN\\r\\n\\r\\nOK\\r\\n" },
+    { "AT^SXRAT?", "\\r\\n^SXRAT: 3,3,2\\r\\n\\r\\nOK\\r\\n" },
+    { NULL }
+};
+
+static const gchar *option_patterns[] = {
+    "\\r\\n_OSSYSI:\\s*(\\d+)\\r\\n",
+    "\\r\\n_OCTI:\\s*(\\d+)\\r\\n",
+    "\\r\\n_OUWCTI:\\s*(\\d+)\\r\\n",
+    "\\r\\n_OSIGQ:\\s*(\\d+),(\\d)\\r\\n",
+    "\\r\\n\\+PACSP0\\r\\n",
+    "_OWANCALL: (\\d),\\s*(\\d)\\r\\n",
+    NULL
+};
+
+static const gchar *option_urcs[] = {
+    "\\r\\n_OSSYSI: 2\\r\\n",
+    "\\r\\n_OCTI: 3\\r\\n",
+    "\\r\\n_OUWCTI: 4\\r\\n",
+    "\\r\\n_OSIGQ: 20,0\\r\\n",
+    "\\r\\n+PACSP0\\r\\n",
+    NULL
+};
+
+static const PluginCommand option_commands[] = {
+    { "AT_OPSYS?", "\\r\\n_OPSYS: 3,2\\r\\n\\r\\nOK\\r\\n" },
+    { "AT_OSSYS?", "\\r\\n_OSSYS: 0,2\\r\\n\\r\\nOK\\r\\n" },
+    { NULL }
+};
+
+static const gchar *simtech_patterns[] = {
+    "\\r\\n\\+CNSMOD:\\s*(\\d+)\\r\\n",
+    "\\r\\n\\+CSQ:\\s*(\\d+),(\\d+)\\r\\n",
+    "\\r\\n(PB DONE)|(SMS DONE)\\r\\n",
+    "\\r\\n\\+NITZ:(.*)\\r\\n",
+    "\\r\\n\\+CPIN: (.*)\\r\\n",
+    "\\r\\n(\\+CLCC: .*\\r\\n)+",
+    "\\r\\nVOICE CALL:\\s*([A-Z]+)(?::\\s*(\\d+))?\\r\\n",
+    "\\r\\nMISSED_CALL:\\s*(.+)\\r\\n",
+    "(?:\\r)+\\n\\+CRING:\\s*(\\S+)(?:\\r)+\\n",
+    "(?:\\r)+\\n\\+RXDTMF:\\s*([0-9A-D\\*\\#])(?:\\r)+\\n",
+    NULL
+};
+
+static const gchar *simtech_urcs[] = {
+    "\\r\\n+CNSMOD: 8\\r\\n",
+    "\\r\\n+CSQ: 20,99\\r\\n",
+    "\\r\\n+NITZ: 26/10/19,10:21:33+8,0\\r\\n",
+    "\\r\\nVOICE CALL: END: 000012\\r\\n",
+    "\\r\\n+CLCC: 1,1,4,0,0,\\\"+1234567890\\\",145\\r\\n",
+    NULL
+};
+
+/* No AT+CSQ here, the +CSQ URC handler would take the reply */
+static const PluginCommand simtech_commands[] = {
+    { "AT+CPSI?",   "\\r\\n+CPSI: LTE,Online,262-02,0xBF75,3453103,350,EUTRAN-BAND20,6300,5,5,-94,-1040,-720,15\\r\\n\\r\\nOK\\r\\n" },
+    { "AT+CNSMOD?", "\\r\\n+CNSMOD: 0,8\\r\\n\\r\\nOK\\r\\n" },
+    { NULL }
+};
+
+static const gchar *ublox_patterns[] = {
+    "\\r\\n\\+UCALLSTAT:\\s*(\\d+),(\\d+)\\r\\n",
+    "\\r\\n\\+UUDTMFD:\\s*([0-9A-D\\*\\#])\\r\\n",
+    "\\r\\n\\+PBREADY\\r\\n",
+    "\\r\\n\\+CIEV: 9,([0-1]{1})\\r\\n",
+    NULL
+};
+
+static const gchar *ublox_urcs[] = {
+    "\\r\\n+UCALLSTAT: 1,0\\r\\n",
+    "\\r\\n+UUDTMFD: 5\\r\\n",
+    "\\r\\n+PBREADY\\r\\n",
+    "\\r\\n+CIEV: 9,1\\r\\n",
+    NULL
+};
+
+static const PluginCommand ublox_commands[] = {
+    { "AT+URAT?",     "\\r\\n+URAT: 1,2\\r\\n\\r\\nOK\\r\\n" },
+    { "AT+UBANDSEL?", "\\r\\n+UBANDSEL: 850,900,1800,1900\\r\\n\\r\\nOK\\r\\n" },
+    { NULL }
+};
+
+static const PluginProfile plugin_profiles[] = {
+    { "huawei",    huawei_patterns,    huawei_urcs,    huawei_commands    },
+    { "cinterion", cinterion_patterns, cinterion_urcs, cinterion_commands },
+    { "option",    option_patterns,    option_urcs,    option_commands    },
+    { "simtech",   simtech_patterns,   simtech_urcs,   simtech_commands   },
+    { "ublox",     ublox_patterns,     ublox_urcs,     ublox_commands     },
+};
+
+static void
+benchmark_plugin (gconstpointer data)
+{
+    const PluginProfile *profile = data;
+    g_autoptr(GPtrArray) regexes = NULL;
+    g_autoptr(GPtrArray) commands = NULL;
+    g_autoptr(GString)   burst = NULL;
+    g_autofree gchar    *name = NULL;
+    guint                n_urcs;
+    guint                i;
+
+    regexes = g_ptr_array_new_with_free_func ((GDestroyNotify) g_regex_unref);
+    for (i = 0; profile->patterns[i]; i++) {
+        GRegex *regex;
+
+        regex = g_regex_new (profile->patterns[i], G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
+        g_assert (regex);
+        mm_port_serial_at_add_unsolicited_msg_handler (benchmark_ctx->port,
+                                                       regex,
+                                                       (MMPortSerialAtUnsolicitedMsgFn) unsolicited_cb,
+                                                       benchmark_ctx,
+                                                       NULL);
+        g_ptr_array_add (regexes, regex);
+    }
+
+    commands = g_ptr_array_new ();
+    for (i = 0; profile->commands[i].command; i++)
+        g_ptr_array_add (commands, (gpointer) profile->commands[i].command);
+    g_ptr_array_add (commands, NULL);
+
+    /* Every other message in the burst is a plugin specific one */
+    n_urcs = g_strv_length ((gchar **) profile->urcs);
+    burst = g_string_new (NULL);
+    for (i = 0; i < STORM_BURST_SIZE; i++) {
+        if (i % 2)
+            g_string_append (burst, storm_messages[(i / 2) % G_N_ELEMENTS (storm_messages)]);
+        else
+            g_string_append (burst, profile->urcs[(i / 2) % n_urcs]);
+    }
+
+    name = g_strdup_printf ("plugin-%s", profile->name);
+    run_scenario (name, (const gchar *const *) commands->pdata, get_n_iterations (200), burst->str, STORM_BURST_SIZE);
+
+    /* There is no way to remove handlers, so leave the port as it was for
+     * the next scenario by disabling them */
+    for (i = 0; i < regexes->len; i++)
+        mm_port_serial_at_enable_unsolicited_msg_handler (benchmark_ctx->port, g_ptr_array_index (regexes, i), FALSE);
+}
+
+/*****************************************************************************/
+
+#define COPS_N_OPERATORS 40
+#define CMGL_N_MESSAGES  250
+#define CMGL_PDU                                                                \
+    "07914306073011F00405812261F700003130916191314095C27"                     \
+    "4D96D2FBBD3E437280CB2BEC961F3DB5D76818EF2F0381D9E83E06F39A8CC2E9FD372F" \
+    "77BEE0249CBE37A594E0E83E2F532085E2F93CB73D0B93CA7A7DFEEB01C447F93DF731" \
+    "0BD3E07CDCB727B7A9C7ECF41E432C8FC96B7C32079189E26874179D0F8DD7E93C3A0B" \
+    "21B246AA641D637396C7EBBCB22D0FD7E77B5D376B3AB3C07"
+
+static void
+setup_large_responses (TestPortContext *port_ctx)
+{
+    g_autoptr(GString) cops = NULL;
+    g_autoptr(GString) cmgl = NULL;
+    guint              i;
+
+    /* Responses are given in the same escaped format as in the commands
+     * files, they're compressed when stored */
+    cops = g_string_new ("\\r\\n+COPS: ");
+    for (i = 0; i < COPS_N_OPERATORS; i++)
+        g_string_append_printf (cops, "%s(%u,\\\"Operator %u\\\",\\\"OP%u\\\",\\\"%u\\\",%u)",
+                                i ? "," : "", (i % 3) + 1, i, i, 21400 + i, (i % 2) ? 7 : 2);
+    g_string_append (cops, ",,(0,1,2,3,4),(0,1,2)\\r\\n\\r\\nOK\\r\\n");
+    test_port_context_set_command (port_ctx, "AT+COPS=?", cops->str);
+
+    cmgl = g_string_new ("\\r\\n");
+    for (i = 0; i < CMGL_N_MESSAGES; i++)
+        g_string_append_printf (cmgl, "+CMGL: %u,1,,147\\r\\n%s\\r\\n", i, CMGL_PDU);
+    g_string_append (cmgl, "\\r\\nOK\\r\\n");
+    test_port_context_set_command (port_ctx, "AT+CMGL=4", cmgl->str);
+
+    test_port_context_set_command (port_ctx, "AT+CSQ", "\\r\\n+CSQ: 20,99\\r\\n\\r\\nOK\\r\\n");
+    test_port_context_set_command (port_ctx, "AT+CREG?", "\\r\\n+CREG: 2,1,\\\"1A2B\\\",\\\"00C0FFEE\\\",7\\r\\n\\r\\nOK\\r\\n");
+
+    for (i = 0; i < G_N_ELEMENTS (plugin_profiles); i++) {
+        const PluginCommand *commands = plugin_profiles[i].commands;
+        guint                j;
+
+        for (j = 0; commands[j].command; j++)
+            test_port_context_set_command (port_ctx, commands[j].command, commands[j].response);
+    }
+}
+
+static void
+benchmark_context_setup (void)
+{
+    BenchmarkContext *ctx;
+    GError           *error = NULL;
+    GRegex           *regex;
+    guint             i;
+
+    ctx = g_slice_new0 (BenchmarkContext);
+
+    /* Fake endpoint; all commands must be set before the port context thread
+     * starts */
+    ctx->port_name = g_strdup_printf ("abstract:benchmark-at:%ld", (glong) getpid ());
+    ctx->port_ctx = test_port_context_new (ctx->port_name);
+    test_port_context_load_commands (ctx->port_ctx, COMMON_GSM_PORT_CONF);
+    setup_large_responses (ctx->port_ctx);
+    test_port_context_start (ctx->port_ctx);
+
+    /* AT port setup as done by the modem objects */
+    ctx->port = mm_port_serial_at_new (ctx->port_name, MM_PORT_SUBSYS_UNIX);
+    g_object_set (ctx->port,
+                  MM_PORT_SERIAL_AT_INIT_SEQUENCE_ENABLED, FALSE,
+                  NULL);
+    mm_port_serial_at_set_response_parser (ctx->port,
+                                           mm_serial_parser_v1_parse,
+                                           mm_serial_parser_v1_remove_echo,
+                                           mm_serial_parser_v1_new (),
+                                           mm_serial_parser_v1_destroy);
+
+    /* Unsolicited message handlers as setup by the generic 3GPP modem */
+    ctx->unsolicited_regexes = mm_3gpp_creg_regex_get (FALSE);
+    g_ptr_array_add (ctx->unsolicited_regexes, mm_3gpp_ciev_regex_get ());
+    g_ptr_array_add (ctx->unsolicited_regexes, mm_3gpp_cmti_regex_get ());
+    g_ptr_array_add (ctx->unsolicited_regexes, mm_3gpp_cusd_regex_get ());
+    g_ptr_array_add (ctx->unsolicited_regexes, mm_3gpp_cgev_regex_get ());
+    for (i = 0; i < ctx->unsolicited_regexes->len; i++) {
+        regex = g_ptr_array_index (ctx->unsolicited_regexes, i);
+        mm_port_serial_at_add_unsolicited_msg_handler (ctx->port,
+                                                       regex,
+                                                       (MMPortSerialAtUnsolicitedMsgFn) unsolicited_cb,
+                                                       ctx,
+                                                       NULL);
+    }
+
+    if (!mm_port_serial_open (MM_PORT_SERIAL (ctx->port), &error))
+        g_error ("Couldn't open AT port: %s", error->message);
+
+    benchmark_ctx = ctx;
+}
+
+static void
+benchmark_context_teardown (void)
+{
+    BenchmarkContext *ctx = benchmark_ctx;
+
+    mm_port_serial_close (MM_PORT_SERIAL (ctx->port));
+    g_object_unref (ctx->port);
+    mm_3gpp_creg_regex_destroy (ctx->unsolicited_regexes);
+
+    test_port_context_stop (ctx->port_ctx);
+    test_port_context_free (ctx->port_ctx);
+    g_free (ctx->port_name);
+    g_slice_free (BenchmarkContext, ctx);
+    benchmark_ctx = NULL;
+}
+
+int main (int argc, char **argv)
+{
+    gint  result;
+    guint i;
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/ModemManager/AT-serial/benchmark/generic-session",   benchmark_generic_session);
+    g_test_add_func ("/ModemManager/AT-serial/benchmark/cops-test",         benchmark_cops_test);
+    g_test_add_func ("/ModemManager/AT-serial/benchmark/cmgl",              benchmark_cmgl);
+    g_test_add_func ("/ModemManager/AT-serial/benchmark/unsolicited-storm", benchmark_unsolicited_storm);
+    g_test_add_func ("/ModemManager/AT-serial/benchmark/unsolicited-mixed", benchmark_unsolicited_storm_with_commands);
+
+    for (i = 0; i < G_N_ELEMENTS (plugin_profiles); i++) {
+        g_autofree gchar *path = NULL;
+
+        path = g_strdup_printf ("/ModemManager/AT-serial/benchmark/plugin/%s", plugin_profiles[i].name);
+        g_test_add_data_func (path, &plugin_profiles[i], benchmark_plugin);
+    }
+
+    benchmark_context_setup ();
+    result = g_test_run ();
+    benchmark_context_teardown ();
+
+    return result;
+}
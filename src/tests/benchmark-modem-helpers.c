@@ -0,0 +1,249 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+/*
+ * Micro-benchmark of the AT response parsers in the modem helpers.
+ *
+ * Each parser is run repeatedly over a synthetic response, and the following
+ * values are reported:
+ *   - parsed responses per second
+ *   - CPU time per parsed response
+ *   - memory allocations per parsed response
+ */
+
+#include <config.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <libmm-glib.h>
+#include "mm-modem-helpers.h"
+#include "mm-log-test.h"
+
+#include "benchmark-allocations.h"
+
+/*****************************************************************************/
+
+typedef void (* ParseFunc) (const gchar *response);
+
+static gint64
+cpu_time (void)
+{
+    struct rusage usage;
+
+    if (getrusage (RUSAGE_SELF, &usage) < 0)
+        return 0;
+    return ((gint64) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * G_USEC_PER_SEC +
+            (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec));
+}
+
+static guint
+get_n_iterations (guint base)
+{
+    return g_test_thorough () ? base * 10 : base;
+}
+
+static void
+run_scenario (const gchar *name,
+              ParseFunc    parse,
+              const gchar *response,
+              guint        n_iterations)
+{
+    gint64  wall_time;
+    gint64  cpu;
+    guint64 allocations = 0;
+    gdouble per_sec;
+    gdouble cpu_per_parse;
+    guint   i;
+
+    /* Warm up; e.g. so that regexes are already compiled */
+    parse (response);
+
+    wall_time = g_get_monotonic_time ();
+    cpu = cpu_time ();
+    mm_benchmark_allocations_start ();
+
+    for (i = 0; i < n_iterations; i++)
+        parse (response);
+
+    allocations = mm_benchmark_allocations_stop ();
+    cpu = cpu_time () - cpu;
+    wall_time = g_get_monotonic_time () - wall_time;
+
+    per_sec = (gdouble) n_iterations * G_USEC_PER_SEC / MAX (wall_time, 1);
+    cpu_per_parse = (gdouble) cpu / n_iterations;
+
+    g_test_maximized_result (per_sec, "%s: %.1f parses/s", name, per_sec);
+    g_test_minimized_result (cpu_per_parse, "%s: %.2f us CPU/parse", name, cpu_per_parse);
+#if defined WITH_ALLOCATION_COUNT
+    g_test_minimized_result ((gdouble) allocations / n_iterations,
+                             "%s: %.2f allocations/parse", name, (gdouble) allocations / n_iterations);
+#endif
+    g_print ("%-24s %8u parses %12.1f parses/s %10.2f us/parse %10.2f allocs/parse\n",
+             name, n_iterations, per_sec, cpu_per_parse, (gdouble) allocations / n_iterations);
+}
+
+/*****************************************************************************/
+
+#define N_PDP_CONTEXTS 24
+
+static void
+parse_cgdcont_read (const gchar *response)
+{
+    GError *error = NULL;
+    GList  *list;
+
+    list = mm_3gpp_parse_cgdcont_read_response (response, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (g_list_length (list), ==, N_PDP_CONTEXTS);
+    mm_3gpp_pdp_context_list_free (list);
+}
+
+static void
+benchmark_cgdcont_read (void)
+{
+    g_autoptr(GString) response = NULL;
+    guint              i;
+
+    response = g_string_new (NULL);
+    for (i = 1; i <= N_PDP_CONTEXTS; i++)
+        g_string_append_printf (response, "+CGDCONT: %u,\"%s\",\"apn%u.example.com\",\"0.0.0.0\",0,0,0,0\r\n",
+                                i, (i % 2) ? "IP" : "IPV4V6", i);
+
+    run_scenario ("cgdcont-read", parse_cgdcont_read, response->str, get_n_iterations (20000));
+}
+
+static void
+parse_cgact_read (const gchar *response)
+{
+    GError *error = NULL;
+    GList  *list;
+
+    list = mm_3gpp_parse_cgact_read_response (response, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (g_list_length (list), ==, N_PDP_CONTEXTS);
+    mm_3gpp_pdp_context_active_list_free (list);
+}
+
+static void
+benchmark_cgact_read (void)
+{
+    g_autoptr(GString) response = NULL;
+    guint              i;
+
+    response = g_string_new (NULL);
+    for (i = 1; i <= N_PDP_CONTEXTS; i++)
+        g_string_append_printf (response, "+CGACT: %u,%u\r\n", i, i % 2);
+
+    run_scenario ("cgact-read", parse_cgact_read, response->str, get_n_iterations (20000));
+}
+
+static void
+parse_cpms_test (const gchar *response)
+{
+    GError *error = NULL;
+    GArray *mem1 = NULL;
+    GArray *mem2 = NULL;
+    GArray *mem3 = NULL;
+
+    g_assert (mm_3gpp_parse_cpms_test_response (response, &mem1, &mem2, &mem3, &error));
+    g_assert_no_error (error);
+    g_array_unref (mem1);
+    g_array_unref (mem2);
+    g_array_unref (mem3);
+}
+
+static void
+benchmark_cpms_test (void)
+{
+    run_scenario ("cpms-test", parse_cpms_test,
+                  "+CPMS: (\"ME\",\"MT\",\"SM\",\"SR\"),(\"ME\",\"MT\",\"SM\"),(\"ME\",\"SM\")",
+                  get_n_iterations (50000));
+}
+
+static void
+parse_cind_test (const gchar *response)
+{
+    GError     *error = NULL;
+    GHashTable *hash;
+
+    hash = mm_3gpp_parse_cind_test_response (response, &error);
+    g_assert_no_error (error);
+    g_hash_table_unref (hash);
+}
+
+static void
+benchmark_cind_test (void)
+{
+    run_scenario ("cind-test", parse_cind_test,
+                  "+CIND: (\"battchg\",(0-5)),(\"signal\",(0-5)),(\"service\",(0,1)),(\"call\",(0,1)),"
+                  "(\"roam\",(0,1)),(\"smsfull\",(0,1)),(\"GPRS coverage\",(0,1)),(\"callsetup\",(0-3))",
+                  get_n_iterations (50000));
+}
+
+static void
+parse_uint_list (const gchar *response)
+{
+    GError *error = NULL;
+    GArray *array;
+
+    array = mm_parse_uint_list (response, &error);
+    g_assert_no_error (error);
+    g_array_unref (array);
+}
+
+static void
+benchmark_uint_list (void)
+{
+    run_scenario ("uint-list", parse_uint_list,
+                  "1,2,3,4,5,7,8,12,13,14,17,18,19,20,25,26,28,29,30,32,34,38,39,40,41,42,43,46,48,66,71",
+                  get_n_iterations (50000));
+}
+
+static void
+parse_string_groups (const gchar *response)
+{
+    g_auto(GStrv) split = NULL;
+
+    split = mm_split_string_groups (response);
+    g_assert (split);
+}
+
+static void
+benchmark_string_groups (void)
+{
+    run_scenario ("string-groups", parse_string_groups,
+                  "(0-2),(\"SM\",\"ME\",\"MT\"),1,(0,1,2,3,4),\"ME\"",
+                  get_n_iterations (50000));
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/modem-helpers/benchmark/cgdcont-read",  benchmark_cgdcont_read);
+    g_test_add_func ("/MM/modem-helpers/benchmark/cgact-read",    benchmark_cgact_read);
+    g_test_add_func ("/MM/modem-helpers/benchmark/cpms-test",     benchmark_cpms_test);
+    g_test_add_func ("/MM/modem-helpers/benchmark/cind-test",     benchmark_cind_test);
+    g_test_add_func ("/MM/modem-helpers/benchmark/uint-list",     benchmark_uint_list);
+    g_test_add_func ("/MM/modem-helpers/benchmark/string-groups", benchmark_string_groups);
+
+    return g_test_run ();
+}
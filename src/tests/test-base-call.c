@@ -355,6 +355,9 @@ test_fixture_setup (TestFixture *tf, gconstpointer unused)
 
     success = mm_log_setup (mm_context_get_log_level (),
                             mm_context_get_log_file (),
+                            mm_context_get_log_file_flush_interval (),
+                            mm_context_get_log_file_flush_size (),
+                            mm_context_get_log_file_sync_level (),
                             mm_context_get_log_journal (),
                             mm_context_get_log_timestamps (),
                             mm_context_get_log_relative_timestamps (),
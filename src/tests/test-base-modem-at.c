@@ -0,0 +1,191 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <string.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-base-modem-at.h"
+
+/*****************************************************************************/
+
+static const MMBaseModemAtCommand registration_sequence[] = {
+    { .command = "+CREG?",  .timeout = 3, .batchable = TRUE },
+    { .command = "+CGREG?", .timeout = 3, .batchable = TRUE },
+    { .command = "+CEREG?", .timeout = 3, .batchable = TRUE },
+    { NULL }
+};
+
+static void
+test_batch_response (void)
+{
+    g_auto(GStrv) responses = NULL;
+
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (registration_sequence, NULL), ==, 3);
+
+    /* Commands without response lines get an empty response */
+    responses = mm_base_modem_at_sequence_split_batch_response (registration_sequence, 3,
+                                                                "\r\n+CREG: 0,1\r\n"
+                                                                "\r\n+CEREG: 0,1\r\n"
+                                                                "+CEREG: 2,1\r\n");
+    g_assert_nonnull (responses);
+    g_assert_cmpuint (g_strv_length (responses), ==, 3);
+    g_assert_cmpstr (responses[0], ==, "+CREG: 0,1");
+    g_assert_cmpstr (responses[1], ==, "");
+    g_assert_cmpstr (responses[2], ==, "+CEREG: 0,1\r\n+CEREG: 2,1");
+}
+
+static void
+test_batch_response_error (void)
+{
+    g_auto(GStrv) responses = NULL;
+
+    /* An error in the middle of the line */
+    responses = mm_base_modem_at_sequence_split_batch_response (registration_sequence, 3,
+                                                                "+CREG: 0,1\r\n"
+                                                                "+CME ERROR: 30\r\n");
+    g_assert_null (responses);
+
+    /* Response lines in a different order than the commands */
+    responses = mm_base_modem_at_sequence_split_batch_response (registration_sequence, 3,
+                                                                "+CGREG: 0,1\r\n"
+                                                                "+CREG: 0,1\r\n");
+    g_assert_null (responses);
+}
+
+static void
+test_batch_max_commands (void)
+{
+    static const MMBaseModemAtCommand sequence[] = {
+        { .command = "+CMD0?", .batchable = TRUE },
+        { .command = "+CMD1?", .batchable = TRUE },
+        { .command = "+CMD2?", .batchable = TRUE },
+        { .command = "+CMD3?", .batchable = TRUE },
+        { .command = "+CMD4?", .batchable = TRUE },
+        { .command = "+CMD5?", .batchable = TRUE },
+        { .command = "+CMD6?", .batchable = TRUE },
+        { .command = "+CMD7?", .batchable = TRUE },
+        { .command = "+CMD8?", .batchable = TRUE },
+        { .command = "+CMD9?", .batchable = TRUE },
+        { NULL }
+    };
+
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (sequence, NULL), ==, 8);
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (&sequence[8], NULL), ==, 2);
+}
+
+static void
+test_batch_max_line_length (void)
+{
+    static const MMBaseModemAtCommand sequence[] = {
+        { .command = "+CMDA=\"0123456789012345678901234567890123456789\"", .batchable = TRUE },
+        { .command = "+CMDB=\"0123456789012345678901234567890123456789\"", .batchable = TRUE },
+        { .command = "+CMDC=\"0123456789012345678901234567890123456789\"", .batchable = TRUE },
+        { NULL }
+    };
+
+    /* Each command takes 48 characters, plus the separator */
+    g_assert_cmpuint (strlen (sequence[0].command), ==, 48);
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (sequence, NULL), ==, 2);
+}
+
+static void
+test_batch_not_batchable (void)
+{
+    static const MMBaseModemAtCommand not_flagged[] = {
+        { .command = "+CREG?",  .batchable = TRUE },
+        { .command = "+CGREG?" },
+        { .command = "+CEREG?", .batchable = TRUE },
+        { NULL }
+    };
+    static const MMBaseModemAtCommand cached[] = {
+        { .command = "+CREG?",  .batchable = TRUE },
+        { .command = "+CGREG?", .batchable = TRUE, .allow_cached = TRUE },
+        { NULL }
+    };
+    static const MMBaseModemAtCommand wait[] = {
+        { .command = "+CREG?",  .batchable = TRUE, .wait_seconds = 1 },
+        { .command = "+CGREG?", .batchable = TRUE, .wait_seconds = 1 },
+        { NULL }
+    };
+    static const MMBaseModemAtCommand same_name[] = {
+        { .command = "+CREG?",  .batchable = TRUE },
+        { .command = "+CREG=?", .batchable = TRUE },
+        { NULL }
+    };
+    static const MMBaseModemAtCommand basic_syntax[] = {
+        { .command = "E0",     .batchable = TRUE },
+        { .command = "+CREG?", .batchable = TRUE },
+        { NULL }
+    };
+
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (not_flagged, NULL), ==, 1);
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (cached, NULL), ==, 1);
+    /* Only the first command may wait */
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (wait, NULL), ==, 1);
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (same_name, NULL), ==, 1);
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (basic_syntax, NULL), ==, 0);
+}
+
+static void
+test_batch_fallback (void)
+{
+    static const MMBaseModemAtCommand sequence[] = {
+        { .command = "+CREG?",  .batchable = TRUE },
+        { .command = "+CGREG?", .batchable = TRUE },
+        { .command = "+CEREG?", .batchable = TRUE },
+        { .command = "+C5GREG?", .batchable = TRUE },
+        { .command = "+COPS?",  .batchable = TRUE },
+        { NULL }
+    };
+    const MMBaseModemAtCommand *no_batch_until;
+    const MMBaseModemAtCommand *current;
+    guint                       n;
+
+    /* First attempt with the first commands concatenated, limited to 3
+     * commands as if the line had been too long */
+    n = mm_base_modem_at_sequence_count_batchable (sequence, NULL);
+    g_assert_cmpuint (n, ==, 5);
+    n = 3;
+
+    /* After the compound command fails, the commands in it are sent one by
+     * one, and only the following ones may be concatenated again */
+    no_batch_until = sequence + n;
+    for (current = sequence; current < no_batch_until; current++)
+        g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (current, no_batch_until), ==, 0);
+    g_assert_cmpuint (mm_base_modem_at_sequence_count_batchable (current, no_batch_until), ==, 2);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/base-modem-at/batch/response",        test_batch_response);
+    g_test_add_func ("/MM/base-modem-at/batch/response-error",  test_batch_response_error);
+    g_test_add_func ("/MM/base-modem-at/batch/max-commands",    test_batch_max_commands);
+    g_test_add_func ("/MM/base-modem-at/batch/max-line-length", test_batch_max_line_length);
+    g_test_add_func ("/MM/base-modem-at/batch/not-batchable",   test_batch_not_batchable);
+    g_test_add_func ("/MM/base-modem-at/batch/fallback",        test_batch_fallback);
+
+    return g_test_run ();
+}
@@ -0,0 +1,174 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+#include <unistd.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-carrier-config-cache.h"
+
+#define TEST_REVISION "T99W175.F0.1.0.0.9.GC.004"
+
+static const guint8 test_id_1[] = { 0x01, 0x02, 0x03, 0x04 };
+static const guint8 test_id_2[] = { 0xAA, 0xBB, 0xCC };
+
+/*****************************************************************************/
+
+static GArray *
+build_id (const guint8 *data,
+          gsize         len)
+{
+    GArray *id;
+
+    id = g_array_sized_new (FALSE, FALSE, sizeof (guint8), len);
+    g_array_append_vals (id, data, len);
+    return id;
+}
+
+static gchar *
+save_test_cache (void)
+{
+    MMCarrierConfigCacheEntry  entries[2] = { { 0 } };
+    g_autoptr(GError)          error = NULL;
+    gchar                     *filename = NULL;
+    gint                       fd;
+
+    fd = g_file_open_tmp (NULL, &filename, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (filename);
+    close (fd);
+
+    entries[0].id = build_id (test_id_1, G_N_ELEMENTS (test_id_1));
+    entries[0].config_type = 1;
+    entries[0].version = 0x05010820;
+    entries[0].description = g_strdup ("VoLTE-ATT");
+    entries[0].total_size = 58040;
+
+    entries[1].id = build_id (test_id_2, G_N_ELEMENTS (test_id_2));
+    entries[1].config_type = 1;
+    entries[1].version = 0x05010124;
+    entries[1].description = g_strdup ("ROW_Generic_3GPP");
+    entries[1].total_size = 25532;
+
+    g_assert (mm_carrier_config_cache_save (filename, TEST_REVISION, entries, G_N_ELEMENTS (entries), &error));
+    g_assert_no_error (error);
+
+    mm_carrier_config_cache_entry_clear (&entries[0]);
+    mm_carrier_config_cache_entry_clear (&entries[1]);
+
+    return filename;
+}
+
+static void
+test_carrier_config_cache_save_load (void)
+{
+    g_autofree gchar                *filename = NULL;
+    g_autoptr(GArray)                entries = NULL;
+    g_autoptr(GArray)                id = NULL;
+    g_autoptr(GError)                error = NULL;
+    const MMCarrierConfigCacheEntry *entry;
+
+    filename = save_test_cache ();
+
+    entries = mm_carrier_config_cache_load (filename, TEST_REVISION, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (entries);
+    g_assert_cmpuint (entries->len, ==, 2);
+
+    id = build_id (test_id_2, G_N_ELEMENTS (test_id_2));
+    entry = mm_carrier_config_cache_lookup (entries, 1, id);
+    g_assert_nonnull (entry);
+    g_assert_cmpuint (entry->version, ==, 0x05010124);
+    g_assert_cmpuint (entry->total_size, ==, 25532);
+    g_assert_cmpstr (entry->description, ==, "ROW_Generic_3GPP");
+
+    /* Same id, different config type */
+    g_assert_null (mm_carrier_config_cache_lookup (entries, 0, id));
+
+    g_clear_pointer (&id, g_array_unref);
+    id = build_id (test_id_1, G_N_ELEMENTS (test_id_1));
+    entry = mm_carrier_config_cache_lookup (entries, 1, id);
+    g_assert_nonnull (entry);
+    g_assert_cmpuint (entry->version, ==, 0x05010820);
+    g_assert_cmpstr (entry->description, ==, "VoLTE-ATT");
+
+    /* Unknown id */
+    g_clear_pointer (&id, g_array_unref);
+    id = build_id (test_id_1, 2);
+    g_assert_null (mm_carrier_config_cache_lookup (entries, 1, id));
+
+    g_unlink (filename);
+}
+
+static void
+test_carrier_config_cache_revision_mismatch (void)
+{
+    g_autofree gchar  *filename = NULL;
+    g_autoptr(GArray)  entries = NULL;
+    g_autoptr(GError)  error = NULL;
+
+    filename = save_test_cache ();
+
+    entries = mm_carrier_config_cache_load (filename, "T99W175.F0.1.0.0.10.GC.004", &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND);
+    g_assert_null (entries);
+
+    g_unlink (filename);
+}
+
+static void
+test_carrier_config_cache_invalid (void)
+{
+    g_autofree gchar  *filename = NULL;
+    g_autoptr(GArray)  entries = NULL;
+    g_autoptr(GError)  error = NULL;
+    gint               fd;
+
+    fd = g_file_open_tmp (NULL, &filename, &error);
+    g_assert_no_error (error);
+    close (fd);
+
+    /* Entry without description */
+    g_assert (g_file_set_contents (filename,
+                                   "[carrier-config]\nversion=1\nrevision=" TEST_REVISION "\n"
+                                   "[config-0]\nid=0102\ntype=1\nversion=1\nsize=10\n",
+                                   -1, NULL));
+    entries = mm_carrier_config_cache_load (filename, TEST_REVISION, &error);
+    g_assert_nonnull (error);
+    g_assert_null (entries);
+
+    g_unlink (filename);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/carrier-config-cache/save_load",         test_carrier_config_cache_save_load);
+    g_test_add_func ("/MM/carrier-config-cache/revision_mismatch", test_carrier_config_cache_revision_mismatch);
+    g_test_add_func ("/MM/carrier-config-cache/invalid",           test_carrier_config_cache_invalid);
+
+    return g_test_run ();
+}
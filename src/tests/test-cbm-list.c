@@ -0,0 +1,167 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <string.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-cbm-list.h"
+#include "mm-cbm-part.h"
+
+/* Single page GSM7 CBM, PLMN wide scope */
+static const guint8 cbm_pdu[] = {
+    0x67, 0x60, 0x11, 0x12, 0x0F, 0x11,
+    0x54, 0x74, 0x7A, 0x0E, 0x4A, 0xCF, 0x41, 0x61,
+    0x10, 0xBD, 0x3C, 0xA7, 0x83, 0xDE, 0x66, 0x10,
+    0x1D, 0x5D, 0x06, 0x3D, 0xDD, 0xF4, 0xB0, 0x3C,
+    0xFD, 0x06, 0x05, 0xD9, 0x65, 0x39, 0x1D, 0x24,
+    0x2D, 0x87, 0xC9, 0x79, 0xD0, 0x34, 0x3F, 0xA7,
+    0x97, 0xDB, 0x2E, 0x10, 0x15, 0x5D, 0x96, 0x97,
+    0x41, 0xE9, 0x39, 0xC8, 0xFD, 0x06, 0x91, 0xC3,
+    0xEE, 0x73, 0x59, 0x0E, 0xA2, 0xBF, 0x41, 0xF9,
+    0x77, 0x5D, 0x0E, 0x42, 0x97, 0xC3, 0x6C, 0x3A,
+    0x1A, 0xF4, 0x96, 0x83, 0xE6, 0x61, 0x73, 0x99,
+    0x9E, 0x07
+};
+
+/* Takes a page of the message with the given update number, each update
+ * number being a different message */
+static gboolean
+take_page (MMCbmList  *list,
+           guint8      update,
+           GError    **error)
+{
+    guint8     pdu[sizeof (cbm_pdu)];
+    MMCbmPart *part;
+
+    memcpy (pdu, cbm_pdu, sizeof (pdu));
+    pdu[1] = (pdu[1] & 0xF0) | (update & 0x0F);
+
+    part = mm_cbm_part_new_from_binary_pdu (pdu, sizeof (pdu), NULL, error);
+    g_assert_nonnull (part);
+
+    if (!mm_cbm_list_take_part (list, NULL, part, MM_CBM_STATE_RECEIVED, error)) {
+        mm_cbm_part_free (part);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void
+take_page_expect_duplicate (MMCbmList *list,
+                            guint8     update)
+{
+    g_autoptr(GError) error = NULL;
+
+    g_assert (!take_page (list, update, &error));
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+}
+
+static void
+take_page_expect_new (MMCbmList *list,
+                      guint8     update)
+{
+    g_autoptr(GError) error = NULL;
+
+    g_assert (take_page (list, update, &error));
+    g_assert_no_error (error);
+}
+
+/*****************************************************************************/
+
+static void
+test_duplicate_dropped (void)
+{
+    g_autoptr(MMCbmList) list = NULL;
+
+    list = mm_cbm_list_new (NULL, NULL);
+
+    take_page_expect_new (list, 1);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 1);
+
+    /* Rebroadcast of the same page */
+    take_page_expect_duplicate (list, 1);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 1);
+
+    /* A new update number is a new message */
+    take_page_expect_new (list, 2);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 2);
+}
+
+static void
+test_evicted_duplicate_dropped (void)
+{
+    g_autoptr(MMCbmList) list = NULL;
+
+    list = mm_cbm_list_new (NULL, NULL);
+    mm_cbm_list_set_limits (list, 2, 0);
+
+    take_page_expect_new (list, 1);
+    take_page_expect_new (list, 2);
+    take_page_expect_new (list, 3);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 2);
+
+    /* The oldest one was evicted, but its rebroadcasts are still dropped */
+    take_page_expect_duplicate (list, 1);
+    take_page_expect_duplicate (list, 3);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 2);
+}
+
+static void
+test_expired_duplicate_dropped (void)
+{
+    g_autoptr(MMCbmList) list = NULL;
+    gint64               deadline;
+
+    list = mm_cbm_list_new (NULL, NULL);
+    mm_cbm_list_set_limits (list, 0, 1);
+
+    take_page_expect_new (list, 1);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 1);
+
+    /* Wait for the message to expire */
+    deadline = g_get_monotonic_time () + 5 * G_USEC_PER_SEC;
+    while (mm_cbm_list_get_count (list) > 0 && g_get_monotonic_time () < deadline)
+        g_main_context_iteration (NULL, TRUE);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 0);
+
+    /* Rebroadcasts are dropped for another retention period */
+    take_page_expect_duplicate (list, 1);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 0);
+
+    /* And then accepted again */
+    g_usleep (G_USEC_PER_SEC + G_USEC_PER_SEC / 10);
+    take_page_expect_new (list, 1);
+    g_assert_cmpuint (mm_cbm_list_get_count (list), ==, 1);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/cbm-list/duplicate-dropped",         test_duplicate_dropped);
+    g_test_add_func ("/MM/cbm-list/evicted-duplicate-dropped", test_evicted_duplicate_dropped);
+    g_test_add_func ("/MM/cbm-list/expired-duplicate-dropped", test_expired_duplicate_dropped);
+
+    return g_test_run ();
+}
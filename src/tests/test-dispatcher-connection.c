@@ -0,0 +1,186 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <glib.h>
+#include <locale.h>
+
+#include "mm-dispatcher-connection.h"
+
+/* Items are opaque to the queue, plain integers are enough */
+#define ITEM(n) GUINT_TO_POINTER (n)
+
+static void
+assert_pop (MMDispatcherConnectionQueue *queue,
+            const guint                 *expected_items,
+            guint                        n_expected_items,
+            guint                        expected_next)
+{
+    GList    *items;
+    GList    *l;
+    gpointer  next = NULL;
+    guint     i;
+
+    items = mm_dispatcher_connection_queue_pop (queue, &next);
+    g_assert_cmpuint (g_list_length (items), ==, n_expected_items);
+    for (l = items, i = 0; l; l = g_list_next (l), i++)
+        g_assert_cmpuint (GPOINTER_TO_UINT (l->data), ==, expected_items[i]);
+    g_assert_cmpuint (GPOINTER_TO_UINT (next), ==, expected_next);
+    g_list_free (items);
+}
+
+/*****************************************************************************/
+
+static void
+test_queue_merge_identical (void)
+{
+    MMDispatcherConnectionQueue *queue;
+    static const guint           first[]  = { 1 };
+    static const guint           second[] = { 2, 3 };
+    static const guint           third[]  = { 4 };
+    static const guint           fourth[] = { 5 };
+
+    queue = mm_dispatcher_connection_queue_new ();
+
+    /* Idle queue, reported right away */
+    g_assert (mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (1)));
+    /* Queued while the first one is reported */
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED, "wwan0", ITEM (2)));
+    /* Identical to the last queued one, merged */
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED, "wwan0", ITEM (3)));
+    /* Different data port, not merged */
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED, "wwan1", ITEM (4)));
+    /* Different event, not merged */
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECT_REQUEST, "wwan1", ITEM (5)));
+
+    assert_pop (queue, first, G_N_ELEMENTS (first), 2);
+    assert_pop (queue, second, G_N_ELEMENTS (second), 4);
+    assert_pop (queue, third, G_N_ELEMENTS (third), 5);
+    g_assert (!mm_dispatcher_connection_queue_is_empty (queue));
+    assert_pop (queue, fourth, G_N_ELEMENTS (fourth), 0);
+    g_assert (mm_dispatcher_connection_queue_is_empty (queue));
+
+    mm_dispatcher_connection_queue_free (queue);
+}
+
+static void
+test_queue_no_merge_running (void)
+{
+    MMDispatcherConnectionQueue *queue;
+    static const guint           first[]  = { 1 };
+    static const guint           second[] = { 2, 3 };
+    static const guint           third[]  = { 4 };
+
+    queue = mm_dispatcher_connection_queue_new ();
+
+    /* The event being reported is never merged */
+    g_assert (mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (1)));
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (2)));
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (3)));
+
+    assert_pop (queue, first, G_N_ELEMENTS (first), 2);
+    assert_pop (queue, second, G_N_ELEMENTS (second), 0);
+    g_assert (mm_dispatcher_connection_queue_is_empty (queue));
+
+    /* Once idle, a new event is reported right away again */
+    g_assert (mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED, NULL, ITEM (4)));
+    assert_pop (queue, third, G_N_ELEMENTS (third), 0);
+
+    mm_dispatcher_connection_queue_free (queue);
+}
+
+static void
+test_queue_collapse_opposite (void)
+{
+    MMDispatcherConnectionQueue *queue;
+    static const guint           first[]  = { 1 };
+    static const guint           second[] = { 2, 3, 4 };
+
+    queue = mm_dispatcher_connection_queue_new ();
+
+    g_assert (mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED, NULL, ITEM (1)));
+    /* Connected, disconnected and connected again while waiting: only the
+     * net state is reported */
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (2)));
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED, "wwan0", ITEM (3)));
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (4)));
+
+    assert_pop (queue, first, G_N_ELEMENTS (first), 2);
+    assert_pop (queue, second, G_N_ELEMENTS (second), 0);
+    g_assert (mm_dispatcher_connection_queue_is_empty (queue));
+
+    mm_dispatcher_connection_queue_free (queue);
+}
+
+static void
+test_queue_collapse_into_running (void)
+{
+    MMDispatcherConnectionQueue *queue;
+    static const guint           first[] = { 1, 2, 3 };
+
+    queue = mm_dispatcher_connection_queue_new ();
+
+    /* Disconnected and connected again while reporting the connection: no
+     * change in the net state, nothing else to report */
+    g_assert (mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (1)));
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED, "wwan0", ITEM (2)));
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (3)));
+    g_assert (!mm_dispatcher_connection_queue_supersede (queue));
+
+    assert_pop (queue, first, G_N_ELEMENTS (first), 0);
+    g_assert (mm_dispatcher_connection_queue_is_empty (queue));
+
+    mm_dispatcher_connection_queue_free (queue);
+}
+
+static void
+test_queue_superseded (void)
+{
+    MMDispatcherConnectionQueue *queue;
+    static const guint           first[]  = { 1 };
+    static const guint           second[] = { 2, 3 };
+
+    queue = mm_dispatcher_connection_queue_new ();
+
+    g_assert (mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (1)));
+    g_assert (!mm_dispatcher_connection_queue_supersede (queue));
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_DISCONNECTED, "wwan0", ITEM (2)));
+    g_assert (mm_dispatcher_connection_queue_supersede (queue));
+    /* Some scripts were skipped for the event being reported, so the state
+     * it reports is no longer the one to keep */
+    g_assert (!mm_dispatcher_connection_queue_push (queue, MM_DISPATCHER_CONNECTION_EVENT_CONNECTED, "wwan0", ITEM (3)));
+
+    assert_pop (queue, first, G_N_ELEMENTS (first), 2);
+    assert_pop (queue, second, G_N_ELEMENTS (second), 0);
+    g_assert (mm_dispatcher_connection_queue_is_empty (queue));
+
+    mm_dispatcher_connection_queue_free (queue);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/dispatcher-connection/queue/merge-identical",       test_queue_merge_identical);
+    g_test_add_func ("/MM/dispatcher-connection/queue/no-merge-running",      test_queue_no_merge_running);
+    g_test_add_func ("/MM/dispatcher-connection/queue/collapse-opposite",     test_queue_collapse_opposite);
+    g_test_add_func ("/MM/dispatcher-connection/queue/collapse-into-running", test_queue_collapse_into_running);
+    g_test_add_func ("/MM/dispatcher-connection/queue/superseded",            test_queue_superseded);
+
+    return g_test_run ();
+}
@@ -0,0 +1,149 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-keyfile-cache.h"
+
+#define TEST_GROUP   "test"
+#define TEST_VERSION 2
+
+/*****************************************************************************/
+
+static gchar *
+build_tmp_filename (void)
+{
+    g_autoptr(GError)  error = NULL;
+    gchar             *filename = NULL;
+    gint               fd;
+
+    fd = g_file_open_tmp (NULL, &filename, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (filename);
+    close (fd);
+
+    return filename;
+}
+
+static void
+test_keyfile_cache_save_load (void)
+{
+    g_autofree gchar    *filename = NULL;
+    g_autofree gchar    *str = NULL;
+    g_autoptr(GKeyFile)  key_file = NULL;
+    g_autoptr(GError)    error = NULL;
+
+    filename = build_tmp_filename ();
+
+    key_file = g_key_file_new ();
+    g_key_file_set_string (key_file, "values", "key", "value");
+    g_assert (mm_keyfile_cache_save (filename, TEST_GROUP, TEST_VERSION, key_file, &error));
+    g_assert_no_error (error);
+    g_clear_pointer (&key_file, g_key_file_unref);
+
+    key_file = mm_keyfile_cache_load (filename, TEST_GROUP, TEST_VERSION, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (key_file);
+    g_assert_cmpint (g_key_file_get_integer (key_file, TEST_GROUP, "version", NULL), ==, TEST_VERSION);
+    str = g_key_file_get_string (key_file, "values", "key", NULL);
+    g_assert_cmpstr (str, ==, "value");
+
+    g_unlink (filename);
+}
+
+static void
+test_keyfile_cache_invalid (void)
+{
+    g_autofree gchar    *filename = NULL;
+    g_autoptr(GKeyFile)  key_file = NULL;
+    g_autoptr(GError)    error = NULL;
+
+    filename = build_tmp_filename ();
+
+    /* Unknown version */
+    g_assert (g_file_set_contents (filename, "[test]\nversion=99\n", -1, NULL));
+    key_file = mm_keyfile_cache_load (filename, TEST_GROUP, TEST_VERSION, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED);
+    g_assert_null (key_file);
+    g_clear_error (&error);
+
+    /* Missing version, e.g. a different header group */
+    g_assert (g_file_set_contents (filename, "[other]\nversion=2\n", -1, NULL));
+    key_file = mm_keyfile_cache_load (filename, TEST_GROUP, TEST_VERSION, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED);
+    g_assert_null (key_file);
+    g_clear_error (&error);
+
+    /* Not a keyfile */
+    g_assert (g_file_set_contents (filename, "garbage", -1, NULL));
+    key_file = mm_keyfile_cache_load (filename, TEST_GROUP, TEST_VERSION, &error);
+    g_assert_nonnull (error);
+    g_assert_null (key_file);
+    g_clear_error (&error);
+
+    /* Missing file */
+    g_unlink (filename);
+    key_file = mm_keyfile_cache_load (filename, TEST_GROUP, TEST_VERSION, &error);
+    g_assert_nonnull (error);
+    g_assert_null (key_file);
+}
+
+static void
+test_keyfile_cache_filename (void)
+{
+    g_autofree gchar *filename1 = NULL;
+    g_autofree gchar *filename2 = NULL;
+    g_autofree gchar *filename3 = NULL;
+    g_autofree gchar *basename = NULL;
+
+    filename1 = mm_keyfile_cache_build_filename ("test-", "89014103211118510720");
+    filename2 = mm_keyfile_cache_build_filename ("test-", "89014103211118510721");
+    filename3 = mm_keyfile_cache_build_filename ("test-", "89014103211118510720");
+    g_assert_cmpstr (filename1, !=, filename2);
+    g_assert_cmpstr (filename1, ==, filename3);
+
+    /* The key isn't exposed in the file name */
+    g_assert_null (strstr (filename1, "89014103211118510720"));
+
+    /* Prefix, 16 digest characters and the extension */
+    basename = g_path_get_basename (filename1);
+    g_assert (g_str_has_prefix (basename, "test-"));
+    g_assert (g_str_has_suffix (basename, ".ini"));
+    g_assert_cmpuint (strlen (basename), ==, strlen ("test-") + 16 + strlen (".ini"));
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/keyfile-cache/save_load", test_keyfile_cache_save_load);
+    g_test_add_func ("/MM/keyfile-cache/invalid",   test_keyfile_cache_invalid);
+    g_test_add_func ("/MM/keyfile-cache/filename",  test_keyfile_cache_filename);
+
+    return g_test_run ();
+}
@@ -15,6 +15,7 @@
  */
 
 #include <config.h>
+#include <string.h>
 
 #include <glib.h>
 #include <glib/gstdio.h>
@@ -437,6 +438,162 @@ test_location_cache_create_dispose (void)
 
 /*****************************************************************************/
 
+static void
+test_location_cache_history (void)
+{
+    g_autoptr(MMLocationCache)  cache = NULL;
+    g_autoptr(GArray)           history = NULL;
+    g_autoptr(GError)           error = NULL;
+    g_autofree gchar           *filename = NULL;
+    g_autofree gchar           *ini_filename = NULL;
+    gboolean                    ret;
+    guint                       n_fixes;
+    guint                       i;
+
+    cache = mm_location_cache_new ();
+    g_assert_nonnull (cache);
+
+    filename = get_temp_filename ();
+    ini_filename = get_temp_filename ();
+    mm_location_cache_set_filename (cache, ini_filename);
+    mm_location_cache_set_history_filename (cache, filename);
+
+    // missing file
+    ret = mm_location_cache_load_history (cache, &error);
+    g_assert_false (ret);
+    g_assert (error != NULL);
+    g_clear_error (&error);
+
+    // overflow the ring buffer
+    n_fixes = MM_LOCATION_CACHE_HISTORY_SIZE + 10;
+    for (i = 1; i <= n_fixes; i++) {
+        MMLocationCacheFix fix = {
+            .timestamp = i * 1000,
+            .latitude  = 48.0 + i * 0.001,
+            .longitude = 11.0 + i * 0.001,
+            .altitude  = MM_LOCATION_ALTITUDE_UNKNOWN,
+            .source    = MM_MODEM_LOCATION_SOURCE_GPS_RAW,
+        };
+
+        mm_location_cache_add_fix (cache, &fix);
+    }
+
+    history = mm_location_cache_get_history (cache, 0);
+    g_assert_cmpuint (history->len, ==, MM_LOCATION_CACHE_HISTORY_SIZE);
+    g_assert_cmpint (g_array_index (history, MMLocationCacheFix, 0).timestamp, ==, 11 * 1000);
+    g_assert_cmpint (g_array_index (history, MMLocationCacheFix, history->len - 1).timestamp, ==, n_fixes * 1000);
+    g_clear_pointer (&history, g_array_unref);
+
+    history = mm_location_cache_get_history (cache, (n_fixes - 5) * 1000);
+    g_assert_cmpuint (history->len, ==, 5);
+    g_clear_pointer (&history, g_array_unref);
+
+    // reload from file in a new cache
+    g_clear_object (&cache);
+    cache = mm_location_cache_new ();
+    mm_location_cache_set_filename (cache, ini_filename);
+    mm_location_cache_set_history_filename (cache, filename);
+    ret = mm_location_cache_load_history (cache, &error);
+    g_assert_true (ret);
+    g_assert_no_error (error);
+
+    history = mm_location_cache_get_history (cache, 0);
+    g_assert_cmpuint (history->len, ==, MM_LOCATION_CACHE_HISTORY_SIZE);
+    for (i = 0; i < history->len; i++) {
+        MMLocationCacheFix *fix;
+
+        fix = &g_array_index (history, MMLocationCacheFix, i);
+        g_assert_cmpint (fix->timestamp, ==, (i + 11) * 1000);
+        g_assert_cmpfloat_with_epsilon (fix->latitude, 48.0 + (i + 11) * 0.001, 0.0001);
+        g_assert_cmpfloat_with_epsilon (fix->longitude, 11.0 + (i + 11) * 0.001, 0.0001);
+        g_assert_cmpuint (fix->source, ==, MM_MODEM_LOCATION_SOURCE_GPS_RAW);
+    }
+
+    g_clear_object (&cache);
+    g_unlink (filename);
+    g_unlink (ini_filename);
+}
+
+static void
+add_history_fixes (MMLocationCache *cache,
+                   guint            first,
+                   guint            last)
+{
+    guint i;
+
+    for (i = first; i <= last; i++) {
+        MMLocationCacheFix fix = {
+            .timestamp = i * 1000,
+            .latitude  = 48.0 + i * 0.001,
+            .longitude = 11.0 + i * 0.001,
+            .altitude  = MM_LOCATION_ALTITUDE_UNKNOWN,
+            .source    = MM_MODEM_LOCATION_SOURCE_GPS_RAW,
+        };
+
+        mm_location_cache_add_fix (cache, &fix);
+    }
+}
+
+static void
+test_location_cache_history_corrupted (void)
+{
+    g_autoptr(MMLocationCache)  cache = NULL;
+    g_autoptr(GArray)           history = NULL;
+    g_autoptr(GError)           error = NULL;
+    g_autofree gchar           *filename = NULL;
+    g_autofree gchar           *contents = NULL;
+    gsize                       length = 0;
+    guint32                     seq = 1;
+    gboolean                    ret;
+
+    cache = mm_location_cache_new ();
+    /* history only, location.ini is never written */
+    mm_location_cache_set_filename (cache, NULL);
+    g_assert_true (mm_location_cache_save (cache, &error));
+    g_assert_no_error (error);
+
+    filename = get_temp_filename ();
+    mm_location_cache_set_history_filename (cache, filename);
+    add_history_fixes (cache, 1, 3);
+    g_clear_object (&cache);
+
+    // record in slot 1 claims to be the first one: 16-byte header, 40-byte
+    // records, sequence number at the end of each record
+    g_assert_true (g_file_get_contents (filename, &contents, &length, NULL));
+    memcpy (contents + 16 + 40 + 36, &seq, sizeof (seq));
+    g_assert_true (g_file_set_contents (filename, contents, length, NULL));
+
+    cache = mm_location_cache_new ();
+    mm_location_cache_set_filename (cache, NULL);
+    mm_location_cache_set_history_filename (cache, filename);
+    ret = mm_location_cache_load_history (cache, &error);
+    g_assert_false (ret);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+    g_clear_error (&error);
+    history = mm_location_cache_get_history (cache, 0);
+    g_assert_cmpuint (history->len, ==, 0);
+    g_clear_pointer (&history, g_array_unref);
+
+    // a new fix initializes the file again, header included
+    add_history_fixes (cache, 10, 10);
+    g_clear_object (&cache);
+
+    cache = mm_location_cache_new ();
+    mm_location_cache_set_filename (cache, NULL);
+    mm_location_cache_set_history_filename (cache, filename);
+    ret = mm_location_cache_load_history (cache, &error);
+    g_assert_no_error (error);
+    g_assert_true (ret);
+    history = mm_location_cache_get_history (cache, 0);
+    g_assert_cmpuint (history->len, ==, 1);
+    g_assert_cmpint (g_array_index (history, MMLocationCacheFix, 0).timestamp, ==, 10 * 1000);
+
+    g_clear_object (&cache);
+    g_unlink (filename);
+}
+
+/*****************************************************************************/
+
 int main (int argc, char **argv)
 {
     setlocale (LC_ALL, "");
@@ -448,6 +605,8 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/location-cache/save",           test_location_cache_save);
     g_test_add_func ("/MM/location-cache/save_load",      test_location_cache_save_load);
     g_test_add_func ("/MM/location-cache/create_dispose", test_location_cache_create_dispose);
+    g_test_add_func ("/MM/location-cache/history",        test_location_cache_history);
+    g_test_add_func ("/MM/location-cache/history_corrupted", test_location_cache_history_corrupted);
 
     return g_test_run ();
 }
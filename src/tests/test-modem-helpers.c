@@ -23,6 +23,8 @@
 #define _LIBMM_INSIDE_MM
 #include <libmm-glib.h>
 #include "mm-modem-helpers.h"
+#include "mm-regex-registry.h"
+#include "mm-at-lexer.h"
 #include "mm-log-test.h"
 
 #define g_assert_cmpfloat_tolerance(val1, val2, tolerance)  \
@@ -958,6 +960,105 @@ test_cops_response_umts_invalid (void *f, gpointer d)
     g_assert_no_error (error);
 }
 
+/*****************************************************************************/
+/* Test incremental network scan helpers */
+
+static void
+test_incremental_scan_passes (MMModemMode        supported,
+                              MMModemMode        allowed,
+                              const MMModemMode *expected,
+                              guint              n_expected)
+{
+    GArray *passes;
+    guint   i;
+
+    passes = mm_3gpp_build_incremental_scan_passes (supported, allowed);
+    g_assert_cmpuint (passes->len, ==, n_expected);
+    for (i = 0; i < n_expected; i++)
+        g_assert_cmpuint (g_array_index (passes, MMModemMode, i), ==, expected[i]);
+    g_array_unref (passes);
+}
+
+static void
+test_incremental_scan_passes_all (void)
+{
+    const MMModemMode expected[] = { MM_MODEM_MODE_5G, MM_MODEM_MODE_4G, MM_MODEM_MODE_3G, MM_MODEM_MODE_2G };
+
+    test_incremental_scan_passes (MM_MODEM_MODE_2G | MM_MODEM_MODE_3G | MM_MODEM_MODE_4G | MM_MODEM_MODE_5G,
+                                  MM_MODEM_MODE_ANY,
+                                  expected, G_N_ELEMENTS (expected));
+}
+
+static void
+test_incremental_scan_passes_allowed (void)
+{
+    const MMModemMode expected[] = { MM_MODEM_MODE_4G, MM_MODEM_MODE_3G };
+
+    test_incremental_scan_passes (MM_MODEM_MODE_2G | MM_MODEM_MODE_3G | MM_MODEM_MODE_4G,
+                                  MM_MODEM_MODE_3G | MM_MODEM_MODE_4G,
+                                  expected, G_N_ELEMENTS (expected));
+}
+
+static void
+test_incremental_scan_passes_single (void)
+{
+    const MMModemMode expected_any[] = { MM_MODEM_MODE_ANY };
+    const MMModemMode expected_2g[] = { MM_MODEM_MODE_2G };
+
+    /* No restricted scan support */
+    test_incremental_scan_passes (MM_MODEM_MODE_NONE, MM_MODEM_MODE_ANY,
+                                  expected_any, G_N_ELEMENTS (expected_any));
+    /* No supported technology allowed */
+    test_incremental_scan_passes (MM_MODEM_MODE_4G, MM_MODEM_MODE_2G,
+                                  expected_2g, G_N_ELEMENTS (expected_2g));
+}
+
+static GList *
+network_info_list_append (GList                   *info_list,
+                          const gchar             *operator_code,
+                          MMModemAccessTechnology  access_tech)
+{
+    MM3gppNetworkInfo *info;
+
+    info = g_new0 (MM3gppNetworkInfo, 1);
+    info->operator_code = g_strdup (operator_code);
+    info->access_tech = access_tech;
+    return g_list_append (info_list, info);
+}
+
+static void
+test_network_info_list_filter_new (void)
+{
+    GList             *known_list = NULL;
+    GList             *info_list = NULL;
+    GList             *new_list;
+    MM3gppNetworkInfo *info;
+
+    known_list = network_info_list_append (known_list, "26201", MM_MODEM_ACCESS_TECHNOLOGY_LTE);
+
+    /* already known */
+    info_list = network_info_list_append (info_list, "26201", MM_MODEM_ACCESS_TECHNOLOGY_LTE);
+    /* same operator, different access technology */
+    info_list = network_info_list_append (info_list, "26201", MM_MODEM_ACCESS_TECHNOLOGY_5GNR);
+    /* no operator code */
+    info_list = network_info_list_append (info_list, NULL, MM_MODEM_ACCESS_TECHNOLOGY_LTE);
+    /* new, and then repeated in the same list */
+    info_list = network_info_list_append (info_list, "26202", MM_MODEM_ACCESS_TECHNOLOGY_LTE);
+    info_list = network_info_list_append (info_list, "26202", MM_MODEM_ACCESS_TECHNOLOGY_LTE);
+
+    new_list = mm_3gpp_network_info_list_filter_new (known_list, info_list);
+    g_assert_cmpuint (g_list_length (new_list), ==, 2);
+    info = new_list->data;
+    g_assert_cmpstr (info->operator_code, ==, "26201");
+    g_assert_cmpuint (info->access_tech, ==, MM_MODEM_ACCESS_TECHNOLOGY_5GNR);
+    info = new_list->next->data;
+    g_assert_cmpstr (info->operator_code, ==, "26202");
+    g_assert_cmpuint (info->access_tech, ==, MM_MODEM_ACCESS_TECHNOLOGY_LTE);
+
+    mm_3gpp_network_info_list_free (new_list);
+    mm_3gpp_network_info_list_free (known_list);
+}
+
 /*****************************************************************************/
 /* Test COPS? responses */
 
@@ -2866,6 +2967,35 @@ test_cgdcont_read_response_simcom (void *f, gpointer d)
     test_cgdcont_read_results ("Simcom", reply, &expected[0], G_N_ELEMENTS (expected));
 }
 
+static void
+test_cgdcont_read_response_ignore (void *f, gpointer d)
+{
+    const gchar *reply =
+        "+CGDCONT: 1,\"IP\",\"nate.sktelecom.com\"\r\n"
+        "+CGDCONT: x,\"IP\",\"epc.tmobile.com\"\r\n"
+        "+CGDCONT: 3,\"FOO\",\"MAXROAM.com\"\r\n";
+    static MM3gppPdpContext expected[] = {
+        { 1, MM_BEARER_IP_FAMILY_IPV4, (gchar *) "nate.sktelecom.com" }
+    };
+
+    test_cgdcont_read_results ("Ignore", reply, &expected[0], G_N_ELEMENTS (expected));
+}
+
+static void
+test_cgdcont_read_response_invalid_cid (void *f, gpointer d)
+{
+    const gchar *reply =
+        "+CGDCONT: 1,\"IP\",\"nate.sktelecom.com\"\r\n"
+        "+CGDCONT: 99999999999,\"IP\",\"epc.tmobile.com\"\r\n";
+    GError *error = NULL;
+    GList *results;
+
+    results = mm_3gpp_parse_cgdcont_read_response (reply, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+    g_assert_null (results);
+    g_error_free (error);
+}
+
 /*****************************************************************************/
 /* Test CGDCONT read responses */
 
@@ -2953,6 +3083,41 @@ test_cgact_read_response_multiple (void)
     test_cgact_read_results ("multiple", reply, &expected[0], G_N_ELEMENTS (expected));
 }
 
+static void
+test_cgact_read_response_ignore (void)
+{
+    const gchar *reply =
+        "+CGACT: 1,0\r\n"
+        "+CGACT: x,1\r\n"
+        "+CGACT: 5,y\r\n";
+    static MM3gppPdpContextActive expected[] = {
+        { 1, FALSE },
+    };
+
+    test_cgact_read_results ("ignore", reply, &expected[0], G_N_ELEMENTS (expected));
+}
+
+static void
+test_cgact_read_response_invalid (void)
+{
+    static const gchar *replies[] = {
+        "+CGACT: 1,0\r\n+CGACT: 4,2\r\n",
+        "+CGACT: 1,0\r\n+CGACT: 99999999999,1\r\n",
+        "+CGACT: 1,0\r\n+CGACT: 4,99999999999\r\n",
+    };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (replies); i++) {
+        GError *error = NULL;
+        GList *results;
+
+        results = mm_3gpp_parse_cgact_read_response (replies[i], &error);
+        g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+        g_assert_null (results);
+        g_error_free (error);
+    }
+}
+
 /*****************************************************************************/
 /* CID selection logic */
 
@@ -3625,6 +3790,21 @@ test_cdma_parse_gsn (void *f, gpointer d)
     }
 }
 
+static void
+test_equipment_identifier_equal (void *f, gpointer d)
+{
+    g_assert (mm_equipment_identifier_equal ("354237065082227", "354237065082227"));
+    g_assert (mm_equipment_identifier_equal ("354237065082227", " 354237065082227\r\n"));
+    g_assert (mm_equipment_identifier_equal ("A1000013FB653A", "a1000013fb653a"));
+    g_assert (mm_equipment_identifier_equal (NULL, NULL));
+
+    g_assert (!mm_equipment_identifier_equal ("354237065082227", "356936001568843"));
+    g_assert (!mm_equipment_identifier_equal ("354237065082227", "35423706508222"));
+    g_assert (!mm_equipment_identifier_equal ("354237065082227", NULL));
+    g_assert (!mm_equipment_identifier_equal (NULL, "354237065082227"));
+    g_assert (!mm_equipment_identifier_equal ("354237065082227", ""));
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -4257,6 +4437,94 @@ test_cesq_response_to_signal (void)
     }
 }
 
+/*****************************************************************************/
+/* Test signal thresholds */
+
+static MMSignal *
+build_lte_signal (gdouble rsrp,
+                  gdouble snr,
+                  gdouble error_rate)
+{
+    MMSignal *signal;
+
+    signal = mm_signal_new ();
+    mm_signal_set_rsrp (signal, rsrp);
+    mm_signal_set_snr (signal, snr);
+    mm_signal_set_error_rate (signal, error_rate);
+    return signal;
+}
+
+typedef struct {
+    gdouble  rsrp;
+    gdouble  snr;
+    gdouble  error_rate;
+    guint    rssi_threshold;
+    guint    sinr_threshold;
+    gboolean error_rate_threshold;
+    gboolean crossed;
+} SignalThresholdTest;
+
+/* Compared against a sample with RSRP -100 dBm, SNR 10 dB, error rate 1% */
+static const SignalThresholdTest signal_threshold_tests[] = {
+    /* same values */
+    { -100.0, 10.0, 1.0, 5, 3, TRUE,  FALSE },
+    /* RSRP changes below, at and above the threshold */
+    { -104.0, 10.0, 1.0, 5, 3, FALSE, FALSE },
+    { -105.0, 10.0, 1.0, 5, 3, FALSE, TRUE  },
+    {  -94.0, 10.0, 1.0, 5, 3, FALSE, TRUE  },
+    /* RSRP changes ignored without RSSI threshold */
+    {  -80.0, 10.0, 1.0, 0, 3, FALSE, FALSE },
+    /* SNR changes use their own threshold, not the RSSI one */
+    { -100.0, 12.0, 1.0, 5, 3, FALSE, FALSE },
+    { -100.0, 13.0, 1.0, 5, 3, FALSE, TRUE  },
+    { -100.0,  6.0, 1.0, 1, 5, FALSE, FALSE },
+    /* SNR changes ignored without SINR threshold, or without RSSI threshold */
+    { -100.0, 20.0, 1.0, 5, 0, FALSE, FALSE },
+    { -100.0, 20.0, 1.0, 0, 3, FALSE, FALSE },
+    /* value appearing or disappearing */
+    { MM_SIGNAL_UNKNOWN, 10.0, 1.0, 5, 3, FALSE, TRUE  },
+    { -100.0, MM_SIGNAL_UNKNOWN, 1.0, 5, 3, FALSE, TRUE  },
+    /* any error rate change, only if enabled */
+    { -100.0, 10.0, 1.5, 5, 3, TRUE,  TRUE  },
+    { -100.0, 10.0, 1.5, 5, 3, FALSE, FALSE },
+};
+
+static void
+test_signal_threshold_crossed (void)
+{
+    g_autoptr(MMSignal) previous = NULL;
+    guint               i;
+
+    previous = build_lte_signal (-100.0, 10.0, 1.0);
+
+    for (i = 0; i < G_N_ELEMENTS (signal_threshold_tests); i++) {
+        g_autoptr(MMSignal) current = NULL;
+
+        current = build_lte_signal (signal_threshold_tests[i].rsrp,
+                                    signal_threshold_tests[i].snr,
+                                    signal_threshold_tests[i].error_rate);
+        g_assert_cmpuint (mm_signal_threshold_crossed (previous,
+                                                       current,
+                                                       signal_threshold_tests[i].rssi_threshold,
+                                                       signal_threshold_tests[i].sinr_threshold,
+                                                       signal_threshold_tests[i].error_rate_threshold),
+                          ==, signal_threshold_tests[i].crossed);
+    }
+}
+
+static void
+test_signal_threshold_crossed_rat (void)
+{
+    g_autoptr(MMSignal) signal = NULL;
+
+    signal = build_lte_signal (-100.0, 10.0, 1.0);
+
+    /* RAT appearing or disappearing is always reported */
+    g_assert_true (mm_signal_threshold_crossed (NULL, signal, 5, 3, FALSE));
+    g_assert_true (mm_signal_threshold_crossed (signal, NULL, 5, 3, FALSE));
+    g_assert_false (mm_signal_threshold_crossed (NULL, NULL, 5, 3, TRUE));
+}
+
 typedef struct {
     const gchar       *str;
     MMModemPowerState  state;
@@ -5058,6 +5326,119 @@ test_cpol_response (void)
 
 /*****************************************************************************/
 
+typedef struct {
+    const gchar *old_networks[5];   /* "" for empty entries */
+    const gchar *new_networks[5];
+    const guint  expected_clear[5]; /* AT+CPOL indices, 0-terminated */
+    const gint   expected_write[5]; /* positions, -1-terminated */
+} TestCpolDiff;
+
+static const TestCpolDiff test_cpol_diff[] = {
+    /* Unchanged */
+    { { "21401", "21403", "21407", NULL }, { "21401", "21403", "21407", NULL }, { 0 },       { -1 } },
+    /* Appended */
+    { { "21401", "21403", NULL },          { "21401", "21403", "21407", NULL }, { 0 },       { 2, -1 } },
+    /* Truncated */
+    { { "21401", "21403", "21407", NULL }, { "21401", NULL },                   { 2, 3, 0 }, { -1 } },
+    /* Replaced in place */
+    { { "21401", "21403", NULL },          { "21401", "21407", NULL },          { 0 },       { 1, -1 } },
+    /* Empty entry in between */
+    { { "21401", "", "21407", NULL },      { "21401", "21403", NULL },          { 3, 0 },    { 1, -1 } },
+    /* Swapped: both cleared before writing */
+    { { "21401", "21403", NULL },          { "21403", "21401", NULL },          { 1, 2, 0 }, { 0, 1, -1 } },
+    /* Moved: everything from the first moved entry is rewritten */
+    { { "21401", "21403", "21407", "21405", NULL }, { "21401", "21407", "21403", NULL }, { 2, 3, 4, 0 }, { 1, 2, -1 } },
+    /* Cleared */
+    { { "21401", "21403", NULL },          { NULL },                            { 1, 2, 0 }, { -1 } },
+};
+
+static MMSimPreferredNetwork *
+build_preferred_network (const gchar             *operator_code,
+                         MMModemAccessTechnology  act)
+{
+    MMSimPreferredNetwork *network;
+
+    network = mm_sim_preferred_network_new ();
+    mm_sim_preferred_network_set_operator_code (network, operator_code);
+    mm_sim_preferred_network_set_access_technology (network, act);
+    return network;
+}
+
+static void
+common_test_cpol_diff (GPtrArray    *old_networks,
+                       GList        *new_networks,
+                       const guint  *expected_clear,
+                       const gint   *expected_write)
+{
+    g_autoptr(GArray) clear_index = NULL;
+    g_autoptr(GArray) write_index = NULL;
+    guint             i;
+
+    clear_index = g_array_new (FALSE, FALSE, sizeof (guint));
+    write_index = g_array_new (FALSE, FALSE, sizeof (guint));
+    mm_sim_preferred_networks_diff (old_networks, new_networks, clear_index, write_index);
+
+    for (i = 0; expected_clear[i]; i++) {
+        g_assert_cmpuint (i, <, clear_index->len);
+        g_assert_cmpuint (g_array_index (clear_index, guint, i), ==, expected_clear[i]);
+    }
+    g_assert_cmpuint (clear_index->len, ==, i);
+
+    for (i = 0; expected_write[i] >= 0; i++) {
+        g_assert_cmpuint (i, <, write_index->len);
+        g_assert_cmpuint (g_array_index (write_index, guint, i), ==, (guint) expected_write[i]);
+    }
+    g_assert_cmpuint (write_index->len, ==, i);
+}
+
+static void
+test_cpol_diff_list (void)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (test_cpol_diff); i++) {
+        g_autoptr(GPtrArray)  old_networks = NULL;
+        GList                *new_networks = NULL;
+        guint                 j;
+
+        old_networks = g_ptr_array_new_with_free_func ((GDestroyNotify) mm_sim_preferred_network_free);
+        for (j = 0; test_cpol_diff[i].old_networks[j]; j++)
+            g_ptr_array_add (old_networks,
+                             test_cpol_diff[i].old_networks[j][0] ?
+                             build_preferred_network (test_cpol_diff[i].old_networks[j], MM_MODEM_ACCESS_TECHNOLOGY_GSM) :
+                             NULL);
+        for (j = 0; test_cpol_diff[i].new_networks[j]; j++)
+            new_networks = g_list_append (new_networks,
+                                          build_preferred_network (test_cpol_diff[i].new_networks[j], MM_MODEM_ACCESS_TECHNOLOGY_GSM));
+
+        common_test_cpol_diff (old_networks, new_networks,
+                               test_cpol_diff[i].expected_clear,
+                               test_cpol_diff[i].expected_write);
+        mm_sim_preferred_network_list_free (new_networks);
+    }
+}
+
+static void
+test_cpol_diff_access_technology (void)
+{
+    g_autoptr(GPtrArray)  old_networks = NULL;
+    GList                *new_networks = NULL;
+    static const guint    expected_clear[] = { 0 };
+    static const gint     expected_write[] = { 1, -1 };
+
+    /* Same network with different access technologies is written in place */
+    old_networks = g_ptr_array_new_with_free_func ((GDestroyNotify) mm_sim_preferred_network_free);
+    g_ptr_array_add (old_networks, build_preferred_network ("21401", MM_MODEM_ACCESS_TECHNOLOGY_GSM));
+    g_ptr_array_add (old_networks, build_preferred_network ("21403", MM_MODEM_ACCESS_TECHNOLOGY_GSM));
+    new_networks = g_list_append (new_networks, build_preferred_network ("21401", MM_MODEM_ACCESS_TECHNOLOGY_GSM));
+    new_networks = g_list_append (new_networks, build_preferred_network ("21403", MM_MODEM_ACCESS_TECHNOLOGY_LTE));
+
+    common_test_cpol_diff (old_networks, new_networks, expected_clear, expected_write);
+    mm_sim_preferred_network_list_free (new_networks);
+}
+
+/*****************************************************************************/
+
 typedef struct {
     const gchar *response;
     gboolean     expected_empty;
@@ -5235,6 +5616,122 @@ test_cpin_response (void)
 
 /*****************************************************************************/
 
+typedef struct {
+    MMAtTokenType  type;
+    const gchar   *str;
+    guint          min;
+    guint          max;
+} TestAtToken;
+
+static const TestAtToken test_at_lexer_tokens[] = {
+    { MM_AT_TOKEN_TYPE_NUMBER, "1",                0, 0    },
+    { MM_AT_TOKEN_TYPE_STRING, "IP",               0, 0    },
+    { MM_AT_TOKEN_TYPE_EMPTY,  "",                 0, 0    },
+    { MM_AT_TOKEN_TYPE_STRING, "a,b",              0, 0    },
+    { MM_AT_TOKEN_TYPE_RANGE,  "0-5",              0, 5    },
+    { MM_AT_TOKEN_TYPE_WORD,   "Non-IP",           0, 0    },
+    { MM_AT_TOKEN_TYPE_NUMBER, "4294967295",       0, 0    },
+    { MM_AT_TOKEN_TYPE_WORD,   "4294967296",       0, 0    },
+    { MM_AT_TOKEN_TYPE_GROUP,  "\"SM\",(\"x)\",1)", 0, 0    },
+    { MM_AT_TOKEN_TYPE_EMPTY,  "",                 0, 0    },
+};
+
+static void
+test_at_lexer (void)
+{
+    const gchar *response = "1, \"IP\" ,,\"a,b\",0-5,Non-IP,4294967295,4294967296,(\"SM\",(\"x)\",1)),";
+    MMAtLexer    lexer;
+    MMAtLexer    group;
+    MMAtToken    token;
+    guint        i;
+
+    mm_at_lexer_init (&lexer, response, -1);
+    for (i = 0; mm_at_lexer_next (&lexer, &token); i++) {
+        g_assert_cmpuint (i, <, G_N_ELEMENTS (test_at_lexer_tokens));
+        g_assert_cmpint (token.type, ==, test_at_lexer_tokens[i].type);
+        g_assert_true (mm_at_token_equal (&token, test_at_lexer_tokens[i].str));
+        if (token.type == MM_AT_TOKEN_TYPE_RANGE) {
+            g_assert_cmpuint (token.min, ==, test_at_lexer_tokens[i].min);
+            g_assert_cmpuint (token.max, ==, test_at_lexer_tokens[i].max);
+        } else if (token.type == MM_AT_TOKEN_TYPE_NUMBER)
+            g_assert_cmpuint (token.min, ==, (guint) atol (test_at_lexer_tokens[i].str));
+    }
+    g_assert_cmpuint (i, ==, G_N_ELEMENTS (test_at_lexer_tokens));
+
+    /* Nested groups */
+    mm_at_lexer_init (&lexer, "(\"SM\",(1,2)),()", -1);
+    g_assert_true (mm_at_lexer_next (&lexer, &token));
+    g_assert_cmpint (token.type, ==, MM_AT_TOKEN_TYPE_GROUP);
+    mm_at_lexer_init_group (&group, &token);
+    g_assert_true (mm_at_lexer_next (&group, &token));
+    g_assert_true (mm_at_token_equal (&token, "SM"));
+    g_assert_true (mm_at_lexer_next (&group, &token));
+    g_assert_cmpint (token.type, ==, MM_AT_TOKEN_TYPE_GROUP);
+    g_assert_true (mm_at_token_equal (&token, "1,2"));
+    g_assert_false (mm_at_lexer_next (&group, &token));
+    g_assert_true (mm_at_lexer_next (&lexer, &token));
+    g_assert_cmpint (token.type, ==, MM_AT_TOKEN_TYPE_GROUP);
+    g_assert_cmpuint (token.len, ==, 0);
+    g_assert_false (mm_at_lexer_next (&lexer, &token));
+}
+
+static void
+test_at_lexer_lines (void)
+{
+    const gchar *response = "\r\n+CGACT: 1,0\r\n\r\n+CGDCONT: 1\r\n+CGACT: 2,1\r\n";
+    MMAtLexer    lexer;
+    MMAtToken    token;
+    guint        n_lines = 0;
+
+    while (mm_at_lexer_init_line (&lexer, &response, "+CGACT:")) {
+        n_lines++;
+        g_assert_true (mm_at_lexer_next (&lexer, &token));
+        g_assert_cmpint (token.type, ==, MM_AT_TOKEN_TYPE_NUMBER);
+        g_assert_cmpuint (token.min, ==, n_lines);
+        g_assert_true (mm_at_lexer_next (&lexer, &token));
+        g_assert_cmpuint (token.min, ==, n_lines - 1);
+        g_assert_false (mm_at_lexer_next (&lexer, &token));
+    }
+    g_assert_cmpuint (n_lines, ==, 2);
+}
+
+/*****************************************************************************/
+
+static void
+test_regex_registry (void)
+{
+    GRegex *r1;
+    GRegex *r2;
+    GRegex *r3;
+    guint   n_compiled = 0;
+    guint   i;
+
+    r1 = mm_regex_registry_get ("\\+TEST:\\s*(\\d+)", G_REGEX_RAW, 0);
+    r2 = mm_regex_registry_get ("\\+TEST:\\s*(\\d+)", G_REGEX_RAW, 0);
+    g_assert_true (r1 == r2);
+
+    /* Same pattern with different flags is a different regex */
+    r3 = mm_regex_registry_get ("\\+TEST:\\s*(\\d+)", 0, 0);
+    g_assert_true (r1 != r3);
+
+    /* Parsing the same kind of response repeatedly must not compile anything new */
+    for (i = 0; i < 3; i++) {
+        g_autofree gchar *operator = NULL;
+        GError           *error = NULL;
+        gboolean          result;
+
+        if (i == 1)
+            n_compiled = mm_regex_registry_get_n_compiled ();
+        result = mm_3gpp_parse_cops_read_response ("+COPS: 0,0,\"T-Mobile\",2", NULL, NULL, &operator, NULL, NULL, &error);
+        g_assert_no_error (error);
+        g_assert_true (result);
+        g_assert_cmpstr (operator, ==, "T-Mobile");
+    }
+    g_assert_cmpuint (mm_regex_registry_get_n_compiled (), ==, n_compiled);
+}
+
+/*****************************************************************************/
+
 typedef struct {
     const char *desc;
     const char *dtmf;
@@ -5342,6 +5839,11 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_cops_response_gsm_invalid, NULL));
     g_test_suite_add (suite, TESTCASE (test_cops_response_umts_invalid, NULL));
 
+    g_test_suite_add (suite, TESTCASE (test_incremental_scan_passes_all, NULL));
+    g_test_suite_add (suite, TESTCASE (test_incremental_scan_passes_allowed, NULL));
+    g_test_suite_add (suite, TESTCASE (test_incremental_scan_passes_single, NULL));
+    g_test_suite_add (suite, TESTCASE (test_network_info_list_filter_new, NULL));
+
     g_test_suite_add (suite, TESTCASE (test_cops_query, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_normalize_operator, NULL));
@@ -5463,6 +5965,8 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_cgdcont_read_response_nokia, NULL));
     g_test_suite_add (suite, TESTCASE (test_cgdcont_read_response_samsung, NULL));
     g_test_suite_add (suite, TESTCASE (test_cgdcont_read_response_simcom, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cgdcont_read_response_ignore, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cgdcont_read_response_invalid_cid, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_profile_selection, NULL));
 
@@ -5470,6 +5974,8 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_cgact_read_response_single_inactive, NULL));
     g_test_suite_add (suite, TESTCASE (test_cgact_read_response_single_active, NULL));
     g_test_suite_add (suite, TESTCASE (test_cgact_read_response_multiple, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cgact_read_response_ignore, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cgact_read_response_invalid, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cnum_response_generic, NULL));
     g_test_suite_add (suite, TESTCASE (test_cnum_response_generic_without_detail, NULL));
@@ -5482,6 +5988,7 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_parse_cds, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cdma_parse_gsn, NULL));
+    g_test_suite_add (suite, TESTCASE (test_equipment_identifier_equal, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cmgl_response_generic, NULL));
     g_test_suite_add (suite, TESTCASE (test_cmgl_response_generic_multiple, NULL));
@@ -5506,6 +6013,8 @@ int main (int argc, char **argv)
 
     g_test_suite_add (suite, TESTCASE (test_cesq_response, NULL));
     g_test_suite_add (suite, TESTCASE (test_cesq_response_to_signal, NULL));
+    g_test_suite_add (suite, TESTCASE (test_signal_threshold_crossed, NULL));
+    g_test_suite_add (suite, TESTCASE (test_signal_threshold_crossed_rat, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_clip_indication, NULL));
     g_test_suite_add (suite, TESTCASE (test_ccwa_indication, NULL));
@@ -5532,6 +6041,8 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_is_valid_dial_number, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cpol_response, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cpol_diff_list, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cpol_diff_access_technology, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_mm_split_string_groups, NULL));
 
@@ -5542,6 +6053,10 @@ int main (int argc, char **argv)
 
     g_test_suite_add (suite, TESTCASE (test_cpin_response, NULL));
 
+    g_test_suite_add (suite, TESTCASE (test_at_lexer, NULL));
+    g_test_suite_add (suite, TESTCASE (test_at_lexer_lines, NULL));
+    g_test_suite_add (suite, TESTCASE (test_regex_registry, NULL));
+
     for (i = 0; i < G_N_ELEMENTS (test_dtmf_data); i++) {
         g_test_add_data_func (test_dtmf_data[i].desc,
                               &test_dtmf_data[i],
@@ -19,6 +19,7 @@
 #include <stdio.h>
 
 #include "mm-port-scheduler-rr.h"
+#include "mm-port-scheduler-prio.h"
 #include "mm-log-test.h"
 
 static GMainLoop *loop;
@@ -35,6 +36,10 @@ typedef struct {
 
     gpointer         data;
     gpointer         data2;
+
+    /* Only for sources reporting their next command */
+    MMPortSchedulerPriority priority;
+    gint64                  enqueued_time;
 } TestSourceCtx;
 
 static void
@@ -610,6 +615,210 @@ test_errors_source_done_before_loop (void)
 
 /*****************************************************************************/
 
+static void
+test_prio_send_command (MMPortScheduler *scheduler,
+                        gpointer         source,
+                        TestSourceCtx   *ctx)
+{
+    GArray *order = ctx->data;
+    guint  *counter = ctx->data2;
+
+    g_assert (scheduler == ctx->sched);
+    if (source != ctx->source_id)
+        return;
+
+    g_array_append_val (order, ctx->source_id);
+
+    ctx->num_pending--;
+    g_assert_cmpint (ctx->num_pending, >=, 0);
+
+    /* Next command in the queue was submitted right now */
+    ctx->enqueued_time = g_get_monotonic_time ();
+    mm_port_scheduler_notify_next_command (ctx->sched, ctx->source_id, ctx->priority, ctx->enqueued_time);
+    mm_port_scheduler_notify_command_done (ctx->sched, ctx->source_id, ctx->num_pending);
+
+    (*counter)--;
+    if (*counter == 0)
+        g_main_loop_quit (loop);
+}
+
+static void
+test_prio_source_setup (TestSourceCtx   *ctx,
+                        MMPortScheduler *sched)
+{
+    ctx->sched = g_object_ref (sched);
+    mm_port_scheduler_register_source (sched, ctx->source_id, "test");
+    ctx->sig_id = g_signal_connect (sched,
+                                    MM_PORT_SCHEDULER_SIGNAL_SEND_COMMAND,
+                                    G_CALLBACK (test_prio_send_command),
+                                    ctx);
+    mm_port_scheduler_notify_next_command (ctx->sched, ctx->source_id, ctx->priority, ctx->enqueued_time);
+    mm_port_scheduler_notify_num_pending (ctx->sched, ctx->source_id, ctx->num_pending);
+}
+
+static void
+test_prio_ordering (void)
+{
+    MMPortScheduler  *sched;
+    g_autoptr(GArray) order = NULL;
+    guint             counter;
+    guint             i;
+    gint64            now;
+
+    order = g_array_new (FALSE, FALSE, sizeof (gpointer));
+    now = g_get_monotonic_time ();
+
+    {
+        TestSourceCtx  ctx1 = {
+            .source_id     = GUINT_TO_POINTER (0x1),
+            .num_pending   = 3,
+            .data          = order,
+            .data2         = &counter,
+            .priority      = MM_PORT_SCHEDULER_PRIORITY_BACKGROUND,
+            .enqueued_time = now,
+        };
+
+        TestSourceCtx  ctx2 = {
+            .source_id     = GUINT_TO_POINTER (0x2),
+            .num_pending   = 3,
+            .data          = order,
+            .data2         = &counter,
+            .priority      = MM_PORT_SCHEDULER_PRIORITY_CONTROL,
+            .enqueued_time = now,
+        };
+
+        TestSourceCtx  ctx3 = {
+            .source_id     = GUINT_TO_POINTER (0x3),
+            .num_pending   = 3,
+            .data          = order,
+            .data2         = &counter,
+            .priority      = MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+            .enqueued_time = now,
+        };
+
+        counter = ctx1.num_pending + ctx2.num_pending + ctx3.num_pending;
+
+        /* No aging, strict priority order expected */
+        sched = MM_PORT_SCHEDULER (mm_port_scheduler_prio_new ());
+        g_object_set (sched, MM_PORT_SCHEDULER_PRIO_AGING_INTERVAL, 0, NULL);
+        test_prio_source_setup (&ctx1, sched);
+        test_prio_source_setup (&ctx2, sched);
+        test_prio_source_setup (&ctx3, sched);
+
+        g_main_loop_run (loop);
+
+        test_source_cleanup (&ctx1);
+        test_source_cleanup (&ctx2);
+        test_source_cleanup (&ctx3);
+        g_object_unref (sched);
+    }
+
+    g_assert_cmpuint (order->len, ==, 9);
+    for (i = 0; i < order->len; i++)
+        g_assert_cmpuint (GPOINTER_TO_UINT (g_array_index (order, gpointer, i)), ==, 3 - (i / 3));
+}
+
+static void
+test_prio_aging (void)
+{
+    MMPortScheduler  *sched;
+    g_autoptr(GArray) order = NULL;
+    guint             counter;
+    gint64            now;
+
+    order = g_array_new (FALSE, FALSE, sizeof (gpointer));
+    now = g_get_monotonic_time ();
+
+    {
+        /* Background command waiting for longer than two aging intervals
+         * already, so it is as urgent as the interactive ones */
+        TestSourceCtx  ctx1 = {
+            .source_id     = GUINT_TO_POINTER (0x1),
+            .num_pending   = 1,
+            .data          = order,
+            .data2         = &counter,
+            .priority      = MM_PORT_SCHEDULER_PRIORITY_BACKGROUND,
+            .enqueued_time = now - 250000,
+        };
+
+        TestSourceCtx  ctx2 = {
+            .source_id     = GUINT_TO_POINTER (0x2),
+            .num_pending   = 5,
+            .data          = order,
+            .data2         = &counter,
+            .priority      = MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE,
+            .enqueued_time = now,
+        };
+
+        counter = ctx1.num_pending + ctx2.num_pending;
+
+        sched = MM_PORT_SCHEDULER (mm_port_scheduler_prio_new ());
+        g_object_set (sched, MM_PORT_SCHEDULER_PRIO_AGING_INTERVAL, 100, NULL);
+        test_prio_source_setup (&ctx2, sched);
+        test_prio_source_setup (&ctx1, sched);
+
+        g_main_loop_run (loop);
+
+        test_source_cleanup (&ctx1);
+        test_source_cleanup (&ctx2);
+        g_object_unref (sched);
+    }
+
+    /* Without aging, the background command would have been the last one */
+    g_assert_cmpuint (order->len, ==, 6);
+    g_assert_cmpuint (GPOINTER_TO_UINT (g_array_index (order, gpointer, 0)), ==, 0x1);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    guint                   id;
+    MMPortSchedulerPriority priority;
+    gboolean                started;
+} TestQueueItem;
+
+static MMPortSchedulerPriority
+test_queue_get_priority (gpointer  item,
+                         gboolean *started)
+{
+    TestQueueItem *queue_item = item;
+
+    if (started)
+        *started = queue_item->started;
+    return queue_item->priority;
+}
+
+static void
+test_prio_queue_insert (void)
+{
+    /* The background command in progress is never preempted */
+    TestQueueItem items[] = {
+        { 1, MM_PORT_SCHEDULER_PRIORITY_BACKGROUND,  TRUE  },
+        { 2, MM_PORT_SCHEDULER_PRIORITY_BACKGROUND,  FALSE },
+        { 3, MM_PORT_SCHEDULER_PRIORITY_CONTROL,     FALSE },
+        { 4, MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE, FALSE },
+        { 5, MM_PORT_SCHEDULER_PRIORITY_BACKGROUND,  FALSE },
+        { 6, MM_PORT_SCHEDULER_PRIORITY_INTERACTIVE, FALSE },
+        { 7, MM_PORT_SCHEDULER_PRIORITY_CONTROL,     FALSE },
+    };
+    static const guint expected[] = { 1, 4, 6, 3, 7, 2, 5 };
+    GQueue *queue;
+    GList  *l;
+    guint   i;
+
+    queue = g_queue_new ();
+    for (i = 0; i < G_N_ELEMENTS (items); i++)
+        mm_port_scheduler_priority_queue_insert (queue, &items[i], test_queue_get_priority);
+
+    g_assert_cmpuint (g_queue_get_length (queue), ==, G_N_ELEMENTS (expected));
+    for (l = queue->head, i = 0; l; l = g_list_next (l), i++)
+        g_assert_cmpuint (((TestQueueItem *) l->data)->id, ==, expected[i]);
+
+    g_queue_free (queue);
+}
+
+/*****************************************************************************/
+
 int main (int argc, char **argv)
 {
     int ret;
@@ -631,6 +840,9 @@ int main (int argc, char **argv)
     g_test_add_data_func ("/MM/port-scheduler/dual-source/pending-during-done", NULL,                     (GTestDataFunc)test_ds_pending_during_done);
     g_test_add_data_func ("/MM/port-scheduler/errors/bad-source-done",          NULL,                     (GTestDataFunc)test_errors_bad_source_done);
     g_test_add_data_func ("/MM/port-scheduler/errors/source-done-before-loop",  NULL,                     (GTestDataFunc)test_errors_source_done_before_loop);
+    g_test_add_data_func ("/MM/port-scheduler/priority/ordering",               NULL,                     (GTestDataFunc)test_prio_ordering);
+    g_test_add_data_func ("/MM/port-scheduler/priority/aging",                  NULL,                     (GTestDataFunc)test_prio_aging);
+    g_test_add_data_func ("/MM/port-scheduler/priority/queue-insert",           NULL,                     (GTestDataFunc)test_prio_queue_insert);
 
     ret = g_test_run();
 
@@ -0,0 +1,214 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+
+#include <glib.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-modem-helpers.h"
+#include "mm-profile-cache.h"
+
+/*****************************************************************************/
+
+static MM3gppProfile *
+build_profile (gint         profile_id,
+               const gchar *apn)
+{
+    MM3gppProfile *profile;
+
+    profile = mm_3gpp_profile_new ();
+    mm_3gpp_profile_set_profile_id (profile, profile_id);
+    mm_3gpp_profile_set_apn (profile, apn);
+    mm_3gpp_profile_set_ip_type (profile, MM_BEARER_IP_FAMILY_IPV4V6);
+    return profile;
+}
+
+static GList *
+build_profile_list (void)
+{
+    GList *profiles = NULL;
+
+    profiles = g_list_append (profiles, build_profile (1, "internet"));
+    profiles = g_list_append (profiles, build_profile (3, "ims"));
+    return profiles;
+}
+
+static void
+assert_cached_apn (MMProfileCache *cache,
+                   gint            profile_id,
+                   const gchar    *apn)
+{
+    g_autoptr(MM3gppProfile) profile = NULL;
+    g_autoptr(GError)        error = NULL;
+
+    profile = mm_profile_cache_dup_profile (cache, profile_id, &error);
+    if (!apn) {
+        g_assert_nonnull (error);
+        g_assert_null (profile);
+        return;
+    }
+    g_assert_no_error (error);
+    g_assert_nonnull (profile);
+    g_assert_cmpstr (mm_3gpp_profile_get_apn (profile), ==, apn);
+}
+
+/*****************************************************************************/
+
+static void
+test_profile_cache_disabled (void)
+{
+    g_autoptr(MMProfileCache) cache = NULL;
+    GList                    *profiles;
+
+    cache = mm_profile_cache_new ();
+    profiles = build_profile_list ();
+
+    /* Not used until enabled */
+    g_assert_false (mm_profile_cache_set_list (cache, mm_profile_cache_get_generation (cache), profiles));
+    g_assert_false (mm_profile_cache_is_valid (cache));
+
+    mm_profile_cache_set_enabled (cache, TRUE);
+    g_assert_true (mm_profile_cache_set_list (cache, mm_profile_cache_get_generation (cache), profiles));
+    g_assert_true (mm_profile_cache_is_valid (cache));
+
+    /* Disabling drops the contents */
+    mm_profile_cache_set_enabled (cache, FALSE);
+    g_assert_false (mm_profile_cache_is_valid (cache));
+
+    mm_3gpp_profile_list_free (profiles);
+}
+
+static void
+test_profile_cache_list (void)
+{
+    g_autoptr(MMProfileCache) cache = NULL;
+    GList                    *profiles;
+    GList                    *cached;
+
+    cache = mm_profile_cache_new ();
+    mm_profile_cache_set_enabled (cache, TRUE);
+
+    profiles = build_profile_list ();
+    g_assert_true (mm_profile_cache_set_list (cache, mm_profile_cache_get_generation (cache), profiles));
+
+    /* Modifying the original list doesn't modify the cache */
+    mm_3gpp_profile_set_apn (MM_3GPP_PROFILE (profiles->data), "other");
+    mm_3gpp_profile_list_free (profiles);
+
+    cached = mm_profile_cache_dup_list (cache);
+    g_assert_cmpuint (g_list_length (cached), ==, 2);
+    g_assert_cmpint (mm_3gpp_profile_get_profile_id (MM_3GPP_PROFILE (cached->data)), ==, 1);
+    g_assert_cmpstr (mm_3gpp_profile_get_apn (MM_3GPP_PROFILE (cached->data)), ==, "internet");
+    mm_3gpp_profile_list_free (cached);
+
+    assert_cached_apn (cache, 3, "ims");
+    assert_cached_apn (cache, 2, NULL);
+}
+
+static void
+test_profile_cache_update_remove (void)
+{
+    g_autoptr(MMProfileCache) cache = NULL;
+    g_autoptr(MM3gppProfile)  profile = NULL;
+    GList                    *profiles;
+    GList                    *cached;
+    guint                     generation;
+
+    cache = mm_profile_cache_new ();
+    mm_profile_cache_set_enabled (cache, TRUE);
+
+    profiles = build_profile_list ();
+    generation = mm_profile_cache_get_generation (cache);
+    g_assert_true (mm_profile_cache_set_list (cache, generation, profiles));
+    mm_3gpp_profile_list_free (profiles);
+
+    /* New profiles are kept sorted by id */
+    profile = build_profile (2, "mms");
+    mm_profile_cache_update (cache, generation, profile);
+    g_clear_object (&profile);
+    cached = mm_profile_cache_dup_list (cache);
+    g_assert_cmpuint (g_list_length (cached), ==, 3);
+    g_assert_cmpint (mm_3gpp_profile_get_profile_id (MM_3GPP_PROFILE (g_list_nth_data (cached, 1))), ==, 2);
+    mm_3gpp_profile_list_free (cached);
+
+    /* Existing profiles are replaced */
+    profile = build_profile (1, "internet2");
+    mm_profile_cache_update (cache, generation, profile);
+    g_clear_object (&profile);
+    assert_cached_apn (cache, 1, "internet2");
+
+    mm_profile_cache_remove (cache, 2);
+    assert_cached_apn (cache, 2, NULL);
+    assert_cached_apn (cache, 3, "ims");
+}
+
+static void
+test_profile_cache_generation (void)
+{
+    g_autoptr(MMProfileCache) cache = NULL;
+    g_autoptr(MM3gppProfile)  profile = NULL;
+    GList                    *profiles;
+    guint                     generation;
+
+    cache = mm_profile_cache_new ();
+    mm_profile_cache_set_enabled (cache, TRUE);
+    profiles = build_profile_list ();
+
+    /* A list started before an invalidation is not cached */
+    generation = mm_profile_cache_get_generation (cache);
+    g_assert_false (mm_profile_cache_invalidate (cache));
+    g_assert_false (mm_profile_cache_set_list (cache, generation, profiles));
+    g_assert_false (mm_profile_cache_is_valid (cache));
+
+    /* A list started after the last invalidation is cached */
+    generation = mm_profile_cache_get_generation (cache);
+    g_assert_true (mm_profile_cache_set_list (cache, generation, profiles));
+    g_assert_true (mm_profile_cache_is_valid (cache));
+
+    /* A read back started before an invalidation is not applied to a list
+     * loaded afterwards */
+    g_assert_true (mm_profile_cache_invalidate (cache));
+    g_assert_true (mm_profile_cache_set_list (cache, mm_profile_cache_get_generation (cache), profiles));
+    profile = build_profile (1, "stale");
+    mm_profile_cache_update (cache, generation, profile);
+    assert_cached_apn (cache, 1, "internet");
+
+    /* Nothing is applied to an invalid cache */
+    mm_profile_cache_invalidate (cache);
+    mm_profile_cache_update (cache, mm_profile_cache_get_generation (cache), profile);
+    g_assert_false (mm_profile_cache_is_valid (cache));
+
+    mm_3gpp_profile_list_free (profiles);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/profile-cache/disabled",      test_profile_cache_disabled);
+    g_test_add_func ("/MM/profile-cache/list",          test_profile_cache_list);
+    g_test_add_func ("/MM/profile-cache/update_remove", test_profile_cache_update_remove);
+    g_test_add_func ("/MM/profile-cache/generation",    test_profile_cache_generation);
+
+    return g_test_run ();
+}
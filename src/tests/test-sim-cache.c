@@ -0,0 +1,138 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 The ModemManager authors
+ */
+
+#include <config.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <locale.h>
+
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+#include "mm-log-test.h"
+#include "mm-sim-cache.h"
+
+#define TEST_ICCID "89014103211118510720"
+#define TEST_IMSI  "310410123456789"
+
+/*****************************************************************************/
+
+static gchar *
+save_test_cache (void)
+{
+    g_autoptr(GKeyFile)  values = NULL;
+    g_autoptr(GError)    error = NULL;
+    const gchar         *emergency_numbers[] = { "112", "911" };
+    gchar               *filename = NULL;
+    gint                 fd;
+
+    fd = g_file_open_tmp (NULL, &filename, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (filename);
+    close (fd);
+
+    values = g_key_file_new ();
+    g_key_file_set_string (values, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_OPERATOR_IDENTIFIER, "310410");
+    g_key_file_set_string (values, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_OPERATOR_NAME, "AT&T");
+    g_key_file_set_string_list (values, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_EMERGENCY_NUMBERS,
+                                emergency_numbers, G_N_ELEMENTS (emergency_numbers));
+    g_key_file_set_string (values, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_GID1, "FF01");
+
+    g_assert (mm_sim_cache_save (filename, TEST_ICCID, TEST_IMSI, values, &error));
+    g_assert_no_error (error);
+
+    return filename;
+}
+
+static void
+test_sim_cache_save_load (void)
+{
+    g_autofree gchar    *filename = NULL;
+    g_autofree gchar    *contents = NULL;
+    g_autoptr(GKeyFile)  key_file = NULL;
+    g_autoptr(GError)    error = NULL;
+    g_autofree gchar    *str = NULL;
+    g_auto(GStrv)        strv = NULL;
+
+    filename = save_test_cache ();
+
+    /* Neither the ICCID nor the IMSI are stored in plain text */
+    g_assert (g_file_get_contents (filename, &contents, NULL, NULL));
+    g_assert_null (strstr (contents, TEST_ICCID));
+    g_assert_null (strstr (contents, TEST_IMSI));
+
+    key_file = mm_sim_cache_load (filename, TEST_ICCID, TEST_IMSI, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (key_file);
+
+    str = g_key_file_get_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_OPERATOR_IDENTIFIER, NULL);
+    g_assert_cmpstr (str, ==, "310410");
+    g_clear_pointer (&str, g_free);
+    str = g_key_file_get_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_OPERATOR_NAME, NULL);
+    g_assert_cmpstr (str, ==, "AT&T");
+    g_clear_pointer (&str, g_free);
+    str = g_key_file_get_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_GID1, NULL);
+    g_assert_cmpstr (str, ==, "FF01");
+    g_clear_pointer (&str, g_free);
+    str = g_key_file_get_string (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_GID2, NULL);
+    g_assert_null (str);
+
+    strv = g_key_file_get_string_list (key_file, MM_SIM_CACHE_GROUP, MM_SIM_CACHE_KEY_EMERGENCY_NUMBERS, NULL, NULL);
+    g_assert_nonnull (strv);
+    g_assert_cmpuint (g_strv_length (strv), ==, 2);
+    g_assert_cmpstr (strv[0], ==, "112");
+    g_assert_cmpstr (strv[1], ==, "911");
+
+    g_unlink (filename);
+}
+
+static void
+test_sim_cache_mismatch (void)
+{
+    g_autofree gchar    *filename = NULL;
+    g_autoptr(GKeyFile)  key_file = NULL;
+    g_autoptr(GError)    error = NULL;
+
+    filename = save_test_cache ();
+
+    /* Different SIM card */
+    key_file = mm_sim_cache_load (filename, "89014103211118510721", TEST_IMSI, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND);
+    g_assert_null (key_file);
+    g_clear_error (&error);
+
+    /* Same SIM card, switched to a different IMSI */
+    key_file = mm_sim_cache_load (filename, TEST_ICCID, "310410987654321", &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND);
+    g_assert_null (key_file);
+
+    g_unlink (filename);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/sim-cache/save_load", test_sim_cache_save_load);
+    g_test_add_func ("/MM/sim-cache/mismatch",  test_sim_cache_mismatch);
+
+    return g_test_run ();
+}
@@ -127,6 +127,189 @@ test_mbim_multipart_zero_index (void)
 
 /****************************************************************/
 
+static void
+take_test_sms (MMSmsList    *list,
+               guint         index,
+               MMSmsState    state,
+               MMSmsStorage  storage)
+{
+    MMSmsPart *part;
+    MMBaseSms *sms;
+    GError *error = NULL;
+
+    part = mm_sms_part_new (index, MM_SMS_PDU_TYPE_DELIVER);
+    mm_sms_part_set_number (part, "+34600000000");
+    mm_sms_part_set_text (part, "test");
+
+    sms = MM_BASE_SMS (g_object_new (MM_TYPE_BASE_SMS,
+                                     MM_BASE_SMS_IS_3GPP, TRUE,
+                                     MM_BASE_SMS_DEFAULT_STORAGE, MM_SMS_STORAGE_MT,
+                                     NULL));
+    mm_sms_list_take_part (list, sms, part, state, storage, &error);
+    g_assert_no_error (error);
+    g_object_unref (sms);
+}
+
+static void
+test_page_bounds (void)
+{
+    g_autoptr(MMSmsList) list = NULL;
+    g_auto(GStrv)        paths = NULL;
+    g_auto(GStrv)        page = NULL;
+    guint                total = 0;
+    guint                i;
+
+    list = mm_sms_list_new (NULL);
+    for (i = 0; i < 5; i++)
+        take_test_sms (list, i, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_MT);
+
+    paths = mm_sms_list_get_paths (list);
+    g_assert_cmpuint (g_strv_length (paths), ==, 5);
+
+    /* First page, same order as the list of paths */
+    page = mm_sms_list_get_page (list, 0, 2, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_UNKNOWN, &total);
+    g_assert_cmpuint (total, ==, 5);
+    g_assert_cmpuint (g_strv_length (page), ==, 2);
+    g_assert_cmpstr (page[0], ==, paths[0]);
+    g_assert_cmpstr (page[1], ==, paths[1]);
+    g_clear_pointer (&page, g_strfreev);
+
+    /* Last page, shorter than requested */
+    page = mm_sms_list_get_page (list, 4, 10, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_UNKNOWN, &total);
+    g_assert_cmpuint (total, ==, 5);
+    g_assert_cmpuint (g_strv_length (page), ==, 1);
+    g_assert_cmpstr (page[0], ==, paths[4]);
+    g_clear_pointer (&page, g_strfreev);
+
+    /* Offset past the end */
+    page = mm_sms_list_get_page (list, 5, 2, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_UNKNOWN, &total);
+    g_assert_cmpuint (total, ==, 5);
+    g_assert_cmpuint (g_strv_length (page), ==, 0);
+    g_clear_pointer (&page, g_strfreev);
+
+    /* Empty page, total still reported */
+    total = 0;
+    page = mm_sms_list_get_page (list, 0, 0, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_UNKNOWN, &total);
+    g_assert_cmpuint (total, ==, 5);
+    g_assert_cmpuint (g_strv_length (page), ==, 0);
+    g_clear_pointer (&page, g_strfreev);
+
+    /* Total is optional */
+    page = mm_sms_list_get_page (list, 1, 3, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_UNKNOWN, NULL);
+    g_assert_cmpuint (g_strv_length (page), ==, 3);
+    g_assert_cmpstr (page[0], ==, paths[1]);
+}
+
+static void
+test_page_filters (void)
+{
+    g_autoptr(MMSmsList) list = NULL;
+    g_auto(GStrv)        page = NULL;
+    guint                total = 0;
+
+    list = mm_sms_list_new (NULL);
+    take_test_sms (list, 0, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_MT);
+    take_test_sms (list, 1, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_SM);
+    take_test_sms (list, 2, MM_SMS_STATE_STORED,   MM_SMS_STORAGE_SM);
+    take_test_sms (list, 3, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_MT);
+
+    page = mm_sms_list_get_page (list, 0, 10, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_UNKNOWN, &total);
+    g_assert_cmpuint (total, ==, 3);
+    g_assert_cmpuint (g_strv_length (page), ==, 3);
+    g_clear_pointer (&page, g_strfreev);
+
+    page = mm_sms_list_get_page (list, 0, 10, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_SM, &total);
+    g_assert_cmpuint (total, ==, 2);
+    g_assert_cmpuint (g_strv_length (page), ==, 2);
+    g_clear_pointer (&page, g_strfreev);
+
+    page = mm_sms_list_get_page (list, 0, 10, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_SM, &total);
+    g_assert_cmpuint (total, ==, 1);
+    g_assert_cmpuint (g_strv_length (page), ==, 1);
+    g_clear_pointer (&page, g_strfreev);
+
+    /* Offset applies to the filtered messages */
+    page = mm_sms_list_get_page (list, 1, 10, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_MT, &total);
+    g_assert_cmpuint (total, ==, 2);
+    g_assert_cmpuint (g_strv_length (page), ==, 1);
+    g_clear_pointer (&page, g_strfreev);
+
+    page = mm_sms_list_get_page (list, 0, 10, MM_SMS_STATE_SENT, MM_SMS_STORAGE_UNKNOWN, &total);
+    g_assert_cmpuint (total, ==, 0);
+    g_assert_cmpuint (g_strv_length (page), ==, 0);
+}
+
+static void
+sms_added_cb (MMSmsList   *list,
+              const gchar *path,
+              gboolean     received,
+              guint       *n_added)
+{
+    g_auto(GStrv) paths = NULL;
+
+    /* Already in the list of paths when notified */
+    g_assert_nonnull (path);
+    paths = mm_sms_list_get_paths (list);
+    g_assert (g_strv_contains ((const gchar *const *) paths, path));
+    (*n_added)++;
+}
+
+static void
+test_defer_export (void)
+{
+    g_autoptr(MMSmsList) list = NULL;
+    g_auto(GStrv)        paths = NULL;
+    g_auto(GStrv)        page = NULL;
+    guint                total = 0;
+    guint                n_added = 0;
+    guint                i;
+
+    list = mm_sms_list_new (NULL);
+    g_signal_connect (list, MM_SMS_ADDED, G_CALLBACK (sms_added_cb), &n_added);
+
+    /* Deferred messages are neither exported nor notified */
+    mm_sms_list_set_defer_export (list, TRUE);
+    for (i = 0; i < 3; i++)
+        take_test_sms (list, i, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_MT);
+    mm_sms_list_set_defer_export (list, FALSE);
+
+    g_assert_cmpuint (n_added, ==, 0);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 3);
+    paths = mm_sms_list_get_paths (list);
+    g_assert_cmpuint (g_strv_length (paths), ==, 0);
+    g_clear_pointer (&paths, g_strfreev);
+
+    /* Listing a page exports and notifies only the messages in the page */
+    page = mm_sms_list_get_page (list, 0, 2, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_UNKNOWN, &total);
+    g_assert_cmpuint (total, ==, 3);
+    g_assert_cmpuint (g_strv_length (page), ==, 2);
+    g_assert_cmpuint (n_added, ==, 2);
+    paths = mm_sms_list_get_paths (list);
+    g_assert_cmpuint (g_strv_length (paths), ==, 2);
+    g_assert_cmpstr (paths[0], ==, page[0]);
+    g_assert_cmpstr (paths[1], ==, page[1]);
+    g_clear_pointer (&paths, g_strfreev);
+    g_clear_pointer (&page, g_strfreev);
+
+    /* Messages added afterwards are exported and notified right away */
+    take_test_sms (list, 3, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_MT);
+    g_assert_cmpuint (n_added, ==, 3);
+    paths = mm_sms_list_get_paths (list);
+    g_assert_cmpuint (g_strv_length (paths), ==, 3);
+    g_clear_pointer (&paths, g_strfreev);
+
+    /* The remaining deferred message is exported and notified once listed,
+     * the ones already exported are not notified again */
+    page = mm_sms_list_get_page (list, 0, 10, MM_SMS_STATE_UNKNOWN, MM_SMS_STORAGE_UNKNOWN, &total);
+    g_assert_cmpuint (total, ==, 4);
+    g_assert_cmpuint (g_strv_length (page), ==, 4);
+    paths = mm_sms_list_get_paths (list);
+    g_assert_cmpuint (g_strv_length (paths), ==, 4);
+    g_assert_cmpuint (n_added, ==, 4);
+}
+
+/****************************************************************/
+
 int main (int argc, char **argv)
 {
     setlocale (LC_ALL, "");
@@ -135,6 +318,9 @@ int main (int argc, char **argv)
 
     g_test_add_func ("/MM/SMS/3GPP/sms-list/zero-index", test_mbim_multipart_zero_index);
     g_test_add_func ("/MM/SMS/3GPP/sms-list/mbim-multipart-unstored", test_mbim_multipart_unstored);
+    g_test_add_func ("/MM/SMS/3GPP/sms-list/page-bounds", test_page_bounds);
+    g_test_add_func ("/MM/SMS/3GPP/sms-list/page-filters", test_page_filters);
+    g_test_add_func ("/MM/SMS/3GPP/sms-list/defer-export", test_defer_export);
 
     return g_test_run ();
 }
@@ -24,6 +24,7 @@
 #include <gio/gio.h>
 
 #include <mm-log.h>
+#include <mm-log-buffer.h>
 #include <mm-port-serial.h>
 #include <mm-port-serial-at.h>
 #include <mm-serial-parsers.h>
@@ -307,6 +308,30 @@ _mm_log (gpointer     obj,
     g_print ("[%s] %s\n", level_str ? level_str : "unknown", msg);
 }
 
+void
+_mm_log_buffer (gpointer           obj,
+                const gchar       *module,
+                const gchar       *loc,
+                const gchar       *func,
+                MMLogLevel         level,
+                const gchar       *prefix,
+                MMLogBufferFormat  format,
+                const guint8      *buffer,
+                gsize              length)
+{
+    g_autoptr(GString) str = NULL;
+    gsize              prefix_len;
+
+    if (!verbose_flag)
+        return;
+
+    str = g_string_new (prefix);
+    prefix_len = str->len;
+    g_string_set_size (str, prefix_len + MM_LOG_BUFFER_ESCAPED_MAX_LEN (length));
+    g_string_truncate (str, prefix_len + mm_log_buffer_escape (format, buffer, length, &str->str[prefix_len]));
+    _mm_log (obj, module, loc, func, level, "%s", str->str);
+}
+
 int main (int argc, char **argv)
 {
     GOptionContext *context;